@@ -0,0 +1,138 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2018 Pivotal, Inc.
+//
+//	@filename:
+//		CCostModelCalibrator.h
+//
+//	@doc:
+//		Offline fitting of GPDB cost model params to measured runtimes
+//---------------------------------------------------------------------------
+#ifndef GPDBCOST_CCostModelCalibrator_H
+#define GPDBCOST_CCostModelCalibrator_H
+
+#include "gpos/base.h"
+#include "gpos/common/CDouble.h"
+#include "gpos/common/CDynamicPtrArray.h"
+
+#include "gpopt/cost/ICostModel.h"
+
+#include "gpdbcost/CCostModelGPDB.h"
+#include "gpdbcost/CCostModelParamsGPDB.h"
+
+
+namespace gpdbcost
+{
+	using namespace gpos;
+	using namespace gpopt;
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CCostModelCalibrator
+	//
+	//	@doc:
+	//		Fits a subset of the GPDB cost model params to recorded
+	//		(plan fragment, actual runtime) pairs, where a plan fragment is an
+	//		operator together with the costing info it was costed with, and
+	//		runtimes are expressed in cost units.
+	//
+	//		Each observation contributes the sensitivity of the fragment's
+	//		cost to every fitted param, measured by perturbing the param,
+	//		to the normal equations of a least-squares fit. Since most params
+	//		are per-tuple coefficients the cost is linear in, one fitting step
+	//		is usually exact; params the cost is not linear in, e.g.,
+	//		thresholds, need repeated calibration starting from the previous
+	//		fit. Fitted params are clamped to their bounds, which therefore
+	//		define the range the calibration may move a param in.
+	//
+	//---------------------------------------------------------------------------
+	class CCostModelCalibrator
+	{
+		private:
+
+			// memory pool
+			IMemoryPool *m_pmp;
+
+			// cost model whose params are perturbed to measure sensitivities
+			CCostModelGPDB *m_pcm;
+
+			// ids of the params to fit
+			DrgPul *m_pdrgpulParams;
+
+			// left-hand side of the normal equations, i.e., the product of the
+			// transposed sensitivity matrix and the sensitivity matrix
+			DOUBLE *m_rgdJtJ;
+
+			// right-hand side of the normal equations, i.e., the product of
+			// the transposed sensitivity matrix and the residuals
+			DOUBLE *m_rgdJtr;
+
+			// number of observations
+			ULONG m_ulObservations;
+
+			// sum of squared residuals under the initial params
+			DOUBLE m_dSquaredError;
+
+			// private copy ctor
+			CCostModelCalibrator(const CCostModelCalibrator &);
+
+			// copy of the given params
+			static
+			CCostModelParamsGPDB *PcpCopy(IMemoryPool *pmp, const ICostModelParams *pcp);
+
+			// cost of a plan fragment under the current params
+			DOUBLE DCost(CExpressionHandle &exprhdl, const ICostModel::SCostingInfo *pci) const;
+
+			// sensitivity of the cost of a plan fragment to a param
+			DOUBLE DSensitivity(CExpressionHandle &exprhdl, const ICostModel::SCostingInfo *pci, ULONG ulId, DOUBLE dCost);
+
+			// solve the linear system rgdA * x = rgdB in place; the solution
+			// is returned in rgdB
+			static
+			void Solve(DOUBLE *rgdA, DOUBLE *rgdB, ULONG ulSize);
+
+		public:
+
+			// ctor; calibration starts at a copy of the given params and fits
+			// the params with the given ids, takes ownership of the ids
+			CCostModelCalibrator
+				(
+				IMemoryPool *pmp,
+				ULONG ulSegments,
+				const CCostModelParamsGPDB *pcp,
+				DrgPul *pdrgpulParams
+				);
+
+			// dtor
+			~CCostModelCalibrator();
+
+			// record the runtime of a plan fragment
+			void AddObservation
+				(
+				CExpressionHandle &exprhdl,
+				const ICostModel::SCostingInfo *pci,
+				CDouble dRuntime
+				);
+
+			// number of observations
+			ULONG UlObservations() const
+			{
+				return m_ulObservations;
+			}
+
+			// sum of squared residuals under the initial params
+			CDouble DSquaredError() const
+			{
+				return CDouble(m_dSquaredError);
+			}
+
+			// fit params to the observations; caller takes ownership
+			CCostModelParamsGPDB *PcpFit() const;
+
+	}; // class CCostModelCalibrator
+
+}
+
+#endif // !GPDBCOST_CCostModelCalibrator_H
+
+// EOF
@@ -75,6 +75,23 @@ namespace gpdbcost
 			static
 			const SCostMapping m_rgcm[];
 
+			// cost functions indexed by operator id, resolved from the array
+			// of mappings once per cost model instance
+			FnCost *m_rgpfnc[COperator::EopSentinel];
+
+			// cost of a unary operator, with the signature of a cost function
+			static
+			CCost CostUnaryOp(IMemoryPool *pmp, CExpressionHandle &exprhdl, const CCostModelGPDB *pcmgpdb, const SCostingInfo *pci);
+
+			// cost function of the given operator
+			FnCost *Pfnc(COperator::EOperatorId eopid) const
+			{
+				GPOS_ASSERT(COperator::EopSentinel > eopid);
+				GPOS_ASSERT(NULL != m_rgpfnc[eopid]);
+
+				return m_rgpfnc[eopid];
+			}
+
 			// return cost of processing the given number of rows
 			static
 			CCost CostTupleProcessing(DOUBLE dRows, DOUBLE dWidth, ICostModelParams *pcp);
@@ -222,6 +239,10 @@ namespace gpdbcost
 			virtual
 			CCost Cost(CExpressionHandle &exprhdl, const SCostingInfo *pci) const;
 
+			// cost a batch of expressions in one call
+			virtual
+			DrgPcost *PdrgpcostBatch(IMemoryPool *pmp, DrgPexprhdl *pdrgpexprhdl, DrgPcostinfo *pdrgpci) const;
+
 			// cost model type
 			virtual
 			ECostModelType Ecmt() const
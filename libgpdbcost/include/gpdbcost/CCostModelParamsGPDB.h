@@ -105,6 +105,11 @@ namespace gpopt
 				EcpSentinel
 			};
 
+			// version of the parameter set written to and accepted from
+			// calibration files
+			static
+			const ULONG ulCalibrationVersion;
+
 		private:
 
 			// memory pool
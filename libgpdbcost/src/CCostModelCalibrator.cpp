@@ -0,0 +1,367 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2018 Pivotal, Inc.
+//
+//	@filename:
+//		CCostModelCalibrator.cpp
+//
+//	@doc:
+//		Implementation of offline fitting of GPDB cost model params
+//---------------------------------------------------------------------------
+
+#include "gpos/base.h"
+#include "gpos/common/CAutoRg.h"
+
+#include "gpopt/operators/CExpressionHandle.h"
+
+#include "gpdbcost/CCostModelCalibrator.h"
+
+using namespace gpos;
+using namespace gpdbcost;
+
+// perturbation of a param when measuring sensitivities, relative to the
+// larger of the param's magnitude and the width of its bounds
+#define GPDBCOST_CALIBRATION_STEP	(1e-3)
+
+// regularization of the normal equations, relative to their diagonal,
+// for params that always contribute together to the observed costs
+#define GPDBCOST_CALIBRATION_RIDGE	(1e-9)
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCostModelCalibrator::CCostModelCalibrator
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+CCostModelCalibrator::CCostModelCalibrator
+	(
+	IMemoryPool *pmp,
+	ULONG ulSegments,
+	const CCostModelParamsGPDB *pcp,
+	DrgPul *pdrgpulParams
+	)
+	:
+	m_pmp(pmp),
+	m_pcm(NULL),
+	m_pdrgpulParams(pdrgpulParams),
+	m_rgdJtJ(NULL),
+	m_rgdJtr(NULL),
+	m_ulObservations(0),
+	m_dSquaredError(0.0)
+{
+	GPOS_ASSERT(NULL != pmp);
+	GPOS_ASSERT(NULL != pcp);
+	GPOS_ASSERT(NULL != pdrgpulParams);
+
+	m_pcm = GPOS_NEW(pmp) CCostModelGPDB(pmp, ulSegments, PcpCopy(pmp, pcp));
+
+	const ULONG ulParams = pdrgpulParams->UlLength();
+	m_rgdJtJ = GPOS_NEW_ARRAY(pmp, DOUBLE, ulParams * ulParams);
+	m_rgdJtr = GPOS_NEW_ARRAY(pmp, DOUBLE, ulParams);
+	for (ULONG ul = 0; ul < ulParams; ul++)
+	{
+		GPOS_ASSERT(CCostModelParamsGPDB::EcpSentinel > *(*pdrgpulParams)[ul]);
+
+		m_rgdJtr[ul] = 0.0;
+		for (ULONG ulOther = 0; ulOther < ulParams; ulOther++)
+		{
+			m_rgdJtJ[ul * ulParams + ulOther] = 0.0;
+		}
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCostModelCalibrator::~CCostModelCalibrator
+//
+//	@doc:
+//		Dtor
+//
+//---------------------------------------------------------------------------
+CCostModelCalibrator::~CCostModelCalibrator()
+{
+	GPOS_DELETE_ARRAY(m_rgdJtr);
+	GPOS_DELETE_ARRAY(m_rgdJtJ);
+	m_pdrgpulParams->Release();
+	m_pcm->Release();
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCostModelCalibrator::PcpCopy
+//
+//	@doc:
+//		Copy of the given params
+//
+//---------------------------------------------------------------------------
+CCostModelParamsGPDB *
+CCostModelCalibrator::PcpCopy
+	(
+	IMemoryPool *pmp,
+	const ICostModelParams *pcp
+	)
+{
+	CCostModelParamsGPDB *pcpCopy = GPOS_NEW(pmp) CCostModelParamsGPDB(pmp);
+	for (ULONG ul = 0; ul < CCostModelParamsGPDB::EcpSentinel; ul++)
+	{
+		ICostModelParams::SCostParam *pcparam = pcp->PcpLookup(ul);
+		pcpCopy->SetParam(ul, pcparam->DVal(), pcparam->DLowerBound(), pcparam->DUpperBound());
+	}
+
+	return pcpCopy;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCostModelCalibrator::DCost
+//
+//	@doc:
+//		Cost of a plan fragment under the current params
+//
+//---------------------------------------------------------------------------
+DOUBLE
+CCostModelCalibrator::DCost
+	(
+	CExpressionHandle &exprhdl,
+	const ICostModel::SCostingInfo *pci
+	)
+	const
+{
+	return m_pcm->Cost(exprhdl, pci).DVal();
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCostModelCalibrator::DSensitivity
+//
+//	@doc:
+//		Sensitivity of the cost of a plan fragment to a param, measured by
+//		a forward difference that stays within the param's bounds; params
+//		whose bounds leave no room to move have no sensitivity
+//
+//---------------------------------------------------------------------------
+DOUBLE
+CCostModelCalibrator::DSensitivity
+	(
+	CExpressionHandle &exprhdl,
+	const ICostModel::SCostingInfo *pci,
+	ULONG ulId,
+	DOUBLE dCost
+	)
+{
+	ICostModelParams *pcp = m_pcm->Pcp();
+	ICostModelParams::SCostParam *pcparam = pcp->PcpLookup(ulId);
+	const DOUBLE dVal = pcparam->DVal().DVal();
+	const DOUBLE dLowerBound = pcparam->DLowerBound().DVal();
+	const DOUBLE dUpperBound = pcparam->DUpperBound().DVal();
+
+	DOUBLE dStep = fabs(dVal);
+	if (dUpperBound - dLowerBound > dStep)
+	{
+		dStep = dUpperBound - dLowerBound;
+	}
+	dStep *= GPDBCOST_CALIBRATION_STEP;
+	if (dVal + dStep > dUpperBound)
+	{
+		dStep = -dStep;
+	}
+
+	if (0.0 == dStep || dVal + dStep < dLowerBound)
+	{
+		return 0.0;
+	}
+
+	pcp->SetParam(ulId, CDouble(dVal + dStep), CDouble(dLowerBound), CDouble(dUpperBound));
+	DOUBLE dCostPerturbed = DCost(exprhdl, pci);
+	pcp->SetParam(ulId, CDouble(dVal), CDouble(dLowerBound), CDouble(dUpperBound));
+
+	return (dCostPerturbed - dCost) / dStep;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCostModelCalibrator::AddObservation
+//
+//	@doc:
+//		Record the runtime of a plan fragment, i.e., add its sensitivities
+//		and residual to the normal equations
+//
+//---------------------------------------------------------------------------
+void
+CCostModelCalibrator::AddObservation
+	(
+	CExpressionHandle &exprhdl,
+	const ICostModel::SCostingInfo *pci,
+	CDouble dRuntime
+	)
+{
+	GPOS_ASSERT(NULL != pci);
+
+	const DOUBLE dCost = DCost(exprhdl, pci);
+	const DOUBLE dResidual = dRuntime.DVal() - dCost;
+	m_dSquaredError += dResidual * dResidual;
+
+	const ULONG ulParams = m_pdrgpulParams->UlLength();
+	CAutoRg<DOUBLE> a_rgdSensitivity;
+	a_rgdSensitivity = GPOS_NEW_ARRAY(m_pmp, DOUBLE, ulParams);
+	for (ULONG ul = 0; ul < ulParams; ul++)
+	{
+		a_rgdSensitivity[ul] = DSensitivity(exprhdl, pci, *(*m_pdrgpulParams)[ul], dCost);
+	}
+
+	for (ULONG ul = 0; ul < ulParams; ul++)
+	{
+		m_rgdJtr[ul] += a_rgdSensitivity[ul] * dResidual;
+		for (ULONG ulOther = 0; ulOther < ulParams; ulOther++)
+		{
+			m_rgdJtJ[ul * ulParams + ulOther] += a_rgdSensitivity[ul] * a_rgdSensitivity[ulOther];
+		}
+	}
+
+	m_ulObservations++;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCostModelCalibrator::Solve
+//
+//	@doc:
+//		Solve the linear system rgdA * x = rgdB by Gaussian elimination with
+//		partial pivoting; unknowns without a usable pivot are set to zero
+//
+//---------------------------------------------------------------------------
+void
+CCostModelCalibrator::Solve
+	(
+	DOUBLE *rgdA,
+	DOUBLE *rgdB,
+	ULONG ulSize
+	)
+{
+	for (ULONG ulCol = 0; ulCol < ulSize; ulCol++)
+	{
+		// find pivot row
+		ULONG ulPivot = ulCol;
+		for (ULONG ulRow = ulCol + 1; ulRow < ulSize; ulRow++)
+		{
+			if (fabs(rgdA[ulRow * ulSize + ulCol]) > fabs(rgdA[ulPivot * ulSize + ulCol]))
+			{
+				ulPivot = ulRow;
+			}
+		}
+
+		if (0.0 == rgdA[ulPivot * ulSize + ulCol])
+		{
+			continue;
+		}
+
+		if (ulPivot != ulCol)
+		{
+			for (ULONG ul = 0; ul < ulSize; ul++)
+			{
+				DOUBLE d = rgdA[ulPivot * ulSize + ul];
+				rgdA[ulPivot * ulSize + ul] = rgdA[ulCol * ulSize + ul];
+				rgdA[ulCol * ulSize + ul] = d;
+			}
+			DOUBLE d = rgdB[ulPivot];
+			rgdB[ulPivot] = rgdB[ulCol];
+			rgdB[ulCol] = d;
+		}
+
+		// eliminate column below pivot
+		for (ULONG ulRow = ulCol + 1; ulRow < ulSize; ulRow++)
+		{
+			const DOUBLE dFactor = rgdA[ulRow * ulSize + ulCol] / rgdA[ulCol * ulSize + ulCol];
+			for (ULONG ul = ulCol; ul < ulSize; ul++)
+			{
+				rgdA[ulRow * ulSize + ul] -= dFactor * rgdA[ulCol * ulSize + ul];
+			}
+			rgdB[ulRow] -= dFactor * rgdB[ulCol];
+		}
+	}
+
+	// back substitution
+	for (ULONG ulRow = ulSize; ulRow > 0; ulRow--)
+	{
+		const ULONG ul = ulRow - 1;
+		if (0.0 == rgdA[ul * ulSize + ul])
+		{
+			rgdB[ul] = 0.0;
+			continue;
+		}
+
+		DOUBLE dSum = rgdB[ul];
+		for (ULONG ulCol = ul + 1; ulCol < ulSize; ulCol++)
+		{
+			dSum -= rgdA[ul * ulSize + ulCol] * rgdB[ulCol];
+		}
+		rgdB[ul] = dSum / rgdA[ul * ulSize + ul];
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCostModelCalibrator::PcpFit
+//
+//	@doc:
+//		Fit params to the observations by solving the normal equations for
+//		the change of each fitted param; params no observation is sensitive
+//		to keep their value
+//
+//---------------------------------------------------------------------------
+CCostModelParamsGPDB *
+CCostModelCalibrator::PcpFit() const
+{
+	const ULONG ulParams = m_pdrgpulParams->UlLength();
+
+	CAutoRg<DOUBLE> a_rgdA;
+	CAutoRg<DOUBLE> a_rgdB;
+	a_rgdA = GPOS_NEW_ARRAY(m_pmp, DOUBLE, ulParams * ulParams);
+	a_rgdB = GPOS_NEW_ARRAY(m_pmp, DOUBLE, ulParams);
+	for (ULONG ul = 0; ul < ulParams * ulParams; ul++)
+	{
+		a_rgdA[ul] = m_rgdJtJ[ul];
+	}
+	for (ULONG ul = 0; ul < ulParams; ul++)
+	{
+		a_rgdB[ul] = m_rgdJtr[ul];
+		a_rgdA[ul * ulParams + ul] *= (1.0 + GPDBCOST_CALIBRATION_RIDGE);
+	}
+
+	Solve(a_rgdA.Rgt(), a_rgdB.Rgt(), ulParams);
+
+	CCostModelParamsGPDB *pcp = PcpCopy(m_pmp, m_pcm->Pcp());
+	for (ULONG ul = 0; ul < ulParams; ul++)
+	{
+		const ULONG ulId = *(*m_pdrgpulParams)[ul];
+		ICostModelParams::SCostParam *pcparam = pcp->PcpLookup(ulId);
+		const DOUBLE dLowerBound = pcparam->DLowerBound().DVal();
+		const DOUBLE dUpperBound = pcparam->DUpperBound().DVal();
+
+		DOUBLE dVal = pcparam->DVal().DVal() + a_rgdB[ul];
+		if (dVal < dLowerBound)
+		{
+			dVal = dLowerBound;
+		}
+		if (dVal > dUpperBound)
+		{
+			dVal = dUpperBound;
+		}
+
+		pcp->SetParam(ulId, CDouble(dVal), CDouble(dLowerBound), CDouble(dUpperBound));
+	}
+
+	return pcp;
+}
+
+// EOF
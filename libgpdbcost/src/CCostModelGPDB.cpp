@@ -125,6 +125,26 @@ CCostModelGPDB::CCostModelGPDB
 
 		m_pcp = pcp;
 	}
+
+	// resolve cost functions of all operators
+	for (ULONG ul = 0; ul < COperator::EopSentinel; ul++)
+	{
+		m_rgpfnc[ul] = NULL;
+		if (FUnary((COperator::EOperatorId) ul))
+		{
+			m_rgpfnc[ul] = CostUnaryOp;
+		}
+	}
+
+	const ULONG ulSize = GPOS_ARRAY_SIZE(m_rgcm);
+	for (ULONG ul = 0; ul < ulSize; ul++)
+	{
+		COperator::EOperatorId eopid = m_rgcm[ul].m_eopid;
+		if (NULL == m_rgpfnc[eopid])
+		{
+			m_rgpfnc[eopid] = m_rgcm[ul].m_pfnc;
+		}
+	}
 }
 
 
@@ -246,6 +266,29 @@ CCostModelGPDB::CostUnary
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CCostModelGPDB::CostUnaryOp
+//
+//	@doc:
+//		Cost of a unary operator, with the signature of a cost function
+//
+//---------------------------------------------------------------------------
+CCost
+CCostModelGPDB::CostUnaryOp
+	(
+	IMemoryPool *pmp,
+	CExpressionHandle &exprhdl,
+	const CCostModelGPDB *pcmgpdb,
+	const SCostingInfo *pci
+	)
+{
+	GPOS_ASSERT(NULL != pcmgpdb);
+
+	return CostUnary(pmp, exprhdl, pci, pcmgpdb->Pcp());
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CCostModelGPDB::CostSpooling
@@ -1560,26 +1603,55 @@ CCostModelGPDB::Cost
 {
 	GPOS_ASSERT(NULL != pci);
 
-	COperator::EOperatorId eopid = exprhdl.Pop()->Eopid();
-	if (FUnary(eopid))
-	{
-		return CostUnary(m_pmp, exprhdl, pci, m_pcp);
-	}
+	FnCost *pfnc = Pfnc(exprhdl.Pop()->Eopid());
 
-	FnCost *pfnc = NULL;
-	const ULONG ulSize = GPOS_ARRAY_SIZE(m_rgcm);
+	return pfnc(m_pmp, exprhdl, this, pci);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCostModelGPDB::PdrgpcostBatch
+//
+//	@doc:
+//		Cost a batch of expressions; the cost function is looked up once
+//		for each run of expressions with the same operator, e.g., all
+//		optimization requests of a group expression
+//
+//---------------------------------------------------------------------------
+DrgPcost *
+CCostModelGPDB::PdrgpcostBatch
+	(
+	IMemoryPool *pmp,
+	DrgPexprhdl *pdrgpexprhdl,
+	DrgPcostinfo *pdrgpci
+	)
+	const
+{
+	GPOS_ASSERT(NULL != pdrgpexprhdl);
+	GPOS_ASSERT(NULL != pdrgpci);
+	GPOS_ASSERT(pdrgpexprhdl->UlLength() == pdrgpci->UlLength());
 
-	// find the cost function corresponding to the given operator
-	for (ULONG ul = 0; pfnc == NULL && ul < ulSize; ul++)
+	DrgPcost *pdrgpcost = GPOS_NEW(pmp) DrgPcost(pmp);
+
+	COperator::EOperatorId eopidPrev = COperator::EopSentinel;
+	FnCost *pfnc = NULL;
+	const ULONG ulSize = pdrgpexprhdl->UlLength();
+	for (ULONG ul = 0; ul < ulSize; ul++)
 	{
-		if (eopid == m_rgcm[ul].m_eopid)
+		CExpressionHandle &exprhdl = *(*pdrgpexprhdl)[ul];
+		COperator::EOperatorId eopid = exprhdl.Pop()->Eopid();
+		if (eopid != eopidPrev)
 		{
-			pfnc = m_rgcm[ul].m_pfnc;
+			pfnc = Pfnc(eopid);
+			eopidPrev = eopid;
 		}
+
+		CCost cost = pfnc(m_pmp, exprhdl, this, (*pdrgpci)[ul]);
+		pdrgpcost->Append(GPOS_NEW(pmp) CCost(cost));
 	}
-	GPOS_ASSERT(NULL != pfnc);
 
-	return pfnc(m_pmp, exprhdl, this, pci);
+	return pdrgpcost;
 }
 
 // EOF
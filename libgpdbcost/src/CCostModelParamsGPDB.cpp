@@ -15,6 +15,9 @@
 
 using namespace gpopt;
 
+// version of the parameter set
+const ULONG CCostModelParamsGPDB::ulCalibrationVersion = 1;
+
 // sequential i/o bandwidth
 const CDouble CCostModelParamsGPDB::DSeqIOBandwidthVal = 1024.0;
 
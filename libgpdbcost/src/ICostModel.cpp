@@ -11,6 +11,8 @@
 
 #include "gpos/base.h"
 #include "gpos/string/CWStringConst.h"
+
+#include "gpopt/operators/CExpressionHandle.h"
 #include "gpdbcost/CCostModelGPDBLegacy.h"
 
 using namespace gpopt;
@@ -66,4 +68,37 @@ ICostModel::SetParams
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		ICostModel::PdrgpcostBatch
+//
+//	@doc:
+//		Cost a batch of expressions; by default, each expression is costed
+//		separately by the main driver
+//
+//---------------------------------------------------------------------------
+DrgPcost *
+ICostModel::PdrgpcostBatch
+	(
+	IMemoryPool *pmp,
+	DrgPexprhdl *pdrgpexprhdl,
+	DrgPcostinfo *pdrgpci
+	)
+	const
+{
+	GPOS_ASSERT(NULL != pdrgpexprhdl);
+	GPOS_ASSERT(NULL != pdrgpci);
+	GPOS_ASSERT(pdrgpexprhdl->UlLength() == pdrgpci->UlLength());
+
+	DrgPcost *pdrgpcost = GPOS_NEW(pmp) DrgPcost(pmp);
+	const ULONG ulSize = pdrgpexprhdl->UlLength();
+	for (ULONG ul = 0; ul < ulSize; ul++)
+	{
+		CCost cost = Cost(*(*pdrgpexprhdl)[ul], (*pdrgpci)[ul]);
+		pdrgpcost->Append(GPOS_NEW(pmp) CCost(cost));
+	}
+
+	return pdrgpcost;
+}
+
 // EOF
@@ -32,6 +32,11 @@ namespace gpopt
 	using namespace gpos;
 	using namespace gpmd;
 
+	class CConstraintInterval;
+
+	// interval array
+	typedef CDynamicPtrArray<CConstraintInterval, CleanupRelease> DrgPci;
+
 	//---------------------------------------------------------------------------
 	//	@class:
 	//		CConstraintInterval
@@ -124,6 +129,15 @@ namespace gpopt
 									CColRef *pcr
 									);
 
+			// union or intersection of the given intervals on the same column
+			static
+			CConstraintInterval *PciCombine
+									(
+									IMemoryPool *pmp,
+									DrgPci *pdrgpci,
+									BOOL fUnion
+									);
+
 			// create interval from scalar bool AND
 			static
 			CConstraintInterval *PciIntervalFromScalarBoolAnd
@@ -27,6 +27,7 @@ namespace gpopt
 	// forward declarations
 	class CColRefSet;
 	class COptimizerConfig;
+	class CScalarInternTable;
 	class ICostModel;
 	class IConstExprEvaluator;
 
@@ -84,6 +85,9 @@ namespace gpopt
 			// optimizer configurations
 			COptimizerConfig *m_poconf;
 
+			// interned scalar expressions, NULL if interning is disabled
+			CScalarInternTable *m_psit;
+
 			// whether or not we are optimizing a DML query
 			BOOL m_fDMLQuery;
 
@@ -164,6 +168,12 @@ namespace gpopt
 				return m_pcomp;
 			}
 
+			// interned scalar expressions, NULL if interning is disabled
+			CScalarInternTable *Psit() const
+			{
+				return m_psit;
+			}
+
 			// cte info
 			CCTEInfo *Pcteinfo()
 			{
@@ -328,15 +328,7 @@ namespace gpopt
 
 			// hash function used for computing stats during costing
 			static
-			ULONG UlHashForStats
-				(
-				const COptimizationContext *poc
-				)
-			{
-				GPOS_ASSERT(m_pocInvalid != poc);
-
-				return UlHash(*poc);
-			}
+			ULONG UlHashForStats(const COptimizationContext *poc);
 
 			// equality function used for computing stats during costing
 			static
@@ -350,9 +342,9 @@ namespace gpopt
 			static
 			BOOL FOptimize(IMemoryPool *pmp, CGroupExpression *pgexprParent, CGroupExpression *pgexprChild, COptimizationContext *pocChild, ULONG ulSearchStages);
 
-			// compare array of contexts based on context ids
+			// compare array of contexts
 			static
-			BOOL FEqualContextIds(DrgPoc *pdrgpocFst, DrgPoc *pdrgpocSnd);
+			BOOL FEqualContexts(DrgPoc *pdrgpocFst, DrgPoc *pdrgpocSnd);
 
 			// compute required properties to CTE producer based on plan properties of CTE consumer
 			static
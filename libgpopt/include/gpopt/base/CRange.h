@@ -16,6 +16,7 @@
 #include "gpos/common/CRefCount.h"
 
 #include "gpopt/base/CColRef.h"
+#include "gpopt/base/IComparator.h"
 #include "gpopt/operators/CExpression.h"
 
 #include "naucrates/md/IMDType.h"
@@ -75,9 +76,70 @@ namespace gpopt
 			// inclusion option for right end
 			ERangeInclusion m_eriRight;
 
+			// are the end points integers, compared through the keys below
+			BOOL m_fIntKeys;
+
+			// left end point as integer key, if any
+			LINT m_lLeft;
+
+			// right end point as integer key, if any
+			LINT m_lRight;
+
 			// hidden copy ctor
 			CRange(const CRange&);
 
+			// compute integer keys of end points if the range type allows it
+			void InitIntKeys();
+
+			// do this and the given range both have integer keys
+			BOOL FIntKeys
+				(
+				const CRange *prange
+				)
+				const
+			{
+				return m_fIntKeys && prange->m_fIntKeys;
+			}
+
+			// is the first end point less than the second one; compares the keys
+			// if the ranges of both end points have them, the datums otherwise
+			BOOL FLess
+				(
+				const IDatum *pdatumFst,
+				LINT lFst,
+				const IDatum *pdatumSnd,
+				LINT lSnd,
+				BOOL fIntKeys
+				)
+				const
+			{
+				if (fIntKeys)
+				{
+					return lFst < lSnd;
+				}
+
+				return m_pcomp->FLessThan(pdatumFst, pdatumSnd);
+			}
+
+			// are the given end points equal
+			BOOL FEqual
+				(
+				const IDatum *pdatumFst,
+				LINT lFst,
+				const IDatum *pdatumSnd,
+				LINT lSnd,
+				BOOL fIntKeys
+				)
+				const
+			{
+				if (fIntKeys)
+				{
+					return lFst == lSnd;
+				}
+
+				return m_pcomp->FEqual(pdatumFst, pdatumSnd);
+			}
+
 			// construct an equality predicate if possible
 			CExpression *PexprEquality(IMemoryPool *pmp, const CColRef *pcr);
 
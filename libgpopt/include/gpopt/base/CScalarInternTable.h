@@ -0,0 +1,121 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2018 Pivotal, Inc.
+//
+//	@filename:
+//		CScalarInternTable.h
+//
+//	@doc:
+//		Per-optimization table of interned scalar expressions
+//---------------------------------------------------------------------------
+#ifndef GPOPT_CScalarInternTable_H
+#define GPOPT_CScalarInternTable_H
+
+#include "gpos/base.h"
+#include "gpos/common/CLockFreeCache.h"
+
+namespace gpopt
+{
+	using namespace gpos;
+
+	// forward declarations
+	class CExpression;
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CScalarInternTable
+	//
+	//	@doc:
+	//		Hash-consing table of scalar expression trees, owned by the
+	//		optimizer context.
+	//
+	//		Interning an expression returns the first interned expression
+	//		that is equal to it with children in the same order, so equal
+	//		predicates built in different places share one node and compare
+	//		equal by pointer. Only trees of scalar operators allocated in the
+	//		optimizer's memory pool are interned, since the table keeps them
+	//		alive until the end of optimization; all other expressions are
+	//		returned as is.
+	//
+	//---------------------------------------------------------------------------
+	class CScalarInternTable
+	{
+		private:
+
+			// hash function of interned expressions
+			static
+			ULONG UlHash(const CExpression *pexpr);
+
+			// equality function of interned expressions
+			static
+			BOOL FEqual(const CExpression *pexprFst, const CExpression *pexprSnd);
+
+			// release an interned expression
+			static
+			void Release(CExpression *pexpr);
+
+			// cache of interned expressions; each expression is both key and value
+			typedef CLockFreeCache<CExpression, CExpression, UlHash, FEqual,
+						Release, Release> LfcExpr;
+
+			// memory pool
+			IMemoryPool *m_pmp;
+
+			// cache of interned expressions
+			LfcExpr m_cache;
+
+			// private copy ctor
+			CScalarInternTable(const CScalarInternTable &);
+
+			// check if expression tree consists of scalar operators only
+			static
+			BOOL FInternable(const CExpression *pexpr);
+
+		public:
+
+			// ctor
+			explicit
+			CScalarInternTable(IMemoryPool *pmp);
+
+			// dtor
+			~CScalarInternTable();
+
+			// return the interned expression equal to the given one, interning
+			// the given expression if there is none; takes ownership of the
+			// given expression and returns an expression owned by the caller
+			CExpression *PexprIntern(IMemoryPool *pmp, CExpression *pexpr);
+
+			// number of lookups
+			ULONG_PTR UlpLookups() const
+			{
+				return m_cache.UlpLookups();
+			}
+
+			// number of lookups that found an interned expression
+			ULONG_PTR UlpHits() const
+			{
+				return m_cache.UlpHits();
+			}
+
+			// number of interned expressions
+			ULONG_PTR UlpEntries() const
+			{
+				return m_cache.UlpEntries();
+			}
+
+			// print hit rate
+			IOstream &OsPrint
+				(
+				IOstream &os
+				)
+				const
+			{
+				return m_cache.OsPrint(os, "interned expressions");
+			}
+
+	}; // class CScalarInternTable
+}
+
+#endif // !GPOPT_CScalarInternTable_H
+
+// EOF
@@ -222,6 +222,10 @@ namespace gpopt
 			static
 			CExpression *PexprScalarIdent(IMemoryPool *pmp, const CColRef *pcr);
 
+			// intern the given scalar expression if scalar interning is enabled
+			static
+			CExpression *PexprIntern(IMemoryPool *pmp, CExpression *pexpr);
+
 			// generate a scalar project element expression
 			static
 			CExpression *PexprScalarProjectElement(IMemoryPool *pmp, CColRef *pcr, CExpression *pexpr);
@@ -470,6 +474,11 @@ namespace gpopt
 			static
 			BOOL FEqual(const CExpression *pexprLeft, const CExpression *pexprRight);
 
+			// deep equality of expression trees, where children of all operators
+			// must appear in the same order
+			static
+			BOOL FEqualOrdered(const CExpression *pexprLeft, const CExpression *pexprRight);
+
 			// compare expression against an array of expressions
 			static
 			BOOL FEqualAny(const CExpression *pexpr, const DrgPexpr *pdrgpexpr);
@@ -39,6 +39,14 @@ namespace gpopt
 	// dynamic array of cost model params
 	typedef CDynamicPtrArray<ICostModelParams::SCostParam, CleanupDelete> DrgPcp;
 
+	// delete an expression handle; defined out of line, since instantiating
+	// CleanupDelete on the incomplete handle type breaks translation units
+	// that never include the handle's header
+	void CleanupExprhdl(CExpressionHandle *pexprhdl);
+
+	// dynamic array of expression handles
+	typedef CDynamicPtrArray<CExpressionHandle, CleanupExprhdl> DrgPexprhdl;
+
 	//---------------------------------------------------------------------------
 	//	@class:
 	//		ICostModel
@@ -352,6 +360,9 @@ namespace gpopt
 
 			}; // struct SCostingInfo
 
+			// dynamic array of costing info
+			typedef CDynamicPtrArray<SCostingInfo, CleanupDelete> DrgPcostinfo;
+
 			// return number of hosts (nodes) that store data
 			virtual
 			ULONG UlHosts() const = 0;
@@ -367,6 +378,12 @@ namespace gpopt
 			// main driver for cost computation
 			virtual
 			CCost Cost(CExpressionHandle &exprhdl, const SCostingInfo *pci) const = 0;
+
+			// cost a batch of expressions, e.g., all group expressions of a
+			// group, in one call; the i-th cost in the returned array is the
+			// cost of the i-th handle under the i-th costing info
+			virtual
+			DrgPcost *PdrgpcostBatch(IMemoryPool *pmp, DrgPexprhdl *pdrgpexprhdl, DrgPcostinfo *pdrgpci) const;
 			
 			// cost model type
 			virtual
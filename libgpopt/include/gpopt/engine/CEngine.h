@@ -12,6 +12,7 @@
 #define GPOPT_CEngine_H
 
 #include "gpos/base.h"
+#include "gpos/common/CWallClock.h"
 #include "gpos/sync/CMutex.h"
 
 #include "gpopt/xforms/CXform.h"
@@ -28,12 +29,15 @@ namespace gpopt
 	class CExpression;
 	class CJob;
 	class CJobFactory;
+	class CJobProfiler;
 	class CPhysical;
 	class CQueryContext;
 	class COptimizationContext;
 	class CReqdPropPlan;
 	class CReqdPropRelational;
+	class CStatsCache;
 	class CEnumeratorConfig;
+	class COptimizerConfig;
 
 	//---------------------------------------------------------------------------
 	//	@class:
@@ -46,6 +50,12 @@ namespace gpopt
 	class CEngine
 	{	
 
+		public:
+
+			// callback receiving improving plans during optimization; the
+			// callee must add a reference to keep the plan
+			typedef void (FnPlanCallback)(void *pvArg, CExpression *pexprPlan);
+
 		private:
 
 			// memory pool
@@ -80,6 +90,42 @@ namespace gpopt
 			// mutex for locking shared data structures when updating optimization statistics
 			CMutex m_mutexOptStats;
 
+			// profiler of optimization jobs, NULL if jobs are not profiled
+			CJobProfiler *m_pjprof;
+
+			// number of group expression optimizations pruned before
+			// optimizing any child
+			volatile ULONG_PTR m_ulpPrunedBeforeChildren;
+
+			// number of group expression optimizations pruned after
+			// optimizing the first child
+			volatile ULONG_PTR m_ulpPrunedAfterChild;
+
+			// number of workers running optimization jobs
+			ULONG m_ulWorkers;
+
+			// optimization deadline in milliseconds, ulong_max if there is none
+			ULONG m_ulDeadline;
+
+			// wall clock measuring optimization time against the deadline; CPU
+			// time would add up the time of all workers
+			CWallClock m_timerDeadline;
+
+			// has a plan satisfying the query requirements been found
+			volatile BOOL m_fPlanFound;
+
+			// callback receiving improving plans, NULL if plans are not reported
+			FnPlanCallback *m_pfnplan;
+
+			// argument of plan callback
+			void *m_pvPlanArg;
+
+			// number of plans reported to plan callback
+			ULONG m_ulPlansReported;
+
+			// cost of last plan reported to plan callback
+			CCost m_costReported;
+
 #ifdef GPOS_DEBUG
 
 			// a set of internal debugging function used for recursive
@@ -160,6 +206,10 @@ namespace gpopt
 			// create and schedule the main optimization job
 			void ScheduleMainJob(CSchedulerContext *psc, COptimizationContext *poc);
 
+			// number of workers to use for optimization
+			static
+			ULONG UlOptimizationWorkers(COptimizerConfig *poconf);
+
 			// build memo using multiple threads
 			void MultiThreadedOptimize(ULONG ulWorkers = 4);
 
@@ -175,10 +225,18 @@ namespace gpopt
 			// check if search has terminated
 			BOOL FSearchTerminated() const
 			{
-				// at least one stage has completed and achieved required cost
-				return (NULL != PssPrevious() && PssPrevious()->FAchievedReqdCost());
+				// at least one stage has completed and achieved required cost,
+				// or optimization deadline has passed
+				return (NULL != PssPrevious() && PssPrevious()->FAchievedReqdCost()) ||
+						FDeadlineExceeded();
 			}
 
+			// extract best plan found at the end of current search stage
+			void SetStageBestExpr();
+
+			// pass plan to plan callback if it improves on the plans reported so far
+			void ReportPlan(CExpression *pexprPlan);
+
 			// generate random plan id
 			ULLONG UllRandomPlanId(ULONG *pulSeed);
 
@@ -363,12 +421,46 @@ namespace gpopt
 				return m_pqc;
 			}
 
+			// job profiler accessor
+			const CJobProfiler *Pjprof() const
+			{
+				return m_pjprof;
+			}
+
 			// return current search stage
 			CSearchStage *PssCurrent() const
 			{
 				return (*m_pdrgpss)[m_ulCurrSearchStage];
 			}
 
+			// check if optimization jobs must stop, because the current search
+			// stage timed out or the optimization deadline has passed
+			BOOL FTimedOut() const
+			{
+				return PssCurrent()->FTimedOut() || FDeadlineExceeded();
+			}
+
+			// set callback receiving improving plans; plans are reported at the
+			// end of each search stage and, when jobs run on a single worker,
+			// whenever a cheaper plan for the query is found
+			void SetPlanCallback(FnPlanCallback *pfnplan, void *pvArg)
+			{
+				m_pfnplan = pfnplan;
+				m_pvPlanArg = pvArg;
+			}
+
+			// check if optimization deadline has passed after a plan was found
+			BOOL FDeadlineExceeded() const;
+
+			// number of plans reported to plan callback
+			ULONG UlPlansReported() const
+			{
+				return m_ulPlansReported;
+			}
+
+			// process an update of the best cost context of an optimization context
+			void ProcessBestCostUpdate(COptimizationContext *poc);
+
 			// current search stage index accessor
 			ULONG UlCurrSearchStage() const
 			{
@@ -410,9 +502,25 @@ namespace gpopt
 				 m_pmemo->ResetTreeMap();
 			}
 
+			// stats computed during costing
+			CStatsCache *Pstatscache() const
+			{
+				return m_pmemo->Pstatscache();
+			}
+
 			// check if parent group expression can optimize child group expression
 			BOOL FOptimizeChild(CGroupExpression *pgexprParent, CGroupExpression *pgexprChild, COptimizationContext *pocChild, EOptimizationLevel eol);
 
+			// is cost-based space pruning enabled
+			static
+			BOOL FSpacePruning();
+
+			// number of group expression optimizations pruned based on cost bounds
+			ULONG_PTR UlpPruned() const
+			{
+				return m_ulpPrunedBeforeChildren + m_ulpPrunedAfterChild;
+			}
+
 			// determine if a plan, rooted by given group expression, can be safely pruned based on cost bounds
 			BOOL FSafeToPrune(CGroupExpression *pgexpr, CReqdPropPlan *prpp, CCostContext *pccChild, ULONG ulChildIndex, CCost *pcostLowerBound);
 
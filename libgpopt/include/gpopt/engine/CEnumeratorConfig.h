@@ -111,6 +111,12 @@ namespace gpopt
 			// size of plan space
 			ULLONG m_ullSpaceSize;
 
+			// number of memo groups at the end of the last optimization
+			ULONG m_ulMemoGroups;
+
+			// number of memo group expressions at the end of the last optimization
+			ULONG m_ulMemoGroupExprs;
+
 			// number of required samples
 			ULLONG m_ullInputSamples;
 
@@ -190,6 +196,29 @@ namespace gpopt
 				m_ullSpaceSize = ullSpaceSize;
 			}
 
+			// return number of memo groups of the last optimization
+			ULONG UlMemoGroups() const
+			{
+				return m_ulMemoGroups;
+			}
+
+			// return number of memo group expressions of the last optimization
+			ULONG UlMemoGroupExprs() const
+			{
+				return m_ulMemoGroupExprs;
+			}
+
+			// set memo size
+			void SetMemoSize
+				(
+				ULONG ulGroups,
+				ULONG ulGroupExprs
+				)
+			{
+				m_ulMemoGroups = ulGroups;
+				m_ulMemoGroupExprs = ulGroupExprs;
+			}
+
 			// return number of required samples
 			ULLONG UllInputSamples() const
 			{
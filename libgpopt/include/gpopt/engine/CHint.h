@@ -15,8 +15,17 @@
 #include "gpos/memory/IMemoryPool.h"
 #include "gpos/common/CRefCount.h"
 
+// largest n-ary join ordered by dynamic programming by default; enumeration
+// is bounded by pairs of connected sets and complements, of which a clique
+// of 10 relations has 28501, of 11 has 86526 and of 12 has 261625, beyond
+// GPOPT_DP_JOIN_ORDERING_MAX_PAIRS; chains stay far below the budget at any
+// size, but 11 relations would triple the worst case and any higher
+// threshold spends the whole budget on dense joins before falling back to
+// the greedy join order (see CJoinOrderTest::EresUnittest_DPEnumeration)
 #define JOIN_ORDER_DP_THRESHOLD ULONG(10)
 #define BROADCAST_THRESHOLD ULONG(10000000)
+#define OPTIMIZER_WORKERS ULONG(1)
+#define OPTIMIZATION_DEADLINE gpos::ulong_max
 
 namespace gpopt
 {
@@ -47,6 +56,10 @@ namespace gpopt
 
 			BOOL m_fEnforceConstraintsOnDML;
 
+			ULONG m_ulOptimizerWorkers;
+
+			ULONG m_ulOptimizationDeadline;
+
 			// private copy ctor
 			CHint(const CHint &);
 
@@ -60,7 +73,9 @@ namespace gpopt
 				ULONG ulArrayExpansionThreshold,
 				ULONG ulJoinOrderDPLimit,
 				ULONG ulBroadcastThreshold,
-				BOOL fEnforceConstraintsOnDML
+				BOOL fEnforceConstraintsOnDML,
+				ULONG ulOptimizerWorkers,
+				ULONG ulOptimizationDeadline
 				)
 				:
 				m_ulMinNumOfPartsToRequireSortOnInsert(ulMinNumOfPartsToRequireSortOnInsert),
@@ -68,7 +83,9 @@ namespace gpopt
 				m_ulArrayExpansionThreshold(ulArrayExpansionThreshold),
 				m_ulJoinOrderDPLimit(ulJoinOrderDPLimit),
 				m_ulBroadcastThreshold(ulBroadcastThreshold),
-				m_fEnforceConstraintsOnDML(fEnforceConstraintsOnDML)
+				m_fEnforceConstraintsOnDML(fEnforceConstraintsOnDML),
+				m_ulOptimizerWorkers(ulOptimizerWorkers),
+				m_ulOptimizationDeadline(ulOptimizationDeadline)
 			{
 			}
 
@@ -121,6 +138,24 @@ namespace gpopt
 				return m_fEnforceConstraintsOnDML;
 			}
 
+			// Number of worker tasks used to execute optimization jobs. With a
+			// single worker, all jobs run on the thread calling the optimizer;
+			// otherwise each worker owns a job queue and steals from the queues
+			// of other workers when its own runs dry.
+			ULONG UlOptimizerWorkers() const
+			{
+				return m_ulOptimizerWorkers;
+			}
+
+			// Wall-clock time in milliseconds after which optimization stops,
+			// even in the middle of a search stage, and returns the best plan
+			// found so far. The deadline only takes effect once a plan has been
+			// found, so optimization always produces a plan.
+			ULONG UlOptimizationDeadline() const
+			{
+				return m_ulOptimizationDeadline;
+			}
+
 			// generate default hint configurations, which disables sort during insert on
 			// append only row-oriented partitioned tables by default
 			static
@@ -132,7 +167,9 @@ namespace gpopt
 					gpos::int_max,			 /* ulArrayExpansionThreshold */
 					JOIN_ORDER_DP_THRESHOLD, /*ulJoinOrderDPLimit*/
 					BROADCAST_THRESHOLD,	 /*ulBroadcastThreshold*/
-					true					 /* fEnforceConstraintsOnDML */
+					true,					 /* fEnforceConstraintsOnDML */
+					OPTIMIZER_WORKERS,		 /* ulOptimizerWorkers */
+					OPTIMIZATION_DEADLINE	 /* ulOptimizationDeadline */
 				);
 			}
 
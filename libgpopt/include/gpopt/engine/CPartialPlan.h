@@ -66,6 +66,13 @@ namespace gpopt
 			// raise exception if the stats object is NULL
 			void RaiseExceptionIfStatsNull(IStatistics *pstats);
 
+			// attach handle to root group expression and compute costing info
+			ICostModel::SCostingInfo *PciCompute(IMemoryPool *pmp, ICostModel *pcm, CExpressionHandle &exprhdl);
+
+			// turn cost computed by cost model into a cost lower bound
+			static
+			CCost CostLowerBound(const ICostModel::SCostingInfo *pci, CCost cost);
+
 		public:
 
 			// ctor
@@ -108,6 +115,10 @@ namespace gpopt
 			// compute partial plan cost
 			CCost CostCompute(IMemoryPool *pmp);
 
+			// compute costs of an array of partial plans in one batch
+			static
+			DrgPcost *PdrgpcostCompute(IMemoryPool *pmp, CDynamicPtrArray<CPartialPlan, CleanupRelease> *pdrgppp);
+
 			// hash function used for cost bounding
 			static
 			ULONG UlHash(const CPartialPlan *ppp);
@@ -117,6 +128,9 @@ namespace gpopt
 			BOOL FEqual(const CPartialPlan *pppFst, const CPartialPlan *pppSnd);
 
 		}; // class CPartialPlan
+
+	// array of partial plans
+	typedef CDynamicPtrArray<CPartialPlan, CleanupRelease> DrgPpp;
 }
 
 
@@ -0,0 +1,179 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2018 Pivotal, Inc.
+//
+//	@filename:
+//		CConstExprEvaluatorNative.h
+//
+//	@doc:
+//		Constant expression evaluator for builtin integer, boolean and oid
+//		expressions
+//---------------------------------------------------------------------------
+
+#ifndef GPOPT_CConstExprEvaluatorNative_H
+#define GPOPT_CConstExprEvaluatorNative_H
+
+#include "gpos/base.h"
+
+#include "gpopt/eval/IConstExprEvaluator.h"
+
+#include "naucrates/md/IMDType.h"
+
+// objects with smaller oids are created by initdb and have fixed semantics
+#define GPDB_FIRST_NORMAL_OBJECT_ID OID(16384)
+
+namespace gpos
+{
+	class CWStringConst;
+}
+
+namespace gpmd
+{
+	class IMDId;
+}
+
+namespace gpopt
+{
+	using namespace gpmd;
+
+	class CExpression;
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CConstExprEvaluatorNative
+	//
+	//	@doc:
+	//		Constant expression evaluator that computes expressions over int2,
+	//		int4, int8, bool and oid values in process: constants, builtin
+	//		arithmetic and comparison operators, boolean operators, null and
+	//		boolean tests, and casts among these types, with NULL propagation.
+	//
+	//		Expressions using anything else, and expressions whose evaluation
+	//		fails, e.g., on overflow or division by zero, are passed to the
+	//		fallback evaluator, so errors are raised the same way as before.
+	//
+	//---------------------------------------------------------------------------
+	class CConstExprEvaluatorNative : public IConstExprEvaluator
+	{
+		private:
+
+			// value of a natively evaluated expression
+			struct SValue
+			{
+				// type of value
+				IMDType::ETypeInfo m_eti;
+
+				// is value NULL
+				BOOL m_fNull;
+
+				// value; booleans are 0 or 1, oids are not negative
+				LINT m_l;
+			};
+
+			// memory pool
+			IMemoryPool *m_pmp;
+
+			// evaluator for unsupported expressions, may be NULL
+			IConstExprEvaluator *m_pceevalFallback;
+
+			// private copy ctor
+			CConstExprEvaluatorNative(const CConstExprEvaluatorNative &);
+
+			// type info of a builtin type supported natively, EtiGeneric otherwise
+			static
+			IMDType::ETypeInfo Eti(IMDId *pmdidType);
+
+			// is the given function or operator created by initdb
+			static
+			BOOL FBuiltin(const IMDId *pmdid);
+
+			// does a value fit into the given type
+			static
+			BOOL FInRange(LINT l, IMDType::ETypeInfo eti);
+
+			// is the given type an integer type
+			static
+			BOOL FInt(IMDType::ETypeInfo eti);
+
+			// arithmetic operator given by name, or '\0' if the name is not
+			// one of +, -, *, /, %
+			static
+			WCHAR WcArith(const CWStringConst *pstrOp);
+
+			// compute an arithmetic operator; returns false on overflow and
+			// division by zero
+			static
+			BOOL FArith(WCHAR wcOp, LINT lLeft, LINT lRight, LINT *pl);
+
+			// cast a value to the given type
+			static
+			BOOL FCast(const SValue &valSrc, IMDType::ETypeInfo etiDest, SValue *pvalDest);
+
+			// can the given comparison operator compare the two values
+			static
+			BOOL FComparable(IMDId *pmdidOp, const SValue *rgval);
+
+			// evaluate children of an expression
+			static
+			BOOL FEvalChildren(CExpression *pexpr, SValue *rgval);
+
+			// evaluate specific operators
+			static
+			BOOL FEvalConst(CExpression *pexpr, SValue *pval);
+
+			static
+			BOOL FEvalOp(CExpression *pexpr, SValue *pval);
+
+			static
+			BOOL FEvalCmp(CExpression *pexpr, SValue *pval);
+
+			static
+			BOOL FEvalIsDistinctFrom(CExpression *pexpr, SValue *pval);
+
+			static
+			BOOL FEvalBoolOp(CExpression *pexpr, SValue *pval);
+
+			static
+			BOOL FEvalNullTest(CExpression *pexpr, SValue *pval);
+
+			static
+			BOOL FEvalBooleanTest(CExpression *pexpr, SValue *pval);
+
+			static
+			BOOL FEvalCast(CExpression *pexpr, SValue *pval);
+
+			// evaluate an expression; returns false if the expression is not
+			// supported or cannot be evaluated
+			static
+			BOOL FEval(CExpression *pexpr, SValue *pval);
+
+			// constant expression of the given type holding the given value
+			CExpression *PexprConst(IMDId *pmdidType, const SValue &val) const;
+
+		public:
+
+			// ctor; takes ownership of the fallback evaluator, if any
+			CConstExprEvaluatorNative(IMemoryPool *pmp, IConstExprEvaluator *pceevalFallback);
+
+			// dtor
+			virtual
+			~CConstExprEvaluatorNative();
+
+			// evaluate the given expression and return the result as a new expression
+			// caller takes ownership of returned expression
+			virtual
+			CExpression *PexprEval(CExpression *pexpr);
+
+			// returns true, since builtin expressions are evaluated natively
+			virtual
+			BOOL FCanEvalExpressions();
+
+			// can the given expression be evaluated without the fallback evaluator
+			static
+			BOOL FCanEvalNatively(CExpression *pexpr);
+	};
+}
+
+#endif // !GPOPT_CConstExprEvaluatorNative_H
+
+// EOF
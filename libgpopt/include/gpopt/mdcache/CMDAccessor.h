@@ -103,6 +103,9 @@ namespace gpopt
 
 		// cache accessor for objects in a MD cache
 		typedef CCacheAccessor<IMDCacheObject*, CMDKey*> CacheAccessorMD;
+
+		// array of mdid arrays, used for grouping prefetched mdids by provider
+		typedef CDynamicPtrArray<DrgPmdid, CleanupRelease> DrgPdrgPmdid;
 		
 		// hashtable for cache accessors indexed by the md id of the accessed object 
 		typedef CSyncHashtable<SMDAccessorElem, MdidPtr, CSpinlockMDAcc> MDHT;
@@ -234,6 +237,26 @@ namespace gpopt
 			// interface to a MD cache object
 			const IMDCacheObject *Pimdobj(IMDId *pmdid);
 
+			// fetch an object from its MD provider into the given memory pool
+			IMDCacheObject *PimdobjFetch(IMemoryPool *pmp, IMDId *pmdid);
+
+			// look up an object in the MD cache, adding it from the given
+			// prefetched encoding or the MD provider if missing
+			IMDCacheObject *PimdobjCached
+				(
+				CacheAccessorMD *pmdcacc,
+				IMDId *pmdid,
+				const BYTE *pbPrefetched,
+				ULONG ulSize
+				);
+
+			// store an object in the local hashtable, retrieving it from the MD
+			// cache or the MD provider
+			void Load(IMDId *pmdid);
+
+			// is the given object in the local hashtable or in the MD cache
+			BOOL FLoaded(IMDId *pmdid);
+
 			// return the type corresponding to the given type info and source system id
 			const IMDType *Pmdtype(CSystemId sysid, IMDType::ETypeInfo eti);
 
@@ -295,12 +318,21 @@ namespace gpopt
 				return m_pcache;
 			}
 
+			// number of MD objects pinned by the accessor
+			ULONG_PTR UlpObjects() const
+			{
+				return m_shtCacheAccessors.UlpEntries();
+			}
+
 			// register a new MD provider
 			void RegisterProvider(CSystemId sysid, IMDProvider *pmdp);
 			
 			// register given MD providers
 			void RegisterProviders(const DrgPsysid *pdrgpsysid, const DrgPmdp *pdrgpmdp);
 
+			// fetch a batch of metadata objects from their providers ahead of use
+			void Prefetch(const DrgPmdid *pdrgpmdid);
+
 			// interface to a relation object from the MD cache
 			const IMDRelation *Pmdrel(IMDId *pmdid);
 
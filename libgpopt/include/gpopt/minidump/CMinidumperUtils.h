@@ -42,6 +42,10 @@ namespace gpopt
 			static
 			CDXLMinidump *PdxlmdLoad(IMemoryPool *pmp, const CHAR *szFileName);
 			
+			// create the minidumps directory if it does not exist
+			static
+			void CreateMinidumpDirectory();
+
 			// generate a minidump file name in the provided buffer
 			static
 			void GenerateMinidumpFileName(CHAR *szBuf, ULONG ulLength, ULONG ulSessionId, ULONG ulCmdId, const CHAR *szMinidumpFileName = NULL);
@@ -14,6 +14,7 @@
 #define GPOPT_CExpressionPreprocessor_H
 
 #include "gpos/base.h"
+#include "gpos/common/CWallClock.h"
 #include "gpopt/base/CUtils.h"
 #include "gpopt/base/CColumnFactory.h"
 
@@ -206,6 +207,11 @@ namespace gpopt
 			static CExpression *
 			PexprReorderScalarCmpChildren(IMemoryPool *pmp, CExpression *pexpr);
 
+			// print the time and the tree sizes of a preprocessing step, if enabled,
+			// and restart the step timer
+			static
+			void ReportStep(const CHAR *szStep, CExpression *pexprIn, CExpression *pexprOut, CWallClock *pclock);
+
 			// private ctor
 			CExpressionPreprocessor();
 
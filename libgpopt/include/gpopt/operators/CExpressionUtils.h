@@ -26,6 +26,7 @@ namespace gpopt
 
 	// fwd declarations
 	class CExpression;
+	class COperator;
 
 	//---------------------------------------------------------------------------
 	//	@class:
@@ -71,6 +72,15 @@ namespace gpopt
 			// unnest AND/OR/NOT predicates
 			static
 			CExpression *PexprUnnest(IMemoryPool *pmp, CExpression *pexpr);
+
+			// return the given expression if the given operator and children are
+			// its own, otherwise create a new expression from them
+			static
+			CExpression *PexprRebuild(IMemoryPool *pmp, CExpression *pexpr, COperator *pop, DrgPexpr *pdrgpexprChildren);
+
+			// number of nodes in the given expression tree
+			static
+			ULONG UlNodes(const CExpression *pexpr);
 	};
 }
 
@@ -0,0 +1,79 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CCachedPlan.h
+//
+//	@doc:
+//		Plan stored in the plan cache
+//---------------------------------------------------------------------------
+
+
+
+#ifndef GPOPT_CCachedPlan_H
+#define GPOPT_CCachedPlan_H
+
+#include "gpos/base.h"
+#include "gpos/common/CRefCount.h"
+
+namespace gpopt
+{
+	using namespace gpos;
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CCachedPlan
+	//
+	//	@doc:
+	//		DXL document of an optimized plan, allocated in the memory pool
+	//		of its cache entry
+	//
+	//---------------------------------------------------------------------------
+	class CCachedPlan : public CRefCount
+	{
+		private:
+			// memory pool
+			IMemoryPool *m_pmp;
+
+			// DXL document of the plan
+			CHAR *m_szPlan;
+
+			// private copy ctor
+			CCachedPlan(const CCachedPlan &);
+
+		public:
+			// ctor; takes ownership of the document
+			CCachedPlan
+				(
+				IMemoryPool *pmp,
+				CHAR *szPlan
+				)
+				:
+				m_pmp(pmp),
+				m_szPlan(szPlan)
+			{
+				GPOS_ASSERT(NULL != szPlan);
+			}
+
+			// dtor
+			virtual
+			~CCachedPlan()
+			{
+				GPOS_DELETE_ARRAY(m_szPlan);
+			}
+
+			// DXL document of the plan
+			const CHAR *SzPlan() const
+			{
+				return m_szPlan;
+			}
+
+	}; // class CCachedPlan
+}
+
+
+
+#endif // !GPOPT_CCachedPlan_H
+
+// EOF
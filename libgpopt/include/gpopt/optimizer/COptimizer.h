@@ -35,7 +35,9 @@ namespace gpopt
 
 	// forward declarations
 	class ICostModel;
+	class CJobProfiler;
 	class COptimizerConfig;
+	class CPlanKey;
 
 	//---------------------------------------------------------------------------
 	//	@class:
@@ -48,7 +50,29 @@ namespace gpopt
 	class COptimizer
 	{
 		private:
-			
+
+			// context of translating improving plans for the plan callback
+			struct SPlanReportCtxt
+			{
+				// memory pool
+				IMemoryPool *m_pmp;
+
+				// MD accessor
+				CMDAccessor *m_pmda;
+
+				// query context
+				CQueryContext *m_pqc;
+
+				// names of output columns
+				DrgPmdname *m_pdrgpmdname;
+
+				// number of hosts
+				ULONG m_ulHosts;
+
+				// optimizer configuration holding the plan callback
+				COptimizerConfig *m_poconf;
+			};
+
 			// handle exception after finalizing minidump
 			static
 			void HandleExceptionAfterFinalizingMinidump(CException &ex);
@@ -59,9 +83,16 @@ namespace gpopt
 				(
 				IMemoryPool *pmp,
 				CQueryContext *pqc,
-				DrgPss *pdrgpss
+				DrgPss *pdrgpss,
+				ULONG ulSessionId,
+				ULONG ulCmdId,
+				SPlanReportCtxt *pprctxt
 				);
 
+			// translate an improving plan into DXL and pass it to the plan callback
+			static
+			void ReportPlan(void *pvCtxt, CExpression *pexprPlan);
+
 			// translate an optimizer expression into a DXL tree 
 			static
 			CDXLNode *Pdxln
@@ -86,6 +117,10 @@ namespace gpopt
 			static
 			void DumpSamples(IMemoryPool *pmp, CEnumeratorConfig *pec, ULONG ulSessionId, ULONG ulCmdId);
 
+			// helper function to dump the profile of optimization jobs
+			static
+			void DumpJobProfile(const CJobProfiler *pjprof, ULONG ulSessionId, ULONG ulCmdId);
+
 			// print query or plan tree
 			static
 			void PrintQueryOrPlan(IMemoryPool *pmp, CExpression *pexpr, CQueryContext *pqc = NULL);
@@ -93,6 +128,40 @@ namespace gpopt
 			// Check for a plan with CTE, if both CTEProducer and CTEConsumer are executed on the same locality.
 			static
 			void CheckCTEConsistency(IMemoryPool *pmp, CExpression *pexpr);
+
+			// canonical text of an optimization request used as plan cache key
+			static
+			CWStringDynamic *PstrPlanCacheKey
+				(
+				IMemoryPool *pmp,
+				const CDXLNode *pdxlnQuery,
+				const DrgPdxln *pdrgpdxlnQueryOutput,
+				const DrgPdxln *pdrgpdxlnCTE,
+				COptimizerConfig *poconf,
+				ULONG ulHosts
+				);
+
+			// serialized DXL document of a plan
+			static
+			CHAR *SzPlan(IMemoryPool *pmp, const CDXLNode *pdxlnPlan, COptimizerConfig *poconf);
+
+			// parse the serialized DXL document of a plan
+			static
+			CDXLNode *PdxlnPlan(IMemoryPool *pmp, const CHAR *szPlan);
+
+			// look up a plan in the plan cache
+			static
+			CDXLNode *PdxlnCachedPlan(IMemoryPool *pmp, const CPlanKey *pplankey);
+
+			// store a plan in the plan cache
+			static
+			void CachePlan
+				(
+				IMemoryPool *pmp,
+				const CPlanKey *pplankey,
+				const CDXLNode *pdxlnPlan,
+				COptimizerConfig *poconf
+				);
 		public:
 			
 			// main optimizer function 
@@ -22,6 +22,11 @@
 #include "gpopt/engine/CHint.h"
 #include "gpopt/base/CWindowOids.h"
 
+namespace gpdxl
+{
+	class CDXLNode;
+}
+
 namespace gpopt
 {
 	using namespace gpos;
@@ -29,6 +34,10 @@ namespace gpopt
 	// forward decl
 	class ICostModel;
 
+	// callback receiving improving plans of a query in DXL; the callee
+	// must add a reference to keep the plan
+	typedef void (FnDXLPlanCallback)(void *pvArg, gpdxl::CDXLNode *pdxlnPlan);
+
 	//---------------------------------------------------------------------------
 	//	@class:
 	//		COptimizerConfig
@@ -67,6 +76,12 @@ namespace gpopt
 			// default window oids
 			CWindowOids *m_pwindowoids;
 
+			// callback receiving improving plans, not part of minidumps
+			FnDXLPlanCallback *m_pfndxlplan;
+
+			// argument of plan callback
+			void *m_pvPlanArg;
+
 		public:
 
 			// ctor
@@ -121,6 +136,27 @@ namespace gpopt
 				return m_phint;
 			}
 
+			// set callback receiving the plans found while a query is optimized,
+			// each cheaper than the previous one; the last plan passed is not
+			// necessarily the final plan, which may be cheaper still
+			void SetPlanCallback(FnDXLPlanCallback *pfndxlplan, void *pvArg)
+			{
+				m_pfndxlplan = pfndxlplan;
+				m_pvPlanArg = pvArg;
+			}
+
+			// plan callback, NULL if plans are not reported
+			FnDXLPlanCallback *PfnPlanCallback() const
+			{
+				return m_pfndxlplan;
+			}
+
+			// argument of plan callback
+			void *PvPlanArg() const
+			{
+				return m_pvPlanArg;
+			}
+
 			// generate default optimizer configurations
 			static
 			COptimizerConfig *PoconfDefault(IMemoryPool *pmp);
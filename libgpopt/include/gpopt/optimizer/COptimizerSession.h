@@ -0,0 +1,122 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2018 Pivotal, Inc.
+//
+//	@filename:
+//		COptimizerSession.h
+//
+//	@doc:
+//		Optimization session for a batch of related queries
+//---------------------------------------------------------------------------
+#ifndef GPOPT_COptimizerSession_H
+#define GPOPT_COptimizerSession_H
+
+#include "gpos/base.h"
+
+#include "naucrates/dxl/operators/CDXLNode.h"
+
+#include "gpopt/mdcache/CMDAccessor.h"
+
+namespace gpopt
+{
+	using namespace gpos;
+	using namespace gpdxl;
+
+	// forward declarations
+	class COptimizerConfig;
+	class IConstExprEvaluator;
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		COptimizerSession
+	//
+	//	@doc:
+	//		Optimizes a batch of related queries, e.g., the statements of an
+	//		ETL job, with one MD accessor, configuration and constant
+	//		expression evaluator.
+	//
+	//		The MD accessor lives as long as the session, so metadata objects
+	//		are looked up and pinned once for the whole batch; they reflect
+	//		the metadata versions seen by the first statement using them.
+	//		Statements are optimized with the plan cache enabled, so a
+	//		statement repeating an earlier optimization request is served
+	//		from the cache if the host has initialized it.
+	//
+	//		Each statement is still optimized in its own optimization context
+	//		and memo, since column references, CTE info and partition ids are
+	//		private to a query.
+	//
+	//---------------------------------------------------------------------------
+	class COptimizerSession
+	{
+		private:
+
+			// memory pool
+			IMemoryPool *m_pmp;
+
+			// MD accessor shared by all statements
+			CMDAccessor m_mda;
+
+			// constant expression evaluator, may be NULL
+			IConstExprEvaluator *m_pceeval;
+
+			// number of hosts (data nodes) in the system
+			ULONG m_ulHosts;
+
+			// session id used for logging and minidumps
+			ULONG m_ulSessionId;
+
+			// optimizer configuration
+			COptimizerConfig *m_poconf;
+
+			// number of optimized statements
+			ULONG m_ulStatements;
+
+			// private copy ctor
+			COptimizerSession(const COptimizerSession &);
+
+		public:
+
+			// ctor; the session takes ownership of the evaluator and configuration
+			COptimizerSession
+				(
+				IMemoryPool *pmp,
+				const DrgPsysid *pdrgpsysid,
+				const DrgPmdp *pdrgpmdp,
+				IConstExprEvaluator *pceeval,
+				ULONG ulHosts,
+				ULONG ulSessionId,
+				COptimizerConfig *poconf
+				);
+
+			// dtor
+			~COptimizerSession();
+
+			// MD accessor shared by all statements
+			CMDAccessor *Pmda()
+			{
+				return &m_mda;
+			}
+
+			// optimize a statement of the batch; caller takes ownership of the plan
+			CDXLNode *PdxlnOptimize
+				(
+				const CDXLNode *pdxlnQuery,
+				const DrgPdxln *pdrgpdxlnQueryOutput,
+				const DrgPdxln *pdrgpdxlnCTE,
+				ULONG ulCmdId,
+				const CHAR *szMinidumpFileName = NULL
+				);
+
+			// number of optimized statements
+			ULONG UlStatements() const
+			{
+				return m_ulStatements;
+			}
+
+	}; // class COptimizerSession
+}
+
+#endif // !GPOPT_COptimizerSession_H
+
+// EOF
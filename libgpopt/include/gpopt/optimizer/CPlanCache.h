@@ -0,0 +1,152 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CPlanCache.h
+//
+//	@doc:
+//		Cross-query plan cache.
+//---------------------------------------------------------------------------
+
+
+
+#ifndef GPOPT_CPlanCache_H
+#define GPOPT_CPlanCache_H
+
+#include "gpos/base.h"
+#include "gpos/memory/CCache.h"
+#include "gpos/memory/CCacheAccessor.h"
+#include "gpos/memory/CCacheFactory.h"
+
+#include "gpopt/optimizer/CCachedPlan.h"
+#include "gpopt/optimizer/CPlanKey.h"
+
+namespace gpopt
+{
+	using namespace gpos;
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CPlanCache
+	//
+	//	@doc:
+	//		A wrapper for a generic cache holding the DXL plans of previously
+	//		optimized queries, keyed on the canonical text of the optimization
+	//		request. Metadata ids, including their versions, are part of the
+	//		serialized query; cached plans are dropped whenever the metadata
+	//		cache is reset.
+	//
+	//		The cache is created on demand by the host and is used for
+	//		queries optimized with EopttraceEnablePlanCache set.
+	//
+	//		COptimizerSession enables the cache for all statements of a batch
+	//		of related queries, so statements repeating an earlier request of
+	//		the batch are served from the cache.
+	//
+	//---------------------------------------------------------------------------
+	class CPlanCache
+	{
+		public:
+
+			// cache of serialized plans
+			typedef CCache<CCachedPlan*, CPlanKey*> PlanCache;
+
+			// accessor of the plan cache
+			typedef CCacheAccessor<CCachedPlan*, CPlanKey*> PlanCacheAccessor;
+
+		private:
+
+			// pointer to the underlying cache
+			static PlanCache *m_pcache;
+
+			// the maximum size of the cache
+			static ULLONG m_ullCacheQuota;
+
+			// number of lookups that found a plan
+			static volatile ULLONG m_ullHits;
+
+			// number of lookups that did not find a plan
+			static volatile ULLONG m_ullMisses;
+
+			// private ctor
+			CPlanCache()
+			{};
+
+			// no copy ctor
+			CPlanCache(const CPlanCache&);
+
+			// private dtor
+			~CPlanCache()
+			{};
+
+		public:
+
+			// initialize underlying cache
+			static
+			void Init();
+
+			// has cache been initialized?
+			static
+			BOOL FInitialized()
+			{
+				return (NULL != m_pcache);
+			}
+
+			// destroy global instance
+			static
+			void Shutdown();
+
+			// set the maximum size of the cache
+			static
+			void SetCacheQuota(ULLONG ullCacheQuota);
+
+			// get the maximum size of the cache
+			static
+			ULLONG ULLGetCacheQuota();
+
+			// get the number of times we evicted entries from this cache
+			static
+			ULLONG ULLGetCacheEvictionCounter();
+
+			// get the number of lookups that found a plan
+			static
+			ULLONG ULLGetCacheHitCounter()
+			{
+				return m_ullHits;
+			}
+
+			// get the number of lookups that did not find a plan
+			static
+			ULLONG ULLGetCacheMissCounter()
+			{
+				return m_ullMisses;
+			}
+
+			// reset global instance
+			static
+			void Reset();
+
+			// look up the plan for the given key; returns a copy of the
+			// serialized plan allocated in the given memory pool, or NULL
+			static
+			CHAR *SzLookup(IMemoryPool *pmp, const CPlanKey *pplankey);
+
+			// add the serialized plan for the given key
+			static
+			void Insert(const CPlanKey *pplankey, const CHAR *szPlan);
+
+			// global accessor
+			static
+			PlanCache *Pcache()
+			{
+				return m_pcache;
+			}
+
+	}; // class CPlanCache
+
+}  // namespace gpopt
+
+#endif // !GPOPT_CPlanCache_H
+
+// EOF
@@ -0,0 +1,88 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CPlanKey.h
+//
+//	@doc:
+//		Key for plans in the plan cache
+//---------------------------------------------------------------------------
+
+
+
+#ifndef GPOPT_CPlanKey_H
+#define GPOPT_CPlanKey_H
+
+#include "gpos/base.h"
+
+namespace gpopt
+{
+	using namespace gpos;
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CPlanKey
+	//
+	//	@doc:
+	//		Key for plans in the plan cache; a canonical text of the
+	//		optimization request consisting of the serialized query, the
+	//		optimizer configuration and the number of segments. The key does
+	//		not own the text.
+	//
+	//---------------------------------------------------------------------------
+	class CPlanKey
+	{
+		private:
+			// canonical text of the optimization request
+			const WCHAR *m_wsz;
+
+			// length of the text in characters
+			ULONG m_ulLength;
+
+			// hash value of the text
+			ULONG m_ulHash;
+
+		public:
+			// ctor
+			CPlanKey(const WCHAR *wsz, ULONG ulLength);
+
+			// dtor
+			~CPlanKey()
+			{}
+
+			// canonical text
+			const WCHAR *Wsz() const
+			{
+				return m_wsz;
+			}
+
+			// length of the text
+			ULONG UlLength() const
+			{
+				return m_ulLength;
+			}
+
+			// equality function
+			BOOL FEquals(const CPlanKey &plankey) const;
+
+			// hash function
+			ULONG UlHash() const
+			{
+				return m_ulHash;
+			}
+
+			// equality function for using plan keys in a cache
+			static BOOL FEqualPlanKey(CPlanKey* const &pvLeft, CPlanKey* const &pvRight);
+
+			// hash function for using plan keys in a cache
+			static ULONG UlHashPlanKey(CPlanKey* const & pv);
+
+	};
+}
+
+
+
+#endif // !GPOPT_CPlanKey_H
+
+// EOF
@@ -12,12 +12,11 @@
 #define GPOPT_CGroup_H
 
 #include "gpos/base.h"
-#include "gpos/sync/CMutex.h"
 
 #include "naucrates/statistics/CStatistics.h"
 
 #include "gpos/common/CDynamicPtrArray.h"
-#include "gpos/common/CSyncHashtable.h"
+#include "gpos/common/CLockFreeHashtable.h"
 #include "gpos/common/CSyncList.h"
 #include "gpos/sync/atomic.h"
 #include "gpos/sync/CSpinlock.h"
@@ -46,6 +45,7 @@ namespace gpopt
 	class CReqdPropPlan;
 	class CReqdPropRelational;
 	class CExpression;
+	class CStatsCache;
 
 	// type definitions
 	// array of groups
@@ -84,10 +84,10 @@ namespace gpopt
 
 			// type definition of optimization context hash table
 			typedef
-				CSyncHashtable<
+				CLockFreeHashtable<
 					COptimizationContext, // entry
-					COptimizationContext, // search key
-					CSpinlockOC> ShtOC;
+					COptimizationContext> // search key
+					LfhtOC;
 
 			// states of a group
 			enum EState
@@ -109,27 +109,6 @@ namespace gpopt
 
 		private:
 
-			// definition of hash table iter
-			typedef
-				CSyncHashtableIter<
-					COptimizationContext, // entry
-					COptimizationContext , // search key
-					CSpinlockOC> ShtIter;
-
-			// definition of hash table iter accessor
-			typedef
-				CSyncHashtableAccessByIter<
-					COptimizationContext, // entry
-					COptimizationContext, // search key
-					CSpinlockOC> ShtAccIter;
-
-			// definition of hash table accessor
-			typedef
-				CSyncHashtableAccessByKey<
-					COptimizationContext, // entry
-					COptimizationContext, // search key
-					CSpinlockOC> ShtAcc;
-
 			//---------------------------------------------------------------------------
 			//	@class:
 			//		SContextLink
@@ -179,10 +158,6 @@ namespace gpopt
 			typedef CHashMap<SContextLink, BOOL, SContextLink::UlHash, SContextLink::FEqual,
 							CleanupDelete<SContextLink>, CleanupDelete<BOOL> > LinkMap;
 
-			// map of computed stats objects during costing
-			typedef CHashMap<COptimizationContext, IStatistics, COptimizationContext::UlHashForStats, COptimizationContext::FEqualForStats,
-							CleanupRelease<COptimizationContext>, CleanupRelease<IStatistics> > StatsMap;
-
 			// memory pool
 			IMemoryPool *m_pmp;
 
@@ -223,15 +198,11 @@ namespace gpopt
 			// map of processed links
 			LinkMap *m_plinkmap;
 
-			// map of computed stats during costing
-			StatsMap *m_pstatsmap;
-
-			// mutex for locking stats map when adding a new entry
-			CMutex m_mutexStats;
-
+			// memo-wide cache of stats computed during costing
+			CStatsCache *m_pstatscache;
 
 			// hashtable of optimization contexts
-			ShtOC m_sht;
+			LfhtOC m_lfht;
 
 			// spin lock to protect operations on expression list
 			CSpinlockGroup m_slock;
@@ -292,6 +263,9 @@ namespace gpopt
 			// insert new group expression
 			void Insert(CGroupExpression *pgexpr);
 
+			// remove group expression whose insertion into memo failed
+			void Remove(CGroupExpression *pgexpr);
+
 			// move duplicate group expression to duplicates list
 			void MoveDuplicateGExpr(CGroupExpression *pgexpr);
 
@@ -367,7 +341,7 @@ namespace gpopt
 		public:
 
 			// ctor
-			CGroup(IMemoryPool *pmp, BOOL fScalar = false);
+			CGroup(IMemoryPool *pmp, CStatsCache *pstatscache, BOOL fScalar = false);
 			
 			// dtor
 			~CGroup();
@@ -441,9 +415,16 @@ namespace gpopt
 			}
 			
 			// optimization contexts hash table accessor
-			ShtOC &Sht()
+			LfhtOC &Lfht()
+			{
+				return m_lfht;
+			}
+
+			// number of optimization context insertions retried due to
+			// concurrent insertions
+			ULONG_PTR UlpInsertRetries() const
 			{
-				return m_sht;
+				return m_lfht.UlpInsertRetries();
 			}
 
 			// exploration job queue accessor
@@ -258,6 +258,17 @@ namespace gpopt
 			// compute a cost lower bound for plans, rooted by current group expression, and satisfying the given required properties
 			CCost CostLowerBound(IMemoryPool *pmp, CReqdPropPlan *prppInput, CCostContext *pccChild, ULONG ulChildIndex);
 
+			// lookup cost lower bound of a partial plan rooted by current group
+			// expression; returns NULL if the bound was not computed yet
+			const CCost *PcostLowerBound(CPartialPlan *ppp) const
+			{
+				return m_ppartialplancostmap->PtLookup(ppp);
+			}
+
+			// store cost lower bound of a partial plan rooted by current group
+			// expression, takes ownership of the partial plan
+			void StoreCostLowerBound(IMemoryPool *pmp, CPartialPlan *ppp, CCost cost);
+
 			// initialize group expression
 			void Init(CGroup *pgroup, ULONG ulId);
 
@@ -80,6 +80,15 @@ namespace gpopt
 			// insert group expression
 			void Insert(CGroupExpression *pgexpr);
 
+			// remove group expression whose insertion into memo failed
+			void Remove
+				(
+				CGroupExpression *pgexpr
+				)
+			{
+				m_pgroup->Remove(pgexpr);
+			}
+
 			// move duplicate group expression to duplicates list
 			void MoveDuplicateGExpr(CGroupExpression *pgexpr);
 
@@ -20,9 +20,11 @@ namespace gpopt
 	using namespace gpos;
 	
 	// prototypes
+	class CGroup;
 	class CJobQueue;
 	class CScheduler;
 	class CSchedulerContext;
+	class CXform;
 
 	//---------------------------------------------------------------------------
 	//	@class:
@@ -294,6 +296,20 @@ namespace gpopt
 			virtual
 			void Cleanup() {}
 
+			// group the job works on, if any
+			virtual
+			CGroup *Pgroup() const
+			{
+				return NULL;
+			}
+
+			// xform applied by the job, if any
+			virtual
+			CXform *Pxform() const
+			{
+				return NULL;
+			}
+
 #ifdef GPOS_DEBUG
 			// print job description
 			virtual
@@ -88,6 +88,15 @@ namespace gpopt
 
 #endif // GPOS_DEBUG
 
+		public:
+
+			// target group accessor
+			virtual
+			CGroup *Pgroup() const
+			{
+				return m_pgroup;
+			}
+
 	}; // class CJobGroup
 
 }
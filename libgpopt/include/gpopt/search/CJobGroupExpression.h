@@ -113,6 +113,12 @@ namespace gpopt
 
 #endif // GPOS_DEBUG
 
+		public:
+
+			// group of target group expression
+			virtual
+			CGroup *Pgroup() const;
+
 	}; // class CJobGroupExpression
 
 }
@@ -0,0 +1,152 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2018 Pivotal, Inc.
+//
+//	@filename:
+//		CJobProfiler.h
+//
+//	@doc:
+//		Profiler of optimization jobs run by the scheduler
+//---------------------------------------------------------------------------
+#ifndef GPOPT_CJobProfiler_H
+#define GPOPT_CJobProfiler_H
+
+#include "gpos/base.h"
+#include "gpos/common/CHashMap.h"
+#include "gpos/common/CHashMapIter.h"
+
+#include "gpopt/search/CJob.h"
+#include "gpopt/xforms/CXform.h"
+
+namespace gpopt
+{
+	using namespace gpos;
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CJobProfiler
+	//
+	//	@doc:
+	//		Records the number of executions, wall time and memory allocated by
+	//		optimization jobs, keyed by job type, memo group and xform.
+	//
+	//		Every execution slice of a job, i.e., every call to CJob::FExecute,
+	//		is recorded separately; since child jobs are scheduled rather than
+	//		run inline, the time of a slice is the job's own time.
+	//
+	//		Each worker records into its own map, so workers do not synchronize;
+	//		maps are merged when a report is generated. Memory is measured as
+	//		the growth of the global memory pool during the slice, which is only
+	//		approximate when several workers run concurrently.
+	//
+	//---------------------------------------------------------------------------
+	class CJobProfiler
+	{
+		public:
+
+			// profiled counters
+			struct SStats
+			{
+				// number of executions
+				ULLONG m_ullExecutions;
+
+				// wall time in micro-seconds
+				ULLONG m_ullTimeUS;
+
+				// bytes allocated
+				ULLONG m_ullBytes;
+
+				// ctor
+				SStats()
+					:
+					m_ullExecutions(0),
+					m_ullTimeUS(0),
+					m_ullBytes(0)
+				{}
+
+				// add counters of another entry
+				void Add(const SStats &stats)
+				{
+					m_ullExecutions += stats.m_ullExecutions;
+					m_ullTimeUS += stats.m_ullTimeUS;
+					m_ullBytes += stats.m_ullBytes;
+				}
+			};
+
+		private:
+
+			// map of profile key to counters
+			typedef CHashMap<ULLONG, SStats, gpos::UlHash<ULLONG>, gpos::FEqual<ULLONG>,
+						CleanupDelete<ULLONG>, CleanupDelete<SStats> > HMUllStats;
+
+			// iterator over profile map
+			typedef CHashMapIter<ULLONG, SStats, gpos::UlHash<ULLONG>, gpos::FEqual<ULLONG>,
+						CleanupDelete<ULLONG>, CleanupDelete<SStats> > HMUllStatsIter;
+
+			// memory pool
+			IMemoryPool *m_pmp;
+
+			// number of workers
+			ULONG m_ulWorkers;
+
+			// per-worker profile maps
+			HMUllStats **m_rgphm;
+
+			// profile key of a job type, group id and xform id
+			static
+			ULLONG UllKey(CJob::EJobType ejt, ULONG ulGroupId, ULONG ulXformId);
+
+			// components of a profile key
+			static
+			CJob::EJobType EjtKey(ULLONG ullKey);
+
+			static
+			ULONG UlGroupIdKey(ULLONG ullKey);
+
+			static
+			ULONG UlXformIdKey(ULLONG ullKey);
+
+			// add counters to the entry of the given key
+			static
+			void Accumulate(IMemoryPool *pmp, HMUllStats *phm, ULLONG ullKey, const SStats &stats);
+
+			// merge maps of all workers into a new map
+			HMUllStats *PhmMerge() const;
+
+			// private copy ctor
+			CJobProfiler(const CJobProfiler &);
+
+		public:
+
+			// ctor
+			CJobProfiler(IMemoryPool *pmp, ULONG ulWorkers);
+
+			// dtor
+			~CJobProfiler();
+
+			// record an execution slice of the given job by the given worker
+			void Record(ULONG ulWorker, CJob *pj, ULONG ulTimeUS, ULLONG ullBytes);
+
+			// counters of a job type, summed over all groups and xforms
+			SStats StatsJobType(CJob::EJobType ejt) const;
+
+			// counters of an xform, summed over all groups
+			SStats StatsXform(CXform::EXformId exfid) const;
+
+			// print counters per job type and per xform
+			IOstream &OsPrint(IOstream &os) const;
+
+			// print wall time in folded stacks format, one line per
+			// group, job type and xform, to be rendered as a flame graph
+			IOstream &OsPrintFolded(IOstream &os) const;
+
+			// name of a job type
+			static
+			const CHAR *SzJobType(CJob::EJobType ejt);
+
+	}; // class CJobProfiler
+}
+
+#endif // !GPOPT_CJobProfiler_H
+
+// EOF
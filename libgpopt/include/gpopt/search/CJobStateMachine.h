@@ -153,8 +153,9 @@ namespace gpopt
                 TEnumState estNext = estSentinel;
                 do
                 {
-                    // check if current search stage is timed-out
-                    if (psc->Peng()->PssCurrent()->FTimedOut())
+                    // check if current search stage is timed-out or the
+                    // optimization deadline has passed
+                    if (psc->Peng()->FTimedOut())
                     {
                         // cleanup job state and terminate state machine
                         pjOwner->Cleanup();
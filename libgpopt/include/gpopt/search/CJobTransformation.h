@@ -100,6 +100,17 @@ namespace gpopt
 			virtual
 			BOOL FExecute(CSchedulerContext *psc);
 
+			// group of target group expression
+			virtual
+			CGroup *Pgroup() const;
+
+			// xform accessor
+			virtual
+			CXform *Pxform() const
+			{
+				return m_pxform;
+			}
+
 #ifdef GPOS_DEBUG
 
 			// print function
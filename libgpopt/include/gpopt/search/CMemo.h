@@ -13,7 +13,7 @@
 
 #include "gpos/base.h"
 #include "gpos/common/CRefCount.h"
-#include "gpos/common/CSyncHashtable.h"
+#include "gpos/common/CLockFreeHashtable.h"
 #include "gpos/common/CSyncList.h"
 #include "gpos/sync/CAtomicCounter.h"
 
@@ -27,6 +27,7 @@ namespace gpopt
 	class CDrvdPropCtxtPlan;
 	class CMemoProxy;
 	class COptimizationContext;
+	class CStatsCache;
 
 	// memo tree map definition
 	typedef CTreeMap<CCostContext, CExpression, CDrvdPropCtxtPlan, CCostContext::UlHash, CCostContext::FEqual> MemoTreeMap;
@@ -45,26 +46,12 @@ namespace gpopt
 	{
 		private:
 		
-			// definition of hash table key accessor
+			// definition of group expression hash table
 			typedef
-					CSyncHashtableAccessByKey<
+					CLockFreeHashtable<
 						CGroupExpression, // entry
-						CGroupExpression, // search key
-						CSpinlockMemo> ShtAcc;
-
-			// definition of hash table iterator
-			typedef
-					CSyncHashtableIter<
-						CGroupExpression, // entry
-						CGroupExpression, // search key
-						CSpinlockMemo> ShtIter;
-
-			// definition of hash table iterator accessor
-			typedef
-					CSyncHashtableAccessByIter<
-						CGroupExpression, // entry
-						CGroupExpression, // search key
-						CSpinlockMemo> ShtAccIter;
+						CGroupExpression> // search key
+						LfhtGExpr;
 
 			// memory pool
 			IMemoryPool *m_pmp;
@@ -85,13 +72,13 @@ namespace gpopt
 			CSyncList<CGroup> m_listGroups;
 
 			// hashtable of all group expressions
-			CSyncHashtable<
-				CGroupExpression, // entry
-				CGroupExpression, // search key
-				CSpinlockMemo> m_sht;
+			LfhtGExpr m_lfht;
+
+			// stats computed during costing, shared by all groups
+			CStatsCache *m_pstatscache;
 
-			// add new group
-			void Add(CGroup *pgroup, CExpression *pexprOrigin);
+			// set up new group around its first group expression
+			void InitGroup(CGroup *pgroup, CGroupExpression *pgexpr, CExpression *pexprOrigin);
 
 			// rehash all group expressions after group merge - not thread-safe
 			BOOL FRehash();
@@ -129,6 +116,23 @@ namespace gpopt
 			// return total number of group expressions
 			ULONG UlGrpExprs();
 
+			// return number of group expression insertions retried due to
+			// concurrent insertions into the same hash bucket
+			ULONG_PTR UlpInsertRetries() const
+			{
+				return m_lfht.UlpInsertRetries();
+			}
+
+			// stats computed during costing
+			CStatsCache *Pstatscache() const
+			{
+				return m_pstatscache;
+			}
+
+			// return number of optimization context insertions retried due
+			// to concurrent insertions, summed over all groups
+			ULONG_PTR UlpContextInsertRetries();
+
 			// return number of duplicate groups
 			ULONG UlDuplicateGroups();
 
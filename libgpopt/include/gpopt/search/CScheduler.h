@@ -12,11 +12,12 @@
 #define GPOPT_CScheduler_H
 
 #include "gpos/base.h"
-#include "gpos/common/CSyncList.h"
+#include "gpos/common/CList.h"
 #include "gpos/common/CSyncPool.h"
 #include "gpos/sync/CEvent.h"
 
 #include "gpopt/search/CJob.h"
+#include "gpopt/spinlock.h"
 
 #define OPT_SCHED_QUEUED_RUNNING_RATIO 10
 #define OPT_SCHED_CFA 100
@@ -26,6 +27,7 @@ namespace gpopt
 	using namespace gpos;
 	
 	// prototypes
+	class CJobProfiler;
 	class CSchedulerContext;
 
 	//---------------------------------------------------------------------------
@@ -52,6 +54,12 @@ namespace gpopt
 	//		complete. At this point, a queued job can be terminated if it does not
 	//		have any further dependencies.
 	//
+	//		Each worker owns a queue of runnable jobs. Jobs spawned or resumed
+	//		by a worker are pushed to the tail of its own queue, and the worker
+	//		keeps popping from that tail (depth-first, cache-friendly). A worker
+	//		whose queue is empty steals the oldest job from the head of another
+	//		worker's queue, so workers only contend when work is scarce.
+	//
 	//---------------------------------------------------------------------------
 	class CScheduler
 	{	
@@ -72,7 +80,7 @@ namespace gpopt
 
 		private:
 
-			// job wrapper; used for inserting job to waiting list (lock-free)
+			// job wrapper; used for inserting job to waiting list
 			struct SJobLink
 			{
 				// link id, set by sync set
@@ -92,12 +100,26 @@ namespace gpopt
 				}
 			};
 
+			// queue of jobs waiting to execute, owned by a single worker;
+			// the owner pushes and pops at the tail, thieves pop at the head
+			struct SWorkerQueue
+			{
+				// spinlock protecting the list
+				CSpinlockSchedulerQueue m_slock;
+
+				// list of waiting jobs
+				CList<SJobLink> m_listjl;
+			};
+
+			// memory pool
+			IMemoryPool *m_pmp;
+
 			// mutex and event mechanism for individual workers
 			CMutex m_mutex;
 			CEvent m_event;
-					
-			// list of jobs waiting to execute
-			CSyncList<SJobLink> m_listjlWaiting;
+
+			// per-worker queues of jobs waiting to execute
+			SWorkerQueue *m_rgwq;
 
 			// pool of job link objects
 			CSyncPool<SJobLink> m_spjl;
@@ -120,6 +142,10 @@ namespace gpopt
 			volatile ULONG_PTR m_ulpStatsCompleted;
 			volatile ULONG_PTR m_ulpStatsCompletedQueued;
 			volatile ULONG_PTR m_ulpStatsResumed;
+			volatile ULONG_PTR m_ulpStatsStolen;
+
+			// profiler of job executions, not owned; NULL if not profiling
+			CJobProfiler *m_pjprof;
 
 #ifdef GPOS_DEBUG
 			// list of running jobs
@@ -147,11 +173,17 @@ namespace gpopt
 				BOOL fCompleted
 				);
 
-			// retrieve next job to run
-			CJob *PjRetrieve();
+			// retrieve next job to run for the given worker
+			CJob *PjRetrieve(ULONG ulWorker);
+
+			// pop most recently queued job from the given worker's queue
+			SJobLink *PjlPop(ULONG ulWorker);
+
+			// steal oldest queued job from the queue of another worker
+			SJobLink *PjlSteal(ULONG ulWorker);
 
-			// schedule job for execution
-			void Schedule(CJob *pj);
+			// schedule job for execution on the given worker's queue
+			void Schedule(CJob *pj, ULONG ulWorker);
 
 			// prepare for job execution
 			void PreExecute(CJob *pj);
@@ -159,11 +191,20 @@ namespace gpopt
 			// execute job
 			BOOL FExecute(CJob *pj, CSchedulerContext *psc);
 
+			// execute job and record its time and memory in the profiler
+			BOOL FExecuteProfiled(CJob *pj, CSchedulerContext *psc);
+
 			// process job execution outcome
 			EJobResult EjrPostExecute(CJob *pj, BOOL fCompleted);
 
 			// resume parent job
-			void ResumeParent(CJob *pj);
+			void ResumeParent(CJob *pj, ULONG ulWorker);
+
+			// map worker index to one of the scheduler's queues
+			ULONG UlQueue(ULONG ulWorker) const
+			{
+				return ulWorker % (ULONG) m_ulpTasksMax;
+			}
 
 			// check if all jobs have completed
 			BOOL FEmpty() const
@@ -220,22 +261,34 @@ namespace gpopt
 			void *Run(void*);
 
 			// transition job to completed
-			void Complete(CJob *pj);
+			void Complete(CJob *pj, ULONG ulWorker);
 
 			// transition queued job to completed
-			void CompleteQueued(CJob *pj);
+			void CompleteQueued(CJob *pj, ULONG ulWorker);
 
 			// transition job to suspended
 			void Suspend(CJob *pj);
 			
-			// add new job for scheduling
-			void Add(CJob *pj, CJob *pjParent);
+			// add new job for scheduling on the given worker's queue
+			void Add(CJob *pj, CJob *pjParent, ULONG ulWorker);
 
 			// resume suspended job
-			void Resume(CJob *pj);
+			void Resume(CJob *pj, ULONG ulWorker);
+
+			// number of workers the scheduler has queues for
+			ULONG UlWorkers() const
+			{
+				return (ULONG) m_ulpTasksMax;
+			}
 
 			// print statistics
 			void PrintStats() const;
+
+			// set profiler of job executions
+			void SetProfiler(CJobProfiler *pjprof)
+			{
+				m_pjprof = pjprof;
+			}
 			
 #ifdef GPOS_DEBUG
 			// get flag for tracking jobs
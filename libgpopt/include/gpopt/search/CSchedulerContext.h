@@ -51,6 +51,9 @@ namespace gpopt
 			// optimization engine
 			CEngine *m_peng;
 
+			// index of the worker using this context
+			ULONG m_ulWorker;
+
 			// flag indicating if context has been initialized
 			BOOL m_fInit;
 
@@ -76,7 +79,8 @@ namespace gpopt
 				IMemoryPool *pmpGlobal,
 				CJobFactory *pjf,
 				CScheduler *psched,
-				CEngine *peng
+				CEngine *peng,
+				ULONG ulWorker
 				);
 
 			// global memory pool accessor
@@ -114,6 +118,13 @@ namespace gpopt
 				return m_peng;
 			}
 
+			// worker index accessor
+			ULONG UlWorker() const
+			{
+				GPOS_ASSERT(FInit() && "Scheduling context is not initialized");
+				return m_ulWorker;
+			}
+
 	}; // class CSchedulerContext
 }
 
@@ -0,0 +1,147 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2018 Pivotal, Inc.
+//
+//	@filename:
+//		CStatsCache.h
+//
+//	@doc:
+//		Memo-wide cache of statistics computed during costing
+//---------------------------------------------------------------------------
+#ifndef GPOPT_CStatsCache_H
+#define GPOPT_CStatsCache_H
+
+#include "gpos/base.h"
+#include "gpos/common/CDynamicPtrArray.h"
+#include "gpos/common/CLockFreeCache.h"
+
+#include "naucrates/statistics/IStatistics.h"
+
+namespace gpopt
+{
+	using namespace gpos;
+	using namespace gpnaucrates;
+
+	// forward declarations
+	class COptimizationContext;
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CStatsCache
+	//
+	//	@doc:
+	//		Statistics computed during costing, shared by all groups of a memo.
+	//
+	//		Entries are keyed on the id of the group, the required stat columns,
+	//		the stats of outer references and the derived partition filters of
+	//		an optimization context; required plan properties, e.g., order and
+	//		distribution, are not part of the key, so all contexts of a group
+	//		that only differ in these properties share one stats object.
+	//		Duplicate groups are keyed on the group they were merged into.
+	//
+	//		Since cached stats objects are shared rather than copied, a hit
+	//		saves the derivation as well as the copies of all histograms.
+	//
+	//---------------------------------------------------------------------------
+	class CStatsCache
+	{
+		private:
+
+			//---------------------------------------------------------------------------
+			//	@struct:
+			//		SKey
+			//
+			//	@doc:
+			//		Group and optimization context under which stats are cached
+			//
+			//---------------------------------------------------------------------------
+			struct SKey
+			{
+				// group id
+				ULONG m_ulGroupId;
+
+				// optimization context
+				COptimizationContext *m_poc;
+
+				// hash function
+				static
+				ULONG UlHash(const SKey *pkey);
+
+				// equality function
+				static
+				BOOL FEqual(const SKey *pkeyFst, const SKey *pkeySnd);
+
+				// release key
+				static
+				void Destroy(SKey *pkey);
+
+			}; // struct SKey
+
+			// cache of computed stats
+			typedef CLockFreeCache<SKey, IStatistics, SKey::UlHash, SKey::FEqual,
+						SKey::Destroy, CleanupRelease<IStatistics> > LfcStats;
+
+			// memory pool
+			IMemoryPool *m_pmp;
+
+			// cache of computed stats
+			LfcStats m_cache;
+
+			// private copy ctor
+			CStatsCache(const CStatsCache &);
+
+		public:
+
+			// ctor
+			explicit
+			CStatsCache(IMemoryPool *pmp);
+
+			// lookup stats of a group under an optimization context;
+			// returns NULL if no stats were cached
+			IStatistics *PstatsLookup(ULONG ulGroupId, COptimizationContext *poc);
+
+			// cache stats of a group under an optimization context, takes
+			// ownership of the given stats; if another worker cached stats
+			// under the same key concurrently, the cached stats are returned
+			IStatistics *PstatsInsert(ULONG ulGroupId, COptimizationContext *poc, IStatistics *pstats);
+
+			// number of lookups
+			ULONG_PTR UlpLookups() const
+			{
+				return m_cache.UlpLookups();
+			}
+
+			// number of lookups that found cached stats
+			ULONG_PTR UlpHits() const
+			{
+				return m_cache.UlpHits();
+			}
+
+			// number of cached stats objects
+			ULONG_PTR UlpEntries() const
+			{
+				return m_cache.UlpEntries();
+			}
+
+			// number of insertions retried due to concurrent insertions
+			ULONG_PTR UlpInsertRetries() const
+			{
+				return m_cache.UlpInsertRetries();
+			}
+
+			// print hit rate
+			IOstream &OsPrint
+				(
+				IOstream &os
+				)
+				const
+			{
+				return m_cache.OsPrint(os, "cached stats objects");
+			}
+
+	}; // class CStatsCache
+}
+
+#endif // !GPOPT_CStatsCache_H
+
+// EOF
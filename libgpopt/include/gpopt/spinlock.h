@@ -19,15 +19,17 @@ namespace gpopt
 
 	// OPTIMIZER SPINLOCKS - reserve range 200-400
 
+	// spinlock used in per-worker scheduler queues
+	typedef CSpinlockRanked<205> CSpinlockSchedulerQueue;
+
 	// spinlock used in job queues
 	typedef CSpinlockRanked<210> CSpinlockJobQueue;
 
 	// spinlock used in column factory
 	typedef CSpinlockRanked<220> CSpinlockColumnFactory;
 
-	// spinlocks to synchronize memo access
+	// spinlock to synchronize group access
 	typedef CSpinlockRanked<230> CSpinlockGroup;
-	typedef CSpinlockRanked<231> CSpinlockMemo;
 
 	// spinlock used in metadata accessor cache accessor hashtable
 	typedef CSpinlockRanked<240> CSpinlockMDAcc;
@@ -35,9 +37,6 @@ namespace gpopt
 	// spinlock used in metadata accessor provider hashtable
 	typedef CSpinlockRanked<241> CSpinlockMDAccMDP;
 
-	// spinlock used in hashtable for optimization contexts
-	typedef CSpinlockRanked<250> CSpinlockOC;
-
 	// spinlock used in hashtable for cost contexts
 	typedef CSpinlockRanked<260> CSpinlockCC;
 }
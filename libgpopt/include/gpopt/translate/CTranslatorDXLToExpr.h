@@ -14,6 +14,7 @@
 
 #include "gpos/base.h"
 #include "gpos/common/CHashMap.h"
+#include "gpos/common/CHashSet.h"
 #include "gpos/sync/CAtomicCounter.h"
 
 #include "naucrates/dxl/operators/CDXLNode.h"
@@ -54,6 +55,13 @@ namespace gpopt
 	typedef CHashMap<ULONG, DrgPexpr, gpos::UlHash<ULONG>, gpos::FEqual<ULONG>,
 					CleanupDelete<ULONG>, CleanupNULL > HMUlPdrgpexpr;
 
+	// hash set of column ids
+	typedef CHashSet<ULONG, gpos::UlHash<ULONG>, gpos::FEqual<ULONG>,
+					CleanupDelete<ULONG> > HSUl;
+
+	// array of DXL table descriptors
+	typedef CDynamicPtrArray<CDXLTableDescr, CleanupNULL> DrgPdxltabdesc;
+
 	// iterator
 	typedef CHashMapIter<ULONG, DrgPexpr, gpos::UlHash<ULONG>, gpos::FEqual<ULONG>,
 		CleanupDelete<ULONG>, CleanupNULL > HMIterUlPdrgpexpr;
@@ -365,6 +373,23 @@ namespace gpopt
 
 			// initialize index of operator translators
 			void InitTranslators();
+
+			// collect metadata ids and referenced column ids of a DXL tree
+			void CollectMDIds
+				(
+				const CDXLNode *pdxln,
+				HSMDId *phsmdid,
+				DrgPmdid *pdrgpmdid,
+				DrgPdxltabdesc *pdrgpdxltabdesc,
+				HSUl *phsulColIds
+				);
+
+			// add a metadata id to a prefetch batch unless already there
+			static
+			void AddMDId(IMDId *pmdid, HSMDId *phsmdid, DrgPmdid *pdrgpmdid);
+
+			// fetch the metadata objects referenced by a DXL tree in batches
+			void PrefetchMetadata(const CDXLNode *pdxln, const DrgPdxln *pdrgpdxlnCTE);
 			
 			// main translation routine for DXL tree -> Expr tree
 			CExpression *Pexpr
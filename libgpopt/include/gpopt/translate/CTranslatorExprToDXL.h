@@ -26,6 +26,7 @@
 #include "naucrates/dxl/operators/CDXLScalarArrayRefIndexList.h"
 #include "naucrates/dxl/operators/CDXLScalarSubPlan.h"
 
+#include "gpopt/base/CUtils.h"
 #include "gpopt/operators/ops.h"
 #include "gpopt/mdcache/CMDAccessor.h"
 #include "gpopt/metadata/CTableDescriptor.h"
@@ -54,6 +55,10 @@ namespace gpopt
 	typedef CHashMap<CColRef, CDXLNode, gpos::UlHash<CColRef>, gpos::FEqual<CColRef>,
 					CleanupNULL<CColRef>, CleanupRelease<CDXLNode> > HMCrDxln;
 
+	// hash map mapping scalar CExpression -> CDXLNode
+	typedef CHashMap<CExpression, CDXLNode, CExpression::UlHash, CUtils::FEqualOrdered,
+					CleanupRelease<CExpression>, CleanupRelease<CDXLNode> > HMExprDxln;
+
 	//---------------------------------------------------------------------------
 	//	@class:
 	//		CTranslatorExprToDXL
@@ -112,6 +117,13 @@ namespace gpopt
 			// mappings CColRef -> CDXLNode used to for index predicates with outer references
 			HMCrDxln *m_phmcrdxlnIndexLookup;
 
+			// translated scalar subtrees, shared by all equal subtrees translated
+			// afterwards, which turns the DXL plan into a DAG
+			HMExprDxln *m_phmexprdxln;
+
+			// shared true constant, used as the default for missing filters
+			CDXLNode *m_pdxlnTrue;
+
 			// derived plan properties of the translated expression
 			CDrvdPropPlan *m_pdpplan;
 
@@ -696,6 +708,13 @@ namespace gpopt
 			
 			// create a DXL filter node with the given scalar expression
 			CDXLNode *PdxlnFilter(CDXLNode *pdxlnCond);
+
+			// shared DXL true constant
+			CDXLNode *PdxlnTrue();
+
+			// can the translation of the given scalar expression be shared
+			// with all equal scalar expressions translated afterwards
+			BOOL FInternable(CExpression *pexpr) const;
 			
 			// construct an array with input segment ids for the given motion expression
 			DrgPi *PdrgpiInputSegIds(CExpression *pexprMotion);
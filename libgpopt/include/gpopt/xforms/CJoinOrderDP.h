@@ -16,6 +16,15 @@
 #include "gpos/io/IOstream.h"
 #include "gpopt/xforms/CJoinOrder.h"
 
+// number of cheapest complete join orders returned besides the best one
+#define GPOPT_DP_JOIN_ORDERING_TOPK	10
+
+// maximum number of components joined by dynamic programming
+#define GPOPT_DP_JOIN_ORDERING_MAX_COMPS	64
+
+// maximum number of pairs of connected sets and connected complements
+// considered before dynamic programming gives up
+#define GPOPT_DP_JOIN_ORDERING_MAX_PAIRS	100000
 
 namespace gpopt
 {
@@ -26,7 +35,16 @@ namespace gpopt
 	//		CJoinOrderDP
 	//
 	//	@doc:
-	//		Helper class for creating join orders using dynamic programming
+	//		Helper class for creating join orders using dynamic programming;
+	//
+	//		Sets of components are represented as 64-bit masks, and connected
+	//		sets are joined with connected complements only, following the
+	//		DPccp algorithm of Moerkotte and Neumann, "Analysis of Two Existing
+	//		and One New Dynamic Programming Algorithm for the Generation of
+	//		Optimal Bushy Join Trees without Cross Products", VLDB 2006;
+	//		a DP entry keeps the cost and best split of a set, and join
+	//		expressions are built and their stats derived only for the
+	//		best split of a set, once the set is used in a larger join
 	//
 	//---------------------------------------------------------------------------
 	class CJoinOrderDP : public CJoinOrder
@@ -36,139 +54,157 @@ namespace gpopt
 
 			//---------------------------------------------------------------------------
 			//	@struct:
-			//		SComponentPair
+			//		SDPEntry
 			//
 			//	@doc:
-			//		Struct to capture a pair of components
+			//		Best join order found so far for a connected set of components;
+			//		the join expression is only built once the entry is used
 			//
 			//---------------------------------------------------------------------------
-			struct SComponentPair : public CRefCount
+			struct SDPEntry
 			{
-				// first component
-				CBitSet *m_pbsFst;
+				// set of components
+				ULLONG m_ullSet;
 
-				// second component
-				CBitSet *m_pbsSnd;
+				// components joined as outer child of the best join, or 0 for
+				// a single component
+				ULLONG m_ullOuter;
 
-				// ctor
-				SComponentPair(CBitSet *pbsFst, CBitSet *pbsSnd);
+				// components joined as inner child of the best join
+				ULLONG m_ullInner;
 
-				// dtor
-				~SComponentPair();
+				// cost of the best join order
+				CDouble m_dCost;
+
+				// expression of the best join order, built on first use
+				CExpression *m_pexpr;
 
-				// hashing function
-				static
-				ULONG UlHash(const SComponentPair *pcomppair);
+				// ctor
+				SDPEntry(ULLONG ullSet, ULLONG ullOuter, ULLONG ullInner, CDouble dCost);
 
-				// equality function
-				static
-				BOOL FEqual(const SComponentPair *pcomppairFst, const SComponentPair *pcomppairSnd);
+				// dtor
+				~SDPEntry();
 			};
 
-			// hashing function
-			static
-			ULONG UlHashBitSet
-				(
-				const CBitSet *pbs
-				)
+			//---------------------------------------------------------------------------
+			//	@struct:
+			//		SJoinOrder
+			//
+			//	@doc:
+			//		Join of two sets of components that covers all components
+			//
+			//---------------------------------------------------------------------------
+			struct SJoinOrder
 			{
-				GPOS_ASSERT(NULL != pbs);
+				// components of outer child
+				ULLONG m_ullOuter;
 
-				return pbs->UlHash();
-			}
+				// components of inner child
+				ULLONG m_ullInner;
 
-			 // equality function
-			static
-			BOOL FEqualBitSet
-				(
-				const CBitSet *pbsFst,
-				const CBitSet *pbsSnd
-				)
-			{
-				GPOS_ASSERT(NULL != pbsFst);
-				GPOS_ASSERT(NULL != pbsSnd);
+				// cost of the join
+				CDouble m_dCost;
 
-				return pbsFst->FEqual(pbsSnd);
-			}
+				// ctor
+				SJoinOrder()
+					:
+					m_ullOuter(0),
+					m_ullInner(0),
+					m_dCost(0.0)
+				{}
+			};
 
-			// hash map from component to best join order
-			typedef CHashMap<CBitSet, CExpression, UlHashBitSet, FEqualBitSet,
-				CleanupRelease<CBitSet>, CleanupRelease<CExpression> > HMBSExpr;
+			// hash map from set of components to best join order
+			typedef CHashMap<ULLONG, SDPEntry, gpos::UlHash<ULLONG>, gpos::FEqual<ULLONG>,
+				CleanupNULL<ULLONG>, CleanupDelete<SDPEntry> > HMUllEntry;
 
-			// hash map from component pair to connecting edges
-			typedef CHashMap<SComponentPair, CExpression, SComponentPair::UlHash, SComponentPair::FEqual,
-				CleanupRelease<SComponentPair>, CleanupRelease<CExpression> > HMCompLink;
+			// dynamic programming table
+			HMUllEntry *m_phmullentry;
 
-			// hash map from expression to cost of best join order
-			typedef CHashMap<CExpression, CDouble, CExpression::UlHash, CUtils::FEqual,
-				CleanupRelease<CExpression>, CleanupDelete<CDouble> > HMExprCost;
+			// set of all components
+			ULLONG m_ullAll;
 
-			// lookup table for links
-			HMCompLink *m_phmcomplink;
+			// components adjacent to each component through an edge
+			ULLONG *m_rgullNeighbors;
 
-			// dynamic programming table
-			HMBSExpr *m_phmbsexpr;
+			// components covered by each edge
+			ULLONG *m_rgullEdges;
+
+			// cheapest joins covering all components
+			SJoinOrder m_rgjoTopK[GPOPT_DP_JOIN_ORDERING_TOPK];
 
-			// map of expressions to its cost
-			HMExprCost *m_phmexprcost;
+			// number of entries in m_rgjoTopK
+			ULONG m_ulTopK;
 
 			// array of top-k join expression
 			DrgPexpr *m_pdrgpexprTopKOrders;
 
-			// dummy expression to used for non-joinable components
-			CExpression *m_pexprDummy;
+			// number of pairs of connected sets and complements considered
+			ULONG m_ulPairs;
+
+			// has enumeration exceeded the maximum number of pairs
+			BOOL FBudgetExceeded() const
+			{
+				return GPOPT_DP_JOIN_ORDERING_MAX_PAIRS < m_ulPairs;
+			}
+
+			// set containing a single component
+			static
+			ULLONG UllSingleton
+				(
+				ULONG ulComp
+				)
+			{
+				return ((ULLONG) 1) << ulComp;
+			}
 
-			// build expression linking given components
-			CExpression *PexprBuildPred(CBitSet *pbsFst, CBitSet *pbsSnd);
+			// components adjacent to the given set, excluding the given components
+			ULLONG UllNeighbors(ULLONG ullSet, ULLONG ullExclude) const;
 
-			// lookup best join order for given set
-			CExpression *PexprLookup(CBitSet *pbs);
+			// lookup the DP entry of a set of components
+			SDPEntry *PentryLookup
+				(
+				ULLONG ullSet
+				)
+				const
+			{
+				return m_phmullentry->PtLookup(&ullSet);
+			}
 
-			// extract predicate joining the two given sets
-			CExpression *PexprPred(CBitSet *pbsFst, CBitSet *pbsSnd);
+			// build expression linking given sets of components
+			CExpression *PexprBuildPred(ULLONG ullOuter, ULLONG ullInner);
 
-			// join expressions in the given two sets
-			CExpression *PexprJoin(CBitSet *pbsFst, CBitSet *pbsSnd);
+			// build the join expression of two sets of components
+			CExpression *PexprJoin(ULLONG ullOuter, ULLONG ullInner);
 
-			// join expressions in the given set
-			CExpression *PexprJoin(CBitSet *pbs);
+			// build the best join order of a set of components
+			CExpression *PexprBest(SDPEntry *pentry);
 
-			// find best join order for given component using dynamic programming
-			CExpression *PexprBestJoinOrderDP(CBitSet *pbs);
+			// estimated number of rows produced by the best join order of a set
+			CDouble DRows(SDPEntry *pentry);
 
-			// find best join order for given component
-			CExpression *PexprBestJoinOrder(CBitSet *pbs);
+			// consider joining a connected set with a connected complement
+			void EmitCsgCmp(ULLONG ullCsg, ULLONG ullCmp);
 
-			// generate cross product for the given components
-			CExpression *PexprCross(CBitSet *pbs);
+			// enumerate connected complements of a connected set
+			void EmitCsg(ULLONG ullCsg);
 
-			// join a covered subset with uncovered subset
-			CExpression *PexprJoinCoveredSubsetWithUncoveredSubset(CBitSet *pbs, CBitSet *pbsCovered, CBitSet *pbsUncovered);
+			// recursively enumerate connected sets extending the given one
+			void EnumerateCsgRec(ULLONG ullCsg, ULLONG ullExclude);
 
-			// return a subset of the given set covered by one or more edges
-			CBitSet *PbsCovered(CBitSet *pbsInput);
+			// recursively enumerate connected complements extending the given one
+			void EnumerateCmpRec(ULLONG ullCsg, ULLONG ullCmp, ULLONG ullExclude);
 
-			// add given join order to best results
-			void AddJoinOrder(CExpression *pexprJoin, CDouble dCost);
+			// cross join the best join orders of the connected parts of the join graph
+			CExpression *PexprCross();
 
-			// compute cost of given join expression
-			CDouble DCost(CExpression *pexpr);
+			// add given join to best results
+			void AddJoinOrder(ULLONG ullOuter, ULLONG ullInner, CDouble dCost);
 
 			// derive stats on given expression
 			virtual
 			void DeriveStats(CExpression *pexpr);
 
-			// add expression to cost map
-			void InsertExpressionCost(CExpression *pexpr, CDouble dCost, BOOL fValidateInsert);
-
-			// generate all subsets of the given array of elements
-			static
-			void GenerateSubsets(IMemoryPool *pmp, CBitSet *pbsCurrent, ULONG *pulElems, ULONG ulSize, ULONG ulIndex, DrgPbs *pdrgpbsSubsets);
-
-			// driver of subset generation
-			static
-			DrgPbs *PdrgpbsSubsets(IMemoryPool *pmp, CBitSet *pbs);
-
 		public:
 
 			// ctor
@@ -183,7 +219,8 @@ namespace gpopt
 			virtual
 			~CJoinOrderDP();
 
-			// main handler
+			// main handler; returns NULL if the join graph has more pairs of
+			// connected sets and complements than dynamic programming considers
 			virtual
 			CExpression *PexprExpand();
 
@@ -193,6 +230,12 @@ namespace gpopt
 				return m_pdrgpexprTopKOrders;
 			}
 
+			// number of pairs of connected sets and complements considered
+			ULONG UlPairs() const
+			{
+				return m_ulPairs;
+			}
+
 			// print function
 			virtual
 			IOstream &OsPrint(IOstream &) const;
@@ -82,6 +82,11 @@ namespace gpopt
 					CExpression *pexpr
 					) const;
 
+			// expand given n-ary join into a normalized cluster of inner joins
+			// ordered by cardinality of intermediate results
+			static
+			CExpression *PexprExpand(IMemoryPool *pmp, CExpression *pexpr);
+
 	}; // class CXformExpandNAryJoinGreedy
 
 }
@@ -558,29 +558,21 @@ CConstraintInterval::PciIntervalFromScalarBoolOr
 	const ULONG ulArity = pexpr->UlArity();
 	GPOS_ASSERT(0 < ulArity);
 
-	CConstraintInterval *pci = PciIntervalFromScalarExpr(pmp, (*pexpr)[0], pcr);
-	if (NULL == pci)
-	{
-		return NULL;
-	}
-
-	for (ULONG ul = 1; ul < ulArity; ul++)
+	DrgPci *pdrgpci = GPOS_NEW(pmp) DrgPci(pmp);
+	for (ULONG ul = 0; ul < ulArity; ul++)
 	{
 		CConstraintInterval *pciChild = PciIntervalFromScalarExpr(pmp, (*pexpr)[ul], pcr);
 
 		if (NULL == pciChild)
 		{
-			pci->Release();
+			pdrgpci->Release();
 			return NULL;
 		}
 
-		CConstraintInterval *pciOr = pci->PciUnion(pmp, pciChild);
-		pci->Release();
-		pciChild->Release();
-		pci = pciOr;
+		pdrgpci->Append(pciChild);
 	}
 
-	return pci;
+	return PciCombine(pmp, pdrgpci, true /*fUnion*/);
 }
 
 //---------------------------------------------------------------------------
@@ -606,25 +598,85 @@ CConstraintInterval::PciIntervalFromScalarBoolAnd
 	const ULONG ulArity = pexpr->UlArity();
 	GPOS_ASSERT(0 < ulArity);
 
-	CConstraintInterval *pci = PciIntervalFromScalarExpr(pmp, (*pexpr)[0], pcr);
-	for (ULONG ul = 1; ul < ulArity; ul++)
+	DrgPci *pdrgpci = GPOS_NEW(pmp) DrgPci(pmp);
+	for (ULONG ul = 0; ul < ulArity; ul++)
 	{
 		CConstraintInterval *pciChild = PciIntervalFromScalarExpr(pmp, (*pexpr)[ul], pcr);
-		// here is where we will return a NULL child from not being able to create a
+
+		// here is where we will skip a NULL child from not being able to create a
 		// CConstraint interval from the ScalarExpr
-		if (NULL != pciChild && NULL != pci)
+		if (NULL != pciChild)
 		{
-			CConstraintInterval *pciAnd = pci->PciIntersect(pmp, pciChild);
-			pci->Release();
-			pciChild->Release();
-			pci = pciAnd;
+			pdrgpci->Append(pciChild);
+		}
+	}
+
+	if (0 == pdrgpci->UlLength())
+	{
+		pdrgpci->Release();
+		return NULL;
+	}
+
+	return PciCombine(pmp, pdrgpci, false /*fUnion*/);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstraintInterval::PciCombine
+//
+//	@doc:
+//		Union or intersection of the given intervals; takes ownership of the
+//		array. Intervals are merged pairwise in rounds instead of folding them
+//		into one growing interval, so that a long list of children, e.g., an
+//		expanded IN list, costs O(n log n) range operations rather than O(n^2)
+//
+//---------------------------------------------------------------------------
+CConstraintInterval *
+CConstraintInterval::PciCombine
+	(
+	IMemoryPool *pmp,
+	DrgPci *pdrgpci,
+	BOOL fUnion
+	)
+{
+	GPOS_ASSERT(NULL != pdrgpci);
+	GPOS_ASSERT(0 < pdrgpci->UlLength());
+
+	while (1 < pdrgpci->UlLength())
+	{
+		GPOS_CHECK_ABORT;
+
+		const ULONG ulLength = pdrgpci->UlLength();
+		DrgPci *pdrgpciNext = GPOS_NEW(pmp) DrgPci(pmp);
+		for (ULONG ul = 0; ul + 1 < ulLength; ul += 2)
+		{
+			CConstraintInterval *pciFst = (*pdrgpci)[ul];
+			CConstraintInterval *pciSnd = (*pdrgpci)[ul + 1];
+			if (fUnion)
+			{
+				pdrgpciNext->Append(pciFst->PciUnion(pmp, pciSnd));
+			}
+			else
+			{
+				pdrgpciNext->Append(pciFst->PciIntersect(pmp, pciSnd));
+			}
 		}
-		else if (NULL != pciChild)
+
+		if (1 == ulLength % 2)
 		{
-			pci = pciChild;
+			CConstraintInterval *pciLast = (*pdrgpci)[ulLength - 1];
+			pciLast->AddRef();
+			pdrgpciNext->Append(pciLast);
 		}
+
+		pdrgpci->Release();
+		pdrgpci = pdrgpciNext;
 	}
 
+	CConstraintInterval *pci = (*pdrgpci)[0];
+	pci->AddRef();
+	pdrgpci->Release();
+
 	return pci;
 }
 
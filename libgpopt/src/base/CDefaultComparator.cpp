@@ -80,6 +80,14 @@ CDefaultComparator::FEvalComparison
 
 	CExpression *pexprResult = m_pceeval->PexprEval(pexprComp);
 	pexprComp->Release();
+	if (!CUtils::FScalarConst(pexprResult))
+	{
+		// evaluator could not fold the comparison, e.g., a native evaluator
+		// without fallback comparing values of an unsupported type
+		pexprResult->Release();
+		GPOS_RAISE(gpopt::ExmaGPOPT, gpopt::ExmiEvalUnsupportedScalarExpr, "comparison the evaluator cannot fold");
+	}
+
 	CScalarConst *popScalarConst = CScalarConst::PopConvert(pexprResult->Pop());
 	IDatum *pdatum = popScalarConst->Pdatum();
 
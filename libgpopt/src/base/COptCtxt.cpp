@@ -17,6 +17,7 @@
 #include "gpopt/base/CColRefSet.h"
 #include "gpopt/base/CDefaultComparator.h"
 #include "gpopt/base/COptCtxt.h"
+#include "gpopt/base/CScalarInternTable.h"
 #include "gpopt/cost/ICostModel.h"
 #include "gpopt/eval/IConstExprEvaluator.h"
 #include "gpopt/optimizer/COptimizerConfig.h"
@@ -53,6 +54,7 @@ COptCtxt::COptCtxt
 	m_pcteinfo(NULL),
 	m_pdrgpcrSystemCols(NULL),
 	m_poconf(poconf),
+	m_psit(NULL),
 	m_fDMLQuery(false)
 {
 	GPOS_ASSERT(NULL != pmp);
@@ -65,6 +67,15 @@ COptCtxt::COptCtxt
 	
 	m_pcteinfo = GPOS_NEW(m_pmp) CCTEInfo(m_pmp);
 	m_pcm = poconf->Pcm();
+
+	// interned expressions are shared between workers, but their derived
+	// properties and statistics are computed lazily and unsynchronized;
+	// intern only when a single worker optimizes the query
+	if (GPOS_FTRACE(EopttraceInternScalars) &&
+		1 >= poconf->Phint()->UlOptimizerWorkers())
+	{
+		m_psit = GPOS_NEW(m_pmp) CScalarInternTable(m_pmp);
+	}
 }
 
 
@@ -79,6 +90,7 @@ COptCtxt::COptCtxt
 //---------------------------------------------------------------------------
 COptCtxt::~COptCtxt()
 {
+	GPOS_DELETE(m_psit);
 	GPOS_DELETE(m_pcf);
 	GPOS_DELETE(m_pcomp);
 	m_pceeval->Release();
@@ -131,6 +131,37 @@ COptimizationContext::FMatch
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		COptimizationContext::UlHashForStats
+//
+//	@doc:
+//		Hash function used for computing stats during costing; only the
+//		components compared by FEqualForStats are hashed, so that contexts
+//		differing in required plan properties only hash to the same bucket
+//
+//---------------------------------------------------------------------------
+ULONG
+COptimizationContext::UlHashForStats
+	(
+	const COptimizationContext *poc
+	)
+{
+	GPOS_ASSERT(m_pocInvalid != poc);
+
+	ULONG ulHash = poc->Prprel()->PcrsStat()->UlHash();
+
+	DrgPstat *pdrgpstat = poc->Pdrgpstat();
+	const ULONG ulStats = pdrgpstat->UlLength();
+	for (ULONG ul = 0; ul < ulStats; ul++)
+	{
+		ulHash = gpos::UlCombineHashes(ulHash, gpos::UlHashPtr<IStatistics>((*pdrgpstat)[ul]));
+	}
+
+	return ulHash;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		COptimizationContext::FEqualForStats
@@ -203,14 +234,17 @@ COptimizationContext::FOptimize
 
 //---------------------------------------------------------------------------
 //	@function:
-//		COptimizationContext::FEqualIds
+//		COptimizationContext::FEqualContexts
 //
 //	@doc:
-//		Compare array of optimization contexts based on context ids
+//		Compare array of optimization contexts; a group holds at most one
+//		context matching given required properties, so contexts are
+//		compared by identity rather than by id, which a context that was
+//		just inserted by another worker may not have yet
 //
 //---------------------------------------------------------------------------
 BOOL
-COptimizationContext::FEqualContextIds
+COptimizationContext::FEqualContexts
 	(
 	DrgPoc *pdrgpocFst,
 	DrgPoc *pdrgpocSnd
@@ -230,7 +264,7 @@ COptimizationContext::FEqualContextIds
 	BOOL fEqual = true;
 	for (ULONG ul = 0; fEqual && ul < ulCtxts; ul++)
 	{
-		fEqual = (*pdrgpocFst)[ul]->UlId() == (*pdrgpocSnd)[ul]->UlId();
+		fEqual = (*pdrgpocFst)[ul] == (*pdrgpocSnd)[ul];
 	}
 
 	return fEqual;
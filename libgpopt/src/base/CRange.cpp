@@ -16,7 +16,11 @@
 #include "gpopt/base/IComparator.h"
 #include "gpopt/operators/CPredicateUtils.h"
 
+#include "naucrates/base/IDatumInt2.h"
+#include "naucrates/base/IDatumInt4.h"
+#include "naucrates/base/IDatumInt8.h"
 #include "naucrates/md/IMDScalarOp.h"
+#include "naucrates/traceflags/traceflags.h"
 
 using namespace gpopt;
 
@@ -44,13 +48,18 @@ CRange::CRange
 	m_pdatumLeft(pdatumLeft),
 	m_eriLeft(eriLeft),
 	m_pdatumRight(pdatumRight),
-	m_eriRight(eriRight)
+	m_eriRight(eriRight),
+	m_fIntKeys(false),
+	m_lLeft(0),
+	m_lRight(0)
 {
 	GPOS_ASSERT(pmdid->FValid());
 	GPOS_ASSERT(NULL != pcomp);
 	GPOS_ASSERT(CUtils::FConstrainableType(pmdid));
 	GPOS_ASSERT_IMP(NULL != pdatumLeft && NULL != pdatumRight,
 			pcomp->FLessThanOrEqual(pdatumLeft, pdatumRight));
+
+	InitIntKeys();
 }
 
 //---------------------------------------------------------------------------
@@ -74,7 +83,10 @@ CRange::CRange
 	m_pdatumLeft(NULL),
 	m_eriLeft(EriExcluded),
 	m_pdatumRight(NULL),
-	m_eriRight(EriExcluded)
+	m_eriRight(EriExcluded),
+	m_fIntKeys(false),
+	m_lLeft(0),
+	m_lRight(0)
 {
 	m_pmdid = pdatum->Pmdid();
 
@@ -125,6 +137,67 @@ CRange::CRange
 			// for anything else, create a (-inf, inf) range
 			break;
 	}
+
+	InitIntKeys();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CRange::InitIntKeys
+//
+//	@doc:
+//		Keep the end points of integer ranges as plain integers, so that
+//		comparing them while merging intervals needs neither virtual calls
+//		nor metadata lookups in the comparator; ranges of other types, and
+//		ranges with NULL end points, are compared through the comparator
+//
+//---------------------------------------------------------------------------
+void
+CRange::InitIntKeys()
+{
+	// integers are compared by the external evaluator on request
+	if (GPOS_FTRACE(EopttraceEnableConstantExpressionEvaluation) &&
+		GPOS_FTRACE(EopttraceUseExternalConstantExpressionEvaluationForInts))
+	{
+		return;
+	}
+
+	IDatum *rgpdatum[] = {m_pdatumLeft, m_pdatumRight};
+	LINT *rgpl[] = {&m_lLeft, &m_lRight};
+	for (ULONG ul = 0; ul < GPOS_ARRAY_SIZE(rgpdatum); ul++)
+	{
+		IDatum *pdatum = rgpdatum[ul];
+		if (NULL == pdatum)
+		{
+			// infinite end points are never compared
+			continue;
+		}
+
+		if (pdatum->FNull())
+		{
+			return;
+		}
+
+		switch (pdatum->Eti())
+		{
+			case IMDType::EtiInt2:
+				*rgpl[ul] = dynamic_cast<IDatumInt2 *>(pdatum)->SValue();
+				break;
+
+			case IMDType::EtiInt4:
+				*rgpl[ul] = dynamic_cast<IDatumInt4 *>(pdatum)->IValue();
+				break;
+
+			case IMDType::EtiInt8:
+				*rgpl[ul] = dynamic_cast<IDatumInt8 *>(pdatum)->LValue();
+				break;
+
+			default:
+				return;
+		}
+	}
+
+	m_fIntKeys = true;
 }
 
 //---------------------------------------------------------------------------
@@ -165,12 +238,13 @@ CRange::FDisjointLeft
 		return false;
 	}
 
-	if (m_pcomp->FLessThan(m_pdatumRight, pdatumLeft))
+	BOOL fIntKeys = FIntKeys(prange);
+	if (FLess(m_pdatumRight, m_lRight, pdatumLeft, prange->m_lLeft, fIntKeys))
 	{
 		return true;
 	}
 
-	if (m_pcomp->FEqual(m_pdatumRight, pdatumLeft))
+	if (FEqual(m_pdatumRight, m_lRight, pdatumLeft, prange->m_lLeft, fIntKeys))
 	{
 		return (EriExcluded == m_eriRight || EriExcluded == prange->EriLeft());
 	}
@@ -271,7 +345,7 @@ CRange::FUpperBoundEqualsLowerBound
 		return false;
 	}
 
-	return m_pcomp->FEqual(m_pdatumRight, pdatumLeft);
+	return FEqual(m_pdatumRight, m_lRight, pdatumLeft, prange->m_lLeft, FIntKeys(prange));
 }
 
 //---------------------------------------------------------------------------
@@ -304,7 +378,8 @@ CRange::FStartsWithOrBefore
 		return false;
 	}
 
-	return (m_pcomp->FEqual(m_pdatumLeft, pdatumLeft) && m_eriLeft == prange->EriLeft());
+	return (FEqual(m_pdatumLeft, m_lLeft, pdatumLeft, prange->m_lLeft, FIntKeys(prange)) &&
+			m_eriLeft == prange->EriLeft());
 }
 
 //---------------------------------------------------------------------------
@@ -329,12 +404,13 @@ CRange::FStartsBefore
 		return (NULL == m_pdatumLeft);
 	}
 
-	if (NULL == m_pdatumLeft || m_pcomp->FLessThan(m_pdatumLeft, pdatumLeft))
+	BOOL fIntKeys = FIntKeys(prange);
+	if (NULL == m_pdatumLeft || FLess(m_pdatumLeft, m_lLeft, pdatumLeft, prange->m_lLeft, fIntKeys))
 	{
 		return true;
 	}
 
-	if (m_pcomp->FGreaterThan(m_pdatumLeft, pdatumLeft))
+	if (FLess(pdatumLeft, prange->m_lLeft, m_pdatumLeft, m_lLeft, fIntKeys))
 	{
 		return false;
 	}
@@ -366,12 +442,13 @@ CRange::FEndsAfter
 		return (NULL == m_pdatumRight);
 	}
 
-	if (NULL == m_pdatumRight || m_pcomp->FGreaterThan(m_pdatumRight, pdatumRight))
+	BOOL fIntKeys = FIntKeys(prange);
+	if (NULL == m_pdatumRight || FLess(pdatumRight, prange->m_lRight, m_pdatumRight, m_lRight, fIntKeys))
 	{
 		return true;
 	}
 
-	if (m_pcomp->FLessThan(m_pdatumRight, pdatumRight))
+	if (FLess(m_pdatumRight, m_lRight, pdatumRight, prange->m_lRight, fIntKeys))
 	{
 		return false;
 	}
@@ -411,7 +488,8 @@ CRange::FEndsWithOrAfter
 		return false;
 	}
 
-	return (m_pcomp->FEqual(m_pdatumRight, pdatumRight) && m_eriRight == prange->EriRight());
+	return (FEqual(m_pdatumRight, m_lRight, pdatumRight, prange->m_lRight, FIntKeys(prange)) &&
+			m_eriRight == prange->EriRight());
 }
 
 //---------------------------------------------------------------------------
@@ -426,7 +504,7 @@ BOOL
 CRange::FPoint() const
 {
 	return (EriIncluded == m_eriLeft && EriIncluded == m_eriRight &&
-			m_pcomp->FEqual(m_pdatumRight, m_pdatumLeft));
+			FEqual(m_pdatumRight, m_lRight, m_pdatumLeft, m_lLeft, m_fIntKeys));
 }
 
 //---------------------------------------------------------------------------
@@ -723,7 +801,7 @@ CRange::PrngExtend
 	)
 {
 	if (FDisjointLeft(prange) &&
-		m_pcomp->FEqual(prange->PdatumLeft(), m_pdatumRight) &&
+		FEqual(prange->PdatumLeft(), prange->m_lLeft, m_pdatumRight, m_lRight, FIntKeys(prange)) &&
 		(EriIncluded == prange->EriLeft() || EriIncluded == m_eriRight))
 	{
 		// ranges are contiguous so combine them into one
@@ -0,0 +1,182 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2018 Pivotal, Inc.
+//
+//	@filename:
+//		CScalarInternTable.cpp
+//
+//	@doc:
+//		Implementation of the table of interned scalar expressions
+//---------------------------------------------------------------------------
+
+#include "gpos/base.h"
+
+#include "gpopt/base/CScalarInternTable.h"
+#include "gpopt/base/CUtils.h"
+#include "gpopt/operators/CExpression.h"
+
+using namespace gpopt;
+
+// number of buckets of the intern hash table
+#define GPOPT_SCALAR_INTERN_HT_BUCKETS	10000
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CScalarInternTable::UlHash
+//
+//	@doc:
+//		Hash function
+//
+//---------------------------------------------------------------------------
+ULONG
+CScalarInternTable::UlHash
+	(
+	const CExpression *pexpr
+	)
+{
+	return CExpression::UlHash(pexpr);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CScalarInternTable::FEqual
+//
+//	@doc:
+//		Equality function
+//
+//---------------------------------------------------------------------------
+BOOL
+CScalarInternTable::FEqual
+	(
+	const CExpression *pexprFst,
+	const CExpression *pexprSnd
+	)
+{
+	return CUtils::FEqualOrdered(pexprFst, pexprSnd);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CScalarInternTable::Release
+//
+//	@doc:
+//		Release an interned expression
+//
+//---------------------------------------------------------------------------
+void
+CScalarInternTable::Release
+	(
+	CExpression *pexpr
+	)
+{
+	pexpr->Release();
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CScalarInternTable::CScalarInternTable
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+CScalarInternTable::CScalarInternTable
+	(
+	IMemoryPool *pmp
+	)
+	:
+	m_pmp(pmp),
+	m_cache(pmp, GPOPT_SCALAR_INTERN_HT_BUCKETS)
+{}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CScalarInternTable::~CScalarInternTable
+//
+//	@doc:
+//		Dtor; defined here since releasing interned expressions requires
+//		their complete type
+//
+//---------------------------------------------------------------------------
+CScalarInternTable::~CScalarInternTable()
+{}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CScalarInternTable::FInternable
+//
+//	@doc:
+//		Check if expression tree consists of scalar operators only; this
+//		excludes subqueries, whose relational children are not shared
+//
+//---------------------------------------------------------------------------
+BOOL
+CScalarInternTable::FInternable
+	(
+	const CExpression *pexpr
+	)
+{
+	GPOS_CHECK_STACK_SIZE;
+
+	if (!pexpr->Pop()->FScalar())
+	{
+		return false;
+	}
+
+	BOOL fInternable = true;
+	const ULONG ulArity = pexpr->UlArity();
+	for (ULONG ul = 0; fInternable && ul < ulArity; ul++)
+	{
+		fInternable = FInternable((*pexpr)[ul]);
+	}
+
+	return fInternable;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CScalarInternTable::PexprIntern
+//
+//	@doc:
+//		Return the interned expression equal to the given one; if another
+//		worker interned an equal expression concurrently, the expression
+//		interned first is returned
+//
+//---------------------------------------------------------------------------
+CExpression *
+CScalarInternTable::PexprIntern
+	(
+	IMemoryPool *pmp,
+	CExpression *pexpr
+	)
+{
+	GPOS_ASSERT(NULL != pexpr);
+
+	if (pmp != m_pmp || !FInternable(pexpr))
+	{
+		return pexpr;
+	}
+
+	CExpression *pexprInterned = m_cache.PtLookup(pexpr);
+	if (NULL == pexprInterned)
+	{
+		// the cache holds one reference for the key and one for the value
+		pexpr->AddRef();
+		pexpr->AddRef();
+		pexprInterned = m_cache.PtInsert(pexpr, pexpr);
+	}
+
+	pexprInterned->AddRef();
+	pexpr->Release();
+
+	return pexprInterned;
+}
+
+// EOF
@@ -21,6 +21,7 @@
 #include "gpopt/base/CConstraintInterval.h"
 #include "gpopt/base/CKeyCollection.h"
 #include "gpopt/base/CUtils.h"
+#include "gpopt/base/CScalarInternTable.h"
 #include "gpopt/base/CCastUtils.h"
 #include "gpopt/base/CPartIndexMap.h"
 #include "gpopt/base/CDistributionSpecRandom.h"
@@ -161,7 +162,28 @@ CUtils::PexprScalarIdent
 {
 	GPOS_ASSERT(NULL != pcr);
 
-	return GPOS_NEW(pmp) CExpression(pmp, GPOS_NEW(pmp) CScalarIdent(pmp, pcr));
+	return PexprIntern(pmp, GPOS_NEW(pmp) CExpression(pmp, GPOS_NEW(pmp) CScalarIdent(pmp, pcr)));
+}
+
+// return the interned scalar expression equal to the given one if scalar
+// interning is enabled, the given expression otherwise; takes ownership
+// of the given expression
+CExpression *
+CUtils::PexprIntern
+	(
+	IMemoryPool *pmp,
+	CExpression *pexpr
+	)
+{
+	GPOS_ASSERT(NULL != pexpr);
+
+	COptCtxt *poctxt = COptCtxt::PoctxtFromTLS();
+	if (NULL == poctxt || NULL == poctxt->Psit())
+	{
+		return pexpr;
+	}
+
+	return poctxt->Psit()->PexprIntern(pmp, pexpr);
 }
 
 // generate a ScalarProjectElement expression
@@ -252,13 +274,15 @@ CUtils::PexprScalarCmp
 		}
 	}
 
-	return GPOS_NEW(pmp) CExpression
+	CExpression *pexprResult = GPOS_NEW(pmp) CExpression
 						(
 						pmp,
 						GPOS_NEW(pmp) CScalarCmp(pmp, pmdidOp, GPOS_NEW(pmp) CWStringConst(pmp, strOp.Wsz()), Ecmpt(pmdidOp)),
 						PexprScalarIdent(pmp, pcrLeft),
 						PexprScalarIdent(pmp, pcrRight)
 						);
+
+	return PexprIntern(pmp, pexprResult);
 }
 
 // check is a comparison between given types or a comparison after casting
@@ -320,13 +344,15 @@ CUtils::PexprScalarCmp
 		}
 	}
 
-	return GPOS_NEW(pmp) CExpression
+	CExpression *pexprResult = GPOS_NEW(pmp) CExpression
 						(
 						pmp,
 						GPOS_NEW(pmp) CScalarCmp(pmp, pmdidOp, GPOS_NEW(pmp) CWStringConst(pmp, strOp.Wsz()), Ecmpt(pmdidOp)),
 						PexprScalarIdent(pmp, pcrLeft),
 						pexprRight
 						);
+
+	return PexprIntern(pmp, pexprResult);
 }
 
 // Generate a comparison expression between two columns
@@ -416,13 +442,15 @@ CUtils::PexprScalarCmp
 		}
 	}
 	
-	return GPOS_NEW(pmp) CExpression
+	CExpression *pexprResult = GPOS_NEW(pmp) CExpression
 						(
 						pmp,
 						GPOS_NEW(pmp) CScalarCmp(pmp, pmdidOp, GPOS_NEW(pmp) CWStringConst(pmp, strOp.Wsz()), ecmpt),
 						pexprLeft,
 						PexprScalarIdent(pmp, pcrRight)
 						);
+
+	return PexprIntern(pmp, pexprResult);
 }
 
 // Generate a comparison expression over two expressions
@@ -454,13 +482,15 @@ CUtils::PexprScalarCmp
 		}
 	}
 	
-	return GPOS_NEW(pmp) CExpression
+	CExpression *pexprResult = GPOS_NEW(pmp) CExpression
 						(
 						pmp,
 						GPOS_NEW(pmp) CScalarCmp(pmp, pmdidOp, GPOS_NEW(pmp) CWStringConst(pmp, strOp.Wsz()), ecmpt),
 						pexprLeft,
 						pexprRight
 						);
+
+	return PexprIntern(pmp, pexprResult);
 }
 
 // Generate a comparison expression over two expressions
@@ -520,7 +550,7 @@ CUtils::PexprScalarCmp
 					pexprNewRight
 					);
 
-	return pexprResult;
+	return PexprIntern(pmp, pexprResult);
 }
 
 // Generate an equality comparison expression over two columns
@@ -1644,6 +1674,39 @@ CUtils::FEqual
 	return FMatchChildrenUnordered(pexprLeft, pexprRight);
 }
 
+// deep equality of expression trees, where children of all operators must
+// appear in the same order, i.e., equal expressions are also equal after
+// translation
+BOOL
+CUtils::FEqualOrdered
+	(
+	const CExpression *pexprLeft,
+	const CExpression *pexprRight
+	)
+{
+	GPOS_CHECK_STACK_SIZE;
+
+	if (pexprLeft == pexprRight)
+	{
+		return true;
+	}
+
+	const ULONG ulArity = pexprLeft->UlArity();
+	if (ulArity != pexprRight->UlArity() ||
+		!pexprLeft->Pop()->FMatch(pexprRight->Pop()))
+	{
+		return false;
+	}
+
+	BOOL fEqual = true;
+	for (ULONG ul = 0; fEqual && ul < ulArity; ul++)
+	{
+		fEqual = FEqualOrdered((*pexprLeft)[ul], (*pexprRight)[ul]);
+	}
+
+	return fEqual;
+}
+
 // check if two expressions have the same children in any order
 BOOL
 CUtils::FMatchChildrenUnordered
@@ -1810,12 +1873,14 @@ CUtils::PexprScalarBoolOp
 	GPOS_ASSERT(NULL != pdrgpexpr);
 	GPOS_ASSERT(0 < pdrgpexpr->UlLength());
 
-	return GPOS_NEW(pmp) CExpression
+	CExpression *pexprResult = GPOS_NEW(pmp) CExpression
 			(
 			pmp,
 			GPOS_NEW(pmp) CScalarBoolOp(pmp, eboolop),
 			pdrgpexpr
 			);
+
+	return PexprIntern(pmp, pexprResult);
 }
 
 // generate a boolean scalar constant expression
@@ -1836,7 +1901,7 @@ CUtils::PexprScalarConstBool
 	CExpression *pexpr =
 			GPOS_NEW(pmp) CExpression(pmp, GPOS_NEW(pmp) CScalarConst(pmp,(IDatum*) pdatum));
 
-	return pexpr;
+	return PexprIntern(pmp, pexpr);
 }
 
 // generate an int4 scalar constant expression
@@ -1856,7 +1921,7 @@ CUtils::PexprScalarConstInt4
 	CExpression *pexpr =
 			GPOS_NEW(pmp) CExpression(pmp, GPOS_NEW(pmp) CScalarConst(pmp, (IDatum*) pdatum));
 
-	return pexpr;
+	return PexprIntern(pmp, pexpr);
 }
 
 // generate an int8 scalar constant expression
@@ -1877,7 +1942,7 @@ CUtils::PexprScalarConstInt8
 	CExpression *pexpr =
 			GPOS_NEW(pmp) CExpression(pmp, GPOS_NEW(pmp) CScalarConst(pmp, (IDatum*) pdatum));
 
-	return pexpr;
+	return PexprIntern(pmp, pexpr);
 }
 
 // generate an oid scalar constant expression
@@ -1897,7 +1962,7 @@ CUtils::PexprScalarConstOid
 	CExpression *pexpr =
 			GPOS_NEW(pmp) CExpression(pmp, GPOS_NEW(pmp) CScalarConst(pmp, (IDatum*) pdatum));
 
-	return pexpr;
+	return PexprIntern(pmp, pexpr);
 }
 
 // get column reference defined by project element
@@ -14,6 +14,7 @@
 #include "gpos/string/CWStringDynamic.h"
 #include "gpos/task/CAutoTaskProxy.h"
 #include "gpos/task/CAutoTraceFlag.h"
+#include "gpos/task/CWorkerPoolManager.h"
 #include "gpos/memory/CAutoMemoryPool.h"
 
 #include "gpopt/exception.h"
@@ -25,6 +26,7 @@
 #include "gpopt/base/CReqdPropRelational.h"
 #include "gpopt/base/CQueryContext.h"
 #include "gpopt/base/COptCtxt.h"
+#include "gpopt/base/CScalarInternTable.h"
 #include "gpopt/engine/CEngine.h"
 #include "gpopt/engine/CEnumeratorConfig.h"
 #include "gpopt/engine/CStatisticsConfig.h"
@@ -44,9 +46,11 @@
 #include "gpopt/search/CGroupProxy.h"
 #include "gpopt/search/CJob.h"
 #include "gpopt/search/CJobFactory.h"
+#include "gpopt/search/CJobProfiler.h"
 #include "gpopt/search/CMemo.h"
 #include "gpopt/search/CScheduler.h"
 #include "gpopt/search/CSchedulerContext.h"
+#include "gpopt/search/CStatsCache.h"
 #include "gpopt/xforms/CXformFactory.h"
 
 #include "naucrates/traceflags/traceflags.h"
@@ -83,7 +87,17 @@ CEngine::CEngine
 	m_pexprEnforcerPattern(NULL),
 	m_pxfs(NULL),
 	m_pdrgpulpXformCalls(NULL),
-	m_pdrgpulpXformTimes(NULL)
+	m_pdrgpulpXformTimes(NULL),
+	m_pjprof(NULL),
+	m_ulpPrunedBeforeChildren(0),
+	m_ulpPrunedAfterChild(0),
+	m_ulWorkers(1),
+	m_ulDeadline(gpos::ulong_max),
+	m_fPlanFound(false),
+	m_pfnplan(NULL),
+	m_pvPlanArg(NULL),
+	m_ulPlansReported(0),
+	m_costReported(0.0)
 {
 	m_pmemo = GPOS_NEW(pmp) CMemo(pmp);
 	m_pexprEnforcerPattern = GPOS_NEW(pmp) CExpression(pmp, GPOS_NEW(pmp) CPatternLeaf(pmp));
@@ -113,6 +127,7 @@ CEngine::~CEngine()
 	m_pdrgpulpXformTimes->Release();
 	m_pexprEnforcerPattern->Release();
 	CRefCount::SafeRelease(m_pdrgpss);
+	GPOS_DELETE(m_pjprof);
 #endif // GPOS_DEBUG
 }
 
@@ -593,7 +608,7 @@ CEngine::FSafeToPruneWithDPEStats
 	)
 {
 	GPOS_ASSERT(GPOS_FTRACE(EopttraceDeriveStatsForDPE));
-	GPOS_ASSERT(GPOS_FTRACE(EopttraceEnableSpacePruning));
+	GPOS_ASSERT(FSpacePruning());
 
 	if (NULL == pccChild)
 	{
@@ -624,6 +639,23 @@ CEngine::FSafeToPruneWithDPEStats
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngine::FSpacePruning
+//
+//	@doc:
+//		Check if cost-based space pruning is enabled; pruning is opt-in,
+//		so plans stay the same as those of exhaustive search unless it is
+//		explicitly enabled
+//
+//---------------------------------------------------------------------------
+BOOL
+CEngine::FSpacePruning()
+{
+	return GPOS_FTRACE(EopttraceEnableSpacePruning);
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CEngine::FSafeToPrune
@@ -646,7 +678,7 @@ CEngine::FSafeToPrune
 	GPOS_ASSERT(NULL != pcostLowerBound);
 	*pcostLowerBound  = GPOPT_INVALID_COST;
 
-	if (!GPOS_FTRACE(EopttraceEnableSpacePruning))
+	if (!FSpacePruning())
 	{
 		// space pruning is disabled
 		return false;
@@ -671,6 +703,15 @@ CEngine::FSafeToPrune
 		if (costLowerBound > pocGroup->PccBest()->Cost())
 		{
 			// group expression cannot deliver a better plan for given properties and can be safely pruned
+			if (NULL == pccChild)
+			{
+				(void) UlpExchangeAdd(&m_ulpPrunedBeforeChildren, 1);
+			}
+			else
+			{
+				(void) UlpExchangeAdd(&m_ulpPrunedAfterChild, 1);
+			}
+
 			return true;
 		}
 	}
@@ -1363,15 +1404,7 @@ CEngine::RecursiveOptimize()
 		poc->Release();
 
 		// extract best plan found at the end of current search stage
-		CExpression *pexprPlan =
-			m_pmemo->PexprExtractPlan
-								(
-								m_pmp,
-								m_pmemo->PgroupRoot(),
-								m_pqc->Prpp(),
-								m_pdrgpss->UlLength()
-								);
-		PssCurrent()->SetBestExpr(pexprPlan);
+		SetStageBestExpr();
 
 		FinalizeSearchStage();
 	}
@@ -1649,6 +1682,23 @@ CEngine::ProcessTraceFlags()
 			<< ", " << m_pmemo->UlGrpExprs() << " group expressions"
 			<< ", " << m_pxfs->CElements() << " activated xforms]";
 
+		at.Os()
+			<< std::endl << "[OPT]: Memo contention (stage "<< m_ulCurrSearchStage << "): ["
+			<< (ULONG) m_pmemo->UlpInsertRetries() << " group expression insert retries"
+			<< ", " << (ULONG) m_pmemo->UlpContextInsertRetries() << " context insert retries]";
+
+		at.Os() << std::endl << "[OPT]: Stats cache (stage "<< m_ulCurrSearchStage << "): [";
+		(void) m_pmemo->Pstatscache()->OsPrint(at.Os());
+		at.Os() << "]";
+
+		CScalarInternTable *psit = COptCtxt::PoctxtFromTLS()->Psit();
+		if (NULL != psit)
+		{
+			at.Os() << std::endl << "[OPT]: Scalar intern table (stage "<< m_ulCurrSearchStage << "): [";
+			(void) psit->OsPrint(at.Os());
+			at.Os() << "]";
+		}
+
 		at.Os()
 			<< std::endl << "[OPT]: stage "<< m_ulCurrSearchStage << " completed in "
 			<< PssCurrent()->UlElapsedTime() << " msec, ";
@@ -1683,9 +1733,25 @@ CEngine::Optimize()
 
 	CAutoTimer at("\n[OPT]: Total Optimization Time", GPOS_FTRACE(EopttracePrintOptimizationStatistics));
 
-	if (GPOS_FTRACE(EopttraceParallel))
+	const ULONG ulWorkers = UlOptimizationWorkers(poconf);
+	m_ulWorkers = ulWorkers;
+
+	// the deadline covers all search stages
+	m_ulDeadline = poconf->Phint()->UlOptimizationDeadline();
+	if (gpos::ulong_max != m_ulDeadline)
 	{
-		MultiThreadedOptimize(2 /*ulWorkers*/);
+		m_timerDeadline.Restart();
+	}
+
+	if (GPOS_FTRACE(EopttraceProfileJobs))
+	{
+		GPOS_ASSERT(NULL == m_pjprof);
+		m_pjprof = GPOS_NEW(m_pmp) CJobProfiler(m_pmp, ulWorkers);
+	}
+
+	if (1 < ulWorkers)
+	{
+		MultiThreadedOptimize(ulWorkers);
 	}
 	else
 	{
@@ -1697,9 +1763,26 @@ CEngine::Optimize()
 		{
 			CAutoTrace atSearch(m_pmp);
 			atSearch.Os() << "[OPT]: Search terminated at stage " << m_ulCurrSearchStage << "/" << m_pdrgpss->UlLength();
+			if (FDeadlineExceeded())
+			{
+				atSearch.Os() << " after optimization deadline of " << m_ulDeadline << " msec";
+			}
+			atSearch.Os()
+				<< std::endl << "[OPT]: Pruned group expression optimizations: "
+				<< (ULONG) m_ulpPrunedBeforeChildren << " before optimizing children, "
+				<< (ULONG) m_ulpPrunedAfterChild << " after optimizing first child";
+
+			if (NULL != m_pjprof)
+			{
+				atSearch.Os() << std::endl;
+				(void) m_pjprof->OsPrint(atSearch.Os());
+			}
 		}
 	}
 
+	// report memo size to the caller
+	poconf->Pec()->SetMemoSize((ULONG) m_pmemo->UlpGroups(), m_pmemo->UlGrpExprs());
+
 	if (poconf->Pec()->FSample())
 	{
 		SamplePlans();
@@ -1707,6 +1790,42 @@ CEngine::Optimize()
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngine::UlOptimizationWorkers
+//
+//	@doc:
+//		Number of workers to use for optimization; taken from the hint
+//		configuration, at least two if parallel optimization is forced by
+//		trace flag, and clamped to [1, workers available in the pool]
+//
+//---------------------------------------------------------------------------
+ULONG
+CEngine::UlOptimizationWorkers
+	(
+	COptimizerConfig *poconf
+	)
+{
+	ULONG ulWorkers = poconf->Phint()->UlOptimizerWorkers();
+	if (GPOS_FTRACE(EopttraceParallel))
+	{
+		ulWorkers = std::max(ulWorkers, (ULONG) 2);
+	}
+
+	// one worker of the pool is taken by the thread driving the optimization;
+	// a pool without spare workers optimizes on the driving thread only
+	CWorkerPoolManager *pwpm = CWorkerPoolManager::Pwpm();
+	const ULONG ulWorkersMax = pwpm->UlWorkersMax();
+	ULONG ulWorkersAvailable = 1;
+	if (1 < ulWorkersMax)
+	{
+		ulWorkersAvailable = ulWorkersMax - 1;
+	}
+
+	return std::max((ULONG) 1, std::min(ulWorkers, ulWorkersAvailable));
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CEngine::MainThreadOptimize
@@ -1724,9 +1843,10 @@ CEngine::MainThreadOptimize()
 	const ULONG ulJobs = std::min((ULONG) GPOPT_JOBS_CAP, (ULONG) (m_pmemo->UlpGroups() * GPOPT_JOBS_PER_GROUP));
 	CJobFactory jf(m_pmp, ulJobs);
 	CScheduler sched(m_pmp, ulJobs, 1 /*ulWorkers*/);
+	sched.SetProfiler(m_pjprof);
 
 	CSchedulerContext sc;
-	sc.Init(m_pmp, &jf, &sched, this);
+	sc.Init(m_pmp, &jf, &sched, this, 0 /*ulWorker*/);
 
 	const ULONG ulSearchStages = m_pdrgpss->UlLength();
 	for (ULONG ul = 0; !FSearchTerminated() && ul < ulSearchStages; ul++)
@@ -1754,21 +1874,147 @@ CEngine::MainThreadOptimize()
 		poc->Release();
 
 		// extract best plan found at the end of current search stage
-		CExpression *pexprPlan =
-			m_pmemo->PexprExtractPlan
-								(
-								m_pmp,
-								m_pmemo->PgroupRoot(),
-								m_pqc->Prpp(),
-								m_pdrgpss->UlLength()
-								);
-		PssCurrent()->SetBestExpr(pexprPlan);
+		SetStageBestExpr();
 
 		FinalizeSearchStage();
 	}
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngine::FDeadlineExceeded
+//
+//	@doc:
+//		Check if the optimization deadline has passed; the deadline only
+//		takes effect once a plan satisfying the query requirements has been
+//		found, so that interrupted optimization can always return a plan
+//
+//---------------------------------------------------------------------------
+BOOL
+CEngine::FDeadlineExceeded() const
+{
+	if (gpos::ulong_max == m_ulDeadline || !m_fPlanFound)
+	{
+		return false;
+	}
+
+	return m_timerDeadline.UlElapsedMS() > m_ulDeadline;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngine::SetStageBestExpr
+//
+//	@doc:
+//		Extract best plan found at the end of current search stage, which
+//		may have been interrupted, and report it to the plan callback
+//
+//---------------------------------------------------------------------------
+void
+CEngine::SetStageBestExpr()
+{
+	CExpression *pexprPlan =
+		m_pmemo->PexprExtractPlan
+							(
+							m_pmp,
+							m_pmemo->PgroupRoot(),
+							m_pqc->Prpp(),
+							m_pdrgpss->UlLength()
+							);
+	PssCurrent()->SetBestExpr(pexprPlan);
+
+	if (NULL != pexprPlan)
+	{
+		m_fPlanFound = true;
+		ReportPlan(pexprPlan);
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngine::ReportPlan
+//
+//	@doc:
+//		Pass plan to plan callback if it is cheaper than all plans reported
+//		so far
+//
+//---------------------------------------------------------------------------
+void
+CEngine::ReportPlan
+	(
+	CExpression *pexprPlan
+	)
+{
+	GPOS_ASSERT(NULL != pexprPlan);
+
+	if (NULL == m_pfnplan ||
+		(0 < m_ulPlansReported && !(pexprPlan->Cost() < m_costReported)))
+	{
+		return;
+	}
+
+	m_ulPlansReported++;
+	m_costReported = pexprPlan->Cost();
+	m_pfnplan(m_pvPlanArg, pexprPlan);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngine::ProcessBestCostUpdate
+//
+//	@doc:
+//		Process an update of the best cost context of an optimization
+//		context; once the root group has a plan satisfying the query
+//		requirements, the optimization deadline takes effect.
+//
+//		When jobs run on a single worker, cheaper plans for the query are
+//		reported right away. With more workers, other jobs may be updating
+//		the memo, so plans are only reported at the end of search stages
+//
+//---------------------------------------------------------------------------
+void
+CEngine::ProcessBestCostUpdate
+	(
+	COptimizationContext *poc
+	)
+{
+	GPOS_ASSERT(NULL != poc);
+
+	if (!FRoot(poc->Pgroup()) ||
+		NULL == poc->PccBest() ||
+		!poc->Prpp()->FEqual(m_pqc->Prpp()))
+	{
+		return;
+	}
+
+	m_fPlanFound = true;
+
+	if (NULL == m_pfnplan || 1 < m_ulWorkers ||
+		(0 < m_ulPlansReported && !(poc->PccBest()->Cost() < m_costReported)))
+	{
+		return;
+	}
+
+	CExpression *pexprPlan =
+		m_pmemo->PexprExtractPlan
+							(
+							m_pmp,
+							PgroupRoot(),
+							m_pqc->Prpp(),
+							m_pdrgpss->UlLength()
+							);
+	if (NULL != pexprPlan)
+	{
+		ReportPlan(pexprPlan);
+		pexprPlan->Release();
+	}
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CEngine::MultiThreadedOptimize
@@ -1789,9 +2035,12 @@ CEngine::MultiThreadedOptimize
 	const ULONG ulJobs = std::min((ULONG) GPOPT_JOBS_CAP, (ULONG) (m_pmemo->UlpGroups() * GPOPT_JOBS_PER_GROUP));
 	CJobFactory jf(m_pmp, ulJobs);
 	CScheduler sched(m_pmp, ulJobs, ulWorkers);
+	sched.SetProfiler(m_pjprof);
 
+	// the main job is seeded into the queue of the first worker,
+	// the remaining workers steal from there
 	CSchedulerContext sc;
-	sc.Init(m_pmp, &jf, &sched, this);
+	sc.Init(m_pmp, &jf, &sched, this, 0 /*ulWorker*/);
 
 	const ULONG ulSearchStages = m_pdrgpss->UlLength();
 	for (ULONG ul = 0; !FSearchTerminated() && ul < ulSearchStages; ul++)
@@ -1829,7 +2078,7 @@ CEngine::MultiThreadedOptimize
 			for (ULONG i = 0; i < ulWorkers; i++)
 			{
 				// initialize scheduling context
-				a_rgsc[i].Init(m_pmp, &jf, &sched, this);
+				a_rgsc[i].Init(m_pmp, &jf, &sched, this, i /*ulWorker*/);
 
 				// create scheduling task
 				a_rgptsk[i] = atp.PtskCreate(CScheduler::Run, &a_rgsc[i]);
@@ -1856,18 +2105,15 @@ CEngine::MultiThreadedOptimize
 		poc->Release();
 
 		// extract best plan found at the end of current search stage
-		CExpression *pexprPlan =
-			m_pmemo->PexprExtractPlan
-								(
-								m_pmp,
-								m_pmemo->PgroupRoot(),
-								m_pqc->Prpp(),
-								m_pdrgpss->UlLength()
-								);
-		PssCurrent()->SetBestExpr(pexprPlan);
+		SetStageBestExpr();
 
 		FinalizeSearchStage();
 	}
+
+	if (GPOS_FTRACE(EopttracePrintOptimizationStatistics))
+	{
+		sched.PrintStats();
+	}
 }
 
 //---------------------------------------------------------------------------
@@ -45,6 +45,8 @@ CEnumeratorConfig::CEnumeratorConfig
 	m_pmp(pmp),
 	m_ullPlanId(ullPlanId),
 	m_ullSpaceSize(0),
+	m_ulMemoGroups(0),
+	m_ulMemoGroupExprs(0),
 	m_ullInputSamples(ullSamples),
 	m_costBest(GPOPT_INVALID_COST),
 	m_costMax(GPOPT_INVALID_COST),
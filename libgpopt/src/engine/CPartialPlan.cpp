@@ -10,6 +10,8 @@
 //---------------------------------------------------------------------------
 
 #include "gpos/base.h"
+#include "gpos/common/CAutoP.h"
+#include "gpos/common/CAutoRef.h"
 
 #include "gpopt/base/CUtils.h"
 #include "gpopt/base/COptCtxt.h"
@@ -176,19 +178,21 @@ CPartialPlan::RaiseExceptionIfStatsNull
 
 //---------------------------------------------------------------------------
 //	@function:
-//		CPartialPlan::CostCompute
+//		CPartialPlan::PciCompute
 //
 //	@doc:
-//		Compute partial plan cost
+//		Attach given handle to root group expression and compute costing
+//		info of partial plan
 //
 //---------------------------------------------------------------------------
-CCost
-CPartialPlan::CostCompute
+ICostModel::SCostingInfo *
+CPartialPlan::PciCompute
 	(
-	IMemoryPool *pmp
+	IMemoryPool *pmp,
+	ICostModel *pcm,
+	CExpressionHandle &exprhdl
 	)
 {
-	CExpressionHandle exprhdl(pmp);
 	exprhdl.Attach(m_pgexpr);
 
 	// init required properties of expression
@@ -209,10 +213,12 @@ CPartialPlan::CostCompute
 	RaiseExceptionIfStatsNull(pstats);
 
 	pstats->AddRef();
-	ICostModel::SCostingInfo ci(pmp, exprhdl.UlNonScalarChildren(), GPOS_NEW(pmp) ICostModel::CCostingStats(pstats));
+	CAutoP<ICostModel::SCostingInfo> a_pci
+		(
+		GPOS_NEW(pmp) ICostModel::SCostingInfo(pmp, exprhdl.UlNonScalarChildren(), GPOS_NEW(pmp) ICostModel::CCostingStats(pstats))
+		);
 
-	ICostModel *pcm = COptCtxt::PoctxtFromTLS()->Pcm();
-	ExtractChildrenCostingInfo(pmp, pcm, exprhdl, &ci);
+	ExtractChildrenCostingInfo(pmp, pcm, exprhdl, a_pci.Pt());
 
 	CDistributionSpec::EDistributionPartitioningType edpt = CDistributionSpec::EdptSentinel;
 	if (NULL != m_prpp->Ped())
@@ -237,20 +243,36 @@ CPartialPlan::CostCompute
 		// use rows per host as a cardinality lower bound
 		dRows = pcm->DRowsPerHost(CDouble(dRows)).DVal();
 	}
-	ci.SetRows(dRows);
+	a_pci->SetRows(dRows);
 
 	// extract width from stats
 	DOUBLE dWidth = m_pgexpr->Pgroup()->Pstats()->DWidth(pmp, m_prpp->PcrsRequired()).DVal();
-	ci.SetWidth(dWidth);
+	a_pci->SetWidth(dWidth);
 
 	// extract rebinds
 	DOUBLE dRebinds = m_pgexpr->Pgroup()->Pstats()->DRebinds().DVal();
-	ci.SetRebinds(dRebinds);
+	a_pci->SetRebinds(dRebinds);
 
-	// compute partial plan cost
-	CCost cost = pcm->Cost(exprhdl, &ci);
+	return a_pci.PtReset();
+}
 
-	if (0 < ci.UlChildren() && 1.0 < cost.DVal())
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPartialPlan::CostLowerBound
+//
+//	@doc:
+//		Turn cost computed by cost model into a cost lower bound
+//
+//---------------------------------------------------------------------------
+CCost
+CPartialPlan::CostLowerBound
+	(
+	const ICostModel::SCostingInfo *pci,
+	CCost cost
+	)
+{
+	if (0 < pci->UlChildren() && 1.0 < cost.DVal())
 	{
 		// cost model implementation adds an artificial const (1.0) to
 		// sum of children cost,
@@ -264,6 +286,74 @@ CPartialPlan::CostCompute
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CPartialPlan::CostCompute
+//
+//	@doc:
+//		Compute partial plan cost
+//
+//---------------------------------------------------------------------------
+CCost
+CPartialPlan::CostCompute
+	(
+	IMemoryPool *pmp
+	)
+{
+	ICostModel *pcm = COptCtxt::PoctxtFromTLS()->Pcm();
+
+	CExpressionHandle exprhdl(pmp);
+	CAutoP<ICostModel::SCostingInfo> a_pci(PciCompute(pmp, pcm, exprhdl));
+
+	// compute partial plan cost
+	return CostLowerBound(a_pci.Pt(), pcm->Cost(exprhdl, a_pci.Pt()));
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPartialPlan::PdrgpcostCompute
+//
+//	@doc:
+//		Compute costs of an array of partial plans with one call to the
+//		cost model
+//
+//---------------------------------------------------------------------------
+DrgPcost *
+CPartialPlan::PdrgpcostCompute
+	(
+	IMemoryPool *pmp,
+	DrgPpp *pdrgppp
+	)
+{
+	GPOS_ASSERT(NULL != pdrgppp);
+
+	ICostModel *pcm = COptCtxt::PoctxtFromTLS()->Pcm();
+
+	CAutoRef<DrgPexprhdl> a_pdrgpexprhdl(GPOS_NEW(pmp) DrgPexprhdl(pmp));
+	CAutoRef<ICostModel::DrgPcostinfo> a_pdrgpci(GPOS_NEW(pmp) ICostModel::DrgPcostinfo(pmp));
+
+	const ULONG ulSize = pdrgppp->UlLength();
+	for (ULONG ul = 0; ul < ulSize; ul++)
+	{
+		CExpressionHandle *pexprhdl = GPOS_NEW(pmp) CExpressionHandle(pmp);
+		a_pdrgpexprhdl->Append(pexprhdl);
+		a_pdrgpci->Append((*pdrgppp)[ul]->PciCompute(pmp, pcm, *pexprhdl));
+	}
+
+	DrgPcost *pdrgpcost = pcm->PdrgpcostBatch(pmp, a_pdrgpexprhdl.Pt(), a_pdrgpci.Pt());
+	GPOS_ASSERT(ulSize == pdrgpcost->UlLength());
+
+	for (ULONG ul = 0; ul < ulSize; ul++)
+	{
+		CCost *pcost = (*pdrgpcost)[ul];
+		*pcost = CostLowerBound((*a_pdrgpci)[ul], *pcost);
+	}
+
+	return pdrgpcost;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CPartialPlan::UlHash
@@ -0,0 +1,990 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2018 Pivotal, Inc.
+//
+//	@filename:
+//		CConstExprEvaluatorNative.cpp
+//
+//	@doc:
+//		Constant expression evaluator for builtin integer, boolean and oid
+//		expressions
+//---------------------------------------------------------------------------
+
+#include "gpopt/eval/CConstExprEvaluatorNative.h"
+
+#include "gpopt/base/COptCtxt.h"
+#include "gpopt/mdcache/CMDAccessor.h"
+#include "gpopt/operators/CExpression.h"
+#include "gpopt/operators/CScalarBoolOp.h"
+#include "gpopt/operators/CScalarBooleanTest.h"
+#include "gpopt/operators/CScalarCast.h"
+#include "gpopt/operators/CScalarCmp.h"
+#include "gpopt/operators/CScalarConst.h"
+#include "gpopt/operators/CScalarOp.h"
+
+#include "naucrates/base/IDatumBool.h"
+#include "naucrates/base/IDatumInt2.h"
+#include "naucrates/base/IDatumInt4.h"
+#include "naucrates/base/IDatumInt8.h"
+#include "naucrates/base/IDatumOid.h"
+#include "naucrates/md/CMDIdGPDB.h"
+#include "naucrates/md/IMDScalarOp.h"
+#include "naucrates/md/IMDTypeBool.h"
+#include "naucrates/md/IMDTypeInt2.h"
+#include "naucrates/md/IMDTypeInt4.h"
+#include "naucrates/md/IMDTypeInt8.h"
+#include "naucrates/md/IMDTypeOid.h"
+
+#include "naucrates/traceflags/traceflags.h"
+
+using namespace gpopt;
+using namespace gpmd;
+using namespace gpnaucrates;
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstExprEvaluatorNative::CConstExprEvaluatorNative
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+CConstExprEvaluatorNative::CConstExprEvaluatorNative
+	(
+	IMemoryPool *pmp,
+	IConstExprEvaluator *pceevalFallback
+	)
+	:
+	m_pmp(pmp),
+	m_pceevalFallback(pceevalFallback)
+{
+	GPOS_ASSERT(NULL != pmp);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstExprEvaluatorNative::~CConstExprEvaluatorNative
+//
+//	@doc:
+//		Dtor
+//
+//---------------------------------------------------------------------------
+CConstExprEvaluatorNative::~CConstExprEvaluatorNative()
+{
+	CRefCount::SafeRelease(m_pceevalFallback);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstExprEvaluatorNative::Eti
+//
+//	@doc:
+//		Type info of a type; only builtin types have a type info other than
+//		EtiGeneric
+//
+//---------------------------------------------------------------------------
+IMDType::ETypeInfo
+CConstExprEvaluatorNative::Eti
+	(
+	IMDId *pmdidType
+	)
+{
+	if (NULL == pmdidType)
+	{
+		return IMDType::EtiGeneric;
+	}
+
+	CMDAccessor *pmda = COptCtxt::PoctxtFromTLS()->Pmda();
+
+	return pmda->Pmdtype(pmdidType)->Eti();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstExprEvaluatorNative::FBuiltin
+//
+//	@doc:
+//		Is the given function or operator created by initdb; user-defined
+//		objects may reuse the names of builtin operators
+//
+//---------------------------------------------------------------------------
+BOOL
+CConstExprEvaluatorNative::FBuiltin
+	(
+	const IMDId *pmdid
+	)
+{
+	return NULL != pmdid &&
+			pmdid->FValid() &&
+			IMDId::EmdidGPDB == pmdid->Emdidt() &&
+			GPDB_FIRST_NORMAL_OBJECT_ID > CMDIdGPDB::PmdidConvert(pmdid)->OidObjectId();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstExprEvaluatorNative::FInt
+//
+//	@doc:
+//		Is the given type an integer type
+//
+//---------------------------------------------------------------------------
+BOOL
+CConstExprEvaluatorNative::FInt
+	(
+	IMDType::ETypeInfo eti
+	)
+{
+	return IMDType::EtiInt2 == eti || IMDType::EtiInt4 == eti || IMDType::EtiInt8 == eti;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstExprEvaluatorNative::FInRange
+//
+//	@doc:
+//		Does a value fit into the given type
+//
+//---------------------------------------------------------------------------
+BOOL
+CConstExprEvaluatorNative::FInRange
+	(
+	LINT l,
+	IMDType::ETypeInfo eti
+	)
+{
+	switch (eti)
+	{
+		case IMDType::EtiInt2:
+			return gpos::sint_min <= l && gpos::sint_max >= l;
+
+		case IMDType::EtiInt4:
+			return gpos::int_min <= l && gpos::int_max >= l;
+
+		case IMDType::EtiInt8:
+			return true;
+
+		case IMDType::EtiBool:
+			return 0 == l || 1 == l;
+
+		case IMDType::EtiOid:
+			return 0 <= l && (LINT) gpos::ulong_max >= l;
+
+		default:
+			return false;
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstExprEvaluatorNative::WcArith
+//
+//	@doc:
+//		Arithmetic operator given by name, or '\0' if the name is not one of
+//		the supported operators
+//
+//---------------------------------------------------------------------------
+WCHAR
+CConstExprEvaluatorNative::WcArith
+	(
+	const CWStringConst *pstrOp
+	)
+{
+	if (NULL == pstrOp || 1 != pstrOp->UlLength())
+	{
+		return '\0';
+	}
+
+	WCHAR wc = pstrOp->Wsz()[0];
+	switch (wc)
+	{
+		case '+':
+		case '-':
+		case '*':
+		case '/':
+		case '%':
+			return wc;
+
+		default:
+			return '\0';
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstExprEvaluatorNative::FArith
+//
+//	@doc:
+//		Compute an arithmetic operator on 64-bit values; returns false on
+//		overflow and division by zero
+//
+//---------------------------------------------------------------------------
+BOOL
+CConstExprEvaluatorNative::FArith
+	(
+	WCHAR wcOp,
+	LINT lLeft,
+	LINT lRight,
+	LINT *pl
+	)
+{
+	switch (wcOp)
+	{
+		case '+':
+			if ((0 < lRight && gpos::lint_max - lRight < lLeft) ||
+				(0 > lRight && gpos::lint_min - lRight > lLeft))
+			{
+				return false;
+			}
+			*pl = lLeft + lRight;
+			return true;
+
+		case '-':
+			if ((0 > lRight && gpos::lint_max + lRight < lLeft) ||
+				(0 < lRight && gpos::lint_min + lRight > lLeft))
+			{
+				return false;
+			}
+			*pl = lLeft - lRight;
+			return true;
+
+		case '*':
+			if (0 < lLeft)
+			{
+				if ((0 < lRight && gpos::lint_max / lRight < lLeft) ||
+					(0 > lRight && gpos::lint_min / lLeft > lRight))
+				{
+					return false;
+				}
+			}
+			else if (0 > lLeft)
+			{
+				if ((0 < lRight && gpos::lint_min / lRight > lLeft) ||
+					(0 > lRight && gpos::lint_max / lLeft > lRight))
+				{
+					return false;
+				}
+			}
+			*pl = lLeft * lRight;
+			return true;
+
+		case '/':
+			if (0 == lRight || (gpos::lint_min == lLeft && -1 == lRight))
+			{
+				return false;
+			}
+			*pl = lLeft / lRight;
+			return true;
+
+		case '%':
+			if (0 == lRight)
+			{
+				return false;
+			}
+			// avoid overflow of lint_min % -1
+			*pl = (-1 == lRight) ? 0 : lLeft % lRight;
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstExprEvaluatorNative::FCast
+//
+//	@doc:
+//		Cast a value to the given type; supports casts among integer types,
+//		between int4 and bool, and between oid and int4 or int8
+//
+//---------------------------------------------------------------------------
+BOOL
+CConstExprEvaluatorNative::FCast
+	(
+	const SValue &valSrc,
+	IMDType::ETypeInfo etiDest,
+	SValue *pvalDest
+	)
+{
+	const IMDType::ETypeInfo etiSrc = valSrc.m_eti;
+	LINT l = valSrc.m_l;
+
+	if (etiSrc == etiDest || (FInt(etiSrc) && FInt(etiDest)))
+	{
+		// value is unchanged
+	}
+	else if (IMDType::EtiInt4 == etiSrc && IMDType::EtiBool == etiDest)
+	{
+		l = (0 != l);
+	}
+	else if (IMDType::EtiBool == etiSrc && IMDType::EtiInt4 == etiDest)
+	{
+		// value is unchanged
+	}
+	else if (IMDType::EtiInt4 == etiSrc && IMDType::EtiOid == etiDest)
+	{
+		// binary coercible: reinterpret as unsigned
+		l = (LINT) (OID) (INT) l;
+	}
+	else if (IMDType::EtiOid == etiSrc && IMDType::EtiInt4 == etiDest)
+	{
+		// binary coercible: reinterpret as signed
+		l = (LINT) (INT) (OID) l;
+	}
+	else if (!(IMDType::EtiInt8 == etiSrc && IMDType::EtiOid == etiDest) &&
+			!(IMDType::EtiOid == etiSrc && IMDType::EtiInt8 == etiDest))
+	{
+		return false;
+	}
+
+	pvalDest->m_eti = etiDest;
+	pvalDest->m_fNull = valSrc.m_fNull;
+	pvalDest->m_l = 0;
+	if (valSrc.m_fNull)
+	{
+		return true;
+	}
+
+	pvalDest->m_l = l;
+
+	return FInRange(l, etiDest);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstExprEvaluatorNative::FEvalChildren
+//
+//	@doc:
+//		Evaluate the children of an expression into the given array
+//
+//---------------------------------------------------------------------------
+BOOL
+CConstExprEvaluatorNative::FEvalChildren
+	(
+	CExpression *pexpr,
+	SValue *rgval
+	)
+{
+	const ULONG ulArity = pexpr->UlArity();
+	for (ULONG ul = 0; ul < ulArity; ul++)
+	{
+		if (!FEval((*pexpr)[ul], &rgval[ul]))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstExprEvaluatorNative::FEvalConst
+//
+//	@doc:
+//		Evaluate a constant
+//
+//---------------------------------------------------------------------------
+BOOL
+CConstExprEvaluatorNative::FEvalConst
+	(
+	CExpression *pexpr,
+	SValue *pval
+	)
+{
+	IDatum *pdatum = CScalarConst::PopConvert(pexpr->Pop())->Pdatum();
+
+	pval->m_eti = pdatum->Eti();
+	pval->m_fNull = pdatum->FNull();
+	pval->m_l = 0;
+
+	switch (pval->m_eti)
+	{
+		case IMDType::EtiInt2:
+			pval->m_l = dynamic_cast<IDatumInt2 *>(pdatum)->SValue();
+			break;
+
+		case IMDType::EtiInt4:
+			pval->m_l = dynamic_cast<IDatumInt4 *>(pdatum)->IValue();
+			break;
+
+		case IMDType::EtiInt8:
+			pval->m_l = dynamic_cast<IDatumInt8 *>(pdatum)->LValue();
+			break;
+
+		case IMDType::EtiBool:
+			pval->m_l = dynamic_cast<IDatumBool *>(pdatum)->FValue() ? 1 : 0;
+			break;
+
+		case IMDType::EtiOid:
+			pval->m_l = dynamic_cast<IDatumOid *>(pdatum)->OidValue();
+			break;
+
+		default:
+			return false;
+	}
+
+	if (pval->m_fNull)
+	{
+		pval->m_l = 0;
+	}
+
+	return true;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstExprEvaluatorNative::FEvalOp
+//
+//	@doc:
+//		Evaluate a builtin unary or binary arithmetic operator on integers
+//
+//---------------------------------------------------------------------------
+BOOL
+CConstExprEvaluatorNative::FEvalOp
+	(
+	CExpression *pexpr,
+	SValue *pval
+	)
+{
+	CScalarOp *popOp = CScalarOp::PopConvert(pexpr->Pop());
+	const ULONG ulArity = pexpr->UlArity();
+	const WCHAR wcOp = WcArith(popOp->Pstr());
+
+	if ('\0' == wcOp || !FBuiltin(popOp->PmdidOp()) || 0 == ulArity || 2 < ulArity ||
+		(1 == ulArity && '+' != wcOp && '-' != wcOp))
+	{
+		return false;
+	}
+
+	const IMDType::ETypeInfo eti = Eti(popOp->PmdidType());
+	SValue rgval[2];
+	if (!FInt(eti) || !FEvalChildren(pexpr, rgval))
+	{
+		return false;
+	}
+
+	pval->m_eti = eti;
+	pval->m_fNull = false;
+	pval->m_l = 0;
+
+	for (ULONG ul = 0; ul < ulArity; ul++)
+	{
+		if (!FInt(rgval[ul].m_eti))
+		{
+			return false;
+		}
+
+		// builtin operators are strict
+		pval->m_fNull = pval->m_fNull || rgval[ul].m_fNull;
+	}
+
+	if (pval->m_fNull)
+	{
+		return true;
+	}
+
+	// unary operators are evaluated as 0 + x and 0 - x
+	LINT lLeft = (1 == ulArity) ? 0 : rgval[0].m_l;
+	LINT lRight = rgval[ulArity - 1].m_l;
+
+	return FArith(wcOp, lLeft, lRight, &pval->m_l) && FInRange(pval->m_l, eti);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstExprEvaluatorNative::FComparable
+//
+//	@doc:
+//		Can the given comparison operator compare the two values natively;
+//		values of different types are only compared if the operator is
+//		defined on exactly these types, e.g. int4 < int8
+//
+//---------------------------------------------------------------------------
+BOOL
+CConstExprEvaluatorNative::FComparable
+	(
+	IMDId *pmdidOp,
+	const SValue *rgval
+	)
+{
+	if (rgval[0].m_eti == rgval[1].m_eti)
+	{
+		return true;
+	}
+
+	CMDAccessor *pmda = COptCtxt::PoctxtFromTLS()->Pmda();
+	const IMDScalarOp *pmdscop = pmda->Pmdscop(pmdidOp);
+
+	return Eti(pmdscop->PmdidTypeLeft()) == rgval[0].m_eti &&
+			Eti(pmdscop->PmdidTypeRight()) == rgval[1].m_eti;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstExprEvaluatorNative::FEvalCmp
+//
+//	@doc:
+//		Evaluate a builtin comparison
+//
+//---------------------------------------------------------------------------
+BOOL
+CConstExprEvaluatorNative::FEvalCmp
+	(
+	CExpression *pexpr,
+	SValue *pval
+	)
+{
+	CScalarCmp *popCmp = CScalarCmp::PopConvert(pexpr->Pop());
+
+	SValue rgval[2];
+	if (!FBuiltin(popCmp->PmdidOp()) || 2 != pexpr->UlArity() || !FEvalChildren(pexpr, rgval) ||
+		!FComparable(popCmp->PmdidOp(), rgval))
+	{
+		return false;
+	}
+
+	const LINT lLeft = rgval[0].m_l;
+	const LINT lRight = rgval[1].m_l;
+	BOOL fResult = false;
+	switch (popCmp->Ecmpt())
+	{
+		case IMDType::EcmptEq:
+			fResult = (lLeft == lRight);
+			break;
+
+		case IMDType::EcmptNEq:
+			fResult = (lLeft != lRight);
+			break;
+
+		case IMDType::EcmptL:
+			fResult = (lLeft < lRight);
+			break;
+
+		case IMDType::EcmptLEq:
+			fResult = (lLeft <= lRight);
+			break;
+
+		case IMDType::EcmptG:
+			fResult = (lLeft > lRight);
+			break;
+
+		case IMDType::EcmptGEq:
+			fResult = (lLeft >= lRight);
+			break;
+
+		default:
+			return false;
+	}
+
+	pval->m_eti = IMDType::EtiBool;
+	pval->m_fNull = rgval[0].m_fNull || rgval[1].m_fNull;
+	pval->m_l = (!pval->m_fNull && fResult) ? 1 : 0;
+
+	return true;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstExprEvaluatorNative::FEvalIsDistinctFrom
+//
+//	@doc:
+//		Evaluate IS DISTINCT FROM using a builtin equality operator
+//
+//---------------------------------------------------------------------------
+BOOL
+CConstExprEvaluatorNative::FEvalIsDistinctFrom
+	(
+	CExpression *pexpr,
+	SValue *pval
+	)
+{
+	CScalarCmp *popCmp = CScalarCmp::PopConvert(pexpr->Pop());
+
+	SValue rgval[2];
+	if (!FBuiltin(popCmp->PmdidOp()) || 2 != pexpr->UlArity() || !FEvalChildren(pexpr, rgval) ||
+		!FComparable(popCmp->PmdidOp(), rgval))
+	{
+		return false;
+	}
+
+	pval->m_eti = IMDType::EtiBool;
+	pval->m_fNull = false;
+	if (rgval[0].m_fNull || rgval[1].m_fNull)
+	{
+		pval->m_l = (rgval[0].m_fNull != rgval[1].m_fNull) ? 1 : 0;
+	}
+	else
+	{
+		pval->m_l = (rgval[0].m_l != rgval[1].m_l) ? 1 : 0;
+	}
+
+	return true;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstExprEvaluatorNative::FEvalBoolOp
+//
+//	@doc:
+//		Evaluate AND, OR and NOT using three-valued logic
+//
+//---------------------------------------------------------------------------
+BOOL
+CConstExprEvaluatorNative::FEvalBoolOp
+	(
+	CExpression *pexpr,
+	SValue *pval
+	)
+{
+	CScalarBoolOp *popBool = CScalarBoolOp::PopConvert(pexpr->Pop());
+	const CScalarBoolOp::EBoolOperator eboolop = popBool->Eboolop();
+
+	pval->m_eti = IMDType::EtiBool;
+	pval->m_fNull = false;
+
+	if (CScalarBoolOp::EboolopNot == eboolop)
+	{
+		SValue val;
+		if (1 != pexpr->UlArity() || !FEval((*pexpr)[0], &val) || IMDType::EtiBool != val.m_eti)
+		{
+			return false;
+		}
+
+		pval->m_fNull = val.m_fNull;
+		pval->m_l = val.m_fNull ? 0 : 1 - val.m_l;
+
+		return true;
+	}
+
+	GPOS_ASSERT(CScalarBoolOp::EboolopAnd == eboolop || CScalarBoolOp::EboolopOr == eboolop);
+
+	// value that decides the result regardless of NULLs: false for AND,
+	// true for OR
+	const LINT lDecisive = (CScalarBoolOp::EboolopOr == eboolop) ? 1 : 0;
+	BOOL fDecided = false;
+
+	const ULONG ulArity = pexpr->UlArity();
+	for (ULONG ul = 0; ul < ulArity; ul++)
+	{
+		SValue val;
+		if (!FEval((*pexpr)[ul], &val) || IMDType::EtiBool != val.m_eti)
+		{
+			return false;
+		}
+
+		if (val.m_fNull)
+		{
+			pval->m_fNull = true;
+		}
+		else if (lDecisive == val.m_l)
+		{
+			fDecided = true;
+		}
+	}
+
+	if (fDecided)
+	{
+		pval->m_fNull = false;
+		pval->m_l = lDecisive;
+	}
+	else
+	{
+		pval->m_l = pval->m_fNull ? 0 : 1 - lDecisive;
+	}
+
+	return true;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstExprEvaluatorNative::FEvalNullTest
+//
+//	@doc:
+//		Evaluate IS NULL
+//
+//---------------------------------------------------------------------------
+BOOL
+CConstExprEvaluatorNative::FEvalNullTest
+	(
+	CExpression *pexpr,
+	SValue *pval
+	)
+{
+	SValue val;
+	if (1 != pexpr->UlArity() || !FEval((*pexpr)[0], &val))
+	{
+		return false;
+	}
+
+	pval->m_eti = IMDType::EtiBool;
+	pval->m_fNull = false;
+	pval->m_l = val.m_fNull ? 1 : 0;
+
+	return true;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstExprEvaluatorNative::FEvalBooleanTest
+//
+//	@doc:
+//		Evaluate IS [NOT] TRUE, IS [NOT] FALSE and IS [NOT] UNKNOWN
+//
+//---------------------------------------------------------------------------
+BOOL
+CConstExprEvaluatorNative::FEvalBooleanTest
+	(
+	CExpression *pexpr,
+	SValue *pval
+	)
+{
+	SValue val;
+	if (1 != pexpr->UlArity() || !FEval((*pexpr)[0], &val) || IMDType::EtiBool != val.m_eti)
+	{
+		return false;
+	}
+
+	const BOOL fTrue = !val.m_fNull && 1 == val.m_l;
+	const BOOL fFalse = !val.m_fNull && 0 == val.m_l;
+	BOOL fResult = false;
+	switch (CScalarBooleanTest::PopConvert(pexpr->Pop())->Ebt())
+	{
+		case CScalarBooleanTest::EbtIsTrue:
+			fResult = fTrue;
+			break;
+
+		case CScalarBooleanTest::EbtIsNotTrue:
+			fResult = !fTrue;
+			break;
+
+		case CScalarBooleanTest::EbtIsFalse:
+			fResult = fFalse;
+			break;
+
+		case CScalarBooleanTest::EbtIsNotFalse:
+			fResult = !fFalse;
+			break;
+
+		case CScalarBooleanTest::EbtIsUnknown:
+			fResult = val.m_fNull;
+			break;
+
+		case CScalarBooleanTest::EbtIsNotUnknown:
+			fResult = !val.m_fNull;
+			break;
+
+		default:
+			return false;
+	}
+
+	pval->m_eti = IMDType::EtiBool;
+	pval->m_fNull = false;
+	pval->m_l = fResult ? 1 : 0;
+
+	return true;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstExprEvaluatorNative::FEvalCast
+//
+//	@doc:
+//		Evaluate a cast using a builtin function or a binary coercion
+//
+//---------------------------------------------------------------------------
+BOOL
+CConstExprEvaluatorNative::FEvalCast
+	(
+	CExpression *pexpr,
+	SValue *pval
+	)
+{
+	CScalarCast *popCast = CScalarCast::PopConvert(pexpr->Pop());
+	if (!popCast->FBinaryCoercible() && !FBuiltin(popCast->PmdidFunc()))
+	{
+		return false;
+	}
+
+	const IMDType::ETypeInfo etiDest = Eti(popCast->PmdidType());
+	SValue val;
+
+	return IMDType::EtiGeneric != etiDest &&
+			1 == pexpr->UlArity() &&
+			FEval((*pexpr)[0], &val) &&
+			FCast(val, etiDest, pval);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstExprEvaluatorNative::FEval
+//
+//	@doc:
+//		Evaluate an expression; returns false if the expression uses
+//		unsupported operators or types, or if evaluation fails
+//
+//---------------------------------------------------------------------------
+BOOL
+CConstExprEvaluatorNative::FEval
+	(
+	CExpression *pexpr,
+	SValue *pval
+	)
+{
+	GPOS_CHECK_STACK_SIZE;
+	GPOS_ASSERT(NULL != pexpr);
+
+	switch (pexpr->Pop()->Eopid())
+	{
+		case COperator::EopScalarConst:
+			return FEvalConst(pexpr, pval);
+
+		case COperator::EopScalarOp:
+			return FEvalOp(pexpr, pval);
+
+		case COperator::EopScalarCmp:
+			return FEvalCmp(pexpr, pval);
+
+		case COperator::EopScalarIsDistinctFrom:
+			return FEvalIsDistinctFrom(pexpr, pval);
+
+		case COperator::EopScalarBoolOp:
+			return FEvalBoolOp(pexpr, pval);
+
+		case COperator::EopScalarNullTest:
+			return FEvalNullTest(pexpr, pval);
+
+		case COperator::EopScalarBooleanTest:
+			return FEvalBooleanTest(pexpr, pval);
+
+		case COperator::EopScalarCast:
+			return FEvalCast(pexpr, pval);
+
+		default:
+			return false;
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstExprEvaluatorNative::PexprConst
+//
+//	@doc:
+//		Constant expression of the given type holding the given value
+//
+//---------------------------------------------------------------------------
+CExpression *
+CConstExprEvaluatorNative::PexprConst
+	(
+	IMDId *pmdidType,
+	const SValue &val
+	)
+	const
+{
+	CMDAccessor *pmda = COptCtxt::PoctxtFromTLS()->Pmda();
+	const IMDType *pmdtype = pmda->Pmdtype(pmdidType);
+	GPOS_ASSERT(val.m_eti == pmdtype->Eti());
+
+	IDatum *pdatum = NULL;
+	switch (val.m_eti)
+	{
+		case IMDType::EtiInt2:
+			pdatum = dynamic_cast<const IMDTypeInt2 *>(pmdtype)->PdatumInt2(m_pmp, (SINT) val.m_l, val.m_fNull);
+			break;
+
+		case IMDType::EtiInt4:
+			pdatum = dynamic_cast<const IMDTypeInt4 *>(pmdtype)->PdatumInt4(m_pmp, (INT) val.m_l, val.m_fNull);
+			break;
+
+		case IMDType::EtiInt8:
+			pdatum = dynamic_cast<const IMDTypeInt8 *>(pmdtype)->PdatumInt8(m_pmp, val.m_l, val.m_fNull);
+			break;
+
+		case IMDType::EtiBool:
+			pdatum = dynamic_cast<const IMDTypeBool *>(pmdtype)->PdatumBool(m_pmp, 1 == val.m_l, val.m_fNull);
+			break;
+
+		case IMDType::EtiOid:
+			pdatum = dynamic_cast<const IMDTypeOid *>(pmdtype)->PdatumOid(m_pmp, (OID) val.m_l, val.m_fNull);
+			break;
+
+		default:
+			GPOS_ASSERT(!"Unexpected type");
+	}
+
+	return GPOS_NEW(m_pmp) CExpression(m_pmp, GPOS_NEW(m_pmp) CScalarConst(m_pmp, pdatum));
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstExprEvaluatorNative::PexprEval
+//
+//	@doc:
+//		Evaluate the given expression and return the result as a new
+//		expression; expressions that cannot be evaluated natively are passed
+//		to the fallback evaluator, or returned unchanged if there is none.
+//		Caller takes ownership of returned expression
+//
+//---------------------------------------------------------------------------
+CExpression *
+CConstExprEvaluatorNative::PexprEval
+	(
+	CExpression *pexpr
+	)
+{
+	GPOS_ASSERT(NULL != pexpr);
+
+	// external evaluation of integers may be forced for testing
+	BOOL fNative = NULL == m_pceevalFallback ||
+					!GPOS_FTRACE(EopttraceUseExternalConstantExpressionEvaluationForInts);
+
+	SValue val;
+	if (fNative && FEval(pexpr, &val))
+	{
+		return PexprConst(CScalar::PopConvert(pexpr->Pop())->PmdidType(), val);
+	}
+
+	if (NULL != m_pceevalFallback)
+	{
+		return m_pceevalFallback->PexprEval(pexpr);
+	}
+
+	pexpr->AddRef();
+	return pexpr;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstExprEvaluatorNative::FCanEvalExpressions
+//
+//	@doc:
+//		Returns true, since builtin expressions are always evaluated
+//		natively; unsupported expressions are passed to the fallback
+//		evaluator one at a time
+//
+//---------------------------------------------------------------------------
+BOOL
+CConstExprEvaluatorNative::FCanEvalExpressions()
+{
+	return true;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstExprEvaluatorNative::FCanEvalNatively
+//
+//	@doc:
+//		Can the given expression be evaluated without the fallback evaluator
+//
+//---------------------------------------------------------------------------
+BOOL
+CConstExprEvaluatorNative::FCanEvalNatively
+	(
+	CExpression *pexpr
+	)
+{
+	SValue val;
+	return FEval(pexpr, &val);
+}
+
+// EOF
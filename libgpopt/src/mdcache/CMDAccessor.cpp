@@ -12,9 +12,11 @@
 
 #include "gpos/common/CAutoP.h"
 #include "gpos/common/CAutoRef.h"
+#include "gpos/common/CAutoRg.h"
 #include "gpos/common/CTimerUser.h"
 #include "gpos/io/COstreamString.h"
 #include "gpos/task/CAutoSuspendAbort.h"
+#include "gpos/task/CAutoTraceFlag.h"
 #include "gpos/error/CAutoTrace.h"
 
 #include "gpopt/base/CColRefSetIter.h"
@@ -28,6 +30,7 @@
 #include "naucrates/traceflags/traceflags.h"
 
 #include "naucrates/dxl/CDXLUtils.h"
+#include "naucrates/dxl/xml/CXMLSerializer.h"
 
 #include "naucrates/md/IMDCacheObject.h"
 #include "naucrates/md/IMDRelation.h"
@@ -50,6 +53,8 @@
 #include "naucrates/md/CMDIdScCmp.h"
 
 #include "naucrates/md/IMDProvider.h"
+#include "naucrates/md/CMDBinaryUtils.h"
+#include "naucrates/md/CMDRequest.h"
 #include "naucrates/md/CMDProviderGeneric.h"
 
 using namespace gpos;
@@ -542,134 +547,341 @@ CMDAccessor::Pmdp
 
 //---------------------------------------------------------------------------
 //	@function:
-//		CMDAccessor::Pimdobj
+//		CMDAccessor::PimdobjFetch
 //
 //	@doc:
-//		Retrieves a metadata cache object from the md cache, possibly retrieving
-//		it from the external metadata provider and storing it in the cache first.
-//		Main workhorse for retrieving the different types of md cache objects.
+//		Fetch an object from its MD provider into the given memory pool,
+//		preferring the binary encoding over DXL
 //
 //---------------------------------------------------------------------------
-const IMDCacheObject *
-CMDAccessor::Pimdobj
+IMDCacheObject *
+CMDAccessor::PimdobjFetch
 	(
+	IMemoryPool *pmp,
 	IMDId *pmdid
 	)
 {
+	IMDProvider *pmdp = Pmdp(pmdid->Sysid());
+
+	ULONG ulSize = 0;
+	CAutoRg<BYTE> a_pb;
+	a_pb = pmdp->PbObject(m_pmp, this, pmdid, &ulSize);
+	if (NULL != a_pb.Rgt())
+	{
+		return CMDBinaryUtils::PimdobjDeserialize(pmp, a_pb.Rgt(), ulSize);
+	}
+
+	// provider cannot encode the object: fall back to DXL
+	CAutoP<CWStringBase> a_pstr;
+	a_pstr = pmdp->PstrObject(m_pmp, this, pmdid);
+
+	GPOS_ASSERT(NULL != a_pstr.Pt());
+
+	return gpdxl::CDXLUtils::PimdobjParseDXL(pmp, a_pstr.Pt(), NULL /* XSD path */);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDAccessor::PimdobjCached
+//
+//	@doc:
+//		Look up an object in the MD cache through the given accessor. A
+//		missing object is decoded from the given prefetched binary encoding
+//		or, if none is given, fetched from its MD provider, and added to the
+//		cache; the returned object is pinned by the accessor
+//
+//---------------------------------------------------------------------------
+IMDCacheObject *
+CMDAccessor::PimdobjCached
+	(
+	CacheAccessorMD *pmdcacc,
+	IMDId *pmdid,
+	const BYTE *pbPrefetched,
+	ULONG ulSize
+	)
+{
+	// construct a key for cache lookup
+	CMDKey mdkey(pmdid);
+
+	pmdcacc->Lookup(&mdkey);
+	IMDCacheObject *pmdobjNew = pmdcacc->PtVal();
+	if (NULL != pmdobjNew)
+	{
+		return pmdobjNew;
+	}
+
+	// object not found in MD cache: retrieve it from MD provider
 	BOOL fPrintOptStats = GPOS_FTRACE(EopttracePrintOptimizationStatistics);
-	CTimerUser timerLookup; // timer to measure lookup time
+	CTimerUser timerFetch;
 	if (fPrintOptStats)
 	{
-		timerLookup.Restart();
+		timerFetch.Restart();
 	}
+	IMemoryPool *pmp = m_pmp;
 
-	const IMDCacheObject *pimdobj = NULL;
+	if (IMDId::EmdidGPDBCtas != pmdid->Emdidt())
+	{
+		// create the accessor memory pool
+		pmp = pmdcacc->Pmp();
+	}
 
-	// first, try to locate object in local hashtable
+	if (NULL != pbPrefetched)
 	{
-		// scope for ht accessor
-		MDHTAccessor mdhtacc(m_shtCacheAccessors, pmdid);
-		SMDAccessorElem *pmdaccelem = mdhtacc.PtLookup(); 
-		if (NULL != pmdaccelem)
+		// object has been fetched as part of a batch
+		pmdobjNew = CMDBinaryUtils::PimdobjDeserialize(pmp, pbPrefetched, ulSize);
+	}
+	else
+	{
+		pmdobjNew = PimdobjFetch(pmp, pmdid);
+	}
+	GPOS_ASSERT(NULL != pmdobjNew);
+
+	if (fPrintOptStats)
+	{
+		// add fetch time in msec
+		CDouble dFetch(timerFetch.UlElapsedUS() / CDouble(GPOS_USEC_IN_MSEC));
+		m_dFetchTime = CDouble(m_dFetchTime.DVal() + dFetch.DVal());
+	}
+
+	// For CTAS mdid, we avoid adding the corresponding object to the MD cache
+	// since those objects have a fixed id, and if caching is enabled and those
+	// objects are cached, then a subsequent CTAS query will attempt to use
+	// the cached object, which has a different schema, resulting in a crash.
+	// so for such objects, we bypass the MD cache, getting them from the
+	// MD provider, directly to the local hash table
+
+	if (IMDId::EmdidGPDBCtas != pmdid->Emdidt())
+	{
+		// add to MD cache
+		CAutoP<CMDKey> a_pmdkeyCache;
+		// ref count of the new object is set to one and optimizer becomes its owner
+		a_pmdkeyCache = GPOS_NEW(pmp) CMDKey(pmdobjNew->Pmdid());
+
+		// object gets pinned independent of whether insertion succeeded or
+		// failed because object was already in cache
+
+#ifdef GPOS_DEBUG
+		IMDCacheObject *pmdobjInserted =
+#endif
+		pmdcacc->PtInsert(a_pmdkeyCache.Pt(), pmdobjNew);
+
+		GPOS_ASSERT(NULL != pmdobjInserted);
+
+		// safely inserted
+		(void) a_pmdkeyCache.PtReset();
+	}
+
+	return pmdobjNew;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDAccessor::Load
+//
+//	@doc:
+//		Store an object missing from the local hashtable in the local
+//		hashtable, taking it from the MD cache or its MD provider
+//
+//---------------------------------------------------------------------------
+void
+CMDAccessor::Load
+	(
+	IMDId *pmdid
+	)
+{
+	CAutoP<CacheAccessorMD> a_pmdcacc;
+	a_pmdcacc = GPOS_NEW(m_pmp) CacheAccessorMD(m_pcache);
+	IMDCacheObject *pmdobjNew = PimdobjCached(a_pmdcacc.Pt(), pmdid, NULL /*pbPrefetched*/, 0 /*ulSize*/);
+
+	{
+		// store in local hashtable
+		GPOS_ASSERT(NULL != pmdobjNew);
+		IMDId *pmdidNew = pmdobjNew->Pmdid();
+		pmdidNew->AddRef();
+
+		CAutoP<SMDAccessorElem> a_pmdaccelem;
+		a_pmdaccelem = GPOS_NEW(m_pmp) SMDAccessorElem(pmdobjNew, pmdidNew);
+
+		MDHTAccessor mdhtacc(m_shtCacheAccessors, a_pmdaccelem->Pmdid());
+
+		if (NULL == mdhtacc.PtLookup())
 		{
-			pimdobj = pmdaccelem->Pimdobj();
+			// object has not been inserted in the meantime
+			mdhtacc.Insert(a_pmdaccelem.Pt());
+
+			// add deletion lock for mdid
+			a_pmdaccelem->Pmdid()->AddDeletionLock();
+			a_pmdaccelem.PtReset();
 		}
 	}
+}
 
-	if (NULL == pimdobj)
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDAccessor::Prefetch
+//
+//	@doc:
+//		Fetch a batch of metadata objects ahead of their use. Objects that are
+//		neither in the local hashtable nor in the MD cache are requested from
+//		their providers with one call per provider and added to the MD cache
+//		only; like any other cached object, they enter the local hashtable,
+//		and thereby minidumps, on first use. Objects a provider does not
+//		return are looked up individually on first use as before
+//
+//---------------------------------------------------------------------------
+void
+CMDAccessor::Prefetch
+	(
+	const DrgPmdid *pdrgpmdid
+	)
+{
+	GPOS_ASSERT(NULL != pdrgpmdid);
+
+	BOOL fPrintOptStats = GPOS_FTRACE(EopttracePrintOptimizationStatistics);
+
+	// missing objects grouped by their MD provider
+	CAutoRef<DrgPmdp> a_pdrgpmdp;
+	a_pdrgpmdp = GPOS_NEW(m_pmp) DrgPmdp(m_pmp);
+	CAutoRef<DrgPdrgPmdid> a_pdrgpdrgpmdid;
+	a_pdrgpdrgpmdid = GPOS_NEW(m_pmp) DrgPdrgPmdid(m_pmp);
+
+	const ULONG ulMDIds = pdrgpmdid->UlLength();
+	for (ULONG ul = 0; ul < ulMDIds; ul++)
 	{
-		// object not in local hashtable, try lookup in the MD cache
-		
-		// construct a key for cache lookup
-		IMDProvider *pmdp = Pmdp(pmdid->Sysid());
-		
-		CMDKey mdkey(pmdid);
-				
-		CAutoP<CacheAccessorMD> a_pmdcacc;
-		a_pmdcacc = GPOS_NEW(m_pmp) CacheAccessorMD(m_pcache);
-		a_pmdcacc->Lookup(&mdkey);
-		IMDCacheObject *pmdobjNew = a_pmdcacc->PtVal();
-		if (NULL == pmdobjNew)
+		IMDId *pmdid = (*pdrgpmdid)[ul];
+		if (IMDId::EmdidGPDBCtas == pmdid->Emdidt() || FLoaded(pmdid))
 		{
-			// object not found in MD cache: retrieve it from MD provider
-			CTimerUser timerFetch;
-			if (fPrintOptStats)
-			{
-				timerFetch.Restart();
-			}
-			CAutoP<CWStringBase> a_pstr;
-			a_pstr = pmdp->PstrObject(m_pmp, this, pmdid);
-			
-			GPOS_ASSERT(NULL != a_pstr.Pt());
-			IMemoryPool *pmp = m_pmp;
-			
-			if (IMDId::EmdidGPDBCtas != pmdid->Emdidt())
-			{
-				// create the accessor memory pool
-				pmp = a_pmdcacc->Pmp();
-			}
+			continue;
+		}
 
-			pmdobjNew = gpdxl::CDXLUtils::PimdobjParseDXL(pmp, a_pstr.Pt(), NULL /* XSD path */);
-			GPOS_ASSERT(NULL != pmdobjNew);
+		IMDProvider *pmdp = Pmdp(pmdid->Sysid());
+		ULONG ulProvider = 0;
+		while (ulProvider < a_pdrgpmdp->UlLength() && (*a_pdrgpmdp)[ulProvider] != pmdp)
+		{
+			ulProvider++;
+		}
 
-			if (fPrintOptStats)
-			{
-				// add fetch time in msec
-				CDouble dFetch(timerFetch.UlElapsedUS() / CDouble(GPOS_USEC_IN_MSEC));
-				m_dFetchTime = CDouble(m_dFetchTime.DVal() + dFetch.DVal());
-			}
+		if (ulProvider == a_pdrgpmdp->UlLength())
+		{
+			pmdp->AddRef();
+			a_pdrgpmdp->Append(pmdp);
+			a_pdrgpdrgpmdid->Append(GPOS_NEW(m_pmp) DrgPmdid(m_pmp));
+		}
 
-			// For CTAS mdid, we avoid adding the corresponding object to the MD cache
-			// since those objects have a fixed id, and if caching is enabled and those
-			// objects are cached, then a subsequent CTAS query will attempt to use
-			// the cached object, which has a different schema, resulting in a crash.
-			// so for such objects, we bypass the MD cache, getting them from the
-			// MD provider, directly to the local hash table
+		pmdid->AddRef();
+		(*a_pdrgpdrgpmdid)[ulProvider]->Append(pmdid);
+	}
 
-			if (IMDId::EmdidGPDBCtas != pmdid->Emdidt())
-			{
-				// add to MD cache
-				CAutoP<CMDKey> a_pmdkeyCache;
-				// ref count of the new object is set to one and optimizer becomes its owner
-				a_pmdkeyCache = GPOS_NEW(pmp) CMDKey(pmdobjNew->Pmdid());
+	const ULONG ulProviders = a_pdrgpmdp->UlLength();
+	for (ULONG ulProvider = 0; ulProvider < ulProviders; ulProvider++)
+	{
+		DrgPmdid *pdrgpmdidMissing = (*a_pdrgpdrgpmdid)[ulProvider];
+		pdrgpmdidMissing->AddRef();
+		CAutoRef<CMDRequest> a_pmdr;
+		a_pmdr = GPOS_NEW(m_pmp) CMDRequest(m_pmp, pdrgpmdidMissing, GPOS_NEW(m_pmp) CMDRequest::DrgPtr(m_pmp));
 
-				// object gets pinned independent of whether insertion succeeded or
-				// failed because object was already in cache
+		CTimerUser timerFetch;
+		if (fPrintOptStats)
+		{
+			timerFetch.Restart();
+		}
 
-#ifdef GPOS_DEBUG
-				IMDCacheObject *pmdobjInserted =
-#endif
-				a_pmdcacc->PtInsert(a_pmdkeyCache.Pt(), pmdobjNew);
+		CAutoRef<DrgPbMDObject> a_pdrgpb;
+		a_pdrgpb = (*a_pdrgpmdp)[ulProvider]->PdrgpbObjects(m_pmp, this, a_pmdr.Pt());
+		GPOS_ASSERT(a_pdrgpb->UlLength() == pdrgpmdidMissing->UlLength());
 
-				GPOS_ASSERT(NULL != pmdobjInserted);
+		if (fPrintOptStats)
+		{
+			// add fetch time in msec
+			CDouble dFetch(timerFetch.UlElapsedUS() / CDouble(GPOS_USEC_IN_MSEC));
+			m_dFetchTime = CDouble(m_dFetchTime.DVal() + dFetch.DVal());
+		}
 
-				// safely inserted
-				(void) a_pmdkeyCache.PtReset();
+		const ULONG ulObjects = a_pdrgpb->UlLength();
+		for (ULONG ul = 0; ul < ulObjects; ul++)
+		{
+			const BYTE *pb = (*a_pdrgpb)[ul];
+			IMDId *pmdid = (*pdrgpmdidMissing)[ul];
+			if (NULL != pb && !FLoaded(pmdid))
+			{
+				CacheAccessorMD mdcacc(m_pcache);
+				(void) PimdobjCached(&mdcacc, pmdid, pb, CMDBinaryUtils::UlSize(pb));
 			}
 		}
+	}
+}
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDAccessor::FLoaded
+//
+//	@doc:
+//		Is the given object in the local hashtable or in the MD cache
+//
+//---------------------------------------------------------------------------
+BOOL
+CMDAccessor::FLoaded
+	(
+	IMDId *pmdid
+	)
+{
+	{
+		// scope for ht accessor
+		MDHTAccessor mdhtacc(m_shtCacheAccessors, pmdid);
+		if (NULL != mdhtacc.PtLookup())
 		{
-			// store in local hashtable
-			GPOS_ASSERT(NULL != pmdobjNew);
-			IMDId *pmdidNew = pmdobjNew->Pmdid();
-			pmdidNew->AddRef();
+			return true;
+		}
+	}
 
-			CAutoP<SMDAccessorElem> a_pmdaccelem;
-			a_pmdaccelem = GPOS_NEW(m_pmp) SMDAccessorElem(pmdobjNew, pmdidNew);
+	CMDKey mdkey(pmdid);
+	CacheAccessorMD mdcacc(m_pcache);
+	mdcacc.Lookup(&mdkey);
 
-			MDHTAccessor mdhtacc(m_shtCacheAccessors, a_pmdaccelem->Pmdid());
+	return NULL != mdcacc.PtVal();
+}
 
-			if (NULL == mdhtacc.PtLookup())
-			{
-				// object has not been inserted in the meantime
-				mdhtacc.Insert(a_pmdaccelem.Pt());
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDAccessor::Pimdobj
+//
+//	@doc:
+//		Retrieves a metadata cache object from the md cache, possibly retrieving
+//		it from the external metadata provider and storing it in the cache first.
+//		Main workhorse for retrieving the different types of md cache objects.
+//
+//---------------------------------------------------------------------------
+const IMDCacheObject *
+CMDAccessor::Pimdobj
+	(
+	IMDId *pmdid
+	)
+{
+	BOOL fPrintOptStats = GPOS_FTRACE(EopttracePrintOptimizationStatistics);
+	CTimerUser timerLookup; // timer to measure lookup time
+	if (fPrintOptStats)
+	{
+		timerLookup.Restart();
+	}
 
-				// add deletion lock for mdid
-				a_pmdaccelem->Pmdid()->AddDeletionLock();
-				a_pmdaccelem.PtReset();
-			}
+	const IMDCacheObject *pimdobj = NULL;
+
+	// first, try to locate object in local hashtable
+	{
+		// scope for ht accessor
+		MDHTAccessor mdhtacc(m_shtCacheAccessors, pmdid);
+		SMDAccessorElem *pmdaccelem = mdhtacc.PtLookup(); 
+		if (NULL != pmdaccelem)
+		{
+			pimdobj = pmdaccelem->Pimdobj();
 		}
 	}
+
+	if (NULL == pimdobj)
+	{
+		// object not in local hashtable, try lookup in the MD cache or fetch it
+		Load(pmdid);
+	}
 	
 	// requested object must be in local hashtable already: retrieve it
 	MDHTAccessor mdhtacc(m_shtCacheAccessors, pmdid);
@@ -1408,9 +1620,14 @@ CMDAccessor::Serialize
 	}
 
 	// Now that we're done iterating and no longer hold the lock,
-	// serialize the entries.
+	// serialize the entries. Cache objects do not retain their DXL
+	// text, so each one is serialized directly into the stream
+	CAutoTraceFlag atf(EtraceSimulateAbort, false);
+	CXMLSerializer xmlser(m_pmp, oos, false /*fIndent*/);
 	for (ul = 0; ul < nentries; ul++)
-		oos << cacheEntries[ul]->Pstr()->Wsz();
+	{
+		cacheEntries[ul]->Serialize(&xmlser);
+	}
 }
 
 //---------------------------------------------------------------------------
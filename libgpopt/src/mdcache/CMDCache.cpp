@@ -12,6 +12,7 @@
 #include "gpos/task/CAutoTraceFlag.h"
 
 #include "gpopt/mdcache/CMDCache.h"
+#include "gpopt/optimizer/CPlanCache.h"
 
 using namespace gpos;
 using namespace gpmd;
@@ -130,6 +131,12 @@ CMDCache::Reset()
 
 	Shutdown();
 	Init();
+
+	// cached plans may depend on the dropped metadata
+	if (CPlanCache::FInitialized())
+	{
+		CPlanCache::Reset();
+	}
 }
 
 // EOF
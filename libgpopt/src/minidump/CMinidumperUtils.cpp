@@ -152,22 +152,15 @@ CMinidumperUtils::PdxlmdLoad
 
 //---------------------------------------------------------------------------
 //	@function:
-//		CMinidumperUtils::GenerateMinidumpFileName
+//		CMinidumperUtils::CreateMinidumpDirectory
 //
 //	@doc:
-//		Generate a timestamp-based minidump filename in the provided buffer.
+//		Create the minidumps directory, which also holds other diagnostic
+//		dumps, if it does not exist yet
 //
 //---------------------------------------------------------------------------
 void
-CMinidumperUtils::GenerateMinidumpFileName
-	(
-	CHAR *szBuf,
-	ULONG ulLength,
-	ULONG ulSessionId,
-	ULONG ulCmdId,
-	const CHAR *szMinidumpFileName // name of minidump file to be created,
-									// if NULL, a time-based name is generated
-	)
+CMinidumperUtils::CreateMinidumpDirectory()
 {
 	if (!gpos::ioutils::FPathExist("minidumps"))
 	{
@@ -186,6 +179,29 @@ CMinidumperUtils::GenerateMinidumpFileName
 		}
 		GPOS_CATCH_END;
 	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMinidumperUtils::GenerateMinidumpFileName
+//
+//	@doc:
+//		Generate a timestamp-based minidump filename in the provided buffer.
+//
+//---------------------------------------------------------------------------
+void
+CMinidumperUtils::GenerateMinidumpFileName
+	(
+	CHAR *szBuf,
+	ULONG ulLength,
+	ULONG ulSessionId,
+	ULONG ulCmdId,
+	const CHAR *szMinidumpFileName // name of minidump file to be created,
+									// if NULL, a time-based name is generated
+	)
+{
+	CreateMinidumpDirectory();
 
 	if (NULL == szMinidumpFileName)
 	{
@@ -86,7 +86,7 @@ CExpressionFactorizer::PexprProcessDisjDescendents
 
 	COperator *pop = pexpr->Pop();
 	pop->AddRef();
-	return GPOS_NEW(pmp) CExpression(pmp, pop, pdrgpexprChildren);
+	return CExpressionUtils::PexprRebuild(pmp, pexpr, pop, pdrgpexprChildren);
 }
 
 //---------------------------------------------------------------------------
@@ -1871,4 +1871,22 @@ CExpressionHandle::PcrsUsedColumns
 	return pcrs;
 }
 
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CleanupExprhdl
+//
+//	@doc:
+//		Delete an expression handle held by an array of handles
+//
+//---------------------------------------------------------------------------
+void
+gpopt::CleanupExprhdl
+	(
+	CExpressionHandle *pexprhdl
+	)
+{
+	GPOS_DELETE(pexprhdl);
+}
+
 // EOF
@@ -71,7 +71,7 @@ CExpressionPreprocessor::PexprEliminateSelfComparison
 	COperator *pop = pexpr->Pop();
 	pop->AddRef();
 
-	return GPOS_NEW(pmp) CExpression(pmp, pop, pdrgpexprChildren);
+	return CExpressionUtils::PexprRebuild(pmp, pexpr, pop, pdrgpexprChildren);
 }
 
 // remove superfluous equality operations
@@ -103,7 +103,7 @@ CExpressionPreprocessor::PexprPruneSuperfluousEquality
 
 	COperator *pop = pexpr->Pop();
 	pop->AddRef();
-	return GPOS_NEW(pmp) CExpression(pmp, pop, pdrgpexprChildren);
+	return CExpressionUtils::PexprRebuild(pmp, pexpr, pop, pdrgpexprChildren);
 }
 
 // an existential subquery whose inner expression is a GbAgg
@@ -163,7 +163,7 @@ CExpressionPreprocessor::PexprTrimExistentialSubqueries
 	}
 
 	pop->AddRef();
-	return GPOS_NEW(pmp) CExpression(pmp, pop, pdrgpexprChildren);
+	return CExpressionUtils::PexprRebuild(pmp, pexpr, pop, pdrgpexprChildren);
 }
 
 
@@ -239,7 +239,7 @@ CExpressionPreprocessor::PexprSimplifyQuantifiedSubqueries
 	}
 
 	pop->AddRef();
-	return GPOS_NEW(pmp) CExpression(pmp, pop, pdrgpexprChildren);
+	return CExpressionUtils::PexprRebuild(pmp, pexpr, pop, pdrgpexprChildren);
 }
 
 // preliminary unnesting of scalar subqueries
@@ -342,7 +342,7 @@ CExpressionPreprocessor::PexprUnnestScalarSubqueries
 	}
 
 	pop->AddRef();
-	return GPOS_NEW(pmp) CExpression(pmp, pop, pdrgpexprChildren);
+	return CExpressionUtils::PexprRebuild(pmp, pexpr, pop, pdrgpexprChildren);
 }
 
 // an intermediate limit is removed if it has neither row count nor offset
@@ -386,7 +386,7 @@ CExpressionPreprocessor::PexprRemoveSuperfluousLimit
 	}
 
 	pop->AddRef();
-	return GPOS_NEW(pmp) CExpression(pmp, pop, pdrgpexprChildren);
+	return CExpressionUtils::PexprRebuild(pmp, pexpr, pop, pdrgpexprChildren);
 }
 
 //	Remove outer references from order spec inside limit, grouping columns
@@ -530,7 +530,7 @@ CExpressionPreprocessor::PexprRemoveSuperfluousOuterRefs
 		pdrgpexprChildren->Append(pexprChild);
 	}
 
-	return GPOS_NEW(pmp) CExpression(pmp, pop, pdrgpexprChildren);
+	return CExpressionUtils::PexprRebuild(pmp, pexpr, pop, pdrgpexprChildren);
 }
 
 // generate a ScalarBoolOp expression or simply return the only expression
@@ -671,7 +671,7 @@ CExpressionPreprocessor::PexprConvert2In
 	}
 
 	pop->AddRef();
-	return GPOS_NEW(pmp) CExpression(pmp, pop, pdrgpexpr);
+	return CExpressionUtils::PexprRebuild(pmp, pexpr, pop, pdrgpexpr);
 
 }
 
@@ -748,7 +748,7 @@ CExpressionPreprocessor::PexprCollapseInnerJoins
 	}
 
 	pop->AddRef();
-	return GPOS_NEW(pmp) CExpression(pmp, pop, pdrgpexprChildren);
+	return CExpressionUtils::PexprRebuild(pmp, pexpr, pop, pdrgpexprChildren);
 }
 
 // collapse cascaded logical project operators
@@ -777,7 +777,7 @@ CExpressionPreprocessor::PexprCollapseProjects
 	COperator *pop = pexpr->Pop();
 	pop->AddRef();
 
-	CExpression *pexprNew = GPOS_NEW(pmp) CExpression(pmp, pop, pdrgpexpr);
+	CExpression *pexprNew = CExpressionUtils::PexprRebuild(pmp, pexpr, pop, pdrgpexpr);
 	CExpression *pexprCollapsed = CUtils::PexprCollapseProjects(pmp, pexprNew);
 
 	if (NULL == pexprCollapsed)
@@ -844,7 +844,12 @@ CExpressionPreprocessor::PexprProjBelowSubquery
 			CExpression *pexprPrList = (*pexpr)[1];
 			CExpression *pexprPrListNew = PexprProjBelowSubquery(pmp, pexprPrList, true /* fUnderPrList */);
 
-			return GPOS_NEW(pmp) CExpression(pmp, GPOS_NEW(pmp) CLogicalProject(pmp), pexprRelNew, pexprPrListNew);
+			DrgPexpr *pdrgpexpr = GPOS_NEW(pmp) DrgPexpr(pmp);
+			pdrgpexpr->Append(pexprRelNew);
+			pdrgpexpr->Append(pexprPrListNew);
+
+			pop->AddRef();
+			return CExpressionUtils::PexprRebuild(pmp, pexpr, pop, pdrgpexpr);
 		}
 
 		fUnderPrListChild = false;
@@ -885,7 +890,7 @@ CExpressionPreprocessor::PexprProjBelowSubquery
 	}
 
 	pop->AddRef();
-	return GPOS_NEW(pmp) CExpression(pmp, pop, pdrgpexpr);
+	return CExpressionUtils::PexprRebuild(pmp, pexpr, pop, pdrgpexpr);
 }
 
 // collapse cascaded union/union all into an NAry union/union all operator
@@ -914,7 +919,7 @@ CExpressionPreprocessor::PexprCollapseUnionUnionAll
 	}
 
 	pop->AddRef();
-	CExpression *pexprNew = GPOS_NEW(pmp) CExpression(pmp, pop, pdrgpexpr);
+	CExpression *pexprNew = CExpressionUtils::PexprRebuild(pmp, pexpr, pop, pdrgpexpr);
 	if (!CPredicateUtils::FUnionOrUnionAll(pexprNew))
 	{
 		return pexprNew;
@@ -1047,7 +1052,7 @@ CExpressionPreprocessor::PexprOuterJoinToInnerJoin
 	}
 
 	pop->AddRef();
-	return GPOS_NEW(pmp) CExpression(pmp, pop, pdrgpexprChildren);
+	return CExpressionUtils::PexprRebuild(pmp, pexpr, pop, pdrgpexprChildren);
 }
 
 // generate equality predicates between the columns in the given set,
@@ -1199,7 +1204,7 @@ CExpressionPreprocessor::PexprAddEqualityPreds
 	return CUtils::PexprSafeSelect
 						(
 						pmp,
-						GPOS_NEW(pmp) CExpression(pmp, pop, pdrgpexprChildren),
+						CExpressionUtils::PexprRebuild(pmp, pexpr, pop, pdrgpexprChildren),
 						pexprPred
 						);
 }
@@ -1294,7 +1299,7 @@ CExpressionPreprocessor::PexprFromConstraintsScalar
 
 	COperator *pop = pexpr->Pop();
 	pop->AddRef();
-	return GPOS_NEW(pmp) CExpression(pmp, pop, pdrgpexprChildren);
+	return CExpressionUtils::PexprRebuild(pmp, pexpr, pop, pdrgpexprChildren);
 }
 
 // Imply new predicates on LOJ's inner child based on constraints derived
@@ -1419,7 +1424,7 @@ CExpressionPreprocessor::PexprOuterJoinInferPredsFromOuterChildToInnerChild
 	}
 
 	pop->AddRef();
-	return GPOS_NEW(pmp) CExpression(pmp, pop, pdrgpexpr);
+	return CExpressionUtils::PexprRebuild(pmp, pexpr, pop, pdrgpexpr);
 }
 
 // additional predicates are generated based on the derived constraint
@@ -1491,7 +1496,7 @@ CExpressionPreprocessor::PexprFromConstraints
 	COperator *pop = pexpr->Pop();
 	pop->AddRef();
 
-	return GPOS_NEW(pmp) CExpression(pmp, pop, pdrgpexprChildren);
+	return CExpressionUtils::PexprRebuild(pmp, pexpr, pop, pdrgpexprChildren);
 }
 
 // eliminate subtrees that have a zero output cardinality, replacing them
@@ -1535,7 +1540,7 @@ CExpressionPreprocessor::PexprPruneEmptySubtrees
 	}
 
 	pop->AddRef();
-	return GPOS_NEW(pmp) CExpression(pmp, pop, pdrgpexpr);
+	return CExpressionUtils::PexprRebuild(pmp, pexpr, pop, pdrgpexpr);
 }
 
 // eliminate CTE Anchors for CTEs that have zero consumers
@@ -1570,7 +1575,7 @@ CExpressionPreprocessor::PexprRemoveUnusedCTEs
 	}
 
 	pop->AddRef();
-	return GPOS_NEW(pmp) CExpression(pmp, pop, pdrgpexpr);
+	return CExpressionUtils::PexprRebuild(pmp, pexpr, pop, pdrgpexpr);
 }
 
 // for all consumers of the same CTE, collect all selection predicates
@@ -1854,7 +1859,7 @@ CExpressionPreprocessor::PexprPruneUnusedComputedColsRecursive
 
 	pop->AddRef();
 
-	return GPOS_NEW(pmp) CExpression(pmp, pop, pdrgpexpr);
+	return CExpressionUtils::PexprRebuild(pmp, pexpr, pop, pdrgpexpr);
 
 }
 
@@ -1994,7 +1999,7 @@ CExpressionPreprocessor::PexprReorderScalarCmpChildren
 	}
 
 	pop->AddRef();
-	return GPOS_NEW(pmp) CExpression(pmp, pop, pdrgpexpr);
+	return CExpressionUtils::PexprRebuild(pmp, pexpr, pop, pdrgpexpr);
 }
 
 // converts IN subquery with a project list to a predicate AND an EXISTS subquery
@@ -2079,7 +2084,7 @@ CExpressionPreprocessor::PexprExistWithPredFromINSubq
 		pdrgpexprChildren->Append(pexprChild);
 	}
 
-	CExpression *pexprNew = GPOS_NEW(pmp) CExpression(pmp, pop, pdrgpexprChildren);
+	CExpression *pexprNew = CExpressionUtils::PexprRebuild(pmp, pexpr, pop, pdrgpexprChildren);
 
 	//Check if the inner is a SubqueryAny
 	if (CUtils::FAnySubquery(pop))
@@ -2108,6 +2113,38 @@ CExpressionPreprocessor::PexprExistWithPredFromINSubq
 	return pexprNew;
 }
 
+// print the time taken by a preprocessing step and the sizes of its input and
+// output trees; a step that changed nothing returns its input as is
+void
+CExpressionPreprocessor::ReportStep
+	(
+	const CHAR *szStep,
+	CExpression *pexprIn,
+	CExpression *pexprOut,
+	CWallClock *pclock
+	)
+{
+	GPOS_ASSERT(NULL != szStep);
+	GPOS_ASSERT(NULL != pexprIn);
+	GPOS_ASSERT(NULL != pexprOut);
+	GPOS_ASSERT(NULL != pclock);
+
+	if (GPOS_FTRACE(EopttracePrintOptimizationStatistics))
+	{
+		GPOS_TRACE_FORMAT
+			(
+			"[OPT]: Preprocessing step %s: %dms, nodes %d -> %d, %s",
+			szStep,
+			pclock->UlElapsedMS(),
+			CExpressionUtils::UlNodes(pexprIn),
+			CExpressionUtils::UlNodes(pexprOut),
+			pexprIn == pexprOut ? "unchanged" : "changed"
+			);
+	}
+
+	pclock->Restart();
+}
+
 // main driver, pre-processing of input logical expression
 CExpression *
 CExpressionPreprocessor::PexprPreprocess
@@ -2122,25 +2159,32 @@ CExpressionPreprocessor::PexprPreprocess
 
 	CAutoTimer at("\n[OPT]: Expression Preprocessing Time", GPOS_FTRACE(EopttracePrintOptimizationStatistics));
 
+	// timer for the current step
+	CWallClock clock;
+
 	// (1) remove unused CTE anchors
 	CExpression *pexprNoUnusedCTEs = PexprRemoveUnusedCTEs(pmp, pexpr);
 	GPOS_CHECK_ABORT;
+	ReportStep("remove unused CTE anchors", pexpr, pexprNoUnusedCTEs, &clock);
 
 	// (2) remove intermediate superfluous limit
 	CExpression *pexprSimplified = PexprRemoveSuperfluousLimit(pmp, pexprNoUnusedCTEs);
 	GPOS_CHECK_ABORT;
+	ReportStep("remove superfluous limits", pexprNoUnusedCTEs, pexprSimplified, &clock);
 	pexprNoUnusedCTEs->Release();
 
 	// (3) trim unnecessary existential subqueries
 	CExpression * pexprTrimmed = PexprTrimExistentialSubqueries(pmp, pexprSimplified);
 
 	GPOS_CHECK_ABORT;
+	ReportStep("trim existential subqueries", pexprSimplified, pexprTrimmed, &clock);
 	pexprSimplified->Release();
 
 	// (4) collapse cascaded union / union all
 	CExpression *pexprNaryUnionUnionAll = PexprCollapseUnionUnionAll(pmp, pexprTrimmed);
 
 	GPOS_CHECK_ABORT;
+	ReportStep("collapse union/union all", pexprTrimmed, pexprNaryUnionUnionAll, &clock);
 	pexprTrimmed->Release();
 
 	// (5) remove superfluous outer references from the order spec in limits, grouping columns in GbAgg, and
@@ -2148,26 +2192,31 @@ CExpressionPreprocessor::PexprPreprocess
 	CExpression *pexprOuterRefsEleminated = PexprRemoveSuperfluousOuterRefs(pmp, pexprNaryUnionUnionAll);
 
 	GPOS_CHECK_ABORT;
+	ReportStep("remove superfluous outer references", pexprNaryUnionUnionAll, pexprOuterRefsEleminated, &clock);
 	pexprNaryUnionUnionAll->Release();
 
 	// (6) remove superfluous equality
 	CExpression *pexprTrimmed2 = PexprPruneSuperfluousEquality(pmp, pexprOuterRefsEleminated);
 	GPOS_CHECK_ABORT;
+	ReportStep("remove superfluous equalities", pexprOuterRefsEleminated, pexprTrimmed2, &clock);
 	pexprOuterRefsEleminated->Release();
 
 	// (7) simplify quantified subqueries
 	CExpression *pexprSubqSimplified = PexprSimplifyQuantifiedSubqueries(pmp, pexprTrimmed2);
 	GPOS_CHECK_ABORT;
+	ReportStep("simplify quantified subqueries", pexprTrimmed2, pexprSubqSimplified, &clock);
 	pexprTrimmed2->Release();
 
 	// (8) do preliminary unnesting of scalar subqueries
 	CExpression *pexprSubqUnnested = PexprUnnestScalarSubqueries(pmp, pexprSubqSimplified);
 	GPOS_CHECK_ABORT;
+	ReportStep("unnest scalar subqueries", pexprSubqSimplified, pexprSubqUnnested, &clock);
 	pexprSubqSimplified->Release();
 
 	// (9) unnest AND/OR/NOT predicates
 	CExpression *pexprUnnested = CExpressionUtils::PexprUnnest(pmp, pexprSubqUnnested);
 	GPOS_CHECK_ABORT;
+	ReportStep("unnest AND/OR/NOT predicates", pexprSubqUnnested, pexprUnnested, &clock);
 	pexprSubqUnnested->Release();
 
 	CExpression *pexprConvert2In = pexprUnnested;
@@ -2177,88 +2226,105 @@ CExpressionPreprocessor::PexprPreprocess
 		// (9.5) ensure predicates are array IN or NOT IN where applicable
 		pexprConvert2In = PexprConvert2In(pmp, pexprUnnested);
 		GPOS_CHECK_ABORT;
+		ReportStep("convert disjunctions to IN", pexprUnnested, pexprConvert2In, &clock);
 		pexprUnnested->Release();
 	}
 
 	// (10) infer predicates from constraints
 	CExpression *pexprInferredPreds = PexprInferPredicates(pmp, pexprConvert2In);
 	GPOS_CHECK_ABORT;
+	ReportStep("infer predicates", pexprConvert2In, pexprInferredPreds, &clock);
 	pexprConvert2In->Release();
 
 	// (11) eliminate self comparisons
 	CExpression *pexprSelfCompEliminated = PexprEliminateSelfComparison(pmp, pexprInferredPreds);
 	GPOS_CHECK_ABORT;
+	ReportStep("eliminate self comparisons", pexprInferredPreds, pexprSelfCompEliminated, &clock);
 	pexprInferredPreds->Release();
 
 	// (12) remove duplicate AND/OR children
 	CExpression *pexprDeduped = CExpressionUtils::PexprDedupChildren(pmp, pexprSelfCompEliminated);
 	GPOS_CHECK_ABORT;
+	ReportStep("remove duplicate AND/OR children", pexprSelfCompEliminated, pexprDeduped, &clock);
 	pexprSelfCompEliminated->Release();
 
 	// (13) factorize common expressions
 	CExpression *pexprFactorized = CExpressionFactorizer::PexprFactorize(pmp, pexprDeduped);
 	GPOS_CHECK_ABORT;
+	ReportStep("factorize common expressions", pexprDeduped, pexprFactorized, &clock);
 	pexprDeduped->Release();
 
 	// (14) infer filters out of components of disjunctive filters
 	CExpression *pexprPrefiltersExtracted =
 			CExpressionFactorizer::PexprExtractInferredFilters(pmp, pexprFactorized);
 	GPOS_CHECK_ABORT;
+	ReportStep("extract inferred filters", pexprFactorized, pexprPrefiltersExtracted, &clock);
 	pexprFactorized->Release();
 
 	// (15) pre-process window functions
 	CExpression *pexprWindowPreprocessed = CWindowPreprocessor::PexprPreprocess(pmp, pexprPrefiltersExtracted);
 	GPOS_CHECK_ABORT;
+	ReportStep("preprocess window functions", pexprPrefiltersExtracted, pexprWindowPreprocessed, &clock);
 	pexprPrefiltersExtracted->Release();
 
 	// (16) eliminate unused computed columns
 	CExpression *pexprNoUnusedPrEl = PexprPruneUnusedComputedCols(pmp, pexprWindowPreprocessed, pcrsOutputAndOrderCols);
 	GPOS_CHECK_ABORT;
+	ReportStep("prune unused computed columns", pexprWindowPreprocessed, pexprNoUnusedPrEl, &clock);
 	pexprWindowPreprocessed->Release();
 
 	// (17) normalize expression
 	CExpression *pexprNormalized = CNormalizer::PexprNormalize(pmp, pexprNoUnusedPrEl);
 	GPOS_CHECK_ABORT;
+	ReportStep("normalize", pexprNoUnusedPrEl, pexprNormalized, &clock);
 	pexprNoUnusedPrEl->Release();
 
 	// (18) transform outer join into inner join whenever possible
 	CExpression *pexprLOJToIJ = PexprOuterJoinToInnerJoin(pmp, pexprNormalized);
 	GPOS_CHECK_ABORT;
+	ReportStep("outer join to inner join", pexprNormalized, pexprLOJToIJ, &clock);
 	pexprNormalized->Release();
 
 	// (19) collapse cascaded inner joins
 	CExpression *pexprCollapsed = PexprCollapseInnerJoins(pmp, pexprLOJToIJ);
 	GPOS_CHECK_ABORT;
+	ReportStep("collapse inner joins", pexprLOJToIJ, pexprCollapsed, &clock);
 	pexprLOJToIJ->Release();
 
 	// (20) after transforming outer joins to inner joins, we may be able to generate more predicates from constraints
 	CExpression *pexprWithPreds = PexprAddPredicatesFromConstraints(pmp, pexprCollapsed);
 	GPOS_CHECK_ABORT;
+	ReportStep("add predicates from constraints", pexprCollapsed, pexprWithPreds, &clock);
 	pexprCollapsed->Release();
 
 	// (21) eliminate empty subtrees
 	CExpression *pexprPruned = PexprPruneEmptySubtrees(pmp, pexprWithPreds);
 	GPOS_CHECK_ABORT;
+	ReportStep("prune empty subtrees", pexprWithPreds, pexprPruned, &clock);
 	pexprWithPreds->Release();
 
 	// (22) collapse cascade of projects
 	CExpression *pexprCollapsedProjects = PexprCollapseProjects(pmp, pexprPruned);
 	GPOS_CHECK_ABORT;
+	ReportStep("collapse projects", pexprPruned, pexprCollapsedProjects, &clock);
 	pexprPruned->Release();
 
 	// (23) insert dummy project when the scalar subquery is under a project and returns an outer reference
 	CExpression *pexprSubquery = PexprProjBelowSubquery(pmp, pexprCollapsedProjects, false /* fUnderPrList */);
 	GPOS_CHECK_ABORT;
+	ReportStep("project below subquery", pexprCollapsedProjects, pexprSubquery, &clock);
 	pexprCollapsedProjects->Release();
 
 	// (24) reorder the children of scalar cmp operator to ensure that left child is scalar ident and right child is scalar const
 	CExpression *pexrReorderedScalarCmpChildren = PexprReorderScalarCmpChildren(pmp, pexprSubquery);
 	GPOS_CHECK_ABORT;
+	ReportStep("reorder comparison children", pexprSubquery, pexrReorderedScalarCmpChildren, &clock);
 	pexprSubquery->Release();
 
 	// (25) rewrite IN subquery to EXIST subquery with a predicate
 	CExpression *pexprExistWithPredFromINSubq = PexprExistWithPredFromINSubq(pmp, pexrReorderedScalarCmpChildren);
 	GPOS_CHECK_ABORT;
+	ReportStep("IN subquery to EXISTS", pexrReorderedScalarCmpChildren, pexprExistWithPredFromINSubq, &clock);
 	pexrReorderedScalarCmpChildren->Release();
 
 	return pexprExistWithPredFromINSubq;
@@ -180,7 +180,7 @@ CExpressionUtils::PexprUnnest
 	DrgPexpr *pdrgpexpr = PdrgpexprUnnestChildren(pmp, pexpr);
 	pop->AddRef();
 
-	return GPOS_NEW(pmp) CExpression(pmp, pop, pdrgpexpr);
+	return PexprRebuild(pmp, pexpr, pop, pdrgpexpr);
 }
 
 
@@ -316,7 +316,92 @@ CExpressionUtils::PexprDedupChildren
 
 	COperator *pop = pexpr->Pop();
 	pop->AddRef();
-	return GPOS_NEW(pmp) CExpression(pmp, pop, pdrgpexprChildren);
+	return PexprRebuild(pmp, pexpr, pop, pdrgpexprChildren);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CExpressionUtils::PexprRebuild
+//
+//	@doc:
+//		Return the given expression if the given operator and children are
+//		the ones it already has, otherwise create a new expression from them;
+//		takes ownership of the operator and the children array the same way
+//		the CExpression ctor does.
+//
+//		Sharing unchanged subtrees saves rewrite passes from copying the
+//		whole tree, and keeps properties already derived on these subtrees.
+//		CTE consumers are always recreated, since their derived properties
+//		come from the CTE producer, which may be replaced between passes;
+//		so are expressions extracted from the memo, which must not be handed
+//		back to it as new results.
+//
+//---------------------------------------------------------------------------
+CExpression *
+CExpressionUtils::PexprRebuild
+	(
+	IMemoryPool *pmp,
+	CExpression *pexpr,
+	COperator *pop,
+	DrgPexpr *pdrgpexprChildren
+	)
+{
+	GPOS_ASSERT(NULL != pexpr);
+	GPOS_ASSERT(NULL != pop);
+	GPOS_ASSERT(NULL != pdrgpexprChildren);
+
+	const ULONG ulArity = pexpr->UlArity();
+	BOOL fUnchanged =
+		pop == pexpr->Pop() &&
+		NULL == pexpr->Pgexpr() &&
+		COperator::EopLogicalCTEConsumer != pop->Eopid() &&
+		ulArity == pdrgpexprChildren->UlLength();
+
+	for (ULONG ul = 0; fUnchanged && ul < ulArity; ul++)
+	{
+		fUnchanged = ((*pexpr)[ul] == (*pdrgpexprChildren)[ul]);
+	}
+
+	if (!fUnchanged)
+	{
+		return GPOS_NEW(pmp) CExpression(pmp, pop, pdrgpexprChildren);
+	}
+
+	pop->Release();
+	pdrgpexprChildren->Release();
+	pexpr->AddRef();
+
+	return pexpr;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CExpressionUtils::UlNodes
+//
+//	@doc:
+//		Number of nodes in the given expression tree, where shared subtrees
+//		are counted once per occurrence
+//
+//---------------------------------------------------------------------------
+ULONG
+CExpressionUtils::UlNodes
+	(
+	const CExpression *pexpr
+	)
+{
+	GPOS_CHECK_STACK_SIZE;
+	GPOS_ASSERT(NULL != pexpr);
+
+	ULONG ulNodes = 1;
+	const ULONG ulArity = pexpr->UlArity();
+	for (ULONG ul = 0; ul < ulArity; ul++)
+	{
+		ulNodes += UlNodes((*pexpr)[ul]);
+	}
+
+	return ulNodes;
 }
 
 // EOF
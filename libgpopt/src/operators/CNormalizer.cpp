@@ -14,6 +14,7 @@
 
 #include "gpopt/base/CUtils.h"
 #include "gpopt/operators/CNormalizer.h"
+#include "gpopt/operators/CExpressionUtils.h"
 #include "gpopt/operators/CPredicateUtils.h"
 #include "gpopt/operators/ops.h"
 
@@ -175,7 +176,7 @@ CNormalizer::PexprRecursiveNormalize
 	COperator *pop = pexpr->Pop();
 	pop->AddRef();
 
-	return GPOS_NEW(pmp) CExpression(pmp, pop, pdrgpexpr);
+	return CExpressionUtils::PexprRebuild(pmp, pexpr, pop, pdrgpexpr);
 }
 
 
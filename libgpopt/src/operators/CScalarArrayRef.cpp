@@ -109,7 +109,8 @@ CScalarArrayRef::FMatch
 
 	return m_pmdidType->FEquals(popArrayRef->PmdidType()) &&
 			m_pmdidElem->FEquals(popArrayRef->PmdidElem()) &&
-			m_pmdidArray->FEquals(popArrayRef->PmdidArray());
+			m_pmdidArray->FEquals(popArrayRef->PmdidArray()) &&
+			popArrayRef->ITypeModifier() == m_iTypeModifier;
 }
 
 // EOF
@@ -190,9 +190,10 @@ CScalarFunc::FMatch
 	}
 	CScalarFunc *popScFunc = CScalarFunc::PopConvert(pop);
 
-	// match if func ids are identical
+	// match if func ids and return types, including type modifiers, are identical
 	return popScFunc->PmdidFunc()->FEquals(m_pmdidFunc) &&
-			popScFunc->PmdidType()->FEquals(m_pmdidRetType);
+			popScFunc->PmdidType()->FEquals(m_pmdidRetType) &&
+			popScFunc->ITypeModifier() == m_iRetTypeModifier;
 }
 
 //---------------------------------------------------------------------------
@@ -12,6 +12,7 @@
 #include "gpos/base.h"
 
 #include "gpopt/base/CUtils.h"
+#include "gpopt/operators/CExpressionUtils.h"
 #include "gpopt/operators/CPredicateUtils.h"
 #include "gpopt/operators/ops.h"
 #include "gpopt/operators/CWindowPreprocessor.h"
@@ -447,7 +448,7 @@ CWindowPreprocessor::PexprPreprocess
 	}
 
 	pop->AddRef();
-	return GPOS_NEW(pmp) CExpression(pmp, pop, pdrgpexprChildren);
+	return CExpressionUtils::PexprRebuild(pmp, pexpr, pop, pdrgpexprChildren);
 }
 
 // EOF
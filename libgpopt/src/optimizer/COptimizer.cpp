@@ -12,8 +12,16 @@
 #include "gpos/common/CBitSet.h"
 #include "gpos/error/CErrorHandlerStandard.h"
 #include "gpos/io/CFileDescriptor.h"
-
+#include "gpos/io/CFileWriter.h"
+#include "gpos/io/COstreamString.h"
+#include "gpos/io/COstreamUTF8.h"
+#include "gpos/io/ioutils.h"
+#include "gpos/task/CAutoSuspendAbort.h"
+#include "gpos/task/CTask.h"
+
+#include "naucrates/dxl/CDXLUtils.h"
 #include "naucrates/dxl/operators/CDXLNode.h"
+#include "naucrates/dxl/xml/CXMLSerializer.h"
 #include "naucrates/md/IMDProvider.h"
 
 #include "naucrates/traceflags/traceflags.h"
@@ -22,6 +30,7 @@
 #include "gpopt/engine/CEngine.h"
 #include "gpopt/engine/CEnumeratorConfig.h"
 #include "gpopt/engine/CStatisticsConfig.h"
+#include "gpopt/eval/CConstExprEvaluatorNative.h"
 #include "gpopt/exception.h"
 #include "gpopt/minidump/CMiniDumperDXL.h"
 #include "gpopt/minidump/CMinidumperUtils.h"
@@ -36,10 +45,10 @@
 
 #include "gpopt/optimizer/COptimizerConfig.h"
 #include "gpopt/optimizer/COptimizer.h"
+#include "gpopt/optimizer/CPlanCache.h"
+#include "gpopt/search/CJobProfiler.h"
 #include "gpopt/cost/ICostModel.h"
 
-#include <fstream>
-
 using namespace gpos;
 using namespace gpdxl;
 using namespace gpmd;
@@ -133,6 +142,58 @@ COptimizer::DumpSamples
 	GPOS_DELETE(pstr);
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		COptimizer::DumpJobProfile
+//
+//	@doc:
+//		Helper function to dump the profile of optimization jobs in folded
+//		stacks format into the minidumps directory; the profile is streamed
+//		to the file, and failing to write it is reported without failing
+//		the query
+//
+//---------------------------------------------------------------------------
+void
+COptimizer::DumpJobProfile
+	(
+	const CJobProfiler *pjprof,
+	ULONG ulSessionId,
+	ULONG ulCmdId
+	)
+{
+	GPOS_ASSERT(NULL != pjprof);
+
+	CAutoSuspendAbort asa;
+
+	CMinidumperUtils::CreateMinidumpDirectory();
+
+	CHAR szFileName[GPOS_FILE_NAME_BUF_SIZE];
+	CUtils::GenerateFileName(szFileName, "minidumps/JobProfile", "folded", GPOS_FILE_NAME_BUF_SIZE, ulSessionId, ulCmdId);
+
+	CFileWriter fw;
+	GPOS_TRY
+	{
+		fw.Open(szFileName, S_IRUSR | S_IWUSR);
+
+		COstreamUTF8 os(&fw);
+		(void) pjprof->OsPrintFolded(os);
+		os.Flush();
+
+		fw.Close();
+	}
+	GPOS_CATCH_EX(ex)
+	{
+		if (!GPOS_MATCH_EX(ex, CException::ExmaSystem, CException::ExmiIOError))
+		{
+			GPOS_RETHROW(ex);
+		}
+
+		GPOS_RESET_EX;
+		GPOS_TRACE_FORMAT_ERR("Failed to write job profile to %s", szFileName);
+	}
+	GPOS_CATCH_END;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		COptimizer::DumpQueryOrPlan
@@ -206,23 +267,59 @@ COptimizer::PdxlnOptimize
 	// minidumper. (We create the minidumper object even if we're not
 	// dumping, but without the Init-call, it will stay inactive.)
 	CMiniDumperDXL mdmp(pmp);
-	CAutoP<std::wofstream> wosMinidump;
-	CAutoP<COstreamBasic> osMinidump;
+	CAutoP<CFileWriter> fwMinidump;
+	CAutoP<COstreamUTF8> osMinidump;
 	if (fMinidump)
 	{
 		CHAR szFileName[GPOS_FILE_NAME_BUF_SIZE];
 
 		CMinidumperUtils::GenerateMinidumpFileName(szFileName, GPOS_FILE_NAME_BUF_SIZE, ulSessionId, ulCmdId, szMinidumpFileName);
 
-		// Note: std::wofstream won't throw an error on failure. The stream is merely marked as
-		// failed. We could check the state, and avoid the overhead of serializing the
-		// minidump if it failed, but it's hardly worth optimizing for an error case.
-		wosMinidump = GPOS_NEW(pmp) std::wofstream(szFileName);
-		osMinidump = GPOS_NEW(pmp) COstreamBasic(wosMinidump.Pt());
+		// the minidump is encoded as UTF-8 and streamed to the file through
+		// a fixed-size buffer, so large minidumps are never held in memory;
+		// failing to create the file does not fail the query
+		fwMinidump = GPOS_NEW(pmp) CFileWriter();
+		GPOS_TRY
+		{
+			fwMinidump->Open(szFileName, S_IRUSR | S_IWUSR);
+		}
+		GPOS_CATCH_EX(ex)
+		{
+			GPOS_RESET_EX;
+		}
+		GPOS_CATCH_END;
 
-		mdmp.Init(osMinidump.Pt());
+		fMinidump = fwMinidump->FOpened();
+		if (fMinidump)
+		{
+			osMinidump = GPOS_NEW(pmp) COstreamUTF8(fwMinidump.Pt());
+			mdmp.Init(osMinidump.Pt());
+		}
 	}
 	CDXLNode *pdxlnPlan = NULL;
+
+	// plans are not cached when optimization has side effects or uses a
+	// custom search strategy
+	BOOL fPlanCache = CPlanCache::FInitialized() &&
+						GPOS_FTRACE(EopttraceEnablePlanCache) &&
+						!fMinidump &&
+						!GPOS_FTRACE(EopttraceSamplePlans) &&
+						NULL == pdrgpss;
+
+	CAutoP<CWStringDynamic> a_pstrPlanKey;
+	CAutoP<CPlanKey> a_pplankey;
+	if (fPlanCache)
+	{
+		a_pstrPlanKey = PstrPlanCacheKey(pmp, pdxlnQuery, pdrgpdxlnQueryOutput, pdrgpdxlnCTE, poconf, ulHosts);
+		a_pplankey = GPOS_NEW(pmp) CPlanKey(a_pstrPlanKey->Wsz(), a_pstrPlanKey->UlLength());
+
+		pdxlnPlan = PdxlnCachedPlan(pmp, a_pplankey.Pt());
+		if (NULL != pdxlnPlan)
+		{
+			return pdxlnPlan;
+		}
+	}
+
 	CErrorHandlerStandard errhdl;
 	GPOS_TRY_HDL(&errhdl)
 	{
@@ -233,13 +330,16 @@ COptimizer::PdxlnOptimize
 
 		{			
 			poconf->AddRef();
+			IConstExprEvaluator *pceevalOpt = NULL;
 			if (NULL != pceeval)
 			{
+				// evaluate builtin expressions natively, fall back to the host
 				pceeval->AddRef();
+				pceevalOpt = GPOS_NEW(pmp) CConstExprEvaluatorNative(pmp, pceeval);
 			}
 
 			// install opt context in TLS
-			CAutoOptCtxt aoc(pmp, pmda, pceeval, poconf);
+			CAutoOptCtxt aoc(pmp, pmda, pceevalOpt, poconf);
 
 			// translate DXL Tree -> Expr Tree
 			CTranslatorDXLToExpr dxltr(pmp, pmda);
@@ -265,8 +365,16 @@ COptimizer::PdxlnOptimize
 			}
 
 			GPOS_CHECK_ABORT;
+			// plans found during optimization are passed to the plan callback, if any
+			SPlanReportCtxt prctxt = {pmp, pmda, pqc, pdrgpmdname, ulHosts, poconf};
+			SPlanReportCtxt *pprctxt = NULL;
+			if (NULL != poconf->PfnPlanCallback())
+			{
+				pprctxt = &prctxt;
+			}
+
 			// optimize logical expression tree into physical expression tree.
-			CExpression *pexprPlan = PexprOptimize(pmp, pqc, pdrgpss);
+			CExpression *pexprPlan = PexprOptimize(pmp, pqc, pdrgpss, ulSessionId, ulCmdId, pprctxt);
 			GPOS_CHECK_ABORT;
 
 			PrintQueryOrPlan(pmp, pexprPlan);
@@ -275,10 +383,16 @@ COptimizer::PdxlnOptimize
 			pdxlnPlan = Pdxln(pmp, pmda, pexprPlan, pqc->PdrgPcr(), pdrgpmdname, ulHosts);
 			GPOS_CHECK_ABORT;
 
+			if (fPlanCache)
+			{
+				CachePlan(pmp, a_pplankey.Pt(), pdxlnPlan, poconf);
+			}
+
 			if (fMinidump)
 			{
 				CSerializablePlan serPlan(pmp, pdxlnPlan, poconf->Pec()->UllPlanId(), poconf->Pec()->UllPlanSpaceSize());
 				CMinidumperUtils::Finalize(&mdmp, true /* fSerializeErrCtxt*/);
+				osMinidump->Flush();
 				GPOS_CHECK_ABORT;
 			}
 			
@@ -299,6 +413,7 @@ COptimizer::PdxlnOptimize
 		if (fMinidump)
 		{
 			CMinidumperUtils::Finalize(&mdmp, false /* fSerializeErrCtxt*/);
+			osMinidump->Flush();
 			HandleExceptionAfterFinalizingMinidump(ex);
 		}
 
@@ -341,6 +456,155 @@ COptimizer::HandleExceptionAfterFinalizingMinidump
 	GPOS_RETHROW(ex);
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		COptimizer::PstrPlanCacheKey
+//
+//	@doc:
+//		Canonical text of an optimization request: the serialized query,
+//		optimizer configuration including trace flags, and number of hosts.
+//		Metadata ids in the serialized query carry their versions, so a
+//		change of a referenced object's version changes the key
+//
+//---------------------------------------------------------------------------
+CWStringDynamic *
+COptimizer::PstrPlanCacheKey
+	(
+	IMemoryPool *pmp,
+	const CDXLNode *pdxlnQuery,
+	const DrgPdxln *pdrgpdxlnQueryOutput,
+	const DrgPdxln *pdrgpdxlnCTE,
+	COptimizerConfig *poconf,
+	ULONG ulHosts
+	)
+{
+	CWStringDynamic *pstr = GPOS_NEW(pmp) CWStringDynamic(pmp);
+	COstreamString oss(pstr);
+
+	CDXLUtils::SerializeQuery
+				(
+				pmp,
+				oss,
+				pdxlnQuery,
+				pdrgpdxlnQueryOutput,
+				pdrgpdxlnCTE,
+				false /*fDocumentHeaderFooter*/,
+				false /*fIndent*/
+				);
+
+	{
+		CXMLSerializer xmlser(pmp, oss, false /*fIndent*/);
+		CBitSet *pbs = CTask::PtskSelf()->Ptskctxt()->PbsCopyTraceFlags(pmp);
+		poconf->Serialize(pmp, &xmlser, pbs);
+		pbs->Release();
+	}
+
+	pstr->AppendFormat(GPOS_WSZ_LIT("<hosts>%d"), ulHosts);
+
+	return pstr;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COptimizer::PdxlnCachedPlan
+//
+//	@doc:
+//		Look up a plan in the plan cache; returns NULL if the plan is not
+//		cached
+//
+//---------------------------------------------------------------------------
+CDXLNode *
+COptimizer::PdxlnCachedPlan
+	(
+	IMemoryPool *pmp,
+	const CPlanKey *pplankey
+	)
+{
+	CAutoRg<CHAR> a_szPlan;
+	a_szPlan = CPlanCache::SzLookup(pmp, pplankey);
+	if (NULL == a_szPlan.Rgt())
+	{
+		return NULL;
+	}
+
+	return PdxlnPlan(pmp, a_szPlan.Rgt());
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COptimizer::SzPlan
+//
+//	@doc:
+//		Serialized DXL document of a plan
+//
+//---------------------------------------------------------------------------
+CHAR *
+COptimizer::SzPlan
+	(
+	IMemoryPool *pmp,
+	const CDXLNode *pdxlnPlan,
+	COptimizerConfig *poconf
+	)
+{
+	CWStringDynamic str(pmp);
+	COstreamString oss(&str);
+	CDXLUtils::SerializePlan
+				(
+				pmp,
+				oss,
+				pdxlnPlan,
+				poconf->Pec()->UllPlanId(),
+				poconf->Pec()->UllPlanSpaceSize(),
+				true /*fDocumentHeaderFooter*/,
+				false /*fIndent*/
+				);
+
+	return CDXLUtils::SzFromWsz(pmp, str.Wsz());
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COptimizer::PdxlnPlan
+//
+//	@doc:
+//		Parse the serialized DXL document of a plan
+//
+//---------------------------------------------------------------------------
+CDXLNode *
+COptimizer::PdxlnPlan
+	(
+	IMemoryPool *pmp,
+	const CHAR *szPlan
+	)
+{
+	ULLONG ullPlanId = 0;
+	ULLONG ullPlanSpaceSize = 0;
+
+	return CDXLUtils::PdxlnParsePlan(pmp, szPlan, NULL /*szXSDPath*/, &ullPlanId, &ullPlanSpaceSize);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COptimizer::CachePlan
+//
+//	@doc:
+//		Store the DXL document of a plan in the plan cache
+//
+//---------------------------------------------------------------------------
+void
+COptimizer::CachePlan
+	(
+	IMemoryPool *pmp,
+	const CPlanKey *pplankey,
+	const CDXLNode *pdxlnPlan,
+	COptimizerConfig *poconf
+	)
+{
+	CAutoRg<CHAR> a_szPlan;
+	a_szPlan = SzPlan(pmp, pdxlnPlan, poconf);
+	CPlanCache::Insert(pplankey, a_szPlan.Rgt());
+}
+
 // This function provides an entry point to check for a plan with CTE,
 // if both CTEProducer and CTEConsumer are executed on the same locality.
 // If it is not the case, the plan is bogus and cannot be executed
@@ -377,15 +641,27 @@ COptimizer::PexprOptimize
 	(
 	IMemoryPool *pmp,
 	CQueryContext *pqc,
-	DrgPss *pdrgpss
+	DrgPss *pdrgpss,
+	ULONG ulSessionId,
+	ULONG ulCmdId,
+	SPlanReportCtxt *pprctxt
 	)
 {
 	CEngine eng(pmp);
 	eng.Init(pqc, pdrgpss);
+	if (NULL != pprctxt)
+	{
+		eng.SetPlanCallback(ReportPlan, pprctxt);
+	}
 	eng.Optimize();
 
 	GPOS_CHECK_ABORT;
 
+	if (NULL != eng.Pjprof())
+	{
+		DumpJobProfile(eng.Pjprof(), ulSessionId, ulCmdId);
+	}
+
 	CExpression *pexprPlan = eng.PexprExtractPlan();
 	(void) pexprPlan->PrppCompute(pmp, pqc->Prpp());
 
@@ -397,6 +673,45 @@ COptimizer::PexprOptimize
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		COptimizer::ReportPlan
+//
+//	@doc:
+//		Translate an improving plan found by the engine into DXL and pass it
+//		to the plan callback of the optimizer configuration
+//
+//---------------------------------------------------------------------------
+void
+COptimizer::ReportPlan
+	(
+	void *pvCtxt,
+	CExpression *pexprPlan
+	)
+{
+	SPlanReportCtxt *pprctxt = reinterpret_cast<SPlanReportCtxt *>(pvCtxt);
+	GPOS_ASSERT(NULL != pprctxt);
+	GPOS_ASSERT(NULL != pprctxt->m_poconf->PfnPlanCallback());
+
+	IMemoryPool *pmp = pprctxt->m_pmp;
+	(void) pexprPlan->PrppCompute(pmp, pprctxt->m_pqc->Prpp());
+
+	CDXLNode *pdxlnPlan = Pdxln
+							(
+							pmp,
+							pprctxt->m_pmda,
+							pexprPlan,
+							pprctxt->m_pqc->PdrgPcr(),
+							pprctxt->m_pdrgpmdname,
+							pprctxt->m_ulHosts
+							);
+
+	COptimizerConfig *poconf = pprctxt->m_poconf;
+	poconf->PfnPlanCallback()(poconf->PvPlanArg(), pdxlnPlan);
+	pdxlnPlan->Release();
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		COptimizer::Pdxln
@@ -43,7 +43,9 @@ COptimizerConfig::COptimizerConfig
 	m_pcteconf(pcteconf),
 	m_pcm(pcm),
 	m_phint(phint),
-	m_pwindowoids(pwindowoids)
+	m_pwindowoids(pwindowoids),
+	m_pfndxlplan(NULL),
+	m_pvPlanArg(NULL)
 {
 	GPOS_ASSERT(NULL != pec);
 	GPOS_ASSERT(NULL != pstatsconf);
@@ -172,6 +174,8 @@ COptimizerConfig::Serialize(IMemoryPool *pmp, CXMLSerializer *pxmlser, CBitSet *
 	pxmlser->AddAttribute(CDXLTokens::PstrToken(EdxltokenJoinOrderDPThreshold), m_phint->UlJoinOrderDPLimit());
 	pxmlser->AddAttribute(CDXLTokens::PstrToken(EdxltokenBroadcastThreshold), m_phint->UlBroadcastThreshold());
 	pxmlser->AddAttribute(CDXLTokens::PstrToken(EdxltokenEnforceConstraintsOnDML), m_phint->FEnforceConstraintsOnDML());
+	pxmlser->AddAttribute(CDXLTokens::PstrToken(EdxltokenOptimizerWorkers), m_phint->UlOptimizerWorkers());
+	pxmlser->AddAttribute(CDXLTokens::PstrToken(EdxltokenOptimizationDeadline), m_phint->UlOptimizationDeadline());
 	pxmlser->CloseElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix), CDXLTokens::PstrToken(EdxltokenHint));
 
 	// Serialize traceflags represented in bitset into stream
@@ -0,0 +1,120 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2018 Pivotal, Inc.
+//
+//	@filename:
+//		COptimizerSession.cpp
+//
+//	@doc:
+//		Implementation of optimization sessions
+//---------------------------------------------------------------------------
+
+#include "gpos/base.h"
+#include "gpos/task/CAutoTraceFlag.h"
+
+#include "naucrates/dxl/operators/CDXLNode.h"
+#include "naucrates/traceflags/traceflags.h"
+
+#include "gpopt/base/CQueryContext.h"
+#include "gpopt/engine/CEnumeratorConfig.h"
+#include "gpopt/eval/IConstExprEvaluator.h"
+#include "gpopt/mdcache/CMDCache.h"
+#include "gpopt/optimizer/COptimizer.h"
+#include "gpopt/optimizer/COptimizerConfig.h"
+#include "gpopt/optimizer/COptimizerSession.h"
+
+using namespace gpos;
+using namespace gpdxl;
+using namespace gpopt;
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COptimizerSession::COptimizerSession
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+COptimizerSession::COptimizerSession
+	(
+	IMemoryPool *pmp,
+	const DrgPsysid *pdrgpsysid,
+	const DrgPmdp *pdrgpmdp,
+	IConstExprEvaluator *pceeval,
+	ULONG ulHosts,
+	ULONG ulSessionId,
+	COptimizerConfig *poconf
+	)
+	:
+	m_pmp(pmp),
+	m_mda(pmp, CMDCache::Pcache(), pdrgpsysid, pdrgpmdp),
+	m_pceeval(pceeval),
+	m_ulHosts(ulHosts),
+	m_ulSessionId(ulSessionId),
+	m_poconf(poconf),
+	m_ulStatements(0)
+{
+	GPOS_ASSERT(NULL != pmp);
+	GPOS_ASSERT(NULL != poconf);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COptimizerSession::~COptimizerSession
+//
+//	@doc:
+//		Dtor
+//
+//---------------------------------------------------------------------------
+COptimizerSession::~COptimizerSession()
+{
+	m_poconf->Release();
+	CRefCount::SafeRelease(m_pceeval);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COptimizerSession::PdxlnOptimize
+//
+//	@doc:
+//		Optimize a statement of the batch using the session's MD accessor;
+//		the plan cache is enabled for the statement
+//
+//---------------------------------------------------------------------------
+CDXLNode *
+COptimizerSession::PdxlnOptimize
+	(
+	const CDXLNode *pdxlnQuery,
+	const DrgPdxln *pdrgpdxlnQueryOutput,
+	const DrgPdxln *pdrgpdxlnCTE,
+	ULONG ulCmdId,
+	const CHAR *szMinidumpFileName
+	)
+{
+	GPOS_ASSERT(NULL != pdxlnQuery);
+	GPOS_ASSERT(NULL != pdrgpdxlnQueryOutput);
+
+	m_ulStatements++;
+
+	CAutoTraceFlag atf(EopttraceEnablePlanCache, true /*fVal*/);
+
+	return COptimizer::PdxlnOptimize
+			(
+			m_pmp,
+			&m_mda,
+			pdxlnQuery,
+			pdrgpdxlnQueryOutput,
+			pdrgpdxlnCTE,
+			m_pceeval,
+			m_ulHosts,
+			m_ulSessionId,
+			ulCmdId,
+			NULL /*pdrgpss*/,
+			m_poconf,
+			szMinidumpFileName
+			);
+}
+
+// EOF
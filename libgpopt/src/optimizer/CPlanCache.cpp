@@ -0,0 +1,221 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CPlanCache.cpp
+//
+//	@doc:
+//		 Function implementation of CPlanCache
+//---------------------------------------------------------------------------
+
+#include "gpos/common/CAutoP.h"
+#include "gpos/common/clibwrapper.h"
+#include "gpos/string/CWStringBase.h"
+#include "gpos/sync/atomic.h"
+#include "gpos/task/CAutoTraceFlag.h"
+
+#include "gpopt/optimizer/CPlanCache.h"
+
+using namespace gpos;
+using namespace gpopt;
+
+// global instance of plan cache
+CPlanCache::PlanCache *CPlanCache::m_pcache = NULL;
+
+// maximum size of the cache
+ULLONG CPlanCache::m_ullCacheQuota = UNLIMITED_CACHE_QUOTA;
+
+// lookup counters
+volatile ULLONG CPlanCache::m_ullHits = 0;
+volatile ULLONG CPlanCache::m_ullMisses = 0;
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCache::Init
+//
+//	@doc:
+//		Initializes global instance
+//
+//---------------------------------------------------------------------------
+void
+CPlanCache::Init()
+{
+	GPOS_ASSERT(NULL == m_pcache && "Plan cache was already created");
+	m_pcache = CCacheFactory::PCacheCreate<CCachedPlan*, CPlanKey*>
+					(
+					true /*fUnique*/,
+					m_ullCacheQuota,
+					CPlanKey::UlHashPlanKey,
+					CPlanKey::FEqualPlanKey
+					);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCache::Shutdown
+//
+//	@doc:
+//		Cleans up the underlying cache
+//
+//---------------------------------------------------------------------------
+void
+CPlanCache::Shutdown()
+{
+	GPOS_DELETE(m_pcache);
+	m_pcache = NULL;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCache::SetCacheQuota
+//
+//	@doc:
+//		Set the maximum size of the cache
+//
+//---------------------------------------------------------------------------
+void
+CPlanCache::SetCacheQuota(ULLONG ullCacheQuota)
+{
+	GPOS_ASSERT(NULL != m_pcache && "Plan cache was not created");
+	m_ullCacheQuota = ullCacheQuota;
+	m_pcache->SetCacheQuota(ullCacheQuota);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCache::ULLGetCacheQuota
+//
+//	@doc:
+//		Get the maximum size of the cache
+//
+//---------------------------------------------------------------------------
+ULLONG
+CPlanCache::ULLGetCacheQuota()
+{
+	// make sure that the saved quota is reflected in the underlying CCache
+	GPOS_ASSERT_IMP(NULL != m_pcache, m_pcache->UllCacheQuota() == m_ullCacheQuota);
+	return m_ullCacheQuota;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCache::ULLGetCacheEvictionCounter
+//
+//	@doc:
+// 		Get the number of times we evicted entries from this cache
+//
+//---------------------------------------------------------------------------
+ULLONG
+CPlanCache::ULLGetCacheEvictionCounter()
+{
+	// make sure that we already initialized our underlying CCache
+	GPOS_ASSERT(NULL != m_pcache);
+	return m_pcache->UllEvictionCounter();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCache::Reset
+//
+//	@doc:
+//		Reset plan cache
+//
+//---------------------------------------------------------------------------
+void
+CPlanCache::Reset()
+{
+	CAutoTraceFlag atf1(EtraceSimulateOOM, false);
+	CAutoTraceFlag atf2(EtraceSimulateAbort, false);
+	CAutoTraceFlag atf3(EtraceSimulateIOError, false);
+	CAutoTraceFlag atf4(EtraceSimulateNetError, false);
+
+	Shutdown();
+	Init();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCache::SzLookup
+//
+//	@doc:
+//		Look up the plan for the given key and return a copy of its DXL
+//		in the given memory pool, or NULL if the plan is not cached
+//
+//---------------------------------------------------------------------------
+CHAR *
+CPlanCache::SzLookup
+	(
+	IMemoryPool *pmp,
+	const CPlanKey *pplankey
+	)
+{
+	GPOS_ASSERT(NULL != m_pcache && "Plan cache was not created");
+	GPOS_ASSERT(NULL != pplankey);
+
+	PlanCacheAccessor pcacc(m_pcache);
+	pcacc.Lookup(const_cast<CPlanKey *>(pplankey));
+
+	CCachedPlan *pcp = pcacc.PtVal();
+	if (NULL == pcp)
+	{
+		(void) UllExchangeAdd(&m_ullMisses, 1);
+		return NULL;
+	}
+
+	(void) UllExchangeAdd(&m_ullHits, 1);
+
+	const CHAR *szCached = pcp->SzPlan();
+	const ULONG ulLength = clib::UlStrLen(szCached);
+	CHAR *sz = GPOS_NEW_ARRAY(pmp, CHAR, ulLength + 1);
+	(void) clib::PvMemCpy(sz, szCached, ulLength + 1);
+
+	return sz;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCache::Insert
+//
+//	@doc:
+//		Add the serialized plan for the given key; the key text and the plan
+//		are copied into the memory pool of the cache entry
+//
+//---------------------------------------------------------------------------
+void
+CPlanCache::Insert
+	(
+	const CPlanKey *pplankey,
+	const CHAR *szPlan
+	)
+{
+	GPOS_ASSERT(NULL != m_pcache && "Plan cache was not created");
+	GPOS_ASSERT(NULL != pplankey);
+	GPOS_ASSERT(NULL != szPlan);
+
+	PlanCacheAccessor pcacc(m_pcache);
+	IMemoryPool *pmp = pcacc.Pmp();
+
+	const ULONG ulKeyLength = pplankey->UlLength();
+	WCHAR *wszKey = GPOS_NEW_ARRAY(pmp, WCHAR, ulKeyLength + 1);
+	(void) clib::WszWcsNCpy(wszKey, pplankey->Wsz(), ulKeyLength);
+	wszKey[ulKeyLength] = WCHAR_EOS;
+
+	const ULONG ulPlanLength = clib::UlStrLen(szPlan);
+	CHAR *sz = GPOS_NEW_ARRAY(pmp, CHAR, ulPlanLength + 1);
+	(void) clib::PvMemCpy(sz, szPlan, ulPlanLength + 1);
+
+	CCachedPlan *pcp = GPOS_NEW(pmp) CCachedPlan(pmp, sz);
+
+	CAutoP<CPlanKey> a_pplankey;
+	a_pplankey = GPOS_NEW(pmp) CPlanKey(wszKey, ulKeyLength);
+
+	// if another task cached the same plan in the meantime, the new entry is
+	// discarded together with its memory pool
+	(void) pcacc.PtInsert(a_pplankey.Pt(), pcp);
+
+	// safely inserted
+	(void) a_pplankey.PtReset();
+}
+
+// EOF
@@ -0,0 +1,109 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CPlanKey.cpp
+//
+//	@doc:
+//		Implementation of a key for plans in the plan cache
+//---------------------------------------------------------------------------
+
+#include "gpos/common/clibwrapper.h"
+#include "gpos/utils.h"
+
+#include "gpopt/optimizer/CPlanKey.h"
+
+using namespace gpos;
+using namespace gpopt;
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanKey::CPlanKey
+//
+//	@doc:
+//		Constructs a plan cache key
+//
+//---------------------------------------------------------------------------
+CPlanKey::CPlanKey
+	(
+	const WCHAR *wsz,
+	ULONG ulLength
+	)
+	:
+	m_wsz(wsz),
+	m_ulLength(ulLength),
+	m_ulHash(0)
+{
+	GPOS_ASSERT(NULL != wsz);
+
+	m_ulHash = UlHashByteArray((const BYTE *) wsz, ulLength * GPOS_SIZEOF(WCHAR));
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanKey::FEquals
+//
+//	@doc:
+//		Equality function
+//
+//---------------------------------------------------------------------------
+BOOL
+CPlanKey::FEquals
+	(
+	const CPlanKey &plankey
+	)
+	const
+{
+	return m_ulHash == plankey.m_ulHash &&
+			m_ulLength == plankey.m_ulLength &&
+			0 == clib::IWcsNCmp(m_wsz, plankey.m_wsz, m_ulLength);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanKey::FEqualPlanKey
+//
+//	@doc:
+//		Equality function for using plan keys in a cache
+//
+//---------------------------------------------------------------------------
+BOOL
+CPlanKey::FEqualPlanKey
+	(
+	CPlanKey* const &pvLeft,
+	CPlanKey* const &pvRight
+	)
+{
+	if (NULL == pvLeft && NULL == pvRight)
+	{
+		return true;
+	}
+
+	if (NULL == pvLeft || NULL == pvRight)
+	{
+		return false;
+	}
+
+	return pvLeft->FEquals(*pvRight);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanKey::UlHashPlanKey
+//
+//	@doc:
+//		Hash function for using plan keys in a cache
+//
+//---------------------------------------------------------------------------
+ULONG
+CPlanKey::UlHashPlanKey
+	(
+	CPlanKey* const & pv
+	)
+{
+	return pv->UlHash();
+}
+
+// EOF
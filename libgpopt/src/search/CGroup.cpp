@@ -18,9 +18,11 @@
 #include "gpopt/base/CDrvdPropCtxtPlan.h"
 #include "gpopt/base/CDrvdPropCtxtRelational.h"
 #include "gpopt/base/COptimizationContext.h"
+#include "gpopt/engine/CPartialPlan.h"
 #include "gpopt/search/CGroup.h"
 #include "gpopt/search/CGroupProxy.h"
 #include "gpopt/search/CJobGroup.h"
+#include "gpopt/search/CStatsCache.h"
 #include "gpopt/operators/CExpressionHandle.h"
 #include "gpopt/operators/CLogicalCTEProducer.h"
 #include "gpopt/operators/CLogicalCTEConsumer.h"
@@ -162,6 +164,7 @@ CGroup::SContextLink::FEqual
 CGroup::CGroup
 	(
 	IMemoryPool *pmp,
+	CStatsCache *pstatscache,
 	BOOL fScalar
 	)
 	:
@@ -176,7 +179,7 @@ CGroup::CGroup
 	m_pccDummy(NULL),
 	m_pgroupDuplicate(NULL),
 	m_plinkmap(NULL),
-	m_pstatsmap(NULL),
+	m_pstatscache(pstatscache),
 	m_ulGExprs(0),
 	m_pcostmap(NULL),
 	m_ulpOptCtxts(0),
@@ -187,22 +190,21 @@ CGroup::CGroup
 	m_fCTEConsumer(false)
 {
 	GPOS_ASSERT(NULL != pmp);
+	GPOS_ASSERT(NULL != pstatscache);
 
 	m_listGExprs.Init(GPOS_OFFSET(CGroupExpression, m_linkGroup));
 	m_listDupGExprs.Init(GPOS_OFFSET(CGroupExpression, m_linkGroup));
 
-	m_sht.Init
+	m_lfht.Init
 			(
 			pmp,
 			GPOPT_OPTCTXT_HT_BUCKETS,
 			GPOS_OFFSET(COptimizationContext, m_link),
 			0, /*cKeyOffset (0 because we use COptimizationContext class as key)*/
-			&(COptimizationContext::m_ocInvalid),
 			COptimizationContext::UlHash,
 			COptimizationContext::FEqual
 			);
 	m_plinkmap = GPOS_NEW(pmp) LinkMap(pmp);
-	m_pstatsmap = GPOS_NEW(pmp) StatsMap(pmp);
 	m_pcostmap = GPOS_NEW(pmp) CostMap(pmp);
 }
 
@@ -224,7 +226,6 @@ CGroup::~CGroup()
 	CRefCount::SafeRelease(m_pccDummy);
 	CRefCount::SafeRelease(m_pstats);
 	m_plinkmap->Release();
-	m_pstatsmap->Release();
 	m_pcostmap->Release();
 	
 	// cleaning-up group expressions
@@ -265,27 +266,7 @@ CGroup::~CGroup()
 void
 CGroup::CleanupContexts()
 {
-	// need to suspend cancellation while cleaning up
-	{
-		CAutoSuspendAbort asa;
-
-		COptimizationContext *poc = NULL;
-		ShtIter shtit(m_sht);
-
-		while (NULL != poc || shtit.FAdvance())
-		{
-			CRefCount::SafeRelease(poc);
-
-			// iter's accessor scope
-			{
-				ShtAccIter shtitacc(shtit);
-				if (NULL != (poc = shtitacc.Pt()))
-				{
-					shtitacc.Remove(poc);
-				}
-			}
-		}
-	}
+	m_lfht.DestroyEntries(CleanupRelease<COptimizationContext>);
 
 #ifdef GPOS_DEBUG
 	CWorker::PwrkrSelf()->ResetTimeSlice();
@@ -311,13 +292,7 @@ CGroup::UpdateBestCost
 {
 	GPOS_ASSERT(CCostContext::estCosted == pcc->Est());
 
-	COptimizationContext *pocFound  = NULL;
-	
-	{
-		// scope for accessor
-		ShtAcc shta(Sht(), *poc);
-		pocFound = shta.PtLookup();
-	}
+	COptimizationContext *pocFound = Lfht().PtLookup(*poc);
 
 	GPOS_ASSERT(NULL != pocFound);
 
@@ -361,11 +336,7 @@ CGroup::PocLookup
 								ulSearchStageIndex
 								);
 
-	COptimizationContext *pocFound = NULL;
-	{
-		ShtAcc shta(Sht(), *poc);
-		pocFound =  shta.PtLookup();
-	}
+	COptimizationContext *pocFound = Lfht().PtLookup(*poc);
 	poc->Release();
 
 	return pocFound;
@@ -428,14 +399,18 @@ CGroup::PocInsert
 	COptimizationContext *poc
 	)
 {
-	ShtAcc shta(Sht(), *poc);
+	COptimizationContext *pocFound = Lfht().PtLookup(*poc);
+	if (NULL != pocFound)
+	{
+		return pocFound;
+	}
 
-	COptimizationContext *pocFound = shta.PtLookup();
-	if (NULL == pocFound)
+	pocFound = Lfht().PtInsert(poc);
+	if (pocFound == poc)
 	{
+		// context id is assigned only once insertion succeeded, so that
+		// ids are not used up by concurrent insertions of matching contexts
 		poc->SetId((ULONG) UlpIncOptCtxts());
-		shta.Insert(poc);
-		return poc;
 	}
 
 	return pocFound;
@@ -456,8 +431,7 @@ CGroup::PgexprBest
 	COptimizationContext *poc
 	)
 {
-	ShtAcc shta(Sht(), *poc);
-	COptimizationContext *pocFound = shta.PtLookup();
+	COptimizationContext *pocFound = Lfht().PtLookup(*poc);
 	if (NULL != pocFound)
 	{
 		return pocFound->PgexprBest();
@@ -655,6 +629,31 @@ CGroup::Insert
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CGroup::Remove
+//
+//	@doc:
+//		Remove group expression whose insertion into memo failed; the group
+//		must not have been published yet
+//
+//---------------------------------------------------------------------------
+void
+CGroup::Remove
+	(
+	CGroupExpression *pgexpr
+	)
+{
+	GPOS_ASSERT(m_slock.FOwned());
+	GPOS_ASSERT(this == pgexpr->Pgroup());
+
+	m_listGExprs.Remove(pgexpr);
+	m_ulGExprs--;
+
+	pgexpr->Reset(NULL /*pgroup*/, GPOPT_INVALID_GEXPR_ID);
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CGroup::MoveDuplicateGExpr
@@ -1722,20 +1721,12 @@ CGroup::OsPrintGrpOptCtxts
 	{
 		os << szPrefix << "Grp OptCtxts:" << std::endl;
 
-		COptimizationContext *poc = NULL;
-		ShtIter shtit(m_sht);
-		while (shtit.FAdvance())
+		COptimizationContext *poc = m_lfht.PtFirst();
+		while (NULL != poc)
 		{
-			{
-				ShtAccIter shtitacc(shtit);
-				poc = shtitacc.Pt();
-			}
-
-			if (NULL != poc)
-			{
-				os << szPrefix;
-				(void) poc->OsPrint(os, szPrefix);
-			}
+			os << szPrefix;
+			(void) poc->OsPrint(os, szPrefix);
+			poc = m_lfht.PtNextEntry(poc);
 
 			GPOS_CHECK_ABORT;
 		}
@@ -2042,7 +2033,15 @@ CGroup::PstatsCompute
 	GPOS_ASSERT(NULL != pgexpr);
 	GPOS_ASSERT(this == pgexpr->Pgroup());
 
-	IStatistics *pstats = m_pstatsmap->PtLookup(poc);
+	// stats are shared with the groups this group is a duplicate of
+	CGroup *pgroupStats = this;
+	while (pgroupStats->FDuplicateGroup())
+	{
+		pgroupStats = pgroupStats->PgroupDuplicate();
+	}
+	ULONG ulGroupId = pgroupStats->UlId();
+
+	IStatistics *pstats = m_pstatscache->PstatsLookup(ulGroupId, poc);
 	if (NULL != pstats)
 	{
 		return pstats;
@@ -2051,24 +2050,9 @@ CGroup::PstatsCompute
 	pstats = CLogical::PopConvert(pgexpr->Pop())->PstatsDerive(m_pmp, exprhdl, poc->Pdrgpstat());
 	GPOS_ASSERT(NULL != pstats);
 
-#ifdef GPOS_DEBUG
-	BOOL fSuccess = false;
-#endif  // GPOS_DEBUG
-
-	// add computed stats to local map -- we can't use group proxy here due to potential memory allocation
-	// which is disallowed with spin locks
-	{
-		CAutoMutex am(m_mutexStats);
-		am.Lock();
-		poc->AddRef();
-#ifdef GPOS_DEBUG
-		fSuccess =
-#endif  // GPOS_DEBUG
-		m_pstatsmap->FInsert(poc, pstats);
-	}
-	GPOS_ASSERT(fSuccess);
-
-	return pstats;
+	// add computed stats to memo-wide cache; if another worker computed
+	// stats for the same key concurrently, keep the ones inserted first
+	return m_pstatscache->PstatsInsert(ulGroupId, poc, pstats);
 }
 
 
@@ -2147,6 +2131,9 @@ CGroup::CostLowerBound
 
 	CCost costLowerBound = GPOPT_INFINITE_COST;
 
+	// partial plans whose cost lower bound is not computed yet
+	DrgPpp *pdrgppp = GPOS_NEW(pmp) DrgPpp(pmp);
+
 	// start with first non-logical group expression
 	CGroupExpression *pgexprCurrent = NULL;
 	{
@@ -2163,12 +2150,20 @@ CGroup::CostLowerBound
 
 		if (!CUtils::FEnforcer(pgexprCurrent->Pop()))
 		{
-			CCost costLowerBoundGExpr =
-				pgexprCurrent->CostLowerBound(pmp, prppInput, NULL /*pccChild*/,
-											  gpos::ulong_max /*ulChildIndex*/);
-			if (costLowerBoundGExpr < costLowerBound)
+			prppInput->AddRef();
+			CPartialPlan *ppp = GPOS_NEW(pmp) CPartialPlan(pgexprCurrent, prppInput, NULL /*pccChild*/, gpos::ulong_max /*ulChildIndex*/);
+			const CCost *pcostLowerBoundGExpr = pgexprCurrent->PcostLowerBound(ppp);
+			if (NULL == pcostLowerBoundGExpr)
 			{
-				costLowerBound = costLowerBoundGExpr;
+				pdrgppp->Append(ppp);
+			}
+			else
+			{
+				if (*pcostLowerBoundGExpr < costLowerBound)
+				{
+					costLowerBound = *pcostLowerBoundGExpr;
+				}
+				ppp->Release();
 			}
 		}
 
@@ -2179,6 +2174,26 @@ CGroup::CostLowerBound
 		}
 	}
 
+	// cost the remaining partial plans in one batch
+	const ULONG ulPlans = pdrgppp->UlLength();
+	if (0 < ulPlans)
+	{
+		DrgPcost *pdrgpcost = CPartialPlan::PdrgpcostCompute(pmp, pdrgppp);
+		for (ULONG ul = 0; ul < ulPlans; ul++)
+		{
+			CPartialPlan *ppp = (*pdrgppp)[ul];
+			CCost costLowerBoundGExpr = *(*pdrgpcost)[ul];
+			if (costLowerBoundGExpr < costLowerBound)
+			{
+				costLowerBound = costLowerBoundGExpr;
+			}
+
+			ppp->AddRef();
+			ppp->Pgexpr()->StoreCostLowerBound(pmp, ppp, costLowerBoundGExpr);
+		}
+		pdrgpcost->Release();
+	}
+	pdrgppp->Release();
 
 	prppInput->AddRef();
 #ifdef GPOS_DEBUG
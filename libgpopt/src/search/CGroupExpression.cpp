@@ -179,7 +179,12 @@ CGroupExpression::Init
 	ULONG ulId
 	)
 {
-	SetGroup(pgroup);
+	// group expressions inserted into a group that is already in memo are
+	// bound to it before they are published
+	if (pgroup != m_pgroup)
+	{
+		SetGroup(pgroup);
+	}
 	SetId(ulId);
 	SetOptimizationLevel();
 }
@@ -339,7 +344,7 @@ CGroupExpression::FCostContextExists
 
 	while (NULL != pccFound)
 	{
-		if (COptimizationContext::FEqualContextIds(pdrgpoc, pccFound->Pdrgpoc()))
+		if (COptimizationContext::FEqualContexts(pdrgpoc, pccFound->Pdrgpoc()))
 		{
 			// a cost context, matching required properties and child contexts, was already created
 			return true;
@@ -547,7 +552,7 @@ CGroupExpression::CostLowerBound
 		pccChild->AddRef();
 	}
 	CPartialPlan *ppp = GPOS_NEW(pmp) CPartialPlan(this, prppInput, pccChild, ulChildIndex);
-	CCost *pcostLowerBound = m_ppartialplancostmap->PtLookup(ppp);
+	const CCost *pcostLowerBound = PcostLowerBound(ppp);
 	if (NULL != pcostLowerBound)
 	{
 		ppp->Release();
@@ -556,14 +561,37 @@ CGroupExpression::CostLowerBound
 
 	// compute partial plan cost
 	CCost cost = ppp->CostCompute(pmp);
+	StoreCostLowerBound(pmp, ppp, cost);
+
+	return cost;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CGroupExpression::StoreCostLowerBound
+//
+//	@doc:
+//		Store cost lower bound of a partial plan rooted by current group
+//		expression
+//
+//---------------------------------------------------------------------------
+void
+CGroupExpression::StoreCostLowerBound
+	(
+	IMemoryPool *pmp,
+	CPartialPlan *ppp,
+	CCost cost
+	)
+{
+	GPOS_ASSERT(NULL != ppp);
+	GPOS_ASSERT(this == ppp->Pgexpr());
 
 #ifdef GPOS_DEBUG
 	BOOL fSuccess =
 #endif // GPOS_DEBUG
 		m_ppartialplancostmap->FInsert(ppp, GPOS_NEW(pmp) CCost(cost.DVal()));
 	GPOS_ASSERT(fSuccess);
-
-	return cost;
 }
 
 
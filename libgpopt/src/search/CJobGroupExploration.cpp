@@ -298,7 +298,7 @@ CJobGroupExploration::ScheduleJob
 	// initialize job
 	CJobGroupExploration *pjge = PjConvert(pj);
 	pjge->Init(pgroup);
-	psc->Psched()->Add(pjge, pjParent);
+	psc->Psched()->Add(pjge, pjParent, psc->UlWorker());
 }
 
 #ifdef GPOS_DEBUG
@@ -47,6 +47,26 @@ CJobGroupExpression::Init
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CJobGroupExpression::Pgroup
+//
+//	@doc:
+//		Group of target group expression
+//
+//---------------------------------------------------------------------------
+CGroup *
+CJobGroupExpression::Pgroup() const
+{
+	if (NULL == m_pgexpr)
+	{
+		return NULL;
+	}
+
+	return m_pgexpr->Pgroup();
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CJobGroupExpression::ScheduleTransformations
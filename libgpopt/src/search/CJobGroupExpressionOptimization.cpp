@@ -662,6 +662,7 @@ CJobGroupExpressionOptimization::EevtOptimizeSelf
 	}
 	
 	pgexpr->Pgroup()->UpdateBestCost(poc, pcc);
+	psc->Peng()->ProcessBestCostUpdate(poc);
 
 	if (FScheduleCTEOptimization(psc, pgexpr, poc, ulOptReq, pjgeo))
 	{
@@ -751,7 +752,7 @@ CJobGroupExpressionOptimization::ScheduleJob
 	// initialize job
 	CJobGroupExpressionOptimization *pjgeo = PjConvert(pj);
 	pjgeo->Init(pgexpr, poc, ulOptReq);
-	psc->Psched()->Add(pjgeo, pjParent);
+	psc->Psched()->Add(pjgeo, pjParent, psc->UlWorker());
 }
 
 
@@ -810,7 +811,7 @@ CJobGroupExpressionOptimization::FScheduleCTEOptimization
 
 	// initialize job
 	pjgeo->Init(pgexpr, poc, ulOptReq, prppCTEProducer);
-	psc->Psched()->Add(pjgeo, pjParent);
+	psc->Psched()->Add(pjgeo, pjParent, psc->UlWorker());
 	prppCTEProducer->Release();
 
 	return true;
@@ -391,7 +391,7 @@ CJobGroupOptimization::ScheduleJob
 	// initialize job
 	CJobGroupOptimization *pjgo = PjConvert(pj);
 	pjgo->Init(pgroup, pgexprOrigin, poc);
-	psc->Psched()->Add(pjgo, pjParent);
+	psc->Psched()->Add(pjgo, pjParent, psc->UlWorker());
 }
 
 #ifdef GPOS_DEBUG
@@ -0,0 +1,463 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2018 Pivotal, Inc.
+//
+//	@filename:
+//		CJobProfiler.cpp
+//
+//	@doc:
+//		Implementation of optimization job profiler
+//---------------------------------------------------------------------------
+
+#include "gpos/base.h"
+
+#include "gpopt/search/CGroup.h"
+#include "gpopt/search/CJobProfiler.h"
+#include "gpopt/xforms/CXformFactory.h"
+
+using namespace gpopt;
+
+// bits of a profile key holding the group id and the xform id
+#define GPOPT_JOB_PROFILE_GROUP_BITS	32
+#define GPOPT_JOB_PROFILE_XFORM_BITS	24
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJobProfiler::CJobProfiler
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+CJobProfiler::CJobProfiler
+	(
+	IMemoryPool *pmp,
+	ULONG ulWorkers
+	)
+	:
+	m_pmp(pmp),
+	m_ulWorkers(ulWorkers),
+	m_rgphm(NULL)
+{
+	GPOS_ASSERT(NULL != pmp);
+	GPOS_ASSERT(0 < ulWorkers);
+
+	m_rgphm = GPOS_NEW_ARRAY(m_pmp, HMUllStats*, m_ulWorkers);
+	for (ULONG ul = 0; ul < m_ulWorkers; ul++)
+	{
+		m_rgphm[ul] = GPOS_NEW(m_pmp) HMUllStats(m_pmp);
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJobProfiler::~CJobProfiler
+//
+//	@doc:
+//		Dtor
+//
+//---------------------------------------------------------------------------
+CJobProfiler::~CJobProfiler()
+{
+	for (ULONG ul = 0; ul < m_ulWorkers; ul++)
+	{
+		m_rgphm[ul]->Release();
+	}
+	GPOS_DELETE_ARRAY(m_rgphm);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJobProfiler::UllKey
+//
+//	@doc:
+//		Profile key of a job type, group id and xform id
+//
+//---------------------------------------------------------------------------
+ULLONG
+CJobProfiler::UllKey
+	(
+	CJob::EJobType ejt,
+	ULONG ulGroupId,
+	ULONG ulXformId
+	)
+{
+	GPOS_ASSERT(ulXformId < (1u << GPOPT_JOB_PROFILE_XFORM_BITS));
+
+	return
+		(((ULLONG) ejt) << (GPOPT_JOB_PROFILE_GROUP_BITS + GPOPT_JOB_PROFILE_XFORM_BITS)) |
+		(((ULLONG) ulXformId) << GPOPT_JOB_PROFILE_GROUP_BITS) |
+		((ULLONG) ulGroupId);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJobProfiler::EjtKey
+//
+//	@doc:
+//		Job type of a profile key
+//
+//---------------------------------------------------------------------------
+CJob::EJobType
+CJobProfiler::EjtKey
+	(
+	ULLONG ullKey
+	)
+{
+	return (CJob::EJobType) (ullKey >> (GPOPT_JOB_PROFILE_GROUP_BITS + GPOPT_JOB_PROFILE_XFORM_BITS));
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJobProfiler::UlGroupIdKey
+//
+//	@doc:
+//		Group id of a profile key
+//
+//---------------------------------------------------------------------------
+ULONG
+CJobProfiler::UlGroupIdKey
+	(
+	ULLONG ullKey
+	)
+{
+	return (ULONG) (ullKey & gpos::ulong_max);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJobProfiler::UlXformIdKey
+//
+//	@doc:
+//		Xform id of a profile key
+//
+//---------------------------------------------------------------------------
+ULONG
+CJobProfiler::UlXformIdKey
+	(
+	ULLONG ullKey
+	)
+{
+	return (ULONG) ((ullKey >> GPOPT_JOB_PROFILE_GROUP_BITS) & ((1u << GPOPT_JOB_PROFILE_XFORM_BITS) - 1));
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJobProfiler::Accumulate
+//
+//	@doc:
+//		Add counters to the entry of the given key
+//
+//---------------------------------------------------------------------------
+void
+CJobProfiler::Accumulate
+	(
+	IMemoryPool *pmp,
+	HMUllStats *phm,
+	ULLONG ullKey,
+	const SStats &stats
+	)
+{
+	SStats *pstats = phm->PtLookup(&ullKey);
+	if (NULL == pstats)
+	{
+		pstats = GPOS_NEW(pmp) SStats();
+#ifdef GPOS_DEBUG
+		BOOL fInserted =
+#endif // GPOS_DEBUG
+			phm->FInsert(GPOS_NEW(pmp) ULLONG(ullKey), pstats);
+		GPOS_ASSERT(fInserted);
+	}
+
+	pstats->Add(stats);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJobProfiler::Record
+//
+//	@doc:
+//		Record an execution slice of the given job by the given worker;
+//		only the calling worker touches its map, so no locking is needed
+//
+//---------------------------------------------------------------------------
+void
+CJobProfiler::Record
+	(
+	ULONG ulWorker,
+	CJob *pj,
+	ULONG ulTimeUS,
+	ULLONG ullBytes
+	)
+{
+	GPOS_ASSERT(NULL != pj);
+	GPOS_ASSERT(ulWorker < m_ulWorkers);
+
+	ULONG ulGroupId = gpos::ulong_max;
+	CGroup *pgroup = pj->Pgroup();
+	if (NULL != pgroup)
+	{
+		ulGroupId = pgroup->UlId();
+	}
+
+	ULONG ulXformId = CXform::ExfInvalid;
+	CXform *pxform = pj->Pxform();
+	if (NULL != pxform)
+	{
+		ulXformId = pxform->Exfid();
+	}
+
+	SStats stats;
+	stats.m_ullExecutions = 1;
+	stats.m_ullTimeUS = ulTimeUS;
+	stats.m_ullBytes = ullBytes;
+
+	Accumulate(m_pmp, m_rgphm[ulWorker], UllKey(pj->Ejt(), ulGroupId, ulXformId), stats);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJobProfiler::PhmMerge
+//
+//	@doc:
+//		Merge maps of all workers into a new map
+//
+//---------------------------------------------------------------------------
+CJobProfiler::HMUllStats *
+CJobProfiler::PhmMerge() const
+{
+	HMUllStats *phm = GPOS_NEW(m_pmp) HMUllStats(m_pmp);
+	for (ULONG ul = 0; ul < m_ulWorkers; ul++)
+	{
+		HMUllStatsIter hmi(m_rgphm[ul]);
+		while (hmi.FAdvance())
+		{
+			Accumulate(m_pmp, phm, *hmi.Pk(), *hmi.Pt());
+		}
+	}
+
+	return phm;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJobProfiler::StatsJobType
+//
+//	@doc:
+//		Counters of a job type, summed over all groups and xforms
+//
+//---------------------------------------------------------------------------
+CJobProfiler::SStats
+CJobProfiler::StatsJobType
+	(
+	CJob::EJobType ejt
+	)
+	const
+{
+	SStats stats;
+	for (ULONG ul = 0; ul < m_ulWorkers; ul++)
+	{
+		HMUllStatsIter hmi(m_rgphm[ul]);
+		while (hmi.FAdvance())
+		{
+			if (ejt == EjtKey(*hmi.Pk()))
+			{
+				stats.Add(*hmi.Pt());
+			}
+		}
+	}
+
+	return stats;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJobProfiler::StatsXform
+//
+//	@doc:
+//		Counters of an xform, summed over all groups
+//
+//---------------------------------------------------------------------------
+CJobProfiler::SStats
+CJobProfiler::StatsXform
+	(
+	CXform::EXformId exfid
+	)
+	const
+{
+	SStats stats;
+	for (ULONG ul = 0; ul < m_ulWorkers; ul++)
+	{
+		HMUllStatsIter hmi(m_rgphm[ul]);
+		while (hmi.FAdvance())
+		{
+			if ((ULONG) exfid == UlXformIdKey(*hmi.Pk()))
+			{
+				stats.Add(*hmi.Pt());
+			}
+		}
+	}
+
+	return stats;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJobProfiler::SzJobType
+//
+//	@doc:
+//		Name of a job type
+//
+//---------------------------------------------------------------------------
+const CHAR *
+CJobProfiler::SzJobType
+	(
+	CJob::EJobType ejt
+	)
+{
+	const CHAR *rgszJobType[] =
+	{
+		"Test",
+		"GroupOptimization",
+		"GroupImplementation",
+		"GroupExploration",
+		"GroupExpressionOptimization",
+		"GroupExpressionImplementation",
+		"GroupExpressionExploration",
+		"Transformation",
+	};
+	GPOS_ASSERT(CJob::EjtSentinel == GPOS_ARRAY_SIZE(rgszJobType));
+	GPOS_ASSERT(CJob::EjtSentinel > ejt);
+
+	return rgszJobType[ejt];
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJobProfiler::OsPrint
+//
+//	@doc:
+//		Print counters per job type and per xform
+//
+//---------------------------------------------------------------------------
+IOstream &
+CJobProfiler::OsPrint
+	(
+	IOstream &os
+	)
+	const
+{
+	HMUllStats *phm = PhmMerge();
+
+	SStats rgstatsJob[CJob::EjtSentinel];
+	SStats rgstatsXform[CXform::ExfSentinel];
+	HMUllStatsIter hmi(phm);
+	while (hmi.FAdvance())
+	{
+		ULLONG ullKey = *hmi.Pk();
+		rgstatsJob[EjtKey(ullKey)].Add(*hmi.Pt());
+
+		ULONG ulXformId = UlXformIdKey(ullKey);
+		if (CXform::ExfInvalid != ulXformId)
+		{
+			rgstatsXform[ulXformId].Add(*hmi.Pt());
+		}
+	}
+
+	os << "Job profile:" << std::endl;
+	for (ULONG ul = 0; ul < CJob::EjtSentinel; ul++)
+	{
+		if (0 < rgstatsJob[ul].m_ullExecutions)
+		{
+			os
+				<< SzJobType((CJob::EJobType) ul)
+				<< ": executions=" << rgstatsJob[ul].m_ullExecutions
+				<< " time=" << rgstatsJob[ul].m_ullTimeUS << "us"
+				<< " bytes=" << rgstatsJob[ul].m_ullBytes
+				<< std::endl;
+		}
+	}
+
+	CXformFactory *pxff = CXformFactory::Pxff();
+	for (ULONG ul = 0; ul < CXform::ExfSentinel; ul++)
+	{
+		if (0 < rgstatsXform[ul].m_ullExecutions)
+		{
+			os
+				<< pxff->Pxf((CXform::EXformId) ul)->SzId()
+				<< ": executions=" << rgstatsXform[ul].m_ullExecutions
+				<< " time=" << rgstatsXform[ul].m_ullTimeUS << "us"
+				<< " bytes=" << rgstatsXform[ul].m_ullBytes
+				<< std::endl;
+		}
+	}
+
+	phm->Release();
+
+	return os;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJobProfiler::OsPrintFolded
+//
+//	@doc:
+//		Print wall time in folded stacks format, e.g.,
+//
+//			Group 3;Transformation;CXformJoinCommutativity 1250
+//
+//		Frames are the memo group, the job type and the xform, if any;
+//		the value is the time in micro-seconds
+//
+//---------------------------------------------------------------------------
+IOstream &
+CJobProfiler::OsPrintFolded
+	(
+	IOstream &os
+	)
+	const
+{
+	HMUllStats *phm = PhmMerge();
+	CXformFactory *pxff = CXformFactory::Pxff();
+
+	HMUllStatsIter hmi(phm);
+	while (hmi.FAdvance())
+	{
+		ULLONG ullKey = *hmi.Pk();
+
+		ULONG ulGroupId = UlGroupIdKey(ullKey);
+		if (gpos::ulong_max != ulGroupId)
+		{
+			os << "Group " << ulGroupId << ";";
+		}
+
+		os << SzJobType(EjtKey(ullKey));
+
+		ULONG ulXformId = UlXformIdKey(ullKey);
+		if (CXform::ExfInvalid != ulXformId)
+		{
+			os << ";" << pxff->Pxf((CXform::EXformId) ulXformId)->SzId();
+		}
+
+		os << " " << hmi.Pt()->m_ullTimeUS << std::endl;
+	}
+
+	phm->Release();
+
+	return os;
+}
+
+// EOF
@@ -121,7 +121,7 @@ CJobQueue::NotifyCompleted
 		if (1 == pj->UlpDecrRefs())
 		{
 			// update job as completed
-			psc->Psched()->CompleteQueued(pj);
+			psc->Psched()->CompleteQueued(pj, psc->UlWorker());
 
 			// recycle job
 			psc->Pjf()->Release(pj);
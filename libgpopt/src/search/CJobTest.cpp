@@ -130,7 +130,7 @@ CJobTest::FSpawn
 			pjt->Init(this);
 
 			// schedule new job for execution as child
-			psc->Psched()->Add(pj, this);
+			psc->Psched()->Add(pj, this, psc->UlWorker());
 
 			GPOS_CHECK_ABORT;
 		}
@@ -174,7 +174,7 @@ CJobTest::FStartQueue
 			pjt->Init(CJobTest::EttQueueu, m_ulRounds, m_ulFanout, m_ulIters, m_pjq);
 
 			// schedule new job for execution as child
-			psc->Psched()->Add(pj, this);
+			psc->Psched()->Add(pj, this, psc->UlWorker());
 
 			GPOS_CHECK_ABORT;
 		}
@@ -72,6 +72,9 @@ const WCHAR rgwszEvents[CJobTransformation::eevSentinel][GPOPT_FSM_NAME_LENGTH]
 //
 //---------------------------------------------------------------------------
 CJobTransformation::CJobTransformation()
+	:
+	m_pgexpr(NULL),
+	m_pxform(NULL)
 {}
 
 
@@ -180,6 +183,26 @@ CJobTransformation::FExecute
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CJobTransformation::Pgroup
+//
+//	@doc:
+//		Group of target group expression
+//
+//---------------------------------------------------------------------------
+CGroup *
+CJobTransformation::Pgroup() const
+{
+	if (NULL == m_pgexpr)
+	{
+		return NULL;
+	}
+
+	return m_pgexpr->Pgroup();
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CJobTransformation::ScheduleJob
@@ -202,7 +225,7 @@ CJobTransformation::ScheduleJob
 	// initialize job
 	CJobTransformation *pjt = PjConvert(pj);
 	pjt->Init(pgexpr, pxform);
-	psc->Psched()->Add(pjt, pjParent);
+	psc->Psched()->Add(pjt, pjParent, psc->UlWorker());
 }
 
 #ifdef GPOS_DEBUG
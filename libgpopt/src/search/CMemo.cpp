@@ -11,8 +11,6 @@
 
 #include "gpos/base.h"
 #include "gpos/common/CAutoTimer.h"
-#include "gpos/common/CSyncHashtableAccessByIter.h"
-#include "gpos/common/CSyncHashtableAccessByKey.h"
 #include "gpos/io/COstreamString.h"
 #include "gpos/string/CWStringDynamic.h"
 
@@ -26,6 +24,7 @@
 
 #include "gpopt/search/CGroupProxy.h"
 #include "gpopt/search/CMemo.h"
+#include "gpopt/search/CStatsCache.h"
 #include "gpopt/operators/CExpressionHandle.h"
 #include "gpopt/operators/CLogicalCTEProducer.h"
 
@@ -51,22 +50,24 @@ CMemo::CMemo
 	m_pmp(pmp),
 	m_pgroupRoot(NULL),
 	m_ulpGrps(0),
-	m_pmemotmap(NULL)
+	m_pmemotmap(NULL),
+	m_pstatscache(NULL)
 {
 	GPOS_ASSERT(NULL != pmp);
 
-	m_sht.Init
+	m_lfht.Init
 		(
 		pmp,
 		GPOPT_MEMO_HT_BUCKETS,
 		GPOS_OFFSET(CGroupExpression, m_linkMemo),
 		0, /*cKeyOffset (0 because we use CGroupExpression class as key)*/
-		&(CGroupExpression::m_gexprInvalid),
 		CGroupExpression::UlHash,
 		CGroupExpression::FEqual
 		);
 
 	m_listGroups.Init(GPOS_OFFSET(CGroup, m_link));
+
+	m_pstatscache = GPOS_NEW(pmp) CStatsCache(pmp);
 }
 
 
@@ -80,6 +81,8 @@ CMemo::CMemo
 //---------------------------------------------------------------------------
 CMemo::~CMemo()
 {
+	GPOS_DELETE(m_pstatscache);
+
 	CGroup *pgroup = m_listGroups.PtFirst();
 	while(NULL != pgroup)
 	{
@@ -116,20 +119,24 @@ CMemo::SetRoot
 
 //---------------------------------------------------------------------------
 //	@function:
-//		CMemo::Add
+//		CMemo::InitGroup
 //
 //	@doc:
-//		Add new group to list
+//		Set up a new group around its first group expression; the group
+//		is only reachable through that group expression, so it is set up
+//		completely before the group expression is published
 //
 //---------------------------------------------------------------------------
 void
-CMemo::Add
+CMemo::InitGroup
 	(
 	CGroup *pgroup,
+	CGroupExpression *pgexpr,
 	CExpression *pexprOrigin // origin expression that produced the group
 	)
 {
 	GPOS_ASSERT(NULL != pgroup);
+	GPOS_ASSERT(NULL != pgexpr);
 	GPOS_ASSERT(NULL != pexprOrigin);
 	GPOS_ASSERT(!pexprOrigin->Pop()->FPhysical() && "Physical operators do not create new groups");
 
@@ -145,23 +152,15 @@ CMemo::Add
 	}
 	GPOS_ASSERT(NULL != pdp);
 
+	// group id is part of a fully built group, since duplicate groups are
+	// ordered and group stats are cached by group id
 	ULONG ulId = m_aul.TIncr();
 	pdp->AddRef();
-#ifdef GPOS_DEBUG
-	CGroupExpression *pgexpr = NULL;
-#endif  // GPOS_DEBUG
-	{
-		CGroupProxy gp(pgroup);
-		gp.SetId(ulId);
-		gp.InitProperties(pdp);
-#ifdef GPOS_DEBUG
-		pgexpr = gp.PgexprFirst();
-#endif  // GPOS_DEBUG
-	}
 
-	GPOS_ASSERT(NULL != pgexpr);
-	m_listGroups.Push(pgroup);
-	(void) UlpExchangeAdd(&m_ulpGrps, 1);
+	CGroupProxy gp(pgroup);
+	gp.SetId(ulId);
+	gp.InitProperties(pdp);
+	gp.Insert(pgexpr);
 }
 
 
@@ -170,8 +169,12 @@ CMemo::Add
 //		CMemo::PgroupInsert
 //
 //	@doc:
-//		Helper for inserting group expression in target group
-//
+//		Helper for inserting group expression in target group;
+//		the group expression is published in the hash table only once it
+//		is bound to a fully built group, so that a worker finding it there
+//		can use its group right away; if an equal group expression was
+//		inserted concurrently, the given group expression is unbound and
+//		the group of the existing one is returned
 //
 //---------------------------------------------------------------------------
 CGroup *
@@ -186,29 +189,45 @@ CMemo::PgroupInsert
 	GPOS_ASSERT(NULL != pgroupTarget);
 	GPOS_ASSERT(NULL != pgexpr);
 
-	ShtAcc shta(m_sht, *pgexpr);
-
-	// we do a lookup since group expression may have been already inserted
-	CGroupExpression *pgexprFound = shta.PtLookup();
-	if (NULL == pgexprFound)
+	if (fNewGroup)
 	{
-		shta.Insert(pgexpr);
+		InitGroup(pgroupTarget, pgexpr, pexprOrigin);
+	}
+	else
+	{
+		// target group is already in memo; the group expression is added
+		// to its list, and gets its id, only if insertion succeeds
+		pgexpr->Reset(pgroupTarget, GPOPT_INVALID_GEXPR_ID);
+	}
 
-		// group proxy scope
+	CGroupExpression *pgexprFound = m_lfht.PtInsert(pgexpr);
+	if (pgexprFound != pgexpr)
+	{
+		if (fNewGroup)
 		{
 			CGroupProxy gp(pgroupTarget);
-			gp.Insert(pgexpr);
+			gp.Remove(pgexpr);
 		}
-
-		if (fNewGroup)
+		else
 		{
-			Add(pgroupTarget, pexprOrigin);
+			pgexpr->Reset(NULL /*pgroup*/, GPOPT_INVALID_GEXPR_ID);
 		}
 
-		return pgexpr->Pgroup();
+		return pgexprFound->Pgroup();
+	}
+
+	if (fNewGroup)
+	{
+		m_listGroups.Push(pgroupTarget);
+		(void) UlpExchangeAdd(&m_ulpGrps, 1);
+	}
+	else
+	{
+		CGroupProxy gp(pgroupTarget);
+		gp.Insert(pgexpr);
 	}
 
-	return pgexprFound->Pgroup();
+	return pgroupTarget;
 }
 
 
@@ -232,7 +251,7 @@ CMemo::FNewGroup
 
 	if (NULL == *ppgroupTarget && NULL == pgexpr)
 	{
-		*ppgroupTarget = GPOS_NEW(m_pmp) CGroup(m_pmp, fScalar);
+		*ppgroupTarget = GPOS_NEW(m_pmp) CGroup(m_pmp, m_pstatscache, fScalar);
 
 		return true;
 	}
@@ -268,12 +287,7 @@ CMemo::PgroupInsert
 	GPOS_ASSERT(pgexpr->UlArity() == pexprOrigin->UlArity());
 
 	CGroup *pgroupContainer = NULL;
-	CGroupExpression *pgexprFound = NULL;
-	// hash table accessor's scope
-	{
-		ShtAcc shta(m_sht, *pgexpr);
-		pgexprFound = shta.PtLookup();
-	}
+	CGroupExpression *pgexprFound = m_lfht.PtLookup(*pgexpr);
 
 	// check if we may need to create a new group
 	BOOL fNewGroup = FNewGroup(&pgroupTarget, pgexprFound, pgexpr->Pop()->FScalar());
@@ -522,22 +536,7 @@ CMemo::FRehash()
 	// dump memo hash table into a local list
 	CList<CGroupExpression> listGExprs;
 	listGExprs.Init(GPOS_OFFSET(CGroupExpression, m_linkMemo));
-
-	ShtIter shtit(m_sht);
-	CGroupExpression *pgexpr = NULL;
-	while (NULL != pgexpr || shtit.FAdvance())
-	{
-		{
-			ShtAccIter shtitacc(shtit);
-			pgexpr = shtitacc.Pt();
-			if (NULL != pgexpr)
-			{
-				shtitacc.Remove(pgexpr);
-				listGExprs.Append(pgexpr);
-			}
-		}
-		GPOS_CHECK_ABORT;
-	}
+	m_lfht.Reset(&listGExprs);
 
 	// iterate on list and insert non-duplicate group expressions
 	// back to memo hash table
@@ -545,19 +544,11 @@ CMemo::FRehash()
 	while (!listGExprs.FEmpty())
 	{
 		CGroupExpression *pgexpr = listGExprs.RemoveHead();
-		CGroupExpression *pgexprFound = NULL;
-
+		CGroupExpression *pgexprFound = m_lfht.PtInsert(pgexpr);
+		if (pgexprFound == pgexpr)
 		{
-			// hash table accessor scope
- 			ShtAcc shta(m_sht, *pgexpr);
- 			pgexprFound = shta.PtLookup();
-
- 			if (NULL == pgexprFound)
- 			{
- 				// group expression has no duplicates, insert back to memo hash table
- 				shta.Insert(pgexpr);
- 				continue;
- 			}
+			// group expression has no duplicates, it is back in memo hash table
+			continue;
 		}
 
 		GPOS_ASSERT(pgexprFound != pgexpr);
@@ -861,6 +852,30 @@ CMemo::UlGrpExprs()
 	return ulGExprs;
 }
 
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemo::UlpContextInsertRetries
+//
+//	@doc:
+//		Return number of optimization context insertions retried due to
+//		concurrent insertions, summed over all groups
+//
+//---------------------------------------------------------------------------
+ULONG_PTR
+CMemo::UlpContextInsertRetries()
+{
+	ULONG_PTR ulpRetries = 0;
+	CGroup *pgroup = m_listGroups.PtFirst();
+	while (NULL != pgroup)
+	{
+		ulpRetries += pgroup->UlpInsertRetries();
+		pgroup = m_listGroups.PtNext(pgroup);
+	}
+
+	return ulpRetries;
+}
+
 #ifdef GPOS_DEBUG
 void
 CMemo::DbgPrint()
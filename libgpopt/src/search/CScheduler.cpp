@@ -11,10 +11,13 @@
 
 #include "gpos/base.h"
 
+#include "gpos/common/CWallClock.h"
 #include "gpos/sync/CAutoMutex.h"
+#include "gpos/sync/CAutoSpinlock.h"
 
 #include "gpopt/search/CJob.h"
 #include "gpopt/search/CJobFactory.h"
+#include "gpopt/search/CJobProfiler.h"
 #include "gpopt/search/CScheduler.h"
 #include "gpopt/search/CSchedulerContext.h"
 
@@ -42,6 +45,8 @@ CScheduler::CScheduler
 #endif // GPOS_DEBUG
 	)
 	:
+	m_pmp(pmp),
+	m_rgwq(NULL),
 	m_spjl(pmp, ulJobs),
 	m_ulpTasksMax(ulpTasks),
 	m_ulpTasksActive(0),
@@ -53,7 +58,9 @@ CScheduler::CScheduler
 	m_ulpStatsSuspended(0),
 	m_ulpStatsCompleted(0),
 	m_ulpStatsCompletedQueued(0),
-	m_ulpStatsResumed(0)
+	m_ulpStatsResumed(0),
+	m_ulpStatsStolen(0),
+	m_pjprof(NULL)
 #ifdef GPOS_DEBUG
 	,
 	m_fTrackingJobs(fTrackingJobs)
@@ -62,9 +69,15 @@ CScheduler::CScheduler
 	// initialize pool of job links
 	m_spjl.Init(GPOS_OFFSET(SJobLink, m_ulId));
 
-	// initialize list of waiting new jobs
-	m_listjlWaiting.Init(GPOS_OFFSET(SJobLink, m_link));
-	
+	GPOS_ASSERT(0 < ulpTasks);
+
+	// initialize per-worker lists of waiting new jobs
+	m_rgwq = GPOS_NEW_ARRAY(pmp, SWorkerQueue, ulpTasks);
+	for (ULONG ul = 0; ul < ulpTasks; ul++)
+	{
+		m_rgwq[ul].m_listjl.Init(GPOS_OFFSET(SJobLink, m_link));
+	}
+
 	// initialize event for job queue
 	m_event.Init(&m_mutex);
 
@@ -95,6 +108,8 @@ CScheduler::~CScheduler()
 		);
 
 	GPOS_ASSERT(0 == m_event.CWaiters());
+
+	GPOS_DELETE_ARRAY(m_rgwq);
 }
 
 
@@ -177,15 +192,24 @@ CScheduler::ExecuteJobs
 {
 	CJob *pj = NULL;
 	ULONG ulCount = 0;
+	const ULONG ulWorker = psc->UlWorker();
 
 	// keep retrieving jobs
-	while (NULL != (pj = PjRetrieve()))
+	while (NULL != (pj = PjRetrieve(ulWorker)))
 	{
 		// prepare for job execution
 		PreExecute(pj);
 
 		// execute job
-		BOOL fCompleted = FExecute(pj, psc);
+		BOOL fCompleted = false;
+		if (NULL == m_pjprof)
+		{
+			fCompleted = FExecute(pj, psc);
+		}
+		else
+		{
+			fCompleted = FExecuteProfiled(pj, psc);
+		}
 
 #ifdef GPOS_DEBUG
 		// restrict parallelism to keep track of jobs
@@ -202,7 +226,7 @@ CScheduler::ExecuteJobs
 		{
 			case EjrCompleted:
 				// job is completed
-				Complete(pj);
+				Complete(pj, ulWorker);
 
 #ifdef GPOS_DEBUG
 				if (GPOS_FTRACE(EopttracePrintJobScheduler))
@@ -220,7 +244,7 @@ CScheduler::ExecuteJobs
 
 			case EjrRunnable:
 				// child jobs have completed, job can immediately resume
-				Resume(pj);
+				Resume(pj, ulWorker);
 				continue;
 
 			case EjrSuspended:
@@ -253,7 +277,8 @@ void
 CScheduler::Add
 	(
 	CJob *pj,
-	CJob *pjParent
+	CJob *pjParent,
+	ULONG ulWorker
 	)
 {
 	GPOS_ASSERT(NULL != pj);
@@ -280,7 +305,7 @@ CScheduler::Add
 	// increment total number of jobs
 	(void) UlpExchangeAdd(&m_ulpTotal, 1);
 
-	Schedule(pj);
+	Schedule(pj, ulWorker);
 }
 
 
@@ -295,13 +320,14 @@ CScheduler::Add
 void
 CScheduler::Resume
 	(
-	CJob *pj
+	CJob *pj,
+	ULONG ulWorker
 	)
 {
 	GPOS_ASSERT(NULL != pj);
 	GPOS_ASSERT(0 == pj->UlpRefs());
 
-	Schedule(pj);
+	Schedule(pj, ulWorker);
 }
 
 
@@ -310,13 +336,14 @@ CScheduler::Resume
 //		CScheduler::Schedule
 //
 //	@doc:
-//		Schedule job for execution
+//		Schedule job for execution on the queue of the given worker
 //
 //---------------------------------------------------------------------------
 void
 CScheduler::Schedule
 	(
-	CJob *pj
+	CJob *pj,
+	ULONG ulWorker
 	)
 {
 	GPOS_ASSERT(NULL != pj);
@@ -345,8 +372,13 @@ CScheduler::Schedule
 	}
 #endif // GPOS_DEBUG
 
-	// add to waiting list
-	m_listjlWaiting.Push(pjl);
+	// add to the tail of the worker's waiting list
+	{
+		SWorkerQueue &wq = m_rgwq[UlQueue(ulWorker)];
+		CAutoSpinlock as(wq.m_slock);
+		as.Lock();
+		wq.m_listjl.Append(pjl);
+	}
 
 	// increment number of queued jobs
 	(void) UlpExchangeAdd(&m_ulpQueued, 1);
@@ -455,6 +487,44 @@ CScheduler::FExecute
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CScheduler::FExecuteProfiled
+//
+//	@doc:
+//		Execute job and record its wall time and the growth of the global
+//		memory pool in the profiler
+//
+//---------------------------------------------------------------------------
+BOOL
+CScheduler::FExecuteProfiled
+	(
+	CJob *pj,
+	CSchedulerContext *psc
+	)
+{
+	GPOS_ASSERT(NULL != m_pjprof);
+
+	IMemoryPool *pmp = psc->PmpGlobal();
+	const ULLONG ullBytesBefore = pmp->UllTotalAllocatedSize();
+	CWallClock clock;
+
+	BOOL fCompleted = FExecute(pj, psc);
+
+	const ULONG ulTimeUS = clock.UlElapsedUS();
+	const ULLONG ullBytesAfter = pmp->UllTotalAllocatedSize();
+	ULLONG ullBytes = 0;
+	if (ullBytesAfter > ullBytesBefore)
+	{
+		ullBytes = ullBytesAfter - ullBytesBefore;
+	}
+
+	m_pjprof->Record(UlQueue(psc->UlWorker()), pj, ulTimeUS, ullBytes);
+
+	return fCompleted;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CScheduler::EjrPostExecute
@@ -502,11 +572,15 @@ CScheduler::EjrPostExecute
 //		CScheduler::PjRetrieve
 //
 //	@doc:
-//		Retrieve next runnable job from queue
+//		Retrieve next runnable job; the worker's own queue is tried first,
+//		then the queues of other workers
 //
 //---------------------------------------------------------------------------
 CJob *
-CScheduler::PjRetrieve()
+CScheduler::PjRetrieve
+	(
+	ULONG ulWorker
+	)
 {
 #ifdef GPOS_DEBUG
 	// restrict parallelism to keep track of jobs
@@ -518,7 +592,11 @@ CScheduler::PjRetrieve()
 #endif // GPOS_DEBUG
 
 	// retrieve runnable job from lists of waiting jobs
-	SJobLink *pjl = m_listjlWaiting.Pop();
+	SJobLink *pjl = PjlPop(ulWorker);
+	if (NULL == pjl)
+	{
+		pjl = PjlSteal(ulWorker);
+	}
 	CJob *pj = NULL;
 
 	if (NULL != pjl)
@@ -553,6 +631,80 @@ CScheduler::PjRetrieve()
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CScheduler::PjlPop
+//
+//	@doc:
+//		Pop the most recently queued job from the worker's own queue
+//
+//---------------------------------------------------------------------------
+CScheduler::SJobLink *
+CScheduler::PjlPop
+	(
+	ULONG ulWorker
+	)
+{
+	SWorkerQueue &wq = m_rgwq[UlQueue(ulWorker)];
+
+	// avoid taking the lock if the queue is empty
+	if (wq.m_listjl.FEmpty())
+	{
+		return NULL;
+	}
+
+	CAutoSpinlock as(wq.m_slock);
+	as.Lock();
+
+	if (wq.m_listjl.FEmpty())
+	{
+		return NULL;
+	}
+
+	return wq.m_listjl.RemoveTail();
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CScheduler::PjlSteal
+//
+//	@doc:
+//		Steal the oldest queued job from the queue of another worker;
+//		victims are probed round-robin starting after the calling worker
+//
+//---------------------------------------------------------------------------
+CScheduler::SJobLink *
+CScheduler::PjlSteal
+	(
+	ULONG ulWorker
+	)
+{
+	const ULONG ulQueues = (ULONG) m_ulpTasksMax;
+	const ULONG ulOwn = UlQueue(ulWorker);
+
+	for (ULONG ul = 1; ul < ulQueues; ul++)
+	{
+		SWorkerQueue &wq = m_rgwq[(ulOwn + ul) % ulQueues];
+		if (wq.m_listjl.FEmpty())
+		{
+			continue;
+		}
+
+		CAutoSpinlock as(wq.m_slock);
+		as.Lock();
+
+		if (!wq.m_listjl.FEmpty())
+		{
+			(void) UlpExchangeAdd(&m_ulpStatsStolen, 1);
+			return wq.m_listjl.RemoveHead();
+		}
+	}
+
+	return NULL;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CScheduler::Suspend
@@ -598,7 +750,8 @@ CScheduler::Suspend
 void
 CScheduler::Complete
 	(
-	CJob *pj
+	CJob *pj,
+	ULONG ulWorker
 	)
 {
 	GPOS_ASSERT(0 == pj->UlpRefs());
@@ -613,7 +766,7 @@ CScheduler::Complete
 	}
 #endif // GPOS_DEBUG
 
-	ResumeParent(pj);
+	ResumeParent(pj, ulWorker);
 
 	// update statistics
 	(void) UlpExchangeAdd(&m_ulpTotal, -1);
@@ -632,7 +785,8 @@ CScheduler::Complete
 void
 CScheduler::CompleteQueued
 	(
-	CJob *pj
+	CJob *pj,
+	ULONG ulWorker
 	)
 {
 	GPOS_ASSERT(0 == pj->UlpRefs());
@@ -651,7 +805,7 @@ CScheduler::CompleteQueued
 	}
 #endif // GPOS_DEBUG
 
-	ResumeParent(pj);
+	ResumeParent(pj, ulWorker);
 
 	// update statistics
 	(void) UlpExchangeAdd(&m_ulpTotal, -1);
@@ -671,7 +825,8 @@ CScheduler::CompleteQueued
 void
 CScheduler::ResumeParent
 	(
-	CJob *pj
+	CJob *pj,
+	ULONG ulWorker
 	)
 {
 	GPOS_ASSERT(0 == pj->UlpRefs());
@@ -692,7 +847,7 @@ CScheduler::ResumeParent
 #endif // GPOS_DEBUG)
 
 			// reschedule parent
-			Resume(pjParent);
+			Resume(pjParent, ulWorker);
 
 			// update statistics
 			(void) UlpExchangeAdd(&m_ulpStatsResumed, 1);
@@ -715,13 +870,16 @@ CScheduler::PrintStats() const
 	GPOS_TRACE_FORMAT
 		(
 		"Job statistics: Queued=%d Dequeued=%d Suspended=%d "
-		                "Resumed=%d CompletedQueued=%d Completed=%d",
+		                "Resumed=%d CompletedQueued=%d Completed=%d "
+		                "Stolen=%d Workers=%d",
 		m_ulpStatsQueued,
 		m_ulpStatsDequeued,
 		m_ulpStatsSuspended,
 		m_ulpStatsResumed,
 		m_ulpStatsCompletedQueued,
-		m_ulpStatsCompleted
+		m_ulpStatsCompleted,
+		m_ulpStatsStolen,
+		m_ulpTasksMax
 		);
 }
 
@@ -756,12 +914,19 @@ CScheduler::OsPrintActiveJobs
 	}
 
 	os << std::endl << "List of waiting jobs: " << std::endl;
-	
-	SJobLink *pjl = m_listjlWaiting.PtFirst();
-	while(NULL != pjl)
+
+	for (ULONG ul = 0; ul < m_ulpTasksMax; ul++)
 	{
-		pjl->m_pj->OsPrint(os);
-		pjl = m_listjlWaiting.PtNext(pjl);
+		SWorkerQueue &wq = m_rgwq[ul];
+		CAutoSpinlock as(wq.m_slock);
+		as.Lock();
+
+		SJobLink *pjl = wq.m_listjl.PtFirst();
+		while(NULL != pjl)
+		{
+			pjl->m_pj->OsPrint(os);
+			pjl = wq.m_listjl.PtNext(pjl);
+		}
 	}
 
 	os << std::endl << "List of suspended jobs: " << std::endl;
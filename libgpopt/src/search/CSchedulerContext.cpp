@@ -34,6 +34,7 @@ CSchedulerContext::CSchedulerContext()
 	m_pmpGlobal(NULL),
 	m_pmpLocal(NULL),
 	m_psched(NULL),
+	m_ulWorker(0),
 	m_fInit(false)
 {}
 
@@ -74,13 +75,15 @@ CSchedulerContext::Init
 	IMemoryPool *pmpGlobal,
 	CJobFactory *pjf,
 	CScheduler *psched,
-	CEngine *peng
+	CEngine *peng,
+	ULONG ulWorker
 	)
 {
 	GPOS_ASSERT(NULL != pmpGlobal);
 	GPOS_ASSERT(NULL != pjf);
 	GPOS_ASSERT(NULL != psched);
 	GPOS_ASSERT(NULL != peng);
+	GPOS_ASSERT(ulWorker < psched->UlWorkers());
 
 	GPOS_ASSERT(!FInit() && "Scheduling context is already initialized");
 
@@ -91,6 +94,7 @@ CSchedulerContext::Init
 	m_pjf = pjf;
 	m_psched = psched;
 	m_peng= peng;
+	m_ulWorker = ulWorker;
 	m_fInit = true;
 }
 
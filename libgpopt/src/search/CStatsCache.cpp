@@ -0,0 +1,157 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2018 Pivotal, Inc.
+//
+//	@filename:
+//		CStatsCache.cpp
+//
+//	@doc:
+//		Implementation of memo-wide stats cache
+//---------------------------------------------------------------------------
+
+#include "gpos/base.h"
+
+#include "gpopt/base/COptimizationContext.h"
+#include "gpopt/search/CStatsCache.h"
+
+using namespace gpopt;
+
+// number of buckets of the stats hash table
+#define GPOPT_STATS_CACHE_HT_BUCKETS	10000
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatsCache::SKey::UlHash
+//
+//	@doc:
+//		Hash function
+//
+//---------------------------------------------------------------------------
+ULONG
+CStatsCache::SKey::UlHash
+	(
+	const SKey *pkey
+	)
+{
+	return gpos::UlCombineHashes
+			(
+			gpos::UlHash<ULONG>(&pkey->m_ulGroupId),
+			COptimizationContext::UlHashForStats(pkey->m_poc)
+			);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatsCache::SKey::FEqual
+//
+//	@doc:
+//		Equality function
+//
+//---------------------------------------------------------------------------
+BOOL
+CStatsCache::SKey::FEqual
+	(
+	const SKey *pkeyFst,
+	const SKey *pkeySnd
+	)
+{
+	return
+		pkeyFst->m_ulGroupId == pkeySnd->m_ulGroupId &&
+		COptimizationContext::FEqualForStats(pkeyFst->m_poc, pkeySnd->m_poc);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatsCache::SKey::Destroy
+//
+//	@doc:
+//		Release key
+//
+//---------------------------------------------------------------------------
+void
+CStatsCache::SKey::Destroy
+	(
+	SKey *pkey
+	)
+{
+	pkey->m_poc->Release();
+	GPOS_DELETE(pkey);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatsCache::CStatsCache
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+CStatsCache::CStatsCache
+	(
+	IMemoryPool *pmp
+	)
+	:
+	m_pmp(pmp),
+	m_cache(pmp, GPOPT_STATS_CACHE_HT_BUCKETS)
+{}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatsCache::PstatsLookup
+//
+//	@doc:
+//		Lookup stats of a group under an optimization context
+//
+//---------------------------------------------------------------------------
+IStatistics *
+CStatsCache::PstatsLookup
+	(
+	ULONG ulGroupId,
+	COptimizationContext *poc
+	)
+{
+	GPOS_ASSERT(NULL != poc);
+
+	SKey key;
+	key.m_ulGroupId = ulGroupId;
+	key.m_poc = poc;
+
+	return m_cache.PtLookup(&key);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CStatsCache::PstatsInsert
+//
+//	@doc:
+//		Cache stats of a group under an optimization context; if another
+//		worker cached stats for the same key concurrently, keep the ones
+//		inserted first
+//
+//---------------------------------------------------------------------------
+IStatistics *
+CStatsCache::PstatsInsert
+	(
+	ULONG ulGroupId,
+	COptimizationContext *poc,
+	IStatistics *pstats
+	)
+{
+	GPOS_ASSERT(NULL != poc);
+	GPOS_ASSERT(NULL != pstats);
+
+	SKey *pkey = GPOS_NEW(m_pmp) SKey;
+	poc->AddRef();
+	pkey->m_ulGroupId = ulGroupId;
+	pkey->m_poc = poc;
+
+	return m_cache.PtInsert(pkey, pstats);
+}
+
+// EOF
@@ -11,6 +11,7 @@
 //		the caller is responsible for freeing it.
 //---------------------------------------------------------------------------
 
+#include "gpos/common/CAutoRef.h"
 #include "gpos/common/CAutoTimer.h"
 
 #include "naucrates/md/IMDId.h"
@@ -22,6 +23,8 @@
 #include "naucrates/md/CMDArrayCoerceCastGPDB.h"
 #include "naucrates/md/CMDRelationCtasGPDB.h"
 #include "naucrates/md/CMDProviderMemory.h"
+#include "naucrates/md/CMDIdRelStats.h"
+#include "naucrates/md/CMDIdColStats.h"
 
 #include "naucrates/dxl/operators/dxlops.h"
 
@@ -230,7 +233,10 @@ CTranslatorDXLToExpr::Pexpr
 	GPOS_ASSERT(NULL == m_phmulpdxlnCTEProducer);
 	GPOS_ASSERT(NULL != pdxln && NULL != pdxln->Pdxlop());
 	GPOS_ASSERT(NULL != pdrgpdxlnQueryOutput);
-	
+
+	// fetch the metadata of the query in batches before translating it
+	PrefetchMetadata(pdxln, pdrgpdxlnCTE);
+
 	m_phmulpdxlnCTEProducer = GPOS_NEW(m_pmp) HMUlPdxln(m_pmp);
 	const ULONG ulCTEs = pdrgpdxlnCTE->UlLength();
 	for (ULONG ul = 0; ul < ulCTEs; ul++)
@@ -329,6 +335,225 @@ CTranslatorDXLToExpr::Pexpr
 	return pexpr;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorDXLToExpr::AddMDId
+//
+//	@doc:
+//		Add a metadata id to a prefetch batch unless it is already there
+//
+//---------------------------------------------------------------------------
+void
+CTranslatorDXLToExpr::AddMDId
+	(
+	IMDId *pmdid,
+	HSMDId *phsmdid,
+	DrgPmdid *pdrgpmdid
+	)
+{
+	if (NULL == pmdid || !pmdid->FValid() || phsmdid->FExists(pmdid))
+	{
+		return;
+	}
+
+	pmdid->AddRef();
+	phsmdid->FInsert(pmdid);
+	pmdid->AddRef();
+	pdrgpmdid->Append(pmdid);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorDXLToExpr::CollectMDIds
+//
+//	@doc:
+//		Collect the ids of relations, types, operators and functions
+//		referenced by a DXL tree, together with the table descriptors and
+//		the ids of the columns referenced by scalar identifiers
+//
+//---------------------------------------------------------------------------
+void
+CTranslatorDXLToExpr::CollectMDIds
+	(
+	const CDXLNode *pdxln,
+	HSMDId *phsmdid,
+	DrgPmdid *pdrgpmdid,
+	DrgPdxltabdesc *pdrgpdxltabdesc,
+	HSUl *phsulColIds
+	)
+{
+	// recursive function - check stack
+	GPOS_CHECK_STACK_SIZE;
+	GPOS_ASSERT(NULL != pdxln);
+
+	CDXLOperator *pdxlop = pdxln->Pdxlop();
+	CDXLTableDescr *pdxltabdesc = NULL;
+
+	switch (pdxlop->Edxlop())
+	{
+		case EdxlopLogicalGet:
+		case EdxlopLogicalExternalGet:
+			pdxltabdesc = CDXLLogicalGet::PdxlopConvert(pdxlop)->Pdxltabdesc();
+			break;
+
+		case EdxlopLogicalInsert:
+			pdxltabdesc = CDXLLogicalInsert::PdxlopConvert(pdxlop)->Pdxltabdesc();
+			break;
+
+		case EdxlopLogicalDelete:
+			pdxltabdesc = CDXLLogicalDelete::PdxlopConvert(pdxlop)->Pdxltabdesc();
+			break;
+
+		case EdxlopLogicalUpdate:
+			pdxltabdesc = CDXLLogicalUpdate::PdxlopConvert(pdxlop)->Pdxltabdesc();
+			break;
+
+		case EdxlopLogicalTVF:
+			AddMDId(CDXLLogicalTVF::PdxlopConvert(pdxlop)->PmdidFunc(), phsmdid, pdrgpmdid);
+			AddMDId(CDXLLogicalTVF::PdxlopConvert(pdxlop)->PmdidRetType(), phsmdid, pdrgpmdid);
+			break;
+
+		case EdxlopScalarCmp:
+		case EdxlopScalarDistinct:
+			AddMDId(CDXLScalarComp::PdxlopConvert(pdxlop)->Pmdid(), phsmdid, pdrgpmdid);
+			break;
+
+		case EdxlopScalarOpExpr:
+			AddMDId(CDXLScalarOpExpr::PdxlopConvert(pdxlop)->Pmdid(), phsmdid, pdrgpmdid);
+			AddMDId(CDXLScalarOpExpr::PdxlopConvert(pdxlop)->PmdidReturnType(), phsmdid, pdrgpmdid);
+			break;
+
+		case EdxlopScalarFuncExpr:
+			AddMDId(CDXLScalarFuncExpr::PdxlopConvert(pdxlop)->PmdidFunc(), phsmdid, pdrgpmdid);
+			AddMDId(CDXLScalarFuncExpr::PdxlopConvert(pdxlop)->PmdidRetType(), phsmdid, pdrgpmdid);
+			break;
+
+		case EdxlopScalarCast:
+			AddMDId(CDXLScalarCast::PdxlopConvert(pdxlop)->PmdidType(), phsmdid, pdrgpmdid);
+			AddMDId(CDXLScalarCast::PdxlopConvert(pdxlop)->PmdidFunc(), phsmdid, pdrgpmdid);
+			break;
+
+		case EdxlopScalarAggref:
+			AddMDId(CDXLScalarAggref::PdxlopConvert(pdxlop)->PmdidAgg(), phsmdid, pdrgpmdid);
+			break;
+
+		case EdxlopScalarWindowRef:
+			AddMDId(CDXLScalarWindowRef::PdxlopConvert(pdxlop)->PmdidFunc(), phsmdid, pdrgpmdid);
+			AddMDId(CDXLScalarWindowRef::PdxlopConvert(pdxlop)->PmdidRetType(), phsmdid, pdrgpmdid);
+			break;
+
+		case EdxlopScalarNullIf:
+			AddMDId(CDXLScalarNullIf::PdxlopConvert(pdxlop)->PmdidOp(), phsmdid, pdrgpmdid);
+			AddMDId(CDXLScalarNullIf::PdxlopConvert(pdxlop)->PmdidType(), phsmdid, pdrgpmdid);
+			break;
+
+		case EdxlopScalarSubqueryAny:
+		case EdxlopScalarSubqueryAll:
+			AddMDId(CDXLScalarSubqueryQuantified::PdxlopConvert(pdxlop)->PmdidScalarOp(), phsmdid, pdrgpmdid);
+			break;
+
+		case EdxlopScalarIdent:
+		{
+			CDXLScalarIdent *pdxlopIdent = CDXLScalarIdent::PdxlopConvert(pdxlop);
+			AddMDId(pdxlopIdent->PmdidType(), phsmdid, pdrgpmdid);
+			ULONG ulColId = pdxlopIdent->Pdxlcr()->UlID();
+			if (!phsulColIds->FExists(&ulColId))
+			{
+				phsulColIds->FInsert(GPOS_NEW(m_pmp) ULONG(ulColId));
+			}
+			break;
+		}
+
+		default:
+			break;
+	}
+
+	if (NULL != pdxltabdesc && IMDId::EmdidGPDBCtas != pdxltabdesc->Pmdid()->Emdidt())
+	{
+		AddMDId(pdxltabdesc->Pmdid(), phsmdid, pdrgpmdid);
+		pdrgpdxltabdesc->Append(pdxltabdesc);
+
+		const ULONG ulCols = pdxltabdesc->UlArity();
+		for (ULONG ul = 0; ul < ulCols; ul++)
+		{
+			AddMDId(pdxltabdesc->Pdxlcd(ul)->PmdidType(), phsmdid, pdrgpmdid);
+		}
+	}
+
+	const ULONG ulArity = pdxln->UlArity();
+	for (ULONG ul = 0; ul < ulArity; ul++)
+	{
+		CollectMDIds((*pdxln)[ul], phsmdid, pdrgpmdid, pdrgpdxltabdesc, phsulColIds);
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorDXLToExpr::PrefetchMetadata
+//
+//	@doc:
+//		Fetch the metadata objects referenced by a DXL query in two batches:
+//		first relations, types, operators and functions, then the statistics
+//		of the referenced relations and columns, whose ids depend on the
+//		relation metadata fetched by the first batch
+//
+//---------------------------------------------------------------------------
+void
+CTranslatorDXLToExpr::PrefetchMetadata
+	(
+	const CDXLNode *pdxln,
+	const DrgPdxln *pdrgpdxlnCTE
+	)
+{
+	CAutoRef<HSMDId> a_phsmdid(GPOS_NEW(m_pmp) HSMDId(m_pmp));
+	CAutoRef<DrgPmdid> a_pdrgpmdid(GPOS_NEW(m_pmp) DrgPmdid(m_pmp));
+	CAutoRef<DrgPdxltabdesc> a_pdrgpdxltabdesc(GPOS_NEW(m_pmp) DrgPdxltabdesc(m_pmp));
+	CAutoRef<HSUl> a_phsulColIds(GPOS_NEW(m_pmp) HSUl(m_pmp));
+
+	CollectMDIds(pdxln, a_phsmdid.Pt(), a_pdrgpmdid.Pt(), a_pdrgpdxltabdesc.Pt(), a_phsulColIds.Pt());
+	const ULONG ulCTEs = pdrgpdxlnCTE->UlLength();
+	for (ULONG ul = 0; ul < ulCTEs; ul++)
+	{
+		CollectMDIds((*pdrgpdxlnCTE)[ul], a_phsmdid.Pt(), a_pdrgpmdid.Pt(), a_pdrgpdxltabdesc.Pt(), a_phsulColIds.Pt());
+	}
+
+	m_pmda->Prefetch(a_pdrgpmdid.Pt());
+
+	// statistics of the referenced relations and columns
+	CAutoRef<DrgPmdid> a_pdrgpmdidStats(GPOS_NEW(m_pmp) DrgPmdid(m_pmp));
+	const ULONG ulTables = a_pdrgpdxltabdesc->UlLength();
+	for (ULONG ulTable = 0; ulTable < ulTables; ulTable++)
+	{
+		CDXLTableDescr *pdxltabdesc = (*a_pdrgpdxltabdesc)[ulTable];
+		CMDIdGPDB *pmdidRel = CMDIdGPDB::PmdidConvert(pdxltabdesc->Pmdid());
+		const IMDRelation *pmdrel = m_pmda->Pmdrel(pmdidRel);
+
+		pmdidRel->AddRef();
+		CMDIdRelStats *pmdidRelStats = GPOS_NEW(m_pmp) CMDIdRelStats(pmdidRel);
+		AddMDId(pmdidRelStats, a_phsmdid.Pt(), a_pdrgpmdidStats.Pt());
+		pmdidRelStats->Release();
+
+		const ULONG ulCols = pdxltabdesc->UlArity();
+		for (ULONG ul = 0; ul < ulCols; ul++)
+		{
+			const CDXLColDescr *pdxlcd = pdxltabdesc->Pdxlcd(ul);
+			ULONG ulColId = pdxlcd->UlID();
+			if (0 >= pdxlcd->IAttno() || !a_phsulColIds->FExists(&ulColId))
+			{
+				continue;
+			}
+
+			pmdidRel->AddRef();
+			CMDIdColStats *pmdidColStats =
+					GPOS_NEW(m_pmp) CMDIdColStats(pmdidRel, pmdrel->UlPosFromAttno(pdxlcd->IAttno()));
+			AddMDId(pmdidColStats, a_phsmdid.Pt(), a_pdrgpmdidStats.Pt());
+			pmdidColStats->Release();
+		}
+	}
+
+	m_pmda->Prefetch(a_pdrgpmdidStats.Pt());
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CTranslatorDXLToExpr::PexprTranslateQuery
@@ -78,6 +78,7 @@ CTranslatorExprToDXL::CTranslatorExprToDXL
 	:
 	m_pmp(pmp),
 	m_pmda(pmda),
+	m_pdxlnTrue(NULL),
 	m_pdpplan(NULL),
 	m_pcf(NULL),
 	m_pdrgpiSegments(pdrgpiSegments),
@@ -95,6 +96,8 @@ CTranslatorExprToDXL::CTranslatorExprToDXL
 
 	m_phmcrdxlnIndexLookup = GPOS_NEW(m_pmp) HMCrDxln(m_pmp);
 
+	m_phmexprdxln = GPOS_NEW(m_pmp) HMExprDxln(m_pmp);
+
 	if (fInitColumnFactory)
 	{
 		// get column factory from optimizer context object
@@ -116,6 +119,8 @@ CTranslatorExprToDXL::~CTranslatorExprToDXL()
 	CRefCount::SafeRelease(m_pdrgpiSegments);
 	m_phmcrdxln->Release();
 	m_phmcrdxlnIndexLookup->Release();
+	m_phmexprdxln->Release();
+	CRefCount::SafeRelease(m_pdxlnTrue);
 	CRefCount::SafeRelease(m_pdpplan);
 }
 
@@ -429,8 +434,93 @@ CTranslatorExprToDXL::PdxlnScalar
 	{
 		GPOS_RAISE(gpopt::ExmaGPOPT, gpopt::ExmiUnsupportedOp, pexpr->Pop()->SzId());
 	}
-	
-	return (this->* pf)(pexpr);
+
+	// leaves are cheaper to translate than to look up
+	if (0 == pexpr->UlArity() || !FInternable(pexpr))
+	{
+		return (this->* pf)(pexpr);
+	}
+
+	CDXLNode *pdxln = m_phmexprdxln->PtLookup(pexpr);
+	if (NULL == pdxln)
+	{
+		pdxln = (this->* pf)(pexpr);
+		pexpr->AddRef();
+		pdxln->AddRef();
+#ifdef GPOS_DEBUG
+		BOOL fInserted =
+#endif // GPOS_DEBUG
+			m_phmexprdxln->FInsert(pexpr, pdxln);
+		GPOS_ASSERT(fInserted);
+	}
+
+	pdxln->AddRef();
+	return pdxln;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorExprToDXL::FInternable
+//
+//	@doc:
+//		Can the translation of the given scalar expression be shared with all
+//		equal scalar expressions translated afterwards; this is the case if
+//		the translation only depends on the expression itself, which excludes
+//		subqueries and columns translated to subplans or index lookups, since
+//		these depend on the state of the translation
+//
+//---------------------------------------------------------------------------
+BOOL
+CTranslatorExprToDXL::FInternable
+	(
+	CExpression *pexpr
+	)
+	const
+{
+	GPOS_CHECK_STACK_SIZE;
+
+	COperator *pop = pexpr->Pop();
+	if (!pop->FScalar())
+	{
+		return false;
+	}
+
+	if (COperator::EopScalarIdent == pop->Eopid())
+	{
+		const CColRef *pcr = CScalarIdent::PopConvert(pop)->Pcr();
+		return NULL == m_phmcrdxln->PtLookup(pcr) && NULL == m_phmcrdxlnIndexLookup->PtLookup(pcr);
+	}
+
+	const ULONG ulArity = pexpr->UlArity();
+	for (ULONG ul = 0; ul < ulArity; ul++)
+	{
+		if (!FInternable((*pexpr)[ul]))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CTranslatorExprToDXL::PdxlnTrue
+//
+//	@doc:
+//		Shared DXL true constant
+//
+//---------------------------------------------------------------------------
+CDXLNode *
+CTranslatorExprToDXL::PdxlnTrue()
+{
+	if (NULL == m_pdxlnTrue)
+	{
+		m_pdxlnTrue = CTranslatorExprToDXLUtils::PdxlnBoolConst(m_pmp, m_pmda, true /*fVal*/);
+	}
+
+	m_pdxlnTrue->AddRef();
+	return m_pdxlnTrue;
 }
 
 //---------------------------------------------------------------------------
@@ -4278,7 +4368,7 @@ CTranslatorExprToDXL::PdxlnPartitionSelectorDML
 	CDXLNode *pdxlnPropagation = GPOS_NEW(m_pmp) CDXLNode(m_pmp, GPOS_NEW(m_pmp) CDXLScalarConstValue(m_pmp, pdxldatumNull));
 
 	// true printable filter
-	CDXLNode *pdxlnPrintable = CTranslatorExprToDXLUtils::PdxlnBoolConst(m_pmp, m_pmda, true /*fVal*/);
+	CDXLNode *pdxlnPrintable = PdxlnTrue();
 
 	// construct PartitionSelector node
 	IMDId *pmdidRel = popSelector->Pmdid();
@@ -4354,7 +4444,7 @@ CTranslatorExprToDXL::PdxlnPartFilterList
 		CDXLNode *pdxlnFilter = NULL;
 		if (NULL == pexprFilter)
 		{
-			pdxlnFilter = CTranslatorExprToDXLUtils::PdxlnBoolConst(m_pmp, m_pmda, true /*fVal*/);
+			pdxlnFilter = PdxlnTrue();
 		}
 		else
 		{
@@ -4707,7 +4797,7 @@ CTranslatorExprToDXL::TranslatePartitionFilters
 		CExpression *pexprResidual = popSelector->PexprResidualPred();
 		if (NULL == pexprResidual)
 		{
-			*ppdxlnResidual = CTranslatorExprToDXLUtils::PdxlnBoolConst(m_pmp, m_pmda, true /*fVal*/);
+			*ppdxlnResidual = PdxlnTrue();
 		}
 		else
 		{
@@ -4722,7 +4812,7 @@ CTranslatorExprToDXL::TranslatePartitionFilters
 	// TODO:  - Apr 11, 2014; translate the residual filter. Take into account
 	// that this might be an arbitrary scalar expression on multiple part keys. Right
 	// now we assume no residual filter in this case
-	*ppdxlnResidual = CTranslatorExprToDXLUtils::PdxlnBoolConst(m_pmp, m_pmda, true /*fVal*/);
+	*ppdxlnResidual = PdxlnTrue();
 }
 
 //---------------------------------------------------------------------------
@@ -4864,11 +4954,11 @@ CTranslatorExprToDXL::ConstructLevelFilters4PartitionSelector
 
 		if (NULL == pdxlnFilter)
 		{
-			pdxlnFilter = CTranslatorExprToDXLUtils::PdxlnBoolConst(m_pmp, m_pmda, true /*fVal*/);
+			pdxlnFilter = PdxlnTrue();
 		}
 
 		(*ppdxlnFilters)->AddChild(pdxlnFilter);
-		(*ppdxlnEqFilters)->AddChild(CTranslatorExprToDXLUtils::PdxlnBoolConst(m_pmp, m_pmda, true /*fVal*/));
+		(*ppdxlnEqFilters)->AddChild(PdxlnTrue());
 	}
 
 	if (NULL != pbsDefaultParts)
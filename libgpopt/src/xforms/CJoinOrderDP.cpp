@@ -29,90 +29,45 @@
 
 using namespace gpopt;
 
-#define GPOPT_DP_JOIN_ORDERING_TOPK	10
-
 //---------------------------------------------------------------------------
 //	@function:
-//		CJoinOrderDP::SComponentPair::SComponentPair
+//		CJoinOrderDP::SDPEntry::SDPEntry
 //
 //	@doc:
 //		Ctor
 //
 //---------------------------------------------------------------------------
-CJoinOrderDP::SComponentPair::SComponentPair
+CJoinOrderDP::SDPEntry::SDPEntry
 	(
-	CBitSet *pbsFst,
-	CBitSet *pbsSnd
+	ULLONG ullSet,
+	ULLONG ullOuter,
+	ULLONG ullInner,
+	CDouble dCost
 	)
 	:
-	m_pbsFst(pbsFst),
-	m_pbsSnd(pbsSnd)
-{
-	GPOS_ASSERT(NULL != pbsFst);
-	GPOS_ASSERT(NULL != pbsSnd);
-	GPOS_ASSERT(pbsFst->FDisjoint(pbsSnd));
-}
-
-
-//---------------------------------------------------------------------------
-//	@function:
-//		CJoinOrderDP::SComponentPair::UlHash
-//
-//	@doc:
-//		Hash function
-//
-//---------------------------------------------------------------------------
-ULONG
-CJoinOrderDP::SComponentPair::UlHash
-	(
-	const SComponentPair *pcomppair
-	)
+	m_ullSet(ullSet),
+	m_ullOuter(ullOuter),
+	m_ullInner(ullInner),
+	m_dCost(dCost),
+	m_pexpr(NULL)
 {
-	GPOS_ASSERT(NULL != pcomppair);
-
-	return UlCombineHashes
-			(
-			pcomppair->m_pbsFst->UlHash(),
-			pcomppair->m_pbsSnd->UlHash()
-			);
+	GPOS_ASSERT(0 != ullSet);
+	GPOS_ASSERT(0 == (ullOuter & ullInner));
+	GPOS_ASSERT_IMP(0 != ullOuter, ullSet == (ullOuter | ullInner));
 }
 
 
 //---------------------------------------------------------------------------
 //	@function:
-//		CJoinOrderDP::SComponentPair::FEqual
-//
-//	@doc:
-//		Equality function
-//
-//---------------------------------------------------------------------------
-BOOL
-CJoinOrderDP::SComponentPair::FEqual
-	(
-	const SComponentPair *pcomppairFst,
-	const SComponentPair *pcomppairSnd
-	)
-{
-	GPOS_ASSERT(NULL != pcomppairFst);
-	GPOS_ASSERT(NULL != pcomppairSnd);
-
-	return pcomppairFst->m_pbsFst->FEqual(pcomppairSnd->m_pbsFst) &&
-		pcomppairFst->m_pbsSnd->FEqual(pcomppairSnd->m_pbsSnd);
-}
-
-
-//---------------------------------------------------------------------------
-//	@function:
-//		CJoinOrderDP::SComponentPair::~SComponentPair
+//		CJoinOrderDP::SDPEntry::~SDPEntry
 //
 //	@doc:
 //		Dtor
 //
 //---------------------------------------------------------------------------
-CJoinOrderDP::SComponentPair::~SComponentPair()
+CJoinOrderDP::SDPEntry::~SDPEntry()
 {
-	m_pbsFst->Release();
-	m_pbsSnd->Release();
+	CRefCount::SafeRelease(m_pexpr);
 }
 
 
@@ -131,21 +86,62 @@ CJoinOrderDP::CJoinOrderDP
 	DrgPexpr *pdrgpexprConjuncts
 	)
 	:
-	CJoinOrder(pmp, pdrgpexprComponents, pdrgpexprConjuncts)
+	CJoinOrder(pmp, pdrgpexprComponents, pdrgpexprConjuncts),
+	m_phmullentry(NULL),
+	m_ullAll(0),
+	m_rgullNeighbors(NULL),
+	m_rgullEdges(NULL),
+	m_ulTopK(0),
+	m_pdrgpexprTopKOrders(NULL),
+	m_ulPairs(0)
 {
-	m_phmcomplink = GPOS_NEW(pmp) HMCompLink(pmp);
-	m_phmbsexpr = GPOS_NEW(pmp) HMBSExpr(pmp);
-	m_phmexprcost = GPOS_NEW(pmp) HMExprCost(pmp);
+	GPOS_ASSERT(GPOPT_DP_JOIN_ORDERING_MAX_COMPS >= m_ulComps);
+
+	m_phmullentry = GPOS_NEW(pmp) HMUllEntry(pmp);
 	m_pdrgpexprTopKOrders = GPOS_NEW(pmp) DrgPexpr(pmp);
-	m_pexprDummy = GPOS_NEW(pmp) CExpression(pmp, GPOS_NEW(pmp) CPatternLeaf(pmp));
+	m_rgullNeighbors = GPOS_NEW_ARRAY(pmp, ULLONG, m_ulComps);
+	m_rgullEdges = GPOS_NEW_ARRAY(pmp, ULLONG, m_ulEdges);
 
-#ifdef GPOS_DEBUG
+	// single components are the leaves of the DP table; their cost is their
+	// estimated number of rows
 	for (ULONG ul = 0; ul < m_ulComps; ul++)
 	{
-		GPOS_ASSERT(NULL != m_rgpcomp[ul]->m_pexpr->Pstats() &&
+		CExpression *pexpr = m_rgpcomp[ul]->m_pexpr;
+		GPOS_ASSERT(NULL != pexpr->Pstats() &&
 				"stats were not derived on input component");
-	}
+
+		const ULLONG ullComp = UllSingleton(ul);
+		m_ullAll |= ullComp;
+		m_rgullNeighbors[ul] = 0;
+
+		SDPEntry *pentry = GPOS_NEW(pmp) SDPEntry(ullComp, 0 /*ullOuter*/, 0 /*ullInner*/, pexpr->Pstats()->DRows());
+		pexpr->AddRef();
+		pentry->m_pexpr = pexpr;
+#ifdef GPOS_DEBUG
+		BOOL fInserted =
 #endif // GPOS_DEBUG
+			m_phmullentry->FInsert(&pentry->m_ullSet, pentry);
+		GPOS_ASSERT(fInserted);
+	}
+
+	// components covered by the same edge are adjacent; edges covering more
+	// than two components connect each pair of them
+	for (ULONG ulEdge = 0; ulEdge < m_ulEdges; ulEdge++)
+	{
+		ULLONG ullEdge = 0;
+		CBitSetIter bsi(*m_rgpedge[ulEdge]->m_pbs);
+		while (bsi.FAdvance())
+		{
+			ullEdge |= UllSingleton(bsi.UlBit());
+		}
+		m_rgullEdges[ulEdge] = ullEdge;
+
+		for (ULLONG ull = ullEdge; 0 != ull; ull &= ull - 1)
+		{
+			const ULONG ulComp = CBitSet::UlLowestBit(ull);
+			m_rgullNeighbors[ulComp] |= ullEdge & ~UllSingleton(ulComp);
+		}
+	}
 }
 
 
@@ -163,180 +159,128 @@ CJoinOrderDP::~CJoinOrderDP()
 	// in optimized build, we flush-down memory pools without leak checking,
 	// we can save time in optimized build by skipping all de-allocations here,
 	// we still have all de-llocations enabled in debug-build to detect any possible leaks
-	m_phmcomplink->Release();
-	m_phmbsexpr->Release();
-	m_phmexprcost->Release();
+	m_phmullentry->Release();
 	m_pdrgpexprTopKOrders->Release();
-	m_pexprDummy->Release();
+	GPOS_DELETE_ARRAY(m_rgullNeighbors);
+	GPOS_DELETE_ARRAY(m_rgullEdges);
 #endif // GPOS_DEBUG
 }
 
 
 //---------------------------------------------------------------------------
 //	@function:
-//		CJoinOrderDP::AddJoinOrder
+//		CJoinOrderDP::UllNeighbors
 //
 //	@doc:
-//		Add given join order to top k join orders
+//		Components adjacent to the given set, excluding the set itself and
+//		the given components
 //
 //---------------------------------------------------------------------------
-void
-CJoinOrderDP::AddJoinOrder
+ULLONG
+CJoinOrderDP::UllNeighbors
 	(
-	CExpression *pexprJoin,
-	CDouble dCost
+	ULLONG ullSet,
+	ULLONG ullExclude
 	)
+	const
 {
-	GPOS_ASSERT(NULL != pexprJoin);
-	GPOS_ASSERT(NULL != m_pdrgpexprTopKOrders);
-
-	// length of the array will not be more than 10
-	INT ulResults = m_pdrgpexprTopKOrders->UlLength();
-	INT iReplacePos = -1;
-	BOOL fAddJoinOrder = false;
-	if (ulResults < GPOPT_DP_JOIN_ORDERING_TOPK)
-	{
-		// we have less than K results, always add the given expression
-		fAddJoinOrder = true;
-	}
-	else
+	ULLONG ullNeighbors = 0;
+	for (ULLONG ull = ullSet; 0 != ull; ull &= ull - 1)
 	{
-		CDouble dmaxCost = 0.0;
-		// we have stored K expressions, evict worst expression
-		for (INT ul = 0; ul < ulResults; ul++)
-		{
-			CExpression *pexpr = (*m_pdrgpexprTopKOrders)[ul];
-			CDouble *pd = m_phmexprcost->PtLookup(pexpr);
-			GPOS_ASSERT(NULL != pd);
-
-			if (dmaxCost < *pd && dCost < *pd)
-			{
-				// found a worse expression
-				dmaxCost = *pd;
-				fAddJoinOrder = true;
-				iReplacePos = ul;
-			}
-		}
+		ullNeighbors |= m_rgullNeighbors[CBitSet::UlLowestBit(ull)];
 	}
 
-	if (fAddJoinOrder)
-	{
-		pexprJoin->AddRef();
-		if (iReplacePos > -1)
-		{
-			m_pdrgpexprTopKOrders->Replace((ULONG) iReplacePos, pexprJoin);
-		}
-		else
-		{
-			m_pdrgpexprTopKOrders->Append(pexprJoin);
-		}
-
-		InsertExpressionCost(pexprJoin, dCost, false /*fValidateInsert*/);
-	}
+	return ullNeighbors & ~(ullSet | ullExclude);
 }
 
 
 //---------------------------------------------------------------------------
 //	@function:
-//		CJoinOrderDP::PexprLookup
+//		CJoinOrderDP::AddJoinOrder
 //
 //	@doc:
-//		Lookup best join order for given set
+//		Add given join to top k joins covering all components
 //
 //---------------------------------------------------------------------------
-CExpression *
-CJoinOrderDP::PexprLookup
+void
+CJoinOrderDP::AddJoinOrder
 	(
-	CBitSet *pbs
+	ULLONG ullOuter,
+	ULLONG ullInner,
+	CDouble dCost
 	)
 {
-	// if set has size 1, return expression directly
-	if (1 == pbs->CElements())
+	GPOS_ASSERT(m_ullAll == (ullOuter | ullInner));
+
+	ULONG ulPos = m_ulTopK;
+	if (GPOPT_DP_JOIN_ORDERING_TOPK == m_ulTopK)
 	{
-		CBitSetIter bsi(*pbs);
-		(void) bsi.FAdvance();
+		// we have stored K joins, evict the worst join that is worse than the given one
+		CDouble dMaxCost = dCost;
+		for (ULONG ul = 0; ul < m_ulTopK; ul++)
+		{
+			if (dMaxCost < m_rgjoTopK[ul].m_dCost)
+			{
+				dMaxCost = m_rgjoTopK[ul].m_dCost;
+				ulPos = ul;
+			}
+		}
 
-		return m_rgpcomp[bsi.UlBit()]->m_pexpr;
+		if (GPOPT_DP_JOIN_ORDERING_TOPK == ulPos)
+		{
+			return;
+		}
+	}
+	else
+	{
+		m_ulTopK++;
 	}
 
-	// otherwise, return expression by looking up DP table
-	return m_phmbsexpr->PtLookup(pbs);
+	m_rgjoTopK[ulPos].m_ullOuter = ullOuter;
+	m_rgjoTopK[ulPos].m_ullInner = ullInner;
+	m_rgjoTopK[ulPos].m_dCost = dCost;
 }
 
 
 //---------------------------------------------------------------------------
 //	@function:
-//		CJoinOrderDP::PexprPred
+//		CJoinOrderDP::PexprBuildPred
 //
 //	@doc:
-//		Extract predicate joining the two given sets
+//		Build predicate connecting the two given sets; returns NULL if no
+//		edge within the union of the sets touches both sets
 //
 //---------------------------------------------------------------------------
 CExpression *
-CJoinOrderDP::PexprPred
+CJoinOrderDP::PexprBuildPred
 	(
-	CBitSet *pbsFst,
-	CBitSet *pbsSnd
+	ULLONG ullOuter,
+	ULLONG ullInner
 	)
 {
-	GPOS_ASSERT(NULL != pbsFst);
-	GPOS_ASSERT(NULL != pbsSnd);
-
-	if (!pbsFst->FDisjoint(pbsSnd) || 0 == pbsFst->CElements() || 0 == pbsSnd->CElements())
-	{
-		// components must be non-empty and disjoint
-		return NULL;
-	}
+	const ULLONG ullSet = ullOuter | ullInner;
 
-	CExpression *pexprPred = NULL;
-	SComponentPair *pcomppair = NULL;
-
-	// lookup link map
-	for (ULONG ul = 0; ul < 2; ul++)
+	DrgPexpr *pdrgpexpr = NULL;
+	for (ULONG ul = 0; ul < m_ulEdges; ul++)
 	{
-		pbsFst->AddRef();
-		pbsSnd->AddRef();
-		pcomppair = GPOS_NEW(m_pmp) SComponentPair(pbsFst, pbsSnd);
-		pexprPred = m_phmcomplink->PtLookup(pcomppair);
-		if (NULL != pexprPred)
+		const ULLONG ullEdge = m_rgullEdges[ul];
+		if (ullEdge == (ullEdge & ullSet) && 0 != (ullEdge & ullOuter) && 0 != (ullEdge & ullInner))
 		{
-			pcomppair->Release();
-			if (m_pexprDummy == pexprPred)
+			if (NULL == pdrgpexpr)
 			{
-				return NULL;
+				pdrgpexpr = GPOS_NEW(m_pmp) DrgPexpr(m_pmp);
 			}
-			return pexprPred;
-		}
-
-		// try again after swapping sets
-		if (0 == ul)
-		{
-			pcomppair->Release();
-			std::swap(pbsFst, pbsSnd);
+			m_rgpedge[ul]->m_pexpr->AddRef();
+			pdrgpexpr->Append(m_rgpedge[ul]->m_pexpr);
 		}
 	}
 
-	// could not find link in the map, construct it from edge set
-	pexprPred = PexprBuildPred(pbsFst, pbsSnd);
-	if (NULL == pexprPred)
+	if (NULL == pdrgpexpr)
 	{
-		m_pexprDummy->AddRef();
-		pexprPred = m_pexprDummy;
-	}
-
-	// store predicate in link map
-#ifdef GPOS_DEBUG
-	BOOL fInserted =
-#endif // GPOS_DEBUG
-		m_phmcomplink->FInsert(pcomppair, pexprPred);
-	GPOS_ASSERT(fInserted);
-
-	if (m_pexprDummy != pexprPred)
-	{
-		return pexprPred;
+		return NULL;
 	}
 
-	return NULL;
+	return CPredicateUtils::PexprConjunction(m_pmp, pdrgpexpr);
 }
 
 
@@ -345,407 +289,266 @@ CJoinOrderDP::PexprPred
 //		CJoinOrderDP::PexprJoin
 //
 //	@doc:
-//		Join expressions in the given two sets
+//		Join the best join orders of the given two sets; sets that are only
+//		adjacent through an edge covering components outside of both sets
+//		are cross joined
 //
 //---------------------------------------------------------------------------
 CExpression *
 CJoinOrderDP::PexprJoin
 	(
-	CBitSet *pbsFst,
-	CBitSet *pbsSnd
+	ULLONG ullOuter,
+	ULLONG ullInner
 	)
 {
-	GPOS_ASSERT(NULL != pbsFst);
-	GPOS_ASSERT(NULL != pbsSnd);
-
-	CExpression *pexprFst = PexprLookup(pbsFst);
-	GPOS_ASSERT(NULL != pexprFst);
+	CExpression *pexprOuter = PexprBest(PentryLookup(ullOuter));
+	CExpression *pexprInner = PexprBest(PentryLookup(ullInner));
 
-	CExpression *pexprSnd = PexprLookup(pbsSnd);
-	GPOS_ASSERT(NULL != pexprSnd);
-
-	CExpression *pexprScalar = PexprPred(pbsFst, pbsSnd);
-	GPOS_ASSERT(NULL != pexprScalar);
+	CExpression *pexprScalar = PexprBuildPred(ullOuter, ullInner);
+	if (NULL == pexprScalar)
+	{
+		pexprScalar = CPredicateUtils::PexprConjunction(m_pmp, NULL /*pdrgpexpr*/);
+	}
 
-	pexprFst->AddRef();
-	pexprSnd->AddRef();
-	pexprScalar->AddRef();
+	pexprOuter->AddRef();
+	pexprInner->AddRef();
 
-	return CUtils::PexprLogicalJoin<CLogicalInnerJoin>(m_pmp, pexprFst, pexprSnd, pexprScalar);
+	return CUtils::PexprLogicalJoin<CLogicalInnerJoin>(m_pmp, pexprOuter, pexprInner, pexprScalar);
 }
 
 
 //---------------------------------------------------------------------------
 //	@function:
-//		CJoinOrderDP::DeriveStats
+//		CJoinOrderDP::PexprBest
 //
 //	@doc:
-//		Derive stats on given expression
+//		Best join order of a set; the join expression is built, and its
+//		stats derived, on first use; by then the entry holds the best split
 //
 //---------------------------------------------------------------------------
-void
-CJoinOrderDP::DeriveStats
+CExpression *
+CJoinOrderDP::PexprBest
 	(
-	CExpression *pexpr
+	SDPEntry *pentry
 	)
 {
-	GPOS_ASSERT(NULL != pexpr);
+	GPOS_CHECK_STACK_SIZE;
+	GPOS_ASSERT(NULL != pentry);
 
-	if (m_pexprDummy != pexpr && NULL == pexpr->Pstats())
+	if (NULL == pentry->m_pexpr)
 	{
-		CExpressionHandle exprhdl(m_pmp);
-		exprhdl.Attach(pexpr);
-		exprhdl.DeriveStats(m_pmp, m_pmp, NULL /*prprel*/, NULL /*pdrgpstatCtxt*/);
+		pentry->m_pexpr = PexprJoin(pentry->m_ullOuter, pentry->m_ullInner);
+		DeriveStats(pentry->m_pexpr);
 	}
+
+	return pentry->m_pexpr;
 }
 
+
 //---------------------------------------------------------------------------
 //	@function:
-//		CJoinOrderDP::InsertExpressionCost
+//		CJoinOrderDP::DRows
 //
 //	@doc:
-//		Add expression to cost map
+//		Estimated number of rows of the best join order of a set
 //
 //---------------------------------------------------------------------------
-void
-CJoinOrderDP::InsertExpressionCost
+CDouble
+CJoinOrderDP::DRows
 	(
-	CExpression *pexpr,
-	CDouble dCost,
-	BOOL fValidateInsert // if true, insertion must succeed
+	SDPEntry *pentry
 	)
 {
-	GPOS_ASSERT(NULL != pexpr);
-
-	if (m_pexprDummy == pexpr)
-	{
-		// ignore dummy expression
-		return;
-	}
-
-	if (!fValidateInsert && NULL != m_phmexprcost->PtLookup(pexpr))
-	{
-		// expression already exists in cost map
-		return;
-	}
-
-	pexpr->AddRef();
-#ifdef GPOS_DEBUG
-	BOOL fInserted =
-#endif // GPOS_DEBUG
-		m_phmexprcost->FInsert(pexpr, GPOS_NEW(m_pmp) CDouble(dCost));
-	GPOS_ASSERT(fInserted);
+	return PexprBest(pentry)->Pstats()->DRows();
 }
 
 
 //---------------------------------------------------------------------------
 //	@function:
-//		CJoinOrderDP::PexprJoin
+//		CJoinOrderDP::DeriveStats
 //
 //	@doc:
-//		Join expressions in the given set
+//		Derive stats on given expression
 //
 //---------------------------------------------------------------------------
-CExpression *
-CJoinOrderDP::PexprJoin
+void
+CJoinOrderDP::DeriveStats
 	(
-	CBitSet *pbs
+	CExpression *pexpr
 	)
 {
-	GPOS_ASSERT(2 == pbs->CElements());
-
-	CBitSetIter bsi(*pbs);
-	(void) bsi.FAdvance();
-	ULONG ulCompFst = bsi.UlBit();
-	(void) bsi.FAdvance();
-	ULONG ulCompSnd = bsi.UlBit();
-	GPOS_ASSERT(!bsi.FAdvance());
-
-	CBitSet *pbsFst = GPOS_NEW(m_pmp) CBitSet(m_pmp);
-	(void) pbsFst->FExchangeSet(ulCompFst);
-	CBitSet *pbsSnd = GPOS_NEW(m_pmp) CBitSet(m_pmp);
-	(void) pbsSnd->FExchangeSet(ulCompSnd);
-	CExpression *pexprScalar = PexprPred(pbsFst, pbsSnd);
-	pbsFst->Release();
-	pbsSnd->Release();
+	GPOS_ASSERT(NULL != pexpr);
 
-	if (NULL == pexprScalar)
+	if (NULL == pexpr->Pstats())
 	{
-		return NULL;
+		CExpressionHandle exprhdl(m_pmp);
+		exprhdl.Attach(pexpr);
+		exprhdl.DeriveStats(m_pmp, m_pmp, NULL /*prprel*/, NULL /*pdrgpstatCtxt*/);
 	}
-
-	CExpression *pexprLeft = m_rgpcomp[ulCompFst]->m_pexpr;
-	CExpression *pexprRight = m_rgpcomp[ulCompSnd]->m_pexpr;
-	pexprLeft->AddRef();
-	pexprRight->AddRef();
-	pexprScalar->AddRef();
-	CExpression *pexprJoin =
-		CUtils::PexprLogicalJoin<CLogicalInnerJoin>(m_pmp, pexprLeft, pexprRight, pexprScalar);
-
-	DeriveStats(pexprJoin);
-	// store solution in DP table
-	pbs->AddRef();
-#ifdef GPOS_DEBUG
-	BOOL fInserted =
-#endif // GPOS_DEBUG
-		m_phmbsexpr->FInsert(pbs, pexprJoin);
-	GPOS_ASSERT(fInserted);
-
-	return pexprJoin;
 }
 
 
 //---------------------------------------------------------------------------
 //	@function:
-//		CJoinOrderDP::PexprBestJoinOrderDP
+//		CJoinOrderDP::EmitCsgCmp
 //
 //	@doc:
-//		Find the best join order of a given set of elements using dynamic
-//		programming;
-//		given a set of elements (e.g., {A, B, C}), we find all possible splits
-//		of the set (e.g., {A}, {B, C}) where at least one edge connects the
-//		two subsets resulting from the split,
-//		for each split, we find the best join orders of left and right subsets
-//		recursively,
-//		the function finds the split with the least cost, and stores the join
-//		of its two subsets as the best join order of the given set
-//
+//		Consider joining a connected set with a connected complement;
+//		primitive costing: the cost of a join is the cost of its children
+//		plus their estimated number of rows, the cost of a single component
+//		is its estimated number of rows;
+//		DPccp emits pairs in an order where the best join orders of both
+//		sets are final
 //
 //---------------------------------------------------------------------------
-CExpression *
-CJoinOrderDP::PexprBestJoinOrderDP
+void
+CJoinOrderDP::EmitCsgCmp
 	(
-	CBitSet *pbs // set of elements to be joined
+	ULLONG ullCsg,
+	ULLONG ullCmp
 	)
 {
-	CDouble dMinCost(0.0);
-	CExpression *pexprResult = NULL;
+	GPOS_ASSERT(0 == (ullCsg & ullCmp));
 
-	DrgPbs *pdrgpbsSubsets = PdrgpbsSubsets(m_pmp, pbs);
-	const ULONG ulSubsets = pdrgpbsSubsets->UlLength();
-	for (ULONG ul = 0; ul < ulSubsets; ul++)
-	{
-		CBitSet *pbsCurrent = (*pdrgpbsSubsets)[ul];
-		CBitSet *pbsRemaining = GPOS_NEW(m_pmp) CBitSet(m_pmp, *pbs);
-		pbsRemaining->Difference(pbsCurrent);
+	m_ulPairs++;
 
-		// check if subsets are connected with one or more edges
-		CExpression *pexprPred = PexprPred(pbsCurrent, pbsRemaining);
-		if (NULL != pexprPred)
-		{
-			// compute solutions of left and right subsets recursively
-			CExpression *pexprLeft = PexprBestJoinOrder(pbsCurrent);
-			CExpression *pexprRight = PexprBestJoinOrder(pbsRemaining);
+	SDPEntry *pentryCsg = PentryLookup(ullCsg);
+	SDPEntry *pentryCmp = PentryLookup(ullCmp);
+	GPOS_ASSERT(NULL != pentryCsg && NULL != pentryCmp);
 
-			if (NULL != pexprLeft && NULL != pexprRight)
-			{
-				// we found solutions of left and right subsets, we check if
-				// this gives a better solution for the input set
-				CExpression *pexprJoin = PexprJoin(pbsCurrent, pbsRemaining);
-				CDouble dCost = DCost(pexprJoin);
-
-				if (NULL == pexprResult || dCost < dMinCost)
-				{
-					// this is the first solution, or we found a better solution
-					dMinCost = dCost;
-					CRefCount::SafeRelease(pexprResult);
-					pexprJoin->AddRef();
-					pexprResult = pexprJoin;
-				}
-
-				if (m_ulComps == pbs->CElements())
-				{
-					AddJoinOrder(pexprJoin, dCost);
-				}
-
-				pexprJoin->Release();
-			}
-		}
-		pbsRemaining->Release();
-	}
-	pdrgpbsSubsets->Release();
+	CDouble dCost = pentryCsg->m_dCost + pentryCmp->m_dCost + DRows(pentryCsg) + DRows(pentryCmp);
 
-	// store solution in DP table
-	if (NULL == pexprResult)
+	const ULLONG ullSet = ullCsg | ullCmp;
+	SDPEntry *pentry = PentryLookup(ullSet);
+	if (NULL == pentry)
 	{
-		m_pexprDummy->AddRef();
-		pexprResult = m_pexprDummy;
-	}
-
-	DeriveStats(pexprResult);
-	pbs->AddRef();
+		pentry = GPOS_NEW(m_pmp) SDPEntry(ullSet, ullCsg, ullCmp, dCost);
 #ifdef GPOS_DEBUG
-	BOOL fInserted =
+		BOOL fInserted =
 #endif // GPOS_DEBUG
-		m_phmbsexpr->FInsert(pbs, pexprResult);
-	GPOS_ASSERT(fInserted);
+			m_phmullentry->FInsert(&pentry->m_ullSet, pentry);
+		GPOS_ASSERT(fInserted);
+	}
+	else if (dCost < pentry->m_dCost)
+	{
+		GPOS_ASSERT(NULL == pentry->m_pexpr && "join order of set is already in use");
 
-	// add expression cost to cost map
-	InsertExpressionCost(pexprResult, dMinCost, false /*fValidateInsert*/);
+		pentry->m_ullOuter = ullCsg;
+		pentry->m_ullInner = ullCmp;
+		pentry->m_dCost = dCost;
+	}
 
-	return pexprResult;
+	if (m_ullAll == ullSet)
+	{
+		AddJoinOrder(ullCsg, ullCmp, dCost);
+	}
 }
 
 
 //---------------------------------------------------------------------------
 //	@function:
-//		CJoinOrderDP::GenerateSubsets
+//		CJoinOrderDP::EmitCsg
 //
 //	@doc:
-//		Generate all subsets of given array of elements
+//		Enumerate connected complements of a connected set; complements
+//		contain only components above the lowest component of the set
 //
 //---------------------------------------------------------------------------
 void
-CJoinOrderDP::GenerateSubsets
+CJoinOrderDP::EmitCsg
 	(
-	IMemoryPool *pmp,
-	CBitSet *pbsCurrent,
-	ULONG *pulElems,
-	ULONG ulSize,
-	ULONG ulIndex,
-	DrgPbs *pdrgpbsSubsets
+	ULLONG ullCsg
 	)
 {
-	GPOS_CHECK_STACK_SIZE;
 	GPOS_CHECK_ABORT;
 
-	GPOS_ASSERT(ulIndex <= ulSize);
-	GPOS_ASSERT(NULL != pbsCurrent);
-	GPOS_ASSERT(NULL != pulElems);
-	GPOS_ASSERT(NULL != pdrgpbsSubsets);
+	const ULONG ulLowest = CBitSet::UlLowestBit(ullCsg);
+	const ULLONG ullExclude = ullCsg | ((UllSingleton(ulLowest) << 1) - 1);
+	const ULLONG ullNeighbors = UllNeighbors(ullCsg, ullExclude);
 
-	if (ulIndex == ulSize)
+	// start complements at each neighbor, in descending order
+	ULONG rgulNeighbors[GPOPT_DP_JOIN_ORDERING_MAX_COMPS];
+	ULONG ulNeighbors = 0;
+	for (ULLONG ull = ullNeighbors; 0 != ull; ull &= ull - 1)
 	{
-		pdrgpbsSubsets->Append(pbsCurrent);
-		return;
+		rgulNeighbors[ulNeighbors++] = CBitSet::UlLowestBit(ull);
 	}
 
-	CBitSet *pbsCopy = GPOS_NEW(pmp) CBitSet(pmp, *pbsCurrent);
-#ifdef GPOS_DEBUG
-	BOOL fSet =
-#endif // GPOS_DEBUG
-		pbsCopy->FExchangeSet(pulElems[ulIndex]);
-	GPOS_ASSERT(!fSet);
-
-	GenerateSubsets(pmp, pbsCopy, pulElems, ulSize, ulIndex + 1, pdrgpbsSubsets);
-	GenerateSubsets(pmp, pbsCurrent, pulElems, ulSize, ulIndex + 1, pdrgpbsSubsets);
-}
-
-//---------------------------------------------------------------------------
-//	@function:
-//		CJoinOrderDP::PdrgpbsSubsets
-//
-//	@doc:
-//		 Driver of subset generation
-//
-//---------------------------------------------------------------------------
-DrgPbs *
-CJoinOrderDP::PdrgpbsSubsets
-	(
-	IMemoryPool *pmp,
-	CBitSet *pbs
-	)
-{
-	const ULONG ulSize = pbs->CElements();
-	ULONG *pulElems = GPOS_NEW_ARRAY(pmp, ULONG, ulSize);
-	ULONG ul = 0;
-	CBitSetIter bsi(*pbs);
-	while (bsi.FAdvance())
+	while (0 < ulNeighbors && !FBudgetExceeded())
 	{
-		pulElems[ul++] = bsi.UlBit();
-	}
-
-	CBitSet *pbsCurrent = GPOS_NEW(pmp) CBitSet(pmp);
-	DrgPbs *pdrgpbsSubsets = GPOS_NEW(pmp) DrgPbs(pmp);
-	GenerateSubsets(pmp, pbsCurrent, pulElems, ulSize, 0, pdrgpbsSubsets);
-	GPOS_DELETE_ARRAY(pulElems);
+		const ULONG ulComp = rgulNeighbors[--ulNeighbors];
+		const ULLONG ullCmp = UllSingleton(ulComp);
+		EmitCsgCmp(ullCsg, ullCmp);
 
-	return pdrgpbsSubsets;
+		const ULLONG ullBelow = (ullCmp << 1) - 1;
+		EnumerateCmpRec(ullCsg, ullCmp, ullExclude | (ullBelow & ullNeighbors));
+	}
 }
 
+
 //---------------------------------------------------------------------------
 //	@function:
-//		CJoinOrderDP::DCost
+//		CJoinOrderDP::EnumerateCsgRec
 //
 //	@doc:
-//		Primitive costing of join expressions;
-//		cost of a join expression is the summation of the costs of its
-//		children plus its local cost;
-//		cost of a leaf expression is the estimated number of rows
+//		Recursively enumerate connected sets extending the given one with
+//		neighbors that are not excluded
 //
 //---------------------------------------------------------------------------
-CDouble
-CJoinOrderDP::DCost
+void
+CJoinOrderDP::EnumerateCsgRec
 	(
-	CExpression *pexpr
+	ULLONG ullCsg,
+	ULLONG ullExclude
 	)
 {
 	GPOS_CHECK_STACK_SIZE;
-	GPOS_ASSERT(NULL != pexpr);
 
-	CDouble *pd = m_phmexprcost->PtLookup(pexpr);
-	if (NULL != pd)
-	{
-		// stop recursion if cost was already cashed
-		return *pd;
-	}
+	const ULLONG ullNeighbors = UllNeighbors(ullCsg, ullExclude);
 
-	CDouble dCost(0.0);
-	const ULONG ulArity = pexpr->UlArity();
-	if (0 == ulArity)
+	// enumerate non-empty subsets of the neighbors in increasing order
+	for (ULLONG ullSub = ullNeighbors & (0 - ullNeighbors); 0 != ullSub && !FBudgetExceeded(); ullSub = ullNeighbors & (ullSub - ullNeighbors))
 	{
-		// leaf operator, use its estimated number of rows as cost
-		dCost = CDouble(pexpr->Pstats()->DRows());
+		EmitCsg(ullCsg | ullSub);
 	}
-	else
-	{
-		// inner join operator, sum-up cost of its children
-		DOUBLE rgdRows[2] = {0.0,  0.0};
-		for (ULONG ul = 0; ul < ulArity - 1; ul++)
-		{
-			CExpression *pexprChild = (*pexpr)[ul];
 
-			// call function recursively to find child cost
-			dCost = dCost + DCost(pexprChild);
-			DeriveStats(pexprChild);
-			rgdRows[ul] = pexprChild->Pstats()->DRows().DVal();
-		}
-
-		// add inner join local cost
-		dCost = dCost + (rgdRows[0] + rgdRows[1]);
+	for (ULLONG ullSub = ullNeighbors & (0 - ullNeighbors); 0 != ullSub && !FBudgetExceeded(); ullSub = ullNeighbors & (ullSub - ullNeighbors))
+	{
+		EnumerateCsgRec(ullCsg | ullSub, ullExclude | ullNeighbors);
 	}
-
-	return dCost;
 }
 
 
 //---------------------------------------------------------------------------
 //	@function:
-//		CJoinOrderDP::PbsCovered
+//		CJoinOrderDP::EnumerateCmpRec
 //
 //	@doc:
-//		Return a subset of the given set covered by one or more edges
+//		Recursively enumerate connected complements extending the given one
+//		with neighbors that are not excluded
 //
 //---------------------------------------------------------------------------
-CBitSet *
-CJoinOrderDP::PbsCovered
+void
+CJoinOrderDP::EnumerateCmpRec
 	(
-	CBitSet *pbsInput
+	ULLONG ullCsg,
+	ULLONG ullCmp,
+	ULLONG ullExclude
 	)
 {
-	GPOS_ASSERT(NULL != pbsInput);
-	CBitSet *pbs = GPOS_NEW(m_pmp) CBitSet(m_pmp);
+	GPOS_CHECK_STACK_SIZE;
 
-	for (ULONG ul = 0; ul < m_ulEdges; ul++)
+	const ULLONG ullNeighbors = UllNeighbors(ullCmp, ullExclude);
+
+	for (ULLONG ullSub = ullNeighbors & (0 - ullNeighbors); 0 != ullSub && !FBudgetExceeded(); ullSub = ullNeighbors & (ullSub - ullNeighbors))
 	{
-		SEdge *pedge = m_rgpedge[ul];
-		if (pbsInput->FSubset(pedge->m_pbs))
-		{
-			pbs->Union(pedge->m_pbs);
-		}
+		EmitCsgCmp(ullCsg, ullCmp | ullSub);
 	}
 
-	return pbs;
+	for (ULLONG ullSub = ullNeighbors & (0 - ullNeighbors); 0 != ullSub && !FBudgetExceeded(); ullSub = ullNeighbors & (ullSub - ullNeighbors))
+	{
+		EnumerateCmpRec(ullCsg, ullCmp | ullSub, ullExclude | ullNeighbors);
+	}
 }
 
 
@@ -754,253 +557,93 @@ CJoinOrderDP::PbsCovered
 //		CJoinOrderDP::PexprCross
 //
 //	@doc:
-//		Generate cross product for the given components
+//		Cross join the best join orders of the connected parts of the join
+//		graph, in the order of their lowest component
 //
 //---------------------------------------------------------------------------
 CExpression *
-CJoinOrderDP::PexprCross
-	(
-	CBitSet *pbs
-	)
+CJoinOrderDP::PexprCross()
 {
-	GPOS_ASSERT(NULL != pbs);
-
-	CExpression *pexpr = PexprLookup(pbs);
-	if (NULL != pexpr)
+	CExpression *pexprCross = NULL;
+	ULLONG ullRemaining = m_ullAll;
+	while (0 != ullRemaining)
 	{
-		// join order is already created
-		return pexpr;
-	}
+		// grow the part of the lowest remaining component
+		ULLONG ullPart = UllSingleton(CBitSet::UlLowestBit(ullRemaining));
+		for (ULLONG ullNew = UllNeighbors(ullPart, 0); 0 != ullNew; ullNew = UllNeighbors(ullPart, 0))
+		{
+			ullPart |= ullNew;
+		}
+		ullRemaining &= ~ullPart;
 
-	CBitSetIter bsi(*pbs);
-	(void) bsi.FAdvance();
-	CExpression *pexprComp = m_rgpcomp[bsi.UlBit()]->m_pexpr;
-	pexprComp->AddRef();
-	CExpression *pexprCross = pexprComp;
-	while (bsi.FAdvance())
-	{
-		pexprComp =  m_rgpcomp[bsi.UlBit()]->m_pexpr;
-		pexprComp->AddRef();
-		pexprCross = CUtils::PexprLogicalJoin<CLogicalInnerJoin>(m_pmp, pexprComp, pexprCross, CPredicateUtils::PexprConjunction(m_pmp, NULL /*pdrgpexpr*/));
+		CExpression *pexprPart = PexprBest(PentryLookup(ullPart));
+		pexprPart->AddRef();
+		if (NULL == pexprCross)
+		{
+			pexprCross = pexprPart;
+		}
+		else
+		{
+			pexprCross = CUtils::PexprLogicalJoin<CLogicalInnerJoin>(m_pmp, pexprCross, pexprPart, CPredicateUtils::PexprConjunction(m_pmp, NULL /*pdrgpexpr*/));
+		}
 	}
 
-	pbs->AddRef();
-#ifdef GPOS_DEBUG
-		BOOL fInserted =
-#endif // GPOS_DEBUG
-			m_phmbsexpr->FInsert(pbs, pexprCross);
-		GPOS_ASSERT(fInserted);
-
 	return pexprCross;
 }
 
 
 //---------------------------------------------------------------------------
 //	@function:
-//		CJoinOrderDP::PexprJoinCoveredSubsetWithUncoveredSubset
+//		CJoinOrderDP::PexprExpand
 //
 //	@doc:
-//		Join a covered subset with uncovered subset
+//		Create join order;
+//		connected sets are enumerated starting from each component, in
+//		descending order, extended only by components above their start;
+//		enumeration stops once the maximum number of pairs of connected
+//		sets and complements is exceeded, and no join order is returned
 //
 //---------------------------------------------------------------------------
 CExpression *
-CJoinOrderDP::PexprJoinCoveredSubsetWithUncoveredSubset
-	(
-	CBitSet *pbs,
-	CBitSet *pbsCovered,
-	CBitSet *pbsUncovered
-	)
+CJoinOrderDP::PexprExpand()
 {
-	GPOS_ASSERT(NULL != pbs);
-	GPOS_ASSERT(NULL != pbsCovered);
-	GPOS_ASSERT(NULL != pbsUncovered);
-	GPOS_ASSERT(pbsCovered->FDisjoint(pbsUncovered));
-	GPOS_ASSERT(pbs->FSubset(pbsCovered));
-	GPOS_ASSERT(pbs->FSubset(pbsUncovered));
-
-	// find best join order for covered subset
-	CExpression *pexprJoin = PexprBestJoinOrder(pbsCovered);
-	if (NULL == pexprJoin)
+	for (ULONG ul = m_ulComps; ul > 0 && !FBudgetExceeded(); ul--)
 	{
-		return NULL;
+		const ULLONG ullComp = UllSingleton(ul - 1);
+		EmitCsg(ullComp);
+		EnumerateCsgRec(ullComp, (ullComp << 1) - 1);
 	}
 
-	// create a cross product for uncovered subset
-	CExpression *pexprCross = PexprCross(pbsUncovered);
-
-	// join the results with a cross product
-	pexprJoin->AddRef();
-	pexprCross->AddRef();
-	CExpression *pexprResult = CUtils::PexprLogicalJoin<CLogicalInnerJoin>(m_pmp, pexprJoin, pexprCross, CPredicateUtils::PexprConjunction(m_pmp, NULL));
-	pbs->AddRef();
-#ifdef GPOS_DEBUG
-	BOOL fInserted =
-#endif // GPOS_DEBUG
-		m_phmbsexpr->FInsert(pbs, pexprResult);
-	GPOS_ASSERT(fInserted);
-
-	return pexprResult;
-}
-
-
-//---------------------------------------------------------------------------
-//	@function:
-//		CJoinOrderDP::PexprBestJoinOrder
-//
-//	@doc:
-//		find best join order for a given set of elements;
-//
-//---------------------------------------------------------------------------
-CExpression *
-CJoinOrderDP::PexprBestJoinOrder
-	(
-	CBitSet *pbs
-	)
-{
-	GPOS_CHECK_STACK_SIZE;
-	GPOS_CHECK_ABORT;
-
-	GPOS_ASSERT(NULL != pbs);
-
-	// start by looking-up cost in the DP map
-	CExpression *pexpr = PexprLookup(pbs);
-
-	if (pexpr == m_pexprDummy)
+	if (FBudgetExceeded())
 	{
-		// no join order could be created
 		return NULL;
 	}
 
-	if (NULL != pexpr)
+	SDPEntry *pentryAll = PentryLookup(m_ullAll);
+	if (NULL == pentryAll)
 	{
-		// join order is found by looking up map
-		return pexpr;
+		// join graph is not connected
+		return PexprCross();
 	}
 
-	// find maximal covered subset
-	CBitSet *pbsCovered = PbsCovered(pbs);
-	if (0 == pbsCovered->CElements())
-	{
-		// set is not covered, return a cross product
-		pbsCovered->Release();
-
-		return PexprCross(pbs);
-	}
-
-	if (!pbsCovered->FEqual(pbs))
-	{
-		// create a cross product for uncovered subset
-		CBitSet *pbsUncovered = GPOS_NEW(m_pmp) CBitSet(m_pmp, *pbs);
-		pbsUncovered->Difference(pbsCovered);
-		CExpression *pexprResult =
-			PexprJoinCoveredSubsetWithUncoveredSubset(pbs, pbsCovered, pbsUncovered);
-		pbsCovered->Release();
-		pbsUncovered->Release();
-
-		return pexprResult;
-	}
-	pbsCovered->Release();
-
-	// if set has size 2, there is only one possible solution
-	if (2 == pbs->CElements())
-	{
-		return PexprJoin(pbs);
-	}
-
-	// otherwise, compute best join order using dynamic programming
-	CExpression *pexprBestJoinOrder = PexprBestJoinOrderDP(pbs);
-	if (pexprBestJoinOrder == m_pexprDummy)
-	{
-		// no join order could be created
-		return NULL;
-	}
-
-	return pexprBestJoinOrder;
-}
-
-
-//---------------------------------------------------------------------------
-//	@function:
-//		CJoinOrderDP::PexprBuildPred
-//
-//	@doc:
-//		Build predicate connecting the two given sets
-//
-//---------------------------------------------------------------------------
-CExpression *
-CJoinOrderDP::PexprBuildPred
-	(
-	CBitSet *pbsFst,
-	CBitSet *pbsSnd
-	)
-{
-	// collect edges connecting the given sets
-	CBitSet *pbsEdges = GPOS_NEW(m_pmp) CBitSet(m_pmp);
-	CBitSet *pbs = GPOS_NEW(m_pmp) CBitSet(m_pmp, *pbsFst);
-	pbs->Union(pbsSnd);
-
-	for (ULONG ul = 0; ul < m_ulEdges; ul++)
+	CExpression *pexprResult = PexprBest(pentryAll);
+	for (ULONG ul = 0; ul < m_ulTopK; ul++)
 	{
-		SEdge *pedge = m_rgpedge[ul];
-		if (
-			pbs->FSubset(pedge->m_pbs) &&
-			!pbsFst->FDisjoint(pedge->m_pbs) &&
-			!pbsSnd->FDisjoint(pedge->m_pbs)
-			)
+		const SJoinOrder &jo = m_rgjoTopK[ul];
+		CExpression *pexprJoin = NULL;
+		if (jo.m_ullOuter == pentryAll->m_ullOuter && jo.m_ullInner == pentryAll->m_ullInner)
 		{
-#ifdef GPOS_DEBUG
-		BOOL fSet =
-#endif // GPOS_DEBUG
-			pbsEdges->FExchangeSet(ul);
-			GPOS_ASSERT(!fSet);
+			pexprResult->AddRef();
+			pexprJoin = pexprResult;
 		}
-	}
-	pbs->Release();
-
-	CExpression *pexprPred = NULL;
-	if (0 < pbsEdges->CElements())
-	{
-		DrgPexpr *pdrgpexpr = GPOS_NEW(m_pmp) DrgPexpr(m_pmp);
-		CBitSetIter bsi(*pbsEdges);
-		while (bsi.FAdvance())
+		else
 		{
-			ULONG ul = bsi.UlBit();
-			SEdge *pedge = m_rgpedge[ul];
-			pedge->m_pexpr->AddRef();
-			pdrgpexpr->Append(pedge->m_pexpr);
+			pexprJoin = PexprJoin(jo.m_ullOuter, jo.m_ullInner);
 		}
-
-		pexprPred = CPredicateUtils::PexprConjunction(m_pmp, pdrgpexpr);
+		m_pdrgpexprTopKOrders->Append(pexprJoin);
 	}
 
-	pbsEdges->Release();
-	return pexprPred;
-}
-
-
-//---------------------------------------------------------------------------
-//	@function:
-//		CJoinOrderDP::PexprExpand
-//
-//	@doc:
-//		Create join order
-//
-//---------------------------------------------------------------------------
-CExpression *
-CJoinOrderDP::PexprExpand()
-{
-	CBitSet *pbs = GPOS_NEW(m_pmp) CBitSet(m_pmp);
-	for (ULONG ul = 0; ul < m_ulComps; ul++)
-	{
-		(void) pbs->FExchangeSet(ul);
-	}
-
-	CExpression *pexprResult = PexprBestJoinOrder(pbs);
-	if (NULL != pexprResult)
-	{
-		pexprResult->AddRef();
-	}
-	pbs->Release();
+	pexprResult->AddRef();
 
 	return pexprResult;
 }
@@ -18,6 +18,7 @@
 #include "gpopt/operators/CNormalizer.h"
 #include "gpopt/operators/CPredicateUtils.h"
 #include "gpopt/xforms/CXformExpandNAryJoinDP.h"
+#include "gpopt/xforms/CXformExpandNAryJoinGreedy.h"
 #include "gpopt/xforms/CXformUtils.h"
 #include "gpopt/xforms/CJoinOrderDP.h"
 
@@ -77,7 +78,7 @@ CXformExpandNAryJoinDP::Exfp
 	// defining the join predicate, ignore it.
 	const ULONG ulRelChild = ulArity - 1;
 
-	if (ulRelChild > phint->UlJoinOrderDPLimit())
+	if (ulRelChild > phint->UlJoinOrderDPLimit() || ulRelChild > GPOPT_DP_JOIN_ORDERING_MAX_COMPS)
 	{
 		return CXform::ExfpNone;
 	}
@@ -129,7 +130,13 @@ CXformExpandNAryJoinDP::Transform
 	CJoinOrderDP jodp(pmp, pdrgpexpr, pdrgpexprPreds);
 	CExpression *pexprResult = jodp.PexprExpand();
 
-	if (NULL != pexprResult)
+	if (NULL == pexprResult)
+	{
+		// join graph is too dense to be ordered by dynamic programming,
+		// fall back to a join order based on cardinality of intermediate results
+		pxfres->Add(CXformExpandNAryJoinGreedy::PexprExpand(pmp, pexpr));
+	}
+	else
 	{
 		// normalize resulting expression
 		CExpression *pexprNormalized = CNormalizer::PexprNormalize(pmp, pexprResult);
@@ -20,6 +20,7 @@
 #include "gpopt/operators/CNormalizer.h"
 #include "gpopt/operators/CPredicateUtils.h"
 #include "gpopt/xforms/CXformExpandNAryJoinGreedy.h"
+#include "gpopt/xforms/CJoinOrderDP.h"
 #include "gpopt/xforms/CJoinOrderGreedy.h"
 #include "gpopt/xforms/CXformUtils.h"
 
@@ -79,7 +80,8 @@ CXformExpandNAryJoinGreedy::Exfp
 	const ULONG ulRelChild = ulArity - 1;
 
 	// This transform is used only when DP is disabled
-	if (GPOPT_FENABLED_XFORM(CXform::ExfExpandNAryJoinDP) && ulRelChild < phint->UlJoinOrderDPLimit())
+	if (GPOPT_FENABLED_XFORM(CXform::ExfExpandNAryJoinDP) && ulRelChild < phint->UlJoinOrderDPLimit() &&
+		ulRelChild <= GPOPT_DP_JOIN_ORDERING_MAX_COMPS)
 	{
 		return CXform::ExfpNone;
 	}
@@ -90,28 +92,20 @@ CXformExpandNAryJoinGreedy::Exfp
 
 //---------------------------------------------------------------------------
 //	@function:
-//		CXformExpandNAryJoinGreedy::Transform
+//		CXformExpandNAryJoinGreedy::PexprExpand
 //
 //	@doc:
-//		Actual transformation of n-ary join to cluster of inner joins
+//		Expand given n-ary join into a normalized cluster of inner joins
+//		ordered by cardinality of intermediate results
 //
 //---------------------------------------------------------------------------
-void
-CXformExpandNAryJoinGreedy::Transform
+CExpression *
+CXformExpandNAryJoinGreedy::PexprExpand
 	(
-	CXformContext *pxfctxt,
-	CXformResult *pxfres,
+	IMemoryPool *pmp,
 	CExpression *pexpr
 	)
-	const
 {
-	GPOS_ASSERT(NULL != pxfctxt);
-	GPOS_ASSERT(NULL != pxfres);
-	GPOS_ASSERT(FPromising(pxfctxt->Pmp(), this, pexpr));
-	GPOS_ASSERT(FCheckPattern(pexpr));
-
-	IMemoryPool *pmp = pxfctxt->Pmp();
-
 	const ULONG ulArity = pexpr->UlArity();
 	GPOS_ASSERT(ulArity >= 3);
 
@@ -133,7 +127,34 @@ CXformExpandNAryJoinGreedy::Transform
 	// normalize resulting expression
 	CExpression *pexprNormalized = CNormalizer::PexprNormalize(pmp, pexprResult);
 	pexprResult->Release();
-	pxfres->Add(pexprNormalized);
+
+	return pexprNormalized;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXformExpandNAryJoinGreedy::Transform
+//
+//	@doc:
+//		Actual transformation of n-ary join to cluster of inner joins
+//
+//---------------------------------------------------------------------------
+void
+CXformExpandNAryJoinGreedy::Transform
+	(
+	CXformContext *pxfctxt,
+	CXformResult *pxfres,
+	CExpression *pexpr
+	)
+	const
+{
+	GPOS_ASSERT(NULL != pxfctxt);
+	GPOS_ASSERT(NULL != pxfres);
+	GPOS_ASSERT(FPromising(pxfctxt->Pmp(), this, pexpr));
+	GPOS_ASSERT(FCheckPattern(pexpr));
+
+	pxfres->Add(PexprExpand(pxfctxt->Pmp(), pexpr));
 }
 
 // EOF
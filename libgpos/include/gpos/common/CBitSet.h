@@ -6,15 +6,21 @@
 //		CBitSet.h
 //
 //	@doc:
-//		Implementation of bitset as linked list of bitvectors
+//		Implementation of bitset as contiguous array of word chunks
 //---------------------------------------------------------------------------
 #ifndef GPOS_CBitSet_H
 #define GPOS_CBitSet_H
 
 #include "gpos/base.h"
 #include "gpos/common/CDynamicPtrArray.h"
-#include "gpos/common/CBitVector.h"
-#include "gpos/common/CList.h"
+#include "gpos/common/CRefCount.h"
+
+// number of words stored inline in a set; one 1024-bit chunk, the chunk
+// size of column sets, or four chunks of the default size
+#define GPOS_BITSET_INLINE_UNITS	(16)
+
+// max number of words of a set in dense form
+#define GPOS_BITSET_DENSE_UNITS		(64)
 
 
 namespace gpos
@@ -25,7 +31,15 @@ namespace gpos
 	//		CBitSet
 	//
 	//	@doc:
-	//		Linked list of CBitSetLink's
+	//		Bit set stored as a sequence of fixed-size chunks of 64-bit words;
+	//		all chunks live in one contiguous word array, which is kept inline
+	//		in the set object while it is small.
+	//
+	//		Chunks are kept in one of two forms: in dense form the chunks cover
+	//		a contiguous window of bits starting at a base offset; once the
+	//		window would grow beyond a size limit, e.g. when very large ids are
+	//		added, the set switches to sparse form where only non-empty chunks
+	//		are stored together with their offsets in ascending order.
 	//
 	//---------------------------------------------------------------------------
 	class CBitSet : public CRefCount
@@ -35,85 +49,133 @@ namespace gpos
 		
 		protected:
 
-			//---------------------------------------------------------------------------
-			//	@class:
-			//		CBitSetLink
-			//
-			//	@doc:
-			//		bit vector + offset + link
-			//
-			//---------------------------------------------------------------------------
-			class CBitSetLink
-			{
-				private:
-				
-					// private copy ctor
-					CBitSetLink(const CBitSetLink &);
-
-					// offset
-					ULONG m_ulOffset;
-					
-					// bitvector
-					CBitVector *m_pbv;
-
-				public:
-				
-					// ctor
-                    explicit
-                    CBitSetLink(IMemoryPool *, ULONG ulOffset, ULONG cSizeBits);
-
-        			explicit
-					CBitSetLink(IMemoryPool *, const CBitSetLink &);
-					
-					// dtor
-					~CBitSetLink();
-
-					// accessor
-					ULONG UlOffset() const
-					{
-						return m_ulOffset;
-					}
-					
-					// accessor
-					CBitVector *Pbv() const
-					{
-						return m_pbv;
-					}
-										
-					// list link
-					SLink m_link;
-					
-			}; // class CBitSetLink
-		
-			// list of bit set links
-			typedef CList<CBitSetLink> BSLList;
-			BSLList m_bsllist;
-		
-			// pool to allocate links from
+			// pool to allocate storage from
 			IMemoryPool *m_pmp;
 		
-			// size of individual bitvectors
+			// size of individual chunks in bits, a multiple of the word size
 			ULONG m_cSizeBits;
+
+			// size of individual chunks in words
+			ULONG m_cUnitsPerChunk;
 			
 			// number of elements
 			ULONG m_cElements;
+
+			// word storage of all chunks; points to inline storage or to an
+			// array allocated from the pool
+			ULLONG *m_rgull;
+
+			// number of chunks in storage
+			ULONG m_cChunks;
+
+			// number of chunks storage has room for
+			ULONG m_cChunksCapacity;
+
+			// is set in sparse form
+			BOOL m_fSparse;
+
+			// offset of first chunk in dense form
+			ULONG m_ulBase;
+
+			// offsets of chunks in sparse form, sized like word storage
+			ULONG *m_rgulOffset;
+
+			// inline storage for small sets
+			ULLONG m_rgullInline[GPOS_BITSET_INLINE_UNITS];
 		
 			// private copy ctor
 			CBitSet(const CBitSet&);
-			
-			// find link with offset less or equal to given value
-			CBitSetLink *PbslLocate(ULONG, CBitSetLink * = NULL) const;
+
+			// offset of given chunk
+			ULONG UlChunkOffset
+				(
+				ULONG ulChunk
+				)
+				const
+			{
+				GPOS_ASSERT(ulChunk < m_cChunks);
+
+				if (!m_fSparse)
+				{
+					return m_ulBase + ulChunk * m_cSizeBits;
+				}
+
+				return m_rgulOffset[ulChunk];
+			}
+
+			// words of given chunk
+			ULLONG *PullChunk
+				(
+				ULONG ulChunk
+				)
+				const
+			{
+				return m_rgull + ulChunk * m_cUnitsPerChunk;
+			}
+
+			// compute target offset
+			ULONG UlOffset
+				(
+				ULONG ul
+				)
+				const
+			{
+				return (ul / m_cSizeBits) * m_cSizeBits;
+			}
+
+			// find chunk with given offset; if there is none, return false and
+			// the position a chunk with this offset would be inserted at
+			BOOL FLocate(ULONG ulOffset, ULONG *pulChunk) const;
+
+			// words of chunk with given offset, NULL if there is none
+			const ULLONG *PullLocate(ULONG ulOffset) const;
+
+			// words of chunk with given offset; add chunk if necessary
+			ULLONG *PullEnsure(ULONG ulOffset);
+
+			// make room for given number of chunks
+			void Reserve(ULONG cChunks);
+
+			// switch storage to sparse form
+			void ConvertToSparse();
+
+			// check if given chunk is empty
+			BOOL FEmptyChunk(ULONG ulChunk) const;
+
+			// find next set bit in chunk at or after given position
+			BOOL FNextBit(ULONG ulChunk, ULONG ulStart, ULONG &ulNext) const;
 			
 			// reset set
 			void Clear();
 			
-			// compute target offset
-			ULONG UlOffset(ULONG) const;
-			
 			// re-compute size of set
 			void RecomputeSize();
 			
 		public:
+
+			// number of set bits in a word
+			static
+			ULONG UlPopCount(ULLONG ull)
+			{
+				const ULLONG ullM1 = ~(ULLONG) 0 / 3;
+				const ULLONG ullM2 = ~(ULLONG) 0 / 5;
+				const ULLONG ullM4 = ~(ULLONG) 0 / 17;
+				const ULLONG ullH1 = ~(ULLONG) 0 / 255;
+
+				ull = ull - ((ull >> 1) & ullM1);
+				ull = (ull & ullM2) + ((ull >> 2) & ullM2);
+				ull = (ull + (ull >> 4)) & ullM4;
+
+				return (ULONG) ((ull * ullH1) >> 56);
+			}
+
+			// position of lowest set bit of a non-zero word
+			static
+			ULONG UlLowestBit(ULLONG ull)
+			{
+				GPOS_ASSERT(0 != ull);
+				return UlPopCount((ull & (~ull + 1)) - 1);
+			}
 				
 			// ctor
 			CBitSet(IMemoryPool *pmp, ULONG cSizeBits = 256);
@@ -184,4 +246,3 @@ namespace gpos
 #endif // !GPOS_CBitSet_H
 
 // EOF
-
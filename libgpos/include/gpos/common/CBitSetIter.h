@@ -22,7 +22,7 @@ namespace gpos
 	//
 	//	@doc:
 	//		Iterator for bitset's; defined as friend, ie can access bitset's 
-	//		internal links
+	//		internal chunks
 	//
 	//---------------------------------------------------------------------------
 	class CBitSetIter
@@ -32,11 +32,11 @@ namespace gpos
 			// bitset
 			const CBitSet &m_bs;
 
-			// current cursor position (in current link)
+			// current cursor position (in current chunk)
 			ULONG m_ulCursor;
 				
-			// current cursor link
-			CBitSet::CBitSetLink *m_pbsl;
+			// current cursor chunk
+			ULONG m_ulChunk;
 		
 			// is iterator active or exhausted
 			BOOL m_fActive;
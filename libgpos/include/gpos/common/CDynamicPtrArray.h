@@ -184,6 +184,12 @@ namespace gpos
                 return m_ulSize;
             }
 
+			// memory pool of the array
+			IMemoryPool *Pmp() const
+			{
+				return m_pmp;
+			}
+
 			// sort array
 			void Sort(PfnCompare pfncompare = PtrCmp)
             {
@@ -11,6 +11,7 @@
 //		* equality == on key uses template function argument
 //		* does not allow insertion of duplicates (no equality on value class req'd)
 //		* destroys objects based on client-side provided destroy functions
+//		* grows automatically; the size given at construction is a hint only
 //---------------------------------------------------------------------------
 #ifndef GPOS_CHashMap_H
 #define GPOS_CHashMap_H
@@ -19,6 +20,9 @@
 #include "gpos/common/CRefCount.h"
 #include "gpos/common/CDynamicPtrArray.h"
 
+// number of entries allocated on first insertion if no size hint is given
+#define GPOS_HASHMAP_MIN_ENTRIES	(8)
+
 namespace gpos
 {	
 	// fwd declaration
@@ -34,7 +38,13 @@ namespace gpos
 	//		CHashMap
 	//
 	//	@doc:
-	//		Hash map
+	//		Hash map with open addressing
+	//
+	//		Entries are kept in a flat array in insertion order; a separate
+	//		power-of-two slot table maps hash values to entry positions using
+	//		linear probing. The slot table is kept at most half full and both
+	//		arrays double when the entry array is exhausted; stored hash values
+	//		make rehashing independent of the hash function.
 	//
 	//---------------------------------------------------------------------------
 	template <class K, class T, 
@@ -50,222 +60,231 @@ namespace gpos
 		private:
 		
 			//---------------------------------------------------------------------------
-			//	@class:
-			//		CHashMapElem
+			//	@struct:
+			//		SEntry
 			//
 			//	@doc:
-			//		Anchor for key/value pair
+			//		Key/value pair and hash value of key
 			//
-			//---------------------------------------------------------------------------		
-			class CHashMapElem
+			//---------------------------------------------------------------------------
+			struct SEntry
 			{
-				private:
-				
-					// key/value pair
-					K *m_pk;
-					T *m_pt;
-					
-					// own objects
-					BOOL m_fOwn;
-					
-					// private copy ctor
-					CHashMapElem(const CHashMapElem &);
-				
-				public:
-				
-					// ctor
-					CHashMapElem(K *pk, T *pt, BOOL fOwn)
-                    :
-                    m_pk(pk),
-                    m_pt(pt),
-                    m_fOwn(fOwn)
-                    {
-                        GPOS_ASSERT(NULL != pk);
-                    }
-
-					// dtor 
-					~CHashMapElem()
-                    {
-                        // in case of a temporary hashmap element for lookup we do NOT own the
-                        // objects, otherwise call destroy functions
-                        if (m_fOwn)
-                        {
-                            pfnDestroyK(m_pk);
-                            pfnDestroyT(m_pt);
-                        }
-                    }
-
-					// key accessor
-					K *Pk() const
-					{
-						return m_pk;
-					}
+				// key
+				K *m_pk;
 
-					// value accessor
-					T *Pt() const
-					{
-						return m_pt;
-					}
-					
-					// replace value
-					void ReplaceValue(T *ptNew)
-                    {
-                        if (m_fOwn)
-                        {
-                            pfnDestroyT(m_pt);
-                        }
-                        m_pt = ptNew;
-                    }
-
-					// equality operator -- map elements are equal if their keys match
-					BOOL operator == (const CHashMapElem &hme) const
-					{
-						return pfnEq(m_pk, hme.m_pk);
-					}
+				// value
+				T *m_pt;
+
+				// hash value of key
+				ULONG m_ulHash;
 			};
 
 			// memory pool
 			IMemoryPool *const m_pmp;
 			
-			// size
-			ULONG m_ulSize;
-		
 			// number of entries
 			ULONG m_ulEntries;
 
-			// each hash chain is an array of hashmap elements
-			typedef CDynamicPtrArray<CHashMapElem, CleanupDelete> DrgHashChain;
-			DrgHashChain **const m_ppdrgchain;
+			// number of entries that fit without growing
+			ULONG m_ulCapacity;
 
-			// array for keys
-			// We use CleanupNULL because the keys are owned by the hash table
-			typedef CDynamicPtrArray<K, CleanupNULL> DrgKeys;
-			DrgKeys *const m_pdrgKeys;
+			// entries in insertion order
+			SEntry *m_rgentry;
 
-			DrgPi *const m_pdrgPiFilledBuckets;
+			// slot table of (twice the capacity) entry positions plus one;
+			// zero marks an empty slot
+			ULONG *m_rgulSlot;
+
+			// log2 of number of slots
+			ULONG m_ulSlotBits;
 
 			// private copy ctor
 			CHashMap(const CHashMap<K, T, pfnHash, pfnEq, pfnDestroyK, pfnDestroyT> &);
 			
-			// lookup appropriate hash chain in static table, may be NULL if
-			// no elements have been inserted yet
-			DrgHashChain **PpdrgChain(const K *pk) const
+			// home slot of a hash value; multiplicative hashing spreads weak hash
+			// values, such as small integers, over the whole slot table
+			ULONG UlHomeSlot(ULONG ulHash) const
 			{
-				GPOS_ASSERT(NULL != m_ppdrgchain);
-				return &m_ppdrgchain[pfnHash(pk) % m_ulSize];
+				GPOS_ASSERT(0 < m_ulSlotBits);
+				return (ULONG) (ulHash * 2654435769u) >> (32 - m_ulSlotBits);
 			}
 
-			// clear elements
-			void Clear()
-            {
-                for (ULONG i = 0; i < m_pdrgPiFilledBuckets->UlLength(); i++)
-                {
-                    // release each hash chain
-                    m_ppdrgchain[*(*m_pdrgPiFilledBuckets)[i]]->Release();
-                }
-                m_ulEntries = 0;
-                m_pdrgPiFilledBuckets->Clear();
-            }
-	
-			// lookup an element by its key
-			void Lookup(const K *pk, CHashMapElem **pphme) const
-            {
-                GPOS_ASSERT(NULL != pphme);
-
-                CHashMapElem hme(const_cast<K*>(pk), NULL /*T*/, false /*fOwn*/);
-                CHashMapElem *phme = NULL;
-                DrgHashChain **ppdrgchain = PpdrgChain(pk);
-                if (NULL != *ppdrgchain)
-                {
-                    phme = (*ppdrgchain)->PtLookup(&hme);
-                    GPOS_ASSERT_IMP(NULL != phme, *phme == hme);
-                }
-
-                *pphme = phme;
-            }
+			// slot mask
+			ULONG UlSlotMask() const
+			{
+				return (1u << m_ulSlotBits) - 1;
+			}
+
+			// lookup an entry by its key
+			SEntry *Pentry(const K *pk) const
+			{
+				GPOS_ASSERT(NULL != pk);
+
+				if (0 == m_ulEntries)
+				{
+					return NULL;
+				}
+
+				const ULONG ulHash = pfnHash(pk);
+				const ULONG ulMask = UlSlotMask();
+				for (ULONG ulSlot = UlHomeSlot(ulHash); 0 != m_rgulSlot[ulSlot]; ulSlot = (ulSlot + 1) & ulMask)
+				{
+					SEntry *pentry = &m_rgentry[m_rgulSlot[ulSlot] - 1];
+					if (pentry->m_ulHash == ulHash && pfnEq(pentry->m_pk, pk))
+					{
+						return pentry;
+					}
+				}
+
+				return NULL;
+			}
+
+			// enter position of an entry into the slot table
+			void InsertSlot(ULONG ulPos)
+			{
+				const ULONG ulMask = UlSlotMask();
+				ULONG ulSlot = UlHomeSlot(m_rgentry[ulPos].m_ulHash);
+				while (0 != m_rgulSlot[ulSlot])
+				{
+					ulSlot = (ulSlot + 1) & ulMask;
+				}
+				m_rgulSlot[ulSlot] = ulPos + 1;
+			}
+
+			// grow entry array and slot table to hold at least the given number of entries
+			void Grow(ULONG ulCapacity)
+			{
+				GPOS_ASSERT(ulCapacity > m_ulCapacity);
+
+				ULONG ulSlotBits = 1;
+				while ((1u << ulSlotBits) < 2 * ulCapacity)
+				{
+					ulSlotBits++;
+				}
+				ulCapacity = (1u << ulSlotBits) / 2;
+
+				// allocate both arrays before touching the map, so that the map
+				// remains intact if allocation fails
+				SEntry *rgentry = GPOS_NEW_ARRAY(m_pmp, SEntry, ulCapacity);
+				ULONG *rgulSlot = NULL;
+				GPOS_TRY
+				{
+					rgulSlot = GPOS_NEW_ARRAY(m_pmp, ULONG, 1u << ulSlotBits);
+				}
+				GPOS_CATCH_EX(ex)
+				{
+					GPOS_DELETE_ARRAY(rgentry);
+					GPOS_RETHROW(ex);
+				}
+				GPOS_CATCH_END;
+
+				if (0 < m_ulEntries)
+				{
+					(void) clib::PvMemCpy(rgentry, m_rgentry, m_ulEntries * sizeof(SEntry));
+				}
+				(void) clib::PvMemSet(rgulSlot, 0, (1u << ulSlotBits) * sizeof(ULONG));
+
+				GPOS_DELETE_ARRAY(m_rgentry);
+				GPOS_DELETE_ARRAY(m_rgulSlot);
+
+				m_rgentry = rgentry;
+				m_rgulSlot = rgulSlot;
+				m_ulCapacity = ulCapacity;
+				m_ulSlotBits = ulSlotBits;
+
+				for (ULONG ul = 0; ul < m_ulEntries; ul++)
+				{
+					InsertSlot(ul);
+				}
+			}
 
 		public:
 		
-			// ctor
+			// ctor; the size is the expected number of entries
 			CHashMap<K, T, pfnHash, pfnEq, pfnDestroyK, pfnDestroyT> (IMemoryPool *pmp, ULONG ulSize = 128)
-            :
-            m_pmp(pmp),
-            m_ulSize(ulSize),
-            m_ulEntries(0),
-            m_ppdrgchain(GPOS_NEW_ARRAY(m_pmp, DrgHashChain*, m_ulSize)),
-            m_pdrgKeys(GPOS_NEW(m_pmp) DrgKeys(m_pmp)),
-            m_pdrgPiFilledBuckets(GPOS_NEW(pmp) DrgPi(pmp))
-            {
-                GPOS_ASSERT(ulSize > 0);
-                (void) clib::PvMemSet(m_ppdrgchain, 0, m_ulSize * sizeof(DrgHashChain*));
-            }
+			:
+			m_pmp(pmp),
+			m_ulEntries(0),
+			m_ulCapacity(0),
+			m_rgentry(NULL),
+			m_rgulSlot(NULL),
+			m_ulSlotBits(0)
+			{
+				GPOS_ASSERT(NULL != pmp);
+
+				if (0 < ulSize)
+				{
+					Grow(ulSize);
+				}
+			}
 
 			// dtor
 			~CHashMap<K, T, pfnHash, pfnEq, pfnDestroyK, pfnDestroyT> ()
-            {
-                // release all hash chains
-                Clear();
-
-                GPOS_DELETE_ARRAY(m_ppdrgchain);
-                m_pdrgKeys->Release();
-                m_pdrgPiFilledBuckets->Release();
-            }
+			{
+				for (ULONG ul = 0; ul < m_ulEntries; ul++)
+				{
+					pfnDestroyK(m_rgentry[ul].m_pk);
+					pfnDestroyT(m_rgentry[ul].m_pt);
+				}
+
+				GPOS_DELETE_ARRAY(m_rgentry);
+				GPOS_DELETE_ARRAY(m_rgulSlot);
+			}
 
 			// insert an element if key is not yet present
 			BOOL FInsert(K *pk, T *pt)
-            {
-                if (NULL != PtLookup(pk))
-                {
-                    return false;
-                }
+			{
+				GPOS_ASSERT(NULL != pk);
 
-                DrgHashChain **ppdrgchain = PpdrgChain(pk);
-                if (NULL == *ppdrgchain)
-                {
-                    *ppdrgchain = GPOS_NEW(m_pmp) DrgHashChain(m_pmp);
-                    INT iBucket = pfnHash(pk) % m_ulSize;
-                    m_pdrgPiFilledBuckets->Append(GPOS_NEW(m_pmp) INT(iBucket));
-                }
+				if (NULL != Pentry(pk))
+				{
+					return false;
+				}
 
-                CHashMapElem *phme = GPOS_NEW(m_pmp) CHashMapElem(pk, pt, true /*fOwn*/);
-                (*ppdrgchain)->Append(phme);
+				if (m_ulEntries == m_ulCapacity)
+				{
+					Grow(std::max((ULONG) GPOS_HASHMAP_MIN_ENTRIES, 2 * m_ulCapacity));
+				}
 
-                m_ulEntries++;
+				SEntry *pentry = &m_rgentry[m_ulEntries];
+				pentry->m_pk = pk;
+				pentry->m_pt = pt;
+				pentry->m_ulHash = pfnHash(pk);
+				InsertSlot(m_ulEntries);
 
-                m_pdrgKeys->Append(pk);
+				m_ulEntries++;
 
-                return true;
-            }
+				return true;
+			}
 			
 			// lookup a value by its key
 			T *PtLookup(const K *pk) const
-            {
-                CHashMapElem *phme = NULL;
-                Lookup(pk, &phme);
-                if (NULL != phme)
-                {
-                    return phme->Pt();
-                }
+			{
+				SEntry *pentry = Pentry(pk);
+				if (NULL != pentry)
+				{
+					return pentry->m_pt;
+				}
 
-                return NULL;
-            }
+				return NULL;
+			}
 
 			// replace the value in a map entry with a new given value
 			BOOL FReplace(const K *pk, T *ptNew)
-            {
-                GPOS_ASSERT(NULL != pk);
-
-                BOOL fSuccess = false;
-                CHashMapElem *phme = NULL;
-                Lookup(pk, &phme);
-                if (NULL != phme)
-                {
-                    phme->ReplaceValue(ptNew);
-                    fSuccess = true;
-                }
-
-                return fSuccess;
-            }
+			{
+				GPOS_ASSERT(NULL != pk);
+
+				SEntry *pentry = Pentry(pk);
+				if (NULL == pentry)
+				{
+					return false;
+				}
+
+				pfnDestroyT(pentry->m_pt);
+				pentry->m_pt = ptNew;
+
+				return true;
+			}
 
 			// return number of map entries
 			ULONG UlEntries() const
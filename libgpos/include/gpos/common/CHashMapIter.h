@@ -14,7 +14,6 @@
 #include "gpos/base.h"
 #include "gpos/common/CStackObject.h"
 #include "gpos/common/CHashMap.h"
-#include "gpos/common/CDynamicPtrArray.h"
 
 namespace gpos
 {	
@@ -23,7 +22,7 @@ namespace gpos
 	//		CHashMapIter
 	//
 	//	@doc:
-	//		Hash map iterator
+	//		Hash map iterator; visits entries in insertion order
 	//
 	//---------------------------------------------------------------------------
 	template <class K, class T, 
@@ -42,39 +41,30 @@ namespace gpos
 			// map to iterate
 			const TMap *m_ptm;
 
-			// current hashchain
-			ULONG m_ulChain;
-
-			// current key
+			// position of current entry plus one
 			ULONG m_ulKey;
 
-			// is initialized?
-			BOOL m_fInit;
-
 			// private copy ctor
 			CHashMapIter(const CHashMapIter<K, T, pfnHash, pfnEq, pfnDestroyK, pfnDestroyT> &);
 			
-			// method to return the current element
-			const typename TMap::CHashMapElem *Phme() const
-            {
-                typename TMap::CHashMapElem *phme = NULL;
-                K *k = (*(m_ptm->m_pdrgKeys))[m_ulKey-1];
-                m_ptm->Lookup(k, &phme);
+			// current entry
+			const typename TMap::SEntry *Pentry() const
+			{
+				GPOS_ASSERT(0 < m_ulKey && m_ulKey <= m_ptm->m_ulEntries);
 
-                return phme;
-            }
+				return &m_ptm->m_rgentry[m_ulKey - 1];
+			}
 
 		public:
 		
 			// ctor
 			CHashMapIter<K, T, pfnHash, pfnEq, pfnDestroyK, pfnDestroyT> (TMap *ptm)
-            :
-            m_ptm(ptm),
-            m_ulChain(0),
-            m_ulKey(0)
-            {
-                GPOS_ASSERT(NULL != ptm);
-            }
+			:
+			m_ptm(ptm),
+			m_ulKey(0)
+			{
+				GPOS_ASSERT(NULL != ptm);
+			}
 
 			// dtor
 			virtual
@@ -83,37 +73,27 @@ namespace gpos
 
 			// advance iterator to next element
 			BOOL FAdvance()
-            {
-                if (m_ulKey < m_ptm->m_pdrgKeys->UlLength())
-                {
-                    m_ulKey++;
-                    return true;
-                }
-
-                return false;
-            }
+			{
+				if (m_ulKey < m_ptm->m_ulEntries)
+				{
+					m_ulKey++;
+					return true;
+				}
+
+				return false;
+			}
 			
 			// current key
 			const K *Pk() const
-            {
-                const typename TMap::CHashMapElem *phme = Phme();
-                if (NULL != phme)
-                {
-                    return phme->Pk();
-                }
-                return NULL;
-            }
+			{
+				return Pentry()->m_pk;
+			}
 
 			// current value
 			const T *Pt() const
-            {
-                const typename TMap::CHashMapElem *phme = Phme();
-                if (NULL != phme)
-                {
-                    return phme->Pt();
-                }
-                return NULL;
-            }
+			{
+				return Pentry()->m_pt;
+			}
 
 	}; // class CHashMapIter
 
@@ -11,6 +11,7 @@
 //		* equality == on objects uses template function argument
 //		* does not allow insertion of duplicates
 //		* destroys objects based on client-side provided destroy functions
+//		* grows automatically; the size given at construction is a hint only
 //
 //	@owner:
 //		solimm1
@@ -26,6 +27,9 @@
 #include "gpos/common/CRefCount.h"
 #include "gpos/common/CDynamicPtrArray.h"
 
+// number of elements allocated on first insertion if no size hint is given
+#define GPOS_HASHSET_MIN_ENTRIES	(8)
+
 namespace gpos
 {
 
@@ -41,7 +45,7 @@ namespace gpos
 	//		CHashSet
 	//
 	//	@doc:
-	//		Hash set
+	//		Hash set with open addressing; see CHashMap for the layout
 	//
 	//---------------------------------------------------------------------------
 	template <class T,
@@ -56,188 +60,203 @@ namespace gpos
 		private:
 
 			//---------------------------------------------------------------------------
-			//	@class:
-			//		CHashSetElem
+			//	@struct:
+			//		SEntry
 			//
 			//	@doc:
-			//		Anchor for set element
+			//		Set element and its hash value
 			//
 			//---------------------------------------------------------------------------
-			class CHashSetElem
+			struct SEntry
 			{
-				private:
-
-					// pointer to object
-					T *m_pt;
-
-					// does hash set element own object?
-					BOOL m_fOwn;
-
-					// private copy ctor
-					CHashSetElem(const CHashSetElem &);
-
-				public:
-
-					// ctor
-					CHashSetElem(T *pt, BOOL fOwn)
-                    :
-                    m_pt(pt),
-                    m_fOwn(fOwn)
-                    {
-                        GPOS_ASSERT(NULL != pt);
-                    }
-
-					// dtor
-					~CHashSetElem()
-                    {
-                        // in case of a temporary HashSet element for lookup we do NOT own the
-                        // objects, otherwise call destroy functions
-                        if (m_fOwn)
-                        {
-                            pfnDestroy(m_pt);
-                        }
-                    }
-
-					// object accessor
-					T *Pt() const
-					{
-						return m_pt;
-					}
+				// element
+				T *m_pt;
 
-					// equality operator
-					BOOL operator == (const CHashSetElem &hse) const
-					{
-						return pfnEq(m_pt, hse.m_pt);
-					}
-			};	// class CHashSetElem
+				// hash value of element
+				ULONG m_ulHash;
+			};
 
 			// memory pool
-			IMemoryPool *m_pmp;
-
-			// number of hash chains
-			ULONG m_ulSize;
+			IMemoryPool *const m_pmp;
 
 			// total number of entries
 			ULONG m_ulEntries;
 
-			// each hash chain is an array of hashset elements
-			typedef CDynamicPtrArray<CHashSetElem, CleanupDelete> DrgHashChain;
-			DrgHashChain **m_ppdrgchain;
+			// number of entries that fit without growing
+			ULONG m_ulCapacity;
 
-			// array for elements
-			// We use CleanupNULL because the elements are owned by the hash table
-			typedef CDynamicPtrArray<T, CleanupNULL> DrgElements;
-			DrgElements *const m_pdrgElements;
+			// entries in insertion order
+			SEntry *m_rgentry;
 
-			DrgPi *const m_pdrgPiFilledBuckets;
+			// slot table of (twice the capacity) entry positions plus one;
+			// zero marks an empty slot
+			ULONG *m_rgulSlot;
+
+			// log2 of number of slots
+			ULONG m_ulSlotBits;
 
 			// private copy ctor
 			CHashSet(const CHashSet<T, pfnHash, pfnEq, pfnDestroy> &);
+			
+			// home slot of a hash value; multiplicative hashing spreads weak hash
+			// values, such as small integers, over the whole slot table
+			ULONG UlHomeSlot(ULONG ulHash) const
+			{
+				GPOS_ASSERT(0 < m_ulSlotBits);
+				return (ULONG) (ulHash * 2654435769u) >> (32 - m_ulSlotBits);
+			}
+
+			// slot mask
+			ULONG UlSlotMask() const
+			{
+				return (1u << m_ulSlotBits) - 1;
+			}
+
+			// lookup an entry
+			SEntry *Pentry(const T *pt) const
+			{
+				GPOS_ASSERT(NULL != pt);
+
+				if (0 == m_ulEntries)
+				{
+					return NULL;
+				}
+
+				const ULONG ulHash = pfnHash(pt);
+				const ULONG ulMask = UlSlotMask();
+				for (ULONG ulSlot = UlHomeSlot(ulHash); 0 != m_rgulSlot[ulSlot]; ulSlot = (ulSlot + 1) & ulMask)
+				{
+					SEntry *pentry = &m_rgentry[m_rgulSlot[ulSlot] - 1];
+					if (pentry->m_ulHash == ulHash && pfnEq(pentry->m_pt, pt))
+					{
+						return pentry;
+					}
+				}
+
+				return NULL;
+			}
 
-			// lookup appropriate hash chain in static table, may be NULL if
-			// no elements have been inserted yet
-			DrgHashChain **PpdrgChain(const T *pt) const
+			// enter position of an entry into the slot table
+			void InsertSlot(ULONG ulPos)
 			{
-				GPOS_ASSERT(NULL != m_ppdrgchain);
-				return &m_ppdrgchain[pfnHash(pt) % m_ulSize];
+				const ULONG ulMask = UlSlotMask();
+				ULONG ulSlot = UlHomeSlot(m_rgentry[ulPos].m_ulHash);
+				while (0 != m_rgulSlot[ulSlot])
+				{
+					ulSlot = (ulSlot + 1) & ulMask;
+				}
+				m_rgulSlot[ulSlot] = ulPos + 1;
 			}
 
-			// clear elements
-			void Clear()
-            {
-                for (ULONG i = 0; i < m_pdrgPiFilledBuckets->UlLength(); i++)
-                {
-                    // release each hash chain
-                    m_ppdrgchain[*(*m_pdrgPiFilledBuckets)[i]]->Release();
-                }
-                m_ulEntries = 0;
-                m_pdrgPiFilledBuckets->Clear();
-            }
-
-			// lookup an element by its key
-			void Lookup(const T *pt, CHashSetElem **pphse) const
-            {
-                GPOS_ASSERT(NULL != pphse);
-
-                CHashSetElem hse(const_cast<T*>(pt), false /*fOwn*/);
-                CHashSetElem *phse = NULL;
-                DrgHashChain **ppdrgchain = PpdrgChain(pt);
-                if (NULL != *ppdrgchain)
-                {
-                    phse = (*ppdrgchain)->PtLookup(&hse);
-                    GPOS_ASSERT_IMP(NULL != phse, *phse == hse);
-                }
-
-                *pphse = phse;
-            }
+			// grow entry array and slot table to hold at least the given number of entries
+			void Grow(ULONG ulCapacity)
+			{
+				GPOS_ASSERT(ulCapacity > m_ulCapacity);
+
+				ULONG ulSlotBits = 1;
+				while ((1u << ulSlotBits) < 2 * ulCapacity)
+				{
+					ulSlotBits++;
+				}
+				ulCapacity = (1u << ulSlotBits) / 2;
+
+				// allocate both arrays before touching the map, so that the map
+				// remains intact if allocation fails
+				SEntry *rgentry = GPOS_NEW_ARRAY(m_pmp, SEntry, ulCapacity);
+				ULONG *rgulSlot = NULL;
+				GPOS_TRY
+				{
+					rgulSlot = GPOS_NEW_ARRAY(m_pmp, ULONG, 1u << ulSlotBits);
+				}
+				GPOS_CATCH_EX(ex)
+				{
+					GPOS_DELETE_ARRAY(rgentry);
+					GPOS_RETHROW(ex);
+				}
+				GPOS_CATCH_END;
+
+				if (0 < m_ulEntries)
+				{
+					(void) clib::PvMemCpy(rgentry, m_rgentry, m_ulEntries * sizeof(SEntry));
+				}
+				(void) clib::PvMemSet(rgulSlot, 0, (1u << ulSlotBits) * sizeof(ULONG));
+
+				GPOS_DELETE_ARRAY(m_rgentry);
+				GPOS_DELETE_ARRAY(m_rgulSlot);
+
+				m_rgentry = rgentry;
+				m_rgulSlot = rgulSlot;
+				m_ulCapacity = ulCapacity;
+				m_ulSlotBits = ulSlotBits;
+
+				for (ULONG ul = 0; ul < m_ulEntries; ul++)
+				{
+					InsertSlot(ul);
+				}
+			}
 
 		public:
 
-			// ctor
+			// ctor; the size is the expected number of elements
 			CHashSet<T, pfnHash, pfnEq, pfnDestroy> (IMemoryPool *pmp, ULONG ulSize = 128)
-            :
-            m_pmp(pmp),
-            m_ulSize(ulSize),
-            m_ulEntries(0),
-            m_ppdrgchain(GPOS_NEW_ARRAY(m_pmp, DrgHashChain*, m_ulSize)),
-            m_pdrgElements(GPOS_NEW(m_pmp) DrgElements(m_pmp)),
-            m_pdrgPiFilledBuckets(GPOS_NEW(pmp) DrgPi(pmp))
-            {
-                GPOS_ASSERT(ulSize > 0);
-
-                (void) clib::PvMemSet(m_ppdrgchain, 0, m_ulSize * sizeof(DrgHashChain*));
-            }
+			:
+			m_pmp(pmp),
+			m_ulEntries(0),
+			m_ulCapacity(0),
+			m_rgentry(NULL),
+			m_rgulSlot(NULL),
+			m_ulSlotBits(0)
+			{
+				GPOS_ASSERT(NULL != pmp);
+
+				if (0 < ulSize)
+				{
+					Grow(ulSize);
+				}
+			}
 
 			// dtor
 			~CHashSet<T, pfnHash, pfnEq, pfnDestroy> ()
-            {
-                // release all hash chains
-                Clear();
+			{
+				for (ULONG ul = 0; ul < m_ulEntries; ul++)
+				{
+					pfnDestroy(m_rgentry[ul].m_pt);
+				}
 
-                GPOS_DELETE_ARRAY(m_ppdrgchain);
-                m_pdrgElements->Release();
-                m_pdrgPiFilledBuckets->Release();
-            }
+				GPOS_DELETE_ARRAY(m_rgentry);
+				GPOS_DELETE_ARRAY(m_rgulSlot);
+			}
 
 			// insert an element if not present
 			BOOL FInsert(T *pt)
-            {
-                if (FExists(pt))
-                {
-                    return false;
-                }
+			{
+				GPOS_ASSERT(NULL != pt);
 
-                DrgHashChain **ppdrgchain = PpdrgChain(pt);
-                if (NULL == *ppdrgchain)
-                {
-                    *ppdrgchain = GPOS_NEW(m_pmp) DrgHashChain(m_pmp);
-                    INT iBucket = pfnHash(pt) % m_ulSize;
-                    m_pdrgPiFilledBuckets->Append(GPOS_NEW(m_pmp) INT(iBucket));
-                }
+				if (FExists(pt))
+				{
+					return false;
+				}
 
-                CHashSetElem *phse = GPOS_NEW(m_pmp) CHashSetElem(pt, true /*fOwn*/);
-                (*ppdrgchain)->Append(phse);
+				if (m_ulEntries == m_ulCapacity)
+				{
+					Grow(std::max((ULONG) GPOS_HASHSET_MIN_ENTRIES, 2 * m_ulCapacity));
+				}
 
-                m_ulEntries++;
-                m_pdrgElements->Append(pt);
+				SEntry *pentry = &m_rgentry[m_ulEntries];
+				pentry->m_pt = pt;
+				pentry->m_ulHash = pfnHash(pt);
+				InsertSlot(m_ulEntries);
 
-                return true;
-            }
+				m_ulEntries++;
+
+				return true;
+			}
 
 			// lookup element
 			BOOL FExists(const T *pt) const
-            {
-                CHashSetElem hse(const_cast<T*>(pt), false /*fOwn*/);
-                DrgHashChain **ppdrgchain = PpdrgChain(pt);
-                if (NULL != *ppdrgchain)
-                {
-                    CHashSetElem *phse = (*ppdrgchain)->PtLookup(&hse);
-
-                    return (NULL != phse);
-                }
-
-                return false;
-            }
+			{
+				return NULL != Pentry(pt);
+			}
 
 			// return number of map entries
 			ULONG UlEntries() const
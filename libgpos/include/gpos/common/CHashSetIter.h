@@ -9,12 +9,11 @@
 #include "gpos/base.h"
 #include "gpos/common/CStackObject.h"
 #include "gpos/common/CHashSet.h"
-#include "gpos/common/CDynamicPtrArray.h"
 
 namespace gpos
 {	
 
-	// Hash set iterator
+	// Hash set iterator; visits elements in insertion order
 	template <class T,
 				ULONG (*pfnHash)(const T*), 
 				BOOL (*pfnEq)(const T*, const T*),
@@ -30,39 +29,22 @@ namespace gpos
 			// set to iterate
 			const TSet *m_pts;
 
-			// current hashchain
-			ULONG m_ulChain;
-
-			// current element
+			// position of current element plus one
 			ULONG m_ulElement;
 
-			// is initialized?
-			BOOL m_fInit;
-
 			// private copy ctor
 			CHashSetIter(const CHashSetIter<T, pfnHash, pfnEq, pfnDestroy> &);
-			
-			// method to return the current element
-			const typename TSet::CHashSetElem *Phse() const
-            {
-                typename TSet::CHashSetElem *phse = NULL;
-                T *t = (*(m_pts->m_pdrgElements))[m_ulElement-1];
-                m_pts->Lookup(t, &phse);
-
-                return phse;
-            }
 
 		public:
 		
 			// ctor
 			CHashSetIter<T, pfnHash, pfnEq, pfnDestroy> (TSet *pts)
-            :
-            m_pts(pts),
-            m_ulChain(0),
-            m_ulElement(0)
-            {
-                GPOS_ASSERT(NULL != pts);
-            }
+			:
+			m_pts(pts),
+			m_ulElement(0)
+			{
+				GPOS_ASSERT(NULL != pts);
+			}
 
 			// dtor
 			virtual
@@ -71,26 +53,23 @@ namespace gpos
 
 			// advance iterator to next element
 			BOOL FAdvance()
-            {
-                if (m_ulElement < m_pts->m_pdrgElements->UlLength())
-                {
-                    m_ulElement++;
-                    return true;
-                }
+			{
+				if (m_ulElement < m_pts->m_ulEntries)
+				{
+					m_ulElement++;
+					return true;
+				}
 
-                return false;
-            }
+				return false;
+			}
 
 			// current element
 			const T *Pt() const
-            {
-                const typename TSet::CHashSetElem *phse = Phse();
-                if (NULL != phse)
-                {
-                    return phse->Pt();
-                }
-                return NULL;
-            }
+			{
+				GPOS_ASSERT(0 < m_ulElement && m_ulElement <= m_pts->m_ulEntries);
+
+				return m_pts->m_rgentry[m_ulElement - 1].m_pt;
+			}
 
 	}; // class CHashSetIter
 
@@ -0,0 +1,265 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2018 Pivotal, Inc.
+//
+//	@filename:
+//		CLockFreeCache.h
+//
+//	@doc:
+//		Insert-only concurrent cache counting its lookups and hits;
+//		built on CLockFreeHashtable
+//---------------------------------------------------------------------------
+#ifndef GPOS_CLockFreeCache_H
+#define GPOS_CLockFreeCache_H
+
+#include "gpos/base.h"
+
+#include "gpos/common/CLockFreeHashtable.h"
+#include "gpos/sync/atomic.h"
+
+namespace gpos
+{
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CLockFreeCache<K, T, pfnHash, pfnEq, pfnDestroyK, pfnDestroyT>
+	//
+	//	@doc:
+	//		Cache mapping keys to values that can be filled by several workers
+	//		at once; the value inserted first under a key wins, and later
+	//		insertions under an equal key destroy their key and value and
+	//		return the cached value instead. Entries live until the cache is
+	//		destroyed.
+	//
+	//		Lookups, hits and entries are counted atomically to report the
+	//		effectiveness of the cache.
+	//
+	//---------------------------------------------------------------------------
+	template <class K, class T,
+				ULONG (*pfnHash)(const K*),
+				BOOL (*pfnEq)(const K*, const K*),
+				void (*pfnDestroyK)(K*),
+				void (*pfnDestroyT)(T*)>
+	class CLockFreeCache
+	{
+		private:
+
+			//---------------------------------------------------------------------------
+			//	@struct:
+			//		SEntry
+			//
+			//	@doc:
+			//		Cached key and value
+			//
+			//---------------------------------------------------------------------------
+			struct SEntry
+			{
+				// key
+				K *m_pk;
+
+				// value
+				T *m_pt;
+
+				// link for hash table
+				SLink m_link;
+
+				// hash function
+				static
+				ULONG UlHash
+					(
+					const SEntry &entry
+					)
+				{
+					return pfnHash(entry.m_pk);
+				}
+
+				// equality function
+				static
+				BOOL FEqual
+					(
+					const SEntry &entryFst,
+					const SEntry &entrySnd
+					)
+				{
+					return pfnEq(entryFst.m_pk, entrySnd.m_pk);
+				}
+
+				// release entry
+				static
+				void Destroy
+					(
+					SEntry *pentry
+					)
+				{
+					pfnDestroyK(pentry->m_pk);
+					pfnDestroyT(pentry->m_pt);
+					GPOS_DELETE(pentry);
+				}
+
+			}; // struct SEntry
+
+			// hash table of cached entries
+			typedef
+				CLockFreeHashtable<
+					SEntry, // entry
+					SEntry> // search key
+					Lfht;
+
+			// memory pool
+			IMemoryPool *m_pmp;
+
+			// hash table of cached entries
+			Lfht m_lfht;
+
+			// number of lookups
+			volatile ULONG_PTR m_ulpLookups;
+
+			// number of lookups that found a cached value
+			volatile ULONG_PTR m_ulpHits;
+
+			// number of cached entries
+			volatile ULONG_PTR m_ulpEntries;
+
+			// private copy ctor
+			CLockFreeCache(const CLockFreeCache &);
+
+		public:
+
+			// ctor
+			CLockFreeCache
+				(
+				IMemoryPool *pmp,
+				ULONG ulBuckets
+				)
+				:
+				m_pmp(pmp),
+				m_ulpLookups(0),
+				m_ulpHits(0),
+				m_ulpEntries(0)
+			{
+				GPOS_ASSERT(NULL != pmp);
+
+				m_lfht.Init
+					(
+					pmp,
+					ulBuckets,
+					GPOS_OFFSET(SEntry, m_link),
+					0, /*cKeyOffset (0 because we use SEntry struct as key)*/
+					SEntry::UlHash,
+					SEntry::FEqual
+					);
+			}
+
+			// dtor
+			~CLockFreeCache()
+			{
+				m_lfht.DestroyEntries(SEntry::Destroy);
+			}
+
+			// lookup the value cached under a key; returns NULL if there is none
+			T *PtLookup
+				(
+				K *pk
+				)
+			{
+				GPOS_ASSERT(NULL != pk);
+
+				(void) UlpExchangeAdd(&m_ulpLookups, 1);
+
+				SEntry entryKey;
+				entryKey.m_pk = pk;
+				entryKey.m_pt = NULL;
+				SEntry *pentry = m_lfht.PtLookup(entryKey);
+				if (NULL == pentry)
+				{
+					return NULL;
+				}
+
+				(void) UlpExchangeAdd(&m_ulpHits, 1);
+
+				return pentry->m_pt;
+			}
+
+			// cache a value under a key, taking ownership of both; if another
+			// worker cached a value under an equal key first, the given key and
+			// value are destroyed and the cached value is returned
+			T *PtInsert
+				(
+				K *pk,
+				T *pt
+				)
+			{
+				GPOS_ASSERT(NULL != pk);
+				GPOS_ASSERT(NULL != pt);
+
+				SEntry *pentry = GPOS_NEW(m_pmp) SEntry;
+				pentry->m_pk = pk;
+				pentry->m_pt = pt;
+
+				SEntry *pentryFound = m_lfht.PtInsert(pentry);
+				if (pentryFound != pentry)
+				{
+					SEntry::Destroy(pentry);
+				}
+				else
+				{
+					(void) UlpExchangeAdd(&m_ulpEntries, 1);
+				}
+
+				return pentryFound->m_pt;
+			}
+
+			// number of lookups
+			ULONG_PTR UlpLookups() const
+			{
+				return m_ulpLookups;
+			}
+
+			// number of lookups that found a cached value
+			ULONG_PTR UlpHits() const
+			{
+				return m_ulpHits;
+			}
+
+			// number of cached entries
+			ULONG_PTR UlpEntries() const
+			{
+				return m_ulpEntries;
+			}
+
+			// number of insertions retried due to concurrent insertions
+			ULONG_PTR UlpInsertRetries() const
+			{
+				return m_lfht.UlpInsertRetries();
+			}
+
+			// print hit rate; entries are printed with the given description
+			IOstream &OsPrint
+				(
+				IOstream &os,
+				const CHAR *szEntries
+				)
+				const
+			{
+				ULONG_PTR ulpLookups = m_ulpLookups;
+				ULONG_PTR ulpHits = m_ulpHits;
+				ULONG ulHitRate = 0;
+				if (0 < ulpLookups)
+				{
+					ulHitRate = (ULONG) ((100 * ulpHits) / ulpLookups);
+				}
+
+				return os
+					<< (ULONG) ulpLookups << " lookups"
+					<< ", " << (ULONG) ulpHits << " hits (" << ulHitRate << "%)"
+					<< ", " << (ULONG) m_ulpEntries << " " << szEntries
+					<< ", " << (ULONG) UlpInsertRetries() << " insert retries";
+			}
+
+	}; // class CLockFreeCache
+
+}
+
+#endif // !GPOS_CLockFreeCache_H
+
+// EOF
@@ -0,0 +1,381 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CLockFreeHashtable.h
+//
+//	@doc:
+//		Allocation-less, insert-only concurrent hashtable;
+//
+//		1)	Hashtable is static and cannot resize during operations;
+//		2)	expects target type to have SLink (see CList.h) and Key
+//			members, like CSyncHashtable;
+//		3)	clients must provide their own hash function;
+//		4)	entries are prepended to bucket chains by compare-and-swap on
+//			the bucket head; lookups and insertions take no locks;
+//		5)	entries cannot be removed while the hashtable is accessed
+//			concurrently; Reset and DestroyEntries are not thread-safe
+//---------------------------------------------------------------------------
+#ifndef GPOS_CLockFreeHashtable_H
+#define GPOS_CLockFreeHashtable_H
+
+#include "gpos/base.h"
+
+#include "gpos/common/CList.h"
+#include "gpos/sync/atomic.h"
+#include "gpos/task/CAutoSuspendAbort.h"
+
+namespace gpos
+{
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CLockFreeHashtable<T, K>
+	//
+	//	@doc:
+	//		Insert-only hash table for insert-mostly structures, such as the
+	//		memo; PtInsert atomically inserts an entry unless an entry with an
+	//		equal key is present, in which case the present entry is returned.
+	//
+	//		An inserting thread scans the bucket chain for an equal key and
+	//		then tries to swap its entry in as the new chain head; if another
+	//		thread changed the head in between, only the entries prepended
+	//		since the previous scan are checked before retrying. Failed swaps
+	//		are counted to report contention.
+	//
+	//---------------------------------------------------------------------------
+	template <class T, class K>
+	class CLockFreeHashtable
+	{
+		private:
+
+			// bucket heads
+			T **m_rgptBucket;
+
+			// number of ht buckets
+			ULONG m_cSize;
+
+			// offset of link
+			ULONG m_cLinkOffset;
+
+			// offset of key
+			ULONG m_cKeyOffset;
+
+			// number of ht entries
+			volatile ULONG_PTR m_ulpEntries;
+
+			// number of failed compare-and-swap attempts
+			volatile ULONG_PTR m_ulpInsertRetries;
+
+			// pointer to hashing function
+			ULONG (*m_pfuncHash)(const K&);
+
+			// pointer to key equality function
+			BOOL (*m_pfuncEqual)(const K&, const K&);
+
+			// no copy ctor
+			CLockFreeHashtable(const CLockFreeHashtable &);
+
+			// extract key out of type
+			const K &Key
+				(
+				const T *pt
+				)
+				const
+			{
+				GPOS_ASSERT(gpos::ulong_max != m_cKeyOffset &&
+							"Key offset not initialized.");
+
+				return *(const K*)((const BYTE*)pt + m_cKeyOffset);
+			}
+
+			// extract link out of type
+			SLink &Link
+				(
+				const T *pt
+				)
+				const
+			{
+				return *(SLink*)((BYTE*)pt + m_cLinkOffset);
+			}
+
+			// function to compute bucket index for key
+			ULONG UlBucketIndex
+				(
+				const K &key
+				)
+				const
+			{
+				GPOS_ASSERT(NULL != m_rgptBucket && "Hashtable not initialized");
+
+				return m_pfuncHash(key) % m_cSize;
+			}
+
+			// read current head of a bucket
+			T *PtHead
+				(
+				ULONG ulBucket
+				)
+				const
+			{
+				return *(T * volatile *) &m_rgptBucket[ulBucket];
+			}
+
+			// lookup key in a chain, stopping at a given entry
+			T *PtFind
+				(
+				const K &key,
+				T *ptFirst,
+				T *ptStop
+				)
+				const
+			{
+				for (T *pt = ptFirst; pt != ptStop; pt = PtNext(pt))
+				{
+					if (m_pfuncEqual(Key(pt), key))
+					{
+						return pt;
+					}
+				}
+
+				return NULL;
+			}
+
+		public:
+
+			// type definition of function used to cleanup element
+			typedef void (*DestroyEntryFuncPtr)(T *);
+
+			// ctor
+			CLockFreeHashtable<T, K>()
+				:
+				m_rgptBucket(NULL),
+				m_cSize(0),
+				m_cLinkOffset(gpos::ulong_max),
+				m_cKeyOffset(gpos::ulong_max),
+				m_ulpEntries(0),
+				m_ulpInsertRetries(0),
+				m_pfuncHash(NULL),
+				m_pfuncEqual(NULL)
+			{}
+
+			// dtor
+			// deallocates hashtable internals, does not destroy
+			// client objects
+			~CLockFreeHashtable<T, K>()
+			{
+				Cleanup();
+			}
+
+			// initialization of hashtable
+			void Init
+				(
+				IMemoryPool *pmp,
+				ULONG cSize,
+				ULONG cLinkOffset,
+				ULONG cKeyOffset,
+				ULONG (*pfuncHash)(const K&),
+				BOOL (*pfuncEqual)(const K&, const K&)
+				)
+			{
+				GPOS_ASSERT(NULL == m_rgptBucket);
+				GPOS_ASSERT(0 < cSize);
+				GPOS_ASSERT(NULL != pfuncHash);
+				GPOS_ASSERT(NULL != pfuncEqual);
+
+				m_rgptBucket = GPOS_NEW_ARRAY(pmp, T*, cSize);
+				(void) clib::PvMemSet(m_rgptBucket, 0, cSize * sizeof(T*));
+
+				m_cSize = cSize;
+				m_cLinkOffset = cLinkOffset;
+				m_cKeyOffset = cKeyOffset;
+				m_pfuncHash = pfuncHash;
+				m_pfuncEqual = pfuncEqual;
+			}
+
+			// dealloc bucket range and reset members
+			void Cleanup()
+			{
+				GPOS_DELETE_ARRAY(m_rgptBucket);
+				m_rgptBucket = NULL;
+
+				m_cSize = 0;
+			}
+
+			// lookup entry by key
+			T *PtLookup
+				(
+				const K &key
+				)
+				const
+			{
+				return PtFind(key, PtHead(UlBucketIndex(key)), NULL /*ptStop*/);
+			}
+
+			// insert entry unless an entry with an equal key exists;
+			// returns the given entry if it was inserted, the existing entry otherwise
+			T *PtInsert
+				(
+				T *pt
+				)
+			{
+				GPOS_ASSERT(NULL != pt);
+
+				const K &key = Key(pt);
+				const ULONG ulBucket = UlBucketIndex(key);
+				SLink &link = Link(pt);
+
+				GPOS_ASSERT(NULL == link.m_pvNext);
+
+				T *ptStop = NULL;
+				ULONG ulAttempts = 0;
+				while (true)
+				{
+					T *ptHead = PtHead(ulBucket);
+
+					// entries behind the previously seen head were checked already
+					T *ptFound = PtFind(key, ptHead, ptStop);
+					if (NULL != ptFound)
+					{
+						link.m_pvNext = NULL;
+						return ptFound;
+					}
+
+					link.m_pvNext = ptHead;
+					if (FCompareSwap<T>((volatile T**) &m_rgptBucket[ulBucket], ptHead, pt))
+					{
+						(void) UlpExchangeAdd(&m_ulpEntries, 1);
+						return pt;
+					}
+
+					(void) UlpExchangeAdd(&m_ulpInsertRetries, 1);
+					ptStop = ptHead;
+
+					if (++ulAttempts == GPOS_SPIN_ATTEMPTS)
+					{
+						// back-off
+						clib::USleep(GPOS_SPIN_BACKOFF);
+
+						ulAttempts = 0;
+					}
+				}
+			}
+
+			// first entry of the hashtable in bucket order
+			T *PtFirst() const
+			{
+				for (ULONG ul = 0; ul < m_cSize; ul++)
+				{
+					T *pt = PtHead(ul);
+					if (NULL != pt)
+					{
+						return pt;
+					}
+				}
+
+				return NULL;
+			}
+
+			// next entry in the same bucket
+			T *PtNext
+				(
+				const T *pt
+				)
+				const
+			{
+				GPOS_ASSERT(NULL != pt);
+
+				return static_cast<T*>(Link(pt).m_pvNext);
+			}
+
+			// next entry of the hashtable in bucket order; entries inserted
+			// concurrently may or may not be visited
+			T *PtNextEntry
+				(
+				const T *pt
+				)
+				const
+			{
+				T *ptNext = PtNext(pt);
+				for (ULONG ul = UlBucketIndex(Key(pt)) + 1; NULL == ptNext && ul < m_cSize; ul++)
+				{
+					ptNext = PtHead(ul);
+				}
+
+				return ptNext;
+			}
+
+			// unlink all entries without destroying them and append them to the
+			// given list, if any, which must use the same link; not thread-safe
+			void Reset
+				(
+				CList<T> *plist = NULL
+				)
+			{
+				for (ULONG ul = 0; ul < m_cSize; ul++)
+				{
+					T *pt = m_rgptBucket[ul];
+					m_rgptBucket[ul] = NULL;
+					while (NULL != pt)
+					{
+						T *ptNext = PtNext(pt);
+						Link(pt).m_pvNext = NULL;
+						if (NULL != plist)
+						{
+							plist->Append(pt);
+						}
+						pt = ptNext;
+					}
+				}
+
+				m_ulpEntries = 0;
+			}
+
+			// call destroy function on each entry and unlink all entries;
+			// not thread-safe
+			void DestroyEntries
+				(
+				DestroyEntryFuncPtr pfuncDestroy
+				)
+			{
+				// need to suspend cancellation while cleaning up
+				CAutoSuspendAbort asa;
+
+				for (ULONG ul = 0; ul < m_cSize; ul++)
+				{
+					T *pt = m_rgptBucket[ul];
+					m_rgptBucket[ul] = NULL;
+					while (NULL != pt)
+					{
+						T *ptNext = PtNext(pt);
+						Link(pt).m_pvNext = NULL;
+						pfuncDestroy(pt);
+						pt = ptNext;
+					}
+				}
+
+				m_ulpEntries = 0;
+			}
+
+			// return number of entries
+			ULONG_PTR UlpEntries() const
+			{
+				return m_ulpEntries;
+			}
+
+			// return number of insertions that had to be retried because
+			// of concurrent insertions into the same bucket
+			ULONG_PTR UlpInsertRetries() const
+			{
+				return m_ulpInsertRetries;
+			}
+
+	}; // class CLockFreeHashtable
+
+}
+
+#endif // !GPOS_CLockFreeHashtable_H
+
+// EOF
+
@@ -13,6 +13,7 @@
 #define GPOS_CFileWriter_H
 
 #include "gpos/io/CFileDescriptor.h"
+#include "gpos/io/IByteSink.h"
 
 namespace gpos
 {
@@ -26,7 +27,7 @@ namespace gpos
 	//		does not provide thread-safety
 	//
 	//---------------------------------------------------------------------------
-	class CFileWriter : public CFileDescriptor
+	class CFileWriter : public CFileDescriptor, public IByteSink
 	{
 		private:
 
@@ -58,6 +59,7 @@ namespace gpos
 			void Close();
 
 			// write bytes to file
+			virtual
 			void Write(const BYTE *pb, const ULONG_PTR ullWriteSize);
 
 	};	// class CFileWriter
@@ -0,0 +1,117 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2018 Pivotal, Inc.
+//
+//	@filename:
+//		COstreamUTF8.h
+//
+//	@doc:
+//		Output stream writing UTF-8 to a byte sink;
+//---------------------------------------------------------------------------
+#ifndef GPOS_COstreamUTF8_H
+#define GPOS_COstreamUTF8_H
+
+#include "gpos/io/COstream.h"
+#include "gpos/io/IByteSink.h"
+
+// size of buffer holding encoded bytes until they are passed to the sink
+#define GPOS_OSTREAM_UTF8_BUF_SIZE	(8 * 1024)
+
+namespace gpos
+{
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		COstreamUTF8
+	//
+	//	@doc:
+	//		Implements an output stream that encodes wide characters as UTF-8
+	//		into a fixed-size buffer, and passes the buffer to a byte sink
+	//		whenever it fills up; memory use is bounded regardless of the size
+	//		of the output. Narrow strings are assumed to be UTF-8 already and
+	//		are written unchanged.
+	//
+	//		Flush() must be called once writing is complete; the destructor
+	//		does not flush, since the sink may raise an exception
+	//
+	//---------------------------------------------------------------------------
+	class COstreamUTF8 : public COstream
+	{
+		private:
+
+			// destination of encoded bytes
+			IByteSink *m_psink;
+
+			// encoded bytes not yet passed to the sink
+			BYTE m_rgb[GPOS_OSTREAM_UTF8_BUF_SIZE];
+
+			// number of bytes in buffer
+			ULONG m_ulBuffered;
+
+			// number of bytes passed to the sink so far
+			ULLONG m_ullFlushed;
+
+			// private copy ctor
+			COstreamUTF8(const COstreamUTF8 &);
+
+			// append a single byte
+			void AppendByte
+				(
+				BYTE b
+				)
+			{
+				if (GPOS_OSTREAM_UTF8_BUF_SIZE == m_ulBuffered)
+				{
+					Flush();
+				}
+
+				m_rgb[m_ulBuffered++] = b;
+			}
+
+			// append the UTF-8 encoding of a wide character
+			void AppendWc(WCHAR wc);
+
+		public:
+
+			// please see comments in COstream.h for an explanation
+			using COstream::operator <<;
+
+			// ctor
+			explicit
+			COstreamUTF8(IByteSink *psink);
+
+			// dtor
+			virtual
+			~COstreamUTF8()
+			{}
+
+			// implement << operator on wide char array
+			virtual
+			IOstream& operator<< (const WCHAR *wsz);
+
+			// implement << operator on char array
+			virtual
+			IOstream& operator<< (const CHAR *sz);
+
+			// implement << operator on wide char
+			virtual
+			IOstream& operator<< (const WCHAR wc);
+
+			// implement << operator on char
+			virtual
+			IOstream& operator<< (const CHAR c);
+
+			// pass buffered bytes to the sink
+			void Flush();
+
+			// total number of bytes written to the stream
+			ULLONG UllSize() const
+			{
+				return m_ullFlushed + m_ulBuffered;
+			}
+
+	};	// class COstreamUTF8
+}
+
+#endif // !GPOS_COstreamUTF8_H
+
+// EOF
@@ -0,0 +1,45 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2018 Pivotal, Inc.
+//
+//	@filename:
+//		IByteSink.h
+//
+//	@doc:
+//		Interface for consumers of serialized output bytes;
+//---------------------------------------------------------------------------
+#ifndef GPOS_IByteSink_H
+#define GPOS_IByteSink_H
+
+#include "gpos/types.h"
+
+namespace gpos
+{
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		IByteSink
+	//
+	//	@doc:
+	//		Destination of a byte stream, e.g., a file or a buffer owned by the
+	//		caller; implementations report failures by raising an exception
+	//
+	//---------------------------------------------------------------------------
+	class IByteSink
+	{
+		public:
+
+			// dtor
+			virtual
+			~IByteSink()
+			{}
+
+			// consume the given bytes
+			virtual
+			void Write(const BYTE *pb, const ULONG_PTR ulpSize) = 0;
+
+	};	// class IByteSink
+}
+
+#endif // !GPOS_IByteSink_H
+
+// EOF
@@ -42,7 +42,8 @@ namespace gpos
 			enum EAllocType
 			{
 				EatTracker,
-				EatStack
+				EatStack,
+				EatSlab
 			};
 
 		private:
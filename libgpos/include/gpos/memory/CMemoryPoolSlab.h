@@ -0,0 +1,233 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CMemoryPoolSlab.h
+//
+//	@doc:
+//		Memory pool that serves small requests from size-class slabs and
+//		keeps freed objects on per-thread free lists.
+//
+//	@owner:
+//
+//	@test:
+//
+//---------------------------------------------------------------------------
+#ifndef GPOS_CMemoryPoolSlab_H
+#define GPOS_CMemoryPoolSlab_H
+
+#include "gpos/assert.h"
+#include "gpos/types.h"
+#include "gpos/utils.h"
+#include "gpos/common/CList.h"
+#include "gpos/memory/CMemoryPool.h"
+#include "gpos/sync/CAutoSpinlock.h"
+#include "gpos/sync/CSpinlock.h"
+
+// number of size classes
+#define GPOS_MEM_SLAB_CLASSES		(20)
+
+// largest request served from slabs
+#define GPOS_MEM_SLAB_MAX_OBJECT	(1024)
+
+// number of free list slots; threads are mapped to slots by their id
+#define GPOS_MEM_SLAB_SLOTS			(16)
+
+
+namespace gpos
+{
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CMemoryPoolSlab
+	//
+	//	@doc:
+	//
+	//		Memory pool which rounds small requests up to one of a fixed set of
+	//		size classes and carves them out of 64KB-aligned slabs; each slab
+	//		holds objects of a single size class and records it in its header,
+	//		so objects carry no header of their own and are freed by masking
+	//		their address down to the slab boundary.
+	//
+	//		Freed objects are kept on free lists which are private to the
+	//		freeing thread's slot and are re-used by later requests of the
+	//		same size class. Requests exceeding the largest size class are
+	//		satisfied from the underlying pool; the returned address of such
+	//		requests is offset by half the slab object alignment, which tells
+	//		them apart from slab objects on free.
+	//
+	//		Slab memory is returned to the underlying pool when the pool is
+	//		torn down.
+	//
+	//---------------------------------------------------------------------------
+	class CMemoryPoolSlab : public CMemoryPool
+	{
+		private:
+
+			// slab header
+			struct SSlab
+			{
+				// size class of objects in this slab
+				ULONG m_ulSizeClass;
+
+				// offset of first uncarved byte
+				ULONG m_ulUsed;
+
+				// address returned by the underlying pool; set only for the
+				// first slab of a chunk
+				void *m_pvRaw;
+
+				// link for chunk list
+				SLink m_link;
+			};
+
+			// header of a request served from the underlying pool
+			struct SLargeBlock
+			{
+				// address returned by the underlying pool
+				void *m_pvRaw;
+
+				// size reserved in the underlying pool
+				ULONG m_ulTotal;
+
+				// link for list of large blocks
+				SLink m_link;
+			};
+
+			// free lists owned by a slot
+			struct SSlot
+			{
+				// spinlock to protect free lists; uncontended unless
+				// threads collide on the same slot
+				CSpinlockOS m_slock;
+
+				// free list head per size class
+				void *m_rgpvFree[GPOS_MEM_SLAB_CLASSES];
+			};
+
+			// size of reserved memory
+			volatile ULLONG m_ullReserved;
+
+			// max memory to allow in the pool;
+			// if equal to ULLONG, checks for exceeding max memory are bypassed
+			const ULLONG m_ullCapacity;
+
+			// slab currently carved for each size class
+			SSlab *m_rgpslabCurrent[GPOS_MEM_SLAB_CLASSES];
+
+			// next unused slab of the most recent chunk
+			SSlab *m_pslabNext;
+
+			// number of unused slabs in the most recent chunk
+			ULONG m_ulSlabsLeft;
+
+			// list of chunks, linked through their first slab
+			CList<SSlab> m_listChunks;
+
+			// list of large blocks
+			CList<SLargeBlock> m_listLarge;
+
+			// spinlock to protect slab carving and block lists
+			CSpinlockOS m_slock;
+
+			// free list slots
+			SSlot m_rgslot[GPOS_MEM_SLAB_SLOTS];
+
+			// map allocation size to size class
+			static
+			ULONG UlSizeClass(ULONG ulAlloc);
+
+			// slot of the current thread
+			SSlot *PslotSelf();
+
+			// carve a batch of objects of the given size class
+			void *PvCarve(ULONG ulSizeClass, void **ppvTail);
+
+			// get an empty slab for the given size class
+			SSlab *PslabNew(CAutoSpinlock &as, ULONG ulSizeClass);
+
+			// allocate request from underlying pool
+			void *PvAllocateLarge(ULONG ulAlloc, const CHAR *szFile, const ULONG ulLine);
+
+			// free request allocated from underlying pool
+			void FreeLarge(void *pv);
+
+			// acquire spinlock if pool is thread-safe
+			void SLock(CAutoSpinlock &as)
+			{
+				if (FThreadSafe())
+				{
+					as.Lock();
+				}
+			}
+
+			// release spinlock if pool is thread-safe
+			void SUnlock(CAutoSpinlock &as)
+			{
+				if (FThreadSafe())
+				{
+					as.Unlock();
+				}
+			}
+
+#ifdef GPOS_DEBUG
+			// check if a particular allocation is sound for this memory pool
+			void CheckAllocation(void *pv);
+#endif // GPOS_DEBUG
+
+			// private copy ctor
+			CMemoryPoolSlab(CMemoryPoolSlab &);
+
+		public:
+
+			// ctor
+			CMemoryPoolSlab
+				(
+				IMemoryPool *pmp,
+				ULLONG ullCapacity,
+				BOOL fThreadSafe,
+				BOOL fOwnsUnderlying
+				);
+
+			// dtor
+			virtual
+			~CMemoryPoolSlab();
+
+			// allocate memory
+			virtual
+			void *PvAllocate
+				(
+				const ULONG ulBytes,
+				const CHAR *szFile,
+				const ULONG ulLine
+				);
+
+			// free memory
+			virtual
+			void Free(void *pv);
+
+			// return all used memory to the underlying pool and tear it down
+			virtual
+			void TearDown();
+
+			// check if the pool stores a pointer to itself at the end of
+			// the header of each allocated object;
+			virtual
+			BOOL FStoresPoolPointer() const
+			{
+				return true;
+			}
+
+			// return total allocated size
+			virtual
+			ULLONG UllTotalAllocatedSize() const
+			{
+				return m_ullReserved;
+			}
+	};
+}
+
+#endif // !GPOS_CMemoryPoolSlab_H
+
+// EOF
+
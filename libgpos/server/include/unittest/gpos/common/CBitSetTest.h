@@ -31,7 +31,11 @@ namespace gpos
 			static GPOS_RESULT EresUnittest_Basics();
 			static GPOS_RESULT EresUnittest_Removal();
 			static GPOS_RESULT EresUnittest_SetOps();
+			static GPOS_RESULT EresUnittest_Sparse();
+			static GPOS_RESULT EresUnittest_Inline();
+			static GPOS_RESULT EresUnittest_Random();
 			static GPOS_RESULT EresUnittest_Performance();
+			static GPOS_RESULT EresUnittest_Benchmark();
 
 	}; // class CBitSetTest
 }
@@ -26,12 +26,19 @@ namespace gpos
 	//---------------------------------------------------------------------------
 	class CHashMapTest
 	{
+		private:
+
+			// reference hash map used as the baseline of the benchmark
+			class CChainedMap;
+
 		public:
 
 			// unittests
 			static GPOS_RESULT EresUnittest();
 			static GPOS_RESULT EresUnittest_Basic();
 			static GPOS_RESULT EresUnittest_Ownership();
+			static GPOS_RESULT EresUnittest_Growth();
+			static GPOS_RESULT EresUnittest_Benchmark();
 
 	}; // class CHashMapTest
 }
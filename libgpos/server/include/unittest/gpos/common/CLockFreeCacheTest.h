@@ -0,0 +1,40 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2018 Pivotal, Inc.
+//
+//	@filename:
+//		CLockFreeCacheTest.h
+//
+//	@doc:
+//		Test for CLockFreeCache
+//---------------------------------------------------------------------------
+#ifndef GPOS_CLockFreeCacheTest_H
+#define GPOS_CLockFreeCacheTest_H
+
+#include "gpos/base.h"
+
+namespace gpos
+{
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CLockFreeCacheTest
+	//
+	//	@doc:
+	//		Static unit tests
+	//
+	//---------------------------------------------------------------------------
+	class CLockFreeCacheTest
+	{
+		public:
+
+			// unittests
+			static GPOS_RESULT EresUnittest();
+			static GPOS_RESULT EresUnittest_Basic();
+
+	}; // class CLockFreeCacheTest
+}
+
+#endif // !GPOS_CLockFreeCacheTest_H
+
+// EOF
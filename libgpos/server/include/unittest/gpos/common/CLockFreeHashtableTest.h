@@ -0,0 +1,114 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CLockFreeHashtableTest.h
+//
+//	@doc:
+//		Test for CLockFreeHashtable
+//---------------------------------------------------------------------------
+#ifndef GPOS_CLockFreeHashtableTest_H
+#define GPOS_CLockFreeHashtableTest_H
+
+#include "gpos/base.h"
+#include "gpos/common/CList.h"
+#include "gpos/common/CLockFreeHashtable.h"
+
+namespace gpos
+{
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CLockFreeHashtableTest
+	//
+	//	@doc:
+	//		Static unit tests
+	//
+	//---------------------------------------------------------------------------
+	class CLockFreeHashtableTest
+	{
+		private:
+
+			//---------------------------------------------------------------------------
+			//	@struct:
+			//		SElem
+			//
+			//	@doc:
+			//		Local class for hashtable tests
+			//
+			//---------------------------------------------------------------------------
+			struct SElem
+			{
+				// hash key
+				ULONG m_ulKey;
+
+				// id of task that created the element
+				ULONG m_ulTask;
+
+				// generic link
+				SLink m_link;
+
+				// hash function; maps several keys to the same bucket
+				static
+				ULONG UlHash
+					(
+					const ULONG &ul
+					)
+				{
+					return ul / 4;
+				}
+
+				// key equality function
+				static
+				BOOL FEqual
+					(
+					const ULONG &ul,
+					const ULONG &ulOther
+					)
+				{
+					return ul == ulOther;
+				}
+			};
+
+			// hashtable type
+			typedef CLockFreeHashtable<SElem, ULONG> SElemHashtable;
+
+			//---------------------------------------------------------------------------
+			//	@struct:
+			//		SInserterArgs
+			//
+			//	@doc:
+			//		Arguments of inserter tasks
+			//
+			//---------------------------------------------------------------------------
+			struct SInserterArgs
+			{
+				// hashtable
+				SElemHashtable *m_plfht;
+
+				// elements to insert
+				SElem *m_rgelem;
+
+				// number of elements
+				ULONG m_ulElems;
+			};
+
+			// inserter task
+			static
+			void *PvUnittest_Inserter(void *pv);
+
+		public:
+
+			// unittests
+			static GPOS_RESULT EresUnittest();
+			static GPOS_RESULT EresUnittest_Basic();
+			static GPOS_RESULT EresUnittest_Concurrency();
+
+	}; // class CLockFreeHashtableTest
+}
+
+#endif // !GPOS_CLockFreeHashtableTest_H
+
+// EOF
+
@@ -0,0 +1,98 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2018 Pivotal, Inc.
+//
+//	@filename:
+//		COstreamUTF8Test.h
+//
+//	@doc:
+//		Tests for COstreamUTF8
+//---------------------------------------------------------------------------
+#ifndef GPOS_COstreamUTF8Test_H
+#define GPOS_COstreamUTF8Test_H
+
+#include "gpos/base.h"
+#include "gpos/io/IByteSink.h"
+
+namespace gpos
+{
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		COstreamUTF8Test
+	//
+	//	@doc:
+	//		Static unit tests for UTF-8 output stream
+	//
+	//---------------------------------------------------------------------------
+	class COstreamUTF8Test
+	{
+		private:
+
+			// sink collecting bytes into a fixed-size array
+			class CTestSink : public IByteSink
+			{
+				private:
+
+					// collected bytes
+					BYTE *m_rgb;
+
+					// capacity of array
+					ULONG m_ulCapacity;
+
+					// number of collected bytes
+					ULONG m_ulSize;
+
+					// number of calls to Write
+					ULONG m_ulWrites;
+
+					// size of largest write
+					ULONG m_ulMaxWrite;
+
+					// private copy ctor
+					CTestSink(const CTestSink &);
+
+				public:
+
+					// ctor
+					CTestSink(BYTE *rgb, ULONG ulCapacity);
+
+					// consume the given bytes
+					virtual
+					void Write(const BYTE *pb, const ULONG_PTR ulpSize);
+
+					// accessors
+					const BYTE *Rgb() const
+					{
+						return m_rgb;
+					}
+
+					ULONG UlSize() const
+					{
+						return m_ulSize;
+					}
+
+					ULONG UlWrites() const
+					{
+						return m_ulWrites;
+					}
+
+					ULONG UlMaxWrite() const
+					{
+						return m_ulMaxWrite;
+					}
+			};
+
+		public:
+
+			// unittests
+			static GPOS_RESULT EresUnittest();
+			static GPOS_RESULT EresUnittest_Basic();
+			static GPOS_RESULT EresUnittest_Encoding();
+			static GPOS_RESULT EresUnittest_Chunks();
+	};
+}
+
+#endif // !GPOS_COstreamUTF8Test_H
+
+// EOF
@@ -38,6 +38,8 @@
 #include "unittest/gpos/common/CStackTest.h"
 #include "unittest/gpos/common/CSyncHashtableTest.h"
 #include "unittest/gpos/common/CSyncListTest.h"
+#include "unittest/gpos/common/CLockFreeHashtableTest.h"
+#include "unittest/gpos/common/CLockFreeCacheTest.h"
 
 #include "unittest/gpos/error/CErrorHandlerTest.h"
 #include "unittest/gpos/error/CExceptionTest.h"
@@ -51,6 +53,7 @@
 #include "unittest/gpos/io/COstreamBasicTest.h"
 #include "unittest/gpos/io/COstreamFileTest.h"
 #include "unittest/gpos/io/COstreamStringTest.h"
+#include "unittest/gpos/io/COstreamUTF8Test.h"
 #include "unittest/gpos/io/CFileTest.h"
 
 #include "unittest/gpos/memory/IMemoryPoolTest.h"
@@ -98,6 +101,8 @@ static gpos::CUnittest rgut[] =
 	GPOS_UNITTEST_STD(CStackTest),
 	GPOS_UNITTEST_STD(CSyncHashtableTest),
 	GPOS_UNITTEST_STD(CSyncListTest),
+	GPOS_UNITTEST_STD(CLockFreeHashtableTest),
+	GPOS_UNITTEST_STD(CLockFreeCacheTest),
 
 	// error
 	GPOS_UNITTEST_STD(CErrorHandlerTest),
@@ -111,6 +116,7 @@ static gpos::CUnittest rgut[] =
 	// io
 	GPOS_UNITTEST_STD(COstreamBasicTest),
 	GPOS_UNITTEST_STD(COstreamStringTest),
+	GPOS_UNITTEST_STD(COstreamUTF8Test),
 	GPOS_UNITTEST_STD(COstreamFileTest),
 	GPOS_UNITTEST_STD(CFileTest),
 
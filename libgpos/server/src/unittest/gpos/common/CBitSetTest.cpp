@@ -13,7 +13,10 @@
 #include "gpos/io/COstreamString.h"
 #include "gpos/string/CWStringDynamic.h"
 
+#include "gpos/common/CAutoTimer.h"
 #include "gpos/common/CBitSet.h"
+#include "gpos/common/CBitSetIter.h"
+#include "gpos/common/CRandom.h"
 #include "gpos/memory/CAutoMemoryPool.h"
 #include "gpos/test/CUnittest.h"
 
@@ -37,7 +40,11 @@ CBitSetTest::EresUnittest()
 		GPOS_UNITTEST_FUNC(CBitSetTest::EresUnittest_Basics),
 		GPOS_UNITTEST_FUNC(CBitSetTest::EresUnittest_Removal),
 		GPOS_UNITTEST_FUNC(CBitSetTest::EresUnittest_SetOps),
-		GPOS_UNITTEST_FUNC(CBitSetTest::EresUnittest_Performance)
+		GPOS_UNITTEST_FUNC(CBitSetTest::EresUnittest_Sparse),
+		GPOS_UNITTEST_FUNC(CBitSetTest::EresUnittest_Inline),
+		GPOS_UNITTEST_FUNC(CBitSetTest::EresUnittest_Random),
+		GPOS_UNITTEST_FUNC(CBitSetTest::EresUnittest_Performance),
+		GPOS_UNITTEST_FUNC(CBitSetTest::EresUnittest_Benchmark)
 		};
 
 	return CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
@@ -211,6 +218,256 @@ CBitSetTest::EresUnittest_SetOps()
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CBitSetTest::EresUnittest_Sparse
+//
+//	@doc:
+//		Test for sets of widely spread bits, which are kept in sparse form
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CBitSetTest::EresUnittest_Sparse()
+{
+	// create memory pool
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	ULONG rgul[] = {3, 100, 5000, 1000000, 4000000000u};
+	ULONG rgulOther[] = {7, 100, 1000000};
+
+	ULONG cSizeBits = 64;
+	CBitSet *pbs = GPOS_NEW(pmp) CBitSet(pmp, cSizeBits);
+	for (ULONG i = 0; i < GPOS_ARRAY_SIZE(rgul); i++)
+	{
+		(void) pbs->FExchangeSet(rgul[i]);
+	}
+	GPOS_ASSERT(GPOS_ARRAY_SIZE(rgul) == pbs->CElements());
+
+	// same set built in reverse order
+	CBitSet *pbsReverse = GPOS_NEW(pmp) CBitSet(pmp, cSizeBits);
+	for (ULONG i = GPOS_ARRAY_SIZE(rgul); i > 0; i--)
+	{
+		(void) pbsReverse->FExchangeSet(rgul[i - 1]);
+	}
+	GPOS_ASSERT(pbs->FEqual(pbsReverse) && pbsReverse->FEqual(pbs));
+	GPOS_ASSERT(pbs->UlHash() == pbsReverse->UlHash());
+
+	// bits are iterated in ascending order
+	ULONG ul = 0;
+	CBitSetIter bsiter(*pbs);
+	while (bsiter.FAdvance())
+	{
+		GPOS_ASSERT(rgul[ul] == bsiter.UlBit());
+		ul++;
+	}
+	GPOS_ASSERT(GPOS_ARRAY_SIZE(rgul) == ul);
+
+	CBitSet *pbsOther = GPOS_NEW(pmp) CBitSet(pmp, cSizeBits);
+	for (ULONG i = 0; i < GPOS_ARRAY_SIZE(rgulOther); i++)
+	{
+		(void) pbsOther->FExchangeSet(rgulOther[i]);
+	}
+	GPOS_ASSERT(!pbs->FSubset(pbsOther) && !pbs->FDisjoint(pbsOther));
+
+	CBitSet *pbsCopy = GPOS_NEW(pmp) CBitSet(pmp, *pbs);
+	pbsCopy->Intersection(pbsOther);
+	GPOS_ASSERT(2 == pbsCopy->CElements());
+	GPOS_ASSERT(pbsCopy->FBit(100) && pbsCopy->FBit(1000000));
+	GPOS_ASSERT(pbs->FSubset(pbsCopy));
+
+	pbsCopy->Union(pbs);
+	GPOS_ASSERT(pbsCopy->FEqual(pbs));
+
+	pbsCopy->Difference(pbsOther);
+	GPOS_ASSERT(3 == pbsCopy->CElements());
+	GPOS_ASSERT(pbsCopy->FDisjoint(pbsOther));
+	GPOS_ASSERT(pbsCopy->FBit(4000000000u) && !pbsCopy->FBit(100));
+
+	// clearing all bits yields the empty set
+	for (ULONG i = 0; i < GPOS_ARRAY_SIZE(rgul); i++)
+	{
+		(void) pbsReverse->FExchangeClear(rgul[i]);
+	}
+	CBitSet *pbsEmpty = GPOS_NEW(pmp) CBitSet(pmp, cSizeBits);
+	GPOS_ASSERT(pbsReverse->FEqual(pbsEmpty));
+	GPOS_ASSERT(pbsReverse->UlHash() == pbsEmpty->UlHash());
+
+	// intersection with a set of a different chunk size
+	CBitSet *pbsWide = GPOS_NEW(pmp) CBitSet(pmp, 1024);
+	(void) pbsWide->FExchangeSet(5000);
+	(void) pbsWide->FExchangeSet(4000000000u);
+	pbsCopy->Intersection(pbsWide);
+	GPOS_ASSERT(2 == pbsCopy->CElements());
+	GPOS_ASSERT(pbsCopy->FBit(5000) && pbsCopy->FBit(4000000000u));
+
+	// ... which clears all bits
+	(void) pbsWide->FExchangeClear(5000);
+	(void) pbsWide->FExchangeClear(4000000000u);
+	pbsCopy->Intersection(pbsWide);
+	GPOS_ASSERT(pbsCopy->FEqual(pbsEmpty));
+
+	pbsWide->Release();
+	pbsEmpty->Release();
+	pbsCopy->Release();
+	pbsOther->Release();
+	pbsReverse->Release();
+	pbs->Release();
+
+	return GPOS_OK;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CBitSetTest::EresUnittest_Inline
+//
+//	@doc:
+//		A set whose bits fit into one chunk of the inline storage, e.g. a
+//		column set with a few hundred column ids, does not allocate
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CBitSetTest::EresUnittest_Inline()
+{
+	// create memory pool
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	const ULONG cSizeBits = GPOS_BITSET_INLINE_UNITS * GPOS_SIZEOF(ULLONG) * 8;
+	CBitSet *pbs = GPOS_NEW(pmp) CBitSet(pmp, cSizeBits);
+	CBitSet *pbsOther = GPOS_NEW(pmp) CBitSet(pmp, cSizeBits);
+
+	const ULLONG ullAllocated = pmp->UllTotalAllocatedSize();
+
+	for (ULONG ul = 0; ul < cSizeBits; ul += 3)
+	{
+		(void) pbs->FExchangeSet(ul);
+	}
+
+	for (ULONG ul = 0; ul < cSizeBits; ul += 2)
+	{
+		(void) pbsOther->FExchangeSet(ul);
+	}
+
+	pbs->Union(pbsOther);
+	pbs->Intersection(pbsOther);
+	pbs->Difference(pbsOther);
+	(void) pbs->FExchangeSet(cSizeBits - 1);
+
+	BOOL fInline = (ullAllocated == pmp->UllTotalAllocatedSize());
+
+	pbsOther->Release();
+	pbs->Release();
+
+	return fInline ? GPOS_OK : GPOS_FAILED;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CBitSetTest::EresUnittest_Random
+//
+//	@doc:
+//		Compare set operations on random sets against a control vector
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CBitSetTest::EresUnittest_Random()
+{
+	// create memory pool
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	// ids range over dense and sparse forms
+	const ULONG cTotal = 20000;
+	const ULONG cSizeBits = 256;
+	CRandom rand;
+
+	CHAR *rg1 = GPOS_NEW_ARRAY(pmp, CHAR, cTotal);
+	CHAR *rg2 = GPOS_NEW_ARRAY(pmp, CHAR, cTotal);
+
+	for (ULONG ulRound = 0; ulRound < 20; ulRound++)
+	{
+		// narrow ranges keep sets in dense form, wide ranges make them sparse
+		const ULONG ulRange = (0 == ulRound % 2) ? 2000 : cTotal;
+		const ULONG cInserts = 1 + rand.ULNext() % 200;
+
+		(void) clib::PvMemSet(rg1, 0, cTotal);
+		(void) clib::PvMemSet(rg2, 0, cTotal);
+
+		CBitSet *pbs1 = GPOS_NEW(pmp) CBitSet(pmp, cSizeBits);
+		CBitSet *pbs2 = GPOS_NEW(pmp) CBitSet(pmp, cSizeBits);
+		for (ULONG i = 0; i < cInserts; i++)
+		{
+			ULONG ul1 = rand.ULNext() % ulRange;
+			ULONG ul2 = rand.ULNext() % ulRange;
+			GPOS_ASSERT((1 == rg1[ul1]) == pbs1->FExchangeSet(ul1));
+			GPOS_ASSERT((1 == rg2[ul2]) == pbs2->FExchangeSet(ul2));
+			rg1[ul1] = 1;
+			rg2[ul2] = 1;
+		}
+
+		CBitSet *pbsUnion = GPOS_NEW(pmp) CBitSet(pmp, *pbs1);
+		pbsUnion->Union(pbs2);
+		CBitSet *pbsIntersect = GPOS_NEW(pmp) CBitSet(pmp, *pbs1);
+		pbsIntersect->Intersection(pbs2);
+		CBitSet *pbsDiff = GPOS_NEW(pmp) CBitSet(pmp, *pbs1);
+		pbsDiff->Difference(pbs2);
+
+		ULONG cUnion = 0;
+		ULONG cIntersect = 0;
+		ULONG cDiff = 0;
+		for (ULONG ul = 0; ul < cTotal; ul++)
+		{
+			BOOL f1 = (1 == rg1[ul]);
+			BOOL f2 = (1 == rg2[ul]);
+			GPOS_ASSERT(f1 == pbs1->FBit(ul));
+			GPOS_ASSERT((f1 || f2) == pbsUnion->FBit(ul));
+			GPOS_ASSERT((f1 && f2) == pbsIntersect->FBit(ul));
+			GPOS_ASSERT((f1 && !f2) == pbsDiff->FBit(ul));
+
+			cUnion += (f1 || f2) ? 1 : 0;
+			cIntersect += (f1 && f2) ? 1 : 0;
+			cDiff += (f1 && !f2) ? 1 : 0;
+		}
+
+		GPOS_ASSERT(cUnion == pbsUnion->CElements());
+		GPOS_ASSERT(cIntersect == pbsIntersect->CElements());
+		GPOS_ASSERT(cDiff == pbsDiff->CElements());
+		GPOS_ASSERT(pbsUnion->FSubset(pbs1) && pbsUnion->FSubset(pbs2));
+		GPOS_ASSERT(pbs1->FSubset(pbsIntersect) && pbs2->FSubset(pbsIntersect));
+		GPOS_ASSERT(pbsDiff->FDisjoint(pbs2));
+		GPOS_ASSERT((0 == cIntersect) == pbs1->FDisjoint(pbs2));
+
+		// iteration visits exactly the bits of the control vector
+		ULONG ulPrev = 0;
+		ULONG cBits = 0;
+		CBitSetIter bsiter(*pbsUnion);
+		while (bsiter.FAdvance())
+		{
+			ULONG ulBit = bsiter.UlBit();
+			GPOS_ASSERT(1 == rg1[ulBit] || 1 == rg2[ulBit]);
+			GPOS_ASSERT(0 == cBits || ulPrev < ulBit);
+			ulPrev = ulBit;
+			cBits++;
+		}
+		GPOS_ASSERT(cUnion == cBits);
+
+		pbsDiff->Release();
+		pbsIntersect->Release();
+		pbsUnion->Release();
+		pbs2->Release();
+		pbs1->Release();
+	}
+
+	GPOS_DELETE_ARRAY(rg2);
+	GPOS_DELETE_ARRAY(rg1);
+
+	return GPOS_OK;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CBitSetTest::EresUnittest_Performance
@@ -251,5 +508,127 @@ CBitSetTest::EresUnittest_Performance()
 	return GPOS_OK;
 }	
 
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CBitSetTest::EresUnittest_Benchmark
+//
+//	@doc:
+//		Microbenchmark of set operations on sets shaped like column
+//		reference sets, i.e. a few dozen ids out of a few hundred
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CBitSetTest::EresUnittest_Benchmark()
+{
+	// create memory pool
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	const ULONG cSizeBits = 1024;
+	const ULONG cSets = 64;
+	const ULONG ulRange = 400;
+	const ULONG cElements = 24;
+#ifdef GPOS_DEBUG
+	const ULONG cLoops = 100;
+#else
+	const ULONG cLoops = 10000;
+#endif // GPOS_DEBUG
+
+	CRandom rand;
+	CBitSet *rgpbs[cSets];
+	for (ULONG ul = 0; ul < cSets; ul++)
+	{
+		rgpbs[ul] = GPOS_NEW(pmp) CBitSet(pmp, cSizeBits);
+		for (ULONG ulElem = 0; ulElem < cElements; ulElem++)
+		{
+			(void) rgpbs[ul]->FExchangeSet(rand.ULNext() % ulRange);
+		}
+	}
+
+	ULONG ulSink = 0;
+
+	// scope for timer
+	{
+		CAutoTimer at("BitSet benchmark: copy and union", true /*fPrint*/);
+		for (ULONG ulLoop = 0; ulLoop < cLoops; ulLoop++)
+		{
+			for (ULONG ul = 0; ul + 1 < cSets; ul++)
+			{
+				CBitSet *pbs = GPOS_NEW(pmp) CBitSet(pmp, *rgpbs[ul]);
+				pbs->Union(rgpbs[ul + 1]);
+				ulSink += pbs->CElements();
+				pbs->Release();
+			}
+		}
+	}
+
+	// scope for timer
+	{
+		CAutoTimer at("BitSet benchmark: copy and intersection", true /*fPrint*/);
+		for (ULONG ulLoop = 0; ulLoop < cLoops; ulLoop++)
+		{
+			for (ULONG ul = 0; ul + 1 < cSets; ul++)
+			{
+				CBitSet *pbs = GPOS_NEW(pmp) CBitSet(pmp, *rgpbs[ul]);
+				pbs->Intersection(rgpbs[ul + 1]);
+				ulSink += pbs->CElements();
+				pbs->Release();
+			}
+		}
+	}
+
+	// scope for timer
+	{
+		CAutoTimer at("BitSet benchmark: subset, disjoint and equality", true /*fPrint*/);
+		for (ULONG ulLoop = 0; ulLoop < cLoops; ulLoop++)
+		{
+			for (ULONG ul = 0; ul + 1 < cSets; ul++)
+			{
+				ulSink += rgpbs[ul]->FSubset(rgpbs[ul + 1]) ? 1 : 0;
+				ulSink += rgpbs[ul]->FDisjoint(rgpbs[ul + 1]) ? 1 : 0;
+				ulSink += rgpbs[ul]->FEqual(rgpbs[ul + 1]) ? 1 : 0;
+			}
+		}
+	}
+
+	// scope for timer
+	{
+		CAutoTimer at("BitSet benchmark: hash", true /*fPrint*/);
+		for (ULONG ulLoop = 0; ulLoop < cLoops; ulLoop++)
+		{
+			for (ULONG ul = 0; ul < cSets; ul++)
+			{
+				ulSink += rgpbs[ul]->UlHash();
+			}
+		}
+	}
+
+	// scope for timer
+	{
+		CAutoTimer at("BitSet benchmark: iteration", true /*fPrint*/);
+		for (ULONG ulLoop = 0; ulLoop < cLoops; ulLoop++)
+		{
+			for (ULONG ul = 0; ul < cSets; ul++)
+			{
+				CBitSetIter bsiter(*rgpbs[ul]);
+				while (bsiter.FAdvance())
+				{
+					ulSink += bsiter.UlBit();
+				}
+			}
+		}
+	}
+
+	for (ULONG ul = 0; ul < cSets; ul++)
+	{
+		rgpbs[ul]->Release();
+	}
+
+	GPOS_TRACE_FORMAT("BitSet benchmark checksum: %u", ulSink);
+
+	return GPOS_OK;
+}
+
 // EOF
 
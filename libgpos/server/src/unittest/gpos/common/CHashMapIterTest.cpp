@@ -67,7 +67,7 @@ CHashMapIterTest::EresUnittest_Basic()
 		CleanupNULL<ULONG>, CleanupNULL<ULONG> > MapIter;
 
 
-	// using N - 2 slots guarantees collisions
+	// an undersized hint forces the map to grow during the test
 	Map *pm = GPOS_NEW(pmp) Map(pmp, ulCnt - 2);
 
 #ifdef GPOS_DEBUG
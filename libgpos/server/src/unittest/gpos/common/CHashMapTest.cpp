@@ -10,7 +10,10 @@
 //---------------------------------------------------------------------------
 
 #include "gpos/base.h"
+#include "gpos/common/CAutoTimer.h"
+#include "gpos/common/CDynamicPtrArray.h"
 #include "gpos/common/CHashMap.h"
+#include "gpos/common/CHashMapIter.h"
 #include "gpos/memory/CAutoMemoryPool.h"
 #include "gpos/test/CUnittest.h"
 
@@ -18,6 +21,108 @@
 
 using namespace gpos;
 
+//---------------------------------------------------------------------------
+//	@class:
+//		CHashMapTest::CChainedMap
+//
+//	@doc:
+//		Reference hash map with a fixed number of buckets, each a chain of
+//		entries; used as the baseline of the hash map benchmark
+//
+//---------------------------------------------------------------------------
+class CHashMapTest::CChainedMap
+{
+	private:
+
+		// key/value pair
+		struct SElem
+		{
+			const ULONG *m_pulKey;
+			ULONG *m_pulValue;
+
+			// equality on keys, used for chain lookup
+			BOOL operator == (const SElem &elem) const
+			{
+				return *m_pulKey == *elem.m_pulKey;
+			}
+		};
+
+		typedef CDynamicPtrArray<SElem, CleanupDelete> DrgPelem;
+
+		// memory pool
+		IMemoryPool *m_pmp;
+
+		// number of buckets
+		ULONG m_ulBuckets;
+
+		// bucket chains, allocated on first use
+		DrgPelem **m_rgpdrgpelem;
+
+		// private copy ctor
+		CChainedMap(const CChainedMap &);
+
+	public:
+
+		// ctor
+		CChainedMap(IMemoryPool *pmp, ULONG ulBuckets)
+		:
+		m_pmp(pmp),
+		m_ulBuckets(ulBuckets),
+		m_rgpdrgpelem(GPOS_NEW_ARRAY(pmp, DrgPelem*, ulBuckets))
+		{
+			(void) clib::PvMemSet(m_rgpdrgpelem, 0, ulBuckets * sizeof(DrgPelem*));
+		}
+
+		// dtor
+		~CChainedMap()
+		{
+			for (ULONG ul = 0; ul < m_ulBuckets; ul++)
+			{
+				CRefCount::SafeRelease(m_rgpdrgpelem[ul]);
+			}
+			GPOS_DELETE_ARRAY(m_rgpdrgpelem);
+		}
+
+		// lookup value by key
+		ULONG *PulLookup(const ULONG *pulKey) const
+		{
+			DrgPelem *pdrgpelem = m_rgpdrgpelem[UlHash<ULONG>(pulKey) % m_ulBuckets];
+			if (NULL == pdrgpelem)
+			{
+				return NULL;
+			}
+
+			SElem elem;
+			elem.m_pulKey = pulKey;
+			elem.m_pulValue = NULL;
+			SElem *pelem = pdrgpelem->PtLookup(&elem);
+
+			return (NULL == pelem) ? NULL : pelem->m_pulValue;
+		}
+
+		// insert key if not present
+		BOOL FInsert(const ULONG *pulKey, ULONG *pulValue)
+		{
+			if (NULL != PulLookup(pulKey))
+			{
+				return false;
+			}
+
+			DrgPelem **ppdrgpelem = &m_rgpdrgpelem[UlHash<ULONG>(pulKey) % m_ulBuckets];
+			if (NULL == *ppdrgpelem)
+			{
+				*ppdrgpelem = GPOS_NEW(m_pmp) DrgPelem(m_pmp);
+			}
+
+			SElem *pelem = GPOS_NEW(m_pmp) SElem;
+			pelem->m_pulKey = pulKey;
+			pelem->m_pulValue = pulValue;
+			(*ppdrgpelem)->Append(pelem);
+
+			return true;
+		}
+}; // class CHashMapTest::CChainedMap
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CHashMapTest::EresUnittest
@@ -33,6 +138,8 @@ CHashMapTest::EresUnittest()
 		{
 		GPOS_UNITTEST_FUNC(CHashMapTest::EresUnittest_Basic),
 		GPOS_UNITTEST_FUNC(CHashMapTest::EresUnittest_Ownership),
+		GPOS_UNITTEST_FUNC(CHashMapTest::EresUnittest_Growth),
+		GPOS_UNITTEST_FUNC(CHashMapTest::EresUnittest_Benchmark),
 		};
 
 	return CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
@@ -186,5 +293,158 @@ CHashMapTest::EresUnittest_Ownership()
 	return GPOS_OK;
 }
 
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CHashMapTest::EresUnittest_Growth
+//
+//	@doc:
+//		Insert far more entries than the size hint and check lookups and
+//		insertion order of iteration while the map grows
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CHashMapTest::EresUnittest_Growth()
+{
+	// create memory pool
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	typedef CHashMap<ULONG, ULONG, UlHash<ULONG>, gpos::FEqual<ULONG>,
+		CleanupDelete<ULONG>, CleanupDelete<ULONG> > HMUlUl;
+
+	typedef CHashMapIter<ULONG, ULONG, UlHash<ULONG>, gpos::FEqual<ULONG>,
+		CleanupDelete<ULONG>, CleanupDelete<ULONG> > HMIterUlUl;
+
+	const ULONG ulCnt = 5000;
+
+	// no size hint
+	HMUlUl *phm = GPOS_NEW(pmp) HMUlUl(pmp);
+	GPOS_ASSERT(NULL == phm->PtLookup(&ulCnt));
+
+	for (ULONG ul = 0; ul < ulCnt; ul++)
+	{
+		// keys are spread so that they collide in low bits
+		ULONG ulKey = ul * 1024;
+		ULONG *pulKey = GPOS_NEW(pmp) ULONG(ulKey);
+#ifdef GPOS_DEBUG
+		BOOL fSuccess =
+#endif // GPOS_DEBUG
+			phm->FInsert(pulKey, GPOS_NEW(pmp) ULONG(ul));
+		GPOS_ASSERT(fSuccess);
+		GPOS_ASSERT(ul + 1 == phm->UlEntries());
+	}
+
+	for (ULONG ul = 0; ul < ulCnt; ul++)
+	{
+		ULONG ulKey = ul * 1024;
+		GPOS_ASSERT(ul == *phm->PtLookup(&ulKey));
+
+		ulKey++;
+		GPOS_ASSERT(NULL == phm->PtLookup(&ulKey));
+	}
+
+	// iteration follows insertion order
+	ULONG ulPos = 0;
+	HMIterUlUl hmiter(phm);
+	while (hmiter.FAdvance())
+	{
+		GPOS_ASSERT(ulPos * 1024 == *hmiter.Pk());
+		GPOS_ASSERT(ulPos == *hmiter.Pt());
+		ulPos++;
+	}
+	GPOS_ASSERT(ulCnt == ulPos);
+
+	phm->Release();
+
+	return GPOS_OK;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CHashMapTest::EresUnittest_Benchmark
+//
+//	@doc:
+//		Compare insertion and lookup times of the hash map against a chained
+//		map with a fixed number of buckets, for a well-sized and an
+//		undersized bucket count
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CHashMapTest::EresUnittest_Benchmark()
+{
+	// create memory pool
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	typedef CHashMap<ULONG, ULONG, UlHash<ULONG>, gpos::FEqual<ULONG>,
+		CleanupNULL<ULONG>, CleanupNULL<ULONG> > HMUlUl;
+
+#ifdef GPOS_DEBUG
+	const ULONG ulCnt = 2000;
+#else
+	const ULONG ulCnt = 100000;
+#endif // GPOS_DEBUG
+	const ULONG ulLookups = 10;
+
+	ULONG *rgul = GPOS_NEW_ARRAY(pmp, ULONG, ulCnt);
+	for (ULONG ul = 0; ul < ulCnt; ul++)
+	{
+		rgul[ul] = ul * 7;
+	}
+
+	ULONG ulSink = 0;
+	const ULONG rgulBuckets[] = {128, ulCnt};
+	const CHAR *rgszRun[] =
+		{
+		"HashMap benchmark: chained, 128 buckets",
+		"HashMap benchmark: chained, one bucket per entry"
+		};
+	GPOS_ASSERT(GPOS_ARRAY_SIZE(rgulBuckets) == GPOS_ARRAY_SIZE(rgszRun));
+
+	for (ULONG ulRun = 0; ulRun < GPOS_ARRAY_SIZE(rgulBuckets); ulRun++)
+	{
+		CAutoTimer at(rgszRun[ulRun], true /*fPrint*/);
+		CChainedMap *pcm = GPOS_NEW(pmp) CChainedMap(pmp, rgulBuckets[ulRun]);
+		for (ULONG ul = 0; ul < ulCnt; ul++)
+		{
+			(void) pcm->FInsert(&rgul[ul], &rgul[ul]);
+		}
+		for (ULONG ulLoop = 0; ulLoop < ulLookups; ulLoop++)
+		{
+			for (ULONG ul = 0; ul < ulCnt; ul++)
+			{
+				ulSink += *pcm->PulLookup(&rgul[ul]);
+			}
+		}
+		GPOS_DELETE(pcm);
+	}
+
+	// scope for timer
+	{
+		CAutoTimer at("HashMap benchmark: open addressing, no size hint", true /*fPrint*/);
+		HMUlUl *phm = GPOS_NEW(pmp) HMUlUl(pmp);
+		for (ULONG ul = 0; ul < ulCnt; ul++)
+		{
+			(void) phm->FInsert(&rgul[ul], &rgul[ul]);
+		}
+		for (ULONG ulLoop = 0; ulLoop < ulLookups; ulLoop++)
+		{
+			for (ULONG ul = 0; ul < ulCnt; ul++)
+			{
+				ulSink += *phm->PtLookup(&rgul[ul]);
+			}
+		}
+		phm->Release();
+	}
+
+	GPOS_DELETE_ARRAY(rgul);
+
+	GPOS_TRACE_FORMAT("HashMap benchmark checksum: %u", ulSink);
+
+	return GPOS_OK;
+}
+
 // EOF
 
@@ -0,0 +1,110 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2018 Pivotal, Inc.
+//
+//	@filename:
+//		CLockFreeCacheTest.cpp
+//
+//	@doc:
+//		Test for CLockFreeCache
+//---------------------------------------------------------------------------
+
+#include "gpos/base.h"
+#include "gpos/common/CDynamicPtrArray.h"
+#include "gpos/common/CLockFreeCache.h"
+#include "gpos/memory/CAutoMemoryPool.h"
+#include "gpos/test/CUnittest.h"
+
+#include "unittest/gpos/common/CLockFreeCacheTest.h"
+
+using namespace gpos;
+
+#define GPOS_LFC_BUCKETS	7
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CLockFreeCacheTest::EresUnittest
+//
+//	@doc:
+//		Unittest for lock-free cache
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CLockFreeCacheTest::EresUnittest()
+{
+	CUnittest rgut[] =
+		{
+		GPOS_UNITTEST_FUNC(CLockFreeCacheTest::EresUnittest_Basic),
+		};
+
+	return CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CLockFreeCacheTest::EresUnittest_Basic
+//
+//	@doc:
+//		Lookup and insertion of unique and duplicate keys; duplicate keys
+//		and values are destroyed by the cache, which the memory pool's leak
+//		check verifies
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CLockFreeCacheTest::EresUnittest_Basic()
+{
+	// create memory pool
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	typedef CLockFreeCache<ULONG, ULONG, UlHash<ULONG>, FEqual<ULONG>,
+				CleanupDelete<ULONG>, CleanupDelete<ULONG> > Cache;
+
+	const ULONG ulElems = 100;
+	GPOS_RESULT eres = GPOS_OK;
+
+	{
+		Cache cache(pmp, GPOS_LFC_BUCKETS);
+
+		for (ULONG ul = 0; ul < ulElems; ul++)
+		{
+			ULONG ulKey = ul;
+			if (NULL != cache.PtLookup(&ulKey))
+			{
+				eres = GPOS_FAILED;
+			}
+
+			ULONG *pulValue = GPOS_NEW(pmp) ULONG(2 * ul);
+			if (pulValue != cache.PtInsert(GPOS_NEW(pmp) ULONG(ul), pulValue))
+			{
+				eres = GPOS_FAILED;
+			}
+		}
+
+		for (ULONG ul = 0; ul < ulElems; ul++)
+		{
+			ULONG ulKey = ul;
+			ULONG *pulCached = cache.PtLookup(&ulKey);
+
+			// duplicate insertion returns the value cached first
+			ULONG *pulDuplicate = cache.PtInsert(GPOS_NEW(pmp) ULONG(ul), GPOS_NEW(pmp) ULONG(0));
+			if (NULL == pulCached || 2 * ul != *pulCached || pulCached != pulDuplicate)
+			{
+				eres = GPOS_FAILED;
+			}
+		}
+
+		// every lookup of the second pass is a hit
+		if (2 * ulElems != cache.UlpLookups() ||
+			ulElems != cache.UlpHits() ||
+			ulElems != cache.UlpEntries())
+		{
+			eres = GPOS_FAILED;
+		}
+	}
+
+	return eres;
+}
+
+// EOF
@@ -0,0 +1,248 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CLockFreeHashtableTest.cpp
+//
+//	@doc:
+//		Test for CLockFreeHashtable
+//---------------------------------------------------------------------------
+
+#include "gpos/base.h"
+#include "gpos/memory/CAutoMemoryPool.h"
+#include "gpos/task/CAutoTaskProxy.h"
+#include "gpos/test/CUnittest.h"
+
+#include "unittest/gpos/common/CLockFreeHashtableTest.h"
+
+using namespace gpos;
+
+#define GPOS_LFHT_BUCKETS	7
+#define GPOS_LFHT_ELEMENTS	1000
+#define GPOS_LFHT_THREADS	8
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CLockFreeHashtableTest::EresUnittest
+//
+//	@doc:
+//		Unittest for lock-free hashtable
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CLockFreeHashtableTest::EresUnittest()
+{
+	CUnittest rgut[] =
+		{
+		GPOS_UNITTEST_FUNC(CLockFreeHashtableTest::EresUnittest_Basic),
+		GPOS_UNITTEST_FUNC(CLockFreeHashtableTest::EresUnittest_Concurrency),
+		};
+
+	return CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CLockFreeHashtableTest::EresUnittest_Basic
+//
+//	@doc:
+//		Insertion of unique and duplicate keys, lookup, iteration and reset
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CLockFreeHashtableTest::EresUnittest_Basic()
+{
+	// create memory pool
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	const ULONG ulElems = 100;
+	SElem *rgelem = GPOS_NEW_ARRAY(pmp, SElem, 2 * ulElems);
+
+	SElemHashtable lfht;
+	lfht.Init
+		(
+		pmp,
+		GPOS_LFHT_BUCKETS,
+		GPOS_OFFSET(SElem, m_link),
+		GPOS_OFFSET(SElem, m_ulKey),
+		SElem::UlHash,
+		SElem::FEqual
+		);
+
+	for (ULONG ul = 0; ul < ulElems; ul++)
+	{
+		rgelem[ul].m_ulKey = ul;
+		GPOS_ASSERT(NULL == lfht.PtLookup(ul));
+		GPOS_ASSERT(&rgelem[ul] == lfht.PtInsert(&rgelem[ul]));
+		GPOS_ASSERT(&rgelem[ul] == lfht.PtLookup(ul));
+	}
+	GPOS_ASSERT(ulElems == lfht.UlpEntries());
+
+	// elements with duplicate keys are not inserted
+	for (ULONG ul = 0; ul < ulElems; ul++)
+	{
+		SElem *pelem = &rgelem[ulElems + ul];
+		pelem->m_ulKey = ul;
+		GPOS_ASSERT(&rgelem[ul] == lfht.PtInsert(pelem));
+		GPOS_ASSERT(NULL == pelem->m_link.m_pvNext);
+	}
+	GPOS_ASSERT(ulElems == lfht.UlpEntries());
+	GPOS_ASSERT(0 == lfht.UlpInsertRetries());
+
+	// iteration visits each entry once
+	ULONG ulCount = 0;
+	ULONG ulKeySum = 0;
+	for (SElem *pelem = lfht.PtFirst(); NULL != pelem; pelem = lfht.PtNextEntry(pelem))
+	{
+		ulCount++;
+		ulKeySum += pelem->m_ulKey;
+	}
+	GPOS_ASSERT(ulElems == ulCount);
+	GPOS_ASSERT(ulElems * (ulElems - 1) / 2 == ulKeySum);
+
+	// move all entries to a list and insert them again
+	CList<SElem> list;
+	list.Init(GPOS_OFFSET(SElem, m_link));
+	lfht.Reset(&list);
+	GPOS_ASSERT(0 == lfht.UlpEntries());
+	GPOS_ASSERT(NULL == lfht.PtFirst());
+	GPOS_ASSERT(ulElems == list.UlSize());
+
+	while (!list.FEmpty())
+	{
+		SElem *pelem = list.RemoveHead();
+		GPOS_ASSERT(pelem == lfht.PtInsert(pelem));
+	}
+	GPOS_ASSERT(ulElems == lfht.UlpEntries());
+
+	lfht.Reset();
+	GPOS_DELETE_ARRAY(rgelem);
+
+	return GPOS_OK;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CLockFreeHashtableTest::EresUnittest_Concurrency
+//
+//	@doc:
+//		Concurrent tasks insert elements with the same set of keys; each key
+//		must end up in the hashtable exactly once, and all tasks must agree
+//		on the entry holding it
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CLockFreeHashtableTest::EresUnittest_Concurrency()
+{
+	// create memory pool
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	CWorkerPoolManager *pwpm = CWorkerPoolManager::Pwpm();
+
+	GPOS_ASSERT(GPOS_LFHT_THREADS <= pwpm->UlWorkersMax() &&
+				"Insufficient number of workers to run test");
+
+	SElemHashtable lfht;
+	lfht.Init
+		(
+		pmp,
+		GPOS_LFHT_BUCKETS,
+		GPOS_OFFSET(SElem, m_link),
+		GPOS_OFFSET(SElem, m_ulKey),
+		SElem::UlHash,
+		SElem::FEqual
+		);
+
+	SElem *rgelem = GPOS_NEW_ARRAY(pmp, SElem, GPOS_LFHT_THREADS * GPOS_LFHT_ELEMENTS);
+	SInserterArgs rgargs[GPOS_LFHT_THREADS];
+	for (ULONG ulTask = 0; ulTask < GPOS_LFHT_THREADS; ulTask++)
+	{
+		rgargs[ulTask].m_plfht = &lfht;
+		rgargs[ulTask].m_rgelem = &rgelem[ulTask * GPOS_LFHT_ELEMENTS];
+		rgargs[ulTask].m_ulElems = GPOS_LFHT_ELEMENTS;
+
+		for (ULONG ul = 0; ul < GPOS_LFHT_ELEMENTS; ul++)
+		{
+			rgargs[ulTask].m_rgelem[ul].m_ulKey = ul;
+			rgargs[ulTask].m_rgelem[ul].m_ulTask = ulTask;
+		}
+	}
+
+	// scope for tasks
+	{
+		CAutoTaskProxy atp(pmp, pwpm);
+		CTask *rgtask[GPOS_LFHT_THREADS];
+
+		for (ULONG ulTask = 0; ulTask < GPOS_LFHT_THREADS; ulTask++)
+		{
+			rgtask[ulTask] = atp.PtskCreate(PvUnittest_Inserter, &rgargs[ulTask]);
+			atp.Schedule(rgtask[ulTask]);
+		}
+
+		for (ULONG ulTask = 0; ulTask < GPOS_LFHT_THREADS; ulTask++)
+		{
+			GPOS_CHECK_ABORT;
+
+			atp.Wait(rgtask[ulTask]);
+		}
+	}
+
+	GPOS_ASSERT(GPOS_LFHT_ELEMENTS == lfht.UlpEntries());
+
+	ULONG ulCount = 0;
+	for (SElem *pelem = lfht.PtFirst(); NULL != pelem; pelem = lfht.PtNextEntry(pelem))
+	{
+		GPOS_ASSERT(pelem == lfht.PtLookup(pelem->m_ulKey));
+		ulCount++;
+	}
+	GPOS_ASSERT(GPOS_LFHT_ELEMENTS == ulCount);
+
+	GPOS_TRACE_FORMAT("Lock-free hashtable insert retries: %u", (ULONG) lfht.UlpInsertRetries());
+
+	lfht.Reset();
+	GPOS_DELETE_ARRAY(rgelem);
+
+	return GPOS_OK;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CLockFreeHashtableTest::PvUnittest_Inserter
+//
+//	@doc:
+//		Inserter task; inserts its elements and checks that the returned
+//		entry holds the same key
+//
+//---------------------------------------------------------------------------
+void *
+CLockFreeHashtableTest::PvUnittest_Inserter
+	(
+	void *pv
+	)
+{
+	SInserterArgs *pargs = (SInserterArgs *) pv;
+
+	for (ULONG ul = 0; ul < pargs->m_ulElems; ul++)
+	{
+		SElem *pelem = &pargs->m_rgelem[ul];
+		SElem *pelemFound = pargs->m_plfht->PtInsert(pelem);
+
+		GPOS_ASSERT(NULL != pelemFound);
+		GPOS_ASSERT(pelem->m_ulKey == pelemFound->m_ulKey);
+		GPOS_ASSERT(pelemFound == pargs->m_plfht->PtLookup(pelem->m_ulKey));
+		GPOS_ASSERT_IMP(pelemFound != pelem, NULL == pelem->m_link.m_pvNext);
+
+		GPOS_CHECK_ABORT;
+	}
+
+	return NULL;
+}
+
+// EOF
+
@@ -0,0 +1,221 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2018 Pivotal, Inc.
+//
+//	@filename:
+//		COstreamUTF8Test.cpp
+//
+//	@doc:
+//		Tests for COstreamUTF8
+//---------------------------------------------------------------------------
+
+#include "gpos/assert.h"
+#include "gpos/common/clibwrapper.h"
+#include "gpos/io/COstreamUTF8.h"
+#include "gpos/memory/CAutoMemoryPool.h"
+#include "gpos/test/CUnittest.h"
+
+#include "unittest/gpos/io/COstreamUTF8Test.h"
+
+using namespace gpos;
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COstreamUTF8Test::CTestSink::CTestSink
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+COstreamUTF8Test::CTestSink::CTestSink
+	(
+	BYTE *rgb,
+	ULONG ulCapacity
+	)
+	:
+	m_rgb(rgb),
+	m_ulCapacity(ulCapacity),
+	m_ulSize(0),
+	m_ulWrites(0),
+	m_ulMaxWrite(0)
+{}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COstreamUTF8Test::CTestSink::Write
+//
+//	@doc:
+//		Append bytes to array
+//
+//---------------------------------------------------------------------------
+void
+COstreamUTF8Test::CTestSink::Write
+	(
+	const BYTE *pb,
+	const ULONG_PTR ulpSize
+	)
+{
+	GPOS_ASSERT(0 < ulpSize);
+	GPOS_RTL_ASSERT(m_ulSize + ulpSize <= m_ulCapacity);
+
+	(void) clib::PvMemCpy(m_rgb + m_ulSize, pb, ulpSize);
+	m_ulSize += (ULONG) ulpSize;
+	m_ulWrites++;
+	if (m_ulMaxWrite < ulpSize)
+	{
+		m_ulMaxWrite = (ULONG) ulpSize;
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COstreamUTF8Test::EresUnittest
+//
+//	@doc:
+//		Unittest for UTF-8 output stream
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+COstreamUTF8Test::EresUnittest()
+{
+	CUnittest rgut[] =
+		{
+		GPOS_UNITTEST_FUNC(COstreamUTF8Test::EresUnittest_Basic),
+		GPOS_UNITTEST_FUNC(COstreamUTF8Test::EresUnittest_Encoding),
+		GPOS_UNITTEST_FUNC(COstreamUTF8Test::EresUnittest_Chunks),
+		};
+
+	return CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COstreamUTF8Test::EresUnittest_Basic
+//
+//	@doc:
+//		Test for ASCII strings and numbers
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+COstreamUTF8Test::EresUnittest_Basic()
+{
+	BYTE rgb[128];
+	CTestSink sink(rgb, GPOS_ARRAY_SIZE(rgb));
+	COstreamUTF8 os(&sink);
+
+	WCHAR wc = 'W';
+	CHAR c = 'C';
+	ULONG ul = 102;
+	INT i = -10;
+	WCHAR wsz[] = GPOS_WSZ_LIT("some regular string");
+	INT hex = 0xdeadbeef;
+
+	os
+		<< wc
+		<< c
+		<< ul
+		<< i
+		<< wsz
+		<< "narrow"
+		<< COstream::EsmHex
+		<< hex
+		;
+
+	// nothing reaches the sink before flushing
+	GPOS_RTL_ASSERT(0 == sink.UlSize());
+	os.Flush();
+
+	const CHAR *szExpected = "WC102-10some regular stringnarrowdeadbeef";
+	const ULONG ulExpected = clib::UlStrLen(szExpected);
+	GPOS_RTL_ASSERT(ulExpected == sink.UlSize());
+	GPOS_RTL_ASSERT(ulExpected == os.UllSize());
+	GPOS_RTL_ASSERT(0 == clib::IMemCmp(szExpected, sink.Rgb(), ulExpected));
+
+	return GPOS_OK;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COstreamUTF8Test::EresUnittest_Encoding
+//
+//	@doc:
+//		Test encoding of characters outside of ASCII
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+COstreamUTF8Test::EresUnittest_Encoding()
+{
+	BYTE rgb[32];
+	CTestSink sink(rgb, GPOS_ARRAY_SIZE(rgb));
+	COstreamUTF8 os(&sink);
+
+	// U+00E9, U+20AC, U+1F600 and a lone surrogate
+	const WCHAR wsz[] = {0xE9, 0x20AC, 0x1F600, 0xD800, '\0'};
+	os << wsz;
+	os.Flush();
+
+	const BYTE rgbExpected[] =
+		{
+		0xC3, 0xA9,
+		0xE2, 0x82, 0xAC,
+		0xF0, 0x9F, 0x98, 0x80,
+		0xEF, 0xBF, 0xBD
+		};
+
+	GPOS_RTL_ASSERT(GPOS_ARRAY_SIZE(rgbExpected) == sink.UlSize());
+	GPOS_RTL_ASSERT(0 == clib::IMemCmp(rgbExpected, sink.Rgb(), GPOS_ARRAY_SIZE(rgbExpected)));
+
+	return GPOS_OK;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COstreamUTF8Test::EresUnittest_Chunks
+//
+//	@doc:
+//		Test that output larger than the buffer reaches the sink in bounded
+//		chunks and in order
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+COstreamUTF8Test::EresUnittest_Chunks()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	const ULONG ulChars = 3 * GPOS_OSTREAM_UTF8_BUF_SIZE + 17;
+
+	// each character takes two bytes
+	const ULONG ulCapacity = 2 * ulChars;
+	BYTE *rgb = GPOS_NEW_ARRAY(pmp, BYTE, ulCapacity);
+	CTestSink sink(rgb, ulCapacity);
+	COstreamUTF8 os(&sink);
+
+	for (ULONG ul = 0; ul < ulChars; ul++)
+	{
+		os << (WCHAR) (0x100 + ul % 0x100);
+	}
+	os.Flush();
+
+	GPOS_RTL_ASSERT(ulCapacity == sink.UlSize());
+	GPOS_RTL_ASSERT(1 < sink.UlWrites());
+	GPOS_RTL_ASSERT(GPOS_OSTREAM_UTF8_BUF_SIZE >= sink.UlMaxWrite());
+
+	for (ULONG ul = 0; ul < ulChars; ul++)
+	{
+		ULONG ulCode = 0x100 + ul % 0x100;
+		GPOS_RTL_ASSERT((BYTE) (0xC0 | (ulCode >> 6)) == rgb[2 * ul]);
+		GPOS_RTL_ASSERT((BYTE) (0x80 | (ulCode & 0x3F)) == rgb[2 * ul + 1]);
+	}
+
+	GPOS_DELETE_ARRAY(rgb);
+
+	return GPOS_OK;
+}
+
+// EOF
@@ -64,6 +64,7 @@ CMemoryPoolBasicTest::EresUnittest()
 #endif // GPOS_DEBUG
 		GPOS_UNITTEST_FUNC(CMemoryPoolBasicTest::EresUnittest_TestTracker),
 		GPOS_UNITTEST_FUNC(CMemoryPoolBasicTest::EresUnittest_TestStack),
+		GPOS_UNITTEST_FUNC(CMemoryPoolBasicTest::EresUnittest_TestSlab),
 		};
 
 	CAutoTraceFlag atf(EtraceTestMemoryPools, true /*fVal*/);
@@ -131,6 +132,21 @@ CMemoryPoolBasicTest::EresUnittest_TestStack()
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolBasicTest::EresUnittest_TestSlab
+//
+//	@doc:
+//		Run tests for pool using size-class slabs
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CMemoryPoolBasicTest::EresUnittest_TestSlab()
+{
+	return EresTestType(CMemoryPoolManager::EatSlab);
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CMemoryPoolBasicTest::EresTestType
@@ -8,12 +8,13 @@
 //	@doc:
 //		Implementation of bit sets
 //
-//		Underlying assumption: a set contains only a few links of bitvectors
-//		hence, keeping them in a linked list is efficient;
+//		Underlying assumption: most sets hold ids of a narrow range, hence
+//		keeping them in a dense window of words is efficient; sets of widely
+//		spread ids switch to a sparse list of chunks
 //---------------------------------------------------------------------------
 
 #include "gpos/base.h"
-#include "gpos/common/CAutoRef.h"
+#include "gpos/common/clibwrapper.h"
 #include "gpos/common/CBitSet.h"
 #include "gpos/common/CBitSetIter.h"
 
@@ -23,111 +24,110 @@
 
 using namespace gpos;
 
+#define GPOS_BITSET_BITS_PER_UNIT	(8 * GPOS_SIZEOF(ULLONG))
+
 
 //---------------------------------------------------------------------------
 //	@function:
-//		CBitSetLink
+//		CBitSet::CBitSet
 //
 //	@doc:
 //		ctor
 //
 //---------------------------------------------------------------------------
-CBitSet::CBitSetLink::CBitSetLink
+CBitSet::CBitSet
 	(
-	IMemoryPool *pmp, 
-	ULONG ulOffset, 
+	IMemoryPool *pmp,
 	ULONG cSizeBits
 	)
-	: 
-	m_ulOffset(ulOffset)
+	:
+	m_pmp(pmp),
+	m_cSizeBits(0),
+	m_cUnitsPerChunk(0),
+	m_cElements(0),
+	m_rgull(m_rgullInline),
+	m_cChunks(0),
+	m_cChunksCapacity(0),
+	m_fSparse(false),
+	m_ulBase(0),
+	m_rgulOffset(NULL)
 {
-	m_pbv = GPOS_NEW(pmp) CBitVector(pmp, cSizeBits);
+	GPOS_ASSERT(0 < cSizeBits);
+
+	// round chunk size up to full words
+	m_cUnitsPerChunk = (cSizeBits + GPOS_BITSET_BITS_PER_UNIT - 1) / GPOS_BITSET_BITS_PER_UNIT;
+	m_cSizeBits = m_cUnitsPerChunk * GPOS_BITSET_BITS_PER_UNIT;
+	m_cChunksCapacity = GPOS_BITSET_INLINE_UNITS / m_cUnitsPerChunk;
 }
 
 
 //---------------------------------------------------------------------------
 //	@function:
-//		CBitSetLink
+//		CBitSet::CBitSet
 //
 //	@doc:
-//		copy ctor
+//		copy ctor;
 //
 //---------------------------------------------------------------------------
-CBitSet::CBitSetLink::CBitSetLink
+CBitSet::CBitSet
 	(
-	IMemoryPool *pmp, 
-	const CBitSetLink &bsl
+	IMemoryPool *pmp,
+	const CBitSet &bs
 	)
-	: 
-	m_ulOffset(bsl.m_ulOffset)
+	:
+	m_pmp(pmp),
+	m_cSizeBits(bs.m_cSizeBits),
+	m_cUnitsPerChunk(bs.m_cUnitsPerChunk),
+	m_cElements(0),
+	m_rgull(m_rgullInline),
+	m_cChunks(0),
+	m_cChunksCapacity(GPOS_BITSET_INLINE_UNITS / bs.m_cUnitsPerChunk),
+	m_fSparse(false),
+	m_ulBase(0),
+	m_rgulOffset(NULL)
 {
-	m_pbv = GPOS_NEW(pmp) CBitVector(pmp, *bsl.Pbv());
+	Union(&bs);
 }
 
 
 //---------------------------------------------------------------------------
 //	@function:
-//		~CBitSetLink
+//		CBitSet::~CBitSet
 //
 //	@doc:
-//		ctor
+//		dtor
 //
 //---------------------------------------------------------------------------
-CBitSet::CBitSetLink::~CBitSetLink()
+CBitSet::~CBitSet()
 {
-	GPOS_DELETE(m_pbv);
+	Clear();
 }
 
 
 //---------------------------------------------------------------------------
 //	@function:
-//		CBitSet::PbslLocate
+//		CBitSet::Clear
 //
 //	@doc:
-//		Find bit set link for a given offset; if non-existent return previous
-//		link (may be NULL);
-//		By providing a starting link we can implement a number of operations
-//		in one sweep, ie O(N) 
+//		Release storage and reset set to empty
 //
 //---------------------------------------------------------------------------
-CBitSet::CBitSetLink *
-CBitSet::PbslLocate
-	(
-	ULONG ulOffset,
-	CBitSetLink *pbsl
-	)
-	const
+void
+CBitSet::Clear()
 {
-	CBitSetLink *pbslFound = NULL;
-	CBitSetLink *pbslCursor = pbsl;
-	
-	if (NULL == pbsl)
-	{
-		// if no cursor provided start with first element
-		pbslCursor = m_bsllist.PtFirst();
-	}
-	else
-	{
-		GPOS_ASSERT(pbsl->UlOffset() <= ulOffset && "invalid start cursor");
-		pbslFound = pbsl;
-	}
-	
-	GPOS_ASSERT_IMP(NULL != pbslCursor, GPOS_OK == m_bsllist.EresFind(pbslCursor) && "cursor not in list");
-	
-	while(1)
+	if (m_rgullInline != m_rgull)
 	{
-		// no more links or we've overshot the target
-		if (NULL == pbslCursor || pbslCursor->UlOffset() > ulOffset)
-		{
-			break;
-		}
-		
-		pbslFound = pbslCursor;		
-		pbslCursor = m_bsllist.PtNext(pbslCursor);
+		GPOS_DELETE_ARRAY(m_rgull);
 	}
-	
-	GPOS_ASSERT_IMP(pbslFound, pbslFound->UlOffset() <= ulOffset);
-	return pbslFound;
+	GPOS_DELETE_ARRAY(m_rgulOffset);
+
+	m_rgull = m_rgullInline;
+	m_rgulOffset = NULL;
+	m_fSparse = false;
+	m_cChunks = 0;
+	m_cChunksCapacity = GPOS_BITSET_INLINE_UNITS / m_cUnitsPerChunk;
+	m_ulBase = 0;
+	m_cElements = 0;
 }
 
 
@@ -136,128 +136,352 @@ CBitSet::PbslLocate
 //		CBitSet::RecomputeSize
 //
 //	@doc:
-//		Compute size of set by adding up sizes of links
+//		Compute size of set by counting bits of all chunks
 //
 //---------------------------------------------------------------------------
 void
 CBitSet::RecomputeSize()
 {
-	m_cElements = 0;
-	CBitSetLink *pbsl = NULL;
-	
-	for (
-		pbsl = m_bsllist.PtFirst();
-		pbsl != NULL;
-		pbsl = m_bsllist.PtNext(pbsl)
-		)
-	{
-		m_cElements += pbsl->Pbv()->CElements();
-	}	
+	const ULONG cUnits = m_cChunks * m_cUnitsPerChunk;
+
+	ULONG cElements = 0;
+	for (ULONG ul = 0; ul < cUnits; ul++)
+	{
+		cElements += UlPopCount(m_rgull[ul]);
+	}
+
+	m_cElements = cElements;
 }
 
 
 //---------------------------------------------------------------------------
 //	@function:
-//		CBitSet::Clear
+//		CBitSet::FEmptyChunk
 //
 //	@doc:
-//		release all links
+//		Check if given chunk has no bits set
 //
 //---------------------------------------------------------------------------
-void
-CBitSet::Clear()
+BOOL
+CBitSet::FEmptyChunk
+	(
+	ULONG ulChunk
+	)
+	const
 {
-	CBitSetLink *pbsl = NULL;
-	
-	while(NULL != (pbsl = m_bsllist.PtFirst()))
-	{		
-		CBitSetLink *pbslRemove = pbsl;
-		pbsl = m_bsllist.PtNext(pbsl);
-		
-		m_bsllist.Remove(pbslRemove);
-		GPOS_DELETE(pbslRemove);
+	const ULLONG *pull = PullChunk(ulChunk);
+
+	ULLONG ull = 0;
+	for (ULONG ul = 0; ul < m_cUnitsPerChunk; ul++)
+	{
+		ull |= pull[ul];
 	}
-	
-	RecomputeSize();
+
+	return 0 == ull;
 }
 
 
 //---------------------------------------------------------------------------
 //	@function:
-//		CBitSet::UlOffset
+//		CBitSet::FLocate
 //
 //	@doc:
-//		Compute offset 
+//		Find chunk with given offset; if there is none, return false and
+//		the position a chunk with this offset would be inserted at
 //
 //---------------------------------------------------------------------------
-ULONG
-CBitSet::UlOffset
+BOOL
+CBitSet::FLocate
 	(
-	ULONG ul
+	ULONG ulOffset,
+	ULONG *pulChunk
 	)
 	const
 {
-	return (ul / m_cSizeBits) * m_cSizeBits;
+	GPOS_ASSERT(ulOffset == UlOffset(ulOffset));
+
+	if (!m_fSparse)
+	{
+		if (0 == m_cChunks || ulOffset < m_ulBase)
+		{
+			*pulChunk = 0;
+			return false;
+		}
+
+		*pulChunk = (ulOffset - m_ulBase) / m_cSizeBits;
+		if (*pulChunk >= m_cChunks)
+		{
+			*pulChunk = m_cChunks;
+			return false;
+		}
+
+		return true;
+	}
+
+	// binary search for offset
+	ULONG ulLow = 0;
+	ULONG ulHigh = m_cChunks;
+	while (ulLow < ulHigh)
+	{
+		ULONG ulMid = ulLow + (ulHigh - ulLow) / 2;
+		if (m_rgulOffset[ulMid] < ulOffset)
+		{
+			ulLow = ulMid + 1;
+		}
+		else
+		{
+			ulHigh = ulMid;
+		}
+	}
+
+	*pulChunk = ulLow;
+	return ulLow < m_cChunks && m_rgulOffset[ulLow] == ulOffset;
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CBitSet::PullLocate
+//
+//	@doc:
+//		Words of chunk with given offset, NULL if there is none
+//
+//---------------------------------------------------------------------------
+const ULLONG *
+CBitSet::PullLocate
+	(
+	ULONG ulOffset
+	)
+	const
+{
+	ULONG ulChunk = 0;
+	if (FLocate(ulOffset, &ulChunk))
+	{
+		return PullChunk(ulChunk);
+	}
+
+	return NULL;
+}
+
 
 //---------------------------------------------------------------------------
 //	@function:
-//		CBitSet::CBitSet
+//		CBitSet::Reserve
 //
 //	@doc:
-//		ctor
+//		Make room for given number of chunks; storage grows geometrically
 //
 //---------------------------------------------------------------------------
-CBitSet::CBitSet
+void
+CBitSet::Reserve
 	(
-	IMemoryPool *pmp,
-	ULONG cSizeBits
+	ULONG cChunks
 	)
-	:
-	m_pmp(pmp),
-	m_cSizeBits(cSizeBits),
-	m_cElements(0)
 {
-	m_bsllist.Init(GPOS_OFFSET(CBitSetLink, m_link));
+	if (cChunks <= m_cChunksCapacity)
+	{
+		return;
+	}
+
+	ULONG cChunksCapacity = std::max(cChunks, 2 * m_cChunksCapacity);
+
+	ULLONG *rgull = GPOS_NEW_ARRAY(m_pmp, ULLONG, cChunksCapacity * m_cUnitsPerChunk);
+	if (0 < m_cChunks)
+	{
+		(void) clib::PvMemCpy(rgull, m_rgull, m_cChunks * m_cUnitsPerChunk * GPOS_SIZEOF(ULLONG));
+	}
+
+	if (m_fSparse)
+	{
+		GPOS_ASSERT(0 < m_cChunks);
+
+		ULONG *rgulOffset = GPOS_NEW_ARRAY(m_pmp, ULONG, cChunksCapacity);
+		(void) clib::PvMemCpy(rgulOffset, m_rgulOffset, m_cChunks * GPOS_SIZEOF(ULONG));
+
+		GPOS_DELETE_ARRAY(m_rgulOffset);
+		m_rgulOffset = rgulOffset;
+	}
+
+	if (m_rgullInline != m_rgull)
+	{
+		GPOS_DELETE_ARRAY(m_rgull);
+	}
+
+	m_rgull = rgull;
+	m_cChunksCapacity = cChunksCapacity;
 }
 
 
 //---------------------------------------------------------------------------
 //	@function:
-//		CBitSet::CBitSet
+//		CBitSet::ConvertToSparse
 //
 //	@doc:
-//		copy ctor;
+//		Switch storage to sparse form; empty chunks of the dense window are
+//		dropped
 //
 //---------------------------------------------------------------------------
-CBitSet::CBitSet
+void
+CBitSet::ConvertToSparse()
+{
+	GPOS_ASSERT(!m_fSparse);
+	GPOS_ASSERT(0 < m_cChunksCapacity);
+
+	m_rgulOffset = GPOS_NEW_ARRAY(m_pmp, ULONG, m_cChunksCapacity);
+
+	ULONG cChunks = 0;
+	for (ULONG ul = 0; ul < m_cChunks; ul++)
+	{
+		if (FEmptyChunk(ul))
+		{
+			continue;
+		}
+
+		if (cChunks != ul)
+		{
+			(void) clib::PvMemCpy
+					(
+					PullChunk(cChunks),
+					PullChunk(ul),
+					m_cUnitsPerChunk * GPOS_SIZEOF(ULLONG)
+					);
+		}
+		m_rgulOffset[cChunks++] = m_ulBase + ul * m_cSizeBits;
+	}
+
+	m_fSparse = true;
+	m_cChunks = cChunks;
+	m_ulBase = 0;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CBitSet::PullEnsure
+//
+//	@doc:
+//		Words of chunk with given offset; a missing chunk is added by
+//		growing the dense window, or inserted in sparse form if the window
+//		would exceed its size limit
+//
+//---------------------------------------------------------------------------
+ULLONG *
+CBitSet::PullEnsure
 	(
-	IMemoryPool *pmp,
-	const CBitSet &bs
+	ULONG ulOffset
 	)
-	:
-	m_pmp(pmp),
-	m_cSizeBits(bs.m_cSizeBits),
-	m_cElements(0)
 {
-	m_bsllist.Init(GPOS_OFFSET(CBitSetLink, m_link));
-	Union(&bs);
+	ULONG ulChunk = 0;
+	if (FLocate(ulOffset, &ulChunk))
+	{
+		return PullChunk(ulChunk);
+	}
+
+	const ULONG ulChunkBytes = m_cUnitsPerChunk * GPOS_SIZEOF(ULLONG);
+
+	if (!m_fSparse)
+	{
+		if (0 == m_cChunks)
+		{
+			Reserve(1);
+			m_ulBase = ulOffset;
+			m_cChunks = 1;
+			(void) clib::PvMemSet(m_rgull, 0, ulChunkBytes);
+
+			return m_rgull;
+		}
+
+		// compute window covering current chunks and the new one
+		const ULLONG ullEnd = (ULLONG) m_ulBase + (ULLONG) m_cChunks * m_cSizeBits;
+		const ULONG ulBase = std::min(m_ulBase, ulOffset);
+		const ULLONG ullEndNew = std::max(ullEnd, (ULLONG) ulOffset + m_cSizeBits);
+		const ULONG cChunks = (ULONG) ((ullEndNew - ulBase) / m_cSizeBits);
+
+		if (cChunks * m_cUnitsPerChunk <= GPOS_BITSET_DENSE_UNITS)
+		{
+			Reserve(cChunks);
+
+			// shift existing chunks if window grows at the front
+			const ULONG cShift = (m_ulBase - ulBase) / m_cSizeBits;
+			if (0 < cShift)
+			{
+				for (ULONG ul = m_cChunks; ul > 0; ul--)
+				{
+					(void) clib::PvMemCpy(PullChunk(ul - 1 + cShift), PullChunk(ul - 1), ulChunkBytes);
+				}
+				(void) clib::PvMemSet(m_rgull, 0, cShift * ulChunkBytes);
+			}
+
+			// clear chunks added at the back
+			const ULONG cOld = m_cChunks + cShift;
+			(void) clib::PvMemSet(PullChunk(cOld), 0, (cChunks - cOld) * ulChunkBytes);
+
+			m_ulBase = ulBase;
+			m_cChunks = cChunks;
+
+			return PullChunk((ulOffset - ulBase) / m_cSizeBits);
+		}
+
+		ConvertToSparse();
+		(void) FLocate(ulOffset, &ulChunk);
+	}
+
+	// insert chunk in sparse form
+	Reserve(m_cChunks + 1);
+	for (ULONG ul = m_cChunks; ul > ulChunk; ul--)
+	{
+		(void) clib::PvMemCpy(PullChunk(ul), PullChunk(ul - 1), ulChunkBytes);
+		m_rgulOffset[ul] = m_rgulOffset[ul - 1];
+	}
+
+	(void) clib::PvMemSet(PullChunk(ulChunk), 0, ulChunkBytes);
+	m_rgulOffset[ulChunk] = ulOffset;
+	m_cChunks++;
+
+	return PullChunk(ulChunk);
 }
 
 
 //---------------------------------------------------------------------------
 //	@function:
-//		CBitSet::~CBitSet
+//		CBitSet::FNextBit
 //
 //	@doc:
-//		dtor
+//		Find next set bit in chunk at or after given position
 //
 //---------------------------------------------------------------------------
-CBitSet::~CBitSet()
+BOOL
+CBitSet::FNextBit
+	(
+	ULONG ulChunk,
+	ULONG ulStart,
+	ULONG &ulNext
+	)
+	const
 {
-	Clear();
+	GPOS_ASSERT(ulChunk < m_cChunks);
+
+	const ULLONG *pull = PullChunk(ulChunk);
+
+	ULONG ulUnit = ulStart / GPOS_BITSET_BITS_PER_UNIT;
+	if (ulUnit >= m_cUnitsPerChunk)
+	{
+		return false;
+	}
+
+	// mask out bits before start position in first word
+	ULLONG ull = pull[ulUnit] & (~(ULLONG) 0 << (ulStart % GPOS_BITSET_BITS_PER_UNIT));
+	while (0 == ull)
+	{
+		if (++ulUnit == m_cUnitsPerChunk)
+		{
+			return false;
+		}
+		ull = pull[ulUnit];
+	}
+
+	ulNext = ulUnit * GPOS_BITSET_BITS_PER_UNIT + UlLowestBit(ull);
+	return true;
 }
 
 
@@ -278,13 +502,14 @@ CBitSet::FBit
 {
 	ULONG ulOffset = UlOffset(ulBit);
 	
-	CBitSetLink *pbsl = PbslLocate(ulOffset);
-	if (NULL != pbsl && pbsl->UlOffset() == ulOffset)
+	const ULLONG *pull = PullLocate(ulOffset);
+	if (NULL == pull)
 	{
-		return pbsl->Pbv()->FBit(ulBit - ulOffset);
+		return false;
 	}
-	
-	return false;
+
+	ULONG ulPos = ulBit - ulOffset;
+	return 0 != (pull[ulPos / GPOS_BITSET_BITS_PER_UNIT] & ((ULLONG) 1 << (ulPos % GPOS_BITSET_BITS_PER_UNIT)));
 }
 
 
@@ -293,7 +518,7 @@ CBitSet::FBit
 //		CBitSet::FExchangeSet
 //
 //	@doc:
-//		Set given bit; return previous value; allocate new link if necessary
+//		Set given bit; return previous value; add chunk if necessary
 //
 //---------------------------------------------------------------------------
 BOOL 
@@ -303,29 +528,16 @@ CBitSet::FExchangeSet
 	)
 {
 	ULONG ulOffset = UlOffset(ulBit);
-	
-	CBitSetLink *pbsl = PbslLocate(ulOffset);
-	if (NULL == pbsl || pbsl->UlOffset() != ulOffset)
-	{
-		CBitSetLink *pbslNew = GPOS_NEW(m_pmp) CBitSetLink(m_pmp, ulOffset, m_cSizeBits);
-		if (NULL == pbsl)
-		{
-			m_bsllist.Prepend(pbslNew);
-		}
-		else
-		{
-			// insert after found link
-			m_bsllist.Append(pbslNew, pbsl);
-		}
-		
-		pbsl = pbslNew;
-	}
-	
-	GPOS_ASSERT(pbsl->UlOffset() == ulOffset);
-	
-	BOOL fBit = pbsl->Pbv()->FExchangeSet(ulBit - ulOffset);
+	ULLONG *pull = PullEnsure(ulOffset);
+
+	ULONG ulPos = ulBit - ulOffset;
+	ULLONG &ull = pull[ulPos / GPOS_BITSET_BITS_PER_UNIT];
+	ULLONG ullMask = (ULLONG) 1 << (ulPos % GPOS_BITSET_BITS_PER_UNIT);
+
+	BOOL fBit = (0 != (ull & ullMask));
 	if (!fBit)
 	{
+		ull |= ullMask;
 		m_cElements++;
 	}
 	
@@ -348,28 +560,31 @@ CBitSet::FExchangeClear
 	)
 {
 	ULONG ulOffset = UlOffset(ulBit);
-	
-	CBitSetLink *pbsl = PbslLocate(ulOffset);
-	if (NULL != pbsl && pbsl->UlOffset() == ulOffset)
+
+	ULONG ulChunk = 0;
+	if (!FLocate(ulOffset, &ulChunk))
 	{
-		BOOL fBit = pbsl->Pbv()->FExchangeClear(ulBit - ulOffset);
-		
-		// remove empty link
-		if (pbsl->Pbv()->FEmpty())
-		{
-			m_bsllist.Remove(pbsl);
-			GPOS_DELETE(pbsl);
-		}
-		
-		if (fBit)
+		return false;
+	}
+
+	ULONG ulPos = ulBit - ulOffset;
+	ULLONG &ull = PullChunk(ulChunk)[ulPos / GPOS_BITSET_BITS_PER_UNIT];
+	ULLONG ullMask = (ULLONG) 1 << (ulPos % GPOS_BITSET_BITS_PER_UNIT);
+
+	BOOL fBit = (0 != (ull & ullMask));
+	if (fBit)
+	{
+		ull &= ~ullMask;
+		m_cElements--;
+
+		if (0 == m_cElements)
 		{
-			m_cElements--;
+			// release storage of empty set
+			Clear();
 		}
-		
-		return fBit;
 	}
 	
-	return false;
+	return fBit;
 }
 
 
@@ -378,13 +593,8 @@ CBitSet::FExchangeClear
 //		CBitSet::Union
 //
 //	@doc:
-//		Union with given other set;
-//		(1) determine which links need to be allocated before(!) modifying
-//			the set allocate and copy missing links aside
-//		(2) insert the new links into the list
-//		(3) union all links, old and new, on a per-bitvector basis
-//
-//		For clarity step (2) and (3) are separated;
+//		Union with given other set; chunks of the other set are or-ed into
+//		the matching chunks of this set, which are added as needed
 //
 //---------------------------------------------------------------------------
 void
@@ -393,64 +603,36 @@ CBitSet::Union
 	const CBitSet *pbsOther
 	)
 {
-	CBitSetLink *pbsl = NULL;
-	CBitSetLink *pbslOther = NULL;
-
-	// dynamic array of CBitSetLink
-	typedef CDynamicPtrArray <CBitSetLink, CleanupNULL> DrgBSL;
+	if (this == pbsOther)
+	{
+		return;
+	}
 
-	CAutoRef<DrgBSL> a_drgpbsl;
-	a_drgpbsl = GPOS_NEW(m_pmp) DrgBSL(m_pmp);
-	
-	// iterate through other's links and copy missing links to array
-	for (
-		pbslOther = pbsOther->m_bsllist.PtFirst();
-		pbslOther != NULL;
-		pbslOther = pbsOther->m_bsllist.PtNext(pbslOther)
-		)
-	{
-		pbsl = PbslLocate(pbslOther->UlOffset(), pbsl);
-		if (NULL == pbsl || pbsl->UlOffset() != pbslOther->UlOffset())
+	if (m_cSizeBits != pbsOther->m_cSizeBits)
+	{
+		CBitSetIter bsiter(*pbsOther);
+		while (bsiter.FAdvance())
 		{
-			// need to copy this link
-			CAutoP<CBitSetLink> a_pbsl;
-			a_pbsl = GPOS_NEW(m_pmp) CBitSetLink(m_pmp, *pbslOther);
-			a_drgpbsl->Append(a_pbsl.Pt());
-			
-			a_pbsl.PtReset();
+			(void) FExchangeSet(bsiter.UlBit());
 		}
+
+		return;
 	}
 
-	// insert all new links
-	pbsl = NULL;
-	for (ULONG i = 0; i < a_drgpbsl->UlLength(); i++)
+	for (ULONG ulChunk = 0; ulChunk < pbsOther->m_cChunks; ulChunk++)
 	{
-		CBitSetLink *pbslInsert = (*a_drgpbsl)[i];
-		pbsl = PbslLocate(pbslInsert->UlOffset(), pbsl);
-		
-		GPOS_ASSERT_IMP(NULL != pbsl, pbsl->UlOffset() < pbslInsert->UlOffset());
-		if (NULL == pbsl)
+		if (pbsOther->FEmptyChunk(ulChunk))
 		{
-			m_bsllist.Prepend(pbslInsert);
+			continue;
 		}
-		else
-		{
-			m_bsllist.Append(pbslInsert, pbsl);
-		}
-	}
-	
-	// iterate through all links and union them up
-	pbslOther = NULL;
-	pbsl = m_bsllist.PtFirst();
-	while (NULL != pbsl)
-	{
-		pbslOther = pbsOther->PbslLocate(pbsl->UlOffset(), pbslOther);
-		if (NULL != pbslOther && pbslOther->UlOffset() == pbsl->UlOffset())
+
+		const ULLONG *pullOther = pbsOther->PullChunk(ulChunk);
+		ULLONG *pull = PullEnsure(pbsOther->UlChunkOffset(ulChunk));
+
+		for (ULONG ul = 0; ul < m_cUnitsPerChunk; ul++)
 		{
-			pbsl->Pbv()->Union(pbslOther->Pbv());
+			pull[ul] |= pullOther[ul];
 		}
-		
-		pbsl = m_bsllist.PtNext(pbsl);
 	}
 	
 	RecomputeSize();
@@ -462,7 +644,7 @@ CBitSet::Union
 //		CBitSet::Intersection
 //
 //	@doc:
-//		Iterate through all links and intersect them; release unused links
+//		Intersect all chunks with the matching chunks of the other set
 //
 //---------------------------------------------------------------------------
 void
@@ -471,30 +653,54 @@ CBitSet::Intersection
 	const CBitSet *pbsOther
 	)
 {
-	CBitSetLink *pbslOther = NULL;
-	CBitSetLink *pbsl = m_bsllist.PtFirst();
-	
-	while (NULL != pbsl)
+	if (this == pbsOther)
 	{
-		CBitSetLink *pbslRemove = NULL;
+		return;
+	}
 
-		pbslOther = pbsOther->PbslLocate(pbsl->UlOffset(), pbslOther);
-		if (NULL != pbslOther && pbslOther->UlOffset() == pbsl->UlOffset())
+	if (m_cSizeBits != pbsOther->m_cSizeBits)
+	{
+		// collect common bits in a separate set, since clearing bits of this
+		// set while iterating over it may release its storage
+		CBitSet *pbsCommon = GPOS_NEW(m_pmp) CBitSet(m_pmp, m_cSizeBits);
+		CBitSetIter bsiter(*this);
+		while (bsiter.FAdvance())
 		{
-			pbsl->Pbv()->Intersection(pbslOther->Pbv());
-			pbsl = m_bsllist.PtNext(pbsl);
+			if (pbsOther->FBit(bsiter.UlBit()))
+			{
+				(void) pbsCommon->FExchangeSet(bsiter.UlBit());
+			}
 		}
-		else
+
+		Clear();
+		Union(pbsCommon);
+		pbsCommon->Release();
+
+		return;
+	}
+
+	for (ULONG ulChunk = 0; ulChunk < m_cChunks; ulChunk++)
+	{
+		ULLONG *pull = PullChunk(ulChunk);
+		const ULLONG *pullOther = pbsOther->PullLocate(UlChunkOffset(ulChunk));
+
+		if (NULL == pullOther)
 		{
-			pbslRemove = pbsl;
-			pbsl = m_bsllist.PtNext(pbsl);
-			
-			m_bsllist.Remove(pbslRemove);
-			GPOS_DELETE(pbslRemove);
+			(void) clib::PvMemSet(pull, 0, m_cUnitsPerChunk * GPOS_SIZEOF(ULLONG));
+			continue;
+		}
+
+		for (ULONG ul = 0; ul < m_cUnitsPerChunk; ul++)
+		{
+			pull[ul] &= pullOther[ul];
 		}
 	}
 	
 	RecomputeSize();
+	if (0 == m_cElements)
+	{
+		Clear();
+	}
 }
 
 
@@ -503,25 +709,52 @@ CBitSet::Intersection
 //		CBitSet::Difference
 //
 //	@doc:
-//		Substract other set from this by iterating through other set and
-//		explicit removal of elements;
+//		Substract other set from this by clearing the bits of the matching
+//		chunks of the other set
 //
 //---------------------------------------------------------------------------
 void
 CBitSet::Difference
 	(
-	const CBitSet *pbs
+	const CBitSet *pbsOther
 	)
 {
-	if (FDisjoint(pbs))
+	if (this == pbsOther)
 	{
+		Clear();
 		return;
 	}
-	
-	CBitSetIter bsiter(*pbs);
-	while (bsiter.FAdvance())
+
+	if (m_cSizeBits != pbsOther->m_cSizeBits)
 	{
-		(void) FExchangeClear(bsiter.UlBit());
+		CBitSetIter bsiter(*pbsOther);
+		while (bsiter.FAdvance())
+		{
+			(void) FExchangeClear(bsiter.UlBit());
+		}
+
+		return;
+	}
+
+	for (ULONG ulChunk = 0; ulChunk < m_cChunks; ulChunk++)
+	{
+		const ULLONG *pullOther = pbsOther->PullLocate(UlChunkOffset(ulChunk));
+		if (NULL == pullOther)
+		{
+			continue;
+		}
+
+		ULLONG *pull = PullChunk(ulChunk);
+		for (ULONG ul = 0; ul < m_cUnitsPerChunk; ul++)
+		{
+			pull[ul] &= ~pullOther[ul];
+		}
+	}
+
+	RecomputeSize();
+	if (0 == m_cElements)
+	{
+		Clear();
 	}
 }	
 
@@ -547,21 +780,43 @@ CBitSet::FSubset
 		return false;
 	}
 
-	CBitSetLink *pbsl = NULL;
-	CBitSetLink *pbslOther = NULL;
+	if (m_cSizeBits != pbsOther->m_cSizeBits)
+	{
+		CBitSetIter bsiter(*pbsOther);
+		while (bsiter.FAdvance())
+		{
+			if (!FBit(bsiter.UlBit()))
+			{
+				return false;
+			}
+		}
 
-	// iterate through other's links and check for subsets
-	for (
-		pbslOther = pbsOther->m_bsllist.PtFirst();
-		pbslOther != NULL;
-		pbslOther = pbsOther->m_bsllist.PtNext(pbslOther)
-		)
+		return true;
+	}
+
+	// check chunks of the other set against matching chunks
+	for (ULONG ulChunk = 0; ulChunk < pbsOther->m_cChunks; ulChunk++)
 	{
-		pbsl = PbslLocate(pbslOther->UlOffset(), pbsl);
-		
-		if (NULL == pbsl ||
-			pbsl->UlOffset() != pbslOther->UlOffset() ||
-			!pbsl->Pbv()->FSubset(pbslOther->Pbv()))
+		const ULLONG *pullOther = pbsOther->PullChunk(ulChunk);
+		const ULLONG *pull = PullLocate(pbsOther->UlChunkOffset(ulChunk));
+
+		ULLONG ullMissing = 0;
+		if (NULL == pull)
+		{
+			for (ULONG ul = 0; ul < m_cUnitsPerChunk; ul++)
+			{
+				ullMissing |= pullOther[ul];
+			}
+		}
+		else
+		{
+			for (ULONG ul = 0; ul < m_cUnitsPerChunk; ul++)
+			{
+				ullMissing |= pullOther[ul] & ~pull[ul];
+			}
+		}
+
+		if (0 != ullMissing)
 		{
 			return false;
 		}
@@ -598,28 +853,11 @@ CBitSet::FEqual
 		return false;
 	}
 
-	CBitSetLink *pbsl = m_bsllist.PtFirst();
-	CBitSetLink *pbslOther = pbsOther->m_bsllist.PtFirst();
-
-	while(NULL != pbsl)
-	{
-		if (NULL == pbslOther || 
-			pbsl->UlOffset() != pbslOther->UlOffset() ||
-			!pbsl->Pbv()->FEqual(pbslOther->Pbv()))
-		{
-			return false;
-		}
-				
-		pbsl = m_bsllist.PtNext(pbsl);
-		pbslOther = pbsOther->m_bsllist.PtNext(pbslOther);
-	}
-	
-	// same length implies pbslOther must have reached end as well
-	return pbslOther == NULL;
+	// a subset of the same size is equal
+	return FSubset(pbsOther);
 }
 
 
-
 //---------------------------------------------------------------------------
 //	@function:
 //		CBitSet::FDisjoint
@@ -635,21 +873,42 @@ CBitSet::FDisjoint
 	)
 	const
 {
-	CBitSetLink *pbsl = NULL;
-	CBitSetLink *pbslOther = NULL;
-
-	// iterate through other's links an check if disjoint
-	for (
-		pbslOther = pbsOther->m_bsllist.PtFirst();
-		pbslOther != NULL;
-		pbslOther = pbsOther->m_bsllist.PtNext(pbslOther)
-		)
-	{
-		pbsl = PbslLocate(pbslOther->UlOffset(), pbsl);
-		
-		if (NULL != pbsl && 
-			pbsl->UlOffset() == pbslOther->UlOffset() &&
-			!pbsl->Pbv()->FDisjoint(pbslOther->Pbv()))
+	if (0 == CElements() || 0 == pbsOther->CElements())
+	{
+		return true;
+	}
+
+	if (m_cSizeBits != pbsOther->m_cSizeBits)
+	{
+		CBitSetIter bsiter(*pbsOther);
+		while (bsiter.FAdvance())
+		{
+			if (FBit(bsiter.UlBit()))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	for (ULONG ulChunk = 0; ulChunk < pbsOther->m_cChunks; ulChunk++)
+	{
+		const ULLONG *pull = PullLocate(pbsOther->UlChunkOffset(ulChunk));
+		if (NULL == pull)
+		{
+			continue;
+		}
+
+		const ULLONG *pullOther = pbsOther->PullChunk(ulChunk);
+
+		ULLONG ullCommon = 0;
+		for (ULONG ul = 0; ul < m_cUnitsPerChunk; ul++)
+		{
+			ullCommon |= pullOther[ul] & pull[ul];
+		}
+
+		if (0 != ullCommon)
 		{
 			return false;
 		}
@@ -664,7 +923,8 @@ CBitSet::FDisjoint
 //		CBitSet::UlHash
 //
 //	@doc:
-//		Compute hash value for set
+//		Compute hash value for set by combining hash values of non-empty
+//		chunks in offset order
 //
 //---------------------------------------------------------------------------
 ULONG
@@ -672,11 +932,19 @@ CBitSet::UlHash() const
 {
 	ULONG ulHash = 0;
 
-	CBitSetLink *pbsl = m_bsllist.PtFirst();
-	while (NULL != pbsl)
+	for (ULONG ulChunk = 0; ulChunk < m_cChunks; ulChunk++)
 	{
-		ulHash = gpos::UlCombineHashes(ulHash, pbsl->Pbv()->UlHash());
-		pbsl = m_bsllist.PtNext(pbsl);
+		if (FEmptyChunk(ulChunk))
+		{
+			continue;
+		}
+
+		ULONG ulHashChunk = gpos::UlHashByteArray
+								(
+								(BYTE *) PullChunk(ulChunk),
+								m_cUnitsPerChunk * GPOS_SIZEOF(ULLONG)
+								);
+		ulHash = gpos::UlCombineHashes(ulHash, ulHashChunk);
 	}
 
 	return ulHash;
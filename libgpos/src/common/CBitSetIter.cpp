@@ -11,7 +11,6 @@
 
 #include "gpos/base.h"
 #include "gpos/common/CBitSetIter.h"
-#include "gpos/common/CAutoRef.h"
 
 using namespace gpos;
 
@@ -31,7 +30,7 @@ CBitSetIter::CBitSetIter
 	:
 	m_bs(bs),
 	m_ulCursor((ULONG)-1),
-	m_pbsl(NULL),
+	m_ulChunk(0),
 	m_fActive(true)
 {
 }
@@ -50,24 +49,19 @@ CBitSetIter::FAdvance()
 {
 	GPOS_ASSERT(m_fActive && "called advance on exhausted iterator");
 	
-	if (NULL == m_pbsl)
+	while (m_ulChunk < m_bs.m_cChunks)
 	{
-		m_pbsl = m_bs.m_bsllist.PtFirst();
-	}
-	
-	while (NULL != m_pbsl)
-	{
-		if (m_ulCursor + 1 <= m_bs.m_cSizeBits &&
-			m_pbsl->Pbv()->FNextBit(m_ulCursor + 1, m_ulCursor))
+		if (m_ulCursor + 1 < m_bs.m_cSizeBits &&
+			m_bs.FNextBit(m_ulChunk, m_ulCursor + 1, m_ulCursor))
 		{
-			break;
+			return true;
 		}
 
-		m_pbsl = m_bs.m_bsllist.PtNext(m_pbsl);
+		m_ulChunk++;
 		m_ulCursor = (ULONG)-1;
 	}
 
-	m_fActive = (NULL != m_pbsl);
+	m_fActive = false;
 	return m_fActive;
 }
 	
@@ -83,10 +77,12 @@ CBitSetIter::FAdvance()
 ULONG
 CBitSetIter::UlBit() const
 {
-	GPOS_ASSERT(m_fActive && NULL != m_pbsl && "iterator uninitialized");
-	GPOS_ASSERT(m_pbsl->Pbv()->FBit(m_ulCursor));
+	GPOS_ASSERT(m_fActive && m_ulChunk < m_bs.m_cChunks && "iterator uninitialized");
+
+	ULONG ulBit = m_bs.UlChunkOffset(m_ulChunk) + m_ulCursor;
+	GPOS_ASSERT(m_bs.FBit(ulBit));
 	
-	return m_pbsl->UlOffset() + m_ulCursor;
+	return ulBit;
 }
 
 // EOF
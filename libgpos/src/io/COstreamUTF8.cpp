@@ -0,0 +1,203 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2018 Pivotal, Inc.
+//
+//	@filename:
+//		COstreamUTF8.cpp
+//
+//	@doc:
+//		Implementation of output stream writing UTF-8 to a byte sink;
+//---------------------------------------------------------------------------
+
+#include "gpos/base.h"
+#include "gpos/io/COstreamUTF8.h"
+
+using namespace gpos;
+
+// replacement for wide characters that are not valid code points
+#define GPOS_UTF8_REPLACEMENT_CHAR	(0xFFFD)
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COstreamUTF8::COstreamUTF8
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+COstreamUTF8::COstreamUTF8
+	(
+	IByteSink *psink
+	)
+	:
+	COstream(),
+	m_psink(psink),
+	m_ulBuffered(0),
+	m_ullFlushed(0)
+{
+	GPOS_ASSERT(NULL != psink);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COstreamUTF8::AppendWc
+//
+//	@doc:
+//		Append the UTF-8 encoding of a wide character; surrogates and values
+//		beyond the Unicode range are replaced by U+FFFD
+//
+//---------------------------------------------------------------------------
+void
+COstreamUTF8::AppendWc
+	(
+	WCHAR wc
+	)
+{
+	ULONG ulCode = (ULONG) wc;
+	if (0x10FFFF < ulCode || (0xD800 <= ulCode && 0xDFFF >= ulCode))
+	{
+		ulCode = GPOS_UTF8_REPLACEMENT_CHAR;
+	}
+
+	if (0x80 > ulCode)
+	{
+		AppendByte((BYTE) ulCode);
+	}
+	else if (0x800 > ulCode)
+	{
+		AppendByte((BYTE) (0xC0 | (ulCode >> 6)));
+		AppendByte((BYTE) (0x80 | (ulCode & 0x3F)));
+	}
+	else if (0x10000 > ulCode)
+	{
+		AppendByte((BYTE) (0xE0 | (ulCode >> 12)));
+		AppendByte((BYTE) (0x80 | ((ulCode >> 6) & 0x3F)));
+		AppendByte((BYTE) (0x80 | (ulCode & 0x3F)));
+	}
+	else
+	{
+		AppendByte((BYTE) (0xF0 | (ulCode >> 18)));
+		AppendByte((BYTE) (0x80 | ((ulCode >> 12) & 0x3F)));
+		AppendByte((BYTE) (0x80 | ((ulCode >> 6) & 0x3F)));
+		AppendByte((BYTE) (0x80 | (ulCode & 0x3F)));
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COstreamUTF8::operator<<
+//
+//	@doc:
+//		Write wide char array
+//
+//---------------------------------------------------------------------------
+IOstream&
+COstreamUTF8::operator <<
+	(
+	const WCHAR *wsz
+	)
+{
+	GPOS_ASSERT(NULL != wsz);
+
+	for (const WCHAR *pwc = wsz; '\0' != *pwc; pwc++)
+	{
+		AppendWc(*pwc);
+	}
+
+	return *this;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COstreamUTF8::operator<<
+//
+//	@doc:
+//		Write char array
+//
+//---------------------------------------------------------------------------
+IOstream&
+COstreamUTF8::operator <<
+	(
+	const CHAR *sz
+	)
+{
+	GPOS_ASSERT(NULL != sz);
+
+	for (const CHAR *pc = sz; '\0' != *pc; pc++)
+	{
+		AppendByte((BYTE) *pc);
+	}
+
+	return *this;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COstreamUTF8::operator<<
+//
+//	@doc:
+//		Write a wide char
+//
+//---------------------------------------------------------------------------
+IOstream&
+COstreamUTF8::operator <<
+	(
+	const WCHAR wc
+	)
+{
+	AppendWc(wc);
+
+	return *this;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COstreamUTF8::operator<<
+//
+//	@doc:
+//		Write a char
+//
+//---------------------------------------------------------------------------
+IOstream&
+COstreamUTF8::operator <<
+	(
+	const CHAR c
+	)
+{
+	AppendByte((BYTE) c);
+
+	return *this;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COstreamUTF8::Flush
+//
+//	@doc:
+//		Pass buffered bytes to the sink
+//
+//---------------------------------------------------------------------------
+void
+COstreamUTF8::Flush()
+{
+	if (0 == m_ulBuffered)
+	{
+		return;
+	}
+
+	// reset buffer before writing so that a failing sink does not see the
+	// same bytes again on a later flush
+	ULONG ulSize = m_ulBuffered;
+	m_ulBuffered = 0;
+	m_ullFlushed += ulSize;
+
+	m_psink->Write(m_rgb, ulSize);
+}
+
+// EOF
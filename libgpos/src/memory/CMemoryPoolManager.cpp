@@ -21,6 +21,7 @@
 #include "gpos/memory/CMemoryPoolAlloc.h"
 #include "gpos/memory/CMemoryPoolInjectFault.h"
 #include "gpos/memory/CMemoryPoolManager.h"
+#include "gpos/memory/CMemoryPoolSlab.h"
 #include "gpos/memory/CMemoryPoolStack.h"
 #include "gpos/memory/CMemoryPoolTracker.h"
 #include "gpos/memory/CMemoryVisitorPrint.h"
@@ -215,6 +216,15 @@ CMemoryPoolManager::PmpNew
 						fThreadSafe,
 						fOwnsUnderlying
 						);
+
+		case CMemoryPoolManager::EatSlab:
+			return GPOS_NEW(m_pmpInternal) CMemoryPoolSlab
+						(
+						pmpUnderlying,
+						ullCapacity,
+						fThreadSafe,
+						fOwnsUnderlying
+						);
 	}
 
 	GPOS_ASSERT(!"No matching pool type found");
@@ -0,0 +1,594 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CMemoryPoolSlab.cpp
+//
+//	@doc:
+//		Implementation of memory pool that serves small requests from
+//		size-class slabs.
+//
+//	@owner:
+//
+//	@test:
+//
+//---------------------------------------------------------------------------
+
+#include "gpos/assert.h"
+#include "gpos/types.h"
+#include "gpos/utils.h"
+#include "gpos/memory/CMemoryPoolSlab.h"
+#include "gpos/memory/CMemoryPoolManager.h"
+#include "gpos/task/CWorkerId.h"
+
+
+// size of a slab; slabs are aligned to their size
+#define GPOS_MEM_SLAB_SIZE			(64 * 1024)
+
+// number of slabs requested from the underlying pool at once
+#define GPOS_MEM_SLAB_CHUNK			(16)
+
+// number of objects moved to a free list when it runs empty
+#define GPOS_MEM_SLAB_BATCH			(32)
+
+// alignment of slab objects
+#define GPOS_MEM_SLAB_ALIGN			(16)
+
+#define GPOS_MEM_SLAB_HEADER_SIZE \
+	(GPOS_MEM_SLAB_ALIGN * ((GPOS_SIZEOF(SSlab) + GPOS_MEM_SLAB_ALIGN - 1) / GPOS_MEM_SLAB_ALIGN))
+
+#define GPOS_MEM_SLAB_LARGE_HEADER_SIZE \
+	(GPOS_MEM_ALIGNED_STRUCT_SIZE(SLargeBlock))
+
+// offset of large block addresses from the slab object alignment
+#define GPOS_MEM_SLAB_LARGE_OFFSET	(GPOS_MEM_SLAB_ALIGN / 2)
+
+#define GPOS_MEM_SLAB_BASE(pv) \
+	((ULONG_PTR) (pv) & ~((ULONG_PTR) GPOS_MEM_SLAB_SIZE - 1))
+
+
+using namespace gpos;
+
+// object sizes of the size classes
+static const ULONG rgulSlabSize[] =
+{
+	16, 32, 48, 64, 80, 96, 112, 128,
+	160, 192, 224, 256,
+	320, 384, 448, 512,
+	640, 768, 896, 1024
+};
+
+// size class by number of 16-byte units in a request
+static const BYTE rgbSlabClass[] =
+{
+	0,
+	0, 1, 2, 3, 4, 5, 6, 7,
+	8, 8, 9, 9, 10, 10, 11, 11,
+	12, 12, 12, 12, 13, 13, 13, 13, 14, 14, 14, 14, 15, 15, 15, 15,
+	16, 16, 16, 16, 16, 16, 16, 16, 17, 17, 17, 17, 17, 17, 17, 17,
+	18, 18, 18, 18, 18, 18, 18, 18, 19, 19, 19, 19, 19, 19, 19, 19
+};
+
+GPOS_CPL_ASSERT(GPOS_MEM_SLAB_CLASSES == GPOS_ARRAY_SIZE(rgulSlabSize));
+GPOS_CPL_ASSERT(GPOS_MEM_SLAB_MAX_OBJECT / GPOS_MEM_SLAB_ALIGN + 1 == GPOS_ARRAY_SIZE(rgbSlabClass));
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolSlab::CMemoryPoolSlab
+//
+//	@doc:
+//	  ctor
+//
+//---------------------------------------------------------------------------
+CMemoryPoolSlab::CMemoryPoolSlab
+	(
+	IMemoryPool *pmp,
+	ULLONG ullCapacity,
+	BOOL fThreadSafe,
+	BOOL fOwnsUnderlying
+	)
+	:
+	CMemoryPool(pmp, fOwnsUnderlying, fThreadSafe),
+	m_ullReserved(0),
+	m_ullCapacity(ullCapacity),
+	m_pslabNext(NULL),
+	m_ulSlabsLeft(0)
+{
+	GPOS_ASSERT(NULL != pmp);
+
+	m_listChunks.Init(GPOS_OFFSET(SSlab, m_link));
+	m_listLarge.Init(GPOS_OFFSET(SLargeBlock, m_link));
+
+	for (ULONG ul = 0; ul < GPOS_MEM_SLAB_CLASSES; ul++)
+	{
+		m_rgpslabCurrent[ul] = NULL;
+	}
+
+	for (ULONG ulSlot = 0; ulSlot < GPOS_MEM_SLAB_SLOTS; ulSlot++)
+	{
+		for (ULONG ul = 0; ul < GPOS_MEM_SLAB_CLASSES; ul++)
+		{
+			m_rgslot[ulSlot].m_rgpvFree[ul] = NULL;
+		}
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolSlab::~CMemoryPoolSlab
+//
+//	@doc:
+//		Dtor.
+//
+//---------------------------------------------------------------------------
+CMemoryPoolSlab::~CMemoryPoolSlab()
+{
+	GPOS_ASSERT(m_listChunks.FEmpty());
+	GPOS_ASSERT(m_listLarge.FEmpty());
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolSlab::UlSizeClass
+//
+//	@doc:
+//		Map allocation size to the smallest size class that fits it
+//
+//---------------------------------------------------------------------------
+ULONG
+CMemoryPoolSlab::UlSizeClass
+	(
+	ULONG ulAlloc
+	)
+{
+	GPOS_ASSERT(0 < ulAlloc && GPOS_MEM_SLAB_MAX_OBJECT >= ulAlloc);
+
+	ULONG ulSizeClass = rgbSlabClass[(ulAlloc + GPOS_MEM_SLAB_ALIGN - 1) / GPOS_MEM_SLAB_ALIGN];
+	GPOS_ASSERT(ulAlloc <= rgulSlabSize[ulSizeClass]);
+
+	return ulSizeClass;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolSlab::PslotSelf
+//
+//	@doc:
+//		Free list slot of the current thread; threads are spread over
+//		slots by their id, which needs no lookup in the worker table
+//
+//---------------------------------------------------------------------------
+CMemoryPoolSlab::SSlot *
+CMemoryPoolSlab::PslotSelf()
+{
+	if (!FThreadSafe())
+	{
+		return &m_rgslot[0];
+	}
+
+	CWorkerId widSelf;
+	return &m_rgslot[CWorkerId::UlHash(widSelf) % GPOS_MEM_SLAB_SLOTS];
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolSlab::PvAllocate
+//
+//	@doc:
+//		Allocate memory, either from the free list of the current thread,
+//		from a slab, or from the underlying pool for large requests
+//
+//---------------------------------------------------------------------------
+void *
+CMemoryPoolSlab::PvAllocate
+	(
+	ULONG ulBytes,
+	const CHAR *szFile,
+	const ULONG ulLine
+	)
+{
+	GPOS_ASSERT(GPOS_MEM_ALLOC_MAX >= ulBytes);
+
+	if (GPOS_MEM_SLAB_MAX_OBJECT < ulBytes)
+	{
+		return PvAllocateLarge(ulBytes, szFile, ulLine);
+	}
+
+	const ULONG ulSizeClass = UlSizeClass(ulBytes);
+	SSlot *pslot = PslotSelf();
+
+	// scope for slot spinlock
+	{
+		CAutoSpinlock as(pslot->m_slock);
+		SLock(as);
+
+		void *pv = pslot->m_rgpvFree[ulSizeClass];
+		if (NULL != pv)
+		{
+			pslot->m_rgpvFree[ulSizeClass] = *static_cast<void**>(pv);
+			return pv;
+		}
+	}
+
+	// free list is empty, carve a new batch of objects
+	void *pvTail = NULL;
+	void *pv = PvCarve(ulSizeClass, &pvTail);
+	if (NULL == pv)
+	{
+		return NULL;
+	}
+
+	void *pvRest = *static_cast<void**>(pv);
+	if (NULL != pvRest)
+	{
+		CAutoSpinlock as(pslot->m_slock);
+		SLock(as);
+
+		*static_cast<void**>(pvTail) = pslot->m_rgpvFree[ulSizeClass];
+		pslot->m_rgpvFree[ulSizeClass] = pvRest;
+	}
+
+	GPOS_ASSERT(0 == (ULONG_PTR) pv % GPOS_MEM_SLAB_ALIGN);
+
+	return pv;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolSlab::PvCarve
+//
+//	@doc:
+//		Carve a batch of objects of the given size class out of the current
+//		slab of the class; returns the objects as a linked list
+//
+//---------------------------------------------------------------------------
+void *
+CMemoryPoolSlab::PvCarve
+	(
+	ULONG ulSizeClass,
+	void **ppvTail
+	)
+{
+	GPOS_ASSERT(NULL != ppvTail);
+
+	const ULONG ulSize = rgulSlabSize[ulSizeClass];
+
+	CAutoSpinlock as(m_slock);
+	SLock(as);
+
+	SSlab *pslab = m_rgpslabCurrent[ulSizeClass];
+	if (NULL == pslab || GPOS_MEM_SLAB_SIZE - pslab->m_ulUsed < ulSize)
+	{
+		pslab = PslabNew(as, ulSizeClass);
+		if (NULL == pslab)
+		{
+			return NULL;
+		}
+
+		m_rgpslabCurrent[ulSizeClass] = pslab;
+	}
+
+	GPOS_ASSERT_IMP(FThreadSafe(), m_slock.FOwned());
+
+	ULONG ulCount = (GPOS_MEM_SLAB_SIZE - pslab->m_ulUsed) / ulSize;
+	if (GPOS_MEM_SLAB_BATCH < ulCount)
+	{
+		ulCount = GPOS_MEM_SLAB_BATCH;
+	}
+	GPOS_ASSERT(0 < ulCount);
+
+	BYTE *pbFirst = static_cast<BYTE*>(GPOS_MEM_OFFSET_POS(pslab, pslab->m_ulUsed));
+	pslab->m_ulUsed += ulCount * ulSize;
+
+	BYTE *pb = pbFirst;
+	for (ULONG ul = 1; ul < ulCount; ul++)
+	{
+		*reinterpret_cast<void**>(pb) = pb + ulSize;
+		pb += ulSize;
+	}
+	*reinterpret_cast<void**>(pb) = NULL;
+
+	*ppvTail = pb;
+	return pbFirst;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolSlab::PslabNew
+//
+//	@doc:
+//		Get an empty slab for the given size class; allocates a new chunk
+//		of slabs from the underlying pool if the current one is used up
+//
+//---------------------------------------------------------------------------
+CMemoryPoolSlab::SSlab *
+CMemoryPoolSlab::PslabNew
+	(
+	CAutoSpinlock &as,
+	ULONG ulSizeClass
+	)
+{
+	if (0 == m_ulSlabsLeft)
+	{
+		// reserve one extra slab to align the chunk to the slab size
+		const ULONG ulChunk = (GPOS_MEM_SLAB_CHUNK + 1) * GPOS_MEM_SLAB_SIZE;
+
+		// check if memory pool has enough capacity
+		if (ulChunk + m_ullReserved > m_ullCapacity)
+		{
+			return NULL;
+		}
+		m_ullReserved += ulChunk;
+
+		// release spinlock to allocate memory from underlying pool
+		SUnlock(as);
+		void *pvRaw = PmpUnderlying()->PvAllocate(ulChunk, __FILE__, __LINE__);
+		SLock(as);
+
+		if (NULL == pvRaw)
+		{
+			m_ullReserved -= ulChunk;
+			return NULL;
+		}
+
+		SSlab *pslabFirst = reinterpret_cast<SSlab*>
+				(
+				GPOS_MEM_SLAB_BASE((BYTE*) pvRaw + GPOS_MEM_SLAB_SIZE - 1)
+				);
+		pslabFirst->m_pvRaw = pvRaw;
+		pslabFirst->m_link.m_pvNext = NULL;
+		pslabFirst->m_link.m_pvPrev = NULL;
+
+		// keep track of new chunk; slabs left over in the previous chunk by
+		// a concurrent refill are released on tear down
+		m_listChunks.Append(pslabFirst);
+		m_pslabNext = pslabFirst;
+		m_ulSlabsLeft = GPOS_MEM_SLAB_CHUNK;
+	}
+
+	SSlab *pslab = m_pslabNext;
+	m_pslabNext = static_cast<SSlab*>(GPOS_MEM_OFFSET_POS(pslab, GPOS_MEM_SLAB_SIZE));
+	m_ulSlabsLeft--;
+
+	pslab->m_ulSizeClass = ulSizeClass;
+	pslab->m_ulUsed = GPOS_MEM_SLAB_HEADER_SIZE;
+
+	return pslab;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolSlab::PvAllocateLarge
+//
+//	@doc:
+//		Allocate request from the underlying pool; the returned address is
+//		placed half-way between two slab object boundaries
+//
+//---------------------------------------------------------------------------
+void *
+CMemoryPoolSlab::PvAllocateLarge
+	(
+	ULONG ulAlloc,
+	const CHAR *szFile,
+	const ULONG ulLine
+	)
+{
+	const ULONG ulTotal = GPOS_MEM_ALIGNED_SIZE(ulAlloc) + GPOS_MEM_SLAB_LARGE_HEADER_SIZE + GPOS_MEM_SLAB_ALIGN;
+
+	// scope for spinlock
+	{
+		CAutoSpinlock as(m_slock);
+		SLock(as);
+
+		// check if memory pool has enough capacity
+		if (ulTotal + m_ullReserved > m_ullCapacity)
+		{
+			return NULL;
+		}
+		m_ullReserved += ulTotal;
+	}
+
+	void *pvRaw = PmpUnderlying()->PvAllocate(ulTotal, szFile, ulLine);
+
+	CAutoSpinlock as(m_slock);
+	SLock(as);
+
+	if (NULL == pvRaw)
+	{
+		m_ullReserved -= ulTotal;
+		return NULL;
+	}
+
+	ULONG_PTR ulpUser = (ULONG_PTR) pvRaw + GPOS_MEM_SLAB_LARGE_HEADER_SIZE;
+	ulpUser += (GPOS_MEM_SLAB_ALIGN + GPOS_MEM_SLAB_LARGE_OFFSET - ulpUser % GPOS_MEM_SLAB_ALIGN) % GPOS_MEM_SLAB_ALIGN;
+	GPOS_ASSERT(GPOS_MEM_SLAB_LARGE_OFFSET == ulpUser % GPOS_MEM_SLAB_ALIGN);
+
+	SLargeBlock *plb = reinterpret_cast<SLargeBlock*>(ulpUser - GPOS_MEM_SLAB_LARGE_HEADER_SIZE);
+	plb->m_pvRaw = pvRaw;
+	plb->m_ulTotal = ulTotal;
+	plb->m_link.m_pvNext = NULL;
+	plb->m_link.m_pvPrev = NULL;
+
+	m_listLarge.Append(plb);
+
+	return reinterpret_cast<void*>(ulpUser);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolSlab::Free
+//
+//	@doc:
+//		Free memory; slab objects go to the free list of the current thread
+//
+//---------------------------------------------------------------------------
+void
+CMemoryPoolSlab::Free
+	(
+	void *pv
+	)
+{
+#ifdef GPOS_DEBUG
+	CheckAllocation(pv);
+#endif // GPOS_DEBUG
+
+	if (GPOS_MEM_SLAB_LARGE_OFFSET == (ULONG_PTR) pv % GPOS_MEM_SLAB_ALIGN)
+	{
+		FreeLarge(pv);
+		return;
+	}
+
+	const SSlab *pslab = reinterpret_cast<const SSlab*>(GPOS_MEM_SLAB_BASE(pv));
+	const ULONG ulSizeClass = pslab->m_ulSizeClass;
+	GPOS_ASSERT(GPOS_MEM_SLAB_CLASSES > ulSizeClass);
+
+	SSlot *pslot = PslotSelf();
+
+	CAutoSpinlock as(pslot->m_slock);
+	SLock(as);
+
+	*static_cast<void**>(pv) = pslot->m_rgpvFree[ulSizeClass];
+	pslot->m_rgpvFree[ulSizeClass] = pv;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolSlab::FreeLarge
+//
+//	@doc:
+//		Return request allocated from the underlying pool
+//
+//---------------------------------------------------------------------------
+void
+CMemoryPoolSlab::FreeLarge
+	(
+	void *pv
+	)
+{
+	SLargeBlock *plb = reinterpret_cast<SLargeBlock*>
+			(
+			static_cast<BYTE*>(pv) - GPOS_MEM_SLAB_LARGE_HEADER_SIZE
+			);
+	void *pvRaw = plb->m_pvRaw;
+
+	// scope for spinlock
+	{
+		CAutoSpinlock as(m_slock);
+		SLock(as);
+
+		m_listLarge.Remove(plb);
+		m_ullReserved -= plb->m_ulTotal;
+	}
+
+	PmpUnderlying()->Free(pvRaw);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolSlab::TearDown
+//
+//	@doc:
+//		Return all used memory to the underlying pool and tear it down.
+//
+//---------------------------------------------------------------------------
+void
+CMemoryPoolSlab::TearDown()
+{
+	GPOS_ASSERT(!m_slock.FOwned());
+
+	while (!m_listLarge.FEmpty())
+	{
+		PmpUnderlying()->Free(m_listLarge.RemoveHead()->m_pvRaw);
+	}
+
+	while (!m_listChunks.FEmpty())
+	{
+		PmpUnderlying()->Free(m_listChunks.RemoveHead()->m_pvRaw);
+	}
+
+	CMemoryPool::TearDown();
+
+	m_ullReserved = 0;
+	m_pslabNext = NULL;
+	m_ulSlabsLeft = 0;
+
+	for (ULONG ul = 0; ul < GPOS_MEM_SLAB_CLASSES; ul++)
+	{
+		m_rgpslabCurrent[ul] = NULL;
+	}
+
+	for (ULONG ulSlot = 0; ulSlot < GPOS_MEM_SLAB_SLOTS; ulSlot++)
+	{
+		for (ULONG ul = 0; ul < GPOS_MEM_SLAB_CLASSES; ul++)
+		{
+			m_rgslot[ulSlot].m_rgpvFree[ul] = NULL;
+		}
+	}
+}
+
+#ifdef GPOS_DEBUG
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolSlab::CheckAllocation
+//
+//	@doc:
+//		Verifies that an allocation is correct and came from this pool.
+//
+//---------------------------------------------------------------------------
+void
+CMemoryPoolSlab::CheckAllocation
+	(
+	void *pv
+	)
+{
+	CAutoSpinlock as(m_slock);
+	SLock(as);
+
+	if (GPOS_MEM_SLAB_LARGE_OFFSET == (ULONG_PTR) pv % GPOS_MEM_SLAB_ALIGN)
+	{
+		SLargeBlock *plb = m_listLarge.PtFirst();
+		while (NULL != plb)
+		{
+			if (GPOS_MEM_OFFSET_POS(plb, GPOS_MEM_SLAB_LARGE_HEADER_SIZE) == pv)
+			{
+				return;
+			}
+
+			plb = m_listLarge.PtNext(plb);
+		}
+
+		GPOS_ASSERT(!"object is allocated in one of the large blocks");
+	}
+
+	SSlab *pslab = m_listChunks.PtFirst();
+	while (NULL != pslab)
+	{
+		if (pv >= GPOS_MEM_OFFSET_POS(pslab, GPOS_MEM_SLAB_HEADER_SIZE) &&
+			pv < GPOS_MEM_OFFSET_POS(pslab, GPOS_MEM_SLAB_CHUNK * GPOS_MEM_SLAB_SIZE))
+		{
+			return;
+		}
+
+		pslab = m_listChunks.PtNext(pslab);
+	}
+
+	GPOS_ASSERT(!"object is allocated in one of the slabs");
+}
+
+#endif // GPOS_DEBUG
+
+// EOF
+
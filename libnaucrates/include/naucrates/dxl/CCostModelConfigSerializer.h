@@ -7,6 +7,8 @@
 #include <gpopt/cost/ICostModel.h>
 #include "gpos/memory/IMemoryPool.h"
 #include "gpos/common/CAutoP.h"
+#include "gpopt/cost/ICostModelParams.h"
+#include "naucrates/dxl/xml/dxltokens.h"
 
 
 namespace gpdxl
@@ -16,10 +18,22 @@ namespace gpdxl
 	{
 		private:
 			const gpopt::ICostModel *m_pcm;
+
+			// serialize a param value without losing precision, since
+			// calibrated coefficients are often far below 1e-6
+			static
+			void AddAttribute(CXMLSerializer &xmlser, Edxltoken edxltokenAttr, CDouble dValue);
+
 		public:
 			CCostModelConfigSerializer(const gpopt::ICostModel *pcm);
 
 			void Serialize(CXMLSerializer &xmlser) const;
+
+			// serialize cost params with the version of the parameter set;
+			// unless fDefaults is set, params that have their default value
+			// are omitted
+			static
+			void SerializeCostParams(CXMLSerializer &xmlser, const gpopt::ICostModelParams *pcp, BOOL fDefaults);
 	};
 }
 #endif
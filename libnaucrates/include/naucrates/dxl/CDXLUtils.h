@@ -38,6 +38,7 @@ namespace gpopt
 	class CStatisticsConfig;
 	class COptimizerConfig;
 	class ICostModel;
+	class ICostModelParams;
 }
 
 namespace gpdxl
@@ -161,6 +162,17 @@ namespace gpdxl
 				const CHAR *szXSDPath
 				);
 
+			// parse a versioned calibration file of cost params and create
+			// a GPDB cost model using them
+			static
+			ICostModel *PcmParseCalibrationFile
+				(
+				IMemoryPool *pmp,
+				const CHAR *szFileName,
+				const CHAR *szXSDPath,
+				ULONG ulSegments
+				);
+
 			static 
 			DrgPimdobj *PdrgpmdobjParseDXL
 				(
@@ -358,6 +370,15 @@ namespace gpdxl
 				BOOL fIndent
 				);
 
+			// serialize all cost params into a calibration file
+			static
+			CWStringDynamic *PstrSerializeCostParams
+				(
+				IMemoryPool *pmp,
+				const ICostModelParams *pcp,
+				BOOL fIndent
+				);
+
 			// serialize a metadata object into DXL
 			static 
 			CWStringDynamic *PstrSerializeMDObj
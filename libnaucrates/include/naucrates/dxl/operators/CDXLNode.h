@@ -154,6 +154,10 @@ namespace gpdxl
 
 			void SerializeChildrenToDXL(CXMLSerializer *pxmlser) const;
 
+			// is the node a scalar expression that may be serialized once and
+			// referred to from all its parents
+			BOOL FShareable() const;
+
 			// setter
 			void SetProperties(CDXLProperties *pdxlprop);
 
@@ -1630,6 +1630,15 @@ namespace gpdxl
 				CParseHandlerBase *pphRoot
 				);
 
+			// construct a shared scalar subtree parse handler
+			static
+			CParseHandlerBase *PphScalarShared
+				(
+				IMemoryPool *pmp,
+				CParseHandlerManager *pphm,
+				CParseHandlerBase *pphRoot
+				);
+
 			// construct a values scan parse handler
 			static
 			CParseHandlerBase *PphValuesScan
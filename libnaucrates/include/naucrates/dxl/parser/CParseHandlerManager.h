@@ -18,6 +18,7 @@
 #include "gpos/common/CStack.h"
 
 #include "naucrates/dxl/parser/CParseHandlerBase.h"
+#include "naucrates/dxl/operators/CDXLNode.h"
 
 #include <xercesc/sax2/SAX2XMLReader.hpp>
 
@@ -60,6 +61,9 @@ namespace gpdxl
 		
 			// steps since last check for aborts
 			ULONG m_ulIterLastCFA;
+
+			// shared scalar subtrees parsed so far, indexed by their ids
+			HMUlPdxln *m_phmuldxlnShared;
 			
 			// check for aborts at regular intervals
 			void CheckForAborts();
@@ -104,6 +108,13 @@ namespace gpdxl
 			
 			// Returns the current parse handler if one exists; used for debugging purposes
 			const CParseHandlerBase *PphCurrent();
+
+			// register a shared scalar subtree under the given id
+			void RegisterSharedScalar(ULONG ulId, CDXLNode *pdxln);
+
+			// shared scalar subtree with the given id; NULL if no subtree was
+			// registered under that id
+			CDXLNode *PdxlnSharedScalar(ULONG ulId) const;
 			
 	};
 }
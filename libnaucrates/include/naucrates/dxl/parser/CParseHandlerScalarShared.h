@@ -0,0 +1,76 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2018 Pivotal, Inc.
+//
+//	@filename:
+//		CParseHandlerScalarShared.h
+//
+//	@doc:
+//		SAX parse handler class for parsing scalar subtrees shared by several
+//		parents
+//---------------------------------------------------------------------------
+#ifndef GPDXL_CParseHandlerScalarShared_H
+#define GPDXL_CParseHandlerScalarShared_H
+
+#include "gpos/base.h"
+#include "naucrates/dxl/parser/CParseHandlerScalarOp.h"
+
+
+namespace gpdxl
+{
+	using namespace gpos;
+
+	XERCES_CPP_NAMESPACE_USE
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CParseHandlerScalarShared
+	//
+	//	@doc:
+	//		Parse handler for parsing a shared scalar subtree; the first
+	//		occurrence of the subtree carries its id and the subtree itself,
+	//		later occurrences only carry the id and resolve to the same node
+	//
+	//---------------------------------------------------------------------------
+	class CParseHandlerScalarShared : public CParseHandlerScalarOp
+	{
+		private:
+
+			// id of the shared subtree
+			ULONG m_ulId;
+
+			// private copy ctor
+			CParseHandlerScalarShared(const CParseHandlerScalarShared &);
+
+			// process the start of an element
+			void StartElement
+					(
+					const XMLCh* const xmlszUri,
+					const XMLCh* const xmlszLocalname,
+					const XMLCh* const xmlszQname,
+					const Attributes& attr
+					);
+
+			// process the end of an element
+			void EndElement
+					(
+					const XMLCh* const xmlszUri,
+					const XMLCh* const xmlszLocalname,
+					const XMLCh* const xmlszQname
+					);
+
+		public:
+			// ctor
+			CParseHandlerScalarShared
+					(
+					IMemoryPool *pmp,
+					CParseHandlerManager *pphm,
+					CParseHandlerBase *pphRoot
+					);
+
+		};
+}
+
+#endif // !GPDXL_CParseHandlerScalarShared_H
+
+//EOF
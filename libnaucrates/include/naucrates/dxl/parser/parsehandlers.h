@@ -162,6 +162,7 @@
 #include "naucrates/dxl/parser/CParseHandlerScalarPartListValues.h"
 #include "naucrates/dxl/parser/CParseHandlerScalarPartListNullTest.h"
 #include "naucrates/dxl/parser/CParseHandlerScalarValuesList.h"
+#include "naucrates/dxl/parser/CParseHandlerScalarShared.h"
 
 #include "naucrates/dxl/parser/CParseHandlerLogicalConstTable.h"
 
@@ -18,12 +18,20 @@
 #include "gpos/io/COstream.h"
 
 #include "gpos/common/CStack.h"
+#include "gpos/common/CHashMap.h"
 #include "naucrates/dxl/xml/dxltokens.h"
 
 namespace gpdxl
 {
 	using namespace gpos;
 	
+	// fwd decl
+	class CDXLNode;
+
+	// map of DXL nodes to counters
+	typedef CHashMap<CDXLNode, ULONG, gpos::UlHashPtr<CDXLNode>, gpos::FEqualPtr<CDXLNode>,
+				CleanupNULL<CDXLNode>, CleanupDelete<ULONG> > HMDxlnUl;
+
 	//---------------------------------------------------------------------------
 	//	@class:
 	//		CXMLSerializer
@@ -59,12 +67,22 @@ namespace gpdxl
 			// steps since last check for aborts
 			ULONG m_ulIterLastCFA;
 			
+			// number of parents of each shareable subtree; NULL unless shared
+			// subtrees are serialized once
+			HMDxlnUl *m_phmdxlnulParents;
+
+			// ids of the shared subtrees serialized so far
+			HMDxlnUl *m_phmdxlnulIds;
+
 			// private copy ctor
 			CXMLSerializer(const CXMLSerializer&);
 			
 			// add indentation
 			void Indent();
 			
+			// count the parents of the shareable subtrees below the given node
+			void CountParents(const CDXLNode *pdxln);
+			
 			// escape the given string and write it to the given stream
 			static
 			void WriteEscaped(IOstream &os, const CWStringBase *pstr);
@@ -84,7 +102,9 @@ namespace gpdxl
 				m_strstackElems(NULL),
 				m_fOpenTag(false),
 				m_ulLevel(0),
-				m_ulIterLastCFA(0)
+				m_ulIterLastCFA(0),
+				m_phmdxlnulParents(NULL),
+				m_phmdxlnulIds(NULL)
 			{
 				m_strstackElems = GPOS_NEW(m_pmp) StrStack(m_pmp);
 			}
@@ -132,6 +152,15 @@ namespace gpdxl
 
 			// add a byte array attribute
 			void AddAttribute(const CWStringBase *pstrAttr, BOOL fNull, const BYTE *pba, ULONG ulLen);
+
+			// serialize shareable subtrees with several parents in the given
+			// tree only once, and refer to them by id elsewhere
+			void ShareSubtrees(const CDXLNode *pdxlnRoot);
+
+			// id of the given subtree if it is serialized once and referred to
+			// elsewhere, and ulong_max otherwise; the flag is set if the subtree
+			// was serialized before
+			ULONG UlSharedId(const CDXLNode *pdxln, BOOL *pfSerialized);
 	};
 	
 }
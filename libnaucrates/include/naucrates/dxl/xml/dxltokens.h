@@ -64,6 +64,8 @@ namespace gpdxl
 		EdxltokenJoinOrderDPThreshold,
 		EdxltokenBroadcastThreshold,
 		EdxltokenEnforceConstraintsOnDML,
+		EdxltokenOptimizerWorkers,
+		EdxltokenOptimizationDeadline,
 		EdxltokenWindowOids,
 		EdxltokenOidRowNumber,
 		EdxltokenOidRank,
@@ -223,6 +225,8 @@ namespace gpdxl
 		EdxltokenScalarPrintableFilter,
 		EdxltokenScalarBitmapIndexProbe,
 		EdxltokenScalarValuesList,
+		EdxltokenScalarShared,
+		EdxltokenScalarSharedId,
 
 		EdxltokenWindowFrame,
 		EdxltokenScalarWindowFrameLeadingEdge,
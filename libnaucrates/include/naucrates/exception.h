@@ -60,6 +60,7 @@ namespace gpdxl
 		ExmiMDCacheEntryDuplicate,
 		ExmiMDCacheEntryNotFound,
 		ExmiMDObjUnsupported,
+		ExmiMDBinaryFormatError,
 		
 		// communication related errors
 		ExmiCommPropagateError,
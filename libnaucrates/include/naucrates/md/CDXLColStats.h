@@ -70,9 +70,6 @@ namespace gpmd
 			// is column statistics missing in the database
 			BOOL m_fColStatsMissing;
 
-			// DXL string for object
-			CWStringDynamic *m_pstr;
-			
 			// private copy ctor
 			CDXLColStats(const CDXLColStats &);
 		
@@ -103,10 +100,6 @@ namespace gpmd
 			virtual 
 			CMDName Mdname() const;
 			
-			// DXL string representation of cache object 
-			virtual 
-			const CWStringDynamic *Pstr() const;
-			
 			// number of buckets
 			virtual
 			ULONG UlBuckets() const;
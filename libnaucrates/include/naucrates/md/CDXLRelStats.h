@@ -59,9 +59,6 @@ namespace gpmd
 			// flag to indicate if input relation is empty
 			BOOL m_fEmpty;
 
-			// DXL string for object
-			CWStringDynamic *m_pstr;
-			
 			// private copy ctor
 			CDXLRelStats(const CDXLRelStats &);
 		
@@ -87,10 +84,6 @@ namespace gpmd
 			virtual 
 			CMDName Mdname() const;
 			
-			// DXL string representation of cache object 
-			virtual 
-			const CWStringDynamic *Pstr() const;
-			
 			// number of rows
 			virtual
 			CDouble DRows() const;
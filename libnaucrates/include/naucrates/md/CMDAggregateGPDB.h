@@ -39,9 +39,6 @@ namespace gpmd
 		// memory pool
 		IMemoryPool *m_pmp;
 		
-		// DXL for object
-		const CWStringDynamic *m_pstr;
-		
 		// aggregate id
 		IMDId *m_pmdid;
 		
@@ -83,12 +80,6 @@ namespace gpmd
 		//dtor
 		~CMDAggregateGPDB();
 		
-		// string representation of object
-		virtual const CWStringDynamic *Pstr() const
-		{
-			return m_pstr;
-		}
-		
 		// aggregate id
 		virtual 
 		IMDId *Pmdid() const;
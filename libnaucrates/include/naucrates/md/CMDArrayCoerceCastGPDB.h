@@ -27,9 +27,6 @@ namespace gpmd
 	class CMDArrayCoerceCastGPDB : public CMDCastGPDB
 	{
 		private:
-			// DXL for object
-			const CWStringDynamic *m_pstr;
-
 			// type mod
 			INT m_iTypeModifier;
 
@@ -67,13 +64,6 @@ namespace gpmd
 			virtual
 			~CMDArrayCoerceCastGPDB();
 
-			// accessors
-			virtual
-			const CWStringDynamic *Pstr() const
-			{
-				return m_pstr;
-			}
-
 			// return type modifier
 			virtual
 			INT ITypeModifier() const;
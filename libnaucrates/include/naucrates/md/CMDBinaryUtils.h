@@ -0,0 +1,292 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CMDBinaryUtils.h
+//
+//	@doc:
+//		Compact binary encoding of metadata cache objects. The encoding is
+//		used by metadata providers to ship objects to the metadata accessor
+//		without going through DXL serialization and parsing; DXL remains the
+//		format for minidumps and debugging.
+//---------------------------------------------------------------------------
+
+#ifndef GPMD_CMDBinaryUtils_H
+#define GPMD_CMDBinaryUtils_H
+
+#include "gpos/base.h"
+#include "gpos/common/CDouble.h"
+
+#include "naucrates/md/IMDCacheObject.h"
+
+namespace gpdxl
+{
+	class CDXLDatum;
+}
+
+namespace gpmd
+{
+	using namespace gpos;
+	using namespace gpdxl;
+
+	// fwd decl
+	class CMDName;
+	class CMDIdGPDB;
+	class CDXLRelStats;
+	class CDXLColStats;
+	class CMDScalarOpGPDB;
+	class CMDCastGPDB;
+	class CMDScCmpGPDB;
+	class CMDRelationGPDB;
+	class IMDType;
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CMDBinaryUtils
+	//
+	//	@doc:
+	//		Encoder and decoder of the binary metadata wire format.
+	//
+	//		An encoded object starts with a fixed header: magic number, format
+	//		version, object type (IMDCacheObject::Emdtype) and total length in
+	//		bytes, followed by the object payload. All integers are stored in
+	//		little-endian byte order, doubles as their IEEE-754 bit pattern.
+	//
+	//		Relations with column default values or partition constraints
+	//		carry DXL expression trees and are not encoded; for such objects
+	//		PbSerialize returns NULL and providers fall back to DXL.
+	//
+	//---------------------------------------------------------------------------
+	class CMDBinaryUtils
+	{
+		public:
+
+			// magic number of an encoded object ("GOMD")
+			static
+			const ULONG ulMagic = 0x444D4F47;
+
+			// current version of the encoding
+			static
+			const ULONG ulVersion = 1;
+
+			// size of the object header in bytes
+			static
+			const ULONG ulHeaderSize = 4 * sizeof(ULONG);
+
+		private:
+
+			//---------------------------------------------------------------------------
+			//	@class:
+			//		CWriter
+			//
+			//	@doc:
+			//		Append-only growable byte buffer
+			//
+			//---------------------------------------------------------------------------
+			class CWriter
+			{
+				private:
+
+					// memory pool
+					IMemoryPool *m_pmp;
+
+					// buffer
+					BYTE *m_pb;
+
+					// number of bytes written
+					ULONG m_ulSize;
+
+					// allocated size of the buffer
+					ULONG m_ulCapacity;
+
+					// make room for the given number of bytes
+					void Reserve(ULONG ulBytes);
+
+					// private copy ctor
+					CWriter(const CWriter &);
+
+				public:
+
+					// ctor
+					explicit
+					CWriter(IMemoryPool *pmp);
+
+					// dtor
+					~CWriter();
+
+					// number of bytes written so far
+					ULONG UlSize() const
+					{
+						return m_ulSize;
+					}
+
+					// append raw bytes
+					void WriteBytes(const BYTE *pb, ULONG ulBytes);
+
+					// overwrite an integer at the given offset
+					void Patch(ULONG ulOffset, ULONG ul);
+
+					// append primitive values
+					void WriteByte(BYTE b);
+					void WriteBool(BOOL f);
+					void WriteUlong(ULONG ul);
+					void WriteInt(INT i);
+					void WriteUllong(ULLONG ull);
+					void WriteLint(LINT l);
+					void WriteDouble(CDouble d);
+
+					// append a metadata name
+					void WriteMDName(const CMDName &mdname);
+
+					// append a metadata id, which may be NULL
+					void WriteMDId(const IMDId *pmdid);
+
+					// append a DXL datum
+					void WriteDatum(const CDXLDatum *pdxldatum);
+
+					// hand over the buffer to the caller
+					BYTE *PbDetach(ULONG *pulSize);
+
+			}; // class CWriter
+
+			//---------------------------------------------------------------------------
+			//	@class:
+			//		CReader
+			//
+			//	@doc:
+			//		Bounds-checked reader over an encoded object
+			//
+			//---------------------------------------------------------------------------
+			class CReader
+			{
+				private:
+
+					// memory pool for the decoded objects
+					IMemoryPool *m_pmp;
+
+					// encoded bytes
+					const BYTE *m_pb;
+
+					// number of encoded bytes
+					ULONG m_ulSize;
+
+					// current read position
+					ULONG m_ulOffset;
+
+					// consume the given number of bytes
+					const BYTE *PbRead(ULONG ulBytes);
+
+					// private copy ctor
+					CReader(const CReader &);
+
+				public:
+
+					// ctor
+					CReader(IMemoryPool *pmp, const BYTE *pb, ULONG ulSize);
+
+					// is the whole buffer consumed
+					BOOL FDone() const
+					{
+						return m_ulOffset == m_ulSize;
+					}
+
+					// read primitive values
+					BYTE BRead();
+					BOOL FRead();
+					ULONG UlRead();
+					INT IRead();
+					ULLONG UllRead();
+					LINT LRead();
+					CDouble DRead();
+
+					// read a metadata name
+					CMDName *PmdnameRead();
+
+					// read a metadata id, which may be NULL
+					IMDId *PmdidRead();
+
+					// read a GPDB metadata id
+					CMDIdGPDB *PmdidGPDBRead();
+
+					// read a DXL datum
+					CDXLDatum *PdxldatumRead();
+
+			}; // class CReader
+
+			// raise an error for a malformed encoding
+			static
+			void RaiseMalformed();
+
+			// check whether a relation can be encoded
+			static
+			BOOL FSerializableRelation(const CMDRelationGPDB *pmdrel);
+
+			// encoders of the supported object types
+			static
+			void SerializeRelStats(CWriter *pwriter, const CDXLRelStats *pdxlrelstats);
+
+			static
+			void SerializeColStats(CWriter *pwriter, const CDXLColStats *pdxlcolstats);
+
+			static
+			void SerializeScalarOp(CWriter *pwriter, const CMDScalarOpGPDB *pmdscop);
+
+			static
+			void SerializeCast(CWriter *pwriter, const CMDCastGPDB *pmdcast);
+
+			static
+			void SerializeScCmp(CWriter *pwriter, const CMDScCmpGPDB *pmdsccmp);
+
+			static
+			void SerializeType(CWriter *pwriter, const IMDType *pmdtype);
+
+			static
+			void SerializeRelation(CWriter *pwriter, const CMDRelationGPDB *pmdrel);
+
+			// decoders of the supported object types
+			static
+			IMDCacheObject *PimdobjRelStats(IMemoryPool *pmp, CReader *preader);
+
+			static
+			IMDCacheObject *PimdobjColStats(IMemoryPool *pmp, CReader *preader);
+
+			static
+			IMDCacheObject *PimdobjScalarOp(IMemoryPool *pmp, CReader *preader);
+
+			static
+			IMDCacheObject *PimdobjCast(IMemoryPool *pmp, CReader *preader);
+
+			static
+			IMDCacheObject *PimdobjScCmp(IMemoryPool *pmp, CReader *preader);
+
+			static
+			IMDCacheObject *PimdobjType(IMemoryPool *pmp, CReader *preader);
+
+			static
+			IMDCacheObject *PimdobjRelation(IMemoryPool *pmp, CReader *preader);
+
+		public:
+
+			// does the binary encoding support the given object
+			static
+			BOOL FSerializable(const IMDCacheObject *pimdobj);
+
+			// encode the given object; returns NULL if the object is not supported
+			static
+			BYTE *PbSerialize(IMemoryPool *pmp, const IMDCacheObject *pimdobj, ULONG *pulSize);
+
+			// total size of an encoded object as recorded in its header
+			static
+			ULONG UlSize(const BYTE *pb);
+
+			// decode an object in the given memory pool
+			static
+			IMDCacheObject *PimdobjDeserialize(IMemoryPool *pmp, const BYTE *pb, ULONG ulSize);
+
+	}; // class CMDBinaryUtils
+}
+
+#endif // !GPMD_CMDBinaryUtils_H
+
+// EOF
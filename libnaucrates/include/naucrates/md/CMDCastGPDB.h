@@ -40,9 +40,6 @@ namespace gpmd
 			// memory pool
 			IMemoryPool *m_pmp;
 			
-			// DXL for object
-			const CWStringDynamic *m_pstr;
-			
 			// func id
 			IMDId *m_pmdid;
 			
@@ -82,13 +79,6 @@ namespace gpmd
 			virtual
 			~CMDCastGPDB();
 			
-			// accessors
-			virtual 
-			const CWStringDynamic *Pstr() const
-			{
-				return m_pstr;
-			}
-			
 			// cast object id
 			virtual 
 			IMDId *Pmdid() const;
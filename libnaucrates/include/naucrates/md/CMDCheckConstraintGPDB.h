@@ -56,9 +56,6 @@ namespace gpmd
 			// the DXL representation of the check constraint
 			CDXLNode *m_pdxln;
 
-			// DXL for object
-			const CWStringDynamic *m_pstr;
-
 		public:
 
 			// ctor
@@ -96,13 +93,6 @@ namespace gpmd
 				return m_pmdidRel;
 			}
 
-			// DXL string for check constraint
-			virtual
-			const CWStringDynamic *Pstr() const
-			{
-				return m_pstr;
-			}
-
 			// the scalar expression of the check constraint
 			virtual
 			CExpression *Pexpr(IMemoryPool *pmp, CMDAccessor *pmda, DrgPcr *pdrgpcr) const;
@@ -119,7 +119,13 @@ namespace gpmd
 			// is the column dropped
 			virtual
 			BOOL FDropped() const;
-		
+
+			// default value expression, if any
+			const gpdxl::CDXLNode *PdxlnDefaultValue() const
+			{
+				return m_pdxlnDefaultValue;
+			}
+
 			// serialize metadata object in DXL format given a serializer object
 			virtual	
 			void Serialize(gpdxl::CXMLSerializer *) const;
@@ -37,9 +37,6 @@ namespace gpmd
 			// memory pool
 			IMemoryPool *m_pmp;
 			
-			// DXL for object
-			const CWStringDynamic *m_pstr;
-			
 			// func id
 			IMDId *m_pmdid;
 			
@@ -103,13 +100,6 @@ namespace gpmd
 			virtual
 			~CMDFunctionGPDB();
 			
-			// accessors
-			virtual 
-			const CWStringDynamic *Pstr() const
-			{
-				return m_pstr;
-			}
-			
 			// function id
 			virtual 
 			IMDId *Pmdid() const;
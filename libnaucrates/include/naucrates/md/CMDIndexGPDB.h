@@ -67,9 +67,6 @@ namespace gpmd
 			// partition constraint
 			IMDPartConstraint *m_pmdpartcnstr;
 			
-			// DXL for object
-			const CWStringDynamic *m_pstr;
-		
 			// private copy ctor
 			CMDIndexGPDB(const CMDIndexGPDB &);
 			
@@ -138,13 +135,6 @@ namespace gpmd
 			virtual
 			IMDPartConstraint *Pmdpartcnstr() const;
 
-			// DXL string for index
-			virtual 
-			const CWStringDynamic *Pstr() const
-			{
-				return m_pstr;
-			}	
-			
 			// serialize MD index in DXL format given a serializer object
 			virtual 
 			void Serialize(gpdxl::CXMLSerializer *) const;
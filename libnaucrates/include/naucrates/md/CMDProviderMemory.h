@@ -45,6 +45,14 @@ namespace gpmd
 			
 			// metadata objects indexed by their metadata id
 			MDMap *m_pmdmap;
+
+			// hash map of binary encoded MD objects indexed by their MD id
+			typedef CHashMap<IMDId, BYTE,
+							IMDId::UlHashMDId, IMDId::FEqualMDId,
+							CleanupRelease, CleanupDeleteRg> MDBinaryMap;
+
+			// binary encodings of the metadata objects that support them
+			MDBinaryMap *m_pmdbinmap;
 			
 			// load MD objects in the hash map
 			void LoadMetadataObjectsFromArray(IMemoryPool *pmp, DrgPimdobj *pdrgpmdobj);
@@ -67,6 +75,10 @@ namespace gpmd
 			// returns the DXL string of the requested metadata object
 			virtual 
 			CWStringBase *PstrObject(IMemoryPool *pmp, CMDAccessor *pmda, IMDId *pmdid) const;
+
+			// returns the binary encoding of the requested metadata object
+			virtual
+			BYTE *PbObject(IMemoryPool *pmp, CMDAccessor *pmda, IMDId *pmdid, ULONG *pulSize) const;
 			
 			// return the mdid for the specified system id and type
 			virtual
@@ -47,9 +47,6 @@ namespace gpmd
 			// memory pool
 			IMemoryPool *m_pmp;
 
-			// DXL for object
-			const CWStringDynamic *m_pstr;
-
 			// relation mdid
 			IMDId *m_pmdid;
 
@@ -126,13 +123,6 @@ namespace gpmd
 			virtual
 			~CMDRelationCtasGPDB();
 
-			// accessors
-			virtual
-			const CWStringDynamic *Pstr() const
-			{
-				return m_pstr;
-			}
-
 			// the metadata id
 			virtual
 			IMDId *Pmdid() const;
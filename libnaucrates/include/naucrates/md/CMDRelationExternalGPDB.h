@@ -45,9 +45,6 @@ namespace gpmd
 			// memory pool
 			IMemoryPool *m_pmp;
 
-			// DXL for object
-			const CWStringDynamic *m_pstr;
-
 			// relation mdid
 			IMDId *m_pmdid;
 
@@ -137,13 +134,6 @@ namespace gpmd
 			virtual
 			~CMDRelationExternalGPDB();
 
-			// accessors
-			virtual
-			const CWStringDynamic *Pstr() const
-			{
-				return m_pstr;
-			}
-
 			// the metadata id
 			virtual
 			IMDId *Pmdid() const;
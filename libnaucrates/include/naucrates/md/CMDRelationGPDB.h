@@ -48,9 +48,6 @@ namespace gpmd
 			// memory pool
 			IMemoryPool *m_pmp;
 
-			// DXL for object
-			const CWStringDynamic *m_pstr;
-			
 			// relation mdid
 			IMDId *m_pmdid;
 			
@@ -153,13 +150,6 @@ namespace gpmd
 			virtual
 			~CMDRelationGPDB();
 			
-			// accessors
-			virtual 
-			const CWStringDynamic *Pstr() const
-			{
-				return m_pstr;
-			}	
-			
 			// the metadata id
 			virtual 
 			IMDId *Pmdid() const;
@@ -37,9 +37,6 @@ namespace gpmd
 			// memory pool
 			IMemoryPool *m_pmp;
 			
-			// DXL for object
-			const CWStringDynamic *m_pstr;
-			
 			// object id
 			IMDId *m_pmdid;
 			
@@ -78,13 +75,6 @@ namespace gpmd
 			virtual
 			~CMDScCmpGPDB();
 			
-			// accessors
-			virtual 
-			const CWStringDynamic *Pstr() const
-			{
-				return m_pstr;
-			}
-			
 			// copmarison object id
 			virtual 
 			IMDId *Pmdid() const;
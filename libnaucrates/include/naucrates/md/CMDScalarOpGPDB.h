@@ -39,9 +39,6 @@ namespace gpmd
 			// memory pool
 			IMemoryPool *m_pmp;
 			
-			// DXL for object
-			const CWStringDynamic *m_pstr;
-			
 			// operator id
 			IMDId *m_pmdid;
 			
@@ -98,13 +95,6 @@ namespace gpmd
 			
 			~CMDScalarOpGPDB();
 			
-			// accessors
-			virtual 
-			const CWStringDynamic *Pstr() const
-			{
-				return m_pstr;
-			}
-			
 			// operator id
 			virtual
 			IMDId *Pmdid() const;
@@ -40,9 +40,6 @@ namespace gpmd
 			// memory pool
 			IMemoryPool *m_pmp;
 
-			// DXL for object
-			const CWStringDynamic *m_pstr;
-
 			// trigger id
 			IMDId *m_pmdid;
 
@@ -80,13 +77,6 @@ namespace gpmd
 			// dtor
 			~CMDTriggerGPDB();
 
-			// accessors
-			virtual
-			const CWStringDynamic *Pstr() const
-			{
-				return m_pstr;
-			}
-
 			// trigger id
 			virtual
 			IMDId *Pmdid() const
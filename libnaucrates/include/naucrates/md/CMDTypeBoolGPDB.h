@@ -90,9 +90,6 @@ namespace gpmd
 		// count aggregate
 		IMDId *m_pmdidCount;
 
-		// DXL for object
-		const CWStringDynamic *m_pstr;
-		
 		// type name and id
 		static CWStringConst m_str;
 		static CMDName m_mdname;
@@ -112,13 +109,6 @@ namespace gpmd
 		virtual 
 		~CMDTypeBoolGPDB();
 		
-		// accessors
-		virtual 
-		const CWStringDynamic *Pstr() const
-		{
-			return m_pstr;
-		}
-		
 		// type id
 		virtual 
 		IMDId *Pmdid() const;
@@ -43,9 +43,6 @@ namespace gpmd
 			// memory pool
 			IMemoryPool *m_pmp;
 			
-			// DXL for object
-			const CWStringDynamic *m_pstr;
-			
 			// metadata id
 			IMDId *m_pmdid;
 			
@@ -156,12 +153,6 @@ namespace gpmd
 			~CMDTypeGenericGPDB();
 			
 			// accessors
-			virtual 
-			const CWStringDynamic *Pstr() const
-			{
-				return m_pstr;
-			}
-			
 			virtual 
 			IMDId *Pmdid() const;
 			
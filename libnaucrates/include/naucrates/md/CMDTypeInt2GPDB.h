@@ -96,9 +96,6 @@ namespace gpmd
 			// count aggregate
 			IMDId *m_pmdidCount;
 
-			// DXL for object
-			const CWStringDynamic *m_pstr;
-			
 			// type name and type
 			static CWStringConst m_str;
 			static CMDName m_mdname;
@@ -122,13 +119,6 @@ namespace gpmd
 			virtual
 			IDatumInt2 *PdatumInt2(IMemoryPool *pmp, SINT sValue, BOOL fNULL) const;
 	
-			// accessors
-			virtual 
-			const CWStringDynamic *Pstr() const
-			{
-				return m_pstr;
-			}
-			
 			// accessor of metadata id
 			virtual 
 			IMDId *Pmdid() const;
@@ -96,9 +96,6 @@ namespace gpmd
 			// count aggregate
 			IMDId *m_pmdidCount;
 
-			// DXL for object
-			const CWStringDynamic *m_pstr;
-			
 			// type name and type
 			static CWStringConst m_str;
 			static CMDName m_mdname;
@@ -123,12 +120,6 @@ namespace gpmd
 			IDatumInt4 *PdatumInt4(IMemoryPool *pmp, INT iValue, BOOL fNULL) const;
 	
 			// accessors
-			virtual 
-			const CWStringDynamic *Pstr() const
-			{
-				return m_pstr;
-			}
-			
 			virtual 
 			IMDId *Pmdid() const;
 			
@@ -98,9 +98,6 @@ namespace gpmd
 		// count aggregate
 		IMDId *m_pmdidCount;
 
-		// DXL for object
-		const CWStringDynamic *m_pstr;
-
 		// type name
 		static CWStringConst m_str;
 		static CMDName m_mdname;
@@ -122,13 +119,6 @@ namespace gpmd
 		virtual
 		IDatumInt8 *PdatumInt8(IMemoryPool *pmp, LINT lValue, BOOL fNULL) const;
 
-		// accessors
-		virtual 
-		const CWStringDynamic *Pstr() const
-		{
-			return m_pstr;
-		}
-
 		// type id
 		virtual 
 		IMDId *Pmdid() const;
@@ -94,8 +94,6 @@ namespace gpmd
 			
 			// count aggregate
 			IMDId *m_pmdidCount;			
-			// DXL for object
-			const CWStringDynamic *m_pstr;
 
 			// type name and type
 			static CWStringConst m_str;
@@ -120,12 +118,6 @@ namespace gpmd
 			IDatumOid *PdatumOid(IMemoryPool *pmp, OID oValue, BOOL fNULL) const;
 
 			// accessors
-			virtual
-			const CWStringDynamic *Pstr() const
-			{
-				return m_pstr;
-			}
-
 			virtual
 			IMDId *Pmdid() const;
 
@@ -97,11 +97,6 @@ namespace gpmd
 			virtual 
 			void Serialize(gpdxl::CXMLSerializer *) const = 0;
 
-			// DXL string representation of cache object 
-			virtual 
-			const CWStringDynamic *Pstr() const = 0;
-			
-						
 			// serialize the metadata id information as the attributes of an 
 			// element with the given name
 			virtual 
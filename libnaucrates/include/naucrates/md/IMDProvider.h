@@ -28,6 +28,12 @@ namespace gpmd
 {
 	using namespace gpos;
 
+	// fwd decl
+	class CMDRequest;
+
+	// array of binary encoded metadata objects
+	typedef CDynamicPtrArray<BYTE, CleanupDeleteRg> DrgPbMDObject;
+
 	//---------------------------------------------------------------------------
 	//	@class:
 	//		IMDProvider
@@ -56,6 +62,29 @@ namespace gpmd
 			virtual 
 			CWStringBase *PstrObject(IMemoryPool *pmp, CMDAccessor *pmda, IMDId *pmdid) const = 0;
 
+			// returns the binary encoding of the requested metadata object (see
+			// CMDBinaryUtils) and its size, or NULL if the provider cannot
+			// encode the object, in which case the DXL string is used instead
+			virtual
+			BYTE *PbObject
+				(
+				IMemoryPool *, // pmp
+				CMDAccessor *, // pmda
+				IMDId *, // pmdid
+				ULONG *pulSize
+				)
+				const
+			{
+				*pulSize = 0;
+				return NULL;
+			}
+
+			// returns the binary encodings of a batch of metadata objects in the
+			// order of the request's mdids, fetching them in a single call; entries
+			// are NULL for objects the provider cannot encode or does not know
+			virtual
+			DrgPbMDObject *PdrgpbObjects(IMemoryPool *pmp, CMDAccessor *pmda, const CMDRequest *pmdr) const;
+
 			// return the mdid for the specified system id and type
 			virtual 
 			IMDId *Pmdid(IMemoryPool *pmp, CSystemId sysid, IMDType::ETypeInfo eti) const = 0;
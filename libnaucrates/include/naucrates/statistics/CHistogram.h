@@ -13,6 +13,7 @@
 
 #include "gpos/base.h"
 #include "naucrates/statistics/CBucket.h"
+#include "naucrates/statistics/CHistogramBounds.h"
 #include "naucrates/statistics/CStatsPred.h"
 
 namespace gpopt
@@ -82,12 +83,22 @@ namespace gpnaucrates
 			// is column statistics missing in the database
 			BOOL m_fColStatsMissing;
 
+			// columnar copy of bucket bounds, built on first use
+			mutable CHistogramBounds *m_phb;
+
 			// private copy ctor
 			CHistogram(const CHistogram &);
 
 			// private assignment operator
 			CHistogram& operator=(const CHistogram &);
 
+			// columnar bucket bounds; builds them on first use
+			const CHistogramBounds *Phb() const;
+
+			// find the first bucket not entirely below the point using the
+			// columnar bounds; returns false if the bounds cannot be used
+			BOOL FLocatePoint(const CPoint *ppoint, ULONG *pulBucketIdx, BOOL *pfContains) const;
+
 			// return an array buckets after applying equality filter on the histogram buckets
 			DrgPbucket *PdrgppbucketEqual(IMemoryPool *pmp, CPoint *ppoint) const;
 
@@ -406,6 +417,7 @@ namespace gpnaucrates
 			~CHistogram()
 			{
 				m_pdrgppbucket->Release();
+				GPOS_DELETE(m_phb);
 			}
 
 			// normalize histogram and return scaling factor
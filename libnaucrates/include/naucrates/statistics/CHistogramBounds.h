@@ -0,0 +1,161 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2018 Pivotal, Inc.
+//
+//	@filename:
+//		CHistogramBounds.h
+//
+//	@doc:
+//		Columnar copy of the bucket bounds of a histogram
+//---------------------------------------------------------------------------
+#ifndef GPNAUCRATES_CHistogramBounds_H
+#define GPNAUCRATES_CHistogramBounds_H
+
+#include "gpos/base.h"
+#include "naucrates/statistics/CBucket.h"
+
+namespace gpnaucrates
+{
+	using namespace gpos;
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CHistogramBounds
+	//
+	//	@doc:
+	//		Bucket bounds of a histogram mapped to their statistics values and
+	//		stored in contiguous arrays, one entry per bucket. Point lookups
+	//		and range skipping over these arrays replace per-bucket datum
+	//		comparisons, each of which dispatches through virtual calls and
+	//		dynamic casts.
+	//
+	//		Bounds are mapped only if comparing them by their mapped values is
+	//		exactly what datum comparison would do: all bounds must be non-null,
+	//		must not use binary comparison, and must all map to LINT or all map
+	//		to doubles only; buckets must be sorted and non-overlapping.
+	//		Otherwise the bounds are unmapped and callers fall back to datum
+	//		comparison.
+	//
+	//---------------------------------------------------------------------------
+	class CHistogramBounds
+	{
+		public:
+
+			// kind of mapped values
+			enum EBoundKind
+			{
+				EbkLint,		// bounds compare by their LINT mapping
+				EbkDouble,		// bounds compare by their double mapping
+				EbkUnmapped,	// bounds must be compared as datums
+
+				EbkSentinel
+			};
+
+			// mapped value of a point
+			struct SKey
+			{
+				// LINT mapping
+				LINT m_l;
+
+				// double mapping
+				DOUBLE m_d;
+			};
+
+		private:
+
+			// kind of mapped values
+			EBoundKind m_ebk;
+
+			// number of buckets
+			ULONG m_ulBuckets;
+
+			// lower bounds mapped to LINT
+			LINT *m_rglLower;
+
+			// upper bounds mapped to LINT
+			LINT *m_rglUpper;
+
+			// lower bounds mapped to doubles
+			DOUBLE *m_rgdLower;
+
+			// upper bounds mapped to doubles
+			DOUBLE *m_rgdUpper;
+
+			// is lower bound closed
+			BOOL *m_rgfLowerClosed;
+
+			// is upper bound closed
+			BOOL *m_rgfUpperClosed;
+
+			// private copy ctor
+			CHistogramBounds(const CHistogramBounds &);
+
+			// kind of mapping that applies to the given datum
+			static
+			EBoundKind EbkDatum(const IDatum *pdatum);
+
+			// map a datum of the given kind
+			static
+			void MapDatum(const IDatum *pdatum, EBoundKind ebk, SKey *pkey);
+
+			// compare the mapped value at the given position to a key
+			static
+			INT ICompare(EBoundKind ebk, const LINT *rgl, const DOUBLE *rgd, ULONG ul, const SKey &key);
+
+			// map the bounds of the given buckets; returns false if bounds
+			// cannot be mapped
+			BOOL FMap(IMemoryPool *pmp, const DrgPbucket *pdrgpbucket);
+
+		public:
+
+			// ctor; maps the bounds of the given buckets if possible
+			CHistogramBounds(IMemoryPool *pmp, const DrgPbucket *pdrgpbucket);
+
+			// dtor
+			~CHistogramBounds();
+
+			// are bounds mapped
+			BOOL FMapped() const
+			{
+				return EbkUnmapped != m_ebk;
+			}
+
+			// kind of mapped values
+			EBoundKind Ebk() const
+			{
+				return m_ebk;
+			}
+
+			// number of buckets
+			ULONG UlBuckets() const
+			{
+				return m_ulBuckets;
+			}
+
+			// map a point for lookups; returns false if the point does not
+			// compare the same way as the bounds
+			BOOL FMapPoint(const CPoint *ppoint, SKey *pkey) const;
+
+			// index of first bucket that is not entirely below the point, or
+			// the number of buckets if there is no such bucket
+			ULONG UlFirstNotBelow(const SKey &key) const;
+
+			// does the given bucket contain the point
+			BOOL FContains(ULONG ulBucket, const SKey &key) const;
+
+			// is the upper bound of the given bucket strictly less than the
+			// lower bound of a bucket of another histogram
+			BOOL FUpperLessThanLower(ULONG ulBucket, const CHistogramBounds *phbOther, ULONG ulBucketOther) const;
+
+			// index of first bucket at or after the given one whose upper bound
+			// is not strictly less than the lower bound of a bucket of another
+			// histogram, or the number of buckets if there is no such bucket
+			ULONG UlFirstUpperNotLessThanLower(ULONG ulStart, const CHistogramBounds *phbOther, ULONG ulBucketOther) const;
+
+	}; // class CHistogramBounds
+
+}
+
+#endif // !GPNAUCRATES_CHistogramBounds_H
+
+// EOF
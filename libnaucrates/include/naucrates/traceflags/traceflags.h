@@ -71,6 +71,9 @@ namespace gpos
 		// print MEMO during property enforcement process
 		EopttracePrintMemoEnforcement = 101015,
 
+		// profile optimization jobs and dump a folded stacks report
+		EopttraceProfileJobs = 101016,
+
 		///////////////////////////////////////////////////////
 		////////////////// transformations flags //////////////
 		///////////////////////////////////////////////////////
@@ -166,6 +169,17 @@ namespace gpos
 		// create constraint intervals from array expressions in preprocessing
 		EopttraceArrayConstraints = 103026,
 
+		// look up and store plans in the plan cache
+		EopttraceEnablePlanCache = 103027,
+
+		// serialize scalar subtrees shared by several plan nodes only once
+		// and refer to them elsewhere in the DXL plan
+		EopttraceSerializeSharedScalars = 103029,
+
+		// intern scalar expressions built by the optimizer, so that equal
+		// predicates share one expression; ignored with multiple workers
+		EopttraceInternScalars = 103030,
+
 		///////////////////////////////////////////////////////
 		///////////////////// statistics flags ////////////////
 		//////////////////////////////////////////////////////
@@ -6,6 +6,7 @@
 #include "gpdbcost/CCostModelParamsGPDB.h"
 
 #include "gpos/common/CAutoRef.h"
+#include "gpos/string/CWStringDynamic.h"
 #include "naucrates/dxl/xml/CXMLSerializer.h"
 
 using namespace gpdxl;
@@ -22,19 +23,57 @@ void CCostModelConfigSerializer::Serialize(CXMLSerializer &xmlser) const
 	xmlser.AddAttribute(CDXLTokens::PstrToken(EdxltokenCostModelType), m_pcm->Ecmt());
 	xmlser.AddAttribute(CDXLTokens::PstrToken(EdxltokenSegmentsForCosting), m_pcm->UlHosts());
 
+	SerializeCostParams(xmlser, m_pcm->Pcp(), false /*fDefaults*/);
+
+	xmlser.CloseElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix), CDXLTokens::PstrToken(EdxltokenCostModelConfig));
+}
+
+void CCostModelConfigSerializer::SerializeCostParams
+	(
+	CXMLSerializer &xmlser,
+	const ICostModelParams *pcp,
+	BOOL fDefaults
+	)
+{
+	IMemoryPool *pmp = xmlser.Pmp();
+	CAutoRef<CCostModelParamsGPDB> a_pcpDefault(GPOS_NEW(pmp) CCostModelParamsGPDB(pmp));
+
 	xmlser.OpenElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix), CDXLTokens::PstrToken(EdxltokenCostParams));
+	xmlser.AddAttribute(CDXLTokens::PstrToken(EdxltokenVersion), CCostModelParamsGPDB::ulCalibrationVersion);
 
-	xmlser.OpenElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix), CDXLTokens::PstrToken(EdxltokenCostParam));
+	for (ULONG ul = 0; ul < CCostModelParamsGPDB::EcpSentinel; ul++)
+	{
+		ICostModelParams::SCostParam *pcparam = pcp->PcpLookup(ul);
+
+		// NLJFactor is always written, as before calibration files existed
+		if (!fDefaults &&
+			CCostModelParamsGPDB::EcpNLJFactor != ul &&
+			pcparam->FEquals(a_pcpDefault->PcpLookup(ul)))
+		{
+			continue;
+		}
 
-	xmlser.AddAttribute(CDXLTokens::PstrToken(EdxltokenName), m_pcm->Pcp()->SzNameLookup(CCostModelParamsGPDB::EcpNLJFactor));
-	xmlser.AddAttribute(CDXLTokens::PstrToken(EdxltokenValue), m_pcm->Pcp()->PcpLookup(CCostModelParamsGPDB::EcpNLJFactor)->DVal());
-	xmlser.AddAttribute(CDXLTokens::PstrToken(EdxltokenCostParamLowerBound), m_pcm->Pcp()->PcpLookup(CCostModelParamsGPDB::EcpNLJFactor)->DLowerBound());
-	xmlser.AddAttribute(CDXLTokens::PstrToken(EdxltokenCostParamUpperBound), m_pcm->Pcp()->PcpLookup(CCostModelParamsGPDB::EcpNLJFactor)->DUpperBound());
-	xmlser.CloseElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix), CDXLTokens::PstrToken(EdxltokenCostParam));
+		xmlser.OpenElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix), CDXLTokens::PstrToken(EdxltokenCostParam));
+		xmlser.AddAttribute(CDXLTokens::PstrToken(EdxltokenName), pcp->SzNameLookup(ul));
+		AddAttribute(xmlser, EdxltokenValue, pcparam->DVal());
+		AddAttribute(xmlser, EdxltokenCostParamLowerBound, pcparam->DLowerBound());
+		AddAttribute(xmlser, EdxltokenCostParamUpperBound, pcparam->DUpperBound());
+		xmlser.CloseElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix), CDXLTokens::PstrToken(EdxltokenCostParam));
+	}
 
 	xmlser.CloseElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix), CDXLTokens::PstrToken(EdxltokenCostParams));
+}
 
-	xmlser.CloseElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix), CDXLTokens::PstrToken(EdxltokenCostModelConfig));
+void CCostModelConfigSerializer::AddAttribute
+	(
+	CXMLSerializer &xmlser,
+	Edxltoken edxltokenAttr,
+	CDouble dValue
+	)
+{
+	CWStringDynamic str(xmlser.Pmp());
+	str.AppendFormat(GPOS_WSZ_LIT("%.17g"), dValue.DVal());
+	xmlser.AddAttribute(CDXLTokens::PstrToken(edxltokenAttr), &str);
 }
 
 CCostModelConfigSerializer::CCostModelConfigSerializer
@@ -27,6 +27,7 @@
 
 #include "naucrates/base/CQueryToDXLResult.h"
 #include "naucrates/dxl/CDXLUtils.h"
+#include "naucrates/dxl/CCostModelConfigSerializer.h"
 #include "naucrates/dxl/parser/CParseHandlerDXL.h"
 #include "naucrates/dxl/parser/CParseHandlerPlan.h"
 
@@ -42,6 +43,7 @@
 #include "naucrates/md/CDXLStatsDerivedRelation.h"
 
 #include "naucrates/traceflags/traceflags.h"
+#include "gpdbcost/CCostModelGPDB.h"
 
 #include <xercesc/sax2/SAX2XMLReader.hpp>
 #include <xercesc/sax2/XMLReaderFactory.hpp>
@@ -582,6 +584,43 @@ CDXLUtils::PoptimizerConfigParseDXL
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLUtils::PcmParseCalibrationFile
+//
+//	@doc:
+//		Parse a calibration file, i.e., a DXL document with the cost params
+//		fitted to a cluster, and create a GPDB cost model using these params.
+//		Params that are not in the file keep their default value.
+//
+//---------------------------------------------------------------------------
+ICostModel *
+CDXLUtils::PcmParseCalibrationFile
+	(
+	IMemoryPool *pmp,
+	const CHAR *szFileName,
+	const CHAR *szXSDPath,
+	ULONG ulSegments
+	)
+{
+	GPOS_ASSERT(NULL != pmp);
+	GPOS_ASSERT(NULL != szFileName);
+
+	CAutoP<CParseHandlerDXL> a_pphdxl(PphdxlParseDXLFile(pmp, szFileName, szXSDPath));
+
+	// collect cost params from dxl parse handler
+	CCostModelParamsGPDB *pcp = dynamic_cast<CCostModelParamsGPDB *>(a_pphdxl->Pcp());
+	if (NULL == pcp)
+	{
+		// the document has no cost params element
+		GPOS_RAISE(gpdxl::ExmaDXL, gpdxl::ExmiDXLIncorrectNumberOfChildren);
+	}
+	pcp->AddRef();
+
+	return GPOS_NEW(pmp) gpdbcost::CCostModelGPDB(pmp, ulSegments, pcp);
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CDXLUtils::PdrgpdxlstatsderrelParseDXL
@@ -981,6 +1020,11 @@ CDXLUtils::SerializePlan
 	xmlser.AddAttribute(CDXLTokens::PstrToken(EdxltokenPlanId), ullPlanId);
 	xmlser.AddAttribute(CDXLTokens::PstrToken(EdxltokenPlanSpaceSize), ullPlanSpaceSize);
 
+	if (GPOS_FTRACE(EopttraceSerializeSharedScalars))
+	{
+		xmlser.ShareSubtrees(pdxln);
+	}
+
 	pdxln->SerializeToDXL(&xmlser);
 
 	xmlser.CloseElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix), CDXLTokens::PstrToken(EdxltokenPlan));
@@ -1181,6 +1225,41 @@ CDXLUtils::PstrSerializeCostDistr
 	return pstr;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLUtils::PstrSerializeCostParams
+//
+//	@doc:
+//		Serialize all cost params, including those with default values, into
+//		a calibration file
+//
+//---------------------------------------------------------------------------
+CWStringDynamic *
+CDXLUtils::PstrSerializeCostParams
+	(
+	IMemoryPool *pmp,
+	const ICostModelParams *pcp,
+	BOOL fIndent
+	)
+{
+	GPOS_ASSERT(NULL != pmp);
+	GPOS_ASSERT(NULL != pcp);
+
+	CWStringDynamic *pstr = GPOS_NEW(pmp) CWStringDynamic(pmp);
+
+	// create a string stream to hold the result of serialization
+	COstreamString oss(pstr);
+
+	CXMLSerializer xmlser(pmp, oss, fIndent);
+	SerializeHeader(pmp, &xmlser);
+
+	CCostModelConfigSerializer::SerializeCostParams(xmlser, pcp, true /*fDefaults*/);
+
+	SerializeFooter(&xmlser);
+
+	return pstr;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CDXLUtils::SerializeMDRequest
@@ -165,6 +165,12 @@ gpdxl::EresExceptionInit
 					 1, // md obj
 					 GPOS_WSZ_WSZLEN("Feature not supported by the Pivotal Query Optimizer:")),
 
+			CMessage(CException(gpdxl::ExmaMD, gpdxl::ExmiMDBinaryFormatError),
+					 CException::ExsevError,
+					 GPOS_WSZ_WSZLEN("Malformed binary metadata object"),
+					 0,
+					 GPOS_WSZ_WSZLEN("Malformed binary metadata object")),
+
 			CMessage(CException(gpdxl::ExmaComm, gpdxl::ExmiCommPropagateError),
 					 CException::ExsevError,
 					 GPOS_WSZ_WSZLEN("%S"),
@@ -57,7 +57,6 @@ CDXLColStats::CDXLColStats
 {
 	GPOS_ASSERT(pmdidColStats->FValid());
 	GPOS_ASSERT(NULL != pdrgpdxlbucket);
-	m_pstr = CDXLUtils::PstrSerializeMDObj(m_pmp, this, false /*fSerializeHeader*/, false /*fIndent*/);
 }
 
 //---------------------------------------------------------------------------
@@ -71,7 +70,6 @@ CDXLColStats::CDXLColStats
 CDXLColStats::~CDXLColStats()
 {
 	GPOS_DELETE(m_pmdname);
-	GPOS_DELETE(m_pstr);
 	m_pmdidColStats->Release();
 	m_pdrgpdxlbucket->Release();
 }
@@ -104,20 +102,6 @@ CDXLColStats::Mdname() const
 	return *m_pmdname;
 }
 
-//---------------------------------------------------------------------------
-//	@function:
-//		CDXLColStats::Pstr
-//
-//	@doc:
-//		Returns the DXL string for this object
-//
-//---------------------------------------------------------------------------
-const CWStringDynamic *
-CDXLColStats::Pstr() const
-{
-	return m_pstr;
-}
-
 //---------------------------------------------------------------------------
 //	@function:
 //		CDXLColStats::UlBuckets
@@ -45,7 +45,6 @@ CDXLRelStats::CDXLRelStats
 	m_fEmpty(fEmpty)
 {
 	GPOS_ASSERT(pmdidRelStats->FValid());
-	m_pstr = CDXLUtils::PstrSerializeMDObj(m_pmp, this, false /*fSerializeHeader*/, false /*fIndent*/);
 }
 
 //---------------------------------------------------------------------------
@@ -59,7 +58,6 @@ CDXLRelStats::CDXLRelStats
 CDXLRelStats::~CDXLRelStats()
 {
 	GPOS_DELETE(m_pmdname);
-	GPOS_DELETE(m_pstr);
 	m_pmdidRelStats->Release();
 }
 
@@ -91,20 +89,6 @@ CDXLRelStats::Mdname() const
 	return *m_pmdname;
 }
 
-//---------------------------------------------------------------------------
-//	@function:
-//		CDXLRelStats::Pstr
-//
-//	@doc:
-//		Returns the DXL string for this object
-//
-//---------------------------------------------------------------------------
-const CWStringDynamic *
-CDXLRelStats::Pstr() const
-{
-	return m_pstr;
-}
-
 //---------------------------------------------------------------------------
 //	@function:
 //		CDXLRelStats::DRows
@@ -50,8 +50,6 @@ CMDAggregateGPDB::CMDAggregateGPDB
 	m_fHashAggCapable(fHashAggCapable)
 	{
 		GPOS_ASSERT(pmdid->FValid());
-		
-		m_pstr = CDXLUtils::PstrSerializeMDObj(m_pmp, this, false /*fSerializeHeader*/, false /*fIndent*/);
 	}
 
 //---------------------------------------------------------------------------
@@ -68,7 +66,6 @@ CMDAggregateGPDB::~CMDAggregateGPDB()
 	m_pmdidTypeIntermediate->Release();
 	m_pmdidTypeResult->Release();
 	GPOS_DELETE(m_pmdname);
-	GPOS_DELETE(m_pstr);
 }
 
 //---------------------------------------------------------------------------
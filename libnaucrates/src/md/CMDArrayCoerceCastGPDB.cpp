@@ -43,13 +43,11 @@ CMDArrayCoerceCastGPDB::CMDArrayCoerceCastGPDB
 	m_edxlcf(edxlcf),
 	m_iLoc(iLoc)
 {
-	m_pstr = CDXLUtils::PstrSerializeMDObj(pmp, this, false /*fSerializeHeader*/, false /*fIndent*/);
 }
 
 // dtor
 CMDArrayCoerceCastGPDB::~CMDArrayCoerceCastGPDB()
 {
-	GPOS_DELETE(m_pstr);
 }
 
 // return type modifier
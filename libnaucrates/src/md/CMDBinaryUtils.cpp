@@ -0,0 +1,1945 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CMDBinaryUtils.cpp
+//
+//	@doc:
+//		Implementation of the binary encoding of metadata cache objects
+//---------------------------------------------------------------------------
+
+#include "gpos/common/CAutoP.h"
+#include "gpos/common/CAutoRef.h"
+#include "gpos/common/CAutoRg.h"
+#include "gpos/string/CWStringConst.h"
+
+#include "naucrates/md/CMDBinaryUtils.h"
+#include "naucrates/md/CMDName.h"
+#include "naucrates/md/CMDIdGPDB.h"
+#include "naucrates/md/CMDIdGPDBCtas.h"
+#include "naucrates/md/CMDIdColStats.h"
+#include "naucrates/md/CMDIdRelStats.h"
+#include "naucrates/md/CMDIdCast.h"
+#include "naucrates/md/CMDIdScCmp.h"
+#include "naucrates/md/CDXLRelStats.h"
+#include "naucrates/md/CDXLColStats.h"
+#include "naucrates/md/CMDScalarOpGPDB.h"
+#include "naucrates/md/CMDCastGPDB.h"
+#include "naucrates/md/CMDArrayCoerceCastGPDB.h"
+#include "naucrates/md/CMDScCmpGPDB.h"
+#include "naucrates/md/CMDTypeInt2GPDB.h"
+#include "naucrates/md/CMDTypeInt4GPDB.h"
+#include "naucrates/md/CMDTypeInt8GPDB.h"
+#include "naucrates/md/CMDTypeBoolGPDB.h"
+#include "naucrates/md/CMDTypeOidGPDB.h"
+#include "naucrates/md/CMDTypeGenericGPDB.h"
+#include "naucrates/md/CMDRelationGPDB.h"
+#include "naucrates/md/CMDColumn.h"
+#include "naucrates/md/CMDIndexInfo.h"
+
+#include "naucrates/dxl/operators/CDXLDatumInt2.h"
+#include "naucrates/dxl/operators/CDXLDatumInt4.h"
+#include "naucrates/dxl/operators/CDXLDatumInt8.h"
+#include "naucrates/dxl/operators/CDXLDatumBool.h"
+#include "naucrates/dxl/operators/CDXLDatumOid.h"
+#include "naucrates/dxl/operators/CDXLDatumGeneric.h"
+#include "naucrates/dxl/operators/CDXLDatumStatsDoubleMappable.h"
+#include "naucrates/dxl/operators/CDXLDatumStatsLintMappable.h"
+
+#include "naucrates/exception.h"
+
+using namespace gpos;
+using namespace gpmd;
+using namespace gpdxl;
+
+// initial size of the encoding buffer
+#define GPMD_BINARY_INITIAL_CAPACITY	ULONG(256)
+
+// doubles are encoded through their 64-bit pattern
+GPOS_CPL_ASSERT(sizeof(DOUBLE) == sizeof(ULLONG));
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::CWriter::CWriter
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+CMDBinaryUtils::CWriter::CWriter
+	(
+	IMemoryPool *pmp
+	)
+	:
+	m_pmp(pmp),
+	m_pb(NULL),
+	m_ulSize(0),
+	m_ulCapacity(0)
+{
+	GPOS_ASSERT(NULL != pmp);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::CWriter::~CWriter
+//
+//	@doc:
+//		Dtor
+//
+//---------------------------------------------------------------------------
+CMDBinaryUtils::CWriter::~CWriter()
+{
+	GPOS_DELETE_ARRAY(m_pb);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::CWriter::Reserve
+//
+//	@doc:
+//		Make room for the given number of bytes, doubling the buffer as needed
+//
+//---------------------------------------------------------------------------
+void
+CMDBinaryUtils::CWriter::Reserve
+	(
+	ULONG ulBytes
+	)
+{
+	if (m_ulSize + ulBytes <= m_ulCapacity)
+	{
+		return;
+	}
+
+	ULONG ulCapacity = m_ulCapacity;
+	if (0 == ulCapacity)
+	{
+		ulCapacity = GPMD_BINARY_INITIAL_CAPACITY;
+	}
+
+	while (ulCapacity < m_ulSize + ulBytes)
+	{
+		ulCapacity = ulCapacity * 2;
+	}
+
+	BYTE *pb = GPOS_NEW_ARRAY(m_pmp, BYTE, ulCapacity);
+	if (0 < m_ulSize)
+	{
+		(void) clib::PvMemCpy(pb, m_pb, m_ulSize);
+	}
+	GPOS_DELETE_ARRAY(m_pb);
+
+	m_pb = pb;
+	m_ulCapacity = ulCapacity;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::CWriter::WriteBytes
+//
+//	@doc:
+//		Append raw bytes
+//
+//---------------------------------------------------------------------------
+void
+CMDBinaryUtils::CWriter::WriteBytes
+	(
+	const BYTE *pb,
+	ULONG ulBytes
+	)
+{
+	if (0 == ulBytes)
+	{
+		return;
+	}
+
+	Reserve(ulBytes);
+	(void) clib::PvMemCpy(m_pb + m_ulSize, pb, ulBytes);
+	m_ulSize += ulBytes;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::CWriter::Patch
+//
+//	@doc:
+//		Overwrite a previously written integer
+//
+//---------------------------------------------------------------------------
+void
+CMDBinaryUtils::CWriter::Patch
+	(
+	ULONG ulOffset,
+	ULONG ul
+	)
+{
+	GPOS_ASSERT(ulOffset + sizeof(ULONG) <= m_ulSize);
+
+	for (ULONG ulByte = 0; ulByte < sizeof(ULONG); ulByte++)
+	{
+		m_pb[ulOffset + ulByte] = (BYTE) (ul >> (8 * ulByte));
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::CWriter::WriteByte
+//
+//	@doc:
+//		Append a single byte
+//
+//---------------------------------------------------------------------------
+void
+CMDBinaryUtils::CWriter::WriteByte
+	(
+	BYTE b
+	)
+{
+	WriteBytes(&b, 1);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::CWriter::WriteBool
+//
+//	@doc:
+//		Append a boolean as a single byte
+//
+//---------------------------------------------------------------------------
+void
+CMDBinaryUtils::CWriter::WriteBool
+	(
+	BOOL f
+	)
+{
+	WriteByte(f ? 1 : 0);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::CWriter::WriteUlong
+//
+//	@doc:
+//		Append a 32-bit unsigned integer
+//
+//---------------------------------------------------------------------------
+void
+CMDBinaryUtils::CWriter::WriteUlong
+	(
+	ULONG ul
+	)
+{
+	BYTE rgb[sizeof(ULONG)];
+	for (ULONG ulByte = 0; ulByte < sizeof(ULONG); ulByte++)
+	{
+		rgb[ulByte] = (BYTE) (ul >> (8 * ulByte));
+	}
+	WriteBytes(rgb, GPOS_ARRAY_SIZE(rgb));
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::CWriter::WriteInt
+//
+//	@doc:
+//		Append a 32-bit signed integer
+//
+//---------------------------------------------------------------------------
+void
+CMDBinaryUtils::CWriter::WriteInt
+	(
+	INT i
+	)
+{
+	WriteUlong((ULONG) i);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::CWriter::WriteUllong
+//
+//	@doc:
+//		Append a 64-bit unsigned integer
+//
+//---------------------------------------------------------------------------
+void
+CMDBinaryUtils::CWriter::WriteUllong
+	(
+	ULLONG ull
+	)
+{
+	BYTE rgb[sizeof(ULLONG)];
+	for (ULONG ulByte = 0; ulByte < sizeof(ULLONG); ulByte++)
+	{
+		rgb[ulByte] = (BYTE) (ull >> (8 * ulByte));
+	}
+	WriteBytes(rgb, GPOS_ARRAY_SIZE(rgb));
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::CWriter::WriteLint
+//
+//	@doc:
+//		Append a 64-bit signed integer
+//
+//---------------------------------------------------------------------------
+void
+CMDBinaryUtils::CWriter::WriteLint
+	(
+	LINT l
+	)
+{
+	WriteUllong((ULLONG) l);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::CWriter::WriteDouble
+//
+//	@doc:
+//		Append a double using its bit pattern
+//
+//---------------------------------------------------------------------------
+void
+CMDBinaryUtils::CWriter::WriteDouble
+	(
+	CDouble d
+	)
+{
+	DOUBLE dVal = d.DVal();
+	ULLONG ull = 0;
+	(void) clib::PvMemCpy(&ull, &dVal, sizeof(ull));
+	WriteUllong(ull);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::CWriter::WriteMDName
+//
+//	@doc:
+//		Append a metadata name as its length followed by its characters
+//
+//---------------------------------------------------------------------------
+void
+CMDBinaryUtils::CWriter::WriteMDName
+	(
+	const CMDName &mdname
+	)
+{
+	const CWStringConst *pstr = mdname.Pstr();
+	const ULONG ulLength = pstr->UlLength();
+	const WCHAR *wsz = pstr->Wsz();
+
+	WriteUlong(ulLength);
+	for (ULONG ul = 0; ul < ulLength; ul++)
+	{
+		WriteUlong((ULONG) wsz[ul]);
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::CWriter::WriteMDId
+//
+//	@doc:
+//		Append a metadata id as a tag followed by the id components; a tag
+//		of zero denotes a missing id
+//
+//---------------------------------------------------------------------------
+void
+CMDBinaryUtils::CWriter::WriteMDId
+	(
+	const IMDId *pmdid
+	)
+{
+	if (NULL == pmdid)
+	{
+		WriteByte(0);
+		return;
+	}
+
+	IMDId::EMDIdType emdidt = pmdid->Emdidt();
+	WriteByte((BYTE) (emdidt + 1));
+
+	switch (emdidt)
+	{
+		case IMDId::EmdidGPDB:
+		{
+			const CMDIdGPDB *pmdidGPDB = CMDIdGPDB::PmdidConvert(pmdid);
+			WriteUlong(pmdidGPDB->OidObjectId());
+			WriteUlong(pmdidGPDB->UlVersionMajor());
+			WriteUlong(pmdidGPDB->UlVersionMinor());
+			break;
+		}
+		case IMDId::EmdidGPDBCtas:
+			WriteUlong(CMDIdGPDBCtas::PmdidConvert(pmdid)->OidObjectId());
+			break;
+
+		case IMDId::EmdidColStats:
+		{
+			const CMDIdColStats *pmdidColStats = CMDIdColStats::PmdidConvert(pmdid);
+			WriteMDId(pmdidColStats->PmdidRel());
+			WriteUlong(pmdidColStats->UlPos());
+			break;
+		}
+		case IMDId::EmdidRelStats:
+			WriteMDId(CMDIdRelStats::PmdidConvert(pmdid)->PmdidRel());
+			break;
+
+		case IMDId::EmdidCastFunc:
+		{
+			const CMDIdCast *pmdidCast = CMDIdCast::PmdidConvert(pmdid);
+			WriteMDId(pmdidCast->PmdidSrc());
+			WriteMDId(pmdidCast->PmdidDest());
+			break;
+		}
+		case IMDId::EmdidScCmp:
+		{
+			const CMDIdScCmp *pmdidScCmp = CMDIdScCmp::PmdidConvert(pmdid);
+			WriteMDId(pmdidScCmp->PmdidLeft());
+			WriteMDId(pmdidScCmp->PmdidRight());
+			WriteUlong(pmdidScCmp->Ecmpt());
+			break;
+		}
+		default:
+			GPOS_ASSERT(!"Unexpected metadata id type");
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::CWriter::WriteDatum
+//
+//	@doc:
+//		Append a DXL datum
+//
+//---------------------------------------------------------------------------
+void
+CMDBinaryUtils::CWriter::WriteDatum
+	(
+	const CDXLDatum *pdxldatum
+	)
+{
+	GPOS_ASSERT(NULL != pdxldatum);
+
+	CDXLDatum::EdxldatumType edxldt = pdxldatum->Edxldt();
+	WriteByte((BYTE) edxldt);
+	WriteMDId(pdxldatum->Pmdid());
+	WriteBool(pdxldatum->FNull());
+
+	switch (edxldt)
+	{
+		case CDXLDatum::EdxldatumInt2:
+			WriteInt(dynamic_cast<const CDXLDatumInt2 *>(pdxldatum)->SValue());
+			break;
+
+		case CDXLDatum::EdxldatumInt4:
+			WriteInt(dynamic_cast<const CDXLDatumInt4 *>(pdxldatum)->IValue());
+			break;
+
+		case CDXLDatum::EdxldatumInt8:
+			WriteLint(dynamic_cast<const CDXLDatumInt8 *>(pdxldatum)->LValue());
+			break;
+
+		case CDXLDatum::EdxldatumBool:
+			WriteBool(dynamic_cast<const CDXLDatumBool *>(pdxldatum)->FValue());
+			break;
+
+		case CDXLDatum::EdxldatumOid:
+			WriteUlong(dynamic_cast<const CDXLDatumOid *>(pdxldatum)->OidValue());
+			break;
+
+		case CDXLDatum::EdxldatumGeneric:
+		case CDXLDatum::EdxldatumStatsDoubleMappable:
+		case CDXLDatum::EdxldatumStatsLintMappable:
+		{
+			const CDXLDatumGeneric *pdxldatumGeneric = dynamic_cast<const CDXLDatumGeneric *>(pdxldatum);
+			const BYTE *pba = pdxldatumGeneric->Pba();
+			const ULONG ulLength = (NULL == pba) ? 0 : pdxldatumGeneric->UlLength();
+
+			WriteInt(pdxldatumGeneric->ITypeModifier());
+			WriteBool(pdxldatumGeneric->FByValue());
+			WriteBool(NULL != pba);
+			WriteUlong(ulLength);
+			WriteBytes(pba, ulLength);
+
+			if (CDXLDatum::EdxldatumStatsDoubleMappable == edxldt)
+			{
+				WriteDouble(pdxldatumGeneric->DStatsMapping());
+			}
+			else if (CDXLDatum::EdxldatumStatsLintMappable == edxldt)
+			{
+				WriteLint(pdxldatumGeneric->LStatsMapping());
+			}
+			break;
+		}
+		default:
+			GPOS_ASSERT(!"Unexpected datum type");
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::CWriter::PbDetach
+//
+//	@doc:
+//		Hand over the buffer to the caller
+//
+//---------------------------------------------------------------------------
+BYTE *
+CMDBinaryUtils::CWriter::PbDetach
+	(
+	ULONG *pulSize
+	)
+{
+	GPOS_ASSERT(NULL != pulSize);
+
+	BYTE *pb = m_pb;
+	*pulSize = m_ulSize;
+
+	m_pb = NULL;
+	m_ulSize = 0;
+	m_ulCapacity = 0;
+
+	return pb;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::CReader::CReader
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+CMDBinaryUtils::CReader::CReader
+	(
+	IMemoryPool *pmp,
+	const BYTE *pb,
+	ULONG ulSize
+	)
+	:
+	m_pmp(pmp),
+	m_pb(pb),
+	m_ulSize(ulSize),
+	m_ulOffset(0)
+{
+	GPOS_ASSERT(NULL != pmp);
+	GPOS_ASSERT(NULL != pb);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::CReader::PbRead
+//
+//	@doc:
+//		Consume the given number of bytes; raises if the buffer is exhausted
+//
+//---------------------------------------------------------------------------
+const BYTE *
+CMDBinaryUtils::CReader::PbRead
+	(
+	ULONG ulBytes
+	)
+{
+	if (ulBytes > m_ulSize - m_ulOffset)
+	{
+		RaiseMalformed();
+	}
+
+	const BYTE *pb = m_pb + m_ulOffset;
+	m_ulOffset += ulBytes;
+
+	return pb;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::CReader::BRead
+//
+//	@doc:
+//		Read a single byte
+//
+//---------------------------------------------------------------------------
+BYTE
+CMDBinaryUtils::CReader::BRead()
+{
+	return *PbRead(1);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::CReader::FRead
+//
+//	@doc:
+//		Read a boolean
+//
+//---------------------------------------------------------------------------
+BOOL
+CMDBinaryUtils::CReader::FRead()
+{
+	BYTE b = BRead();
+	if (1 < b)
+	{
+		RaiseMalformed();
+	}
+
+	return 1 == b;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::CReader::UlRead
+//
+//	@doc:
+//		Read a 32-bit unsigned integer
+//
+//---------------------------------------------------------------------------
+ULONG
+CMDBinaryUtils::CReader::UlRead()
+{
+	const BYTE *pb = PbRead(sizeof(ULONG));
+
+	ULONG ul = 0;
+	for (ULONG ulByte = 0; ulByte < sizeof(ULONG); ulByte++)
+	{
+		ul |= ((ULONG) pb[ulByte]) << (8 * ulByte);
+	}
+
+	return ul;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::CReader::IRead
+//
+//	@doc:
+//		Read a 32-bit signed integer
+//
+//---------------------------------------------------------------------------
+INT
+CMDBinaryUtils::CReader::IRead()
+{
+	return (INT) UlRead();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::CReader::UllRead
+//
+//	@doc:
+//		Read a 64-bit unsigned integer
+//
+//---------------------------------------------------------------------------
+ULLONG
+CMDBinaryUtils::CReader::UllRead()
+{
+	const BYTE *pb = PbRead(sizeof(ULLONG));
+
+	ULLONG ull = 0;
+	for (ULONG ulByte = 0; ulByte < sizeof(ULLONG); ulByte++)
+	{
+		ull |= ((ULLONG) pb[ulByte]) << (8 * ulByte);
+	}
+
+	return ull;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::CReader::LRead
+//
+//	@doc:
+//		Read a 64-bit signed integer
+//
+//---------------------------------------------------------------------------
+LINT
+CMDBinaryUtils::CReader::LRead()
+{
+	return (LINT) UllRead();
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::CReader::DRead
+//
+//	@doc:
+//		Read a double
+//
+//---------------------------------------------------------------------------
+CDouble
+CMDBinaryUtils::CReader::DRead()
+{
+	ULLONG ull = UllRead();
+	DOUBLE d = 0.0;
+	(void) clib::PvMemCpy(&d, &ull, sizeof(d));
+
+	return CDouble(d);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::CReader::PmdnameRead
+//
+//	@doc:
+//		Read a metadata name
+//
+//---------------------------------------------------------------------------
+CMDName *
+CMDBinaryUtils::CReader::PmdnameRead()
+{
+	const ULONG ulLength = UlRead();
+
+	// every character takes four bytes on the wire
+	if (ulLength > (m_ulSize - m_ulOffset) / sizeof(ULONG))
+	{
+		RaiseMalformed();
+	}
+
+	CAutoRg<WCHAR> a_wsz;
+	a_wsz = GPOS_NEW_ARRAY(m_pmp, WCHAR, ulLength + 1);
+	for (ULONG ul = 0; ul < ulLength; ul++)
+	{
+		a_wsz[ul] = (WCHAR) UlRead();
+	}
+	a_wsz[ulLength] = WCHAR_EOS;
+
+	CWStringConst str(a_wsz.Rgt());
+
+	return GPOS_NEW(m_pmp) CMDName(m_pmp, &str);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::CReader::PmdidRead
+//
+//	@doc:
+//		Read a metadata id; returns NULL for a missing id
+//
+//---------------------------------------------------------------------------
+IMDId *
+CMDBinaryUtils::CReader::PmdidRead()
+{
+	BYTE bTag = BRead();
+	if (0 == bTag)
+	{
+		return NULL;
+	}
+
+	switch (bTag - 1)
+	{
+		case IMDId::EmdidGPDB:
+		{
+			OID oid = UlRead();
+			ULONG ulVersionMajor = UlRead();
+			ULONG ulVersionMinor = UlRead();
+			return GPOS_NEW(m_pmp) CMDIdGPDB(oid, ulVersionMajor, ulVersionMinor);
+		}
+		case IMDId::EmdidGPDBCtas:
+			return GPOS_NEW(m_pmp) CMDIdGPDBCtas(UlRead());
+
+		case IMDId::EmdidColStats:
+		{
+			CAutoRef<CMDIdGPDB> a_pmdidRel(PmdidGPDBRead());
+			ULONG ulPos = UlRead();
+			return GPOS_NEW(m_pmp) CMDIdColStats(a_pmdidRel.PtReset(), ulPos);
+		}
+		case IMDId::EmdidRelStats:
+			return GPOS_NEW(m_pmp) CMDIdRelStats(PmdidGPDBRead());
+
+		case IMDId::EmdidCastFunc:
+		{
+			CAutoRef<CMDIdGPDB> a_pmdidSrc(PmdidGPDBRead());
+			CAutoRef<CMDIdGPDB> a_pmdidDest(PmdidGPDBRead());
+			return GPOS_NEW(m_pmp) CMDIdCast(a_pmdidSrc.PtReset(), a_pmdidDest.PtReset());
+		}
+		case IMDId::EmdidScCmp:
+		{
+			CAutoRef<CMDIdGPDB> a_pmdidLeft(PmdidGPDBRead());
+			CAutoRef<CMDIdGPDB> a_pmdidRight(PmdidGPDBRead());
+			ULONG ulCmpt = UlRead();
+			if (IMDType::EcmptOther < ulCmpt)
+			{
+				RaiseMalformed();
+			}
+			return GPOS_NEW(m_pmp) CMDIdScCmp(a_pmdidLeft.PtReset(), a_pmdidRight.PtReset(), (IMDType::ECmpType) ulCmpt);
+		}
+		default:
+			RaiseMalformed();
+			return NULL;
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::CReader::PmdidGPDBRead
+//
+//	@doc:
+//		Read a GPDB metadata id; raises if the id has a different type
+//
+//---------------------------------------------------------------------------
+CMDIdGPDB *
+CMDBinaryUtils::CReader::PmdidGPDBRead()
+{
+	IMDId *pmdid = PmdidRead();
+	if (NULL == pmdid || IMDId::EmdidGPDB != pmdid->Emdidt())
+	{
+		CRefCount::SafeRelease(pmdid);
+		RaiseMalformed();
+	}
+
+	return CMDIdGPDB::PmdidConvert(pmdid);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::CReader::PdxldatumRead
+//
+//	@doc:
+//		Read a DXL datum
+//
+//---------------------------------------------------------------------------
+CDXLDatum *
+CMDBinaryUtils::CReader::PdxldatumRead()
+{
+	BYTE bType = BRead();
+	CAutoRef<IMDId> a_pmdidType(PmdidRead());
+	if (NULL == a_pmdidType.Pt())
+	{
+		RaiseMalformed();
+	}
+	BOOL fNull = FRead();
+
+	switch (bType)
+	{
+		case CDXLDatum::EdxldatumInt2:
+		{
+			SINT sValue = (SINT) IRead();
+			return GPOS_NEW(m_pmp) CDXLDatumInt2(m_pmp, a_pmdidType.PtReset(), fNull, sValue);
+		}
+		case CDXLDatum::EdxldatumInt4:
+		{
+			INT iValue = IRead();
+			return GPOS_NEW(m_pmp) CDXLDatumInt4(m_pmp, a_pmdidType.PtReset(), fNull, iValue);
+		}
+		case CDXLDatum::EdxldatumInt8:
+		{
+			LINT lValue = LRead();
+			return GPOS_NEW(m_pmp) CDXLDatumInt8(m_pmp, a_pmdidType.PtReset(), fNull, lValue);
+		}
+		case CDXLDatum::EdxldatumBool:
+		{
+			BOOL fValue = FRead();
+			return GPOS_NEW(m_pmp) CDXLDatumBool(m_pmp, a_pmdidType.PtReset(), fNull, fValue);
+		}
+		case CDXLDatum::EdxldatumOid:
+		{
+			OID oidValue = UlRead();
+			return GPOS_NEW(m_pmp) CDXLDatumOid(m_pmp, a_pmdidType.PtReset(), fNull, oidValue);
+		}
+		case CDXLDatum::EdxldatumGeneric:
+		case CDXLDatum::EdxldatumStatsDoubleMappable:
+		case CDXLDatum::EdxldatumStatsLintMappable:
+		{
+			INT iTypeModifier = IRead();
+			BOOL fByVal = FRead();
+			BOOL fHasValue = FRead();
+			ULONG ulLength = UlRead();
+
+			CAutoRg<BYTE> a_pba;
+			if (fHasValue)
+			{
+				const BYTE *pbValue = PbRead(ulLength);
+				a_pba = GPOS_NEW_ARRAY(m_pmp, BYTE, ulLength);
+				(void) clib::PvMemCpy(a_pba.Rgt(), pbValue, ulLength);
+			}
+
+			if (CDXLDatum::EdxldatumStatsDoubleMappable == bType)
+			{
+				CDouble dValue = DRead();
+				return GPOS_NEW(m_pmp) CDXLDatumStatsDoubleMappable(m_pmp, a_pmdidType.PtReset(), iTypeModifier, fByVal, fNull, a_pba.RgtReset(), ulLength, dValue);
+			}
+
+			if (CDXLDatum::EdxldatumStatsLintMappable == bType)
+			{
+				LINT lValue = LRead();
+				return GPOS_NEW(m_pmp) CDXLDatumStatsLintMappable(m_pmp, a_pmdidType.PtReset(), iTypeModifier, fByVal, fNull, a_pba.RgtReset(), ulLength, lValue);
+			}
+
+			return GPOS_NEW(m_pmp) CDXLDatumGeneric(m_pmp, a_pmdidType.PtReset(), iTypeModifier, fByVal, fNull, a_pba.RgtReset(), ulLength);
+		}
+		default:
+			RaiseMalformed();
+			return NULL;
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::RaiseMalformed
+//
+//	@doc:
+//		Raise an error for a truncated or otherwise malformed encoding
+//
+//---------------------------------------------------------------------------
+void
+CMDBinaryUtils::RaiseMalformed()
+{
+	GPOS_RAISE(gpdxl::ExmaMD, gpdxl::ExmiMDBinaryFormatError);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::FSerializableRelation
+//
+//	@doc:
+//		A relation can be encoded unless it carries DXL expressions, i.e.
+//		column default values or a partition constraint
+//
+//---------------------------------------------------------------------------
+BOOL
+CMDBinaryUtils::FSerializableRelation
+	(
+	const CMDRelationGPDB *pmdrel
+	)
+{
+	if (NULL != pmdrel->Pmdpartcnstr())
+	{
+		return false;
+	}
+
+	const ULONG ulColumns = pmdrel->UlColumns();
+	for (ULONG ul = 0; ul < ulColumns; ul++)
+	{
+		const CMDColumn *pmdcol = dynamic_cast<const CMDColumn *>(pmdrel->Pmdcol(ul));
+		if (NULL == pmdcol || NULL != pmdcol->PdxlnDefaultValue())
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::FSerializable
+//
+//	@doc:
+//		Does the binary encoding support the given object
+//
+//---------------------------------------------------------------------------
+BOOL
+CMDBinaryUtils::FSerializable
+	(
+	const IMDCacheObject *pimdobj
+	)
+{
+	GPOS_ASSERT(NULL != pimdobj);
+
+	switch (pimdobj->Emdt())
+	{
+		case IMDCacheObject::EmdtRelStats:
+			return NULL != dynamic_cast<const CDXLRelStats *>(pimdobj);
+
+		case IMDCacheObject::EmdtColStats:
+			return NULL != dynamic_cast<const CDXLColStats *>(pimdobj);
+
+		case IMDCacheObject::EmdtOp:
+			return NULL != dynamic_cast<const CMDScalarOpGPDB *>(pimdobj);
+
+		case IMDCacheObject::EmdtCastFunc:
+			return NULL != dynamic_cast<const CMDCastGPDB *>(pimdobj);
+
+		case IMDCacheObject::EmdtScCmp:
+			return NULL != dynamic_cast<const CMDScCmpGPDB *>(pimdobj);
+
+		case IMDCacheObject::EmdtType:
+		{
+			const IMDType *pmdtype = dynamic_cast<const IMDType *>(pimdobj);
+			return NULL != pmdtype &&
+					(IMDType::EtiGeneric != pmdtype->Eti() || NULL != dynamic_cast<const CMDTypeGenericGPDB *>(pmdtype));
+		}
+		case IMDCacheObject::EmdtRel:
+		{
+			const CMDRelationGPDB *pmdrel = dynamic_cast<const CMDRelationGPDB *>(pimdobj);
+			return NULL != pmdrel && FSerializableRelation(pmdrel);
+		}
+		default:
+			return false;
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::PbSerialize
+//
+//	@doc:
+//		Encode the given object into a buffer allocated in the given memory
+//		pool; returns NULL if the object is not supported by the encoding
+//
+//---------------------------------------------------------------------------
+BYTE *
+CMDBinaryUtils::PbSerialize
+	(
+	IMemoryPool *pmp,
+	const IMDCacheObject *pimdobj,
+	ULONG *pulSize
+	)
+{
+	GPOS_ASSERT(NULL != pulSize);
+
+	*pulSize = 0;
+	if (!FSerializable(pimdobj))
+	{
+		return NULL;
+	}
+
+	CWriter writer(pmp);
+	writer.WriteUlong(ulMagic);
+	writer.WriteUlong(ulVersion);
+	writer.WriteUlong(pimdobj->Emdt());
+
+	// total size is patched in once the payload is written
+	const ULONG ulSizeOffset = writer.UlSize();
+	writer.WriteUlong(0);
+
+	switch (pimdobj->Emdt())
+	{
+		case IMDCacheObject::EmdtRelStats:
+			SerializeRelStats(&writer, dynamic_cast<const CDXLRelStats *>(pimdobj));
+			break;
+
+		case IMDCacheObject::EmdtColStats:
+			SerializeColStats(&writer, dynamic_cast<const CDXLColStats *>(pimdobj));
+			break;
+
+		case IMDCacheObject::EmdtOp:
+			SerializeScalarOp(&writer, dynamic_cast<const CMDScalarOpGPDB *>(pimdobj));
+			break;
+
+		case IMDCacheObject::EmdtCastFunc:
+			SerializeCast(&writer, dynamic_cast<const CMDCastGPDB *>(pimdobj));
+			break;
+
+		case IMDCacheObject::EmdtScCmp:
+			SerializeScCmp(&writer, dynamic_cast<const CMDScCmpGPDB *>(pimdobj));
+			break;
+
+		case IMDCacheObject::EmdtType:
+			SerializeType(&writer, dynamic_cast<const IMDType *>(pimdobj));
+			break;
+
+		case IMDCacheObject::EmdtRel:
+			SerializeRelation(&writer, dynamic_cast<const CMDRelationGPDB *>(pimdobj));
+			break;
+
+		default:
+			GPOS_ASSERT(!"Unexpected metadata object type");
+	}
+
+	writer.Patch(ulSizeOffset, writer.UlSize());
+
+	return writer.PbDetach(pulSize);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::SerializeRelStats
+//
+//	@doc:
+//		Encode relation statistics
+//
+//---------------------------------------------------------------------------
+void
+CMDBinaryUtils::SerializeRelStats
+	(
+	CWriter *pwriter,
+	const CDXLRelStats *pdxlrelstats
+	)
+{
+	pwriter->WriteMDId(pdxlrelstats->Pmdid());
+	pwriter->WriteMDName(pdxlrelstats->Mdname());
+	pwriter->WriteDouble(pdxlrelstats->DRows());
+	pwriter->WriteBool(pdxlrelstats->FEmpty());
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::SerializeColStats
+//
+//	@doc:
+//		Encode column statistics together with their histogram buckets
+//
+//---------------------------------------------------------------------------
+void
+CMDBinaryUtils::SerializeColStats
+	(
+	CWriter *pwriter,
+	const CDXLColStats *pdxlcolstats
+	)
+{
+	pwriter->WriteMDId(pdxlcolstats->Pmdid());
+	pwriter->WriteMDName(pdxlcolstats->Mdname());
+	pwriter->WriteDouble(pdxlcolstats->DWidth());
+	pwriter->WriteDouble(pdxlcolstats->DNullFreq());
+	pwriter->WriteDouble(pdxlcolstats->DDistinctRemain());
+	pwriter->WriteDouble(pdxlcolstats->DFreqRemain());
+	pwriter->WriteBool(pdxlcolstats->FColStatsMissing());
+
+	const ULONG ulBuckets = pdxlcolstats->UlBuckets();
+	pwriter->WriteUlong(ulBuckets);
+	for (ULONG ul = 0; ul < ulBuckets; ul++)
+	{
+		const CDXLBucket *pdxlbucket = pdxlcolstats->Pdxlbucket(ul);
+		pwriter->WriteDatum(pdxlbucket->PdxldatumLower());
+		pwriter->WriteDatum(pdxlbucket->PdxldatumUpper());
+		pwriter->WriteBool(pdxlbucket->FLowerClosed());
+		pwriter->WriteBool(pdxlbucket->FUpperClosed());
+		pwriter->WriteDouble(pdxlbucket->DFrequency());
+		pwriter->WriteDouble(pdxlbucket->DDistinct());
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::SerializeScalarOp
+//
+//	@doc:
+//		Encode a scalar operator
+//
+//---------------------------------------------------------------------------
+void
+CMDBinaryUtils::SerializeScalarOp
+	(
+	CWriter *pwriter,
+	const CMDScalarOpGPDB *pmdscop
+	)
+{
+	pwriter->WriteMDId(pmdscop->Pmdid());
+	pwriter->WriteMDName(pmdscop->Mdname());
+	pwriter->WriteMDId(pmdscop->PmdidTypeLeft());
+	pwriter->WriteMDId(pmdscop->PmdidTypeRight());
+	pwriter->WriteMDId(pmdscop->PmdidTypeResult());
+	pwriter->WriteMDId(pmdscop->PmdidFunc());
+	pwriter->WriteMDId(pmdscop->PmdidOpCommute());
+	pwriter->WriteMDId(pmdscop->PmdidOpInverse());
+	pwriter->WriteUlong(pmdscop->Ecmpt());
+	pwriter->WriteBool(pmdscop->FReturnsNullOnNullInput());
+
+	const ULONG ulOpClasses = pmdscop->UlOpCLasses();
+	pwriter->WriteUlong(ulOpClasses);
+	for (ULONG ul = 0; ul < ulOpClasses; ul++)
+	{
+		pwriter->WriteMDId(pmdscop->PmdidOpClass(ul));
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::SerializeCast
+//
+//	@doc:
+//		Encode a cast function, including array coerce casts
+//
+//---------------------------------------------------------------------------
+void
+CMDBinaryUtils::SerializeCast
+	(
+	CWriter *pwriter,
+	const CMDCastGPDB *pmdcast
+	)
+{
+	const CMDArrayCoerceCastGPDB *pmdcastArray = dynamic_cast<const CMDArrayCoerceCastGPDB *>(pmdcast);
+
+	pwriter->WriteBool(NULL != pmdcastArray);
+	pwriter->WriteMDId(pmdcast->Pmdid());
+	pwriter->WriteMDName(pmdcast->Mdname());
+	pwriter->WriteMDId(pmdcast->PmdidSrc());
+	pwriter->WriteMDId(pmdcast->PmdidDest());
+	pwriter->WriteBool(pmdcast->FBinaryCoercible());
+	pwriter->WriteMDId(pmdcast->PmdidCastFunc());
+	pwriter->WriteUlong(pmdcast->EmdPathType());
+
+	if (NULL != pmdcastArray)
+	{
+		pwriter->WriteInt(pmdcastArray->ITypeModifier());
+		pwriter->WriteBool(pmdcastArray->FIsExplicit());
+		pwriter->WriteUlong(pmdcastArray->Ecf());
+		pwriter->WriteInt(pmdcastArray->ILoc());
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::SerializeScCmp
+//
+//	@doc:
+//		Encode a scalar comparison
+//
+//---------------------------------------------------------------------------
+void
+CMDBinaryUtils::SerializeScCmp
+	(
+	CWriter *pwriter,
+	const CMDScCmpGPDB *pmdsccmp
+	)
+{
+	pwriter->WriteMDId(pmdsccmp->Pmdid());
+	pwriter->WriteMDName(pmdsccmp->Mdname());
+	pwriter->WriteMDId(pmdsccmp->PmdidLeft());
+	pwriter->WriteMDId(pmdsccmp->PmdidRight());
+	pwriter->WriteUlong(pmdsccmp->Ecmpt());
+	pwriter->WriteMDId(pmdsccmp->PmdidOp());
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::SerializeType
+//
+//	@doc:
+//		Encode a type; built-in types are fully described by their type info
+//
+//---------------------------------------------------------------------------
+void
+CMDBinaryUtils::SerializeType
+	(
+	CWriter *pwriter,
+	const IMDType *pmdtype
+	)
+{
+	pwriter->WriteUlong(pmdtype->Eti());
+	if (IMDType::EtiGeneric != pmdtype->Eti())
+	{
+		return;
+	}
+
+	const CMDTypeGenericGPDB *pmdtypeGeneric = dynamic_cast<const CMDTypeGenericGPDB *>(pmdtype);
+
+	pwriter->WriteMDId(pmdtypeGeneric->Pmdid());
+	pwriter->WriteMDName(pmdtypeGeneric->Mdname());
+	pwriter->WriteBool(pmdtypeGeneric->FRedistributable());
+	pwriter->WriteBool(pmdtypeGeneric->FFixedLength());
+	pwriter->WriteUlong(pmdtypeGeneric->UlLength());
+	pwriter->WriteBool(pmdtypeGeneric->FByValue());
+	pwriter->WriteMDId(pmdtypeGeneric->PmdidCmp(IMDType::EcmptEq));
+	pwriter->WriteMDId(pmdtypeGeneric->PmdidCmp(IMDType::EcmptNEq));
+	pwriter->WriteMDId(pmdtypeGeneric->PmdidCmp(IMDType::EcmptL));
+	pwriter->WriteMDId(pmdtypeGeneric->PmdidCmp(IMDType::EcmptLEq));
+	pwriter->WriteMDId(pmdtypeGeneric->PmdidCmp(IMDType::EcmptG));
+	pwriter->WriteMDId(pmdtypeGeneric->PmdidCmp(IMDType::EcmptGEq));
+	pwriter->WriteMDId(pmdtypeGeneric->PmdidOpComp());
+	pwriter->WriteMDId(pmdtypeGeneric->PmdidAgg(IMDType::EaggMin));
+	pwriter->WriteMDId(pmdtypeGeneric->PmdidAgg(IMDType::EaggMax));
+	pwriter->WriteMDId(pmdtypeGeneric->PmdidAgg(IMDType::EaggAvg));
+	pwriter->WriteMDId(pmdtypeGeneric->PmdidAgg(IMDType::EaggSum));
+	pwriter->WriteMDId(pmdtypeGeneric->PmdidAgg(IMDType::EaggCount));
+	pwriter->WriteBool(pmdtypeGeneric->FHashable());
+	pwriter->WriteBool(pmdtypeGeneric->FComposite());
+	pwriter->WriteMDId(pmdtypeGeneric->PmdidBaseRelation());
+	pwriter->WriteMDId(pmdtypeGeneric->PmdidTypeArray());
+	pwriter->WriteInt(pmdtypeGeneric->ILength());
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::SerializeRelation
+//
+//	@doc:
+//		Encode a relation; column positions in distribution and partitioning
+//		keys are stored as indexes into the column array
+//
+//---------------------------------------------------------------------------
+void
+CMDBinaryUtils::SerializeRelation
+	(
+	CWriter *pwriter,
+	const CMDRelationGPDB *pmdrel
+	)
+{
+	pwriter->WriteMDId(pmdrel->Pmdid());
+	pwriter->WriteMDName(pmdrel->Mdname());
+	pwriter->WriteBool(pmdrel->FTemporary());
+	pwriter->WriteUlong(pmdrel->Erelstorage());
+	pwriter->WriteUlong(pmdrel->Ereldistribution());
+
+	const ULONG ulColumns = pmdrel->UlColumns();
+	pwriter->WriteUlong(ulColumns);
+	for (ULONG ul = 0; ul < ulColumns; ul++)
+	{
+		const IMDColumn *pmdcol = pmdrel->Pmdcol(ul);
+		pwriter->WriteMDName(pmdcol->Mdname());
+		pwriter->WriteInt(pmdcol->IAttno());
+		pwriter->WriteMDId(pmdcol->PmdidType());
+		pwriter->WriteInt(pmdcol->ITypeModifier());
+		pwriter->WriteBool(pmdcol->FNullable());
+		pwriter->WriteBool(pmdcol->FDropped());
+		pwriter->WriteUlong(pmdcol->UlLength());
+	}
+
+	const ULONG ulDistrColumns = pmdrel->UlDistrColumns();
+	pwriter->WriteUlong(ulDistrColumns);
+	for (ULONG ul = 0; ul < ulDistrColumns; ul++)
+	{
+		pwriter->WriteUlong(pmdrel->UlPosFromAttno(pmdrel->PmdcolDistrColumn(ul)->IAttno()));
+	}
+
+	const ULONG ulPartColumns = pmdrel->UlPartColumns();
+	pwriter->WriteUlong(ulPartColumns);
+	for (ULONG ul = 0; ul < ulPartColumns; ul++)
+	{
+		pwriter->WriteUlong(pmdrel->UlPosFromAttno(pmdrel->PmdcolPartColumn(ul)->IAttno()));
+	}
+
+	DrgPsz *pdrgpszPartTypes = pmdrel->PdrgpszPartTypes();
+	pwriter->WriteBool(NULL != pdrgpszPartTypes);
+	if (NULL != pdrgpszPartTypes)
+	{
+		const ULONG ulPartTypes = pdrgpszPartTypes->UlLength();
+		pwriter->WriteUlong(ulPartTypes);
+		for (ULONG ul = 0; ul < ulPartTypes; ul++)
+		{
+			pwriter->WriteByte((BYTE) *(*pdrgpszPartTypes)[ul]);
+		}
+	}
+
+	pwriter->WriteUlong(pmdrel->UlPartitions());
+	pwriter->WriteBool(pmdrel->FConvertHashToRandom());
+
+	const ULONG ulKeySets = pmdrel->UlKeySets();
+	pwriter->WriteUlong(ulKeySets);
+	for (ULONG ul = 0; ul < ulKeySets; ul++)
+	{
+		const DrgPul *pdrgpulKeyset = pmdrel->PdrgpulKeyset(ul);
+		const ULONG ulKeys = pdrgpulKeyset->UlLength();
+		pwriter->WriteUlong(ulKeys);
+		for (ULONG ulKey = 0; ulKey < ulKeys; ulKey++)
+		{
+			pwriter->WriteUlong(*(*pdrgpulKeyset)[ulKey]);
+		}
+	}
+
+	const ULONG ulIndices = pmdrel->UlIndices();
+	pwriter->WriteUlong(ulIndices);
+	for (ULONG ul = 0; ul < ulIndices; ul++)
+	{
+		IMDId *pmdidIndex = pmdrel->PmdidIndex(ul);
+		pwriter->WriteMDId(pmdidIndex);
+		pwriter->WriteBool(pmdrel->FPartialIndex(pmdidIndex));
+	}
+
+	const ULONG ulTriggers = pmdrel->UlTriggers();
+	pwriter->WriteUlong(ulTriggers);
+	for (ULONG ul = 0; ul < ulTriggers; ul++)
+	{
+		pwriter->WriteMDId(pmdrel->PmdidTrigger(ul));
+	}
+
+	const ULONG ulCheckConstraints = pmdrel->UlCheckConstraints();
+	pwriter->WriteUlong(ulCheckConstraints);
+	for (ULONG ul = 0; ul < ulCheckConstraints; ul++)
+	{
+		pwriter->WriteMDId(pmdrel->PmdidCheckConstraint(ul));
+	}
+
+	pwriter->WriteBool(pmdrel->FHasOids());
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::UlSize
+//
+//	@doc:
+//		Total size of an encoded object as recorded in its header
+//
+//---------------------------------------------------------------------------
+ULONG
+CMDBinaryUtils::UlSize
+	(
+	const BYTE *pb
+	)
+{
+	GPOS_ASSERT(NULL != pb);
+
+	ULONG ulSize = 0;
+	for (ULONG ulByte = 0; ulByte < sizeof(ULONG); ulByte++)
+	{
+		ulSize |= ((ULONG) pb[3 * sizeof(ULONG) + ulByte]) << (8 * ulByte);
+	}
+
+	return ulSize;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::PimdobjDeserialize
+//
+//	@doc:
+//		Decode an object in the given memory pool; raises on a truncated or
+//		malformed buffer and on a version mismatch
+//
+//---------------------------------------------------------------------------
+IMDCacheObject *
+CMDBinaryUtils::PimdobjDeserialize
+	(
+	IMemoryPool *pmp,
+	const BYTE *pb,
+	ULONG ulSize
+	)
+{
+	CReader reader(pmp, pb, ulSize);
+
+	if (ulMagic != reader.UlRead() || ulVersion != reader.UlRead())
+	{
+		RaiseMalformed();
+	}
+
+	ULONG ulMdt = reader.UlRead();
+	if (ulSize != reader.UlRead())
+	{
+		RaiseMalformed();
+	}
+
+	IMDCacheObject *pimdobj = NULL;
+	switch (ulMdt)
+	{
+		case IMDCacheObject::EmdtRelStats:
+			pimdobj = PimdobjRelStats(pmp, &reader);
+			break;
+
+		case IMDCacheObject::EmdtColStats:
+			pimdobj = PimdobjColStats(pmp, &reader);
+			break;
+
+		case IMDCacheObject::EmdtOp:
+			pimdobj = PimdobjScalarOp(pmp, &reader);
+			break;
+
+		case IMDCacheObject::EmdtCastFunc:
+			pimdobj = PimdobjCast(pmp, &reader);
+			break;
+
+		case IMDCacheObject::EmdtScCmp:
+			pimdobj = PimdobjScCmp(pmp, &reader);
+			break;
+
+		case IMDCacheObject::EmdtType:
+			pimdobj = PimdobjType(pmp, &reader);
+			break;
+
+		case IMDCacheObject::EmdtRel:
+			pimdobj = PimdobjRelation(pmp, &reader);
+			break;
+
+		default:
+			RaiseMalformed();
+	}
+
+	if (!reader.FDone())
+	{
+		pimdobj->Release();
+		RaiseMalformed();
+	}
+
+	return pimdobj;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::PimdobjRelStats
+//
+//	@doc:
+//		Decode relation statistics
+//
+//---------------------------------------------------------------------------
+IMDCacheObject *
+CMDBinaryUtils::PimdobjRelStats
+	(
+	IMemoryPool *pmp,
+	CReader *preader
+	)
+{
+	CAutoRef<IMDId> a_pmdid(preader->PmdidRead());
+	if (NULL == a_pmdid.Pt() || IMDId::EmdidRelStats != a_pmdid->Emdidt())
+	{
+		RaiseMalformed();
+	}
+
+	CAutoP<CMDName> a_pmdname(preader->PmdnameRead());
+	CDouble dRows = preader->DRead();
+	BOOL fEmpty = preader->FRead();
+
+	return GPOS_NEW(pmp) CDXLRelStats(pmp, CMDIdRelStats::PmdidConvert(a_pmdid.PtReset()), a_pmdname.PtReset(), dRows, fEmpty);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::PimdobjColStats
+//
+//	@doc:
+//		Decode column statistics
+//
+//---------------------------------------------------------------------------
+IMDCacheObject *
+CMDBinaryUtils::PimdobjColStats
+	(
+	IMemoryPool *pmp,
+	CReader *preader
+	)
+{
+	CAutoRef<IMDId> a_pmdid(preader->PmdidRead());
+	if (NULL == a_pmdid.Pt() || IMDId::EmdidColStats != a_pmdid->Emdidt())
+	{
+		RaiseMalformed();
+	}
+
+	CAutoP<CMDName> a_pmdname(preader->PmdnameRead());
+	CDouble dWidth = preader->DRead();
+	CDouble dNullFreq = preader->DRead();
+	CDouble dDistinctRemain = preader->DRead();
+	CDouble dFreqRemain = preader->DRead();
+	BOOL fColStatsMissing = preader->FRead();
+
+	CAutoRef<DrgPdxlbucket> a_pdrgpdxlbucket(GPOS_NEW(pmp) DrgPdxlbucket(pmp));
+	const ULONG ulBuckets = preader->UlRead();
+	for (ULONG ul = 0; ul < ulBuckets; ul++)
+	{
+		CAutoRef<CDXLDatum> a_pdxldatumLower(preader->PdxldatumRead());
+		CAutoRef<CDXLDatum> a_pdxldatumUpper(preader->PdxldatumRead());
+		BOOL fLowerClosed = preader->FRead();
+		BOOL fUpperClosed = preader->FRead();
+		CDouble dFrequency = preader->DRead();
+		CDouble dDistinct = preader->DRead();
+
+		a_pdrgpdxlbucket->Append
+						(
+						GPOS_NEW(pmp) CDXLBucket(a_pdxldatumLower.PtReset(), a_pdxldatumUpper.PtReset(), fLowerClosed, fUpperClosed, dFrequency, dDistinct)
+						);
+	}
+
+	return GPOS_NEW(pmp) CDXLColStats
+						(
+						pmp,
+						CMDIdColStats::PmdidConvert(a_pmdid.PtReset()),
+						a_pmdname.PtReset(),
+						dWidth,
+						dNullFreq,
+						dDistinctRemain,
+						dFreqRemain,
+						a_pdrgpdxlbucket.PtReset(),
+						fColStatsMissing
+						);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::PimdobjScalarOp
+//
+//	@doc:
+//		Decode a scalar operator
+//
+//---------------------------------------------------------------------------
+IMDCacheObject *
+CMDBinaryUtils::PimdobjScalarOp
+	(
+	IMemoryPool *pmp,
+	CReader *preader
+	)
+{
+	CAutoRef<IMDId> a_pmdid(preader->PmdidRead());
+	CAutoP<CMDName> a_pmdname(preader->PmdnameRead());
+	CAutoRef<IMDId> a_pmdidTypeLeft(preader->PmdidRead());
+	CAutoRef<IMDId> a_pmdidTypeRight(preader->PmdidRead());
+	CAutoRef<IMDId> a_pmdidTypeResult(preader->PmdidRead());
+	CAutoRef<IMDId> a_pmdidFunc(preader->PmdidRead());
+	CAutoRef<IMDId> a_pmdidOpCommute(preader->PmdidRead());
+	CAutoRef<IMDId> a_pmdidOpInverse(preader->PmdidRead());
+	ULONG ulCmpt = preader->UlRead();
+	BOOL fReturnsNullOnNullInput = preader->FRead();
+
+	if (IMDType::EcmptOther < ulCmpt)
+	{
+		RaiseMalformed();
+	}
+
+	CAutoRef<DrgPmdid> a_pdrgpmdidOpClasses(GPOS_NEW(pmp) DrgPmdid(pmp));
+	const ULONG ulOpClasses = preader->UlRead();
+	for (ULONG ul = 0; ul < ulOpClasses; ul++)
+	{
+		a_pdrgpmdidOpClasses->Append(preader->PmdidRead());
+	}
+
+	return GPOS_NEW(pmp) CMDScalarOpGPDB
+						(
+						pmp,
+						a_pmdid.PtReset(),
+						a_pmdname.PtReset(),
+						a_pmdidTypeLeft.PtReset(),
+						a_pmdidTypeRight.PtReset(),
+						a_pmdidTypeResult.PtReset(),
+						a_pmdidFunc.PtReset(),
+						a_pmdidOpCommute.PtReset(),
+						a_pmdidOpInverse.PtReset(),
+						(IMDType::ECmpType) ulCmpt,
+						fReturnsNullOnNullInput,
+						a_pdrgpmdidOpClasses.PtReset()
+						);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::PimdobjCast
+//
+//	@doc:
+//		Decode a cast function
+//
+//---------------------------------------------------------------------------
+IMDCacheObject *
+CMDBinaryUtils::PimdobjCast
+	(
+	IMemoryPool *pmp,
+	CReader *preader
+	)
+{
+	BOOL fArrayCoerce = preader->FRead();
+	CAutoRef<IMDId> a_pmdid(preader->PmdidRead());
+	CAutoP<CMDName> a_pmdname(preader->PmdnameRead());
+	CAutoRef<IMDId> a_pmdidSrc(preader->PmdidRead());
+	CAutoRef<IMDId> a_pmdidDest(preader->PmdidRead());
+	BOOL fBinaryCoercible = preader->FRead();
+	CAutoRef<IMDId> a_pmdidCastFunc(preader->PmdidRead());
+	ULONG ulPathType = preader->UlRead();
+
+	if (IMDCast::EmdtArrayCoerce < ulPathType)
+	{
+		RaiseMalformed();
+	}
+	IMDCast::EmdCoercepathType emdPathType = (IMDCast::EmdCoercepathType) ulPathType;
+
+	if (!fArrayCoerce)
+	{
+		return GPOS_NEW(pmp) CMDCastGPDB
+							(
+							pmp,
+							a_pmdid.PtReset(),
+							a_pmdname.PtReset(),
+							a_pmdidSrc.PtReset(),
+							a_pmdidDest.PtReset(),
+							fBinaryCoercible,
+							a_pmdidCastFunc.PtReset(),
+							emdPathType
+							);
+	}
+
+	INT iTypeModifier = preader->IRead();
+	BOOL fIsExplicit = preader->FRead();
+	ULONG ulCoercionForm = preader->UlRead();
+	INT iLoc = preader->IRead();
+
+	if (EdxlcfDontCare < ulCoercionForm)
+	{
+		RaiseMalformed();
+	}
+
+	return GPOS_NEW(pmp) CMDArrayCoerceCastGPDB
+						(
+						pmp,
+						a_pmdid.PtReset(),
+						a_pmdname.PtReset(),
+						a_pmdidSrc.PtReset(),
+						a_pmdidDest.PtReset(),
+						fBinaryCoercible,
+						a_pmdidCastFunc.PtReset(),
+						emdPathType,
+						iTypeModifier,
+						fIsExplicit,
+						(EdxlCoercionForm) ulCoercionForm,
+						iLoc
+						);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::PimdobjScCmp
+//
+//	@doc:
+//		Decode a scalar comparison
+//
+//---------------------------------------------------------------------------
+IMDCacheObject *
+CMDBinaryUtils::PimdobjScCmp
+	(
+	IMemoryPool *pmp,
+	CReader *preader
+	)
+{
+	CAutoRef<IMDId> a_pmdid(preader->PmdidRead());
+	CAutoP<CMDName> a_pmdname(preader->PmdnameRead());
+	CAutoRef<IMDId> a_pmdidLeft(preader->PmdidRead());
+	CAutoRef<IMDId> a_pmdidRight(preader->PmdidRead());
+	ULONG ulCmpt = preader->UlRead();
+	CAutoRef<IMDId> a_pmdidOp(preader->PmdidRead());
+
+	if (IMDType::EcmptOther < ulCmpt)
+	{
+		RaiseMalformed();
+	}
+
+	return GPOS_NEW(pmp) CMDScCmpGPDB
+						(
+						pmp,
+						a_pmdid.PtReset(),
+						a_pmdname.PtReset(),
+						a_pmdidLeft.PtReset(),
+						a_pmdidRight.PtReset(),
+						(IMDType::ECmpType) ulCmpt,
+						a_pmdidOp.PtReset()
+						);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::PimdobjType
+//
+//	@doc:
+//		Decode a type
+//
+//---------------------------------------------------------------------------
+IMDCacheObject *
+CMDBinaryUtils::PimdobjType
+	(
+	IMemoryPool *pmp,
+	CReader *preader
+	)
+{
+	switch (preader->UlRead())
+	{
+		case IMDType::EtiInt2:
+			return GPOS_NEW(pmp) CMDTypeInt2GPDB(pmp);
+
+		case IMDType::EtiInt4:
+			return GPOS_NEW(pmp) CMDTypeInt4GPDB(pmp);
+
+		case IMDType::EtiInt8:
+			return GPOS_NEW(pmp) CMDTypeInt8GPDB(pmp);
+
+		case IMDType::EtiBool:
+			return GPOS_NEW(pmp) CMDTypeBoolGPDB(pmp);
+
+		case IMDType::EtiOid:
+			return GPOS_NEW(pmp) CMDTypeOidGPDB(pmp);
+
+		case IMDType::EtiGeneric:
+			break;
+
+		default:
+			RaiseMalformed();
+	}
+
+	CAutoRef<IMDId> a_pmdid(preader->PmdidRead());
+	CAutoP<CMDName> a_pmdname(preader->PmdnameRead());
+	BOOL fRedistributable = preader->FRead();
+	BOOL fFixedLength = preader->FRead();
+	ULONG ulLength = preader->UlRead();
+	BOOL fByValue = preader->FRead();
+	CAutoRef<IMDId> a_pmdidOpEq(preader->PmdidRead());
+	CAutoRef<IMDId> a_pmdidOpNEq(preader->PmdidRead());
+	CAutoRef<IMDId> a_pmdidOpLT(preader->PmdidRead());
+	CAutoRef<IMDId> a_pmdidOpLEq(preader->PmdidRead());
+	CAutoRef<IMDId> a_pmdidOpGT(preader->PmdidRead());
+	CAutoRef<IMDId> a_pmdidOpGEq(preader->PmdidRead());
+	CAutoRef<IMDId> a_pmdidOpComp(preader->PmdidRead());
+	CAutoRef<IMDId> a_pmdidMin(preader->PmdidRead());
+	CAutoRef<IMDId> a_pmdidMax(preader->PmdidRead());
+	CAutoRef<IMDId> a_pmdidAvg(preader->PmdidRead());
+	CAutoRef<IMDId> a_pmdidSum(preader->PmdidRead());
+	CAutoRef<IMDId> a_pmdidCount(preader->PmdidRead());
+	BOOL fHashable = preader->FRead();
+	BOOL fComposite = preader->FRead();
+	CAutoRef<IMDId> a_pmdidBaseRelation(preader->PmdidRead());
+	CAutoRef<IMDId> a_pmdidTypeArray(preader->PmdidRead());
+	INT iLength = preader->IRead();
+
+	return GPOS_NEW(pmp) CMDTypeGenericGPDB
+						(
+						pmp,
+						a_pmdid.PtReset(),
+						a_pmdname.PtReset(),
+						fRedistributable,
+						fFixedLength,
+						ulLength,
+						fByValue,
+						a_pmdidOpEq.PtReset(),
+						a_pmdidOpNEq.PtReset(),
+						a_pmdidOpLT.PtReset(),
+						a_pmdidOpLEq.PtReset(),
+						a_pmdidOpGT.PtReset(),
+						a_pmdidOpGEq.PtReset(),
+						a_pmdidOpComp.PtReset(),
+						a_pmdidMin.PtReset(),
+						a_pmdidMax.PtReset(),
+						a_pmdidAvg.PtReset(),
+						a_pmdidSum.PtReset(),
+						a_pmdidCount.PtReset(),
+						fHashable,
+						fComposite,
+						a_pmdidBaseRelation.PtReset(),
+						a_pmdidTypeArray.PtReset(),
+						iLength
+						);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDBinaryUtils::PimdobjRelation
+//
+//	@doc:
+//		Decode a relation
+//
+//---------------------------------------------------------------------------
+IMDCacheObject *
+CMDBinaryUtils::PimdobjRelation
+	(
+	IMemoryPool *pmp,
+	CReader *preader
+	)
+{
+	CAutoRef<IMDId> a_pmdid(preader->PmdidRead());
+	CAutoP<CMDName> a_pmdname(preader->PmdnameRead());
+	BOOL fTemporary = preader->FRead();
+	ULONG ulStorage = preader->UlRead();
+	ULONG ulDistrPolicy = preader->UlRead();
+
+	if (IMDRelation::ErelstorageSentinel <= ulStorage || IMDRelation::EreldistrSentinel <= ulDistrPolicy)
+	{
+		RaiseMalformed();
+	}
+
+	CAutoRef<DrgPmdcol> a_pdrgpmdcol(GPOS_NEW(pmp) DrgPmdcol(pmp));
+	const ULONG ulColumns = preader->UlRead();
+	for (ULONG ul = 0; ul < ulColumns; ul++)
+	{
+		CAutoP<CMDName> a_pmdnameCol(preader->PmdnameRead());
+		INT iAttno = preader->IRead();
+		CAutoRef<IMDId> a_pmdidType(preader->PmdidRead());
+		INT iTypeModifier = preader->IRead();
+		BOOL fNullable = preader->FRead();
+		BOOL fDropped = preader->FRead();
+		ULONG ulLength = preader->UlRead();
+
+		a_pdrgpmdcol->Append
+					(
+					GPOS_NEW(pmp) CMDColumn
+									(
+									a_pmdnameCol.PtReset(),
+									iAttno,
+									a_pmdidType.PtReset(),
+									iTypeModifier,
+									fNullable,
+									fDropped,
+									NULL /*pdxlnDefaultValue*/,
+									ulLength
+									)
+					);
+	}
+
+	CAutoRef<DrgPul> a_pdrgpulDistrColumns;
+	const ULONG ulDistrColumns = preader->UlRead();
+	if (0 < ulDistrColumns)
+	{
+		a_pdrgpulDistrColumns = GPOS_NEW(pmp) DrgPul(pmp);
+		for (ULONG ul = 0; ul < ulDistrColumns; ul++)
+		{
+			a_pdrgpulDistrColumns->Append(GPOS_NEW(pmp) ULONG(preader->UlRead()));
+		}
+	}
+
+	CAutoRef<DrgPul> a_pdrgpulPartColumns;
+	const ULONG ulPartColumns = preader->UlRead();
+	if (0 < ulPartColumns)
+	{
+		a_pdrgpulPartColumns = GPOS_NEW(pmp) DrgPul(pmp);
+		for (ULONG ul = 0; ul < ulPartColumns; ul++)
+		{
+			a_pdrgpulPartColumns->Append(GPOS_NEW(pmp) ULONG(preader->UlRead()));
+		}
+	}
+
+	CAutoRef<DrgPsz> a_pdrgpszPartTypes;
+	if (preader->FRead())
+	{
+		a_pdrgpszPartTypes = GPOS_NEW(pmp) DrgPsz(pmp);
+		const ULONG ulPartTypes = preader->UlRead();
+		for (ULONG ul = 0; ul < ulPartTypes; ul++)
+		{
+			a_pdrgpszPartTypes->Append(GPOS_NEW(pmp) CHAR((CHAR) preader->BRead()));
+		}
+	}
+
+	ULONG ulPartitions = preader->UlRead();
+	BOOL fConvertHashToRandom = preader->FRead();
+
+	CAutoRef<DrgPdrgPul> a_pdrgpdrgpulKeys(GPOS_NEW(pmp) DrgPdrgPul(pmp));
+	const ULONG ulKeySets = preader->UlRead();
+	for (ULONG ul = 0; ul < ulKeySets; ul++)
+	{
+		CAutoRef<DrgPul> a_pdrgpulKeyset(GPOS_NEW(pmp) DrgPul(pmp));
+		const ULONG ulKeys = preader->UlRead();
+		for (ULONG ulKey = 0; ulKey < ulKeys; ulKey++)
+		{
+			a_pdrgpulKeyset->Append(GPOS_NEW(pmp) ULONG(preader->UlRead()));
+		}
+		a_pdrgpdrgpulKeys->Append(a_pdrgpulKeyset.PtReset());
+	}
+
+	CAutoRef<DrgPmdIndexInfo> a_pdrgpmdIndexInfo(GPOS_NEW(pmp) DrgPmdIndexInfo(pmp));
+	const ULONG ulIndices = preader->UlRead();
+	for (ULONG ul = 0; ul < ulIndices; ul++)
+	{
+		CAutoRef<IMDId> a_pmdidIndex(preader->PmdidRead());
+		BOOL fPartial = preader->FRead();
+		a_pdrgpmdIndexInfo->Append(GPOS_NEW(pmp) CMDIndexInfo(a_pmdidIndex.PtReset(), fPartial));
+	}
+
+	CAutoRef<DrgPmdid> a_pdrgpmdidTriggers(GPOS_NEW(pmp) DrgPmdid(pmp));
+	const ULONG ulTriggers = preader->UlRead();
+	for (ULONG ul = 0; ul < ulTriggers; ul++)
+	{
+		a_pdrgpmdidTriggers->Append(preader->PmdidRead());
+	}
+
+	CAutoRef<DrgPmdid> a_pdrgpmdidCheckConstraint(GPOS_NEW(pmp) DrgPmdid(pmp));
+	const ULONG ulCheckConstraints = preader->UlRead();
+	for (ULONG ul = 0; ul < ulCheckConstraints; ul++)
+	{
+		a_pdrgpmdidCheckConstraint->Append(preader->PmdidRead());
+	}
+
+	BOOL fHasOids = preader->FRead();
+
+	return GPOS_NEW(pmp) CMDRelationGPDB
+						(
+						pmp,
+						a_pmdid.PtReset(),
+						a_pmdname.PtReset(),
+						fTemporary,
+						(IMDRelation::Erelstoragetype) ulStorage,
+						(IMDRelation::Ereldistrpolicy) ulDistrPolicy,
+						a_pdrgpmdcol.PtReset(),
+						a_pdrgpulDistrColumns.PtReset(),
+						a_pdrgpulPartColumns.PtReset(),
+						a_pdrgpszPartTypes.PtReset(),
+						ulPartitions,
+						fConvertHashToRandom,
+						a_pdrgpdrgpulKeys.PtReset(),
+						a_pdrgpmdIndexInfo.PtReset(),
+						a_pdrgpmdidTriggers.PtReset(),
+						a_pdrgpmdidCheckConstraint.PtReset(),
+						NULL /*pmdpartcnstr*/,
+						fHasOids
+						);
+}
+
+// EOF
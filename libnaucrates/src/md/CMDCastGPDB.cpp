@@ -53,8 +53,6 @@ CMDCastGPDB::CMDCastGPDB
 	GPOS_ASSERT(m_pmdidSrc->FValid());
 	GPOS_ASSERT(m_pmdidDest->FValid());
 	GPOS_ASSERT_IMP(!fBinaryCoercible, m_pmdidCastFunc->FValid());
-
-	m_pstr = CDXLUtils::PstrSerializeMDObj(m_pmp, this, false /*fSerializeHeader*/, false /*fIndent*/);
 }
 
 //---------------------------------------------------------------------------
@@ -72,7 +70,6 @@ CMDCastGPDB::~CMDCastGPDB()
 	m_pmdidDest->Release();
 	CRefCount::SafeRelease(m_pmdidCastFunc);
 	GPOS_DELETE(m_pmdname);
-	GPOS_DELETE(m_pstr);
 }
 
 
@@ -48,8 +48,6 @@ CMDCheckConstraintGPDB::CMDCheckConstraintGPDB
 	GPOS_ASSERT(pmdidRel->FValid());
 	GPOS_ASSERT(NULL != pmdname);
 	GPOS_ASSERT(NULL != pdxln);
-
-	m_pstr = CDXLUtils::PstrSerializeMDObj(m_pmp, this, false /*fSerializeHeader*/, false /*fIndent*/);
 }
 
 //---------------------------------------------------------------------------
@@ -63,7 +61,6 @@ CMDCheckConstraintGPDB::CMDCheckConstraintGPDB
 CMDCheckConstraintGPDB::~CMDCheckConstraintGPDB()
 {
 	GPOS_DELETE(m_pmdname);
-	GPOS_DELETE(m_pstr);
 	m_pmdid->Release();
 	m_pmdidRel->Release();
 	m_pdxln->Release();
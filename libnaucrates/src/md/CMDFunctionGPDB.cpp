@@ -56,7 +56,6 @@ CMDFunctionGPDB::CMDFunctionGPDB
 	GPOS_ASSERT(EfdaSentinel > efdaDataAccess);
 
 	InitDXLTokenArrays();
-	m_pstr = CDXLUtils::PstrSerializeMDObj(m_pmp, this, false /*fSerializeHeader*/, false /*fIndent*/);
 }
 
 //---------------------------------------------------------------------------
@@ -73,7 +72,6 @@ CMDFunctionGPDB::~CMDFunctionGPDB()
 	m_pmdidTypeResult->Release();
 	CRefCount::SafeRelease(m_pdrgpmdidTypes);
 	GPOS_DELETE(m_pmdname);
-	GPOS_DELETE(m_pstr);
 }
 
 //---------------------------------------------------------------------------
@@ -64,8 +64,6 @@ CMDIndexGPDB::CMDIndexGPDB
 	GPOS_ASSERT_IMP(NULL != pmdidItemType, IMDIndex::EmdindBitmap == emdindt);
 	GPOS_ASSERT_IMP(IMDIndex::EmdindBitmap == emdindt, NULL != pmdidItemType && pmdidItemType->FValid());
 	GPOS_ASSERT(NULL != pdrgpmdidOpClasses);
-	
-	m_pstr = CDXLUtils::PstrSerializeMDObj(m_pmp, this, false /*fSerializeHeader*/, false /*fIndent*/);
 }
 
 //---------------------------------------------------------------------------
@@ -79,7 +77,6 @@ CMDIndexGPDB::CMDIndexGPDB
 CMDIndexGPDB::~CMDIndexGPDB()
 {
 	GPOS_DELETE(m_pmdname);
-	GPOS_DELETE(m_pstr);
 	m_pmdid->Release();
 	CRefCount::SafeRelease(m_pmdidItemType);
 	m_pdrgpulKeyCols->Release();
@@ -18,6 +18,7 @@
 #include "gpos/error/CAutoTrace.h"
 
 #include "naucrates/md/CMDProviderMemory.h"
+#include "naucrates/md/CMDBinaryUtils.h"
 #include "naucrates/md/CMDTypeInt4GPDB.h"
 #include "naucrates/md/CMDTypeInt8GPDB.h"
 #include "naucrates/md/CMDTypeBoolGPDB.h"
@@ -46,7 +47,8 @@ CMDProviderMemory::CMDProviderMemory
 	const CHAR *szFileName
 	)
 	:
-	m_pmdmap(NULL)
+	m_pmdmap(NULL),
+	m_pmdbinmap(NULL)
 {
 	GPOS_ASSERT(NULL != szFileName);
 	
@@ -79,7 +81,8 @@ CMDProviderMemory::CMDProviderMemory
 	DrgPimdobj *pdrgpmdobj
 	)
 	:
-	m_pmdmap(NULL)
+	m_pmdmap(NULL),
+	m_pmdbinmap(NULL)
 {
 	LoadMetadataObjectsFromArray(pmp, pdrgpmdobj);
 }
@@ -106,6 +109,10 @@ CMDProviderMemory::LoadMetadataObjectsFromArray
 	m_pmdmap = GPOS_NEW(pmp) MDMap(pmp);
 	a_pmdmap = m_pmdmap;
 
+	CAutoRef<MDBinaryMap> a_pmdbinmap;
+	m_pmdbinmap = GPOS_NEW(pmp) MDBinaryMap(pmp);
+	a_pmdbinmap = m_pmdbinmap;
+
 	const ULONG ulSize = pdrgpmdobj->UlLength();
 
 	// load objects into the hash map
@@ -131,10 +138,24 @@ CMDProviderMemory::LoadMetadataObjectsFromArray
 		}
 		(void) a_pmdidKey.PtReset();
 		(void) a_pstr.PtReset();
+
+		// keep the binary encoding of objects that support it
+		ULONG ulSize = 0;
+		BYTE *pb = CMDBinaryUtils::PbSerialize(pmp, pmdobj, &ulSize);
+		if (NULL != pb)
+		{
+			pmdidKey->AddRef();
+#ifdef GPOS_DEBUG
+			BOOL fInsertedBinary =
+#endif // GPOS_DEBUG
+			m_pmdbinmap->FInsert(pmdidKey, pb);
+			GPOS_ASSERT(fInsertedBinary);
+		}
 	}
 	
 	// safely completed loading
 	(void) a_pmdmap.PtReset();
+	(void) a_pmdbinmap.PtReset();
 }
 
 //---------------------------------------------------------------------------
@@ -148,6 +169,7 @@ CMDProviderMemory::LoadMetadataObjectsFromArray
 CMDProviderMemory::~CMDProviderMemory()
 {
 	CRefCount::SafeRelease(m_pmdmap);
+	CRefCount::SafeRelease(m_pmdbinmap);
 }
 
 //---------------------------------------------------------------------------
@@ -221,6 +243,44 @@ CMDProviderMemory::PstrObject
 	return a_pstrResult.PtReset();
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDProviderMemory::PbObject
+//
+//	@doc:
+//		Returns a copy of the binary encoding of the requested object in the
+//		provided memory pool, or NULL if the object has no binary encoding
+//
+//---------------------------------------------------------------------------
+BYTE *
+CMDProviderMemory::PbObject
+	(
+	IMemoryPool *pmp,
+	CMDAccessor *, //pmda
+	IMDId *pmdid,
+	ULONG *pulSize
+	)
+	const
+{
+	GPOS_ASSERT(NULL != m_pmdbinmap);
+	GPOS_ASSERT(NULL != pulSize);
+
+	*pulSize = 0;
+
+	const BYTE *pbObj = m_pmdbinmap->PtLookup(pmdid);
+	if (NULL == pbObj)
+	{
+		return NULL;
+	}
+
+	const ULONG ulSize = CMDBinaryUtils::UlSize(pbObj);
+	BYTE *pb = GPOS_NEW_ARRAY(pmp, BYTE, ulSize);
+	(void) clib::PvMemCpy(pb, pbObj, ulSize);
+	*pulSize = ulSize;
+
+	return pb;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CMDProviderMemory::Pmdid
@@ -94,7 +94,6 @@ CMDRelationCtasGPDB::CMDRelationCtasGPDB
 
 		m_pdrgpdoubleColWidths->Append(GPOS_NEW(pmp) CDouble(pmdcol->UlLength()));
 	}
-	m_pstr = CDXLUtils::PstrSerializeMDObj(m_pmp, this, false /*fSerializeHeader*/, false /*fIndent*/);
 }
 
 //---------------------------------------------------------------------------
@@ -109,7 +108,6 @@ CMDRelationCtasGPDB::~CMDRelationCtasGPDB()
 {
 	GPOS_DELETE(m_pmdnameSchema);
 	GPOS_DELETE(m_pmdname);
-	GPOS_DELETE(m_pstr);
 	m_pmdid->Release();
 	m_pdrgpmdcol->Release();
 	m_pdrgpdrgpulKeys->Release();
@@ -110,7 +110,6 @@ CMDRelationExternalGPDB::CMDRelationExternalGPDB
 									);
 		m_pdrgpdoubleColWidths->Append(GPOS_NEW(pmp) CDouble(pmdcol->UlLength()));
 	}
-	m_pstr = CDXLUtils::PstrSerializeMDObj(m_pmp, this, false /*fSerializeHeader*/, false /*fIndent*/);
 }
 
 //---------------------------------------------------------------------------
@@ -124,7 +123,6 @@ CMDRelationExternalGPDB::CMDRelationExternalGPDB
 CMDRelationExternalGPDB::~CMDRelationExternalGPDB()
 {
 	GPOS_DELETE(m_pmdname);
-	GPOS_DELETE(m_pstr);
 	m_pmdid->Release();
 	m_pdrgpmdcol->Release();
 	CRefCount::SafeRelease(m_pdrgpulDistrColumns);
@@ -121,7 +121,6 @@ CMDRelationGPDB::CMDRelationGPDB
 
 		m_pdrgpdoubleColWidths->Append(GPOS_NEW(pmp) CDouble(pmdcol->UlLength()));
 	}
-	m_pstr = CDXLUtils::PstrSerializeMDObj(m_pmp, this, false /*fSerializeHeader*/, false /*fIndent*/);
 }
 
 //---------------------------------------------------------------------------
@@ -135,7 +134,6 @@ CMDRelationGPDB::CMDRelationGPDB
 CMDRelationGPDB::~CMDRelationGPDB()
 {
 	GPOS_DELETE(m_pmdname);
-	GPOS_DELETE(m_pstr);
 	m_pmdid->Release();
 	m_pdrgpmdcol->Release();
 	CRefCount::SafeRelease(m_pdrgpulDistrColumns);
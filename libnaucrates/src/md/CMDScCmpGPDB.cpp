@@ -52,8 +52,6 @@ CMDScCmpGPDB::CMDScCmpGPDB
 	GPOS_ASSERT(m_pmdidRight->FValid());
 	GPOS_ASSERT(m_pmdidOp->FValid());
 	GPOS_ASSERT(IMDType::EcmptOther != m_ecmpt);
-
-	m_pstr = CDXLUtils::PstrSerializeMDObj(m_pmp, this, false /*fSerializeHeader*/, false /*fIndent*/);
 }
 
 //---------------------------------------------------------------------------
@@ -71,7 +69,6 @@ CMDScCmpGPDB::~CMDScCmpGPDB()
 	m_pmdidRight->Release();
 	m_pmdidOp->Release();
 	GPOS_DELETE(m_pmdname);
-	GPOS_DELETE(m_pstr);
 }
 
 
@@ -58,7 +58,6 @@ CMDScalarOpGPDB::CMDScalarOpGPDB
 	m_pdrgpmdidOpClasses(pdrgpmdidOpClasses)
 {
 	GPOS_ASSERT(NULL != pdrgpmdidOpClasses);
-	m_pstr = CDXLUtils::PstrSerializeMDObj(m_pmp, this, false /*fSerializeHeader*/, false /*fIndent*/);
 }
 
 
@@ -82,7 +81,6 @@ CMDScalarOpGPDB::~CMDScalarOpGPDB()
 	CRefCount::SafeRelease(m_pmdidOpInverse);
 	
 	GPOS_DELETE(m_pmdname);
-	GPOS_DELETE(m_pstr);
 	m_pdrgpmdidOpClasses->Release();
 }
 
@@ -51,8 +51,6 @@ CMDTriggerGPDB::CMDTriggerGPDB
 	GPOS_ASSERT(m_pmdidRel->FValid());
 	GPOS_ASSERT(m_pmdidFunc->FValid());
 	GPOS_ASSERT(0 <= iType);
-
-	m_pstr = CDXLUtils::PstrSerializeMDObj(m_pmp, this, false /*fSerializeHeader*/, false /*fIndent*/);
 }
 
 //---------------------------------------------------------------------------
@@ -69,7 +67,6 @@ CMDTriggerGPDB::~CMDTriggerGPDB()
 	m_pmdidRel->Release();
 	m_pmdidFunc->Release();
 	GPOS_DELETE(m_pmdname);
-	GPOS_DELETE(m_pstr);
 }
 
 //---------------------------------------------------------------------------
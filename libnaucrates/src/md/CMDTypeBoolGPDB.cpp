@@ -64,8 +64,6 @@ CMDTypeBoolGPDB::CMDTypeBoolGPDB
 	m_pmdidSum = GPOS_NEW(pmp) CMDIdGPDB(GPDB_BOOL_AGG_SUM);
 	m_pmdidCount = GPOS_NEW(pmp) CMDIdGPDB(GPDB_BOOL_AGG_COUNT);
 
-	m_pstr = CDXLUtils::PstrSerializeMDObj(m_pmp, this, false /*fSerializeHeader*/, false /*fIndent*/);
-
 	m_pmdid->AddRef();
 
 	GPOS_ASSERT(GPDB_BOOL_OID == CMDIdGPDB::PmdidConvert(m_pmdid)->OidObjectId());
@@ -98,7 +96,6 @@ CMDTypeBoolGPDB::~CMDTypeBoolGPDB()
 	m_pmdidSum->Release();
 	m_pmdidCount->Release();
 	m_pdatumNull->Release();
-	GPOS_DELETE(m_pstr);
 }
 
 //---------------------------------------------------------------------------
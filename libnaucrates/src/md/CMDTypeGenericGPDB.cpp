@@ -100,7 +100,6 @@ CMDTypeGenericGPDB::CMDTypeGenericGPDB
 {
 	GPOS_ASSERT_IMP(m_fFixedLength, 0 < m_ulLength);
 	GPOS_ASSERT_IMP(!m_fFixedLength, 0 > m_iLength);
-	m_pstr = CDXLUtils::PstrSerializeMDObj(m_pmp, this, false /*fSerializeHeader*/, false /*fIndent*/);
 
 	m_pmdid->AddRef();
 	m_pdatumNull = GPOS_NEW(m_pmp) CDatumGenericGPDB(m_pmp, m_pmdid, IDefaultTypeModifier, NULL /*pba*/, 0 /*ulLength*/, true /*fConstNull*/, 0 /*lValue */, 0 /*dValue */);
@@ -132,7 +131,6 @@ CMDTypeGenericGPDB::~CMDTypeGenericGPDB()
 	m_pmdidCount->Release();
 	CRefCount::SafeRelease(m_pmdidBaseRelation);
 	GPOS_DELETE(m_pmdname);
-	GPOS_DELETE(m_pstr);
 	m_pdatumNull->Release();
 }
 
@@ -62,8 +62,6 @@ CMDTypeInt4GPDB::CMDTypeInt4GPDB
 	m_pmdidSum = GPOS_NEW(pmp) CMDIdGPDB(GPDB_INT4_AGG_SUM);
 	m_pmdidCount = GPOS_NEW(pmp) CMDIdGPDB(GPDB_INT4_AGG_COUNT);
 
-	m_pstr = CDXLUtils::PstrSerializeMDObj(m_pmp, this, false /*fSerializeHeader*/, false /*fIndent*/);
-
 	GPOS_ASSERT(GPDB_INT4_OID == CMDIdGPDB::PmdidConvert(m_pmdid)->OidObjectId());
 	m_pmdid->AddRef();
 	m_pdatumNull = GPOS_NEW(pmp) CDatumInt4GPDB(m_pmdid, 1 /* fVal */, true /* fNull */);
@@ -94,8 +92,6 @@ CMDTypeInt4GPDB::~CMDTypeInt4GPDB()
 	m_pmdidSum->Release();
 	m_pmdidCount->Release();
 	m_pdatumNull->Release();
-
-	GPOS_DELETE(m_pstr);
 }
 
 //---------------------------------------------------------------------------
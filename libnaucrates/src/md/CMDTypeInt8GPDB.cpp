@@ -69,8 +69,6 @@ CMDTypeInt8GPDB::CMDTypeInt8GPDB
 	m_pmdidSum = GPOS_NEW(pmp) CMDIdGPDB(GPDB_INT8_AGG_SUM);
 	m_pmdidCount = GPOS_NEW(pmp) CMDIdGPDB(GPDB_INT8_AGG_COUNT);
 
-	m_pstr = CDXLUtils::PstrSerializeMDObj(m_pmp, this, false /*fSerializeHeader*/, false /*fIndent*/);
-
 	GPOS_ASSERT(GPDB_INT8_OID == CMDIdGPDB::PmdidConvert(m_pmdid)->OidObjectId());
 	m_pmdid->AddRef();
 	m_pdatumNull = GPOS_NEW(pmp) CDatumInt8GPDB(m_pmdid, 1 /* fVal */, true /* fNull */);
@@ -102,8 +100,6 @@ CMDTypeInt8GPDB::~CMDTypeInt8GPDB()
 	m_pmdidSum->Release();
 	m_pmdidCount->Release();
 	m_pdatumNull->Release();
-	
-	GPOS_DELETE(m_pstr);
 }
 
 //---------------------------------------------------------------------------
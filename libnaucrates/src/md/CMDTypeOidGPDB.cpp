@@ -62,8 +62,6 @@ CMDTypeOidGPDB::CMDTypeOidGPDB
 	m_pmdidAvg = GPOS_NEW(pmp) CMDIdGPDB(GPDB_OID_AGG_AVG);
 	m_pmdidSum = GPOS_NEW(pmp) CMDIdGPDB(GPDB_OID_AGG_SUM);
 	m_pmdidCount = GPOS_NEW(pmp) CMDIdGPDB(GPDB_OID_AGG_COUNT);
-	
-	m_pstr = CDXLUtils::PstrSerializeMDObj(m_pmp, this, false /*fSerializeHeader*/, false /*fIndent*/);
 
 	GPOS_ASSERT(GPDB_OID_OID == CMDIdGPDB::PmdidConvert(m_pmdid)->OidObjectId());
 	m_pmdid->AddRef();
@@ -96,8 +94,6 @@ CMDTypeOidGPDB::~CMDTypeOidGPDB()
 	m_pmdidSum->Release();
 	m_pmdidCount->Release();
 	m_pdatumNull->Release();
-
-	GPOS_DELETE(m_pstr);
 }
 
 //---------------------------------------------------------------------------
@@ -11,6 +11,7 @@
 
 #include "naucrates/md/IMDProvider.h"
 #include "naucrates/md/CMDIdGPDB.h"
+#include "naucrates/md/CMDRequest.h"
 
 using namespace gpmd;
 
@@ -59,4 +60,38 @@ IMDProvider::PmdidTypeGPDB
 	}
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		IMDProvider::PdrgpbObjects
+//
+//	@doc:
+//		Return the binary encodings of the requested objects. Providers with
+//		an actual round trip per lookup should override this to fetch the
+//		whole batch at once; the default looks objects up one at a time
+//
+//---------------------------------------------------------------------------
+DrgPbMDObject *
+IMDProvider::PdrgpbObjects
+	(
+	IMemoryPool *pmp,
+	CMDAccessor *pmda,
+	const CMDRequest *pmdr
+	)
+	const
+{
+	GPOS_ASSERT(NULL != pmdr);
+
+	DrgPmdid *pdrgpmdid = pmdr->Pdrgpmdid();
+	DrgPbMDObject *pdrgpb = GPOS_NEW(pmp) DrgPbMDObject(pmp);
+
+	const ULONG ulObjects = pdrgpmdid->UlLength();
+	for (ULONG ul = 0; ul < ulObjects; ul++)
+	{
+		ULONG ulSize = 0;
+		pdrgpb->Append(PbObject(pmp, pmda, (*pdrgpmdid)[ul], &ulSize));
+	}
+
+	return pdrgpb;
+}
+
 // EOF
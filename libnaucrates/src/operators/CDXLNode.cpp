@@ -13,6 +13,8 @@
 #include "naucrates/dxl/operators/CDXLDirectDispatchInfo.h"
 
 #include "naucrates/dxl/operators/CDXLOperator.h"
+#include "naucrates/dxl/xml/CXMLSerializer.h"
+#include "naucrates/dxl/xml/dxltokens.h"
 
 using namespace gpos;
 using namespace gpdxl;
@@ -270,6 +272,24 @@ CDXLNode::SerializeToDXL
 	)
 	const
 {
+	BOOL fSerialized = false;
+	const ULONG ulSharedId = pxmlser->UlSharedId(this, &fSerialized);
+	if (gpos::ulong_max != ulSharedId)
+	{
+		// wrap the first occurrence of a shared subtree in an element carrying
+		// its id, and only refer to the id afterwards
+		const CWStringConst *pstrElemName = CDXLTokens::PstrToken(EdxltokenScalarShared);
+		pxmlser->OpenElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix), pstrElemName);
+		pxmlser->AddAttribute(CDXLTokens::PstrToken(EdxltokenScalarSharedId), ulSharedId);
+		if (!fSerialized)
+		{
+			m_pdxlop->SerializeToDXL(pxmlser, this);
+		}
+		pxmlser->CloseElement(CDXLTokens::PstrToken(EdxltokenNamespacePrefix), pstrElemName);
+
+		return;
+	}
+
 	if (NULL != m_pdxlop)
 	{
 		m_pdxlop->SerializeToDXL(pxmlser, this);
@@ -309,6 +329,51 @@ CDXLNode::SerializeChildrenToDXL
 	}
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLNode::FShareable
+//
+//	@doc:
+//		Is the node a scalar expression that may be serialized once and
+//		referred to from all its parents; these are the operators with
+//		children that are parsed wherever a generic scalar is expected
+//
+//---------------------------------------------------------------------------
+BOOL
+CDXLNode::FShareable() const
+{
+	if (NULL == m_pdxlop || 0 == UlArity())
+	{
+		return false;
+	}
+
+	switch (m_pdxlop->Edxlop())
+	{
+		case EdxlopScalarCmp:
+		case EdxlopScalarDistinct:
+		case EdxlopScalarOpExpr:
+		case EdxlopScalarBoolExpr:
+		case EdxlopScalarFuncExpr:
+		case EdxlopScalarCast:
+		case EdxlopScalarCoerceToDomain:
+		case EdxlopScalarCoerceViaIO:
+		case EdxlopScalarArrayCoerceExpr:
+		case EdxlopScalarNullTest:
+		case EdxlopScalarNullIf:
+		case EdxlopScalarBooleanTest:
+		case EdxlopScalarArrayComp:
+		case EdxlopScalarArray:
+		case EdxlopScalarCoalesce:
+		case EdxlopScalarMinMax:
+		case EdxlopScalarIfStmt:
+		case EdxlopScalarSwitch:
+			return true;
+
+		default:
+			return false;
+	}
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CDXLNode::SetProperties
@@ -14,6 +14,7 @@
 #include "naucrates/dxl/parser/CParseHandlerCostParams.h"
 #include "naucrates/dxl/parser/CParseHandlerFactory.h"
 #include "naucrates/dxl/parser/CParseHandlerManager.h"
+#include "naucrates/dxl/operators/CDXLOperatorFactory.h"
 
 #include "gpdbcost/CCostModelParamsGPDB.h"
 
@@ -74,6 +75,28 @@ CParseHandlerCostParams::StartElement
 {
 	if (0 == XMLString::compareString(CDXLTokens::XmlstrToken(EdxltokenCostParams), xmlstrLocalname))
 	{
+		// reject calibration files written for a newer parameter set; files
+		// without a version predate versioning and are read as the current one
+		ULONG ulVersion = CDXLOperatorFactory::UlValueFromAttrs
+							(
+							m_pphm->Pmm(),
+							attrs,
+							EdxltokenVersion,
+							EdxltokenCostParams,
+							true /*fOptional*/,
+							CCostModelParamsGPDB::ulCalibrationVersion
+							);
+		if (CCostModelParamsGPDB::ulCalibrationVersion < ulVersion)
+		{
+			GPOS_RAISE
+				(
+				gpdxl::ExmaDXL,
+				gpdxl::ExmiDXLInvalidAttributeValue,
+				CDXLTokens::PstrToken(EdxltokenVersion)->Wsz(),
+				CDXLTokens::PstrToken(EdxltokenCostParams)->Wsz()
+				);
+		}
+
 		// as of now, we only parse params of GPDB cost model
 		m_pcp = GPOS_NEW(m_pmp) CCostModelParamsGPDB(m_pmp);
 	}
@@ -124,6 +147,17 @@ CParseHandlerCostParams::EndElement
 	for (ULONG ul = 0; ul < ulSize; ul++)
 	{
 		CParseHandlerCostParam *pphCostParam = dynamic_cast<CParseHandlerCostParam*>((*this)[ul]);
+		if (NULL == m_pcp->PcpLookup(pphCostParam->SzName()))
+		{
+			// a misspelled param would otherwise silently keep its default
+			GPOS_RAISE
+				(
+				gpdxl::ExmaDXL,
+				gpdxl::ExmiDXLInvalidAttributeValue,
+				CDXLTokens::PstrToken(EdxltokenName)->Wsz(),
+				CDXLTokens::PstrToken(EdxltokenCostParam)->Wsz()
+				);
+		}
 		m_pcp->SetParam(pphCostParam->SzName(), pphCostParam->DVal(), pphCostParam->DLowerBound(), pphCostParam->DUpperBound());
 	}
 
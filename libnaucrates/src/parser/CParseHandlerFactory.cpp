@@ -276,6 +276,7 @@ CParseHandlerFactory::Init
 
 			{EdxltokenScalarExpr, &PphScalarExpr},
 			{EdxltokenScalarValuesList, &PphScalarValuesList},
+			{EdxltokenScalarShared, &PphScalarShared},
 			{EdxltokenPhysicalValuesScan, &PphValuesScan}
 
 	};
@@ -2403,6 +2404,18 @@ CParseHandlerFactory::PphScalarValuesList
 	return GPOS_NEW(pmp) CParseHandlerScalarValuesList(pmp, pphm, pphRoot);
 }
 
+// creates a parse handler for parsing a shared scalar subtree
+CParseHandlerBase *
+CParseHandlerFactory::PphScalarShared
+	(
+	IMemoryPool *pmp,
+	CParseHandlerManager *pphm,
+	CParseHandlerBase *pphRoot
+	)
+{
+	return GPOS_NEW(pmp) CParseHandlerScalarShared(pmp, pphm, pphRoot);
+}
+
 // creates a parse handler for parsing a Values Scan operator
 CParseHandlerBase *
 CParseHandlerFactory::PphValuesScan
@@ -38,6 +38,7 @@ CParseHandlerManager::CParseHandlerManager
 	m_ulIterLastCFA(0)
 {
 	m_pphstack = GPOS_NEW(pmm->Pmp()) PHStack(pmm->Pmp());
+	m_phmuldxlnShared = GPOS_NEW(pmm->Pmp()) HMUlPdxln(pmm->Pmp());
 }
 
 //---------------------------------------------------------------------------
@@ -51,6 +52,7 @@ CParseHandlerManager::CParseHandlerManager
 CParseHandlerManager::~CParseHandlerManager()
 {
 	GPOS_DELETE(m_pphstack);
+	m_phmuldxlnShared->Release();
 }
 
 
@@ -176,4 +178,49 @@ CParseHandlerManager::CheckForAborts()
 	}
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CParseHandlerManager::RegisterSharedScalar
+//
+//	@doc:
+//		Register a shared scalar subtree under the given id, so that later
+//		references to the id resolve to the same node
+//
+//---------------------------------------------------------------------------
+void
+CParseHandlerManager::RegisterSharedScalar
+	(
+	ULONG ulId,
+	CDXLNode *pdxln
+	)
+{
+	GPOS_ASSERT(NULL != pdxln);
+	GPOS_ASSERT(NULL == PdxlnSharedScalar(ulId));
+
+	pdxln->AddRef();
+#ifdef GPOS_DEBUG
+	BOOL fInserted =
+#endif // GPOS_DEBUG
+		m_phmuldxlnShared->FInsert(GPOS_NEW(m_pmm->Pmp()) ULONG(ulId), pdxln);
+	GPOS_ASSERT(fInserted);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CParseHandlerManager::PdxlnSharedScalar
+//
+//	@doc:
+//		Shared scalar subtree with the given id
+//
+//---------------------------------------------------------------------------
+CDXLNode *
+CParseHandlerManager::PdxlnSharedScalar
+	(
+	ULONG ulId
+	)
+	const
+{
+	return m_phmuldxlnShared->PtLookup(&ulId);
+}
+
 // EOF
@@ -0,0 +1,135 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2018 Pivotal, Inc.
+//
+//	@filename:
+//		CParseHandlerScalarShared.cpp
+//
+//	@doc:
+//
+//		Implementation of the SAX parse handler class for shared scalar
+//		subtrees
+//---------------------------------------------------------------------------
+
+
+#include "naucrates/dxl/parser/CParseHandlerFactory.h"
+#include "naucrates/dxl/CDXLUtils.h"
+#include "naucrates/dxl/operators/CDXLOperatorFactory.h"
+#include "naucrates/dxl/parser/CParseHandlerScalarShared.h"
+
+
+using namespace gpdxl;
+
+XERCES_CPP_NAMESPACE_USE
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CParseHandlerScalarShared::CParseHandlerScalarShared
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+CParseHandlerScalarShared::CParseHandlerScalarShared
+	(
+	IMemoryPool *pmp,
+	CParseHandlerManager *pphm,
+	CParseHandlerBase *pphRoot
+	)
+	:
+	CParseHandlerScalarOp(pmp, pphm, pphRoot),
+	m_ulId(gpos::ulong_max)
+{
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CParseHandlerScalarShared::StartElement
+//
+//	@doc:
+//		Processes a Xerces start element event
+//
+//---------------------------------------------------------------------------
+void
+CParseHandlerScalarShared::StartElement
+	(
+	const XMLCh* const xmlszUri,
+	const XMLCh* const xmlszLocalname,
+	const XMLCh* const xmlszQname,
+	const Attributes& attrs
+	)
+{
+	if (0 == XMLString::compareString(CDXLTokens::XmlstrToken(EdxltokenScalarShared), xmlszLocalname) && gpos::ulong_max == m_ulId)
+	{
+		// parse id
+		m_ulId = CDXLOperatorFactory::UlValueFromAttrs(m_pphm->Pmm(), attrs, EdxltokenScalarSharedId, EdxltokenScalarShared);
+		return;
+	}
+
+	// only the first occurrence of a shared subtree has a single child
+	if (0 < this->UlLength() || NULL != m_pphm->PdxlnSharedScalar(m_ulId))
+	{
+		CWStringDynamic *pstr = CDXLUtils::PstrFromXMLCh(m_pphm->Pmm(), xmlszLocalname);
+		GPOS_RAISE(gpdxl::ExmaDXL, gpdxl::ExmiDXLUnexpectedTag, pstr->Wsz());
+	}
+
+	// parse scalar child
+	CParseHandlerBase *pphChild = CParseHandlerFactory::Pph(m_pmp, CDXLTokens::XmlstrToken(EdxltokenScalar), m_pphm, this);
+	m_pphm->ActivateParseHandler(pphChild);
+
+	// store parse handlers
+	this->Append(pphChild);
+
+	pphChild->startElement(xmlszUri, xmlszLocalname, xmlszQname, attrs);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CParseHandlerScalarShared::EndElement
+//
+//	@doc:
+//		Invoked by Xerces to process a closing tag
+//
+//---------------------------------------------------------------------------
+void
+CParseHandlerScalarShared::EndElement
+	(
+	const XMLCh* const ,// xmlszUri
+	const XMLCh* const xmlszLocalname,
+	const XMLCh* const // xmlszQname
+	)
+{
+	if (0 != XMLString::compareString(CDXLTokens::XmlstrToken(EdxltokenScalarShared), xmlszLocalname))
+	{
+		CWStringDynamic *pstr = CDXLUtils::PstrFromXMLCh(m_pphm->Pmm(), xmlszLocalname);
+		GPOS_RAISE(gpdxl::ExmaDXL, gpdxl::ExmiDXLUnexpectedTag, pstr->Wsz());
+	}
+
+	if (0 == this->UlLength())
+	{
+		// a reference to a subtree parsed before
+		m_pdxln = m_pphm->PdxlnSharedScalar(m_ulId);
+		if (NULL == m_pdxln)
+		{
+			GPOS_RAISE
+				(
+				gpdxl::ExmaDXL,
+				gpdxl::ExmiDXLInvalidAttributeValue,
+				CDXLTokens::PstrToken(EdxltokenScalarSharedId)->Wsz(),
+				CDXLTokens::PstrToken(EdxltokenScalarShared)->Wsz()
+				);
+		}
+	}
+	else
+	{
+		CParseHandlerScalarOp *pphChild = dynamic_cast<CParseHandlerScalarOp *>((*this)[0]);
+		m_pdxln = pphChild->Pdxln();
+		m_pphm->RegisterSharedScalar(m_ulId, m_pdxln);
+	}
+	m_pdxln->AddRef();
+
+	// deactivate handler
+	m_pphm->DeactivateHandler();
+}
+
+//EOF
@@ -17,6 +17,7 @@
 #include "gpos/io/COstreamString.h"
 #include "gpos/string/CWStringDynamic.h"
 #include "gpos/common/syslibwrapper.h"
+#include "gpos/sync/atomic.h"
 
 #include "naucrates/statistics/CStatistics.h"
 #include "naucrates/statistics/CStatisticsUtils.h"
@@ -50,6 +51,9 @@ const CDouble CHistogram::DDefaultNDVFreqRemain(0.0);
 // sample size used to estimate skew
 #define GPOPT_SKEW_SAMPLE_SIZE 1000
 
+// minimum number of buckets for which bucket lookups use columnar bounds
+#define GPOPT_HIST_BOUNDS_MIN_BUCKETS 8
+
 // ctor
 CHistogram::CHistogram
 	(
@@ -65,7 +69,8 @@ CHistogram::CHistogram
 	m_fSkewMeasured(false),
 	m_dSkew(1.0),
 	m_fNDVScaled(false),
-	m_fColStatsMissing(false)
+	m_fColStatsMissing(false),
+	m_phb(NULL)
 {
 	GPOS_ASSERT(NULL != pdrgppbucket);
 }
@@ -89,7 +94,8 @@ CHistogram::CHistogram
 	m_fSkewMeasured(false),
 	m_dSkew(1.0),
 	m_fNDVScaled(false),
-	m_fColStatsMissing(fColStatsMissing)
+	m_fColStatsMissing(fColStatsMissing),
+	m_phb(NULL)
 {
 	GPOS_ASSERT(m_pdrgppbucket);
 	GPOS_ASSERT(CDouble(0.0) <= dNullFreq);
@@ -160,6 +166,67 @@ CHistogram::FEmpty
 	return (0 == m_pdrgppbucket->UlLength() && CStatistics::DEpsilon > m_dNullFreq && CStatistics::DEpsilon > m_dDistinctRemain);
 }
 
+// columnar bucket bounds; histograms may be shared by concurrent stats
+// derivation jobs, so the first builder publishes its copy atomically
+const CHistogramBounds *
+CHistogram::Phb() const
+{
+	CHistogramBounds *phb = *(CHistogramBounds * volatile *) &m_phb;
+	if (NULL != phb)
+	{
+		return phb;
+	}
+
+	// bounds live as long as the buckets, so use the buckets' pool
+	IMemoryPool *pmp = m_pdrgppbucket->Pmp();
+	phb = GPOS_NEW(pmp) CHistogramBounds(pmp, m_pdrgppbucket);
+	if (!FCompareSwap<CHistogramBounds>((volatile CHistogramBounds **) &m_phb, NULL, phb))
+	{
+		GPOS_DELETE(phb);
+		phb = m_phb;
+	}
+
+	GPOS_ASSERT(phb->UlBuckets() == m_pdrgppbucket->UlLength());
+
+	return phb;
+}
+
+// find the first bucket which is not entirely below the given point, and
+// check if it contains the point, by binary search over the columnar bounds;
+// returns false if the histogram is too small or its bounds or the point
+// must be compared as datums
+BOOL
+CHistogram::FLocatePoint
+	(
+	const CPoint *ppoint,
+	ULONG *pulBucketIdx,
+	BOOL *pfContains
+	)
+	const
+{
+	GPOS_ASSERT(NULL != ppoint);
+	GPOS_ASSERT(NULL != pulBucketIdx);
+	GPOS_ASSERT(NULL != pfContains);
+
+	if (GPOPT_HIST_BOUNDS_MIN_BUCKETS > m_pdrgppbucket->UlLength())
+	{
+		return false;
+	}
+
+	const CHistogramBounds *phb = Phb();
+	CHistogramBounds::SKey key;
+	if (!phb->FMapPoint(ppoint, &key))
+	{
+		return false;
+	}
+
+	*pulBucketIdx = phb->UlFirstNotBelow(key);
+	*pfContains = (*pulBucketIdx < phb->UlBuckets() && phb->FContains(*pulBucketIdx, key));
+	GPOS_ASSERT(*pfContains == (*pulBucketIdx < phb->UlBuckets() && (*m_pdrgppbucket)[*pulBucketIdx]->FContains(ppoint)));
+
+	return true;
+}
+
 // construct new histogram with less than or less than equal to filter
 CHistogram *
 CHistogram::PhistLessThanOrLessThanEqual
@@ -175,26 +242,48 @@ CHistogram::PhistLessThanOrLessThanEqual
 	DrgPbucket *pdrgppbucketNew = GPOS_NEW(pmp) DrgPbucket(pmp);
 	const ULONG ulNumBuckets = m_pdrgppbucket->UlLength();
 
-	for (ULONG ulBucketIdx = 0; ulBucketIdx < ulNumBuckets; ulBucketIdx++)
+	ULONG ulBucketFirst = 0;
+	BOOL fContains = false;
+	if (FLocatePoint(ppoint, &ulBucketFirst, &fContains))
 	{
-		CBucket *pbucket = (*m_pdrgppbucket)[ulBucketIdx];
-		if (pbucket->FBefore(ppoint))
+		// buckets below the point are kept as they are
+		for (ULONG ulBucketIdx = 0; ulBucketIdx < ulBucketFirst; ulBucketIdx++)
 		{
-			break;
+			pdrgppbucketNew->Append((*m_pdrgppbucket)[ulBucketIdx]->PbucketCopy(pmp));
 		}
-		else if (pbucket->FAfter(ppoint))
-		{
-			pdrgppbucketNew->Append(pbucket->PbucketCopy(pmp));
-		}
-		else
+
+		if (fContains)
 		{
-			GPOS_ASSERT(pbucket->FContains(ppoint));
-			CBucket *pbucketLast = pbucket->PbucketScaleUpper(pmp, ppoint, CStatsPred::EstatscmptLEq == escmpt /*fIncludeUpper*/);
+			CBucket *pbucketLast = (*m_pdrgppbucket)[ulBucketFirst]->PbucketScaleUpper(pmp, ppoint, CStatsPred::EstatscmptLEq == escmpt /*fIncludeUpper*/);
 			if (NULL != pbucketLast)
 			{
 				pdrgppbucketNew->Append(pbucketLast);
 			}
-			break;
+		}
+	}
+	else
+	{
+		for (ULONG ulBucketIdx = 0; ulBucketIdx < ulNumBuckets; ulBucketIdx++)
+		{
+			CBucket *pbucket = (*m_pdrgppbucket)[ulBucketIdx];
+			if (pbucket->FBefore(ppoint))
+			{
+				break;
+			}
+			else if (pbucket->FAfter(ppoint))
+			{
+				pdrgppbucketNew->Append(pbucket->PbucketCopy(pmp));
+			}
+			else
+			{
+				GPOS_ASSERT(pbucket->FContains(ppoint));
+				CBucket *pbucketLast = pbucket->PbucketScaleUpper(pmp, ppoint, CStatsPred::EstatscmptLEq == escmpt /*fIncludeUpper*/);
+				if (NULL != pbucketLast)
+				{
+					pdrgppbucketNew->Append(pbucketLast);
+				}
+				break;
+			}
 		}
 	}
 
@@ -230,11 +319,22 @@ CHistogram::PdrgppbucketNEqual
 	const ULONG ulNumBuckets = m_pdrgppbucket->UlLength();
 	bool fPointNull = ppoint->Pdatum()->FNull();
 
+	// at most one bucket contains the point; when the columnar bounds can
+	// locate it, the other buckets need not be compared with the point
+	ULONG ulBucketContains = gpos::ulong_max;
+	BOOL fContains = false;
+	BOOL fLocated = FLocatePoint(ppoint, &ulBucketContains, &fContains);
+	if (fLocated && !fContains)
+	{
+		ulBucketContains = gpos::ulong_max;
+	}
+
 	for (ULONG ulBucketIdx = 0; ulBucketIdx < ulNumBuckets; ulBucketIdx++)
 	{
 		CBucket *pbucket = (*m_pdrgppbucket)[ulBucketIdx];
 
-		if (pbucket->FContains(ppoint) && !fPointNull)
+		BOOL fBucketContains = fLocated ? (ulBucketIdx == ulBucketContains) : pbucket->FContains(ppoint);
+		if (fBucketContains && !fPointNull)
 		{
 			CBucket *pbucketLT = pbucket->PbucketScaleUpper(pmp, ppoint, false /*fIncludeUpper */);
 			if (NULL != pbucketLT)
@@ -316,7 +416,15 @@ CHistogram::PdrgppbucketEqual
 	const ULONG ulNumBuckets = m_pdrgppbucket->UlLength();
 	ULONG ulBucketIdx = 0;
 
-	for (ulBucketIdx = 0; ulBucketIdx < ulNumBuckets; ulBucketIdx++)
+	// start at the only bucket that may contain the point if the columnar
+	// bounds can locate it
+	BOOL fContains = false;
+	if (FLocatePoint(ppoint, &ulBucketIdx, &fContains) && !fContains)
+	{
+		return pdrgppbucket;
+	}
+
+	for (; ulBucketIdx < ulNumBuckets; ulBucketIdx++)
 	{
 		CBucket *pbucket = (*m_pdrgppbucket)[ulBucketIdx];
 
@@ -438,16 +546,19 @@ CHistogram::PhistGreaterThanOrGreaterThanEqual
 	DrgPbucket *pdrgppbucketNew = GPOS_NEW(pmp) DrgPbucket(pmp);
 	const ULONG ulNumBuckets = m_pdrgppbucket->UlLength();
 
-	// find first bucket that contains ppoint
+	// find first bucket that contains ppoint; buckets below the point are
+	// skipped by binary search if the columnar bounds can locate the point
 	ULONG ulBucketIdx = 0;
-	for (ulBucketIdx = 0; ulBucketIdx < ulNumBuckets; ulBucketIdx++)
+	BOOL fContains = false;
+	BOOL fLocated = FLocatePoint(ppoint, &ulBucketIdx, &fContains);
+	for (; ulBucketIdx < ulNumBuckets; ulBucketIdx++)
 	{
 		CBucket *pbucket = (*m_pdrgppbucket)[ulBucketIdx];
-		if (pbucket->FBefore(ppoint))
+		if (fLocated ? !fContains : pbucket->FBefore(ppoint))
 		{
 			break;
 		}
-		if (pbucket->FContains(ppoint))
+		if (fLocated || pbucket->FContains(ppoint))
 		{
 			if (CStatsPred::EstatscmptGEq == escmpt)
 			{
@@ -1106,9 +1217,40 @@ CHistogram::PhistJoinEquality
 		return PhistJoinEqualityNDV(pmp, phist);
 	}
 
+	// if both histograms have columnar bounds of the same kind, runs of
+	// buckets that lie entirely before the current bucket of the other
+	// histogram are skipped by binary search
+	const CHistogramBounds *phb1 = NULL;
+	const CHistogramBounds *phb2 = NULL;
+	if (GPOPT_HIST_BOUNDS_MIN_BUCKETS <= ulBuckets1 + ulBuckets2 && 0 < ulBuckets1 && 0 < ulBuckets2)
+	{
+		phb1 = Phb();
+		phb2 = phist->Phb();
+		if (!phb1->FMapped() || phb1->Ebk() != phb2->Ebk())
+		{
+			phb1 = NULL;
+			phb2 = NULL;
+		}
+	}
+
 	DrgPbucket *pdrgppbucketJoin = GPOS_NEW(pmp) DrgPbucket(pmp);
 	while (ul1 < ulBuckets1 && ul2 < ulBuckets2)
 	{
+		if (NULL != phb1)
+		{
+			if (phb1->FUpperLessThanLower(ul1, phb2, ul2))
+			{
+				ul1 = phb1->UlFirstUpperNotLessThanLower(ul1 + 1, phb2, ul2);
+				continue;
+			}
+
+			if (phb2->FUpperLessThanLower(ul2, phb1, ul1))
+			{
+				ul2 = phb2->UlFirstUpperNotLessThanLower(ul2 + 1, phb1, ul1);
+				continue;
+			}
+		}
+
 		CBucket *pbucket1 = (*m_pdrgppbucket)[ul1];
 		CBucket *pbucket2 = (*phist->m_pdrgppbucket)[ul2];
 
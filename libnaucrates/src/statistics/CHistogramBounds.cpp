@@ -0,0 +1,446 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2018 Pivotal, Inc.
+//
+//	@filename:
+//		CHistogramBounds.cpp
+//
+//	@doc:
+//		Implementation of columnar histogram bucket bounds
+//---------------------------------------------------------------------------
+
+#include "gpos/base.h"
+#include "naucrates/base/IDatumStatisticsMappable.h"
+#include "naucrates/statistics/CHistogramBounds.h"
+
+using namespace gpnaucrates;
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CHistogramBounds::CHistogramBounds
+//
+//	@doc:
+//		Ctor
+//
+//---------------------------------------------------------------------------
+CHistogramBounds::CHistogramBounds
+	(
+	IMemoryPool *pmp,
+	const DrgPbucket *pdrgpbucket
+	)
+	:
+	m_ebk(EbkUnmapped),
+	m_ulBuckets(pdrgpbucket->UlLength()),
+	m_rglLower(NULL),
+	m_rglUpper(NULL),
+	m_rgdLower(NULL),
+	m_rgdUpper(NULL),
+	m_rgfLowerClosed(NULL),
+	m_rgfUpperClosed(NULL)
+{
+	GPOS_ASSERT(NULL != pdrgpbucket);
+
+	if (!FMap(pmp, pdrgpbucket))
+	{
+		m_ebk = EbkUnmapped;
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CHistogramBounds::~CHistogramBounds
+//
+//	@doc:
+//		Dtor
+//
+//---------------------------------------------------------------------------
+CHistogramBounds::~CHistogramBounds()
+{
+	GPOS_DELETE_ARRAY(m_rglLower);
+	GPOS_DELETE_ARRAY(m_rglUpper);
+	GPOS_DELETE_ARRAY(m_rgdLower);
+	GPOS_DELETE_ARRAY(m_rgdUpper);
+	GPOS_DELETE_ARRAY(m_rgfLowerClosed);
+	GPOS_DELETE_ARRAY(m_rgfUpperClosed);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CHistogramBounds::EbkDatum
+//
+//	@doc:
+//		Kind of mapping under which the datum compares exactly like
+//		IDatumStatisticsMappable does; datums with LINT mapping compare by
+//		it, datums with only a double mapping compare by that, while nulls
+//		and datums compared by their bytes are left unmapped
+//
+//---------------------------------------------------------------------------
+CHistogramBounds::EBoundKind
+CHistogramBounds::EbkDatum
+	(
+	const IDatum *pdatum
+	)
+{
+	const IDatumStatisticsMappable *pdatumsm = dynamic_cast<const IDatumStatisticsMappable *>(pdatum);
+	if (NULL == pdatumsm || pdatumsm->FNull() || pdatumsm->FSupportsBinaryComp(pdatumsm))
+	{
+		return EbkUnmapped;
+	}
+
+	if (pdatumsm->FHasStatsLINTMapping())
+	{
+		return EbkLint;
+	}
+
+	if (pdatumsm->FHasStatsDoubleMapping())
+	{
+		return EbkDouble;
+	}
+
+	return EbkUnmapped;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CHistogramBounds::MapDatum
+//
+//	@doc:
+//		Map a datum of the given kind
+//
+//---------------------------------------------------------------------------
+void
+CHistogramBounds::MapDatum
+	(
+	const IDatum *pdatum,
+	EBoundKind ebk,
+	SKey *pkey
+	)
+{
+	GPOS_ASSERT(ebk == EbkDatum(pdatum));
+
+	const IDatumStatisticsMappable *pdatumsm = dynamic_cast<const IDatumStatisticsMappable *>(pdatum);
+	pkey->m_l = 0;
+	pkey->m_d = 0.0;
+	if (EbkLint == ebk)
+	{
+		pkey->m_l = pdatumsm->LStatsMapping();
+	}
+	else
+	{
+		pkey->m_d = pdatumsm->DStatsMapping().DVal();
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CHistogramBounds::ICompare
+//
+//	@doc:
+//		Compare the mapped value at the given position to a key; doubles
+//		compare as CDouble, like datum comparison does
+//
+//---------------------------------------------------------------------------
+INT
+CHistogramBounds::ICompare
+	(
+	EBoundKind ebk,
+	const LINT *rgl,
+	const DOUBLE *rgd,
+	ULONG ul,
+	const SKey &key
+	)
+{
+	if (EbkLint == ebk)
+	{
+		if (rgl[ul] == key.m_l)
+		{
+			return 0;
+		}
+
+		return (rgl[ul] < key.m_l) ? -1 : 1;
+	}
+
+	GPOS_ASSERT(EbkDouble == ebk);
+
+	CDouble d(rgd[ul]);
+	CDouble dKey(key.m_d);
+	if (d == dKey)
+	{
+		return 0;
+	}
+
+	return (d < dKey) ? -1 : 1;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CHistogramBounds::FMap
+//
+//	@doc:
+//		Map the bounds of the given buckets; returns false if some bound
+//		cannot be mapped, the bounds map to different kinds, or the buckets
+//		are not sorted and disjoint
+//
+//---------------------------------------------------------------------------
+BOOL
+CHistogramBounds::FMap
+	(
+	IMemoryPool *pmp,
+	const DrgPbucket *pdrgpbucket
+	)
+{
+	if (0 == m_ulBuckets)
+	{
+		return false;
+	}
+
+	EBoundKind ebk = EbkDatum((*pdrgpbucket)[0]->PpLower()->Pdatum());
+	if (EbkUnmapped == ebk)
+	{
+		return false;
+	}
+
+	for (ULONG ul = 0; ul < m_ulBuckets; ul++)
+	{
+		CBucket *pbucket = (*pdrgpbucket)[ul];
+		if (ebk != EbkDatum(pbucket->PpLower()->Pdatum()) || ebk != EbkDatum(pbucket->PpUpper()->Pdatum()))
+		{
+			return false;
+		}
+	}
+
+	m_ebk = ebk;
+	if (EbkLint == ebk)
+	{
+		m_rglLower = GPOS_NEW_ARRAY(pmp, LINT, m_ulBuckets);
+		m_rglUpper = GPOS_NEW_ARRAY(pmp, LINT, m_ulBuckets);
+	}
+	else
+	{
+		m_rgdLower = GPOS_NEW_ARRAY(pmp, DOUBLE, m_ulBuckets);
+		m_rgdUpper = GPOS_NEW_ARRAY(pmp, DOUBLE, m_ulBuckets);
+	}
+	m_rgfLowerClosed = GPOS_NEW_ARRAY(pmp, BOOL, m_ulBuckets);
+	m_rgfUpperClosed = GPOS_NEW_ARRAY(pmp, BOOL, m_ulBuckets);
+
+	for (ULONG ul = 0; ul < m_ulBuckets; ul++)
+	{
+		CBucket *pbucket = (*pdrgpbucket)[ul];
+		SKey keyLower;
+		SKey keyUpper;
+		MapDatum(pbucket->PpLower()->Pdatum(), ebk, &keyLower);
+		MapDatum(pbucket->PpUpper()->Pdatum(), ebk, &keyUpper);
+
+		if (EbkLint == ebk)
+		{
+			m_rglLower[ul] = keyLower.m_l;
+			m_rglUpper[ul] = keyUpper.m_l;
+		}
+		else
+		{
+			m_rgdLower[ul] = keyLower.m_d;
+			m_rgdUpper[ul] = keyUpper.m_d;
+		}
+		m_rgfLowerClosed[ul] = pbucket->FLowerClosed();
+		m_rgfUpperClosed[ul] = pbucket->FUpperClosed();
+
+		// bounds must be ordered, and singletons closed
+		INT iRes = ICompare(ebk, m_rglLower, m_rgdLower, ul, keyUpper);
+		if (0 < iRes || (0 == iRes && !(m_rgfLowerClosed[ul] && m_rgfUpperClosed[ul])))
+		{
+			return false;
+		}
+
+		// buckets must not overlap the previous one, not even in one point
+		if (0 < ul)
+		{
+			iRes = ICompare(ebk, m_rglUpper, m_rgdUpper, ul - 1, keyLower);
+			if (0 < iRes || (0 == iRes && m_rgfUpperClosed[ul - 1] && m_rgfLowerClosed[ul]))
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CHistogramBounds::FMapPoint
+//
+//	@doc:
+//		Map a point for lookups; returns false if the point does not compare
+//		to the bounds by the same mapping
+//
+//---------------------------------------------------------------------------
+BOOL
+CHistogramBounds::FMapPoint
+	(
+	const CPoint *ppoint,
+	SKey *pkey
+	)
+	const
+{
+	GPOS_ASSERT(NULL != ppoint);
+
+	if (!FMapped() || m_ebk != EbkDatum(ppoint->Pdatum()))
+	{
+		return false;
+	}
+
+	MapDatum(ppoint->Pdatum(), m_ebk, pkey);
+
+	return true;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CHistogramBounds::UlFirstNotBelow
+//
+//	@doc:
+//		Binary search for the first bucket that is not entirely below the
+//		point, i.e. the first bucket for which CBucket::FAfter is false;
+//		since buckets are sorted, FAfter holds for a prefix of the buckets
+//
+//---------------------------------------------------------------------------
+ULONG
+CHistogramBounds::UlFirstNotBelow
+	(
+	const SKey &key
+	)
+	const
+{
+	GPOS_ASSERT(FMapped());
+
+	ULONG ulLow = 0;
+	ULONG ulHigh = m_ulBuckets;
+	while (ulLow < ulHigh)
+	{
+		ULONG ulMid = ulLow + (ulHigh - ulLow) / 2;
+		INT iRes = ICompare(m_ebk, m_rglUpper, m_rgdUpper, ulMid, key);
+		if (0 > iRes || (0 == iRes && !m_rgfUpperClosed[ulMid]))
+		{
+			ulLow = ulMid + 1;
+		}
+		else
+		{
+			ulHigh = ulMid;
+		}
+	}
+
+	return ulLow;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CHistogramBounds::FContains
+//
+//	@doc:
+//		Does the given bucket contain the point; same as CBucket::FContains
+//
+//---------------------------------------------------------------------------
+BOOL
+CHistogramBounds::FContains
+	(
+	ULONG ulBucket,
+	const SKey &key
+	)
+	const
+{
+	GPOS_ASSERT(FMapped());
+	GPOS_ASSERT(ulBucket < m_ulBuckets);
+
+	INT iResLower = ICompare(m_ebk, m_rglLower, m_rgdLower, ulBucket, key);
+	INT iResUpper = ICompare(m_ebk, m_rglUpper, m_rgdUpper, ulBucket, key);
+
+	if (0 == iResLower)
+	{
+		return m_rgfLowerClosed[ulBucket];
+	}
+
+	if (0 == iResUpper)
+	{
+		return m_rgfUpperClosed[ulBucket];
+	}
+
+	return 0 > iResLower && 0 < iResUpper;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CHistogramBounds::FUpperLessThanLower
+//
+//	@doc:
+//		Is the upper bound of the given bucket strictly less than the lower
+//		bound of a bucket of another histogram; such buckets do not
+//		intersect, and the first one is before the second
+//
+//---------------------------------------------------------------------------
+BOOL
+CHistogramBounds::FUpperLessThanLower
+	(
+	ULONG ulBucket,
+	const CHistogramBounds *phbOther,
+	ULONG ulBucketOther
+	)
+	const
+{
+	GPOS_ASSERT(FMapped());
+	GPOS_ASSERT(m_ebk == phbOther->m_ebk);
+	GPOS_ASSERT(ulBucket < m_ulBuckets);
+	GPOS_ASSERT(ulBucketOther < phbOther->m_ulBuckets);
+
+	SKey key;
+	key.m_l = (EbkLint == m_ebk) ? phbOther->m_rglLower[ulBucketOther] : 0;
+	key.m_d = (EbkDouble == m_ebk) ? phbOther->m_rgdLower[ulBucketOther] : 0.0;
+
+	return 0 > ICompare(m_ebk, m_rglUpper, m_rgdUpper, ulBucket, key);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CHistogramBounds::UlFirstUpperNotLessThanLower
+//
+//	@doc:
+//		Binary search for the first bucket at or after the given one whose
+//		upper bound is not strictly less than the lower bound of a bucket of
+//		another histogram; upper bounds are non-decreasing
+//
+//---------------------------------------------------------------------------
+ULONG
+CHistogramBounds::UlFirstUpperNotLessThanLower
+	(
+	ULONG ulStart,
+	const CHistogramBounds *phbOther,
+	ULONG ulBucketOther
+	)
+	const
+{
+	GPOS_ASSERT(FMapped());
+	GPOS_ASSERT(m_ebk == phbOther->m_ebk);
+	GPOS_ASSERT(ulBucketOther < phbOther->m_ulBuckets);
+
+	SKey key;
+	key.m_l = (EbkLint == m_ebk) ? phbOther->m_rglLower[ulBucketOther] : 0;
+	key.m_d = (EbkDouble == m_ebk) ? phbOther->m_rgdLower[ulBucketOther] : 0.0;
+
+	ULONG ulLow = ulStart;
+	ULONG ulHigh = m_ulBuckets;
+	while (ulLow < ulHigh)
+	{
+		ULONG ulMid = ulLow + (ulHigh - ulLow) / 2;
+		if (0 > ICompare(m_ebk, m_rglUpper, m_rgdUpper, ulMid, key))
+		{
+			ulLow = ulMid + 1;
+		}
+		else
+		{
+			ulHigh = ulMid;
+		}
+	}
+
+	return ulLow;
+}
+
+// EOF
@@ -13,6 +13,7 @@
 #include "naucrates/dxl/xml/CXMLSerializer.h"
 #include "naucrates/dxl/xml/dxltokens.h"
 #include "naucrates/dxl/CDXLUtils.h"
+#include "naucrates/dxl/operators/CDXLNode.h"
 
 using namespace gpdxl;
 
@@ -29,6 +30,8 @@ using namespace gpdxl;
 CXMLSerializer::~CXMLSerializer()
 {
 	GPOS_DELETE(m_strstackElems);
+	CRefCount::SafeRelease(m_phmdxlnulParents);
+	CRefCount::SafeRelease(m_phmdxlnulIds);
 }
 
 //---------------------------------------------------------------------------
@@ -487,4 +490,120 @@ CXMLSerializer::AddAttribute
 	}
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CXMLSerializer::ShareSubtrees
+//
+//	@doc:
+//		Serialize shareable subtrees that have several parents in the given
+//		tree only once; the first occurrence of such a subtree is wrapped in
+//		a shared scalar element carrying an id, and all further occurrences
+//		are serialized as an empty shared scalar element with that id
+//
+//---------------------------------------------------------------------------
+void
+CXMLSerializer::ShareSubtrees
+	(
+	const CDXLNode *pdxlnRoot
+	)
+{
+	GPOS_ASSERT(NULL != pdxlnRoot);
+	GPOS_ASSERT(NULL == m_phmdxlnulParents && "Shared subtrees already set");
+
+	m_phmdxlnulParents = GPOS_NEW(m_pmp) HMDxlnUl(m_pmp);
+	m_phmdxlnulIds = GPOS_NEW(m_pmp) HMDxlnUl(m_pmp);
+
+	CountParents(pdxlnRoot);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXMLSerializer::CountParents
+//
+//	@doc:
+//		Count the parents of the shareable subtrees below the given node;
+//		the children of a shareable subtree are only visited once, since
+//		the subtree is serialized only once
+//
+//---------------------------------------------------------------------------
+void
+CXMLSerializer::CountParents
+	(
+	const CDXLNode *pdxln
+	)
+{
+	GPOS_CHECK_STACK_SIZE;
+
+	const ULONG ulArity = pdxln->UlArity();
+	for (ULONG ul = 0; ul < ulArity; ul++)
+	{
+		CDXLNode *pdxlnChild = (*pdxln)[ul];
+		if (pdxlnChild->FShareable())
+		{
+			ULONG *pulParents = m_phmdxlnulParents->PtLookup(pdxlnChild);
+			if (NULL != pulParents)
+			{
+				(*pulParents)++;
+				continue;
+			}
+
+#ifdef GPOS_DEBUG
+			BOOL fInserted =
+#endif // GPOS_DEBUG
+				m_phmdxlnulParents->FInsert(pdxlnChild, GPOS_NEW(m_pmp) ULONG(1));
+			GPOS_ASSERT(fInserted);
+		}
+
+		CountParents(pdxlnChild);
+	}
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CXMLSerializer::UlSharedId
+//
+//	@doc:
+//		Id of the given subtree if it is serialized once and referred to
+//		elsewhere, and ulong_max otherwise; ids are assigned in the order in
+//		which shared subtrees are first serialized
+//
+//---------------------------------------------------------------------------
+ULONG
+CXMLSerializer::UlSharedId
+	(
+	const CDXLNode *pdxln,
+	BOOL *pfSerialized
+	)
+{
+	GPOS_ASSERT(NULL != pfSerialized);
+
+	*pfSerialized = false;
+	if (NULL == m_phmdxlnulParents)
+	{
+		return gpos::ulong_max;
+	}
+
+	const ULONG *pulParents = m_phmdxlnulParents->PtLookup(pdxln);
+	if (NULL == pulParents || 1 == *pulParents)
+	{
+		return gpos::ulong_max;
+	}
+
+	const ULONG *pulId = m_phmdxlnulIds->PtLookup(pdxln);
+	if (NULL != pulId)
+	{
+		*pfSerialized = true;
+		return *pulId;
+	}
+
+	ULONG ulId = m_phmdxlnulIds->UlEntries();
+#ifdef GPOS_DEBUG
+	BOOL fInserted =
+#endif // GPOS_DEBUG
+		m_phmdxlnulIds->FInsert(const_cast<CDXLNode *>(pdxln), GPOS_NEW(m_pmp) ULONG(ulId));
+	GPOS_ASSERT(fInserted);
+
+	return ulId;
+}
+
 // EOF
@@ -86,6 +86,8 @@ CDXLTokens::Init
 			{EdxltokenJoinOrderDPThreshold, GPOS_WSZ_LIT("JoinOrderDynamicProgThreshold")},
 			{EdxltokenBroadcastThreshold, GPOS_WSZ_LIT("BroadcastThreshold")},
 			{EdxltokenEnforceConstraintsOnDML, GPOS_WSZ_LIT("EnforceConstraintsOnDML")},
+			{EdxltokenOptimizerWorkers, GPOS_WSZ_LIT("OptimizerWorkers")},
+			{EdxltokenOptimizationDeadline, GPOS_WSZ_LIT("OptimizationDeadline")},
 			{EdxltokenWindowOids, GPOS_WSZ_LIT("WindowOids")},
 			{EdxltokenOidRowNumber, GPOS_WSZ_LIT("RowNumber")},
 			{EdxltokenOidRank, GPOS_WSZ_LIT("Rank")},
@@ -264,6 +266,8 @@ CDXLTokens::Init
 			{EdxltokenScalarSubPlanParam, GPOS_WSZ_LIT("Param")},
 			{EdxltokenScalarSubPlanTestExpr, GPOS_WSZ_LIT("TestExpr")},
 			{EdxltokenScalarValuesList, GPOS_WSZ_LIT("ValuesList")},
+			{EdxltokenScalarShared, GPOS_WSZ_LIT("SharedScalar")},
+			{EdxltokenScalarSharedId, GPOS_WSZ_LIT("Id")},
 
 			{EdxltokenValue, GPOS_WSZ_LIT("Value")},
 			{EdxltokenTypeId, GPOS_WSZ_LIT("TypeMdid")},
@@ -36,6 +36,7 @@ namespace gpdxl
 			static GPOS_RESULT EresUnittest();
 			static GPOS_RESULT EresUnittest_SerializeQuery();
 			static GPOS_RESULT EresUnittest_SerializePlan();
+			static GPOS_RESULT EresUnittest_SerializePlanUTF8();
 			static GPOS_RESULT EresUnittest_Encoding();
 
 	}; // class CDXLUtilsTest
@@ -37,6 +37,10 @@ namespace gpdxl
 			static
 			const CHAR *m_szMDRequestFile;
 
+			// plan file with a shared scalar subtree
+			static
+			const CHAR *m_szSharedScalarFile;
+
 			// files for testing parsing of different DXL nodes
 			static
 			const CHAR *m_rgszPlanDXLFileNames[];
@@ -116,6 +120,10 @@ namespace gpdxl
 			// run MD request test
 			static 
 			GPOS_RESULT EresUnittest_MDRequest();
+
+			// run shared scalar subtree test
+			static
+			GPOS_RESULT EresUnittest_SharedScalars();
 			
 			// run stats test
 			static 
@@ -46,6 +46,10 @@ namespace gpnaucrates
 			static
 			GPOS_RESULT EresUnittest_CHistogramBool();
 
+			// columnar bucket bounds tests
+			static
+			GPOS_RESULT EresUnittest_CHistogramBounds();
+
 			// skew basic tests
 			static
 			GPOS_RESULT EresUnittest_Skew();
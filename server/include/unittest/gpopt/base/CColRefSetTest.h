@@ -31,6 +31,7 @@ namespace gpopt
 			// unittests
 			static GPOS_RESULT EresUnittest();
 			static GPOS_RESULT EresUnittest_Basics();
+			static GPOS_RESULT EresUnittest_Inline();
 
 	}; // class CColRefSetTest
 }
@@ -134,6 +134,15 @@ namespace gpopt
 							CColRef *pcr
 							);
 
+			// interval from long disjunctions and conjunctions
+			static
+			GPOS_RESULT EresUnittest_CIntervalFromLongBoolOp
+							(
+							IMemoryPool *pmp,
+							CMDAccessor *pmda,
+							CColRef *pcr
+							);
+
 			// debug print
 			static void PrintConstraint (IMemoryPool *pmp, CConstraint *pcnstr);
 
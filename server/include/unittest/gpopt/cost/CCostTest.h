@@ -13,6 +13,8 @@
 
 #include "gpos/base.h"
 
+#include "gpopt/cost/ICostModel.h"
+
 
 namespace gpopt
 {
@@ -33,6 +35,18 @@ namespace gpopt
 			static
 			void TestParams(IMemoryPool *pmp, BOOL fCalibrated);
 
+			// collect physical operators of a plan
+			static
+			void CollectPhysical(CExpression *pexpr, DrgPexpr *pdrgpexpr);
+
+			// optimize a join of two tables
+			static
+			CExpression *PexprJoinPlan(IMemoryPool *pmp);
+
+			// attach handles to physical operators of a plan and create their costing info
+			static
+			void AddCostingInfo(IMemoryPool *pmp, CExpression *pexprPlan, DrgPexprhdl *pdrgpexprhdl, ICostModel::DrgPcostinfo *pdrgpci);
+
 		public:
 
 			// unittests
@@ -43,6 +57,9 @@ namespace gpopt
 			static GPOS_RESULT EresUnittest_Parsing();
 			static GPOS_RESULT EresUnittest_ParsingWithException();
 			static GPOS_RESULT EresUnittest_SetParams();
+			static GPOS_RESULT EresUnittest_Batch();
+			static GPOS_RESULT EresUnittest_CalibrationFile();
+			static GPOS_RESULT EresUnittest_Calibration();
 
 	}; // class CCostTest
 }
@@ -18,6 +18,7 @@
 #include "gpopt/base/COptimizationContext.h"
 #include "gpopt/search/CSearchStage.h"
 #include "gpopt/operators/CExpression.h"
+#include "gpopt/optimizer/COptimizerConfig.h"
 
 namespace gpopt
 {
@@ -46,6 +47,19 @@ namespace gpopt
 
 #endif // GPOS_DEBUG
 
+			// optimize expression and print resulting plan into given stream;
+			// return number of pruned group expression optimizations
+			static
+			ULONG_PTR UlpOptimizeAndPrint(IMemoryPool *pmp, CExpression *pexpr, IOstream &os);
+
+			// plan callback recording the costs of reported plans
+			static
+			void RecordPlanCost(void *pvArg, CExpression *pexprPlan);
+
+			// optimizer configuration with the given workers and deadline
+			static
+			COptimizerConfig *PoconfDeadline(IMemoryPool *pmp, ULONG ulWorkers, ULONG ulDeadline);
+
 			// counter used to mark last successful test
 			static ULONG m_ulTestCounter;
 
@@ -65,6 +79,21 @@ namespace gpopt
 			static
 			GPOS_RESULT EresUnittest_Basic();
 
+			// test that space pruning does not change plans
+			static
+			GPOS_RESULT EresUnittest_SpacePruning();
+
+			// test optimization deadline and reporting of improving plans
+			static
+			GPOS_RESULT EresUnittest_Deadline();
+
+			// test that the deadline is measured in wall clock time
+			static
+			GPOS_RESULT EresUnittest_DeadlineWorkers();
+
+			static
+			GPOS_RESULT EresUnittest_StatsCache();
+
 			// helper function for optimizing deep join trees
 			static
 			GPOS_RESULT EresOptimize
@@ -0,0 +1,87 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2018 Pivotal, Inc.
+//
+//	@filename:
+//		CConstExprEvaluatorNativeTest.h
+//
+//	@doc:
+//		Unit tests for CConstExprEvaluatorNative
+//---------------------------------------------------------------------------
+
+#ifndef GPOPT_CConstExprEvaluatorNativeTest_H
+#define GPOPT_CConstExprEvaluatorNativeTest_H
+
+#include "gpos/base.h"
+
+namespace gpopt
+{
+	// forward decl
+	class CExpression;
+	class CConstExprEvaluatorNative;
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CConstExprEvaluatorNativeTest
+	//
+	//	@doc:
+	//		Unit tests for CConstExprEvaluatorNative
+	//
+	//---------------------------------------------------------------------------
+	class CConstExprEvaluatorNativeTest
+	{
+		private:
+
+			// evaluate an expression and compare the result to the expected
+			// constant; releases both expressions
+			static
+			GPOS_RESULT EresCheck
+				(
+				CConstExprEvaluatorNative *pceeval,
+				CExpression *pexpr,
+				CExpression *pexprExpected
+				);
+
+			// int4 constant which may be NULL
+			static
+			CExpression *PexprInt4(IMemoryPool *pmp, INT iVal, BOOL fNull);
+
+			// int4 addition
+			static
+			CExpression *PexprInt4Plus(IMemoryPool *pmp, CExpression *pexprLeft, CExpression *pexprRight);
+
+		public:
+
+			// run unittests
+			static
+			GPOS_RESULT EresUnittest();
+
+			// test evaluation of arithmetic operators
+			static
+			GPOS_RESULT EresUnittest_Arithmetic();
+
+			// test evaluation of comparisons
+			static
+			GPOS_RESULT EresUnittest_Comparisons();
+
+			// test evaluation of boolean operators and tests
+			static
+			GPOS_RESULT EresUnittest_BoolOps();
+
+			// test evaluation of casts
+			static
+			GPOS_RESULT EresUnittest_Casts();
+
+			// test that unsupported expressions are left to the fallback
+			static
+			GPOS_RESULT EresUnittest_Unsupported();
+
+			// test datum comparisons evaluated without a fallback evaluator
+			static
+			GPOS_RESULT EresUnittest_Comparator();
+	};
+}
+
+#endif // !GPOPT_CConstExprEvaluatorNativeTest_H
+
+// EOF
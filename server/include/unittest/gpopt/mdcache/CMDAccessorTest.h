@@ -77,6 +77,7 @@ namespace gpopt
 			static GPOS_RESULT EresUnittest_IndexPartConstraint();
 			static GPOS_RESULT EresUnittest_Cast();
 			static GPOS_RESULT EresUnittest_ScCmp();
+			static GPOS_RESULT EresUnittest_Prefetch();
 
 			static GPOS_RESULT EresUnittest_ConcurrentAccessSingleMDA();
 			static GPOS_RESULT EresUnittest_ConcurrentAccessMultipleMDA();
@@ -47,6 +47,9 @@ namespace gpdxl
 			static GPOS_RESULT EresUnittest_Basic();
 			static GPOS_RESULT EresUnittest_Stats();
 			static GPOS_RESULT EresUnittest_Negative();
+			static GPOS_RESULT EresUnittest_Binary();
+			static GPOS_RESULT EresUnittest_BinaryTruncated();
+			static GPOS_RESULT EresUnittest_BinaryTruncatedNoLeak();
 
 
 	}; // class CMDProviderTest
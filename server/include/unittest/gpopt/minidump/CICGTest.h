@@ -41,6 +41,10 @@ namespace gpopt
 			static
 			ULONG m_ulNegativeIndexApplyTestCounter;
 
+			// counter used to mark last successful test with interned scalars
+			static
+			ULONG m_ulInternScalarsTestCounter;
+
 			// counter to mark last successful test for has joins versus index joins
 			static ULONG m_ulTestCounterPreferHashJoinToIndexJoin;
 
@@ -71,6 +75,14 @@ namespace gpopt
 
 		public:
 
+			// number of minidumps in the test corpus
+			static
+			ULONG UlMinidumps();
+
+			// file name of the minidump at the given position in the test corpus
+			static
+			const CHAR *SzMinidump(ULONG ul);
+
 			// unittests
 			static 
 			GPOS_RESULT EresUnittest();
@@ -78,6 +90,9 @@ namespace gpopt
 			static 
 			GPOS_RESULT EresUnittest_RunMinidumpTests();
 
+			static
+			GPOS_RESULT EresUnittest_RunMinidumpTestsInternScalars();
+
 			static 
 			GPOS_RESULT EresUnittest_RunUnsupportedMinidumpTests();
 
@@ -0,0 +1,52 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CMemoryPoolBenchmarkTest.h
+//
+//	@doc:
+//		Compare memory pool types on optimizing a set of minidumps
+//---------------------------------------------------------------------------
+#ifndef GPOPT_CMemoryPoolBenchmarkTest_H
+#define GPOPT_CMemoryPoolBenchmarkTest_H
+
+#include "gpos/base.h"
+#include "gpos/memory/CMemoryPoolManager.h"
+#include "gpos/string/CWStringDynamic.h"
+
+namespace gpopt
+{
+	using namespace gpos;
+
+	class CMemoryPoolBenchmarkTest
+	{
+		private:
+
+			// optimize a minidump in a new pool of the given type; returns
+			// the serialized plan, elapsed time and size allocated in the pool
+			static
+			CWStringDynamic *PstrOptimize
+				(
+				IMemoryPool *pmp,
+				CMemoryPoolManager::EAllocType eat,
+				const CHAR *szFileName,
+				ULONG *pulElapsedUS,
+				ULLONG *pullAllocated
+				);
+
+		public:
+
+			// unittests
+			static
+			GPOS_RESULT EresUnittest();
+
+			static
+			GPOS_RESULT EresUnittest_ComparePoolTypes();
+
+	}; // class CMemoryPoolBenchmarkTest
+}
+
+#endif // !GPOPT_CMemoryPoolBenchmarkTest_H
+
+// EOF
@@ -40,6 +40,9 @@ namespace gpopt
 			static
 			GPOS_RESULT EresUnittest_RunTests();
 
+			static
+			GPOS_RESULT EresUnittest_SharedScalars();
+
 	}; // class CMultilevelPartitionTest
 }
 
@@ -34,6 +34,7 @@ namespace gpopt
 			static GPOS_RESULT EresUnittest_Disjunctions();
 			static GPOS_RESULT EresUnittest_PlainEqualities();
 			static GPOS_RESULT EresUnittest_Implication();
+			static GPOS_RESULT EresUnittest_Interning();
 
 
 	}; // class CPredicateUtilsTest
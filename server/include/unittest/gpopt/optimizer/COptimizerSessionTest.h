@@ -0,0 +1,53 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2018 Pivotal, Inc.
+//
+//	@filename:
+//		COptimizerSessionTest.h
+//
+//	@doc:
+//		Tests for optimization sessions
+//---------------------------------------------------------------------------
+
+
+#ifndef GPOPT_COptimizerSessionTest_H
+#define GPOPT_COptimizerSessionTest_H
+
+#include "gpos/base.h"
+
+namespace gpopt
+{
+	using namespace gpos;
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		COptimizerSessionTest
+	//
+	//	@doc:
+	//		Static unit tests
+	//
+	//---------------------------------------------------------------------------
+	class COptimizerSessionTest
+	{
+		private:
+			// minidump used for end-to-end tests
+			static const CHAR *m_szQueryFile;
+
+			// optimize the query of the minidump a number of times in one
+			// session; returns true if all plans are the same
+			static
+			BOOL FOptimizeBatch(IMemoryPool *pmp, ULONG ulStatements, ULONG_PTR *pulpObjectsFirst, ULONG_PTR *pulpObjectsLast);
+
+		public:
+
+			// unittests
+			static GPOS_RESULT EresUnittest();
+			static GPOS_RESULT EresUnittest_Metadata();
+			static GPOS_RESULT EresUnittest_PlanCache();
+
+	}; // class COptimizerSessionTest
+}
+
+#endif // !GPOPT_COptimizerSessionTest_H
+
+// EOF
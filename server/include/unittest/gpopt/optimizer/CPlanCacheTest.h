@@ -0,0 +1,49 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CPlanCacheTest.h
+//
+//	@doc:
+//		Tests the plan cache.
+//---------------------------------------------------------------------------
+
+
+#ifndef GPOPT_CPlanCacheTest_H
+#define GPOPT_CPlanCacheTest_H
+
+#include "gpos/base.h"
+
+namespace gpopt
+{
+	using namespace gpos;
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CPlanCacheTest
+	//
+	//	@doc:
+	//		Static unit tests
+	//
+	//---------------------------------------------------------------------------
+	class CPlanCacheTest
+	{
+		private:
+			// minidump used for end-to-end tests
+			static const CHAR *m_szQueryFile;
+
+		public:
+
+			// unittests
+			static GPOS_RESULT EresUnittest();
+			static GPOS_RESULT EresUnittest_Basic();
+			static GPOS_RESULT EresUnittest_Eviction();
+			static GPOS_RESULT EresUnittest_Optimize();
+
+	}; // class CPlanCacheTest
+}
+
+#endif // !GPOPT_CPlanCacheTest_H
+
+// EOF
@@ -0,0 +1,72 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2018 Pivotal Software, Inc.
+//
+//	@filename:
+//		CSchedulerScalingTest.h
+//
+//	@doc:
+//		Scaling benchmark for multi-worker optimization
+//---------------------------------------------------------------------------
+#ifndef GPOPT_CSchedulerScalingTest_H
+#define GPOPT_CSchedulerScalingTest_H
+
+#include "gpos/base.h"
+#include "gpos/string/CWStringDynamic.h"
+
+namespace gpopt
+{
+	using namespace gpos;
+
+	// prototypes
+	class COptimizerConfig;
+
+	//---------------------------------------------------------------------------
+	//	@class:
+	//		CSchedulerScalingTest
+	//
+	//	@doc:
+	//		Replays the minidump corpus of CICGTest with an increasing number
+	//		of optimizer workers and reports optimization time per worker count
+	//
+	//---------------------------------------------------------------------------
+	class CSchedulerScalingTest
+	{
+		private:
+
+			// copy of the given configuration with a different number of workers
+			static
+			COptimizerConfig *PoconfWithWorkers
+				(
+				IMemoryPool *pmp,
+				COptimizerConfig *poconf,
+				ULONG ulWorkers
+				);
+
+			// optimize the given minidump with the given number of workers;
+			// append the serialized plan and its cost to the given strings and
+			// return elapsed optimization time in milliseconds
+			static
+			ULONG UlOptimize
+				(
+				const CHAR *szFileName,
+				ULONG ulWorkers,
+				CWStringDynamic *pstrPlan,
+				CWStringDynamic *pstrCost
+				);
+
+		public:
+
+			// unittests
+			static
+			GPOS_RESULT EresUnittest();
+
+			static
+			GPOS_RESULT EresUnittest_Scaling();
+
+	}; // class CSchedulerScalingTest
+}
+
+#endif // !GPOPT_CSchedulerScalingTest_H
+
+// EOF
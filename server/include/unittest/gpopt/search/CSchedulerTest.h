@@ -73,6 +73,7 @@ namespace gpopt
 			static GPOS_RESULT EresUnittest_SpawnBasic();
 			static GPOS_RESULT EresUnittest_SpawnLight();
 			static GPOS_RESULT EresUnittest_SpawnHeavy();
+			static GPOS_RESULT EresUnittest_SpawnProfiled();
 			static GPOS_RESULT EresUnittest_QueueBasic();
 			static GPOS_RESULT EresUnittest_QueueLight();
 			static GPOS_RESULT EresUnittest_QueueHeavy();
@@ -33,11 +33,32 @@ namespace gpopt
 			// counter used to mark last successful test
 			static
 			ULONG m_ulTestCounter;
+
+			// shapes of join graphs
+			enum EJoinGraph
+			{
+				EjgChain,
+				EjgStar,
+				EjgClique,
+
+				EjgSentinel
+			};
+
+			// generate an n-ary join of given number of relations whose
+			// predicates form a join graph of given shape
+			static
+			CExpression *PexprJoinGraph(IMemoryPool *pmp, EJoinGraph ejg, ULONG ulRels);
+
+			// number of pairs of connected sets and complements in a join graph
+			static
+			ULLONG UllPairs(EJoinGraph ejg, ULONG ulRels);
+
 		public:
 		
 			// unittests
 			static GPOS_RESULT EresUnittest();
 			static GPOS_RESULT EresUnittest_ExpandMinCard();
+			static GPOS_RESULT EresUnittest_DPEnumeration();
 			static GPOS_RESULT EresUnittest_RunTests();
 
 	}; // class CJoinOrderTest
@@ -0,0 +1,619 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2018 Pivotal Software, Inc.
+//
+//	@filename:
+//		bench.cpp
+//
+//	@doc:
+//		Stand-alone optimization latency benchmark; replays a set of minidumps
+//		and reports optimization time, memory and memo sizes per minidump.
+//
+//		Usage:
+//			gporca_bench [-n runs] [-d minidump]... [-f minidump list]
+//						 [-o output] [-b baseline [-t threshold percent]]
+//
+//		Output has one tab-separated line per minidump:
+//			minidump runs p50_us p99_us pool_bytes total_bytes groups group_exprs
+//
+//		where pool_bytes is the high-water mark of the pool used by a single
+//		optimization, and total_bytes is the largest size of all memory pools
+//		seen at the end of an optimization. An output file can be passed
+//		back as a baseline; the benchmark then fails if the median time or
+//		the pool size of any minidump grew by more than the threshold.
+//---------------------------------------------------------------------------
+
+#include "gpos/_api.h"
+#include "gpos/types.h"
+#include "gpopt/init.h"
+
+#include "naucrates/init.h"
+
+#include "gpos/common/CAutoP.h"
+#include "gpos/common/CAutoRg.h"
+#include "gpos/common/CMainArgs.h"
+#include "gpos/common/CWallClock.h"
+#include "gpos/error/CAutoTrace.h"
+#include "gpos/io/COstreamFile.h"
+#include "gpos/memory/CAutoMemoryPool.h"
+
+#include "naucrates/dxl/CDXLUtils.h"
+#include "naucrates/dxl/operators/CDXLNode.h"
+
+#include "gpopt/cost/ICostModel.h"
+#include "gpopt/engine/CEnumeratorConfig.h"
+#include "gpopt/mdcache/CMDCache.h"
+#include "gpopt/minidump/CDXLMinidump.h"
+#include "gpopt/minidump/CMetadataAccessorFactory.h"
+#include "gpopt/minidump/CMinidumperUtils.h"
+#include "gpopt/optimizer/COptimizerConfig.h"
+
+#include "unittest/base.h"
+
+using namespace gpos;
+using namespace gpopt;
+using namespace gpdxl;
+
+// default number of timed runs per minidump
+#define GPOPT_BENCH_RUNS 10
+
+// default regression threshold in percent
+#define GPOPT_BENCH_THRESHOLD 10
+
+// array of strings pointing into a buffer owned elsewhere
+typedef CDynamicPtrArray<CHAR, CleanupNULL> DrgPszBuffer;
+
+// measurements of one minidump
+struct SBenchResult
+{
+	// median optimization time
+	ULONG m_ulP50US;
+
+	// 99th percentile of optimization time
+	ULONG m_ulP99US;
+
+	// high-water mark of the optimization pool
+	ULLONG m_ullPoolBytes;
+
+	// largest size of all pools at the end of an optimization
+	ULLONG m_ullTotalBytes;
+
+	// number of memo groups
+	ULONG m_ulGroups;
+
+	// number of memo group expressions
+	ULONG m_ulGroupExprs;
+};
+
+// baseline measurements of one minidump
+struct SBaseline
+{
+	// minidump file name
+	const CHAR *m_szFileName;
+
+	// median optimization time
+	ULONG m_ulP50US;
+
+	// high-water mark of the optimization pool
+	ULLONG m_ullPoolBytes;
+};
+
+typedef CDynamicPtrArray<SBaseline, CleanupDelete> DrgPbaseline;
+
+// number of regressions found against the baseline, or gpos::ulong_max
+// if the benchmark could not run
+static ULONG regressions = 0;
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		ICompareUl
+//
+//	@doc:
+//		Comparison function for sorting times
+//
+//---------------------------------------------------------------------------
+static INT
+ICompareUl
+	(
+	const void *pv1,
+	const void *pv2
+	)
+{
+	const ULONG ul1 = *(const ULONG *) pv1;
+	const ULONG ul2 = *(const ULONG *) pv2;
+
+	if (ul1 < ul2)
+	{
+		return -1;
+	}
+
+	if (ul1 > ul2)
+	{
+		return 1;
+	}
+
+	return 0;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		UlPercentile
+//
+//	@doc:
+//		Nearest-rank percentile of a sorted array of times
+//
+//---------------------------------------------------------------------------
+static ULONG
+UlPercentile
+	(
+	const ULONG *rgul,
+	ULONG ulSize,
+	ULONG ulPercent
+	)
+{
+	GPOS_ASSERT(0 < ulSize);
+	GPOS_ASSERT(100 >= ulPercent);
+
+	ULONG ulRank = (ulPercent * ulSize + 99) / 100;
+
+	return rgul[std::max((ULONG) 1, ulRank) - 1];
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		AppendLines
+//
+//	@doc:
+//		Split a buffer into lines in place and append all lines that are
+//		neither empty nor comments
+//
+//---------------------------------------------------------------------------
+static void
+AppendLines
+	(
+	CHAR *sz,
+	DrgPszBuffer *pdrgpsz
+	)
+{
+	CHAR *szLine = sz;
+	while (NULL != szLine)
+	{
+		CHAR *szEnd = clib::SzStrChr(szLine, '\n');
+		if (NULL != szEnd)
+		{
+			*szEnd = '\0';
+			szEnd++;
+		}
+
+		if ('\0' != *szLine && '#' != *szLine)
+		{
+			pdrgpsz->Append(szLine);
+		}
+
+		szLine = szEnd;
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		PdrgpbaselineParse
+//
+//	@doc:
+//		Parse baseline lines produced by an earlier benchmark run
+//
+//---------------------------------------------------------------------------
+static DrgPbaseline *
+PdrgpbaselineParse
+	(
+	IMemoryPool *pmp,
+	const DrgPszBuffer *pdrgpszLines
+	)
+{
+	DrgPbaseline *pdrgpbaseline = GPOS_NEW(pmp) DrgPbaseline(pmp);
+
+	const ULONG ulLines = pdrgpszLines->UlLength();
+	for (ULONG ul = 0; ul < ulLines; ul++)
+	{
+		CHAR *szLine = (*pdrgpszLines)[ul];
+		CHAR *szField = clib::SzStrChr(szLine, '\t');
+		if (NULL == szField)
+		{
+			continue;
+		}
+
+		// terminate file name, remaining fields are numbers
+		*szField = '\0';
+		szField++;
+
+		SBaseline *pbaseline = GPOS_NEW(pmp) SBaseline;
+		pbaseline->m_szFileName = szLine;
+
+		(void) clib::LStrToLL(szField, &szField, 10 /*ulBase*/);
+		pbaseline->m_ulP50US = (ULONG) clib::LStrToLL(szField, &szField, 10 /*ulBase*/);
+		(void) clib::LStrToLL(szField, &szField, 10 /*ulBase*/);
+		pbaseline->m_ullPoolBytes = (ULLONG) clib::LStrToLL(szField, &szField, 10 /*ulBase*/);
+
+		pdrgpbaseline->Append(pbaseline);
+	}
+
+	return pdrgpbaseline;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		PbaselineLookup
+//
+//	@doc:
+//		Find the baseline of a minidump
+//
+//---------------------------------------------------------------------------
+static const SBaseline *
+PbaselineLookup
+	(
+	const DrgPbaseline *pdrgpbaseline,
+	const CHAR *szFileName
+	)
+{
+	const ULONG ulSize = pdrgpbaseline->UlLength();
+	for (ULONG ul = 0; ul < ulSize; ul++)
+	{
+		const SBaseline *pbaseline = (*pdrgpbaseline)[ul];
+		if (0 == clib::IStrCmp(pbaseline->m_szFileName, szFileName))
+		{
+			return pbaseline;
+		}
+	}
+
+	return NULL;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		FExceeds
+//
+//	@doc:
+//		Does a measurement exceed its baseline by more than the threshold
+//
+//---------------------------------------------------------------------------
+static BOOL
+FExceeds
+	(
+	ULLONG ullValue,
+	ULLONG ullBaseline,
+	ULONG ulThreshold
+	)
+{
+	return ullValue * 100 > ullBaseline * (100 + ulThreshold);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		Benchmark
+//
+//	@doc:
+//		Optimize a minidump once to warm up the metadata cache, then the
+//		given number of times while measuring each run
+//
+//---------------------------------------------------------------------------
+static void
+Benchmark
+	(
+	IMemoryPool *pmp,
+	const CHAR *szFileName,
+	ULONG ulRuns,
+	SBenchResult *pbr
+	)
+{
+	GPOS_ASSERT(0 < ulRuns);
+
+	CAutoP<CDXLMinidump> a_pdxlmd(CMinidumperUtils::PdxlmdLoad(pmp, szFileName));
+
+	COptimizerConfig *poconf = a_pdxlmd->Poconf();
+	if (NULL == poconf)
+	{
+		poconf = COptimizerConfig::PoconfDefault(pmp);
+	}
+	else
+	{
+		poconf->AddRef();
+	}
+
+	ULONG ulSegments = GPOPT_TEST_SEGMENTS;
+	if (NULL != poconf->Pcm())
+	{
+		ulSegments = std::max(ulSegments, poconf->Pcm()->UlHosts());
+	}
+
+	// metadata of different minidumps may use the same ids
+	CMDCache::Reset();
+
+	CAutoRg<ULONG> a_rgulElapsedUS(GPOS_NEW_ARRAY(pmp, ULONG, ulRuns));
+	pbr->m_ullPoolBytes = 0;
+	pbr->m_ullTotalBytes = 0;
+
+	// run 0 is not measured
+	for (ULONG ul = 0; ul <= ulRuns; ul++)
+	{
+		// a stack pool does not release memory before it is destroyed,
+		// so its size after optimization is its high-water mark
+		CAutoMemoryPool amp(CAutoMemoryPool::ElcExc, CMemoryPoolManager::EatStack);
+		IMemoryPool *pmpRun = amp.Pmp();
+
+		CMetadataAccessorFactory factory(pmpRun, a_pdxlmd.Pt(), szFileName);
+
+		CWallClock clock;
+		CDXLNode *pdxlnPlan = CMinidumperUtils::PdxlnExecuteMinidump
+								(
+								pmpRun,
+								factory.Pmda(),
+								a_pdxlmd.Pt(),
+								szFileName,
+								ulSegments,
+								1 /*ulSessionId*/,
+								1 /*ulCmdId*/,
+								poconf,
+								NULL /*pceeval*/
+								);
+		ULONG ulElapsedUS = clock.UlElapsedUS();
+
+		ULLONG ullPoolBytes = pmpRun->UllTotalAllocatedSize();
+		ULLONG ullTotalBytes = CMemoryPoolManager::Pmpm()->UllTotalAllocatedSize();
+
+		pdxlnPlan->Release();
+
+		if (0 < ul)
+		{
+			a_rgulElapsedUS[ul - 1] = ulElapsedUS;
+			pbr->m_ullPoolBytes = std::max(pbr->m_ullPoolBytes, ullPoolBytes);
+			pbr->m_ullTotalBytes = std::max(pbr->m_ullTotalBytes, ullTotalBytes);
+		}
+	}
+
+	clib::QSort(a_rgulElapsedUS.Rgt(), ulRuns, sizeof(ULONG), ICompareUl);
+	pbr->m_ulP50US = UlPercentile(a_rgulElapsedUS.Rgt(), ulRuns, 50);
+	pbr->m_ulP99US = UlPercentile(a_rgulElapsedUS.Rgt(), ulRuns, 99);
+	pbr->m_ulGroups = poconf->Pec()->UlMemoGroups();
+	pbr->m_ulGroupExprs = poconf->Pec()->UlMemoGroupExprs();
+
+	poconf->Release();
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		ReportRegressions
+//
+//	@doc:
+//		Compare measurements of a minidump to its baseline, if any, and
+//		trace and count regressions
+//
+//---------------------------------------------------------------------------
+static void
+ReportRegressions
+	(
+	IMemoryPool *pmp,
+	const DrgPbaseline *pdrgpbaseline,
+	ULONG ulThreshold,
+	const CHAR *szFileName,
+	const SBenchResult &br
+	)
+{
+	const SBaseline *pbaseline = PbaselineLookup(pdrgpbaseline, szFileName);
+	if (NULL == pbaseline)
+	{
+		CAutoTrace at(pmp);
+		at.Os() << "No baseline for " << szFileName;
+
+		return;
+	}
+
+	BOOL fTime = FExceeds(br.m_ulP50US, pbaseline->m_ulP50US, ulThreshold);
+	BOOL fMemory = FExceeds(br.m_ullPoolBytes, pbaseline->m_ullPoolBytes, ulThreshold);
+	if (!fTime && !fMemory)
+	{
+		return;
+	}
+
+	regressions++;
+
+	CAutoTrace at(pmp);
+	at.Os() << "Regression in " << szFileName << ":";
+	if (fTime)
+	{
+		at.Os() << " p50 " << pbaseline->m_ulP50US << " -> " << br.m_ulP50US << " us";
+	}
+	if (fMemory)
+	{
+		at.Os() << " pool " << pbaseline->m_ullPoolBytes << " -> " << br.m_ullPoolBytes << " bytes";
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		PvExec
+//
+//	@doc:
+//		Function driving the benchmark
+//
+//---------------------------------------------------------------------------
+static void *
+PvExec
+	(
+	void *pv
+	)
+{
+	CMainArgs *pma = (CMainArgs*) pv;
+
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	ULONG ulRuns = GPOPT_BENCH_RUNS;
+	ULONG ulThreshold = GPOPT_BENCH_THRESHOLD;
+	const CHAR *szOutput = NULL;
+	const CHAR *szBaseline = NULL;
+
+	// buffers of files read; minidump names and baselines point into them
+	CAutoRg<CHAR> a_szList;
+	CAutoRg<CHAR> a_szBaseline;
+
+	CAutoRef<DrgPszBuffer> a_pdrgpszFiles(GPOS_NEW(pmp) DrgPszBuffer(pmp));
+
+	CHAR ch = '\0';
+	while (pma->FGetopt(&ch))
+	{
+		switch (ch)
+		{
+			case 'd':
+				a_pdrgpszFiles->Append(optarg);
+				break;
+
+			case 'f':
+				GPOS_ASSERT(NULL == a_szList.Rgt() && "Minidump list given twice");
+				a_szList = CDXLUtils::SzRead(pmp, optarg);
+				AppendLines(a_szList.Rgt(), a_pdrgpszFiles.Pt());
+				break;
+
+			case 'n':
+				ulRuns = (ULONG) clib::LStrToLL(optarg, NULL, 10 /*ulBase*/);
+				break;
+
+			case 'o':
+				szOutput = optarg;
+				break;
+
+			case 'b':
+				szBaseline = optarg;
+				break;
+
+			case 't':
+				ulThreshold = (ULONG) clib::LStrToLL(optarg, NULL, 10 /*ulBase*/);
+				break;
+
+			default:
+				// ignore other parameters
+				break;
+		}
+	}
+
+	if (0 == ulRuns || 0 == a_pdrgpszFiles->UlLength())
+	{
+		GPOS_TRACE(GPOS_WSZ_LIT("Usage: gporca_bench [-n runs] [-d minidump]... [-f minidump list] [-o output] [-b baseline [-t threshold percent]]"));
+		regressions = gpos::ulong_max;
+
+		return NULL;
+	}
+
+	CAutoRef<DrgPbaseline> a_pdrgpbaseline;
+	if (NULL != szBaseline)
+	{
+		a_szBaseline = CDXLUtils::SzRead(pmp, szBaseline);
+
+		CAutoRef<DrgPszBuffer> a_pdrgpszLines(GPOS_NEW(pmp) DrgPszBuffer(pmp));
+		AppendLines(a_szBaseline.Rgt(), a_pdrgpszLines.Pt());
+		a_pdrgpbaseline = PdrgpbaselineParse(pmp, a_pdrgpszLines.Pt());
+	}
+
+	// initialize DXL support
+	InitDXL();
+
+	CMDCache::Init();
+
+	{
+		CAutoP<COstreamFile> a_posFile;
+		IOstream *pos = &oswcout;
+		if (NULL != szOutput)
+		{
+			a_posFile = GPOS_NEW(pmp) COstreamFile(szOutput);
+			pos = a_posFile.Pt();
+		}
+
+		*pos << "# minidump\truns\tp50_us\tp99_us\tpool_bytes\ttotal_bytes\tgroups\tgroup_exprs" << std::endl;
+
+		const ULONG ulFiles = a_pdrgpszFiles->UlLength();
+		for (ULONG ul = 0; ul < ulFiles; ul++)
+		{
+			const CHAR *szFileName = (*a_pdrgpszFiles)[ul];
+
+			SBenchResult br;
+			Benchmark(pmp, szFileName, ulRuns, &br);
+
+			*pos
+				<< szFileName
+				<< "\t" << ulRuns
+				<< "\t" << br.m_ulP50US
+				<< "\t" << br.m_ulP99US
+				<< "\t" << br.m_ullPoolBytes
+				<< "\t" << br.m_ullTotalBytes
+				<< "\t" << br.m_ulGroups
+				<< "\t" << br.m_ulGroupExprs
+				<< std::endl;
+
+			if (NULL != a_pdrgpbaseline.Pt())
+			{
+				ReportRegressions(pmp, a_pdrgpbaseline.Pt(), ulThreshold, szFileName, br);
+			}
+		}
+	}
+
+	CMDCache::Shutdown();
+
+	return NULL;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		main
+//
+//	@doc:
+//		Entry point for stand-alone benchmark binary
+//
+//---------------------------------------------------------------------------
+INT main
+	(
+	INT iArgs,
+	const CHAR **rgszArgs
+	)
+{
+	// Use default allocator
+	struct gpos_init_params gpos_params = { NULL, NULL, NULL };
+
+	gpos_init(&gpos_params);
+	gpdxl_init();
+	gpopt_init();
+
+	GPOS_ASSERT(iArgs >= 0);
+
+	if (gpos_set_threads(4, 20))
+	{
+		return GPOS_FAILED;
+	}
+
+	CMainArgs ma(iArgs, rgszArgs, "d:f:n:o:b:t:");
+
+	gpos_exec_params params;
+	params.func = PvExec;
+	params.arg = &ma;
+	params.stack_start = &params;
+	params.error_buffer = NULL;
+	params.error_buffer_size = -1;
+	params.abort_requested = NULL;
+
+	if (gpos_exec(&params) || (regressions != 0))
+	{
+		return 1;
+	}
+
+	return 0;
+}
+
+
+// EOF
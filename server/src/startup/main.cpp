@@ -15,6 +15,7 @@
 
 #include "naucrates/init.h"
 
+#include "gpos/common/CBitVector.h"
 #include "gpos/common/CMainArgs.h"
 #include "gpos/memory/CAutoMemoryPool.h"
 #include "gpos/test/CFSimulatorTestExt.h"
@@ -72,6 +73,9 @@
 #include "unittest/gpopt/mdcache/CMDAccessorTest.h"
 #include "unittest/gpopt/mdcache/CMDProviderTest.h"
 
+#include "unittest/gpopt/optimizer/COptimizerSessionTest.h"
+#include "unittest/gpopt/optimizer/CPlanCacheTest.h"
+
 #include "unittest/gpopt/minidump/CArrayExpansionTest.h"
 #include "unittest/gpopt/minidump/CJoinOrderDPTest.h"
 #include "unittest/gpopt/minidump/CPullUpProjectElementTest.h"
@@ -94,6 +98,7 @@
 #include "unittest/gpopt/minidump/CEscapeMechanismTest.h"
 #include "unittest/gpopt/minidump/CDirectDispatchTest.h"
 #include "unittest/gpopt/minidump/CCastTest.h"
+#include "unittest/gpopt/minidump/CMemoryPoolBenchmarkTest.h"
 #include "unittest/gpopt/minidump/CConstTblGetTest.h"
 
 #include "unittest/gpopt/operators/CContradictionTest.h"
@@ -103,6 +108,7 @@
 #include "unittest/gpopt/operators/CScalarIsDistinctFromTest.h"
 
 #include "unittest/gpopt/search/CSchedulerTest.h"
+#include "unittest/gpopt/search/CSchedulerScalingTest.h"
 #include "unittest/gpopt/search/CSearchStrategyTest.h"
 #include "unittest/gpopt/minidump/CMultilevelPartitionTest.h"
 #include "unittest/gpopt/search/COptimizationJobsTest.h"
@@ -113,6 +119,7 @@
 #include "unittest/gpopt/csq/CCorrelatedExecutionTest.h"
 #include "unittest/gpopt/eval/CConstExprEvaluatorDefaultTest.h"
 #include "unittest/gpopt/eval/CConstExprEvaluatorDXLTest.h"
+#include "unittest/gpopt/eval/CConstExprEvaluatorNativeTest.h"
 #include "unittest/gpopt/xforms/CDecorrelatorTest.h"
 #include "unittest/gpopt/xforms/CJoinOrderTest.h"
 #include "unittest/gpopt/xforms/CSubqueryHandlerTest.h"
@@ -148,6 +155,8 @@ static gpos::CUnittest rgut[] =
 	GPOS_UNITTEST_STD(CDXLUtilsTest),
 	GPOS_UNITTEST_STD(CMDAccessorTest),
 	GPOS_UNITTEST_STD(CMDProviderTest),
+	GPOS_UNITTEST_STD(CPlanCacheTest),
+	GPOS_UNITTEST_STD(COptimizerSessionTest),
 	GPOS_UNITTEST_STD(CMiniDumperDXLTest),
 	GPOS_UNITTEST_STD(CExpressionPreprocessorTest),
 	GPOS_UNITTEST_STD(CWindowTest),
@@ -198,6 +207,7 @@ static gpos::CUnittest rgut[] =
 	GPOS_UNITTEST_STD(CDecorrelatorTest),
 	GPOS_UNITTEST_STD(CDistributionSpecTest),
 	GPOS_UNITTEST_STD(CCastTest),
+	GPOS_UNITTEST_STD(CMemoryPoolBenchmarkTest),
 	GPOS_UNITTEST_STD(CConstTblGetTest),
 
 #if !defined(GPOS_32BIT)
@@ -229,6 +239,7 @@ static gpos::CUnittest rgut[] =
 	GPOS_UNITTEST_STD(CXformTest),
 	GPOS_UNITTEST_STD(CConstExprEvaluatorDefaultTest),
 	GPOS_UNITTEST_STD(CConstExprEvaluatorDXLTest),
+	GPOS_UNITTEST_STD(CConstExprEvaluatorNativeTest),
 	// disable CEnumeratorTest until it is fixed
 //#if !defined(GPOS_SunOS)
 //	GPOS_UNITTEST_STD(CEnumeratorTest),
@@ -241,6 +252,11 @@ static gpos::CUnittest rgut[] =
 #ifdef GPOS_DEBUG
 	GPOS_UNITTEST_EXT(CTimeSliceTest),
 #endif // GPOS_DEBUG
+
+#if !defined(GPOS_SunOS)
+	// scaling of multi-worker optimization
+	GPOS_UNITTEST_EXT(CSchedulerScalingTest),
+#endif  // !defined(GPOS_SunOS)
 };
 
 //---------------------------------------------------------------------------
@@ -11,6 +11,7 @@
 
 #include "gpos/base.h"
 #include "gpos/io/COstreamString.h"
+#include "gpos/io/COstreamUTF8.h"
 #include "gpos/error/CAutoTrace.h"
 #include "gpos/common/CRandom.h"
 #include "gpos/common/CAutoP.h"
@@ -34,6 +35,66 @@ using namespace gpdxl;
 static const char *szQueryFile = "../data/dxl/expressiontests/TableScanQuery.xml";
 static const char *szPlanFile = "../data/dxl/expressiontests/TableScanPlan.xml";
 
+//---------------------------------------------------------------------------
+//	@class:
+//		CCompareSink
+//
+//	@doc:
+//		Byte sink comparing its input to an expected string without
+//		collecting it
+//
+//---------------------------------------------------------------------------
+class CCompareSink : public IByteSink
+{
+	private:
+
+		// expected output
+		const CHAR *m_szExpected;
+
+		// number of bytes received so far
+		ULONG_PTR m_ulpReceived;
+
+		// did all bytes received so far match
+		BOOL m_fMatch;
+
+		// private copy ctor
+		CCompareSink(const CCompareSink &);
+
+	public:
+
+		// ctor
+		explicit
+		CCompareSink
+			(
+			const CHAR *szExpected
+			)
+			:
+			m_szExpected(szExpected),
+			m_ulpReceived(0),
+			m_fMatch(true)
+		{}
+
+		// compare the given bytes to the expected output
+		virtual
+		void Write
+			(
+			const BYTE *pb,
+			const ULONG_PTR ulpSize
+			)
+		{
+			m_fMatch = m_fMatch &&
+						m_ulpReceived + ulpSize <= clib::UlStrLen(m_szExpected) &&
+						0 == clib::IMemCmp(m_szExpected + m_ulpReceived, pb, ulpSize);
+			m_ulpReceived += ulpSize;
+		}
+
+		// did the complete expected output arrive
+		BOOL FMatch() const
+		{
+			return m_fMatch && m_ulpReceived == clib::UlStrLen(m_szExpected);
+		}
+};
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CDXLUtilsTest::EresUnittest
@@ -49,6 +110,7 @@ CDXLUtilsTest::EresUnittest()
 		{
 		GPOS_UNITTEST_FUNC(CDXLUtilsTest::EresUnittest_SerializeQuery),
 		GPOS_UNITTEST_FUNC(CDXLUtilsTest::EresUnittest_SerializePlan),
+		GPOS_UNITTEST_FUNC(CDXLUtilsTest::EresUnittest_SerializePlanUTF8),
 		GPOS_UNITTEST_FUNC(CDXLUtilsTest::EresUnittest_Encoding),
 		};
 
@@ -161,6 +223,49 @@ CDXLUtilsTest::EresUnittest_SerializePlan()
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CDXLUtilsTest::EresUnittest_SerializePlanUTF8
+//
+//	@doc:
+//		Testing that streaming a plan as UTF-8 produces the same document as
+//		serializing it into a string
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CDXLUtilsTest::EresUnittest_SerializePlanUTF8()
+{
+	// create memory pool
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	// read DXL file
+	CHAR *szDXL = CDXLUtils::SzRead(pmp, szPlanFile);
+
+	ULLONG ullPlanId = gpos::ullong_max;
+	ULLONG ullPlanSpaceSize = gpos::ullong_max;
+	CDXLNode *pdxln = CDXLUtils::PdxlnParsePlan(pmp, szDXL, NULL /*szXSDPath*/, &ullPlanId, &ullPlanSpaceSize);
+
+	CWStringDynamic str(pmp);
+	COstreamString oss(&str);
+	CDXLUtils::SerializePlan(pmp, oss, pdxln, ullPlanId, ullPlanSpaceSize, true /*fDocumentHeaderFooter*/, true /*fIndent*/);
+	CHAR *szExpected = CDXLUtils::SzFromWsz(pmp, str.Wsz());
+
+	CCompareSink sink(szExpected);
+	COstreamUTF8 osUTF8(&sink);
+	CDXLUtils::SerializePlan(pmp, osUTF8, pdxln, ullPlanId, ullPlanSpaceSize, true /*fDocumentHeaderFooter*/, true /*fIndent*/);
+	osUTF8.Flush();
+
+	GPOS_RESULT eres = sink.FMatch() ? GPOS_OK : GPOS_FAILED;
+
+	// cleanup
+	GPOS_DELETE_ARRAY(szExpected);
+	pdxln->Release();
+	GPOS_DELETE_ARRAY(szDXL);
+
+	return eres;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CDXLUtilsTest::EresUnittest_Encoding
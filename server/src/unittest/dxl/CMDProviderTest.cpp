@@ -13,6 +13,9 @@
 #include "gpos/memory/CAutoMemoryPool.h"
 #include "gpos/io/ioutils.h"
 #include "gpos/io/COstreamString.h"
+#include "gpos/common/CAutoRef.h"
+#include "gpos/common/CAutoRg.h"
+#include "gpos/error/CAutoTrace.h"
 #include "gpos/task/CAutoTaskProxy.h"
 #include "gpos/test/CUnittest.h"
 
@@ -22,6 +25,8 @@
 #include "naucrates/md/CMDProviderMemory.h"
 #include "naucrates/md/CMDIdRelStats.h"
 #include "naucrates/md/CMDIdColStats.h"
+#include "naucrates/md/CMDBinaryUtils.h"
+#include "naucrates/md/CDXLRelStats.h"
 
 #include "naucrates/exception.h"
 #include "naucrates/dxl/CDXLUtils.h"
@@ -56,6 +61,14 @@ CMDProviderTest::EresUnittest()
 			gpdxl::ExmaMD,
 			gpdxl::ExmiMDCacheEntryNotFound
 			),
+		GPOS_UNITTEST_FUNC(CMDProviderTest::EresUnittest_Binary),
+		GPOS_UNITTEST_FUNC_THROW
+			(
+			CMDProviderTest::EresUnittest_BinaryTruncated,
+			gpdxl::ExmaMD,
+			gpdxl::ExmiMDBinaryFormatError
+			),
+		GPOS_UNITTEST_FUNC(CMDProviderTest::EresUnittest_BinaryTruncatedNoLeak),
 		};
 
 	return CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
@@ -236,5 +249,179 @@ CMDProviderTest::EresUnittest_Negative()
 	return GPOS_FAILED;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDProviderTest::EresUnittest_Binary
+//
+//	@doc:
+//		Test round-tripping metadata objects through the binary encoding and
+//		fetching them through the binary provider interface
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CMDProviderTest::EresUnittest_Binary()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	CAutoRg<CHAR> a_szDXL;
+	a_szDXL = CDXLUtils::SzRead(pmp, szFileName);
+
+	CAutoRef<DrgPimdobj> a_pdrgpmdobj;
+	a_pdrgpmdobj = CDXLUtils::PdrgpmdobjParseDXL(pmp, a_szDXL.Rgt(), NULL /*szXSDPath*/);
+
+	CMDProviderMemory *pmdpMemory = GPOS_NEW(pmp) CMDProviderMemory(pmp, a_pdrgpmdobj.Pt());
+	pmdpMemory->AddRef();
+
+	ULONG ulEncoded = 0;
+	{
+		CAutoMDAccessor amda(pmp, pmdpMemory, CTestUtils::m_sysidDefault, CMDCache::Pcache());
+
+		const ULONG ulObjects = a_pdrgpmdobj->UlLength();
+		for (ULONG ul = 0; ul < ulObjects; ul++)
+		{
+			IMDCacheObject *pimdobj = (*a_pdrgpmdobj)[ul];
+
+			ULONG ulSize = 0;
+			CAutoRg<BYTE> a_pb;
+			a_pb = pmdpMemory->PbObject(pmp, amda.Pmda(), pimdobj->Pmdid(), &ulSize);
+			if (NULL == a_pb.Rgt())
+			{
+				GPOS_ASSERT(!CMDBinaryUtils::FSerializable(pimdobj));
+				continue;
+			}
+
+			GPOS_ASSERT(ulSize == CMDBinaryUtils::UlSize(a_pb.Rgt()));
+			ulEncoded++;
+
+			// decoded object must serialize to the same DXL as the original one
+			CAutoRef<IMDCacheObject> a_pimdobjDecoded;
+			a_pimdobjDecoded = CMDBinaryUtils::PimdobjDeserialize(pmp, a_pb.Rgt(), ulSize);
+
+			CAutoP<CWStringDynamic> a_pstrOriginal;
+			a_pstrOriginal = CDXLUtils::PstrSerializeMDObj(pmp, pimdobj, true /*fSerializeHeaders*/, false /*findent*/);
+			CAutoP<CWStringDynamic> a_pstrDecoded;
+			a_pstrDecoded = CDXLUtils::PstrSerializeMDObj(pmp, a_pimdobjDecoded.Pt(), true /*fSerializeHeaders*/, false /*findent*/);
+
+			if (!a_pstrOriginal->FEquals(a_pstrDecoded.Pt()))
+			{
+				CAutoTrace at(pmp);
+				at.Os() << "Binary round trip mismatch for object " << pimdobj->Pmdid()->Wsz() << std::endl;
+				at.Os() << "Expected: " << a_pstrOriginal->Wsz() << std::endl;
+				at.Os() << "Actual: " << a_pstrDecoded->Wsz() << std::endl;
+
+				pmdpMemory->Release();
+				return GPOS_FAILED;
+			}
+		}
+	}
+
+	pmdpMemory->Release();
+
+	return (0 < ulEncoded) ? GPOS_OK : GPOS_FAILED;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDProviderTest::EresUnittest_BinaryTruncated
+//
+//	@doc:
+//		Test decoding a truncated binary metadata object
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CMDProviderTest::EresUnittest_BinaryTruncated()
+{
+	CAutoMemoryPool amp(CAutoMemoryPool::ElcNone);
+	IMemoryPool *pmp = amp.Pmp();
+
+	CAutoRef<CDXLRelStats> a_pdxlrelstats;
+	a_pdxlrelstats = CDXLRelStats::PdxlrelstatsDummy
+						(
+						pmp,
+						GPOS_NEW(pmp) CMDIdRelStats(GPOS_NEW(pmp) CMDIdGPDB(GPOPT_MDCACHE_TEST_OID, 1, 1))
+						);
+
+	ULONG ulSize = 0;
+	CAutoRg<BYTE> a_pb;
+	a_pb = CMDBinaryUtils::PbSerialize(pmp, a_pdxlrelstats.Pt(), &ulSize);
+	GPOS_ASSERT(NULL != a_pb.Rgt());
+
+	// drop the last byte of the encoding: decoding must raise
+	(void) CMDBinaryUtils::PimdobjDeserialize(pmp, a_pb.Rgt(), ulSize - 1);
+
+	return GPOS_FAILED;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDProviderTest::EresUnittest_BinaryTruncatedNoLeak
+//
+//	@doc:
+//		Decode every encoded object of the test metadata truncated at every
+//		payload byte; each decoding must raise and release the partially
+//		decoded object, which is checked by a leak-checking memory pool
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CMDProviderTest::EresUnittest_BinaryTruncatedNoLeak()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	CAutoRg<CHAR> a_szDXL;
+	a_szDXL = CDXLUtils::SzRead(pmp, szFileName);
+
+	CAutoRef<DrgPimdobj> a_pdrgpmdobj;
+	a_pdrgpmdobj = CDXLUtils::PdrgpmdobjParseDXL(pmp, a_szDXL.Rgt(), NULL /*szXSDPath*/);
+
+	const ULONG ulObjects = a_pdrgpmdobj->UlLength();
+	for (ULONG ul = 0; ul < ulObjects; ul++)
+	{
+		ULONG ulSize = 0;
+		CAutoRg<BYTE> a_pb;
+		a_pb = CMDBinaryUtils::PbSerialize(pmp, (*a_pdrgpmdobj)[ul], &ulSize);
+		if (NULL == a_pb.Rgt())
+		{
+			continue;
+		}
+
+		// objects decoded from all truncations of the encoding must be released
+		CAutoMemoryPool ampDecode(CAutoMemoryPool::ElcStrict);
+		IMemoryPool *pmpDecode = ampDecode.Pmp();
+
+		for (ULONG ulTruncated = CMDBinaryUtils::ulHeaderSize; ulTruncated < ulSize; ulTruncated++)
+		{
+			// record the truncated length in the header, so that decoding
+			// fails in the payload rather than on the header check
+			for (ULONG ulByte = 0; ulByte < sizeof(ULONG); ulByte++)
+			{
+				a_pb[3 * sizeof(ULONG) + ulByte] = (BYTE) (ulTruncated >> (8 * ulByte));
+			}
+
+			GPOS_TRY
+			{
+				IMDCacheObject *pimdobj = CMDBinaryUtils::PimdobjDeserialize(pmpDecode, a_pb.Rgt(), ulTruncated);
+
+				// a truncated encoding must not decode
+				pimdobj->Release();
+				return GPOS_FAILED;
+			}
+			GPOS_CATCH_EX(ex)
+			{
+				if (!GPOS_MATCH_EX(ex, gpdxl::ExmaMD, gpdxl::ExmiMDBinaryFormatError))
+				{
+					GPOS_RETHROW(ex);
+				}
+
+				GPOS_RESET_EX;
+			}
+			GPOS_CATCH_END;
+		}
+	}
+
+	return GPOS_OK;
+}
+
 // EOF
 
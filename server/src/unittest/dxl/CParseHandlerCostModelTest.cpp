@@ -130,8 +130,8 @@ static gpos::GPOS_RESULT Eres_SerializeCalibratedCostModel()
 	IMemoryPool *pmp = amp.Pmp();
 
 	const WCHAR *const wszExpectedString = L"<dxl:CostModelConfig CostModelType=\"1\" SegmentsForCosting=\"3\">"
-								   "<dxl:CostParams>"
-								   "<dxl:CostParam Name=\"NLJFactor\" Value=\"1024.000000\" LowerBound=\"1023.000000\" UpperBound=\"1025.000000\"/>"
+								   "<dxl:CostParams Version=\"1\">"
+								   "<dxl:CostParam Name=\"NLJFactor\" Value=\"1024\" LowerBound=\"1023\" UpperBound=\"1025\"/>"
 								   "</dxl:CostParams>"
 								   "</dxl:CostModelConfig>";
 	gpos::CAutoP<CWStringDynamic> apwsExpected(GPOS_NEW(pmp) CWStringDynamic(pmp, wszExpectedString));
@@ -13,12 +13,15 @@
 #include "gpos/error/CMessage.h"
 #include "gpos/io/COstreamString.h"
 #include "gpos/string/CWStringDynamic.h"
+#include "gpos/task/CAutoTraceFlag.h"
 
 #include "naucrates/exception.h"
 #include "naucrates/base/CQueryToDXLResult.h"
 #include "naucrates/dxl/xml/CXMLSerializer.h"
 #include "naucrates/dxl/operators/CDXLNode.h"
+#include "naucrates/dxl/operators/CDXLPhysicalTableScan.h"
 #include "naucrates/dxl/CDXLUtils.h"
+#include "naucrates/traceflags/traceflags.h"
 
 #include "gpopt/eval/CConstExprEvaluatorDefault.h"
 
@@ -34,6 +37,10 @@
 const CHAR *
 CParseHandlerTest::m_szMDRequestFile = "../data/dxl/parse_tests/MDRequest.xml";
 
+// plan file with a shared scalar subtree
+const CHAR *
+CParseHandlerTest::m_szSharedScalarFile = "../data/dxl/parse_tests/q77-SharedScalar.xml";
+
 // files for testing parsing of different DXL nodes
 const CHAR *
 CParseHandlerTest::m_rgszPlanDXLFileNames[] =
@@ -188,6 +195,7 @@ CParseHandlerTest::EresUnittest()
 		GPOS_UNITTEST_FUNC(CParseHandlerTest::EresUnittest_Metadata),
 		GPOS_UNITTEST_FUNC(CParseHandlerTest::EresUnittest_MDRequest),
 		GPOS_UNITTEST_FUNC(CParseHandlerTest::EresUnittest_RunPlanTests),
+		GPOS_UNITTEST_FUNC(CParseHandlerTest::EresUnittest_SharedScalars),
 		// tests involving dxl representation of queries.
 		GPOS_UNITTEST_FUNC(CParseHandlerTest::EresUnittest_RunQueryTests),
 
@@ -278,6 +286,68 @@ CParseHandlerTest::EresUnittest_MDRequest()
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CParseHandlerTest::EresUnittest_SharedScalars
+//
+//	@doc:
+//		Tests parsing of a plan where a project element and a filter share a
+//		scalar subtree; the plan is serialized back to the same string only
+//		if shared subtrees are serialized once
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CParseHandlerTest::EresUnittest_SharedScalars()
+{
+	// create own memory pool
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	CHAR *szDXL = CDXLUtils::SzRead(pmp, m_szSharedScalarFile);
+
+	ULLONG ullPlanId = gpos::ullong_max;
+	ULLONG ullPlanSpaceSize = gpos::ullong_max;
+	CDXLNode *pdxlnRoot = CDXLUtils::PdxlnParsePlan(pmp, szDXL, NULL /*szXSDPath*/, &ullPlanId, &ullPlanSpaceSize);
+
+	// both references resolve to the same node
+	CDXLNode *pdxlnProjElem = (*(*pdxlnRoot)[EdxltsIndexProjList])[0];
+	CDXLNode *pdxlnNot = (*(*pdxlnRoot)[EdxltsIndexFilter])[0];
+	BOOL fShared = ((*pdxlnProjElem)[0] == (*pdxlnNot)[0]);
+
+	CWStringDynamic strShared(pmp);
+	{
+		CAutoTraceFlag atf(EopttraceSerializeSharedScalars, true /*fVal*/);
+		COstreamString os(&strShared);
+		CDXLUtils::SerializePlan(pmp, os, pdxlnRoot, ullPlanId, ullPlanSpaceSize, true /*fSerializeHeaderFooter*/, true /*fIndent*/);
+	}
+
+	CWStringDynamic strCopied(pmp);
+	{
+		CAutoTraceFlag atf(EopttraceSerializeSharedScalars, false /*fVal*/);
+		COstreamString os(&strCopied);
+		CDXLUtils::SerializePlan(pmp, os, pdxlnRoot, ullPlanId, ullPlanSpaceSize, true /*fSerializeHeaderFooter*/, true /*fIndent*/);
+	}
+
+	CWStringDynamic strExpected(pmp);
+	strExpected.AppendFormat(GPOS_WSZ_LIT("%s"), szDXL);
+
+	BOOL fMatching = strExpected.FEquals(&strShared);
+	if (!fMatching)
+	{
+		GPOS_TRACE(strExpected.Wsz());
+		GPOS_TRACE(strShared.Wsz());
+	}
+
+	// without sharing, the subtree is serialized under both parents
+	BOOL fCopied = strShared.UlLength() < strCopied.UlLength();
+
+	pdxlnRoot->Release();
+	GPOS_DELETE_ARRAY(szDXL);
+
+	return (fShared && fMatching && fCopied) ? GPOS_OK : GPOS_FAILED;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CParseHandlerTest::EresUnittest_Statistics
@@ -20,6 +20,7 @@
 
 #include "naucrates/statistics/CPoint.h"
 #include "naucrates/statistics/CHistogram.h"
+#include "naucrates/statistics/CHistogramBounds.h"
 
 #include "unittest/base.h"
 #include "unittest/dxl/statistics/CCardinalityTestUtils.h"
@@ -38,7 +39,8 @@ CHistogramTest::EresUnittest()
 		GPOS_UNITTEST_FUNC(CHistogramTest::EresUnittest_CHistogramInt4),
 		GPOS_UNITTEST_FUNC(CHistogramTest::EresUnittest_CHistogramBool),
 		GPOS_UNITTEST_FUNC(CHistogramTest::EresUnittest_Skew),
-		GPOS_UNITTEST_FUNC(CHistogramTest::EresUnittest_CHistogramValid)
+		GPOS_UNITTEST_FUNC(CHistogramTest::EresUnittest_CHistogramValid),
+		GPOS_UNITTEST_FUNC(CHistogramTest::EresUnittest_CHistogramBounds)
 		};
 
 	CAutoMemoryPool amp;
@@ -221,6 +223,97 @@ CHistogramTest::EresUnittest_CHistogramValid()
 	return GPOS_OK;
 }
 
+// check that lookups over columnar bucket bounds agree with bucket comparisons
+GPOS_RESULT
+CHistogramTest::EresUnittest_CHistogramBounds()
+{
+	// create memory pool
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	// generate histogram of the form [0, 10), [20, 30], (40, 50), [55, 55], [60, 70) ...
+	// mixing open and closed bounds, gaps and singletons
+	const ULONG ulBuckets = 30;
+	DrgPbucket *pdrgppbucket = GPOS_NEW(pmp) DrgPbucket(pmp);
+	for (ULONG ulIdx = 0; ulIdx < ulBuckets; ulIdx++)
+	{
+		INT iLower = INT(ulIdx * 20);
+		if (0 == ulIdx % 3)
+		{
+			pdrgppbucket->Append(CCardinalityTestUtils::PbucketInteger(pmp, iLower, iLower + 10, true, false, 0.02, 10.0));
+		}
+		else if (1 == ulIdx % 3)
+		{
+			pdrgppbucket->Append(CCardinalityTestUtils::PbucketInteger(pmp, iLower, iLower + 10, true, true, 0.02, 11.0));
+		}
+		else
+		{
+			pdrgppbucket->Append(CCardinalityTestUtils::PbucketInteger(pmp, iLower, iLower + 10, false, false, 0.02, 9.0));
+			pdrgppbucket->Append(CCardinalityTestUtils::PbucketInteger(pmp, iLower + 15, iLower + 15, true, true, 0.01, 1.0));
+		}
+	}
+
+	CHistogram *phist = GPOS_NEW(pmp) CHistogram(pdrgppbucket);
+	GPOS_RTL_ASSERT(phist->FValid());
+
+	CHistogramBounds hb(pmp, pdrgppbucket);
+	GPOS_RTL_ASSERT(hb.FMapped());
+	GPOS_RTL_ASSERT(CHistogramBounds::EbkLint == hb.Ebk());
+
+	const ULONG ulNumBuckets = pdrgppbucket->UlLength();
+	for (INT i = -5; i < INT(ulBuckets * 20) + 5; i++)
+	{
+		CPoint *ppoint = CTestUtils::PpointInt4(pmp, i);
+
+		CHistogramBounds::SKey key;
+		GPOS_RTL_ASSERT(hb.FMapPoint(ppoint, &key));
+
+		// first bucket not entirely below the point, by comparing datums
+		ULONG ulExpected = 0;
+		while (ulExpected < ulNumBuckets && (*pdrgppbucket)[ulExpected]->FAfter(ppoint))
+		{
+			ulExpected++;
+		}
+		GPOS_RTL_ASSERT(ulExpected == hb.UlFirstNotBelow(key));
+
+		for (ULONG ul = 0; ul < ulNumBuckets; ul++)
+		{
+			GPOS_RTL_ASSERT((*pdrgppbucket)[ul]->FContains(ppoint) == hb.FContains(ul, key));
+		}
+
+		// filters over the columnar bounds keep the buckets a scan would keep
+		CHistogram *phistEq = phist->PhistFilter(pmp, CStatsPred::EstatscmptEq, ppoint);
+		CHistogram *phistLEq = phist->PhistFilter(pmp, CStatsPred::EstatscmptLEq, ppoint);
+		CHistogram *phistG = phist->PhistFilter(pmp, CStatsPred::EstatscmptG, ppoint);
+		BOOL fContains = (ulExpected < ulNumBuckets && (*pdrgppbucket)[ulExpected]->FContains(ppoint));
+		GPOS_RTL_ASSERT(phistEq->UlBuckets() == (fContains ? 1 : 0));
+		GPOS_RTL_ASSERT(phistLEq->FValid() && phistG->FValid());
+		GPOS_RTL_ASSERT(phistLEq->UlBuckets() <= ulExpected + 1 && ulExpected <= phistLEq->UlBuckets());
+
+		GPOS_DELETE(phistEq);
+		GPOS_DELETE(phistLEq);
+		GPOS_DELETE(phistG);
+		ppoint->Release();
+	}
+
+	// equality join with itself intersects every bucket with itself only
+	CHistogram *phistJoin = phist->PhistJoin(pmp, CStatsPred::EstatscmptEq, phist);
+	GPOS_RTL_ASSERT(phistJoin->UlBuckets() == ulNumBuckets);
+
+	// bounds of an ill-formed histogram are left unmapped
+	DrgPbucket *pdrgppbucketInvalid = GPOS_NEW(pmp) DrgPbucket(pmp);
+	pdrgppbucketInvalid->Append(CCardinalityTestUtils::PbucketIntegerClosedLowerBound(pmp, 0, 10, 0.1, 2.0));
+	pdrgppbucketInvalid->Append(CCardinalityTestUtils::PbucketIntegerClosedLowerBound(pmp, 9, 20, 0.1, 2.0));
+	CHistogramBounds hbInvalid(pmp, pdrgppbucketInvalid);
+	GPOS_RTL_ASSERT(!hbInvalid.FMapped());
+
+	pdrgppbucketInvalid->Release();
+	GPOS_DELETE(phistJoin);
+	GPOS_DELETE(phist);
+
+	return GPOS_OK;
+}
+
 // generates example int histogram having tuples not covered by buckets,
 // including null fraction and nDistinctRemain
 CHistogram*
@@ -37,7 +37,8 @@ CColRefSetTest::EresUnittest()
 {
 	CUnittest rgut[] =
 		{
-		GPOS_UNITTEST_FUNC(CColRefSetTest::EresUnittest_Basics)
+		GPOS_UNITTEST_FUNC(CColRefSetTest::EresUnittest_Basics),
+		GPOS_UNITTEST_FUNC(CColRefSetTest::EresUnittest_Inline)
 		};
 
 	return CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
@@ -102,5 +103,89 @@ CColRefSetTest::EresUnittest_Basics()
 	return GPOS_OK;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CColRefSetTest::EresUnittest_Inline
+//
+//	@doc:
+//		Column sets over the first chunk of column ids are stored inline
+//		and do not allocate when members are added or combined
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CColRefSetTest::EresUnittest_Inline()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	// Setup an MD cache with a file-based provider
+	CMDProviderMemory *pmdp = CTestUtils::m_pmdpf;
+	pmdp->AddRef();
+	CMDAccessor mda(pmp, CMDCache::Pcache());
+	mda.RegisterProvider(CTestUtils::m_sysidDefault, pmdp);
+
+	// install opt context in TLS
+	CAutoOptCtxt aoc
+				(
+				pmp,
+				&mda,
+				NULL, /* pceeval */
+				CTestUtils::Pcm(pmp)
+				);
+
+	// get column factory from optimizer context object
+	CColumnFactory *pcf = COptCtxt::PoctxtFromTLS()->Pcf();
+
+	CWStringConst strName(GPOS_WSZ_LIT("Test Column"));
+	CName name(&strName);
+
+	const IMDTypeInt4 *pmdtypeint4 = mda.PtMDType<IMDTypeInt4>();
+
+	// a typical query touches a few hundred columns at most
+	const ULONG ulCols = 300;
+	DrgPcr *pdrgpcr = GPOS_NEW(pmp) DrgPcr(pmp);
+	for (ULONG ul = 0; ul < ulCols; ul++)
+	{
+		CColRef *pcr = pcf->PcrCreate(pmdtypeint4, IDefaultTypeModifier, name);
+		GPOS_ASSERT(GPOPT_COLREFSET_SIZE > pcr->UlId());
+		pdrgpcr->Append(pcr);
+	}
+
+	// sets live in their own pool so that only their allocations are counted
+	CAutoMemoryPool ampSets;
+	IMemoryPool *pmpSets = ampSets.Pmp();
+
+	CColRefSet *pcrs = GPOS_NEW(pmpSets) CColRefSet(pmpSets);
+	CColRefSet *pcrsEven = GPOS_NEW(pmpSets) CColRefSet(pmpSets);
+	const ULLONG ullAllocated = pmpSets->UllTotalAllocatedSize();
+
+	for (ULONG ul = 0; ul < ulCols; ul++)
+	{
+		CColRef *pcr = (*pdrgpcr)[ul];
+		pcrs->Include(pcr);
+		if (0 == ul % 2)
+		{
+			pcrsEven->Include(pcr);
+		}
+	}
+
+	pcrs->Difference(pcrsEven);
+	pcrs->Union(pcrsEven);
+	pcrs->Intersection(pcrsEven);
+	pcrs->Include(pdrgpcr);
+
+	GPOS_RESULT eres = GPOS_OK;
+	if (ulCols != pcrs->CElements() ||
+		ullAllocated != pmpSets->UllTotalAllocatedSize())
+	{
+		eres = GPOS_FAILED;
+	}
+
+	pcrsEven->Release();
+	pcrs->Release();
+	pdrgpcr->Release();
+
+	return eres;
+}
 
 // EOF
@@ -508,8 +508,11 @@ CConstraintTest::EresUnittest_CIntervalFromScalarExpr()
 	// from ScalarBool
 	GPOS_RESULT eres2 = EresUnittest_CIntervalFromScalarBoolOp(pmp, &mda, pcr);
 
+	// from long ScalarBool
+	GPOS_RESULT eres3 = EresUnittest_CIntervalFromLongBoolOp(pmp, &mda, pcr);
+
 	pexprGet->Release();
-	if (GPOS_OK == eres1 && GPOS_OK == eres2)
+	if (GPOS_OK == eres1 && GPOS_OK == eres2 && GPOS_OK == eres3)
 	{
 		return GPOS_OK;
 	}
@@ -1045,6 +1048,81 @@ CConstraintTest::EresUnittest_CIntervalFromScalarBoolOp
 	return GPOS_OK;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstraintTest::EresUnittest_CIntervalFromLongBoolOp
+//
+//	@doc:
+//		Interval from disjunctions and conjunctions with many children,
+//		including duplicate and adjacent constants
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CConstraintTest::EresUnittest_CIntervalFromLongBoolOp
+	(
+	IMemoryPool *pmp,
+	CMDAccessor *pmda,
+	CColRef *pcr
+	)
+{
+	const ULONG ulValues = 500;
+
+	// x = 0 OR x = 1 OR ... with every value appearing twice
+	DrgPexpr *pdrgpexpr = GPOS_NEW(pmp) DrgPexpr(pmp);
+	for (ULONG ul = 0; ul < 2 * ulValues; ul++)
+	{
+		LINT lVal = (LINT) ((ul * 7) % ulValues);
+		pdrgpexpr->Append(PexprScalarCmp(pmp, pmda, pcr, IMDType::EcmptEq, lVal));
+	}
+
+	CExpression *pexpr = CUtils::PexprScalarBoolOp(pmp, CScalarBoolOp::EboolopOr, pdrgpexpr);
+	CConstraintInterval *pciOr = CConstraintInterval::PciIntervalFromScalarExpr(pmp, pexpr, pcr);
+	GPOS_ASSERT(NULL != pciOr);
+
+	BOOL fSuccess = (ulValues == pciOr->Pdrgprng()->UlLength()) && !pciOr->FIncludesNull();
+
+	pciOr->Release();
+	pexpr->Release();
+
+	// x <> 0 AND x <> 1 AND ... with every value appearing twice
+	pdrgpexpr = GPOS_NEW(pmp) DrgPexpr(pmp);
+	for (ULONG ul = 0; ul < 2 * ulValues; ul++)
+	{
+		LINT lVal = (LINT) ((ul * 7) % ulValues);
+		pdrgpexpr->Append(PexprScalarCmp(pmp, pmda, pcr, IMDType::EcmptNEq, lVal));
+	}
+
+	pexpr = CUtils::PexprScalarBoolOp(pmp, CScalarBoolOp::EboolopAnd, pdrgpexpr);
+	CConstraintInterval *pciAnd = CConstraintInterval::PciIntervalFromScalarExpr(pmp, pexpr, pcr);
+	GPOS_ASSERT(NULL != pciAnd);
+
+	fSuccess = fSuccess && (ulValues + 1 == pciAnd->Pdrgprng()->UlLength());
+
+	pciAnd->Release();
+	pexpr->Release();
+
+	// x < 10 OR x >= 10 covers the whole domain except NULL
+	pdrgpexpr = GPOS_NEW(pmp) DrgPexpr(pmp);
+	pdrgpexpr->Append(PexprScalarCmp(pmp, pmda, pcr, IMDType::EcmptL, 10));
+	pdrgpexpr->Append(PexprScalarCmp(pmp, pmda, pcr, IMDType::EcmptGEq, 10));
+
+	pexpr = CUtils::PexprScalarBoolOp(pmp, CScalarBoolOp::EboolopOr, pdrgpexpr);
+	CConstraintInterval *pciUnbounded = CConstraintInterval::PciIntervalFromScalarExpr(pmp, pexpr, pcr);
+	GPOS_ASSERT(NULL != pciUnbounded);
+
+	fSuccess = fSuccess && 1 == pciUnbounded->Pdrgprng()->UlLength() && (*pciUnbounded->Pdrgprng())[0]->FUnbounded();
+
+	pciUnbounded->Release();
+	pexpr->Release();
+
+	if (fSuccess)
+	{
+		return GPOS_OK;
+	}
+
+	return GPOS_FAILED;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CConstraintTest::PexprScalarCmp
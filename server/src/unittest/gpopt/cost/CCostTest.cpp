@@ -14,6 +14,7 @@
 #include "gpopt/cost/CCost.h"
 #include "gpopt/cost/ICostModelParams.h"
 #include "gpopt/engine/CEngine.h"
+#include "gpopt/operators/CExpressionHandle.h"
 #include "gpopt/eval/CConstExprEvaluatorDefault.h"
 #include "gpopt/minidump/CMinidumperUtils.h"
 #include "gpopt/optimizer/COptimizerConfig.h"
@@ -26,6 +27,7 @@
 #include "unittest/gpopt/cost/CCostTest.h"
 #include "unittest/gpopt/CTestUtils.h"
 
+#include "gpdbcost/CCostModelCalibrator.h"
 #include "gpdbcost/CCostModelGPDB.h"
 #include "gpdbcost/CCostModelGPDBLegacy.h"
 
@@ -47,6 +49,9 @@ CCostTest::EresUnittest()
 		GPOS_UNITTEST_FUNC(CCostTest::EresUnittest_Params),
 		GPOS_UNITTEST_FUNC(CCostTest::EresUnittest_Parsing),
 		GPOS_UNITTEST_FUNC(EresUnittest_SetParams),
+		GPOS_UNITTEST_FUNC(EresUnittest_Batch),
+		GPOS_UNITTEST_FUNC(EresUnittest_CalibrationFile),
+		GPOS_UNITTEST_FUNC(EresUnittest_Calibration),
 
 		// TODO: : re-enable test after resolving exception throwing problem on OSX
 		// GPOS_UNITTEST_FUNC_THROW(CCostTest::EresUnittest_ParsingWithException, gpdxl::ExmaDXL, gpdxl::ExmiDXLUnexpectedTag),
@@ -417,4 +422,318 @@ CCostTest::EresUnittest_SetParams()
 	return GPOS_OK;
 }
 
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCostTest::CollectPhysical
+//
+//	@doc:
+//		Collect physical operators of a plan
+//
+//---------------------------------------------------------------------------
+void
+CCostTest::CollectPhysical
+	(
+	CExpression *pexpr,
+	DrgPexpr *pdrgpexpr
+	)
+{
+	if (!pexpr->Pop()->FPhysical())
+	{
+		return;
+	}
+
+	pexpr->AddRef();
+	pdrgpexpr->Append(pexpr);
+
+	const ULONG ulArity = pexpr->UlArity();
+	for (ULONG ul = 0; ul < ulArity; ul++)
+	{
+		CollectPhysical((*pexpr)[ul], pdrgpexpr);
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCostTest::PexprJoinPlan
+//
+//	@doc:
+//		Optimize a join of two tables; requires an optimization context
+//		in TLS
+//
+//---------------------------------------------------------------------------
+CExpression *
+CCostTest::PexprJoinPlan
+	(
+	IMemoryPool *pmp
+	)
+{
+	CExpression *pexpr = CTestUtils::PexprLogicalJoin<CLogicalInnerJoin>(pmp);
+
+	CExpression *pexprPlan = NULL;
+	{
+		CEngine eng(pmp);
+		CQueryContext *pqc = CTestUtils::PqcGenerate(pmp, pexpr);
+		eng.Init(pqc, NULL /*pdrgpss*/);
+		eng.Optimize();
+		pexprPlan = eng.PexprExtractPlan();
+		GPOS_ASSERT(NULL != pexprPlan);
+		GPOS_DELETE(pqc);
+	}
+	pexpr->Release();
+
+	return pexprPlan;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCostTest::AddCostingInfo
+//
+//	@doc:
+//		Attach a handle to each physical operator of a plan and create its
+//		costing info with made-up estimates
+//
+//---------------------------------------------------------------------------
+void
+CCostTest::AddCostingInfo
+	(
+	IMemoryPool *pmp,
+	CExpression *pexprPlan,
+	DrgPexprhdl *pdrgpexprhdl,
+	ICostModel::DrgPcostinfo *pdrgpci
+	)
+{
+	DrgPexpr *pdrgpexpr = GPOS_NEW(pmp) DrgPexpr(pmp);
+	CollectPhysical(pexprPlan, pdrgpexpr);
+
+	const ULONG ulSize = pdrgpexpr->UlLength();
+	for (ULONG ul = 0; ul < ulSize; ul++)
+	{
+		CExpressionHandle *pexprhdl = GPOS_NEW(pmp) CExpressionHandle(pmp);
+		pexprhdl->Attach((*pdrgpexpr)[ul]);
+		pdrgpexprhdl->Append(pexprhdl);
+
+		const ULONG ulChildren = pexprhdl->UlNonScalarChildren();
+		ICostModel::SCostingInfo *pci = GPOS_NEW(pmp) ICostModel::SCostingInfo
+										(
+										pmp,
+										ulChildren,
+										GPOS_NEW(pmp) ICostModel::CCostingStats(CStatistics::PstatsEmpty(pmp))
+										);
+		pci->SetRows(100.0 * (ul + 1));
+		pci->SetWidth(8.0);
+		for (ULONG ulChild = 0; ulChild < ulChildren; ulChild++)
+		{
+			pci->SetChildRows(ulChild, 50.0 * (ulChild + 1));
+			pci->SetChildWidth(ulChild, 4.0);
+			pci->SetChildRebinds(ulChild, GPOPT_DEFAULT_REBINDS);
+			pci->SetChildCost(ulChild, 10.0);
+		}
+		pdrgpci->Append(pci);
+	}
+
+	pdrgpexpr->Release();
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCostTest::EresUnittest_Batch
+//
+//	@doc:
+//		Cost the operators of a plan in one batch, and check that costs
+//		match the ones computed separately
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CCostTest::EresUnittest_Batch()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	// setup a file-based provider
+	CMDProviderMemory *pmdp = CTestUtils::m_pmdpf;
+	pmdp->AddRef();
+	CMDAccessor mda(pmp, CMDCache::Pcache(), CTestUtils::m_sysidDefault, pmdp);
+
+	ICostModel *pcm = GPOS_NEW(pmp) CCostModelGPDB(pmp, GPOPT_TEST_SEGMENTS);
+
+	// install opt context in TLS
+	CAutoOptCtxt aoc(pmp, &mda, NULL, /* pceeval */ pcm);
+
+	CExpression *pexprPlan = PexprJoinPlan(pmp);
+
+	DrgPexprhdl *pdrgpexprhdl = GPOS_NEW(pmp) DrgPexprhdl(pmp);
+	ICostModel::DrgPcostinfo *pdrgpci = GPOS_NEW(pmp) ICostModel::DrgPcostinfo(pmp);
+	AddCostingInfo(pmp, pexprPlan, pdrgpexprhdl, pdrgpci);
+	const ULONG ulSize = pdrgpexprhdl->UlLength();
+
+	DrgPcost *pdrgpcost = pcm->PdrgpcostBatch(pmp, pdrgpexprhdl, pdrgpci);
+
+	GPOS_RESULT eres = GPOS_OK;
+	if (ulSize != pdrgpcost->UlLength())
+	{
+		eres = GPOS_FAILED;
+	}
+
+	for (ULONG ul = 0; GPOS_OK == eres && ul < ulSize; ul++)
+	{
+		CCost cost = pcm->Cost(*(*pdrgpexprhdl)[ul], (*pdrgpci)[ul]);
+		if (cost != *(*pdrgpcost)[ul])
+		{
+			eres = GPOS_FAILED;
+		}
+	}
+
+	{
+		CAutoTrace at(pmp);
+		at.Os() << "Operators costed in one batch: " << ulSize;
+	}
+
+	// clean up
+	pdrgpcost->Release();
+	pdrgpci->Release();
+	pdrgpexprhdl->Release();
+	pexprPlan->Release();
+
+	return eres;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCostTest::EresUnittest_CalibrationFile
+//
+//	@doc:
+//		Create a cost model from a calibration file, and check that a
+//		calibration file written from its params reads back the same params
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CCostTest::EresUnittest_CalibrationFile()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	CAutoRef<ICostModel> a_pcm(CDXLUtils::PcmParseCalibrationFile(pmp, "../data/dxl/cost/calibration.xml", NULL, GPOPT_TEST_SEGMENTS));
+	ICostModelParams *pcp = a_pcm->Pcp();
+
+	// params in the file are calibrated, all others keep their defaults
+	CAutoRef<CCostModelParamsGPDB> a_pcpDefault(GPOS_NEW(pmp) CCostModelParamsGPDB(pmp));
+	if (CDouble(1.1e-06) != pcp->PcpLookup(CCostModelParamsGPDB::EcpTableScanCostUnit)->DVal() ||
+		CDouble(104857600.0) != pcp->PcpLookup(CCostModelParamsGPDB::EcpHJSpillingMemThreshold)->DVal() ||
+		!pcp->PcpLookup(CCostModelParamsGPDB::EcpSeqIOBandwidth)->FEquals(a_pcpDefault->PcpLookup(CCostModelParamsGPDB::EcpSeqIOBandwidth)))
+	{
+		return GPOS_FAILED;
+	}
+
+	CAutoP<CWStringDynamic> a_pstr(CDXLUtils::PstrSerializeCostParams(pmp, pcp, true /*fIndent*/));
+	{
+		CAutoTrace at(pmp);
+		at.Os() << a_pstr->Wsz();
+	}
+
+	CAutoRg<CHAR> a_sz(CDXLUtils::SzFromWsz(pmp, a_pstr->Wsz()));
+	CAutoP<CParseHandlerDXL> a_pphdxl(CDXLUtils::PphdxlParseDXL(pmp, a_sz.Rgt(), NULL /*szXSDPath*/));
+
+	return pcp->FEquals(a_pphdxl->Pcp()) ? GPOS_OK : GPOS_FAILED;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CCostTest::EresUnittest_Calibration
+//
+//	@doc:
+//		Fit cost model params to runtimes produced by a model with
+//		different params, and check that the fitted params explain the
+//		runtimes better than the initial ones
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CCostTest::EresUnittest_Calibration()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	// setup a file-based provider
+	CMDProviderMemory *pmdp = CTestUtils::m_pmdpf;
+	pmdp->AddRef();
+	CMDAccessor mda(pmp, CMDCache::Pcache(), CTestUtils::m_sysidDefault, pmdp);
+
+	ICostModel *pcm = GPOS_NEW(pmp) CCostModelGPDB(pmp, GPOPT_TEST_SEGMENTS);
+
+	// install opt context in TLS
+	CAutoOptCtxt aoc(pmp, &mda, NULL, /* pceeval */ pcm);
+
+	CExpression *pexprPlan = PexprJoinPlan(pmp);
+	DrgPexprhdl *pdrgpexprhdl = GPOS_NEW(pmp) DrgPexprhdl(pmp);
+	ICostModel::DrgPcostinfo *pdrgpci = GPOS_NEW(pmp) ICostModel::DrgPcostinfo(pmp);
+	AddCostingInfo(pmp, pexprPlan, pdrgpexprhdl, pdrgpci);
+
+	// the cluster the runtimes are recorded on scans and sends tuples at
+	// a different speed than the default params assume
+	const ULONG rgulParams[] =
+		{
+		CCostModelParamsGPDB::EcpInitScanFactor,
+		CCostModelParamsGPDB::EcpTableScanCostUnit,
+		CCostModelParamsGPDB::EcpGatherSendCostUnit,
+		CCostModelParamsGPDB::EcpRedistributeSendCostUnit,
+		CCostModelParamsGPDB::EcpBroadcastSendCostUnit,
+		};
+
+	CCostModelParamsGPDB *pcpDefault = dynamic_cast<CCostModelParamsGPDB *>(pcm->Pcp());
+	CCostModelParamsGPDB *pcpCluster = GPOS_NEW(pmp) CCostModelParamsGPDB(pmp);
+	DrgPul *pdrgpulParams = GPOS_NEW(pmp) DrgPul(pmp);
+	for (ULONG ul = 0; ul < GPOS_ARRAY_SIZE(rgulParams); ul++)
+	{
+		ICostModelParams::SCostParam *pcparam = pcpDefault->PcpLookup(rgulParams[ul]);
+		CDouble dVal = pcparam->DVal() + (pcparam->DUpperBound() - pcparam->DVal()) * CDouble(0.5);
+		pcpCluster->SetParam(rgulParams[ul], dVal, pcparam->DLowerBound(), pcparam->DUpperBound());
+		pdrgpulParams->Append(GPOS_NEW(pmp) ULONG(rgulParams[ul]));
+	}
+	CAutoRef<CCostModelGPDB> a_pcmCluster(GPOS_NEW(pmp) CCostModelGPDB(pmp, GPOPT_TEST_SEGMENTS, pcpCluster));
+
+	// record runtimes and calibrate the default params against them
+	CCostModelCalibrator calibrator(pmp, GPOPT_TEST_SEGMENTS, pcpDefault, pdrgpulParams);
+	const ULONG ulSize = pdrgpexprhdl->UlLength();
+	for (ULONG ul = 0; ul < ulSize; ul++)
+	{
+		CCost costRuntime = a_pcmCluster->Cost(*(*pdrgpexprhdl)[ul], (*pdrgpci)[ul]);
+		calibrator.AddObservation(*(*pdrgpexprhdl)[ul], (*pdrgpci)[ul], costRuntime);
+	}
+
+	CCostModelParamsGPDB *pcpFit = calibrator.PcpFit();
+	CCostModelCalibrator calibratorFit(pmp, GPOPT_TEST_SEGMENTS, pcpFit, GPOS_NEW(pmp) DrgPul(pmp));
+	for (ULONG ul = 0; ul < ulSize; ul++)
+	{
+		CCost costRuntime = a_pcmCluster->Cost(*(*pdrgpexprhdl)[ul], (*pdrgpci)[ul]);
+		calibratorFit.AddObservation(*(*pdrgpexprhdl)[ul], (*pdrgpci)[ul], costRuntime);
+	}
+
+	{
+		CAutoTrace at(pmp);
+		at.Os()
+			<< "Observations: " << calibrator.UlObservations()
+			<< ", squared error before calibration: " << calibrator.DSquaredError()
+			<< ", after calibration: " << calibratorFit.DSquaredError();
+	}
+
+	GPOS_RESULT eres = GPOS_OK;
+	if (calibratorFit.DSquaredError() >= calibrator.DSquaredError())
+	{
+		eres = GPOS_FAILED;
+	}
+
+	// clean up
+	pcpFit->Release();
+	pdrgpci->Release();
+	pdrgpexprhdl->Release();
+	pexprPlan->Release();
+
+	return eres;
+}
+
 // EOF
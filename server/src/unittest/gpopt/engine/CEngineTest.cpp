@@ -8,7 +8,10 @@
 //	@doc:
 //		Test for CEngine
 //---------------------------------------------------------------------------
+#include "gpos/common/CWallClock.h"
 #include "gpos/task/CAutoTraceFlag.h"
+#include "gpos/io/COstreamString.h"
+#include "gpos/string/CWStringDynamic.h"
 
 #include "gpopt/base/CUtils.h"
 #include "gpopt/base/CColRefSetIter.h"
@@ -16,8 +19,10 @@
 #include "gpopt/eval/CConstExprEvaluatorDefault.h"
 #include "gpopt/search/CGroup.h"
 #include "gpopt/search/CGroupProxy.h"
+#include "gpopt/search/CStatsCache.h"
 #include "gpopt/mdcache/CMDCache.h"
 #include "gpopt/operators/ops.h"
+#include "gpopt/optimizer/COptimizerConfig.h"
 
 #include "unittest/base.h"
 #include "unittest/gpopt/engine/CEngineTest.h"
@@ -40,6 +45,10 @@ CEngineTest::EresUnittest()
 	CUnittest rgut[] =
 	{
 		GPOS_UNITTEST_FUNC(EresUnittest_Basic),
+		GPOS_UNITTEST_FUNC(EresUnittest_SpacePruning),
+		GPOS_UNITTEST_FUNC(EresUnittest_Deadline),
+		GPOS_UNITTEST_FUNC(EresUnittest_DeadlineWorkers),
+		GPOS_UNITTEST_FUNC(EresUnittest_StatsCache),
 #ifdef GPOS_DEBUG
 		GPOS_UNITTEST_FUNC(EresUnittest_BuildMemo),
 		GPOS_UNITTEST_FUNC(EresUnittest_AppendStats),
@@ -122,6 +131,485 @@ CEngineTest::EresUnittest_Basic()
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngineTest::UlpOptimizeAndPrint
+//
+//	@doc:
+//		Optimize expression and print resulting plan into given stream;
+//		return number of pruned group expression optimizations
+//
+//---------------------------------------------------------------------------
+ULONG_PTR
+CEngineTest::UlpOptimizeAndPrint
+	(
+	IMemoryPool *pmp,
+	CExpression *pexpr,
+	IOstream &os
+	)
+{
+	CQueryContext *pqc = CTestUtils::PqcGenerate(pmp, pexpr);
+
+	CEngine eng(pmp);
+	eng.Init(pqc, NULL /*pdrgpss*/);
+	eng.Optimize();
+
+	CExpression *pexprPlan = eng.PexprExtractPlan();
+	GPOS_ASSERT(NULL != pexprPlan);
+
+	os << *pexprPlan;
+
+	pexprPlan->Release();
+	GPOS_DELETE(pqc);
+
+	return eng.UlpPruned();
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngineTest::EresUnittest_SpacePruning
+//
+//	@doc:
+//		Optimize join expressions with and without space pruning, and check
+//		that plans are the same
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CEngineTest::EresUnittest_SpacePruning()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	// array of relation names
+	CWStringConst rgscRel[] =
+	{
+		GPOS_WSZ_LIT("Rel1"),
+		GPOS_WSZ_LIT("Rel2"),
+		GPOS_WSZ_LIT("Rel3"),
+		GPOS_WSZ_LIT("Rel4"),
+	};
+
+	// array of relation IDs
+	ULONG rgulRel[] =
+	{
+		GPOPT_TEST_REL_OID1,
+		GPOPT_TEST_REL_OID2,
+		GPOPT_TEST_REL_OID3,
+		GPOPT_TEST_REL_OID4,
+	};
+
+	const ULONG ulRels = GPOS_ARRAY_SIZE(rgscRel);
+
+	// setup a file-based provider
+	CMDProviderMemory *pmdp = CTestUtils::m_pmdpf;
+	pmdp->AddRef();
+	CMDAccessor mda(pmp, CMDCache::Pcache());
+	mda.RegisterProvider(CTestUtils::m_sysidDefault, pmdp);
+
+	GPOS_RESULT eres = GPOS_OK;
+
+	// scope for optimization context
+	{
+		CAutoOptCtxt aoc
+					(
+					pmp,
+					&mda,
+					NULL, /* pceeval */
+					CTestUtils::Pcm(pmp)
+					);
+
+		DrgPexprJoins *pdrgpexpr = CTestUtils::PdrgpexprJoins(pmp, rgscRel, rgulRel, ulRels, false /*fCrossProduct*/);
+
+		ULONG_PTR ulpPruned = 0;
+		for (ULONG ul = 0; GPOS_OK == eres && ul < ulRels; ul++)
+		{
+			CWStringDynamic strExhaustive(pmp);
+			COstreamString ossExhaustive(&strExhaustive);
+			ULONG_PTR ulpPrunedExhaustive = UlpOptimizeAndPrint(pmp, (*pdrgpexpr)[ul], ossExhaustive);
+			if (0 != ulpPrunedExhaustive)
+			{
+				eres = GPOS_FAILED;
+			}
+
+			CWStringDynamic strPruned(pmp);
+			COstreamString ossPruned(&strPruned);
+			{
+				CAutoTraceFlag atf(EopttraceEnableSpacePruning, true /*fVal*/);
+				ulpPruned += UlpOptimizeAndPrint(pmp, (*pdrgpexpr)[ul], ossPruned);
+			}
+
+			if (!strExhaustive.FEquals(&strPruned))
+			{
+				CAutoTrace at(pmp);
+				at.Os()
+					<< "Plan with space pruning differs from exhaustive search:" << std::endl
+					<< strExhaustive.Wsz() << std::endl
+					<< strPruned.Wsz() << std::endl;
+
+				eres = GPOS_FAILED;
+			}
+		}
+
+		{
+			CAutoTrace at(pmp);
+			at.Os() << "Pruned group expression optimizations: " << (ULONG) ulpPruned;
+		}
+
+		(*pdrgpexpr)[ulRels - 1]->Release();
+		pdrgpexpr->Release();
+	}
+
+	return eres;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngineTest::RecordPlanCost
+//
+//	@doc:
+//		Plan callback recording the costs of reported plans
+//
+//---------------------------------------------------------------------------
+void
+CEngineTest::RecordPlanCost
+	(
+	void *pvArg,
+	CExpression *pexprPlan
+	)
+{
+	DrgPcost *pdrgpcost = reinterpret_cast<DrgPcost *>(pvArg);
+	IMemoryPool *pmp = COptCtxt::PoctxtFromTLS()->Pmp();
+
+	pdrgpcost->Append(GPOS_NEW(pmp) CCost(pexprPlan->Cost()));
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngineTest::PoconfDeadline
+//
+//	@doc:
+//		Default optimizer configuration with the given number of workers
+//		and optimization deadline
+//
+//---------------------------------------------------------------------------
+COptimizerConfig *
+CEngineTest::PoconfDeadline
+	(
+	IMemoryPool *pmp,
+	ULONG ulWorkers,
+	ULONG ulDeadline
+	)
+{
+	CHint *phintDefault = CHint::PhintDefault(pmp);
+	COptimizerConfig *poconf = GPOS_NEW(pmp) COptimizerConfig
+						(
+						GPOS_NEW(pmp) CEnumeratorConfig(pmp, 0 /*ullPlanId*/, 0 /*ullSamples*/),
+						CStatisticsConfig::PstatsconfDefault(pmp),
+						CCTEConfig::PcteconfDefault(pmp),
+						CTestUtils::Pcm(pmp),
+						GPOS_NEW(pmp) CHint
+							(
+							phintDefault->UlMinNumOfPartsToRequireSortOnInsert(),
+							phintDefault->UlJoinArityForAssociativityCommutativity(),
+							phintDefault->UlArrayExpansionThreshold(),
+							phintDefault->UlJoinOrderDPLimit(),
+							phintDefault->UlBroadcastThreshold(),
+							phintDefault->FEnforceConstraintsOnDML(),
+							ulWorkers,
+							ulDeadline
+							),
+						CWindowOids::Pwindowoids(pmp)
+						);
+	phintDefault->Release();
+
+	return poconf;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngineTest::EresUnittest_Deadline
+//
+//	@doc:
+//		Optimize a join with a deadline that passes right away; optimization
+//		stops after the first plan is found, each reported plan is cheaper
+//		than the previous one, and the extracted plan is the last reported
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CEngineTest::EresUnittest_Deadline()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	// array of relation names
+	CWStringConst rgscRel[] =
+	{
+		GPOS_WSZ_LIT("Rel1"),
+		GPOS_WSZ_LIT("Rel2"),
+		GPOS_WSZ_LIT("Rel3"),
+		GPOS_WSZ_LIT("Rel4"),
+		GPOS_WSZ_LIT("Rel5"),
+	};
+
+	// array of relation IDs
+	ULONG rgulRel[] =
+	{
+		GPOPT_TEST_REL_OID1,
+		GPOPT_TEST_REL_OID2,
+		GPOPT_TEST_REL_OID3,
+		GPOPT_TEST_REL_OID4,
+		GPOPT_TEST_REL_OID5,
+	};
+
+	const ULONG ulRels = GPOS_ARRAY_SIZE(rgscRel);
+
+	// setup a file-based provider
+	CMDProviderMemory *pmdp = CTestUtils::m_pmdpf;
+	pmdp->AddRef();
+	CMDAccessor mda(pmp, CMDCache::Pcache(), CTestUtils::m_sysidDefault, pmdp);
+
+	// configuration with a deadline of zero milliseconds
+	COptimizerConfig *poconf = PoconfDeadline(pmp, 1 /*ulWorkers*/, 0 /*ulDeadline*/);
+
+	GPOS_RESULT eres = GPOS_OK;
+
+	// scope for optimization context
+	{
+		CAutoOptCtxt aoc(pmp, &mda, NULL /*pceeval*/, poconf);
+
+		DrgPexprJoins *pdrgpexpr = CTestUtils::PdrgpexprJoins(pmp, rgscRel, rgulRel, ulRels, false /*fCrossProduct*/);
+		CQueryContext *pqc = CTestUtils::PqcGenerate(pmp, (*pdrgpexpr)[ulRels - 1]);
+
+		DrgPcost *pdrgpcost = GPOS_NEW(pmp) DrgPcost(pmp);
+
+		CEngine eng(pmp);
+		eng.Init(pqc, NULL /*pdrgpss*/);
+		eng.SetPlanCallback(RecordPlanCost, pdrgpcost);
+		eng.Optimize();
+
+		CExpression *pexprPlan = eng.PexprExtractPlan();
+		GPOS_ASSERT(NULL != pexprPlan);
+
+		const ULONG ulPlans = pdrgpcost->UlLength();
+		if (0 == ulPlans || ulPlans != eng.UlPlansReported())
+		{
+			eres = GPOS_FAILED;
+		}
+
+		for (ULONG ul = 1; ul < ulPlans; ul++)
+		{
+			if (!(*(*pdrgpcost)[ul] < *(*pdrgpcost)[ul - 1]))
+			{
+				eres = GPOS_FAILED;
+			}
+		}
+
+		if (0 < ulPlans && pexprPlan->Cost() > *(*pdrgpcost)[ulPlans - 1])
+		{
+			eres = GPOS_FAILED;
+		}
+
+		{
+			CAutoTrace at(pmp);
+			at.Os() << "Plans reported before deadline: " << ulPlans;
+		}
+
+		pexprPlan->Release();
+		pdrgpcost->Release();
+		GPOS_DELETE(pqc);
+		(*pdrgpexpr)[ulRels - 1]->Release();
+		pdrgpexpr->Release();
+	}
+
+	return eres;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngineTest::EresUnittest_DeadlineWorkers
+//
+//	@doc:
+//		Optimize a larger join on several workers with a short deadline; if
+//		the engine reports the deadline as passed, at least as much wall
+//		clock time must have elapsed, however much CPU time the workers used
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CEngineTest::EresUnittest_DeadlineWorkers()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	// array of relation names
+	CWStringConst rgscRel[] =
+	{
+		GPOS_WSZ_LIT("Rel1"),
+		GPOS_WSZ_LIT("Rel2"),
+		GPOS_WSZ_LIT("Rel3"),
+		GPOS_WSZ_LIT("Rel4"),
+		GPOS_WSZ_LIT("Rel5"),
+		GPOS_WSZ_LIT("Rel6"),
+		GPOS_WSZ_LIT("Rel7"),
+		GPOS_WSZ_LIT("Rel8"),
+	};
+
+	// array of relation IDs
+	ULONG rgulRel[] =
+	{
+		GPOPT_TEST_REL_OID1,
+		GPOPT_TEST_REL_OID2,
+		GPOPT_TEST_REL_OID3,
+		GPOPT_TEST_REL_OID4,
+		GPOPT_TEST_REL_OID5,
+		GPOPT_TEST_REL_OID6,
+		GPOPT_TEST_REL_OID7,
+		GPOPT_TEST_REL_OID8,
+	};
+
+	const ULONG ulRels = GPOS_ARRAY_SIZE(rgscRel);
+	const ULONG ulWorkers = 4;
+	const ULONG ulDeadline = 50;
+
+	// setup a file-based provider
+	CMDProviderMemory *pmdp = CTestUtils::m_pmdpf;
+	pmdp->AddRef();
+	CMDAccessor mda(pmp, CMDCache::Pcache(), CTestUtils::m_sysidDefault, pmdp);
+
+	COptimizerConfig *poconf = PoconfDeadline(pmp, ulWorkers, ulDeadline);
+
+	GPOS_RESULT eres = GPOS_OK;
+
+	// scope for optimization context
+	{
+		CAutoOptCtxt aoc(pmp, &mda, NULL /*pceeval*/, poconf);
+
+		DrgPexprJoins *pdrgpexpr = CTestUtils::PdrgpexprJoins(pmp, rgscRel, rgulRel, ulRels, false /*fCrossProduct*/);
+		CQueryContext *pqc = CTestUtils::PqcGenerate(pmp, (*pdrgpexpr)[ulRels - 1]);
+
+		CEngine eng(pmp);
+		eng.Init(pqc, NULL /*pdrgpss*/);
+
+		CWallClock clock;
+		eng.Optimize();
+		const ULONG ulElapsedMS = clock.UlElapsedMS();
+
+		const BOOL fDeadlineExceeded = eng.FDeadlineExceeded();
+		if (fDeadlineExceeded && ulElapsedMS < ulDeadline)
+		{
+			eres = GPOS_FAILED;
+		}
+
+		CExpression *pexprPlan = eng.PexprExtractPlan();
+		GPOS_ASSERT(NULL != pexprPlan);
+
+		{
+			CAutoTrace at(pmp);
+			at.Os()
+				<< "Workers: " << ulWorkers
+				<< ", deadline: " << ulDeadline << " msec"
+				<< ", elapsed: " << ulElapsedMS << " msec"
+				<< ", deadline exceeded: " << fDeadlineExceeded;
+		}
+
+		pexprPlan->Release();
+		GPOS_DELETE(pqc);
+		(*pdrgpexpr)[ulRels - 1]->Release();
+		pdrgpexpr->Release();
+	}
+
+	return eres;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CEngineTest::EresUnittest_StatsCache
+//
+//	@doc:
+//		Optimize a join and check that stats computed during costing are
+//		shared by optimization contexts that only differ in required plan
+//		properties
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CEngineTest::EresUnittest_StatsCache()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	// array of relation names
+	CWStringConst rgscRel[] =
+	{
+		GPOS_WSZ_LIT("Rel1"),
+		GPOS_WSZ_LIT("Rel2"),
+		GPOS_WSZ_LIT("Rel3"),
+		GPOS_WSZ_LIT("Rel4"),
+	};
+
+	// array of relation IDs
+	ULONG rgulRel[] =
+	{
+		GPOPT_TEST_REL_OID1,
+		GPOPT_TEST_REL_OID2,
+		GPOPT_TEST_REL_OID3,
+		GPOPT_TEST_REL_OID4,
+	};
+
+	const ULONG ulRels = GPOS_ARRAY_SIZE(rgscRel);
+
+	// setup a file-based provider
+	CMDProviderMemory *pmdp = CTestUtils::m_pmdpf;
+	pmdp->AddRef();
+	CMDAccessor mda(pmp, CMDCache::Pcache(), CTestUtils::m_sysidDefault, pmdp);
+
+	GPOS_RESULT eres = GPOS_OK;
+
+	// scope for optimization context
+	{
+		CAutoOptCtxt aoc
+					(
+					pmp,
+					&mda,
+					NULL, /* pceeval */
+					CTestUtils::Pcm(pmp)
+					);
+
+		DrgPexprJoins *pdrgpexpr = CTestUtils::PdrgpexprJoins(pmp, rgscRel, rgulRel, ulRels, false /*fCrossProduct*/);
+		CQueryContext *pqc = CTestUtils::PqcGenerate(pmp, (*pdrgpexpr)[ulRels - 1]);
+
+		CEngine eng(pmp);
+		eng.Init(pqc, NULL /*pdrgpss*/);
+		eng.Optimize();
+
+		CStatsCache *pstatscache = eng.Pstatscache();
+
+		// every lookup either hits or inserts a new stats object
+		if (0 == pstatscache->UlpHits() ||
+			pstatscache->UlpLookups() != pstatscache->UlpHits() + pstatscache->UlpEntries())
+		{
+			eres = GPOS_FAILED;
+		}
+
+		{
+			CAutoTrace at(pmp);
+			at.Os() << "Stats cache: ";
+			(void) pstatscache->OsPrint(at.Os());
+		}
+
+		GPOS_DELETE(pqc);
+		(*pdrgpexpr)[ulRels - 1]->Release();
+		pdrgpexpr->Release();
+	}
+
+	return eres;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CEngineTest::EresOptimize
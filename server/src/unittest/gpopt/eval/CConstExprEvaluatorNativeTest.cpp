@@ -0,0 +1,459 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2018 Pivotal, Inc.
+//
+//	@filename:
+//		CConstExprEvaluatorNativeTest.cpp
+//
+//	@doc:
+//		Unit tests for CConstExprEvaluatorNative
+//---------------------------------------------------------------------------
+
+#include "naucrates/base/IDatumInt4.h"
+#include "naucrates/md/CMDIdGPDB.h"
+#include "naucrates/md/CMDTypeInt4GPDB.h"
+#include "naucrates/md/IMDTypeInt4.h"
+#include "naucrates/md/IMDTypeInt8.h"
+#include "naucrates/md/IMDTypeOid.h"
+
+#include "gpopt/base/CDefaultComparator.h"
+#include "gpopt/base/CUtils.h"
+#include "gpopt/eval/CConstExprEvaluatorNative.h"
+#include "gpopt/mdcache/CMDAccessor.h"
+#include "gpopt/operators/CExpression.h"
+#include "gpopt/operators/CScalarCmp.h"
+#include "gpopt/operators/CScalarConst.h"
+#include "gpopt/operators/CScalarOp.h"
+
+#include "unittest/gpopt/eval/CConstExprEvaluatorNativeTest.h"
+#include "unittest/base.h"
+#include "unittest/gpopt/CTestUtils.h"
+
+using namespace gpnaucrates;
+using namespace gpopt;
+
+// int4 addition operator in the test metadata
+#define GPDB_INT4_PLUS_OP OID(551)
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstExprEvaluatorNativeTest::EresUnittest
+//
+//	@doc:
+//		Executes all unit tests for CConstExprEvaluatorNative
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CConstExprEvaluatorNativeTest::EresUnittest()
+{
+	CUnittest rgut[] =
+		{
+		GPOS_UNITTEST_FUNC(CConstExprEvaluatorNativeTest::EresUnittest_Arithmetic),
+		GPOS_UNITTEST_FUNC(CConstExprEvaluatorNativeTest::EresUnittest_Comparisons),
+		GPOS_UNITTEST_FUNC(CConstExprEvaluatorNativeTest::EresUnittest_BoolOps),
+		GPOS_UNITTEST_FUNC(CConstExprEvaluatorNativeTest::EresUnittest_Casts),
+		GPOS_UNITTEST_FUNC(CConstExprEvaluatorNativeTest::EresUnittest_Unsupported),
+		GPOS_UNITTEST_FUNC(CConstExprEvaluatorNativeTest::EresUnittest_Comparator),
+		};
+
+	return CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstExprEvaluatorNativeTest::EresCheck
+//
+//	@doc:
+//		Evaluate an expression and compare the result to the expected
+//		constant; releases both expressions
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CConstExprEvaluatorNativeTest::EresCheck
+	(
+	CConstExprEvaluatorNative *pceeval,
+	CExpression *pexpr,
+	CExpression *pexprExpected
+	)
+{
+	GPOS_RESULT eres = GPOS_FAILED;
+
+	CExpression *pexprResult = pceeval->PexprEval(pexpr);
+	if (COperator::EopScalarConst == pexprResult->Pop()->Eopid() &&
+		CScalarConst::PopConvert(pexprResult->Pop())->FMatch(pexprExpected->Pop()))
+	{
+		eres = GPOS_OK;
+	}
+
+	pexprResult->Release();
+	pexprExpected->Release();
+	pexpr->Release();
+
+	return eres;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstExprEvaluatorNativeTest::PexprInt4
+//
+//	@doc:
+//		Int4 constant which may be NULL
+//
+//---------------------------------------------------------------------------
+CExpression *
+CConstExprEvaluatorNativeTest::PexprInt4
+	(
+	IMemoryPool *pmp,
+	INT iVal,
+	BOOL fNull
+	)
+{
+	CMDAccessor *pmda = COptCtxt::PoctxtFromTLS()->Pmda();
+	IDatumInt4 *pdatum = pmda->PtMDType<IMDTypeInt4>()->PdatumInt4(pmp, iVal, fNull);
+
+	return GPOS_NEW(pmp) CExpression(pmp, GPOS_NEW(pmp) CScalarConst(pmp, (IDatum *) pdatum));
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstExprEvaluatorNativeTest::PexprInt4Plus
+//
+//	@doc:
+//		Int4 addition
+//
+//---------------------------------------------------------------------------
+CExpression *
+CConstExprEvaluatorNativeTest::PexprInt4Plus
+	(
+	IMemoryPool *pmp,
+	CExpression *pexprLeft,
+	CExpression *pexprRight
+	)
+{
+	CMDAccessor *pmda = COptCtxt::PoctxtFromTLS()->Pmda();
+	IMDId *pmdidInt4 = pmda->PtMDType<IMDTypeInt4>()->Pmdid();
+	pmdidInt4->AddRef();
+
+	CScalarOp *pop = GPOS_NEW(pmp) CScalarOp
+									(
+									pmp,
+									GPOS_NEW(pmp) CMDIdGPDB(GPDB_INT4_PLUS_OP),
+									pmdidInt4,
+									GPOS_NEW(pmp) CWStringConst(pmp, GPOS_WSZ_LIT("+"))
+									);
+
+	return GPOS_NEW(pmp) CExpression(pmp, pop, pexprLeft, pexprRight);
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstExprEvaluatorNativeTest::EresUnittest_Arithmetic
+//
+//	@doc:
+//		Test evaluation of arithmetic operators, including NULL inputs and
+//		overflow
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CConstExprEvaluatorNativeTest::EresUnittest_Arithmetic()
+{
+	CTestUtils::CTestSetup testsetup;
+	IMemoryPool *pmp = testsetup.Pmp();
+	CConstExprEvaluatorNative *pceeval = GPOS_NEW(pmp) CConstExprEvaluatorNative(pmp, NULL /*pceevalFallback*/);
+
+	// (200 + 100) + -50
+	CExpression *pexpr = PexprInt4Plus
+							(
+							pmp,
+							PexprInt4Plus(pmp, CUtils::PexprScalarConstInt4(pmp, 200), CUtils::PexprScalarConstInt4(pmp, 100)),
+							CUtils::PexprScalarConstInt4(pmp, -50)
+							);
+	GPOS_RESULT eres = EresCheck(pceeval, pexpr, CUtils::PexprScalarConstInt4(pmp, 250));
+
+	// 1 + NULL
+	if (GPOS_OK == eres)
+	{
+		pexpr = PexprInt4Plus(pmp, CUtils::PexprScalarConstInt4(pmp, 1), PexprInt4(pmp, 0, true /*fNull*/));
+		eres = EresCheck(pceeval, pexpr, PexprInt4(pmp, 0, true /*fNull*/));
+	}
+
+	// overflow is not evaluated natively, the input is returned unchanged
+	if (GPOS_OK == eres)
+	{
+		pexpr = PexprInt4Plus(pmp, CUtils::PexprScalarConstInt4(pmp, gpos::int_max), CUtils::PexprScalarConstInt4(pmp, 1));
+		GPOS_ASSERT(!CConstExprEvaluatorNative::FCanEvalNatively(pexpr));
+
+		CExpression *pexprResult = pceeval->PexprEval(pexpr);
+		if (pexprResult != pexpr)
+		{
+			eres = GPOS_FAILED;
+		}
+		pexprResult->Release();
+		pexpr->Release();
+	}
+
+	pceeval->Release();
+
+	return eres;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstExprEvaluatorNativeTest::EresUnittest_Comparisons
+//
+//	@doc:
+//		Test evaluation of comparisons and IS DISTINCT FROM
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CConstExprEvaluatorNativeTest::EresUnittest_Comparisons()
+{
+	CTestUtils::CTestSetup testsetup;
+	IMemoryPool *pmp = testsetup.Pmp();
+	CConstExprEvaluatorNative *pceeval = GPOS_NEW(pmp) CConstExprEvaluatorNative(pmp, NULL /*pceevalFallback*/);
+
+	// 1 < 2
+	CExpression *pexpr = CUtils::PexprScalarCmp
+							(
+							pmp,
+							CUtils::PexprScalarConstInt4(pmp, 1),
+							CUtils::PexprScalarConstInt4(pmp, 2),
+							IMDType::EcmptL
+							);
+	GPOS_RESULT eres = EresCheck(pceeval, pexpr, CUtils::PexprScalarConstBool(pmp, true /*fVal*/));
+
+	// 1 = NULL
+	if (GPOS_OK == eres)
+	{
+		pexpr = CUtils::PexprScalarEqCmp(pmp, CUtils::PexprScalarConstInt4(pmp, 1), PexprInt4(pmp, 0, true /*fNull*/));
+		eres = EresCheck(pceeval, pexpr, CUtils::PexprScalarConstBool(pmp, false /*fVal*/, true /*fNull*/));
+	}
+
+	// 1 IS DISTINCT FROM NULL
+	if (GPOS_OK == eres)
+	{
+		pexpr = CUtils::PexprIDF(pmp, CUtils::PexprScalarConstInt4(pmp, 1), PexprInt4(pmp, 0, true /*fNull*/));
+		eres = EresCheck(pceeval, pexpr, CUtils::PexprScalarConstBool(pmp, true /*fVal*/));
+	}
+
+	// NULL IS DISTINCT FROM NULL
+	if (GPOS_OK == eres)
+	{
+		pexpr = CUtils::PexprIDF(pmp, PexprInt4(pmp, 0, true /*fNull*/), PexprInt4(pmp, 0, true /*fNull*/));
+		eres = EresCheck(pceeval, pexpr, CUtils::PexprScalarConstBool(pmp, false /*fVal*/));
+	}
+
+	// 1 = true through the int4 equality operator does not compare values
+	// of comparable types and is returned unchanged
+	if (GPOS_OK == eres)
+	{
+		CScalarCmp *popCmp = GPOS_NEW(pmp) CScalarCmp
+										(
+										pmp,
+										GPOS_NEW(pmp) CMDIdGPDB(GPDB_INT4_EQ_OP),
+										GPOS_NEW(pmp) CWStringConst(pmp, GPOS_WSZ_LIT("=")),
+										IMDType::EcmptEq
+										);
+		pexpr = GPOS_NEW(pmp) CExpression
+								(
+								pmp,
+								popCmp,
+								CUtils::PexprScalarConstInt4(pmp, 1),
+								CUtils::PexprScalarConstBool(pmp, true /*fVal*/)
+								);
+
+		CExpression *pexprResult = pceeval->PexprEval(pexpr);
+		if (CConstExprEvaluatorNative::FCanEvalNatively(pexpr) || pexprResult != pexpr)
+		{
+			eres = GPOS_FAILED;
+		}
+		pexprResult->Release();
+		pexpr->Release();
+	}
+
+	pceeval->Release();
+
+	return eres;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstExprEvaluatorNativeTest::EresUnittest_BoolOps
+//
+//	@doc:
+//		Test three-valued evaluation of boolean operators and null tests
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CConstExprEvaluatorNativeTest::EresUnittest_BoolOps()
+{
+	CTestUtils::CTestSetup testsetup;
+	IMemoryPool *pmp = testsetup.Pmp();
+	CConstExprEvaluatorNative *pceeval = GPOS_NEW(pmp) CConstExprEvaluatorNative(pmp, NULL /*pceevalFallback*/);
+
+	// false AND NULL
+	DrgPexpr *pdrgpexpr = GPOS_NEW(pmp) DrgPexpr(pmp);
+	pdrgpexpr->Append(CUtils::PexprScalarConstBool(pmp, false /*fVal*/));
+	pdrgpexpr->Append(CUtils::PexprScalarConstBool(pmp, false /*fVal*/, true /*fNull*/));
+	CExpression *pexpr = CUtils::PexprScalarBoolOp(pmp, CScalarBoolOp::EboolopAnd, pdrgpexpr);
+	GPOS_RESULT eres = EresCheck(pceeval, pexpr, CUtils::PexprScalarConstBool(pmp, false /*fVal*/));
+
+	// false OR NULL
+	if (GPOS_OK == eres)
+	{
+		pdrgpexpr = GPOS_NEW(pmp) DrgPexpr(pmp);
+		pdrgpexpr->Append(CUtils::PexprScalarConstBool(pmp, false /*fVal*/));
+		pdrgpexpr->Append(CUtils::PexprScalarConstBool(pmp, false /*fVal*/, true /*fNull*/));
+		pexpr = CUtils::PexprScalarBoolOp(pmp, CScalarBoolOp::EboolopOr, pdrgpexpr);
+		eres = EresCheck(pceeval, pexpr, CUtils::PexprScalarConstBool(pmp, false /*fVal*/, true /*fNull*/));
+	}
+
+	// NOT true
+	if (GPOS_OK == eres)
+	{
+		pexpr = CUtils::PexprNegate(pmp, CUtils::PexprScalarConstBool(pmp, true /*fVal*/));
+		eres = EresCheck(pceeval, pexpr, CUtils::PexprScalarConstBool(pmp, false /*fVal*/));
+	}
+
+	// NULL IS NULL
+	if (GPOS_OK == eres)
+	{
+		pexpr = CUtils::PexprIsNull(pmp, PexprInt4(pmp, 0, true /*fNull*/));
+		eres = EresCheck(pceeval, pexpr, CUtils::PexprScalarConstBool(pmp, true /*fVal*/));
+	}
+
+	pceeval->Release();
+
+	return eres;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstExprEvaluatorNativeTest::EresUnittest_Casts
+//
+//	@doc:
+//		Test evaluation of casts
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CConstExprEvaluatorNativeTest::EresUnittest_Casts()
+{
+	CTestUtils::CTestSetup testsetup;
+	IMemoryPool *pmp = testsetup.Pmp();
+	CMDAccessor *pmda = testsetup.Pmda();
+	CConstExprEvaluatorNative *pceeval = GPOS_NEW(pmp) CConstExprEvaluatorNative(pmp, NULL /*pceevalFallback*/);
+
+	// int4 to int8
+	CExpression *pexpr = CUtils::PexprCast
+							(
+							pmp,
+							pmda,
+							CUtils::PexprScalarConstInt4(pmp, -7),
+							pmda->PtMDType<IMDTypeInt8>()->Pmdid()
+							);
+	GPOS_RESULT eres = EresCheck(pceeval, pexpr, CUtils::PexprScalarConstInt8(pmp, -7));
+
+	// int4 to oid is binary coercible
+	if (GPOS_OK == eres)
+	{
+		pexpr = CUtils::PexprCast
+					(
+					pmp,
+					pmda,
+					CUtils::PexprScalarConstInt4(pmp, -1),
+					pmda->PtMDType<IMDTypeOid>()->Pmdid()
+					);
+		eres = EresCheck(pceeval, pexpr, CUtils::PexprScalarConstOid(pmp, gpos::ulong_max));
+	}
+
+	pceeval->Release();
+
+	return eres;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstExprEvaluatorNativeTest::EresUnittest_Unsupported
+//
+//	@doc:
+//		Test that expressions with variables are not evaluated natively and
+//		are returned unchanged without a fallback evaluator
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CConstExprEvaluatorNativeTest::EresUnittest_Unsupported()
+{
+	CTestUtils::CTestSetup testsetup;
+	IMemoryPool *pmp = testsetup.Pmp();
+	CConstExprEvaluatorNative *pceeval = GPOS_NEW(pmp) CConstExprEvaluatorNative(pmp, NULL /*pceevalFallback*/);
+
+	const IMDTypeInt4 *pmdtypeint4 = testsetup.Pmda()->PtMDType<IMDTypeInt4>();
+	CColumnFactory *pcf = COptCtxt::PoctxtFromTLS()->Pcf();
+	CColRef *pcr = pcf->PcrCreate(pmdtypeint4, IDefaultTypeModifier);
+
+	CExpression *pexpr = CUtils::PexprScalarEqCmp
+							(
+							pmp,
+							CUtils::PexprScalarConstInt4(pmp, 200 /*iVal*/),
+							CUtils::PexprScalarIdent(pmp, pcr)
+							);
+
+	GPOS_RESULT eres = GPOS_OK;
+	CExpression *pexprResult = pceeval->PexprEval(pexpr);
+	if (CConstExprEvaluatorNative::FCanEvalNatively(pexpr) ||
+		!pceeval->FCanEvalExpressions() ||
+		pexprResult != pexpr)
+	{
+		eres = GPOS_FAILED;
+	}
+
+	pexprResult->Release();
+	pexpr->Release();
+	pceeval->Release();
+
+	return eres;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CConstExprEvaluatorNativeTest::EresUnittest_Comparator
+//
+//	@doc:
+//		Test that the default comparator can use the native evaluator alone
+//		when integer comparisons are forced through the evaluator
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CConstExprEvaluatorNativeTest::EresUnittest_Comparator()
+{
+	CAutoTraceFlag atfEval(EopttraceEnableConstantExpressionEvaluation, true /*fVal*/);
+	CAutoTraceFlag atfExternal(EopttraceUseExternalConstantExpressionEvaluationForInts, true /*fVal*/);
+
+	CTestUtils::CTestSetup testsetup;
+	IMemoryPool *pmp = testsetup.Pmp();
+	CConstExprEvaluatorNative *pceeval = GPOS_NEW(pmp) CConstExprEvaluatorNative(pmp, NULL /*pceevalFallback*/);
+	GPOS_ASSERT(pceeval->FCanEvalExpressions());
+
+	const IMDTypeInt4 *pmdtypeint4 = testsetup.Pmda()->PtMDType<IMDTypeInt4>();
+	IDatumInt4 *pdatumOne = pmdtypeint4->PdatumInt4(pmp, 1 /*iValue*/, false /*fNULL*/);
+	IDatumInt4 *pdatumTwo = pmdtypeint4->PdatumInt4(pmp, 2 /*iValue*/, false /*fNULL*/);
+
+	GPOS_RESULT eres = GPOS_OK;
+	{
+		CDefaultComparator comp(pceeval);
+		if (!comp.FLessThan(pdatumOne, pdatumTwo) ||
+			comp.FEqual(pdatumOne, pdatumTwo) ||
+			!comp.FGreaterThan(pdatumTwo, pdatumOne))
+		{
+			eres = GPOS_FAILED;
+		}
+	}
+
+	pdatumOne->Release();
+	pdatumTwo->Release();
+	pceeval->Release();
+
+	return eres;
+}
+
+// EOF
@@ -86,6 +86,7 @@ CMDAccessorTest::EresUnittest()
 		GPOS_UNITTEST_FUNC(CMDAccessorTest::EresUnittest_IndexPartConstraint),
 		GPOS_UNITTEST_FUNC(CMDAccessorTest::EresUnittest_Cast),
 		GPOS_UNITTEST_FUNC(CMDAccessorTest::EresUnittest_ScCmp),
+		GPOS_UNITTEST_FUNC(CMDAccessorTest::EresUnittest_Prefetch),
 		GPOS_UNITTEST_FUNC(CMDAccessorTest::EresUnittest_ConcurrentAccessSingleMDA),
 		GPOS_UNITTEST_FUNC(CMDAccessorTest::EresUnittest_ConcurrentAccessMultipleMDA)
 		};
@@ -720,6 +721,82 @@ CMDAccessorTest::EresUnittest_ScCmp()
 	return GPOS_OK;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CMDAccessorTest::EresUnittest_Prefetch
+//
+//	@doc:
+//		Test fetching a batch of metadata objects ahead of their use; ids
+//		unknown to the provider are skipped by the batch, and prefetched
+//		objects are not recorded by the accessor until they are used
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CMDAccessorTest::EresUnittest_Prefetch()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	// setup a file-based provider
+	CMDProviderMemory *pmdp = CTestUtils::m_pmdpf;
+	pmdp->AddRef();
+	CMDAccessor mda(pmp, CMDCache::Pcache(), CTestUtils::m_sysidDefault, pmdp);
+
+	// install opt context in TLS
+	CAutoOptCtxt aoc
+					(
+					pmp,
+					&mda,
+					NULL,  /* pceeval */
+					CTestUtils::Pcm(pmp)
+					);
+
+	CMDIdGPDB *pmdidRel = GPOS_NEW(pmp) CMDIdGPDB(GPOPT_MDCACHE_TEST_OID, 1, 1);
+	CMDIdGPDB *pmdidType = GPOS_NEW(pmp) CMDIdGPDB(GPDB_INT4, 1, 0);
+	CMDIdGPDB *pmdidOp = GPOS_NEW(pmp) CMDIdGPDB(GPDB_OP_INT4_LT, 1, 0);
+	CMDIdGPDB *pmdidUnknown = GPOS_NEW(pmp) CMDIdGPDB(GPOPT_MDCACHE_TEST_OID, 1000 /* major version */, 1 /* minor version */);
+
+	DrgPmdid *pdrgpmdid = GPOS_NEW(pmp) DrgPmdid(pmp);
+	pdrgpmdid->Append(pmdidRel);
+	pdrgpmdid->Append(pmdidType);
+	pdrgpmdid->Append(pmdidOp);
+	pdrgpmdid->Append(pmdidUnknown);
+
+	// the accessor serializes the objects it recorded, e.g. into minidumps
+	CWStringDynamic strRecordedBefore(pmp);
+	{
+		COstreamString oss(&strRecordedBefore);
+		mda.Serialize(oss);
+	}
+
+	// prefetching twice must not load objects again
+	mda.Prefetch(pdrgpmdid);
+	mda.Prefetch(pdrgpmdid);
+
+	CWStringDynamic strRecordedAfter(pmp);
+	{
+		COstreamString oss(&strRecordedAfter);
+		mda.Serialize(oss);
+	}
+
+	const IMDRelation *pmdrel = mda.Pmdrel(pmdidRel);
+	const IMDType *pmdtype = mda.Pmdtype(pmdidType);
+	const IMDScalarOp *pmdscop = mda.Pmdscop(pmdidOp);
+
+	GPOS_RESULT eres = GPOS_FAILED;
+	if (strRecordedBefore.FEquals(&strRecordedAfter) &&
+		pmdrel->Pmdid()->FEquals(pmdidRel) &&
+		pmdtype->Pmdid()->FEquals(pmdidType) &&
+		pmdscop->Pmdid()->FEquals(pmdidOp))
+	{
+		eres = GPOS_OK;
+	}
+
+	pdrgpmdid->Release();
+
+	return eres;
+}
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CMDAccessorTest::EresUnittest_Negative
@@ -36,6 +36,7 @@ ULONG CICGTest::m_ulUnsupportedTestCounter = 0; // start from first unsupported
 ULONG CICGTest::m_ulTestCounterPreferHashJoinToIndexJoin = 0;
 ULONG CICGTest::m_ulTestCounterPreferIndexJoinToHashJoin = 0;
 ULONG CICGTest::m_ulNegativeIndexApplyTestCounter = 0;
+ULONG CICGTest::m_ulInternScalarsTestCounter = 0;
 
 // minidump files
 const CHAR *rgszFileNames[] =
@@ -99,6 +100,41 @@ const CHAR *rgszPreferHashJoinVersusIndexJoin[] =
 		};
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CICGTest::UlMinidumps
+//
+//	@doc:
+//		Number of minidumps in the test corpus
+//
+//---------------------------------------------------------------------------
+ULONG
+CICGTest::UlMinidumps()
+{
+	return GPOS_ARRAY_SIZE(rgszFileNames);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CICGTest::SzMinidump
+//
+//	@doc:
+//		File name of the minidump at the given position in the test corpus
+//
+//---------------------------------------------------------------------------
+const CHAR *
+CICGTest::SzMinidump
+	(
+	ULONG ul
+	)
+{
+	GPOS_ASSERT(ul < UlMinidumps());
+
+	return rgszFileNames[ul];
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CICGTest::EresUnittest
@@ -117,6 +153,7 @@ CICGTest::EresUnittest()
 		GPOS_UNITTEST_FUNC(CICGTest::EresUnittest_NegativeIndexApplyTests),
 
 		GPOS_UNITTEST_FUNC(CICGTest::EresUnittest_RunMinidumpTests),
+		GPOS_UNITTEST_FUNC(CICGTest::EresUnittest_RunMinidumpTestsInternScalars),
 
 #ifndef GPOS_DEBUG
 		// This test is slow in debug build because it has to free a lot of memory structures
@@ -148,6 +185,24 @@ CICGTest::EresUnittest_RunMinidumpTests()
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CICGTest::EresUnittest_RunMinidumpTestsInternScalars
+//
+//	@doc:
+//		Run all Minidump-based tests with scalar expressions interned;
+//		interning must not change the plans
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CICGTest::EresUnittest_RunMinidumpTestsInternScalars()
+{
+	CAutoTraceFlag atf(EopttraceInternScalars, true /*fVal*/);
+
+	return CTestUtils::EresUnittest_RunTests(rgszFileNames, &m_ulInternScalarsTestCounter, GPOS_ARRAY_SIZE(rgszFileNames));
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CICGTest::EresUnittest_RunUnsupportedMinidumpTests
@@ -0,0 +1,247 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CMemoryPoolBenchmarkTest.cpp
+//
+//	@doc:
+//		Compare memory pool types on optimizing a set of minidumps
+//---------------------------------------------------------------------------
+
+#include "gpos/base.h"
+#include "gpos/common/CAutoP.h"
+#include "gpos/common/CWallClock.h"
+#include "gpos/error/CAutoTrace.h"
+#include "gpos/io/COstreamString.h"
+#include "gpos/memory/CAutoMemoryPool.h"
+#include "gpos/test/CUnittest.h"
+
+#include "naucrates/dxl/CDXLUtils.h"
+#include "naucrates/dxl/operators/CDXLNode.h"
+
+#include "gpopt/mdcache/CMDCache.h"
+#include "gpopt/minidump/CDXLMinidump.h"
+#include "gpopt/minidump/CMetadataAccessorFactory.h"
+#include "gpopt/minidump/CMinidumperUtils.h"
+#include "gpopt/optimizer/COptimizerConfig.h"
+
+#include "unittest/gpopt/CTestUtils.h"
+#include "unittest/gpopt/minidump/CMemoryPoolBenchmarkTest.h"
+
+using namespace gpos;
+using namespace gpdxl;
+using namespace gpopt;
+
+// minidump files
+static const CHAR *rgszMemoryPoolBenchmarkMdpFiles[] =
+{
+	"../data/dxl/minidump/Agg-Limit.mdp",
+	"../data/dxl/minidump/JOIN-int4-Eq-int2.mdp",
+	"../data/dxl/minidump/CastOnSubquery.mdp",
+	"../data/dxl/minidump/TPCH-Q5.mdp",
+	"../data/dxl/minidump/HAWQ-TPCH09-NoTopBroadcast.mdp",
+};
+
+// pool types to compare
+static const CMemoryPoolManager::EAllocType rgeatBenchmark[] =
+{
+	CMemoryPoolManager::EatTracker,
+	CMemoryPoolManager::EatStack,
+	CMemoryPoolManager::EatSlab,
+};
+
+// pool type names
+static const CHAR *rgszPoolType[] =
+{
+	"tracker",
+	"stack",
+	"slab",
+};
+
+GPOS_CPL_ASSERT(GPOS_ARRAY_SIZE(rgeatBenchmark) == GPOS_ARRAY_SIZE(rgszPoolType));
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolBenchmarkTest::EresUnittest
+//
+//	@doc:
+//		Unittest for comparing memory pool types
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CMemoryPoolBenchmarkTest::EresUnittest()
+{
+	CUnittest rgut[] =
+		{
+		GPOS_UNITTEST_FUNC(CMemoryPoolBenchmarkTest::EresUnittest_ComparePoolTypes),
+		};
+
+	GPOS_RESULT eres = CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
+
+	// reset metadata cache
+	CMDCache::Reset();
+
+	return eres;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolBenchmarkTest::PstrOptimize
+//
+//	@doc:
+//		Optimize a minidump with all optimizer allocations going to a new
+//		pool of the given type
+//
+//---------------------------------------------------------------------------
+CWStringDynamic *
+CMemoryPoolBenchmarkTest::PstrOptimize
+	(
+	IMemoryPool *pmp,
+	CMemoryPoolManager::EAllocType eat,
+	const CHAR *szFileName,
+	ULONG *pulElapsedUS,
+	ULLONG *pullAllocated
+	)
+{
+	CWStringDynamic *pstrPlan = GPOS_NEW(pmp) CWStringDynamic(pmp);
+
+	// start every run with a cold metadata cache
+	CMDCache::Reset();
+
+	CAutoMemoryPool amp(CAutoMemoryPool::ElcExc, eat);
+	IMemoryPool *pmpOpt = amp.Pmp();
+
+	CWallClock clock;
+
+	CAutoP<CDXLMinidump> a_pdxlmd(CMinidumperUtils::PdxlmdLoad(pmpOpt, szFileName));
+	CMetadataAccessorFactory factory(pmpOpt, a_pdxlmd.Pt(), szFileName);
+
+	COptimizerConfig *poconf = a_pdxlmd->Poconf();
+	if (NULL == poconf)
+	{
+		poconf = COptimizerConfig::PoconfDefault(pmpOpt);
+	}
+	else
+	{
+		poconf->AddRef();
+	}
+
+	CDXLNode *pdxlnPlan = CMinidumperUtils::PdxlnExecuteMinidump
+							(
+							pmpOpt,
+							factory.Pmda(),
+							a_pdxlmd.Pt(),
+							szFileName,
+							CTestUtils::UlSegments(poconf),
+							1 /*ulSessionId*/,
+							1 /*ulCmdId*/,
+							poconf,
+							NULL /*pceeval*/
+							);
+
+	*pulElapsedUS = clock.UlElapsedUS();
+	*pullAllocated = pmpOpt->UllTotalAllocatedSize();
+
+	COstreamString oss(pstrPlan);
+	CDXLUtils::SerializePlan
+				(
+				pmpOpt,
+				oss,
+				pdxlnPlan,
+				0 /*ullPlanId*/,
+				0 /*ullPlanSpaceSize*/,
+				true /*fDocumentHeaderFooter*/,
+				false /*fIndent*/
+				);
+
+	pdxlnPlan->Release();
+	poconf->Release();
+
+	return pstrPlan;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CMemoryPoolBenchmarkTest::EresUnittest_ComparePoolTypes
+//
+//	@doc:
+//		Optimize each minidump in a pool of every type, report optimization
+//		time and pool size per type, and check that all pool types produce
+//		the same plan
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CMemoryPoolBenchmarkTest::EresUnittest_ComparePoolTypes()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	const ULONG ulTypes = GPOS_ARRAY_SIZE(rgeatBenchmark);
+	ULLONG rgullElapsedUS[GPOS_ARRAY_SIZE(rgeatBenchmark)];
+	ULLONG rgullMaxAllocated[GPOS_ARRAY_SIZE(rgeatBenchmark)];
+	for (ULONG ulType = 0; ulType < ulTypes; ulType++)
+	{
+		rgullElapsedUS[ulType] = 0;
+		rgullMaxAllocated[ulType] = 0;
+	}
+
+	BOOL fSamePlans = true;
+	for (ULONG ul = 0; ul < GPOS_ARRAY_SIZE(rgszMemoryPoolBenchmarkMdpFiles); ul++)
+	{
+		const CHAR *szFileName = rgszMemoryPoolBenchmarkMdpFiles[ul];
+		CWStringDynamic *pstrPlanFirst = NULL;
+
+		for (ULONG ulType = 0; ulType < ulTypes; ulType++)
+		{
+			ULONG ulElapsedUS = 0;
+			ULLONG ullAllocated = 0;
+			CWStringDynamic *pstrPlan =
+				PstrOptimize(pmp, rgeatBenchmark[ulType], szFileName, &ulElapsedUS, &ullAllocated);
+
+			rgullElapsedUS[ulType] += ulElapsedUS;
+			if (rgullMaxAllocated[ulType] < ullAllocated)
+			{
+				rgullMaxAllocated[ulType] = ullAllocated;
+			}
+
+			{
+				CAutoTrace at(pmp);
+				at.Os()
+					<< "Memory pool benchmark: " << szFileName
+					<< ", pool: " << rgszPoolType[ulType]
+					<< ", time (us): " << ulElapsedUS
+					<< ", allocated (bytes): " << ullAllocated;
+			}
+
+			if (NULL == pstrPlanFirst)
+			{
+				pstrPlanFirst = pstrPlan;
+				continue;
+			}
+
+			if (!pstrPlanFirst->FEquals(pstrPlan))
+			{
+				CAutoTrace at(pmp);
+				at.Os() << "Plan differs from " << rgszPoolType[0] << " pool: " << szFileName;
+				fSamePlans = false;
+			}
+			GPOS_DELETE(pstrPlan);
+		}
+
+		GPOS_DELETE(pstrPlanFirst);
+	}
+
+	for (ULONG ulType = 0; ulType < ulTypes; ulType++)
+	{
+		CAutoTrace at(pmp);
+		at.Os()
+			<< "Memory pool benchmark total, pool: " << rgszPoolType[ulType]
+			<< ", time (us): " << rgullElapsedUS[ulType]
+			<< ", max allocated (bytes): " << rgullMaxAllocated[ulType];
+	}
+
+	return fSamePlans ? GPOS_OK : GPOS_FAILED;
+}
+
+// EOF
@@ -10,12 +10,24 @@
 //---------------------------------------------------------------------------
 
 #include "gpos/base.h"
+#include "gpos/common/CAutoP.h"
+#include "gpos/common/CWallClock.h"
+#include "gpos/error/CAutoTrace.h"
+#include "gpos/io/COstreamString.h"
 #include "gpos/memory/CAutoMemoryPool.h"
+#include "gpos/string/CWStringDynamic.h"
 #include "gpos/task/CAutoTraceFlag.h"
 #include "gpos/test/CUnittest.h"
 
+#include "naucrates/dxl/CDXLUtils.h"
+#include "naucrates/dxl/operators/CDXLNode.h"
+
 #include "gpopt/exception.h"
+#include "gpopt/mdcache/CMDCache.h"
+#include "gpopt/minidump/CDXLMinidump.h"
+#include "gpopt/minidump/CMetadataAccessorFactory.h"
 #include "gpopt/minidump/CMinidumperUtils.h"
+#include "gpopt/optimizer/COptimizerConfig.h"
 
 #include "unittest/gpopt/CTestUtils.h"
 
@@ -47,6 +59,9 @@ const CHAR *rgszMultilevel[] =
 		"../data/dxl/multilevel-partitioning/Multilevel-Nary-Join.mdp",
 };
 
+// minidump whose plan is serialized with and without shared scalar subtrees
+const CHAR *szSharedScalarsFile = "../data/dxl/multilevel-partitioning/Multilevel-JoinPred-AllLevels.mdp";
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CMultilevelPartitionTest::EresUnittest
@@ -62,6 +77,7 @@ CMultilevelPartitionTest::EresUnittest()
 	CUnittest rgut[] =
 	{
 			GPOS_UNITTEST_FUNC(EresUnittest_RunTests),
+			GPOS_UNITTEST_FUNC(EresUnittest_SharedScalars),
 	};
 
 	GPOS_RESULT eres = CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
@@ -101,4 +117,85 @@ CMultilevelPartitionTest::EresUnittest_RunTests()
 						);
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CMultilevelPartitionTest::EresUnittest_SharedScalars
+//
+//	@doc:
+//		Measure size and serialization time of a plan on a multilevel
+//		partitioned table with and without serializing shared scalar
+//		subtrees once; sharing must not grow the serialized plan
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CMultilevelPartitionTest::EresUnittest_SharedScalars()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	CAutoP<CDXLMinidump> a_pdxlmd(CMinidumperUtils::PdxlmdLoad(pmp, szSharedScalarsFile));
+	CMetadataAccessorFactory factory(pmp, a_pdxlmd.Pt(), szSharedScalarsFile);
+
+	COptimizerConfig *poconf = a_pdxlmd->Poconf();
+	if (NULL == poconf)
+	{
+		poconf = COptimizerConfig::PoconfDefault(pmp);
+	}
+	else
+	{
+		poconf->AddRef();
+	}
+
+	CDXLNode *pdxlnPlan = CMinidumperUtils::PdxlnExecuteMinidump
+							(
+							pmp,
+							factory.Pmda(),
+							a_pdxlmd.Pt(),
+							szSharedScalarsFile,
+							CTestUtils::UlSegments(poconf),
+							1 /*ulSessionId*/,
+							1 /*ulCmdId*/,
+							poconf,
+							NULL /*pceeval*/
+							);
+
+	// index 0: every subtree copied, index 1: shared subtrees serialized once
+	ULONG rgulLength[2];
+	ULONG rgulElapsedUS[2];
+	for (ULONG ul = 0; ul < GPOS_ARRAY_SIZE(rgulLength); ul++)
+	{
+		CAutoTraceFlag atf(EopttraceSerializeSharedScalars, 1 == ul /*fVal*/);
+
+		CWStringDynamic str(pmp);
+		COstreamString oss(&str);
+
+		CWallClock clock;
+		CDXLUtils::SerializePlan
+					(
+					pmp,
+					oss,
+					pdxlnPlan,
+					0 /*ullPlanId*/,
+					0 /*ullPlanSpaceSize*/,
+					true /*fDocumentHeaderFooter*/,
+					false /*fIndent*/
+					);
+		rgulElapsedUS[ul] = clock.UlElapsedUS();
+		rgulLength[ul] = str.UlLength();
+	}
+
+	{
+		CAutoTrace at(pmp);
+		at.Os()
+			<< "Serialized plan: "
+			<< rgulLength[0] << " characters in " << rgulElapsedUS[0] << "us copied, "
+			<< rgulLength[1] << " characters in " << rgulElapsedUS[1] << "us shared";
+	}
+
+	pdxlnPlan->Release();
+	poconf->Release();
+
+	return (rgulLength[1] <= rgulLength[0]) ? GPOS_OK : GPOS_FAILED;
+}
+
 // EOF
@@ -66,7 +66,8 @@ CExpressionPreprocessorTest::EresUnittest()
 		GPOS_UNITTEST_FUNC(EresUnittest_CollapseInnerJoin),
 		GPOS_UNITTEST_FUNC(EresUnittest_PreProcessConvert2InPredicate),
 		GPOS_UNITTEST_FUNC(EresUnittest_PreProcessConvertArrayWithEquals),
-		GPOS_UNITTEST_FUNC(EresUnittest_PreProcessConvert2InPredicateDeepExpressionTree)
+		GPOS_UNITTEST_FUNC(EresUnittest_PreProcessConvert2InPredicateDeepExpressionTree),
+		GPOS_UNITTEST_FUNC(EresUnittest_PreProcessSharedSubtrees)
 		};
 
 	return CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
@@ -2449,5 +2450,53 @@ CExpressionPreprocessorTest::EresUnittest_PreProcessConvert2InPredicateDeepExpre
 	return GPOS_OK;
 }
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CExpressionPreprocessorTest::EresUnittest_PreProcessSharedSubtrees
+//
+//	@doc:
+//		Test that rewrites return unchanged subtrees as is instead of copying
+//		them, and that a rewrite that changes nothing returns its input
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CExpressionPreprocessorTest::EresUnittest_PreProcessSharedSubtrees()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	// reset metadata cache
+	CMDCache::Reset();
+
+	// setup a file-based provider
+	CMDProviderMemory *pmdp = CTestUtils::m_pmdpf;
+	pmdp->AddRef();
+	CMDAccessor mda(pmp, CMDCache::Pcache(), CTestUtils::m_sysidDefault, pmdp);
+
+	CAutoOptCtxt aoc(pmp, &mda, NULL /*pceeval*/, CTestUtils::Pcm(pmp));
+
+	CAutoRef<CExpression> apexpr(CTestUtils::PexprLogicalSelectWithNestedAnd(pmp));
+
+	// unnesting the predicate creates a new select over the original get
+	CAutoRef<CExpression> apexprUnnested(CExpressionUtils::PexprUnnest(pmp, apexpr.Pt()));
+	GPOS_RTL_ASSERT(apexprUnnested.Pt() != apexpr.Pt());
+	GPOS_RTL_ASSERT((*apexprUnnested)[0] == (*apexpr)[0]);
+
+	// unnesting again changes nothing
+	CAutoRef<CExpression> apexprUnnestedAgain(CExpressionUtils::PexprUnnest(pmp, apexprUnnested.Pt()));
+	GPOS_RTL_ASSERT(apexprUnnestedAgain.Pt() == apexprUnnested.Pt());
+
+	CAutoRef<CExpression> apexprDeduped(CExpressionUtils::PexprDedupChildren(pmp, apexprUnnested.Pt()));
+	GPOS_RTL_ASSERT(CExpressionUtils::UlNodes(apexprDeduped.Pt()) <= CExpressionUtils::UlNodes(apexprUnnested.Pt()));
+	GPOS_RTL_ASSERT((*apexprDeduped)[0] == (*apexpr)[0]);
+
+	// run the whole pipeline with per-step statistics
+	CAutoTraceFlag atf(EopttracePrintOptimizationStatistics, true /*fVal*/);
+	CAutoRef<CExpression> apexprPreprocessed(CExpressionPreprocessor::PexprPreprocess(pmp, apexpr.Pt()));
+	GPOS_RTL_ASSERT(NULL != apexprPreprocessed.Pt());
+
+	return GPOS_OK;
+}
+
 // EOF
 
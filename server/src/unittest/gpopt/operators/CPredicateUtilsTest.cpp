@@ -8,7 +8,10 @@
 //	@doc:
 //		Test for predicate utilities
 //---------------------------------------------------------------------------
+#include "gpos/task/CAutoTraceFlag.h"
+
 #include "gpopt/base/CColRefSetIter.h"
+#include "gpopt/base/CScalarInternTable.h"
 #include "gpopt/base/CUtils.h"
 #include "gpopt/eval/CConstExprEvaluatorDefault.h"
 #include "gpopt/operators/CExpressionPreprocessor.h"
@@ -20,6 +23,7 @@
 #include "unittest/gpopt/CTestUtils.h"
 
 #include "naucrates/md/CMDIdGPDB.h"
+#include "naucrates/traceflags/traceflags.h"
 
 
 //---------------------------------------------------------------------------
@@ -40,6 +44,7 @@ CPredicateUtilsTest::EresUnittest()
 		GPOS_UNITTEST_FUNC(CPredicateUtilsTest::EresUnittest_Disjunctions),
 		GPOS_UNITTEST_FUNC(CPredicateUtilsTest::EresUnittest_PlainEqualities),
 		GPOS_UNITTEST_FUNC(CPredicateUtilsTest::EresUnittest_Implication),
+		GPOS_UNITTEST_FUNC(CPredicateUtilsTest::EresUnittest_Interning),
 		};
 
 	return CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
@@ -404,4 +409,89 @@ CPredicateUtilsTest::EresUnittest_Implication()
 
 	return GPOS_OK;
 }
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPredicateUtilsTest::EresUnittest_Interning
+//
+//	@doc:
+//		Test sharing of equal predicates built with scalar interning enabled
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CPredicateUtilsTest::EresUnittest_Interning()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	// setup a file-based provider
+	CMDProviderMemory *pmdp = CTestUtils::m_pmdpf;
+	pmdp->AddRef();
+	CMDAccessor mda(pmp, CMDCache::Pcache(), CTestUtils::m_sysidDefault, pmdp);
+
+	// interning is enabled when the opt context is created
+	CAutoTraceFlag atf(EopttraceInternScalars, true /*fVal*/);
+
+	// install opt context in TLS
+	CAutoOptCtxt aoc
+					(
+					pmp,
+					&mda,
+					NULL,  /* pceeval */
+					CTestUtils::Pcm(pmp)
+					);
+	GPOS_ASSERT(NULL != COptCtxt::PoctxtFromTLS()->Psit());
+
+	CExpression *pexprLeft = CTestUtils::PexprLogicalGet(pmp);
+	CExpression *pexprRight = CTestUtils::PexprLogicalGet(pmp);
+	CColRef *pcr1 = CDrvdPropRelational::Pdprel(pexprLeft->PdpDerive())->PcrsOutput()->PcrAny();
+	CColRef *pcr2 = CDrvdPropRelational::Pdprel(pexprRight->PdpDerive())->PcrsOutput()->PcrAny();
+
+	// equal predicates share one expression
+	CExpression *pexprCmp1 = CUtils::PexprScalarEqCmp(pmp, pcr1, pcr2);
+	CExpression *pexprCmp2 = CUtils::PexprScalarEqCmp(pmp, pcr1, pcr2);
+	CExpression *pexprConst1 = CUtils::PexprScalarEqCmp(pmp, CUtils::PexprScalarConstInt4(pmp, 1 /*iVal*/), pcr1);
+	CExpression *pexprConst2 = CUtils::PexprScalarEqCmp(pmp, CUtils::PexprScalarConstInt4(pmp, 1 /*iVal*/), pcr1);
+	GPOS_ASSERT(pexprCmp1 == pexprCmp2);
+	GPOS_ASSERT(pexprConst1 == pexprConst2);
+	GPOS_ASSERT((*pexprCmp1)[0] == (*pexprConst1)[1]);
+
+	// so do conjunctions of equal predicates
+	CExpression *pexprConj1 = CPredicateUtils::PexprConjunction(pmp, pexprCmp1, pexprConst1);
+	CExpression *pexprConj2 = CPredicateUtils::PexprConjunction(pmp, pexprCmp2, pexprConst2);
+	GPOS_ASSERT(pexprConj1 == pexprConj2);
+
+	// appending the same conjuncts adds no duplicates
+	DrgPexpr *pdrgpexpr = CPredicateUtils::PdrgpexprConjuncts(pmp, pexprConj1);
+	DrgPexpr *pdrgpexprDedup = CPredicateUtils::PdrgpexprAppendConjunctsDedup(pmp, pdrgpexpr, pexprConj2);
+	GPOS_ASSERT(2 == pdrgpexprDedup->UlLength());
+
+	// predicates with children in a different order are not shared
+	CExpression *pexprCmpCommuted = CUtils::PexprScalarEqCmp(pmp, pcr2, pcr1);
+	GPOS_ASSERT(pexprCmpCommuted != pexprCmp1);
+
+	// expressions over relational operators are not interned
+	pexprLeft->AddRef();
+	CExpression *pexprLeftInterned = CUtils::PexprIntern(pmp, pexprLeft);
+	GPOS_ASSERT(pexprLeftInterned == pexprLeft);
+	GPOS_ASSERT(0 < COptCtxt::PoctxtFromTLS()->Psit()->UlpHits());
+
+	// clean up
+	pexprLeftInterned->Release();
+	pexprCmpCommuted->Release();
+	pdrgpexprDedup->Release();
+	pdrgpexpr->Release();
+	pexprConj1->Release();
+	pexprConj2->Release();
+	pexprCmp1->Release();
+	pexprCmp2->Release();
+	pexprConst1->Release();
+	pexprConst2->Release();
+	pexprLeft->Release();
+	pexprRight->Release();
+
+	return GPOS_OK;
+}
+
 // EOF
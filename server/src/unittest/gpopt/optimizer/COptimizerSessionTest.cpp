@@ -0,0 +1,248 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2018 Pivotal, Inc.
+//
+//	@filename:
+//		COptimizerSessionTest.cpp
+//
+//	@doc:
+//		Tests for optimization sessions.
+//---------------------------------------------------------------------------
+
+#include "gpos/base.h"
+#include "gpos/common/CAutoP.h"
+#include "gpos/common/CAutoRef.h"
+#include "gpos/common/CBitSet.h"
+#include "gpos/io/COstreamString.h"
+#include "gpos/memory/CAutoMemoryPool.h"
+#include "gpos/string/CWStringDynamic.h"
+#include "gpos/test/CUnittest.h"
+
+#include "naucrates/dxl/CDXLUtils.h"
+#include "naucrates/dxl/operators/CDXLNode.h"
+#include "naucrates/md/CMDProviderMemory.h"
+#include "naucrates/traceflags/traceflags.h"
+
+#include "gpopt/minidump/CDXLMinidump.h"
+#include "gpopt/minidump/CMinidumperUtils.h"
+#include "gpopt/optimizer/COptimizerConfig.h"
+#include "gpopt/optimizer/COptimizerSession.h"
+#include "gpopt/optimizer/CPlanCache.h"
+
+#include "unittest/gpopt/CTestUtils.h"
+#include "unittest/gpopt/optimizer/COptimizerSessionTest.h"
+
+using namespace gpos;
+using namespace gpdxl;
+using namespace gpopt;
+
+const CHAR *COptimizerSessionTest::m_szQueryFile = "../data/dxl/minidump/Agg-Limit.mdp";
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COptimizerSessionTest::EresUnittest
+//
+//	@doc:
+//		Unittest for optimization sessions
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+COptimizerSessionTest::EresUnittest()
+{
+	CUnittest rgut[] =
+		{
+		GPOS_UNITTEST_FUNC(COptimizerSessionTest::EresUnittest_Metadata),
+		GPOS_UNITTEST_FUNC(COptimizerSessionTest::EresUnittest_PlanCache),
+		};
+
+	return CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COptimizerSessionTest::FOptimizeBatch
+//
+//	@doc:
+//		Optimize the query of the minidump a number of times in one session;
+//		returns the number of MD objects pinned by the session after the
+//		first and the last statement, and true if all plans are the same
+//
+//---------------------------------------------------------------------------
+BOOL
+COptimizerSessionTest::FOptimizeBatch
+	(
+	IMemoryPool *pmp,
+	ULONG ulStatements,
+	ULONG_PTR *pulpObjectsFirst,
+	ULONG_PTR *pulpObjectsLast
+	)
+{
+	GPOS_ASSERT(1 < ulStatements);
+	GPOS_ASSERT(NULL != pulpObjectsFirst);
+	GPOS_ASSERT(NULL != pulpObjectsLast);
+
+	CAutoP<CDXLMinidump> a_pdxlmd(CMinidumperUtils::PdxlmdLoad(pmp, m_szQueryFile));
+
+	// set up MD providers, with at least one system id
+	CAutoRef<CMDProviderMemory> a_pmdp(GPOS_NEW(pmp) CMDProviderMemory(pmp, m_szQueryFile));
+	const DrgPsysid *pdrgpsysid = a_pdxlmd->Pdrgpsysid();
+	CAutoRef<DrgPmdp> a_pdrgpmdp(GPOS_NEW(pmp) DrgPmdp(pmp));
+	a_pmdp->AddRef();
+	a_pdrgpmdp->Append(a_pmdp.Pt());
+	for (ULONG ul = 1; ul < pdrgpsysid->UlLength(); ul++)
+	{
+		a_pmdp->AddRef();
+		a_pdrgpmdp->Append(a_pmdp.Pt());
+	}
+
+	COptimizerConfig *poconf = a_pdxlmd->Poconf();
+	if (NULL == poconf)
+	{
+		poconf = COptimizerConfig::PoconfDefault(pmp);
+	}
+	else
+	{
+		poconf->AddRef();
+	}
+	ULONG ulSegments = CTestUtils::UlSegments(poconf);
+
+	// set trace flags of the minidump
+	CBitSet *pbsEnabled = NULL;
+	CBitSet *pbsDisabled = NULL;
+	SetTraceflags(pmp, a_pdxlmd->Pbs(), &pbsEnabled, &pbsDisabled);
+	GPOS_UNSET_TRACE(EopttraceEnableConstantExpressionEvaluation);
+
+	CWStringDynamic strPlanFirst(pmp);
+	BOOL fSamePlans = true;
+	{
+		// session takes ownership of the configuration
+		COptimizerSession session
+			(
+			pmp,
+			pdrgpsysid,
+			a_pdrgpmdp.Pt(),
+			NULL /*pceeval*/,
+			ulSegments,
+			1 /*ulSessionId*/,
+			poconf
+			);
+
+		for (ULONG ul = 0; ul < ulStatements; ul++)
+		{
+			CDXLNode *pdxlnPlan = session.PdxlnOptimize
+									(
+									a_pdxlmd->PdxlnQuery(),
+									a_pdxlmd->PdrgpdxlnQueryOutput(),
+									a_pdxlmd->PdrgpdxlnCTE(),
+									ul + 1 /*ulCmdId*/
+									);
+
+			CWStringDynamic strPlan(pmp);
+			COstreamString oss(&strPlan);
+			CDXLUtils::SerializePlan
+						(
+						pmp,
+						oss,
+						pdxlnPlan,
+						0 /*ullPlanId*/,
+						0 /*ullPlanSpaceSize*/,
+						true /*fDocumentHeaderFooter*/,
+						false /*fIndent*/
+						);
+			pdxlnPlan->Release();
+
+			if (0 == ul)
+			{
+				strPlanFirst.Append(&strPlan);
+				*pulpObjectsFirst = session.Pmda()->UlpObjects();
+			}
+			else
+			{
+				fSamePlans = fSamePlans && strPlanFirst.FEquals(&strPlan);
+			}
+		}
+
+		*pulpObjectsLast = session.Pmda()->UlpObjects();
+		fSamePlans = fSamePlans && ulStatements == session.UlStatements();
+	}
+
+	ResetTraceflags(pbsEnabled, pbsDisabled);
+	CRefCount::SafeRelease(pbsEnabled);
+	CRefCount::SafeRelease(pbsDisabled);
+
+	return fSamePlans;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COptimizerSessionTest::EresUnittest_Metadata
+//
+//	@doc:
+//		Statements of a batch share the MD accessor of the session; MD
+//		objects pinned by the first statement are found by later statements
+//		without pinning any more objects
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+COptimizerSessionTest::EresUnittest_Metadata()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	ULONG_PTR ulpObjectsFirst = 0;
+	ULONG_PTR ulpObjectsLast = 0;
+	BOOL fSamePlans = FOptimizeBatch(pmp, 3 /*ulStatements*/, &ulpObjectsFirst, &ulpObjectsLast);
+
+	{
+		CAutoTrace at(pmp);
+		at.Os()
+			<< "MD objects pinned after first statement: " << (ULONG) ulpObjectsFirst
+			<< ", after last statement: " << (ULONG) ulpObjectsLast;
+	}
+
+	BOOL fReused = 0 < ulpObjectsFirst && ulpObjectsFirst == ulpObjectsLast;
+
+	return (fSamePlans && fReused) ? GPOS_OK : GPOS_FAILED;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		COptimizerSessionTest::EresUnittest_PlanCache
+//
+//	@doc:
+//		Statements of a batch repeating an earlier request are served from
+//		the plan cache
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+COptimizerSessionTest::EresUnittest_PlanCache()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	BOOL fInitPlanCache = !CPlanCache::FInitialized();
+	if (fInitPlanCache)
+	{
+		CPlanCache::Init();
+	}
+	CPlanCache::Reset();
+
+	const ULONG ulStatements = 3;
+	const ULLONG ullHits = CPlanCache::ULLGetCacheHitCounter();
+
+	ULONG_PTR ulpObjectsFirst = 0;
+	ULONG_PTR ulpObjectsLast = 0;
+	BOOL fSamePlans = FOptimizeBatch(pmp, ulStatements, &ulpObjectsFirst, &ulpObjectsLast);
+
+	// all statements but the first are cache hits
+	BOOL fHits = ullHits + ulStatements - 1 == CPlanCache::ULLGetCacheHitCounter();
+
+	if (fInitPlanCache)
+	{
+		CPlanCache::Shutdown();
+	}
+
+	return (fSamePlans && fHits) ? GPOS_OK : GPOS_FAILED;
+}
+
+// EOF
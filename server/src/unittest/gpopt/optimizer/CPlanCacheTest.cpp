@@ -0,0 +1,238 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2017 Pivotal Software, Inc.
+//
+//	@filename:
+//		CPlanCacheTest.cpp
+//
+//	@doc:
+//		Tests the plan cache.
+//---------------------------------------------------------------------------
+
+#include "gpos/base.h"
+#include "gpos/common/CAutoP.h"
+#include "gpos/common/CAutoRg.h"
+#include "gpos/common/clibwrapper.h"
+#include "gpos/io/COstreamString.h"
+#include "gpos/memory/CAutoMemoryPool.h"
+#include "gpos/string/CWStringDynamic.h"
+#include "gpos/task/CAutoTraceFlag.h"
+#include "gpos/test/CUnittest.h"
+
+#include "naucrates/dxl/CDXLUtils.h"
+#include "naucrates/dxl/operators/CDXLNode.h"
+
+#include "gpopt/mdcache/CMDCache.h"
+#include "gpopt/minidump/CDXLMinidump.h"
+#include "gpopt/minidump/CMetadataAccessorFactory.h"
+#include "gpopt/minidump/CMinidumperUtils.h"
+#include "gpopt/optimizer/COptimizerConfig.h"
+#include "gpopt/optimizer/CPlanCache.h"
+
+#include "unittest/gpopt/CTestUtils.h"
+#include "unittest/gpopt/optimizer/CPlanCacheTest.h"
+
+using namespace gpos;
+using namespace gpdxl;
+using namespace gpopt;
+
+const CHAR *CPlanCacheTest::m_szQueryFile = "../data/dxl/minidump/Agg-Limit.mdp";
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCacheTest::EresUnittest
+//
+//	@doc:
+//		Unittest for the plan cache
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CPlanCacheTest::EresUnittest()
+{
+	CUnittest rgut[] =
+		{
+		GPOS_UNITTEST_FUNC(CPlanCacheTest::EresUnittest_Basic),
+		GPOS_UNITTEST_FUNC(CPlanCacheTest::EresUnittest_Eviction),
+		GPOS_UNITTEST_FUNC(CPlanCacheTest::EresUnittest_Optimize),
+		};
+
+	CPlanCache::Init();
+	GPOS_RESULT eres = CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
+	CPlanCache::Shutdown();
+
+	return eres;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCacheTest::EresUnittest_Basic
+//
+//	@doc:
+//		Store and look up plans
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CPlanCacheTest::EresUnittest_Basic()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	CPlanCache::Reset();
+
+	const WCHAR *wszQuery = GPOS_WSZ_LIT("select * from t where a = 1");
+	const WCHAR *wszOtherQuery = GPOS_WSZ_LIT("select * from t where a = 2");
+	CPlanKey plankey(wszQuery, clib::UlWcsLen(wszQuery));
+	CPlanKey plankeyOther(wszOtherQuery, clib::UlWcsLen(wszOtherQuery));
+
+	const ULLONG ullHits = CPlanCache::ULLGetCacheHitCounter();
+	const ULLONG ullMisses = CPlanCache::ULLGetCacheMissCounter();
+
+	CAutoRg<CHAR> a_sz;
+	a_sz = CPlanCache::SzLookup(pmp, &plankey);
+	if (NULL != a_sz.Rgt())
+	{
+		return GPOS_FAILED;
+	}
+
+	const CHAR *szPlan = "<dxl:Plan/>";
+	CPlanCache::Insert(&plankey, szPlan);
+
+	a_sz = CPlanCache::SzLookup(pmp, &plankey);
+	if (NULL == a_sz.Rgt() || 0 != clib::IStrCmp(szPlan, a_sz.Rgt()))
+	{
+		return GPOS_FAILED;
+	}
+
+	// a different query is not found
+	CAutoRg<CHAR> a_szOther;
+	a_szOther = CPlanCache::SzLookup(pmp, &plankeyOther);
+	if (NULL != a_szOther.Rgt())
+	{
+		return GPOS_FAILED;
+	}
+
+	if (ullHits + 1 != CPlanCache::ULLGetCacheHitCounter() ||
+		ullMisses + 2 != CPlanCache::ULLGetCacheMissCounter())
+	{
+		return GPOS_FAILED;
+	}
+
+	return GPOS_OK;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCacheTest::EresUnittest_Eviction
+//
+//	@doc:
+//		Plans are evicted once the cache exceeds its quota
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CPlanCacheTest::EresUnittest_Eviction()
+{
+	CPlanCache::Reset();
+
+	const ULLONG ullQuota = CPlanCache::ULLGetCacheQuota();
+	CPlanCache::SetCacheQuota(1 /*ullCacheQuota*/);
+
+	const ULLONG ullEvictions = CPlanCache::ULLGetCacheEvictionCounter();
+
+	const WCHAR *rgwszQueries[] =
+		{
+		GPOS_WSZ_LIT("select 1"),
+		GPOS_WSZ_LIT("select 2"),
+		GPOS_WSZ_LIT("select 3"),
+		};
+
+	for (ULONG ul = 0; ul < GPOS_ARRAY_SIZE(rgwszQueries); ul++)
+	{
+		CPlanKey plankey(rgwszQueries[ul], clib::UlWcsLen(rgwszQueries[ul]));
+		CPlanCache::Insert(&plankey, "<dxl:Plan/>");
+	}
+
+	BOOL fEvicted = ullEvictions < CPlanCache::ULLGetCacheEvictionCounter();
+
+	CPlanCache::SetCacheQuota(ullQuota);
+
+	return fEvicted ? GPOS_OK : GPOS_FAILED;
+}
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CPlanCacheTest::EresUnittest_Optimize
+//
+//	@doc:
+//		Optimizing the same query twice with the plan cache enabled serves
+//		the second request from the cache
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CPlanCacheTest::EresUnittest_Optimize()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	CPlanCache::Reset();
+	CAutoTraceFlag atf(EopttraceEnablePlanCache, true /*fVal*/);
+
+	CAutoP<CDXLMinidump> a_pdxlmd(CMinidumperUtils::PdxlmdLoad(pmp, m_szQueryFile));
+	CMetadataAccessorFactory factory(pmp, a_pdxlmd.Pt(), m_szQueryFile);
+
+	COptimizerConfig *poconf = a_pdxlmd->Poconf();
+	if (NULL == poconf)
+	{
+		poconf = COptimizerConfig::PoconfDefault(pmp);
+	}
+	else
+	{
+		poconf->AddRef();
+	}
+	ULONG ulSegments = CTestUtils::UlSegments(poconf);
+
+	CWStringDynamic *rgpstrPlan[2];
+	ULLONG ullHits = 0;
+	for (ULONG ul = 0; ul < GPOS_ARRAY_SIZE(rgpstrPlan); ul++)
+	{
+		ullHits = CPlanCache::ULLGetCacheHitCounter();
+
+		CDXLNode *pdxlnPlan = CMinidumperUtils::PdxlnExecuteMinidump
+								(
+								pmp,
+								factory.Pmda(),
+								a_pdxlmd.Pt(),
+								m_szQueryFile,
+								ulSegments,
+								1 /*ulSessionId*/,
+								1 /*ulCmdId*/,
+								poconf,
+								NULL /*pceeval*/
+								);
+
+		rgpstrPlan[ul] = GPOS_NEW(pmp) CWStringDynamic(pmp);
+		COstreamString oss(rgpstrPlan[ul]);
+		CDXLUtils::SerializePlan
+					(
+					pmp,
+					oss,
+					pdxlnPlan,
+					0 /*ullPlanId*/,
+					0 /*ullPlanSpaceSize*/,
+					true /*fDocumentHeaderFooter*/,
+					false /*fIndent*/
+					);
+		pdxlnPlan->Release();
+	}
+
+	// second optimization must be a cache hit with the same plan
+	BOOL fHit = ullHits + 1 == CPlanCache::ULLGetCacheHitCounter();
+	BOOL fSamePlan = rgpstrPlan[0]->FEquals(rgpstrPlan[1]);
+
+	GPOS_DELETE(rgpstrPlan[0]);
+	GPOS_DELETE(rgpstrPlan[1]);
+	poconf->Release();
+
+	return (fHit && fSamePlan) ? GPOS_OK : GPOS_FAILED;
+}
+
+// EOF
@@ -104,11 +104,11 @@ COptimizationJobsTest::EresUnittest_StateMachine()
 		CJobFactory jf(pmp, 1000 /*ulJobs*/);
 		CScheduler sched(pmp, 1000 /*ulJobs*/, 1 /*ulWorkers*/);
 		CSchedulerContext sc;
-		sc.Init(pmp, &jf, &sched, &eng);
+		sc.Init(pmp, &jf, &sched, &eng, 0 /*ulWorker*/);
 		CJob *pj = jf.PjCreate(CJob::EjtGroupOptimization);
 		CJobGroupOptimization *pjgo = CJobGroupOptimization::PjConvert(pj);
 		pjgo->Init(pgroup, NULL /*pgexprOrigin*/, poc);
-		sched.Add(pjgo, NULL /*pjParent*/);
+		sched.Add(pjgo, NULL /*pjParent*/, 0 /*ulWorker*/);
 		CScheduler::Run(&sc);
 
 #ifdef GPOS_DEBUG
@@ -0,0 +1,275 @@
+//---------------------------------------------------------------------------
+//	Greenplum Database
+//	Copyright (C) 2018 Pivotal Software, Inc.
+//
+//	@filename:
+//		CSchedulerScalingTest.cpp
+//
+//	@doc:
+//		Scaling benchmark for multi-worker optimization
+//---------------------------------------------------------------------------
+
+#include "gpos/base.h"
+#include "gpos/common/CAutoRg.h"
+#include "gpos/common/CWallClock.h"
+#include "gpos/error/CAutoTrace.h"
+#include "gpos/io/COstreamString.h"
+#include "gpos/memory/CAutoMemoryPool.h"
+#include "gpos/string/CWStringDynamic.h"
+#include "gpos/test/CUnittest.h"
+
+#include "gpopt/engine/CHint.h"
+#include "gpopt/minidump/CDXLMinidump.h"
+#include "gpopt/minidump/CMinidumperUtils.h"
+#include "gpopt/optimizer/COptimizerConfig.h"
+
+#include "naucrates/dxl/CDXLUtils.h"
+#include "naucrates/dxl/operators/CDXLNode.h"
+#include "naucrates/dxl/operators/CDXLOperatorCost.h"
+#include "naucrates/dxl/operators/CDXLPhysicalProperties.h"
+
+#include "unittest/gpopt/CTestUtils.h"
+#include "unittest/gpopt/minidump/CICGTest.h"
+#include "unittest/gpopt/search/CSchedulerScalingTest.h"
+
+using namespace gpopt;
+
+// worker counts to benchmark
+static const ULONG rgulScalingWorkers[] = {1, 2, 4, 8, 16};
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CSchedulerScalingTest::EresUnittest
+//
+//	@doc:
+//		Unittest for scaling of multi-worker optimization
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CSchedulerScalingTest::EresUnittest()
+{
+	CUnittest rgut[] =
+		{
+		GPOS_UNITTEST_FUNC(CSchedulerScalingTest::EresUnittest_Scaling),
+		};
+
+	return CUnittest::EresExecute(rgut, GPOS_ARRAY_SIZE(rgut));
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CSchedulerScalingTest::PoconfWithWorkers
+//
+//	@doc:
+//		Copy of the given configuration with a different number of workers
+//
+//---------------------------------------------------------------------------
+COptimizerConfig *
+CSchedulerScalingTest::PoconfWithWorkers
+	(
+	IMemoryPool *pmp,
+	COptimizerConfig *poconf,
+	ULONG ulWorkers
+	)
+{
+	CHint *phint = poconf->Phint();
+
+	poconf->Pec()->AddRef();
+	poconf->Pstatsconf()->AddRef();
+	poconf->Pcteconf()->AddRef();
+	poconf->Pcm()->AddRef();
+	poconf->Pwindowoids()->AddRef();
+
+	return GPOS_NEW(pmp) COptimizerConfig
+						(
+						poconf->Pec(),
+						poconf->Pstatsconf(),
+						poconf->Pcteconf(),
+						poconf->Pcm(),
+						GPOS_NEW(pmp) CHint
+							(
+							phint->UlMinNumOfPartsToRequireSortOnInsert(),
+							phint->UlJoinArityForAssociativityCommutativity(),
+							phint->UlArrayExpansionThreshold(),
+							phint->UlJoinOrderDPLimit(),
+							phint->UlBroadcastThreshold(),
+							phint->FEnforceConstraintsOnDML(),
+							ulWorkers,
+							phint->UlOptimizationDeadline()
+							),
+						poconf->Pwindowoids()
+						);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CSchedulerScalingTest::UlOptimize
+//
+//	@doc:
+//		Optimize the given minidump with the given number of workers;
+//		append the serialized plan and its cost to the given strings and
+//		return elapsed optimization time in milliseconds
+//
+//---------------------------------------------------------------------------
+ULONG
+CSchedulerScalingTest::UlOptimize
+	(
+	const CHAR *szFileName,
+	ULONG ulWorkers,
+	CWStringDynamic *pstrPlan,
+	CWStringDynamic *pstrCost
+	)
+{
+	GPOS_ASSERT(NULL != pstrPlan);
+	GPOS_ASSERT(NULL != pstrCost);
+
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	CDXLMinidump *pdxlmd = CMinidumperUtils::PdxlmdLoad(pmp, szFileName);
+	GPOS_CHECK_ABORT;
+
+	COptimizerConfig *poconfDump = pdxlmd->Poconf();
+	if (NULL == poconfDump)
+	{
+		poconfDump = COptimizerConfig::PoconfDefault(pmp);
+	}
+	else
+	{
+		poconfDump->AddRef();
+	}
+
+	COptimizerConfig *poconf = PoconfWithWorkers(pmp, poconfDump, ulWorkers);
+	poconfDump->Release();
+
+	CWallClock clock;
+	CDXLNode *pdxlnPlan = CMinidumperUtils::PdxlnExecuteMinidump
+							(
+							pmp,
+							pdxlmd,
+							szFileName,
+							CTestUtils::UlSegments(poconf),
+							1 /*ulSessionId*/,
+							1 /*ulCmdId*/,
+							poconf,
+							NULL /*pceeval*/
+							);
+	ULONG ulElapsedMS = clock.UlElapsedMS();
+
+	if (NULL != pdxlnPlan)
+	{
+		COstreamString oss(pstrPlan);
+		CDXLUtils::SerializePlan
+					(
+					pmp,
+					oss,
+					pdxlnPlan,
+					0 /*ullPlanId*/,
+					0 /*ullPlanSpaceSize*/,
+					true /*fDocumentHeaderFooter*/,
+					false /*fIndent*/
+					);
+
+		CDXLPhysicalProperties *pdxlprop = CDXLPhysicalProperties::PdxlpropConvert(pdxlnPlan->Pdxlprop());
+		pstrCost->Append(pdxlprop->Pdxlopcost()->PstrTotalCost());
+	}
+
+	CRefCount::SafeRelease(pdxlnPlan);
+	poconf->Release();
+	GPOS_DELETE(pdxlmd);
+
+	return ulElapsedMS;
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CSchedulerScalingTest::EresUnittest_Scaling
+//
+//	@doc:
+//		Optimize the minidumps of the ICG test corpus with 1/2/4/8/16
+//		workers and report total optimization time and speedup relative to
+//		a single worker; parallel search must find the same plan with the
+//		same cost as a single worker
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CSchedulerScalingTest::EresUnittest_Scaling()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	const ULONG ulFiles = CICGTest::UlMinidumps();
+	ULONG ulBaselineMS = 0;
+
+	// plans and costs found with a single worker
+	CAutoRg<CWStringDynamic *> a_rgpstrPlan;
+	a_rgpstrPlan = GPOS_NEW_ARRAY(pmp, CWStringDynamic *, ulFiles);
+	CAutoRg<CWStringDynamic *> a_rgpstrCost;
+	a_rgpstrCost = GPOS_NEW_ARRAY(pmp, CWStringDynamic *, ulFiles);
+	for (ULONG ul = 0; ul < ulFiles; ul++)
+	{
+		a_rgpstrPlan[ul] = GPOS_NEW(pmp) CWStringDynamic(pmp);
+		a_rgpstrCost[ul] = GPOS_NEW(pmp) CWStringDynamic(pmp);
+	}
+
+	GPOS_RESULT eres = GPOS_OK;
+	for (ULONG ulConfig = 0; ulConfig < GPOS_ARRAY_SIZE(rgulScalingWorkers); ulConfig++)
+	{
+		const ULONG ulWorkers = rgulScalingWorkers[ulConfig];
+		ULONG ulTotalMS = 0;
+
+		for (ULONG ul = 0; ul < ulFiles; ul++)
+		{
+			const CHAR *szFileName = CICGTest::SzMinidump(ul);
+
+			CWStringDynamic strPlan(pmp);
+			CWStringDynamic strCost(pmp);
+			CWStringDynamic *pstrPlan = (0 == ulConfig) ? a_rgpstrPlan[ul] : &strPlan;
+			CWStringDynamic *pstrCost = (0 == ulConfig) ? a_rgpstrCost[ul] : &strCost;
+
+			ULONG ulElapsedMS = UlOptimize(szFileName, ulWorkers, pstrPlan, pstrCost);
+			ulTotalMS += ulElapsedMS;
+
+			CAutoTrace at(pmp);
+			at.Os()
+				<< "[SCALING]: workers=" << ulWorkers
+				<< " file=" << szFileName
+				<< " time=" << ulElapsedMS << "ms"
+				<< " cost=" << pstrCost->Wsz();
+
+			if (0 < ulConfig &&
+				(!a_rgpstrCost[ul]->FEquals(pstrCost) || !a_rgpstrPlan[ul]->FEquals(pstrPlan)))
+			{
+				at.Os()
+					<< std::endl << "[SCALING]: plan differs from single worker plan with cost "
+					<< a_rgpstrCost[ul]->Wsz();
+				eres = GPOS_FAILED;
+			}
+		}
+
+		if (0 == ulConfig)
+		{
+			ulBaselineMS = ulTotalMS;
+		}
+
+		CAutoTrace at(pmp);
+		at.Os()
+			<< "[SCALING]: workers=" << ulWorkers
+			<< " total=" << ulTotalMS << "ms"
+			<< " speedup=" << CDouble(ulBaselineMS) / CDouble(std::max(ulTotalMS, (ULONG) 1));
+	}
+
+	for (ULONG ul = 0; ul < ulFiles; ul++)
+	{
+		GPOS_DELETE(a_rgpstrPlan[ul]);
+		GPOS_DELETE(a_rgpstrCost[ul]);
+	}
+
+	return eres;
+}
+
+// EOF
@@ -12,6 +12,7 @@
 #include "gpos/base.h"
 #include "gpos/common/CAutoP.h"
 #include "gpos/common/CAutoRg.h"
+#include "gpos/error/CAutoTrace.h"
 #include "gpos/io/COstreamString.h"
 #include "gpos/memory/CAutoMemoryPool.h"
 #include "gpos/string/CWStringDynamic.h"
@@ -24,6 +25,7 @@
 #include "gpopt/engine/CEngine.h"
 #include "gpopt/search/CJobTest.h"
 #include "gpopt/search/CJobFactory.h"
+#include "gpopt/search/CJobProfiler.h"
 #include "gpopt/search/CScheduler.h"
 #include "gpopt/search/CSchedulerContext.h"
 #include "gpopt/mdcache/CMDAccessor.h"
@@ -57,6 +59,7 @@ CSchedulerTest::EresUnittest()
 #ifndef GPOS_DEBUG
 		GPOS_UNITTEST_FUNC(CSchedulerTest::EresUnittest_SpawnHeavy),
 #endif // GPOS_DEBUG
+		GPOS_UNITTEST_FUNC(CSchedulerTest::EresUnittest_SpawnProfiled),
 		GPOS_UNITTEST_FUNC(CSchedulerTest::EresUnittest_QueueBasic),
 		GPOS_UNITTEST_FUNC(CSchedulerTest::EresUnittest_QueueLight),
 		GPOS_UNITTEST_FUNC(CSchedulerTest::EresUnittest_QueueHeavy),
@@ -151,6 +154,74 @@ CSchedulerTest::EresUnittest_SpawnHeavy()
 }
 
 
+//---------------------------------------------------------------------------
+//	@function:
+//		CSchedulerTest::EresUnittest_SpawnProfiled
+//
+//	@doc:
+//		Job scheduling test with a job profiler attached to the scheduler
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CSchedulerTest::EresUnittest_SpawnProfiled()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	const ULONG ulRounds = 100;
+	const ULONG ulFanout = 4;
+	const ULONG ulWorkers = 2;
+	const ULONG ulJobs = ulRounds * ulFanout + 1;
+
+	CJobFactory jf(pmp, ulJobs);
+	CScheduler sched
+				(
+				pmp,
+				ulJobs,
+				ulWorkers
+#ifdef GPOS_DEBUG
+				,
+				false /*fTrackingJobs*/
+#endif // GPOS_DEBUG
+				);
+
+	CJobProfiler jprof(pmp, ulWorkers);
+	sched.SetProfiler(&jprof);
+
+	CEngine eng(pmp);
+
+	// add root job
+	CJobTest *pjt = CJobTest::PjConvert(jf.PjCreate(CJob::EjtTest));
+	CJobQueue jq;
+	pjt->Init(CJobTest::EttSpawn, ulRounds, ulFanout, 1 /*ulIters*/, &jq);
+	pjt->ResetCnt();
+	sched.Add(pjt, NULL, 0 /*ulWorker*/);
+
+	RunTasks(pmp, &jf, &sched, &eng, ulWorkers);
+
+	// every job runs at least once, suspended jobs run again when resumed
+	CJobProfiler::SStats statsTest = jprof.StatsJobType(CJob::EjtTest);
+	CJobProfiler::SStats statsOpt = jprof.StatsJobType(CJob::EjtGroupOptimization);
+
+	CWStringDynamic str(pmp);
+	COstreamString oss(&str);
+	(void) jprof.OsPrintFolded(oss);
+
+	CAutoTrace at(pmp);
+	(void) jprof.OsPrint(at.Os());
+	at.Os() << str.Wsz();
+
+	if (ulJobs > statsTest.m_ullExecutions ||
+		0 != statsOpt.m_ullExecutions ||
+		0 == str.UlLength())
+	{
+		return GPOS_FAILED;
+	}
+
+	return GPOS_OK;
+}
+
+
 //---------------------------------------------------------------------------
 //	@function:
 //		CSchedulerTest::EresUnittest_QueueBasic
@@ -282,7 +353,7 @@ CSchedulerTest::ScheduleRoot
 	CJobQueue jq;
 	pjt->Init(ett, ulRounds, ulFanout, ulIters, &jq);
 	pjt->ResetCnt();
-	sched.Add(pjt, NULL);
+	sched.Add(pjt, NULL, 0 /*ulWorker*/);
 
 	RunTasks(pmp, &jf, &sched, &eng, ulWorkers);
 
@@ -325,7 +396,7 @@ CSchedulerTest::RunTasks
 		for (ULONG i = 0; i < ulWorkers; i++)
 		{
 			// initialize scheduling context
-			a_rgsc[i].Init(pmp, pjf, psched, peng);
+			a_rgsc[i].Init(pmp, pjf, psched, peng, i /*ulWorker*/);
 
 			// create scheduling task
 			a_rgptsk[i] = atp.PtskCreate(CScheduler::Run, &a_rgsc[i]);
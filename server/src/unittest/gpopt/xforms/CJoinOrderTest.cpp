@@ -8,6 +8,7 @@
 //	@doc:
 //		Test for join ordering
 //---------------------------------------------------------------------------
+#include "gpos/common/CWallClock.h"
 #include "gpos/io/COstreamString.h"
 #include "gpos/test/CUnittest.h"
 
@@ -18,6 +19,7 @@
 #include "gpopt/operators/ops.h"
 
 #include "gpopt/xforms/CJoinOrder.h"
+#include "gpopt/xforms/CJoinOrderDP.h"
 #include "gpopt/xforms/CJoinOrderMinCard.h"
 
 #include "unittest/base.h"
@@ -48,6 +50,7 @@ CJoinOrderTest::EresUnittest()
 	CUnittest rgut[] =
 		{
 		GPOS_UNITTEST_FUNC(EresUnittest_ExpandMinCard),
+		GPOS_UNITTEST_FUNC(EresUnittest_DPEnumeration),
 		GPOS_UNITTEST_FUNC(EresUnittest_RunTests)
 		};
 
@@ -162,6 +165,242 @@ CJoinOrderTest::EresUnittest_ExpandMinCard()
 	return GPOS_OK;
 }
 
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderTest::PexprJoinGraph
+//
+//	@doc:
+//		Generate an n-ary join of given number of relations whose predicates
+//		form a join graph of given shape
+//
+//---------------------------------------------------------------------------
+CExpression *
+CJoinOrderTest::PexprJoinGraph
+	(
+	IMemoryPool *pmp,
+	EJoinGraph ejg,
+	ULONG ulRels
+	)
+{
+	GPOS_ASSERT(EjgSentinel > ejg);
+
+	// array of relation names
+	CWStringConst rgscRel[] =
+	{
+		GPOS_WSZ_LIT("Rel1"),
+		GPOS_WSZ_LIT("Rel2"),
+		GPOS_WSZ_LIT("Rel3"),
+		GPOS_WSZ_LIT("Rel4"),
+		GPOS_WSZ_LIT("Rel5"),
+		GPOS_WSZ_LIT("Rel6"),
+		GPOS_WSZ_LIT("Rel7"),
+		GPOS_WSZ_LIT("Rel8"),
+		GPOS_WSZ_LIT("Rel9"),
+		GPOS_WSZ_LIT("Rel10"),
+		GPOS_WSZ_LIT("Rel11"),
+		GPOS_WSZ_LIT("Rel12"),
+		GPOS_WSZ_LIT("Rel13"),
+		GPOS_WSZ_LIT("Rel14"),
+		GPOS_WSZ_LIT("Rel15"),
+		GPOS_WSZ_LIT("Rel16"),
+		GPOS_WSZ_LIT("Rel17"),
+		GPOS_WSZ_LIT("Rel18"),
+	};
+
+	// array of relation IDs
+	ULONG rgulRel[] =
+	{
+		GPOPT_TEST_REL_OID1,
+		GPOPT_TEST_REL_OID2,
+		GPOPT_TEST_REL_OID3,
+		GPOPT_TEST_REL_OID4,
+		GPOPT_TEST_REL_OID5,
+		GPOPT_TEST_REL_OID6,
+		GPOPT_TEST_REL_OID7,
+		GPOPT_TEST_REL_OID8,
+		GPOPT_TEST_REL_OID9,
+		GPOPT_TEST_REL_OID10,
+		GPOPT_TEST_REL_OID11,
+		GPOPT_TEST_REL_OID12,
+		GPOPT_TEST_REL_OID13,
+		GPOPT_TEST_REL_OID14,
+		GPOPT_TEST_REL_OID15,
+		GPOPT_TEST_REL_OID16,
+		GPOPT_TEST_REL_OID17,
+		GPOPT_TEST_REL_OID18,
+	};
+
+	GPOS_ASSERT(GPOS_ARRAY_SIZE(rgulRel) == GPOS_ARRAY_SIZE(rgscRel));
+	GPOS_ASSERT(ulRels <= GPOS_ARRAY_SIZE(rgscRel));
+
+	DrgPexpr *pdrgpexpr = GPOS_NEW(pmp) DrgPexpr(pmp);
+	for (ULONG ul = 0; ul < ulRels; ul++)
+	{
+		CExpression *pexpr = CTestUtils::PexprLogicalGet(pmp, &rgscRel[ul], &rgscRel[ul], rgulRel[ul]);
+		pdrgpexpr->Append(pexpr);
+	}
+
+	DrgPexpr *pdrgpexprPred = GPOS_NEW(pmp) DrgPexpr(pmp);
+	for (ULONG ulOuter = 0; ulOuter < ulRels; ulOuter++)
+	{
+		for (ULONG ulInner = ulOuter + 1; ulInner < ulRels; ulInner++)
+		{
+			BOOL fEdge =
+				EjgClique == ejg ||
+				(EjgChain == ejg && ulInner == ulOuter + 1) ||
+				(EjgStar == ejg && 0 == ulOuter);
+			if (!fEdge)
+			{
+				continue;
+			}
+
+			// get any two columns; one from each side
+			CColRef *pcrOuter = CDrvdPropRelational::Pdprel((*pdrgpexpr)[ulOuter]->PdpDerive())->PcrsOutput()->PcrAny();
+			CColRef *pcrInner = CDrvdPropRelational::Pdprel((*pdrgpexpr)[ulInner]->PdpDerive())->PcrsOutput()->PcrAny();
+			pdrgpexprPred->Append(CUtils::PexprScalarEqCmp(pmp, pcrOuter, pcrInner));
+		}
+	}
+	pdrgpexpr->Append(CPredicateUtils::PexprConjunction(pmp, pdrgpexprPred));
+
+	return CTestUtils::PexprLogicalNAryJoin(pmp, pdrgpexpr);
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderTest::UllPairs
+//
+//	@doc:
+//		Number of pairs of connected sets and complements in a join graph
+//		of given shape (Moerkotte and Neumann, VLDB 2006)
+//
+//---------------------------------------------------------------------------
+ULLONG
+CJoinOrderTest::UllPairs
+	(
+	EJoinGraph ejg,
+	ULONG ulRels
+	)
+{
+	const ULLONG ullRels = ulRels;
+	switch (ejg)
+	{
+		case EjgChain:
+			return (ullRels * ullRels * ullRels - ullRels) / 6;
+
+		case EjgStar:
+			return (ullRels - 1) << (ulRels - 2);
+
+		case EjgClique:
+		{
+			ULLONG ullPow3 = 1;
+			for (ULONG ul = 0; ul < ulRels; ul++)
+			{
+				ullPow3 *= 3;
+			}
+			return (ullPow3 - (ULLONG(1) << (ulRels + 1)) + 1) / 2;
+		}
+
+		default:
+			GPOS_ASSERT(!"Unexpected join graph");
+			return 0;
+	}
+}
+
+
+//---------------------------------------------------------------------------
+//	@function:
+//		CJoinOrderTest::EresUnittest_DPEnumeration
+//
+//	@doc:
+//		Measure join ordering by dynamic programming on chain, star and
+//		clique join graphs beyond the default DP threshold; enumeration
+//		falls back exactly when the join graph has more pairs of connected
+//		sets and complements than GPOPT_DP_JOIN_ORDERING_MAX_PAIRS
+//
+//---------------------------------------------------------------------------
+GPOS_RESULT
+CJoinOrderTest::EresUnittest_DPEnumeration()
+{
+	CAutoMemoryPool amp;
+	IMemoryPool *pmp = amp.Pmp();
+
+	// setup a file-based provider
+	CMDProviderMemory *pmdp = CTestUtils::m_pmdpf;
+	pmdp->AddRef();
+	CMDAccessor mda(pmp, CMDCache::Pcache());
+	mda.RegisterProvider(CTestUtils::m_sysidDefault, pmdp);
+
+	// install opt context in TLS
+	CAutoOptCtxt aoc
+			(
+			pmp,
+			&mda,
+			NULL,  /* pceeval */
+			CTestUtils::Pcm(pmp)
+			);
+
+	const CHAR *rgszJoinGraph[] = {"chain", "star", "clique"};
+	GPOS_ASSERT(GPOS_ARRAY_SIZE(rgszJoinGraph) == EjgSentinel);
+
+	const ULONG rgulRels[] = {12, 15, 18};
+
+	GPOS_RESULT eres = GPOS_OK;
+	for (ULONG ulGraph = 0; ulGraph < EjgSentinel && GPOS_OK == eres; ulGraph++)
+	{
+		EJoinGraph ejg = (EJoinGraph) ulGraph;
+		for (ULONG ul = 0; ul < GPOS_ARRAY_SIZE(rgulRels) && GPOS_OK == eres; ul++)
+		{
+			const ULONG ulRels = rgulRels[ul];
+			CExpression *pexprNAryJoin = PexprJoinGraph(pmp, ejg, ulRels);
+
+			// derive stats on input expression
+			CExpressionHandle exprhdl(pmp);
+			exprhdl.Attach(pexprNAryJoin);
+			exprhdl.DeriveStats(pmp, pmp, NULL /*prprel*/, NULL /*pdrgpstatCtxt*/);
+
+			DrgPexpr *pdrgpexpr = GPOS_NEW(pmp) DrgPexpr(pmp);
+			for (ULONG ulChild = 0; ulChild < ulRels; ulChild++)
+			{
+				CExpression *pexprChild = (*pexprNAryJoin)[ulChild];
+				pexprChild->AddRef();
+				pdrgpexpr->Append(pexprChild);
+			}
+			DrgPexpr *pdrgpexprPred = CPredicateUtils::PdrgpexprConjuncts(pmp, (*pexprNAryJoin)[ulRels]);
+
+			CJoinOrderDP jodp(pmp, pdrgpexpr, pdrgpexprPred);
+
+			CWallClock clock;
+			CExpression *pexprResult = jodp.PexprExpand();
+			const ULONG ulElapsedMS = clock.UlElapsedMS();
+
+			const ULLONG ullPairs = UllPairs(ejg, ulRels);
+			const BOOL fFallback = (NULL == pexprResult);
+			{
+				CAutoTrace at(pmp);
+				at.Os()
+					<< rgszJoinGraph[ulGraph] << " of " << ulRels << " relations: "
+					<< ullPairs << " pairs, " << jodp.UlPairs() << " enumerated in "
+					<< ulElapsedMS << " ms"
+					<< (fFallback ? ", fell back to greedy join order" : "");
+			}
+
+			// enumeration gives up exactly when the join graph exceeds the budget
+			if (fFallback != (GPOPT_DP_JOIN_ORDERING_MAX_PAIRS < ullPairs) ||
+				(!fFallback && ullPairs != jodp.UlPairs()))
+			{
+				eres = GPOS_FAILED;
+			}
+
+			CRefCount::SafeRelease(pexprResult);
+			pexprNAryJoin->Release();
+		}
+	}
+
+	return eres;
+}
+
 //	run all Minidump-based tests with plan matching
 GPOS_RESULT
 CJoinOrderTest::EresUnittest_RunTests()